@@ -25,6 +25,10 @@ function(proton_core_generator GENERATED_FILES GENERATED_FOLDER TARGET)
   get_filename_component(PROTON_ROOT_DIR "${PROTON_CORE_CMAKE_DIR}" DIRECTORY)
   set(PROTON_CORE_GENERATOR_SCRIPT "${PROTON_ROOT_DIR}/generator_scripts/generator.py")
   set(PROTON_CORE_PYTHONPATH "$ENV{PYTHONPATH}:${PROTON_ROOT_DIR}/generator_scripts")
+  file(GLOB PROTON_CORE_GENERATOR_DEPENDS
+    ${PROTON_ROOT_DIR}/generator_scripts/*.py
+    ${PROTON_ROOT_DIR}/generator_scripts/resources/*.jinja
+  )
 
 
   find_package(Python3 REQUIRED COMPONENTS Interpreter)
@@ -38,7 +42,7 @@ function(proton_core_generator GENERATED_FILES GENERATED_FOLDER TARGET)
       ${CONFIG_ARG}
       -d ${GENERATED_FOLDER}
       -t ${TARGET}
-    DEPENDS ${CONFIG_DEPENDS}
+    DEPENDS ${CONFIG_DEPENDS} ${PROTON_CORE_GENERATOR_DEPENDS}
     WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
     COMMENT "Running Python script: ${Python3_EXECUTABLE} ${PROTON_CORE_GENERATOR} ${CONFIG_ARG} -d ${GENERATED_FOLDER} -t ${TARGET}"
   )
@@ -29,15 +29,30 @@ extern "C"
 // Max message size
 #define PROTON_MAX_MESSAGE_SIZE UINT16_MAX
 
+// Frame flags, carried by the udp4 header flags and by the serial frame magic bytes
+#define PROTON_FRAME_FLAG_COMPACT \
+  (uint8_t)0x01  // Payload is a compact frame, see proton_encode_bundle_compact
+#define PROTON_FRAME_FLAG_CRC32C \
+  (uint8_t)0x02  // Serial frame is checked with CRC32C instead of CRC16
+
 // Serial Framing
 // [0x50][0x52][Length byte 0][Length byte 1][Payload][CRC16 byte 0][CRC16 byte 1]
+// CRC32C frames use a lowercase magic byte 1 and end in 4 little endian CRC32C bytes
 #define PROTON_FRAME_HEADER_MAGIC_BYTE_0 \
   (uint8_t)0x50  // Magic overhead byte 0 for serial synchronization
 #define PROTON_FRAME_HEADER_MAGIC_BYTE_1 \
   (uint8_t)0x52  // Magic overhead byte 1 for serial synchronization
+#define PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT \
+  (uint8_t)0x43  // Magic overhead byte 1 of a frame carrying a compact payload
+#define PROTON_FRAME_HEADER_MAGIC_BYTE_1_CRC32C \
+  (uint8_t)0x72  // Magic overhead byte 1 of a frame checked with CRC32C
+#define PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT_CRC32C \
+  (uint8_t)0x63  // Magic overhead byte 1 of a compact frame checked with CRC32C
 #define PROTON_FRAME_HEADER_LENGTH_OVERHEAD \
   sizeof(uint16_t)                                  // Length is sent in 2 bytes as a uint16_t
 #define PROTON_FRAME_CRC_OVERHEAD sizeof(uint16_t)  // CRC is sent in 2 bytes as a uint16_t
+#define PROTON_FRAME_CRC32C_OVERHEAD \
+  sizeof(uint32_t)  // CRC32C is sent in 4 bytes as a uint32_t
 #define PROTON_FRAME_HEADER_OVERHEAD                                                    \
   sizeof(PROTON_FRAME_HEADER_MAGIC_BYTE_0) + sizeof(PROTON_FRAME_HEADER_MAGIC_BYTE_1) + \
     PROTON_FRAME_HEADER_LENGTH_OVERHEAD
@@ -60,11 +75,12 @@ extern "C"
     PROTON_DISCONNECT_ERROR,                // Error while trying to disconnect
     PROTON_READ_ERROR,                      // Error while trying to read
     PROTON_WRITE_ERROR,                     // Error while trying to write
-    PROTON_CRC16_ERROR,                     // CRC16 mismatch
+    PROTON_CRC16_ERROR,                     // CRC16 or CRC32C mismatch
     PROTON_MUTEX_ERROR,                     // Failed to lock or unlock mutex
     PROTON_INSUFFICIENT_BUFFER_ERROR,       // Buffer is too small to fit required data
     PROTON_INCORRECT_TARGET_ERROR,          // Message has been sent to the wrong target
     PROTON_UNSUPPORTED_OPERATION_ERROR,     // Message is not a supported operation
+    PROTON_SCHEMA_MISMATCH_ERROR,           // Compact frame from a peer with another schema
   } proton_status_e;
 
   /**
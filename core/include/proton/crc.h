@@ -0,0 +1,79 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_CRC_H
+#define PROTON_CRC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// CRC16-CCITT (polynomial 0x1021, no reflection, no final xor) as used by serial frames
+#define PROTON_CRC16_INIT (uint16_t)0xFFFF
+
+// CRC32C (Castagnoli) starts from 0, the pre and post inversion is done by the update functions
+#define PROTON_CRC32C_INIT (uint32_t)0
+
+  /**
+   * @brief Continue a CRC16-CCITT over more data
+   * @note Start from PROTON_CRC16_INIT. Feeding a buffer in any number of chunks gives the same CRC
+   * as feeding it at once. Eight bytes are folded per step with slicing-by-8 tables, unless
+   * PROTON_CRC16_SLICE_BY_8 is 0, in which case a single 512 byte table is used.
+   *
+   * @param crc CRC of the data so far
+   * @param data Data buffer, may only be null if len is 0
+   * @param len Buffer length
+   * @return uint16_t CRC including data
+   */
+  uint16_t proton_crc16_update(uint16_t crc, const uint8_t * data, size_t len);
+
+  /**
+   * @brief Bit by bit CRC16-CCITT, the reference for proton_crc16_update
+   */
+  uint16_t proton_crc16_update_bitwise(uint16_t crc, const uint8_t * data, size_t len);
+
+  /**
+   * @brief Continue a CRC32C over more data
+   * @note Start from PROTON_CRC32C_INIT. Uses the SSE4.2 or ARMv8 CRC32 instructions when the
+   * host has them, and proton_crc32c_update_sw otherwise.
+   *
+   * @param crc CRC of the data so far
+   * @param data Data buffer, may only be null if len is 0
+   * @param len Buffer length
+   * @return uint32_t CRC including data
+   */
+  uint32_t proton_crc32c_update(uint32_t crc, const uint8_t * data, size_t len);
+
+  /**
+   * @brief Table driven CRC32C, used when there are no CRC instructions
+   */
+  uint32_t proton_crc32c_update_sw(uint32_t crc, const uint8_t * data, size_t len);
+
+  /**
+   * @brief Whether proton_crc32c_update runs on CRC instructions on this host
+   */
+  bool proton_crc32c_hw_supported(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // PROTON_CRC_H
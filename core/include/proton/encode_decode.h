@@ -37,6 +37,63 @@ extern "C"
     proton_registry_t * registry, uint32_t bundle_id, uint8_t * buffer, size_t buffer_len,
     size_t * bytes_encoded);
 
+  /**
+   * Encode a bundle from the registry into a Proton top-level message without going through nanopb.
+   * Message lengths are computed from the signal types and sizes, and the fields are written in a
+   * single pass. The output is byte-identical to proton_encode_bundle.
+   */
+  proton_status_e proton_encode_bundle_direct(
+    proton_registry_t * registry, uint32_t bundle_id, uint8_t * buffer, size_t buffer_len,
+    size_t * bytes_encoded);
+
+  /**
+   * State of a Proton message being built from several bundles, see proton_bundle_set_init
+   */
+  typedef struct proton_bundle_set_encoder
+  {
+    uint8_t * buffer;
+    size_t buffer_len;
+    // Most bytes the finished message may use, the smaller of the buffer length and the MTU
+    size_t limit;
+    // Bytes of encoded bundle entries, stored after the space reserved for the message header
+    size_t payload_len;
+    size_t num_bundles;
+  } proton_bundle_set_encoder_t;
+
+  /**
+   * Start building a Proton message that carries several bundles in buffer.
+   * Bundles are encoded after a few bytes reserved for the message header, so a buffer only just
+   * larger than mtu may fit slightly fewer bundles than mtu allows.
+   * @param mtu largest size of the finished message, 0 to only limit it by buffer_len
+   */
+  proton_status_e proton_bundle_set_init(
+    proton_bundle_set_encoder_t * encoder, uint8_t * buffer, size_t buffer_len, size_t mtu);
+
+  /**
+   * Encode a bundle from the registry into the message.
+   * The first bundle is only limited by the buffer, so that a bundle larger than the MTU can still
+   * be sent on its own.
+   * @return PROTON_INSUFFICIENT_BUFFER_ERROR if the bundle does not fit in the message, which is
+   * left unchanged so that smaller bundles can still be added
+   */
+  proton_status_e proton_bundle_set_add(
+    proton_bundle_set_encoder_t * encoder, proton_registry_t * registry, uint32_t bundle_id);
+
+  /**
+   * Finish the message, moving it to the start of the buffer.
+   * A message holding a single bundle is written as a plain bundle operation, byte-identical to
+   * proton_encode_bundle, so that it is understood by peers without bundle set support.
+   */
+  proton_status_e proton_bundle_set_finish(
+    proton_bundle_set_encoder_t * encoder, size_t * bytes_encoded);
+
+  /**
+   * Called by proton_decode_dispatch and proton_decode_direct after each decoded bundle is written
+   * to the registry
+   */
+  typedef proton_status_e (*proton_bundle_decoded_cb_t)(
+    proton_registry_t * registry, uint32_t bundle_id, void * arg);
+
   /**
    * Decode a Proton message from a buffer
    * If the message is a bundle, the registry will be updated with the decoded signals
@@ -45,6 +102,181 @@ extern "C"
     proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
     proton_Proton * decoded_msg);
 
+  /**
+   * Decode a Proton message from a buffer, calling bundle_decoded for every bundle it carries.
+   * Bundles of a bundle set are written to the registry and dispatched one at a time, in order.
+   * bundle_decoded may be NULL, an error it returns stops decoding and is returned.
+   */
+  proton_status_e proton_decode_dispatch(
+    proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
+    proton_Proton * decoded_msg, proton_bundle_decoded_cb_t bundle_decoded, void * arg);
+
+  /**
+   * Decode a Proton message from a buffer without going through nanopb, calling bundle_decoded for
+   * every bundle it carries as proton_decode_dispatch does.
+   * Each signal is parsed once and checked against the bundle: it must be part of it, have the
+   * registered type and fit the signal capacity. Values are staged in the registry encode/decode
+   * buffer, with string and bytes values left in the input, and are only copied into the registry
+   * once every signal of the bundle is present and valid. A rejected bundle leaves the registry
+   * unchanged.
+   */
+  proton_status_e proton_decode_direct(
+    proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
+    proton_bundle_decoded_cb_t bundle_decoded, void * arg);
+
+  // Bytes of the schema hash at the start of a compact frame
+#define PROTON_COMPACT_HEADER_LEN 4
+  // Bytes of the schema_hash field of a Proton message: a one byte key and a fixed32
+#define PROTON_SCHEMA_HASH_FIELD_LEN 5
+
+  /**
+   * Append the schema_hash field to an encoded Proton message, advertising that the sender accepts
+   * compact frames of that schema. Peers without compact support skip it as an unknown field.
+   * @param len length of the message, updated to include the field
+   */
+  proton_status_e proton_append_schema_hash(
+    uint8_t * buffer, size_t buffer_len, size_t * len, uint32_t schema_hash);
+
+  /**
+   * Find the schema_hash field of an encoded Proton message
+   * @return false if the message has none, or is malformed
+   */
+  bool proton_read_schema_hash(const uint8_t * buffer, size_t buffer_len, uint32_t * schema_hash);
+
+  /**
+   * Encode a bundle as a compact frame, which peers sharing the registry schema_hash decode from
+   * the bundle layout instead of from signal IDs. Transports mark compact frames as such, see
+   * PROTON_UDP4_FLAG_COMPACT and PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT.
+   *
+   * The frame is the schema hash (fixed32), then the bundle ID (varint) and the value of each
+   * signal in bundle order. Delta bundles have a bitmap of the signals present after the ID, one bit per
+   * signal from the least significant bit of the first byte. Doubles and floats are fixed64 and
+   * fixed32, bools a single byte, signed integers zigzag varints, unsigned integers varints, and
+   * strings and bytes a varint length followed by the data.
+   * @return PROTON_UNSUPPORTED_OPERATION_ERROR if the registry has no schema hash
+   */
+  proton_status_e proton_encode_bundle_compact(
+    const proton_registry_t * registry, uint32_t bundle_id, uint8_t * buffer, size_t buffer_len,
+    size_t * bytes_encoded);
+
+  /**
+   * Decode a compact frame, calling bundle_decoded for every bundle it carries as
+   * proton_decode_direct does. Each bundle is validated before any of it is written to the
+   * registry.
+   * @return PROTON_SCHEMA_MISMATCH_ERROR, leaving the registry unchanged, if the frame was encoded
+   * for another schema
+   */
+  proton_status_e proton_decode_compact(
+    proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
+    proton_bundle_decoded_cb_t bundle_decoded, void * arg);
+
+  /**
+   * Bounded view of an input buffer being parsed
+   */
+  typedef struct proton_reader
+  {
+    const uint8_t * pos;
+    const uint8_t * end;
+  } proton_reader_t;
+
+  // Protobuf wire format helpers, shared with the bundle codecs emitted by the generator
+
+  /**
+   * Number of bytes needed to encode a value as a protobuf varint
+   */
+  size_t proton_varint_size(uint64_t value);
+
+  /**
+   * Write a varint, fixed32 or fixed64 value. The caller checks that it fits.
+   * @return position after the written value
+   */
+  uint8_t * proton_write_varint(uint8_t * out, uint64_t value);
+  uint8_t * proton_write_fixed32(uint8_t * out, uint32_t value);
+  uint8_t * proton_write_fixed64(uint8_t * out, uint64_t value);
+
+  /**
+   * Read a varint of at most 10 bytes
+   * @return false if the input ends before the varint does
+   */
+  bool proton_read_varint(proton_reader_t * reader, uint64_t * value);
+
+  /**
+   * Read a little-endian value of size bytes, at most 8
+   */
+  bool proton_read_fixed(proton_reader_t * reader, size_t size, uint64_t * value);
+
+  /**
+   * Read the length of a length-delimited field and point field at its contents
+   */
+  bool proton_read_length_delimited(proton_reader_t * reader, proton_reader_t * field);
+
+  /**
+   * Consume len bytes if they match expected, leaving the reader unchanged otherwise
+   */
+  bool proton_read_expect(proton_reader_t * reader, const uint8_t * expected, size_t len);
+
+  /**
+   * Length of the packed encoding of size bytes of elements of an array type, which is the
+   * payload of the length-delimited value field of an array signal
+   */
+  size_t proton_packed_array_len(proton_signal_type_e type, const void * data, size_t size);
+
+  /**
+   * Write the packed encoding of size bytes of elements of an array type. The caller checks that
+   * proton_packed_array_len bytes fit.
+   * @return position after the written elements
+   */
+  uint8_t * proton_write_packed_array(
+    uint8_t * out, proton_signal_type_e type, const void * data, size_t size);
+
+  /**
+   * Unpack len bytes of packed elements of an array type
+   * @param out destination of the elements, or NULL to only validate them
+   * @param capacity size of out in bytes
+   * @param size receives the size of the unpacked elements in bytes
+   * @return false if an element is malformed or out of range of the type, or the elements do not
+   * fit in capacity
+   */
+  bool proton_read_packed_array(
+    proton_signal_type_e type, const uint8_t * in, size_t len, void * out, size_t capacity,
+    size_t * size);
+
+  // Lossy encodings of float and double signals, see proton_signal_encoding_t
+
+  /**
+   * Convert to IEEE 754 half precision, rounding to nearest even. Values too large for a half
+   * become infinities and NaNs stay NaNs.
+   */
+  uint16_t proton_float_to_half(float value);
+  float proton_half_to_float(uint16_t half);
+
+  /**
+   * Quantize a value to round((value - offset) / scale), saturating at the int64 range. NaN
+   * quantizes to 0.
+   */
+  int64_t proton_quantize(const proton_signal_encoding_t * encoding, double value);
+  double proton_dequantize(const proton_signal_encoding_t * encoding, int64_t quantized);
+
+  /**
+   * Value tag of the Signal field a signal with an encoding is sent as, quantized_value or
+   * half_value
+   */
+  pb_size_t proton_encoding_tag(const proton_signal_encoding_t * encoding);
+
+  /**
+   * Varint the value of a float or double signal with an encoding is sent as. Quantized values
+   * are zigzag encoded like a sint64 field.
+   */
+  uint64_t proton_encode_signal_varint(const signal_desc_t * desc);
+
+  /**
+   * Turn the varint of an encoded float or double signal back into its value
+   * @param signal receives the value and value tag the signal has in the registry
+   * @return false if the varint is out of range of the encoding
+   */
+  bool proton_decode_signal_varint(
+    const signal_desc_t * desc, uint64_t varint, proton_Signal * signal);
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,6 +16,11 @@ typedef struct _proton_Bundle {
     pb_callback_t signals;
 } proton_Bundle;
 
+/* Several bundles sent to the same peers in one message */
+typedef struct _proton_BundleSet {
+    pb_callback_t bundles;
+} proton_BundleSet;
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,11 +28,14 @@ extern "C" {
 
 /* Initializer values for message structs */
 #define proton_Bundle_init_default               {0, {{NULL}, NULL}}
+#define proton_BundleSet_init_default            {{{NULL}, NULL}}
 #define proton_Bundle_init_zero                  {0, {{NULL}, NULL}}
+#define proton_BundleSet_init_zero               {{{NULL}, NULL}}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define proton_Bundle_id_tag                     1
 #define proton_Bundle_signals_tag                2
+#define proton_BundleSet_bundles_tag             1
 
 /* Struct field encoding specification for nanopb */
 #define proton_Bundle_FIELDLIST(X, a) \
@@ -37,13 +45,22 @@ X(a, CALLBACK, REPEATED, MESSAGE,  signals,           2)
 #define proton_Bundle_DEFAULT NULL
 #define proton_Bundle_signals_MSGTYPE proton_Signal
 
+#define proton_BundleSet_FIELDLIST(X, a) \
+X(a, CALLBACK, REPEATED, MESSAGE,  bundles,           1)
+#define proton_BundleSet_CALLBACK pb_default_field_callback
+#define proton_BundleSet_DEFAULT NULL
+#define proton_BundleSet_bundles_MSGTYPE proton_Bundle
+
 extern const pb_msgdesc_t proton_Bundle_msg;
+extern const pb_msgdesc_t proton_BundleSet_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define proton_Bundle_fields &proton_Bundle_msg
+#define proton_BundleSet_fields &proton_BundleSet_msg
 
 /* Maximum encoded size of messages (where known) */
 /* proton_Bundle_size depends on runtime parameters */
+/* proton_BundleSet_size depends on runtime parameters */
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -16,8 +16,11 @@ typedef struct _proton_Proton {
     pb_callback_t cb_operation;
     pb_size_t which_operation;
     union {
-        proton_Bundle bundle; /* Reserved for future operation types */
+        proton_Bundle bundle;
+        proton_BundleSet bundle_set; /* Reserved for future operation types */
     } operation;
+    /* Schema hash of the sender, advertised by nodes that accept compact frames */
+    uint32_t schema_hash;
 } proton_Proton;
 
 
@@ -26,18 +29,23 @@ extern "C" {
 #endif
 
 /* Initializer values for message structs */
-#define proton_Proton_init_default               {{{NULL}, NULL}, 0, {proton_Bundle_init_default}}
-#define proton_Proton_init_zero                  {{{NULL}, NULL}, 0, {proton_Bundle_init_zero}}
+#define proton_Proton_init_default               {{{NULL}, NULL}, 0, {proton_Bundle_init_default}, 0}
+#define proton_Proton_init_zero                  {{{NULL}, NULL}, 0, {proton_Bundle_init_zero}, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define proton_Proton_bundle_tag                 1
+#define proton_Proton_bundle_set_tag             2
+#define proton_Proton_schema_hash_tag            15
 
 /* Struct field encoding specification for nanopb */
 #define proton_Proton_FIELDLIST(X, a) \
-X(a, STATIC,   ONEOF,    MSG_W_CB, (operation,bundle,operation.bundle),   1)
+X(a, STATIC,   ONEOF,    MSG_W_CB, (operation,bundle,operation.bundle),   1) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (operation,bundle_set,operation.bundle_set),   2) \
+X(a, STATIC,   SINGULAR, FIXED32,  schema_hash,      15)
 #define proton_Proton_CALLBACK NULL
 #define proton_Proton_DEFAULT NULL
 #define proton_Proton_operation_bundle_MSGTYPE proton_Bundle
+#define proton_Proton_operation_bundle_set_MSGTYPE proton_BundleSet
 
 extern const pb_msgdesc_t proton_Proton_msg;
 
@@ -45,11 +53,12 @@ extern const pb_msgdesc_t proton_Proton_msg;
 #define proton_Proton_fields &proton_Proton_msg
 
 /* Maximum encoded size of messages (where known) */
-#if defined(proton_Bundle_size)
+#if defined(proton_Bundle_size) && defined(proton_BundleSet_size)
+union proton_Proton_operation_size_union {char f1[(6 + proton_Bundle_size)]; char f2[(6 + proton_BundleSet_size)];};
 #endif
-#if defined(proton_Bundle_size)
+#if defined(proton_Bundle_size) && defined(proton_BundleSet_size)
 #define PROTON_PROTON_PB_H_MAX_SIZE              proton_Proton_size
-#define proton_Proton_size                       (6 + proton_Bundle_size)
+#define proton_Proton_size                       (5 + sizeof(union proton_Proton_operation_size_union))
 #endif
 
 #ifdef __cplusplus
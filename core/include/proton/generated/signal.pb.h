@@ -22,6 +22,21 @@ typedef struct _proton_Signal {
         bool bool_value;
         void * string_value;
         void * bytes_value;
+        /* Set of up to 64 flags, bit n holding flag n */
+        uint64_t flags_value;
+        /* Arrays of up to the signal capacity elements. Their bytes are the encoding of a packed
+     repeated field of the element type, which a oneof cannot hold directly. */
+        void * double_array_value;
+        void * float_array_value;
+        void * int32_array_value;
+        void * int64_array_value;
+        void * uint32_array_value;
+        void * uint64_array_value;
+        /* Float and double signals sent with a lossy encoding. A quantized value stands for
+     offset + scale * quantized_value, with the scale and offset of the signal config. A half
+     value holds the bits of an IEEE 754 half precision number. */
+        int64_t quantized_value;
+        uint32_t half_value;
     } signal;
     uint32_t id;
 } proton_Signal;
@@ -45,6 +60,15 @@ extern "C" {
 #define proton_Signal_bool_value_tag             7
 #define proton_Signal_string_value_tag           8
 #define proton_Signal_bytes_value_tag            9
+#define proton_Signal_flags_value_tag            10
+#define proton_Signal_double_array_value_tag     11
+#define proton_Signal_float_array_value_tag      12
+#define proton_Signal_int32_array_value_tag      13
+#define proton_Signal_int64_array_value_tag      14
+#define proton_Signal_uint32_array_value_tag     15
+#define proton_Signal_uint64_array_value_tag     16
+#define proton_Signal_quantized_value_tag        17
+#define proton_Signal_half_value_tag             18
 #define proton_Signal_id_tag                     19
 
 /* Struct field encoding specification for nanopb */
@@ -58,6 +82,15 @@ X(a, STATIC,   ONEOF,    UINT64,   (signal,uint64_value,signal.uint64_value),
 X(a, STATIC,   ONEOF,    BOOL,     (signal,bool_value,signal.bool_value),   7) \
 X(a, CALLBACK, ONEOF,    STRING,   (signal,string_value,signal.string_value),   8) \
 X(a, CALLBACK, ONEOF,    BYTES,    (signal,bytes_value,signal.bytes_value),   9) \
+X(a, STATIC,   ONEOF,    UINT64,   (signal,flags_value,signal.flags_value),  10) \
+X(a, CALLBACK, ONEOF,    BYTES,    (signal,double_array_value,signal.double_array_value),  11) \
+X(a, CALLBACK, ONEOF,    BYTES,    (signal,float_array_value,signal.float_array_value),  12) \
+X(a, CALLBACK, ONEOF,    BYTES,    (signal,int32_array_value,signal.int32_array_value),  13) \
+X(a, CALLBACK, ONEOF,    BYTES,    (signal,int64_array_value,signal.int64_array_value),  14) \
+X(a, CALLBACK, ONEOF,    BYTES,    (signal,uint32_array_value,signal.uint32_array_value),  15) \
+X(a, CALLBACK, ONEOF,    BYTES,    (signal,uint64_array_value,signal.uint64_array_value),  16) \
+X(a, STATIC,   ONEOF,    SINT64,   (signal,quantized_value,signal.quantized_value),  17) \
+X(a, STATIC,   ONEOF,    UINT32,   (signal,half_value,signal.half_value),  18) \
 X(a, STATIC,   SINGULAR, UINT32,   id,               19)
 extern bool proton_Signal_callback(pb_istream_t *istream, pb_ostream_t *ostream, const pb_field_t *field);
 #define proton_Signal_CALLBACK proton_Signal_callback
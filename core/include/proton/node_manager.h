@@ -44,8 +44,44 @@ extern "C"
     uint32_t node_id;
     uint32_t endpoint_id;
     proton_transport_type_e transport_type;
+    // Largest message proton_node_update_coalesced sends to this peer, 0 for no limit
+    uint16_t mtu;
   } proton_endpoint_t;
 
+  /**
+   * Entry in the periodic bundle schedule, ordered by deadline (last_send_ms + period_ms)
+   */
+  typedef struct proton_schedule_entry
+  {
+    uint64_t deadline_ms;
+    uint16_t slot;
+  } proton_schedule_entry_t;
+
+  /**
+   * Deadline-ordered schedule of the bundles a node produces, used by proton_node_update.
+   * Periodic bundles are kept in a min-heap keyed by deadline, and triggered bundles in a separate
+   * lane that is always served first. heap and triggered are user-provided storage of capacity
+   * entries each, which should be at least the number of bundles in the registry. If the storage is
+   * NULL or too small, proton_node_update falls back to scanning the whole bundle table.
+   *
+   * The schedule is built on the first update and rebuilt when the registry or its bundle periods
+   * change (through proton_registry_set_bundle_period). Writing last_send_ms, period_ms or send_now
+   * directly after the first update requires a call to proton_node_reset_scheduler.
+   */
+  typedef struct proton_node_scheduler
+  {
+    proton_schedule_entry_t * heap;
+    uint16_t * triggered;
+    uint16_t capacity;
+    uint16_t heap_size;
+    uint16_t triggered_size;
+    bool initialized;
+    // Registry state the schedule was built for
+    const bundle_desc_t * bundle_table;
+    uint16_t bundle_count;
+    uint32_t bundle_schedule_version;
+  } proton_node_scheduler_t;
+
   /**
    * Top-level struct for proton interaction, this is the main struct that users will interact with
    * to send and receive bundles. It contains a pointer to the registry, as well as information about
@@ -60,6 +96,11 @@ extern "C"
     uint32_t pending_triggers[PROTON_MAX_PENDING_TRIGGERS];
     uint8_t trigger_head;
     uint8_t trigger_tail;
+    proton_node_scheduler_t scheduler;
+    // Schema hash each destination peer last advertised, one entry per destination peer and 0 while
+    // unknown. NULL disables compact frames, and the node then neither advertises its schema nor
+    // records the schemas of its peers.
+    uint32_t * peer_schema_hashes;
   } proton_node_t;
 
   /**
@@ -70,9 +111,25 @@ extern "C"
    *
    * This function will decode the message, update the signal registry with new information,
    * and call the relevant bundle callback if a bundle is successfully decoded.
+   * For a bundle set, each contained bundle is written to the registry and its callback called in
+   * turn.
    */
   proton_status_e proton_node_receive(proton_node_t * node, const uint8_t * buffer, size_t len);
 
+  /**
+   * Receive a message for a node, as proton_node_receive, with the frame flags the transport read
+   * (PROTON_FRAME_FLAG_*) and the ID of the sending node.
+   *
+   * Compact frames are decoded against the node's schema, and rejected with
+   * PROTON_SCHEMA_MISMATCH_ERROR without touching the registry when the sender uses another schema.
+   * The schema hash of the frame, or the one a normal message advertises, is recorded for every
+   * destination endpoint of the sending node, so proton_node_update_batch only sends compact frames
+   * to peers that are known to decode them.
+   */
+  proton_status_e proton_node_receive_frame(
+    proton_node_t * node, const uint8_t * buffer, size_t len, uint32_t peer_node_id,
+    uint8_t frame_flags);
+
   /**
    * Update function to be called periodically by the user to check if there are any messages to send
    * This function will encode bundles by a priority scheme:
@@ -87,6 +144,100 @@ extern "C"
     proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len, size_t * out_len,
     proton_endpoint_t * dest_peers, size_t num_dest_peers, size_t * num_selected_peers);
 
+  /**
+   * @typedef fill the transport header and trailer around a message encoded in place.
+   * Called with the start of the frame, the length of the message that follows the headroom, the
+   * PROTON_FRAME_FLAG_* bits of the message, and the framing arg.
+   */
+  typedef proton_status_e (*proton_frame_fill_f)(uint8_t *, size_t, uint8_t, void *);
+
+  /**
+   * Transport framing of messages encoded by proton_node_update_framed. The message is encoded
+   * headroom bytes into the buffer, leaving tailroom bytes free after it, and fill writes the
+   * transport header and trailer around it. See PROTON_SERIAL_FRAMING and PROTON_UDP4_FRAMING.
+   */
+  typedef struct proton_framing
+  {
+    size_t headroom;
+    size_t tailroom;
+    // May be NULL to only reserve the space
+    proton_frame_fill_f fill;
+    void * arg;
+  } proton_framing_t;
+
+  /**
+   * Update as proton_node_update, encoding the message straight into a transport frame so that it
+   * does not have to be copied between a header and a trailer before it is sent.
+   * On success out_len is the length of the whole frame, headroom and tailroom included.
+   * A NULL framing encodes a bare message, as proton_node_update does.
+   */
+  proton_status_e proton_node_update_framed(
+    proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len,
+    const proton_framing_t * framing, size_t * out_len, proton_endpoint_t * dest_peers,
+    size_t num_dest_peers, size_t * num_selected_peers);
+
+  /**
+   * Location of one encoded bundle in the output of proton_node_update_batch
+   */
+  typedef struct proton_bundle_record
+  {
+    // Position and size of the encoded bundle in the output buffer
+    size_t offset;
+    size_t length;
+    uint32_t bundle_id;
+    // Destination peers of the bundle, pointing into the dest_peers array given to the update
+    const proton_endpoint_t * peers;
+    size_t num_peers;
+    // PROTON_FRAME_FLAG_* bits the transport should send with the bundle
+    uint8_t frame_flags;
+  } proton_bundle_record_t;
+
+  /**
+   * Encode every bundle that is due to be sent, in one pass with the registry locked.
+   * Bundles are selected in the same order that repeated calls to proton_node_update would send
+   * them, and are encoded back to back into buffer, with one record per bundle written to records.
+   * Each record's destination peers are written consecutively to dest_peers.
+   *
+   * Encoding stops when nothing else is due, or when records, buffer or dest_peers run out of
+   * space. Bundles that did not fit stay scheduled and are returned by the next call.
+   * A bundle whose destination peers all advertised the node's schema is encoded as a compact
+   * frame, and its record has PROTON_FRAME_FLAG_COMPACT set.
+   * @return PROTON_OK on success, even when no bundle was due (*num_records is 0). If the first
+   * selected bundle cannot be encoded, the error is returned as for proton_node_update.
+   */
+  proton_status_e proton_node_update_batch(
+    proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len,
+    proton_bundle_record_t * records, size_t max_records, size_t * num_records,
+    proton_endpoint_t * dest_peers, size_t num_dest_peers);
+
+  /**
+   * Update function that packs several due bundles into one message, to reduce the number of
+   * packets sent over links with a high per-packet cost.
+   * The bundle to send is selected as in proton_node_update. Every other due bundle with the same
+   * consumers is then added, in bundle table order, as long as the message stays within buffer_len
+   * and the smallest non-zero MTU of the destination peers. A message holding several bundles is
+   * encoded as a bundle set, and a single bundle as a plain bundle.
+   */
+  proton_status_e proton_node_update_coalesced(
+    proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len, size_t * out_len,
+    proton_endpoint_t * dest_peers, size_t num_dest_peers, size_t * num_selected_peers);
+
+  /**
+   * Discard the node's bundle schedule so that it is rebuilt from the registry on the next update.
+   * Required after writing bundle timing state (last_send_ms, period_ms, send_now) directly.
+   */
+  void proton_node_reset_scheduler(proton_node_t * node);
+
+  /**
+   * Find when proton_node_update next has a bundle to send, so that an event loop can sleep until
+   * then instead of polling. A pending trigger makes the deadline uptime_ms, otherwise it is the
+   * earliest last_send_ms + period_ms of the periodic bundles the node produces, which may already
+   * be in the past.
+   * @param has_deadline set to false if the node produces no periodic or triggered bundle
+   */
+  proton_status_e proton_node_next_deadline(
+    proton_node_t * node, uint64_t uptime_ms, uint64_t * deadline_ms, bool * has_deadline);
+
   /**
    * Set a bundle ID to be sent at the next available node update, according to priority rules.
    */
@@ -100,6 +251,14 @@ extern "C"
     size_t buffer_len, size_t * out_len, proton_endpoint_t * dest_peers, size_t num_dest_peers,
     size_t * num_selected_peers);
 
+  /**
+   * Encode a bundle by ID straight into a transport frame, see proton_node_update_framed
+   */
+  proton_status_e proton_node_encode_bundle_framed(
+    proton_node_t * node, uint32_t bundle_id, uint64_t uptime_ms, uint8_t * buffer,
+    size_t buffer_len, const proton_framing_t * framing, size_t * out_len,
+    proton_endpoint_t * dest_peers, size_t num_dest_peers, size_t * num_selected_peers);
+
 #ifdef __cplusplus
 }
 #endif
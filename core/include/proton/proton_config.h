@@ -32,6 +32,17 @@
 #define PROTON_MAX_PENDING_TRIGGERS 4
 #endif
 
+// Copies proton_bundle_snapshot makes while a signal of the bundle is being written, before it
+// waits for the registry lock instead
+#ifndef PROTON_SNAPSHOT_ATTEMPTS
+#define PROTON_SNAPSHOT_ATTEMPTS 64
+#endif
+
+// Fold CRC16 eight bytes at a time with 4 KiB of tables, 0 uses a single 512 byte table
+#ifndef PROTON_CRC16_SLICE_BY_8
+#define PROTON_CRC16_SLICE_BY_8 1
+#endif
+
 #ifndef PROTON_NODE_BUILDER
 #define PROTON_NODE_BUILDER 0
 #endif
@@ -74,8 +74,18 @@ extern "C"
     PROTON_BOOL = proton_Signal_bool_value_tag,
     PROTON_STRING = proton_Signal_string_value_tag,
     PROTON_BYTES = proton_Signal_bytes_value_tag,
+    PROTON_FLAGS = proton_Signal_flags_value_tag,
+    PROTON_DOUBLE_ARRAY = proton_Signal_double_array_value_tag,
+    PROTON_FLOAT_ARRAY = proton_Signal_float_array_value_tag,
+    PROTON_INT32_ARRAY = proton_Signal_int32_array_value_tag,
+    PROTON_INT64_ARRAY = proton_Signal_int64_array_value_tag,
+    PROTON_UINT32_ARRAY = proton_Signal_uint32_array_value_tag,
+    PROTON_UINT64_ARRAY = proton_Signal_uint64_array_value_tag,
   } proton_signal_type_e;
 
+// Number of flags a PROTON_FLAGS signal holds, one per bit of its uint64 value
+#define PROTON_FLAGS_MAX_BITS 64
+
   typedef struct proton_buffer
   {
     uint8_t * data;
@@ -91,6 +101,46 @@ extern "C"
     uint8_t count;
   } proton_id_list_t;
 
+  /**
+   * Marks an unused slot in a proton_lookup_index_t
+   */
+#define PROTON_LOOKUP_INDEX_EMPTY UINT16_MAX
+
+  /**
+   * Open-addressed hash index mapping an ID to its position in a registry table.
+   * slots holds table positions (PROTON_LOOKUP_INDEX_EMPTY for unused slots) and capacity must be a
+   * power of two larger than the number of entries. Collisions are resolved by linear probing.
+   * An index with NULL slots or 0 capacity is disabled, and lookups fall back to a linear scan.
+   */
+  typedef struct proton_lookup_index
+  {
+    const uint16_t * slots;
+    uint16_t capacity;
+  } proton_lookup_index_t;
+
+  /**
+   * @typedef lossy wire encoding of a float or double signal
+   */
+  typedef enum proton_signal_encoding_type
+  {
+    // round((value - offset) / scale), sent as a zigzag varint
+    PROTON_ENCODING_QUANTIZED,
+    // IEEE 754 half precision, sent as a varint of its 16 bits
+    PROTON_ENCODING_FLOAT16,
+  } proton_signal_encoding_type_e;
+
+  /**
+   * Wire encoding of a float or double signal. The registry and the accessors still hold the
+   * float or double value, it is only converted when the signal is encoded and decoded.
+   */
+  typedef struct proton_signal_encoding
+  {
+    proton_signal_encoding_type_e type;
+    // Quantization step and value of 0, used by PROTON_ENCODING_QUANTIZED
+    double scale;
+    double offset;
+  } proton_signal_encoding_t;
+
   /**
    * Descriptor for a signal in the registry
    * Contains information for encoding/decoding the signal, as well as the signal's current value
@@ -99,15 +149,55 @@ extern "C"
   {
     uint32_t id;
     proton_signal_type_e type;
-    // For strings and bytes, current size of the signal. For other types, this is the size of the internal type.
+    // For strings, bytes and arrays, current size of the signal in bytes. For other types, this is the size of the internal type.
     uint16_t value_size;
-    // For strings and bytes, max size of the signal. Others, 0
+    // For strings, bytes and arrays, max size of the signal in bytes. Others, 0
     uint16_t capacity;
     proton_Signal signal;
-    // Decode buffer for string/bytes signals (NULL for other types)
+    // Decode buffer for string/bytes/array signals (NULL for other types)
     proton_buffer_t signal_decode_buffer;
+    // Incremented every time the value is written by a setter or a decoded bundle
+    uint32_t version;
+    // Odd while the value is being written, so that proton_bundle_snapshot can copy it without the
+    // registry lock and tell when it raced a writer
+    uint32_t sequence;
+    // Wire encoding of a float or double signal, NULL to send the value as it is
+    const proton_signal_encoding_t * encoding;
   } signal_desc_t;
 
+  /**
+   * @typedef signal handle, a signal resolved once by proton_registry_resolve_signal.
+   * Handle accessors index the signal registry directly instead of looking the signal up by ID.
+   * Handles stay valid for copies of the registry they were resolved in, as long as the signals
+   * keep their order.
+   */
+  typedef struct proton_signal_handle
+  {
+    uint16_t index;
+    // Type the handle was resolved for, PROTON_INVALID_TYPE for an unresolved handle
+    proton_signal_type_e type;
+  } proton_signal_handle_t;
+
+#define PROTON_SIGNAL_HANDLE_INIT {.index = UINT16_MAX, .type = PROTON_INVALID_TYPE}
+
+  struct proton_registry;
+
+  /**
+   * Encoder and decoder specialized for the signal layout of one bundle, see target_codec.c.jinja.
+   * encode writes the bundle as a Proton message byte-identical to proton_encode_bundle, returning
+   * PROTON_INSUFFICIENT_BUFFER_ERROR if it does not fit in buffer_len.
+   * decode takes the body of a Bundle message and writes it to the registry only if it is valid and
+   * laid out the way encode writes it. It returns false otherwise, without changing the registry,
+   * so that the generic decoder can handle the message.
+   */
+  typedef struct proton_bundle_codec
+  {
+    proton_status_e (*encode)(
+      const struct proton_registry * registry, uint8_t * buffer, size_t buffer_len,
+      size_t * bytes_encoded);
+    bool (*decode)(struct proton_registry * registry, const uint8_t * buffer, size_t len);
+  } proton_bundle_codec_t;
+
   /**
    * Descriptor for a bundle, containing the ID, which nodes produce/consume it, and the signals within
    */
@@ -117,12 +207,27 @@ extern "C"
     proton_id_list_t producer_ids;
     proton_id_list_t consumer_ids;
     proton_id_list_t signal_ids;
+    // Optional registry index of each signal in signal_ids, NULL to look signals up by ID
+    const uint16_t * signal_indices;
+    // Optional map from signal ID to its position in signal_ids, used when decoding
+    proton_lookup_index_t signal_slots;
     uint64_t last_send_ms;
     // NOTE: 0 means no period, and will only be sent if triggered or directly requested in the node manager API
     uint32_t period_ms;
     bool send_now;
     // Callback for when this bundle is successfully decoded
     proton_bundle_cb_t callback;
+    // Optional codec generated for this bundle, NULL to use the generic encoder and decoder
+    const proton_bundle_codec_t * codec;
+    // Delta bundles may be sent with only the signals that changed, and are accepted partial
+    bool delta;
+    // Sends between two full bundles of a delta bundle, 0 to only send the first one in full
+    uint16_t keyframe_interval;
+    // Sends since the last full bundle, 0 when the next send must be a full bundle
+    uint16_t sends_since_keyframe;
+    // Version of each signal in signal_ids when the bundle was last sent, needed by a delta bundle
+    // to be sent with only its changed signals. NULL to always send every signal.
+    uint32_t * sent_versions;
   } bundle_desc_t;
 
   /**
@@ -157,6 +262,18 @@ extern "C"
 
     // Optional mutex callbacks
     proton_registry_mutex_cb_t mutex_handles;
+
+    // Optional ID lookup indices, see proton_registry_build_index
+    proton_lookup_index_t bundle_index;
+    proton_lookup_index_t signal_index;
+
+    // Incremented whenever a bundle period is changed through the registry API, so node schedulers
+    // know to rebuild
+    uint32_t bundle_schedule_version;
+
+    // Hash of the bundle layouts of the config the registry was generated from, which peers must
+    // share to exchange compact frames. 0 if unknown, which disables compact frames.
+    uint32_t schema_hash;
   } proton_registry_t;
 
   /**
@@ -170,6 +287,58 @@ extern "C"
   proton_status_e proton_lock_registry(const proton_registry_t * registry);
   proton_status_e proton_unlock_registry(const proton_registry_t * registry);
 
+  /**
+   * Hash used to place an ID in a proton_lookup_index_t.
+   * The generator scripts mirror this function to emit static index tables, so both must be kept
+   * in sync.
+   */
+  uint32_t proton_lookup_index_hash(uint32_t id);
+
+  /**
+   * Smallest index capacity for a table of count entries, keeping the load factor at or below 50%.
+   * @return power of two capacity, or 0 if count is too large to be indexed
+   */
+  uint16_t proton_lookup_index_capacity(size_t count);
+
+  /**
+   * Build the bundle and signal lookup indices of a registry into caller-provided slot storage.
+   * Each slot array must hold proton_lookup_index_capacity() entries for its table.
+   * Passing NULL storage disables the corresponding index.
+   * The indices must be rebuilt if the bundle or signal tables are reordered or their IDs change.
+   * @return PROTON_OK on success, PROTON_INSUFFICIENT_BUFFER_ERROR if a capacity is too small or not
+   * a power of two (the index is left disabled)
+   */
+  proton_status_e proton_registry_build_index(
+    proton_registry_t * registry, uint16_t * bundle_slots, uint16_t bundle_capacity,
+    uint16_t * signal_slots, uint16_t signal_capacity);
+
+  /**
+   * Resolve the signal_indices and signal_slots tables of a bundle into caller-provided storage.
+   * signal_indices must hold signal_ids.count entries, and signal_slots must hold
+   * proton_lookup_index_capacity(signal_ids.count) entries. Either may be NULL to leave that table
+   * disabled.
+   * @return PROTON_OK on success, PROTON_ERROR if a signal of the bundle is not in the registry,
+   * PROTON_INSUFFICIENT_BUFFER_ERROR if slot_capacity is too small or not a power of two
+   */
+  proton_status_e proton_registry_build_bundle_index(
+    const proton_registry_t * registry, bundle_desc_t * bundle, uint16_t * signal_indices,
+    uint16_t * signal_slots, uint16_t slot_capacity);
+
+  /**
+   * Get the position of a signal within a bundle's signal_ids
+   * @return true if the signal is part of the bundle, in which case *slot is set
+   */
+  bool proton_bundle_get_signal_slot(
+    const bundle_desc_t * bundle, uint32_t signal_id, size_t * slot);
+
+  /**
+   * Get the descriptor of the signal at a position in a bundle's signal_ids.
+   * Uses the bundle's signal_indices when present, falling back to a lookup by ID.
+   * @return pointer to the signal descriptor, or NULL if not found
+   */
+  signal_desc_t * proton_registry_get_bundle_signal(
+    const proton_registry_t * registry, const bundle_desc_t * bundle, size_t slot);
+
   /**
    * Get the bundle from a registry by ID
    * slot_idx is optional output parameter for the index of the bundle in the registry
@@ -206,6 +375,72 @@ extern "C"
   void proton_registry_set_bundle_period(
     proton_registry_t * registry, uint32_t bundle_id, uint32_t period_ms);
 
+  /**
+   * Whether the next send of a bundle carries every signal of the bundle, which is always the case
+   * unless it is a delta bundle with sent_versions between two keyframes
+   */
+  bool proton_bundle_keyframe_due(const bundle_desc_t * bundle);
+
+  /**
+   * Whether a signal of a bundle changed since the bundle was last sent
+   * @param slot position of the signal in the bundle signal_ids
+   */
+  bool proton_bundle_signal_changed(
+    const proton_registry_t * registry, const bundle_desc_t * bundle, size_t slot);
+
+  /**
+   * Record that a bundle was sent: the current version of each of its signals is stored in
+   * sent_versions and the keyframe count advances. Called by the node manager once a bundle is
+   * encoded for sending.
+   */
+  void proton_bundle_mark_sent(const proton_registry_t * registry, bundle_desc_t * bundle);
+
+  /**
+   * Make the next send of a bundle a full bundle, such as when a consumer reconnects
+   */
+  void proton_registry_request_keyframe(proton_registry_t * registry, uint32_t bundle_id);
+
+  /**
+   * A signal value copied out of the registry by proton_bundle_snapshot
+   */
+  typedef struct proton_signal_value
+  {
+    uint32_t id;
+    proton_signal_type_e type;
+    // Size of the value in bytes, including the null terminator of a string if it has one
+    uint16_t value_size;
+    // Version and sequence of the signal when it was copied
+    uint32_t version;
+    uint32_t sequence;
+    // Scalars are held in the field of their type. Strings, bytes and arrays point into the buffer
+    // given to proton_bundle_snapshot, at an 8 byte aligned offset.
+    proton_Signal signal;
+  } proton_signal_value_t;
+
+  /**
+   * Mark every signal of a bundle as being written, before a decoded bundle is copied into the
+   * registry, and as written once it is. Writers still serialize on the registry lock, the marks
+   * only tell snapshots to retry.
+   */
+  void proton_bundle_begin_write(const proton_registry_t * registry, const bundle_desc_t * bundle);
+  void proton_bundle_end_write(const proton_registry_t * registry, const bundle_desc_t * bundle);
+
+  /**
+   * Copy every signal of a bundle, all as they were at one point in time, without taking the
+   * registry lock. The copy is retried if a signal was written meanwhile, and only after
+   * PROTON_SNAPSHOT_ATTEMPTS attempts does the snapshot wait for the lock, so that a reader
+   * preempted by a writer on the same core still finishes. Safe to call with the lock held.
+   * @param values Filled with one value per signal of the bundle, in bundle order
+   * @param buffer Holds the string, bytes and array values the values point to
+   * @param count Number of values
+   * @return PROTON_ERROR if the bundle or one of its signals is not in the registry,
+   * PROTON_INSUFFICIENT_BUFFER_ERROR if values or buffer are too small, and PROTON_MUTEX_ERROR if
+   * the lock could not be taken
+   */
+  proton_status_e proton_bundle_snapshot(
+    const proton_registry_t * registry, uint32_t bundle_id, proton_signal_value_t * values,
+    size_t capacity, uint8_t * buffer, size_t buffer_len, size_t * count);
+
   /**
    * Get the signal from a registry by ID
    * registry_idx is optional output parameter for the index of the signal in the registry
@@ -214,6 +449,17 @@ extern "C"
   signal_desc_t * proton_registry_get_signal(
     const proton_registry_t * registry, uint32_t signal_id, size_t * registry_idx);
 
+  /**
+   * Resolve a signal ID into a handle for the handle accessors.
+   * @param expected_type type the handle will be used with, PROTON_INVALID_TYPE to take the
+   * registered type of the signal
+   * @return PROTON_ERROR if the signal is not in the registry or has a different type, in which
+   * case handle is left unresolved
+   */
+  proton_status_e proton_registry_resolve_signal(
+    const proton_registry_t * registry, uint32_t signal_id, proton_signal_type_e expected_type,
+    proton_signal_handle_t * handle);
+
   /**
    * Get the signal type from a protobuf tag
    * @return the signal type
@@ -228,10 +474,23 @@ extern "C"
 
   /**
    * Get the size of a value for a given type, for string/bytes types, return given capacity
-   * @return the size of the value for the type, or capacity for string/bytes types
+   * @param capacity capacity of a string/bytes signal in bytes, or of an array in elements
+   * @return the size of the value for the type, capacity for string/bytes types, or the size of
+   * capacity elements for array types
    */
   uint16_t get_signal_value_size(proton_signal_type_e type, uint32_t capacity);
 
+  /**
+   * Whether a type is one of the packed numeric array types
+   */
+  bool proton_is_array_type(proton_signal_type_e type);
+
+  /**
+   * Size of one element of an array type
+   * @return the element size, or 0 if type is not an array type
+   */
+  size_t proton_array_element_size(proton_signal_type_e type);
+
   /**
    * Get the signal type from a string representation. Used for parsing config files
    * @return the signal type, or PROTON_INVALID_TYPE if the string does not match a valid type
@@ -258,6 +517,9 @@ extern "C"
    *                                     registered capacity for the signal
    *
    * For string/bytes getters, *out_len receives the number of bytes copied.
+   *
+   * Flags signals are read and written whole with the flags accessors, or one bit at a time with
+   * the flag accessors, which return PROTON_ERROR for a bit of PROTON_FLAGS_MAX_BITS or more.
    */
 
   proton_status_e proton_signal_get_double(
@@ -307,6 +569,140 @@ extern "C"
   proton_status_e proton_signal_set_bytes(
     const proton_registry_t * registry, uint32_t signal_id, const uint8_t * data, size_t len);
 
+  proton_status_e proton_signal_get_flags(
+    const proton_registry_t * registry, uint32_t signal_id, uint64_t * value);
+  proton_status_e proton_signal_set_flags(
+    const proton_registry_t * registry, uint32_t signal_id, uint64_t value);
+
+  proton_status_e proton_signal_get_flag(
+    const proton_registry_t * registry, uint32_t signal_id, uint8_t bit, bool * value);
+  proton_status_e proton_signal_set_flag(
+    const proton_registry_t * registry, uint32_t signal_id, uint8_t bit, bool value);
+
+  /*
+   * Handle-based typed accessors, with the same semantics as the ID-based accessors above.
+   * They return PROTON_ERROR for a handle that is unresolved, was resolved for another type, or
+   * is out of range of the registry.
+   */
+
+  proton_status_e proton_signal_handle_get_double(
+    const proton_registry_t * registry, proton_signal_handle_t handle, double * value);
+  proton_status_e proton_signal_handle_set_double(
+    const proton_registry_t * registry, proton_signal_handle_t handle, double value);
+
+  proton_status_e proton_signal_handle_get_float(
+    const proton_registry_t * registry, proton_signal_handle_t handle, float * value);
+  proton_status_e proton_signal_handle_set_float(
+    const proton_registry_t * registry, proton_signal_handle_t handle, float value);
+
+  proton_status_e proton_signal_handle_get_int32(
+    const proton_registry_t * registry, proton_signal_handle_t handle, int32_t * value);
+  proton_status_e proton_signal_handle_set_int32(
+    const proton_registry_t * registry, proton_signal_handle_t handle, int32_t value);
+
+  proton_status_e proton_signal_handle_get_int64(
+    const proton_registry_t * registry, proton_signal_handle_t handle, int64_t * value);
+  proton_status_e proton_signal_handle_set_int64(
+    const proton_registry_t * registry, proton_signal_handle_t handle, int64_t value);
+
+  proton_status_e proton_signal_handle_get_uint32(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint32_t * value);
+  proton_status_e proton_signal_handle_set_uint32(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint32_t value);
+
+  proton_status_e proton_signal_handle_get_uint64(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint64_t * value);
+  proton_status_e proton_signal_handle_set_uint64(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint64_t value);
+
+  proton_status_e proton_signal_handle_get_bool(
+    const proton_registry_t * registry, proton_signal_handle_t handle, bool * value);
+  proton_status_e proton_signal_handle_set_bool(
+    const proton_registry_t * registry, proton_signal_handle_t handle, bool value);
+
+  proton_status_e proton_signal_handle_get_string(
+    const proton_registry_t * registry, proton_signal_handle_t handle, char * buf,
+    size_t capacity, size_t * out_len);
+  proton_status_e proton_signal_handle_set_string(
+    const proton_registry_t * registry, proton_signal_handle_t handle, const char * str,
+    size_t len);
+
+  proton_status_e proton_signal_handle_get_bytes(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint8_t * buf,
+    size_t capacity, size_t * out_len);
+  proton_status_e proton_signal_handle_set_bytes(
+    const proton_registry_t * registry, proton_signal_handle_t handle, const uint8_t * data,
+    size_t len);
+
+  proton_status_e proton_signal_handle_get_flags(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint64_t * value);
+  proton_status_e proton_signal_handle_set_flags(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint64_t value);
+
+  proton_status_e proton_signal_handle_get_flag(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint8_t bit, bool * value);
+  proton_status_e proton_signal_handle_set_flag(
+    const proton_registry_t * registry, proton_signal_handle_t handle, uint8_t bit, bool value);
+
+  /*
+   * Array accessors. Array signals keep their elements contiguous in the registry, so they are
+   * read and written in place instead of copied:
+   *   get_array points *data at the elements and sets *count to their number.
+   *   array_buffer points *data at the storage of the signal and sets *capacity to the number of
+   *   elements it holds, to be filled before commit_array sets the element count.
+   * The pointers stay valid as long as the registry, which should be locked while they are used
+   * if another thread decodes into it. set_array copies count elements in. Elements filled in
+   * place are not marked as being written, so a snapshot taken while they are filled may see some
+   * of them changed.
+   *
+   * The handle accessors take a handle resolved for any array type and work in elements of that
+   * type. They return PROTON_ERROR for a handle that is not an array, and
+   * PROTON_INSUFFICIENT_BUFFER_ERROR for a count past the capacity of the signal.
+   */
+
+  proton_status_e proton_signal_handle_get_array(
+    const proton_registry_t * registry, proton_signal_handle_t handle, const void ** data,
+    size_t * count);
+  proton_status_e proton_signal_handle_set_array(
+    const proton_registry_t * registry, proton_signal_handle_t handle, const void * data,
+    size_t count);
+
+  proton_status_e proton_signal_handle_array_buffer(
+    const proton_registry_t * registry, proton_signal_handle_t handle, void ** data,
+    size_t * capacity);
+  proton_status_e proton_signal_handle_commit_array(
+    const proton_registry_t * registry, proton_signal_handle_t handle, size_t count);
+
+  proton_status_e proton_signal_get_double_array(
+    const proton_registry_t * registry, uint32_t signal_id, const double ** data, size_t * count);
+  proton_status_e proton_signal_set_double_array(
+    const proton_registry_t * registry, uint32_t signal_id, const double * data, size_t count);
+
+  proton_status_e proton_signal_get_float_array(
+    const proton_registry_t * registry, uint32_t signal_id, const float ** data, size_t * count);
+  proton_status_e proton_signal_set_float_array(
+    const proton_registry_t * registry, uint32_t signal_id, const float * data, size_t count);
+
+  proton_status_e proton_signal_get_int32_array(
+    const proton_registry_t * registry, uint32_t signal_id, const int32_t ** data, size_t * count);
+  proton_status_e proton_signal_set_int32_array(
+    const proton_registry_t * registry, uint32_t signal_id, const int32_t * data, size_t count);
+
+  proton_status_e proton_signal_get_int64_array(
+    const proton_registry_t * registry, uint32_t signal_id, const int64_t ** data, size_t * count);
+  proton_status_e proton_signal_set_int64_array(
+    const proton_registry_t * registry, uint32_t signal_id, const int64_t * data, size_t count);
+
+  proton_status_e proton_signal_get_uint32_array(
+    const proton_registry_t * registry, uint32_t signal_id, const uint32_t ** data, size_t * count);
+  proton_status_e proton_signal_set_uint32_array(
+    const proton_registry_t * registry, uint32_t signal_id, const uint32_t * data, size_t count);
+
+  proton_status_e proton_signal_get_uint64_array(
+    const proton_registry_t * registry, uint32_t signal_id, const uint64_t ** data, size_t * count);
+  proton_status_e proton_signal_set_uint64_array(
+    const proton_registry_t * registry, uint32_t signal_id, const uint64_t * data, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,8 @@ extern "C"
   {
     TRANSPORT_TYPE_SERIAL,
     TRANSPORT_TYPE_UDP4,
+    // Shared-memory ring between processes of one host
+    TRANSPORT_TYPE_SHM,
   } proton_transport_type_e;
 
 #ifdef __cplusplus
@@ -20,6 +20,7 @@
 #define PROTON_TRANSPORT_SERIAL_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "proton/common.h"
@@ -31,13 +32,22 @@ extern "C"
 
 // Serial Framing
 // [0x50][0x52][Length byte 0][Length byte 1][Payload][CRC16 byte 0][CRC16 byte 1]
+// CRC32C frames use a lowercase magic byte 1 and end in 4 little endian CRC32C bytes
 #define PROTON_FRAME_HEADER_MAGIC_BYTE_0 \
   (uint8_t)0x50  // Magic overhead byte 0 for serial synchronization
 #define PROTON_FRAME_HEADER_MAGIC_BYTE_1 \
   (uint8_t)0x52  // Magic overhead byte 1 for serial synchronization
+#define PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT \
+  (uint8_t)0x43  // Magic overhead byte 1 of a frame carrying a compact payload
+#define PROTON_FRAME_HEADER_MAGIC_BYTE_1_CRC32C \
+  (uint8_t)0x72  // Magic overhead byte 1 of a frame checked with CRC32C
+#define PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT_CRC32C \
+  (uint8_t)0x63  // Magic overhead byte 1 of a compact frame checked with CRC32C
 #define PROTON_FRAME_HEADER_LENGTH_OVERHEAD \
   sizeof(uint16_t)                                  // Length is sent in 2 bytes as a uint16_t
 #define PROTON_FRAME_CRC_OVERHEAD sizeof(uint16_t)  // CRC is sent in 2 bytes as a uint16_t
+#define PROTON_FRAME_CRC32C_OVERHEAD \
+  sizeof(uint32_t)  // CRC32C is sent in 4 bytes as a uint32_t
 #define PROTON_FRAME_HEADER_OVERHEAD                                                    \
   sizeof(PROTON_FRAME_HEADER_MAGIC_BYTE_0) + sizeof(PROTON_FRAME_HEADER_MAGIC_BYTE_1) + \
     PROTON_FRAME_HEADER_LENGTH_OVERHEAD
@@ -52,6 +62,17 @@ extern "C"
    */
   proton_status_e proton_serial_fill_frame_header(uint8_t * header, const uint16_t payload_len);
 
+  /**
+   * @brief Fill header of a serial frame with frame flags
+   *
+   * @param header Pointer to start of header
+   * @param payload_len Payload length
+   * @param flags PROTON_FRAME_FLAG_* bits, compact and CRC32C frames have their own magic bytes
+   * @return proton_status_e return status
+   */
+  proton_status_e proton_serial_fill_frame_header_flags(
+    uint8_t * header, const uint16_t payload_len, const uint8_t flags);
+
   /**
    * @brief Fill CRC16 bytes of a serial frame
    *
@@ -74,6 +95,28 @@ extern "C"
   proton_status_e proton_serial_check_framed_payload(
     const uint8_t * payload, const uint16_t payload_len, const uint16_t frame_crc);
 
+  /**
+   * @brief Fill CRC32C bytes of a serial frame sent with PROTON_FRAME_FLAG_CRC32C
+   *
+   * @param payload Pointer to payload
+   * @param payload_len Payload length
+   * @param crc Pointer to start of CRC32C
+   * @return proton_status_e return status
+   */
+  proton_status_e proton_serial_fill_crc32c(
+    const uint8_t * payload, const uint16_t payload_len, uint8_t * crc);
+
+  /**
+   * @brief Check for a valid CRC32C in a framed payload
+   *
+   * @param payload Pointer to payload
+   * @param payload_len Payload length
+   * @param frame_crc Received CRC32C
+   * @return proton_status_e return status
+   */
+  proton_status_e proton_serial_check_framed_payload_crc32c(
+    const uint8_t * payload, const uint16_t payload_len, const uint32_t frame_crc);
+
   /**
    * @brief Get payload length from a framed payload
    *
@@ -84,6 +127,134 @@ extern "C"
   proton_status_e proton_serial_get_framed_payload_length(
     const uint8_t * framed_buf, uint16_t * length);
 
+  /**
+   * @brief Get payload length and frame flags from a framed payload
+   * @note Unlike proton_serial_get_framed_payload_length, compact and CRC32C frames are accepted.
+   * A CRC32C frame has PROTON_FRAME_CRC32C_OVERHEAD CRC bytes instead of PROTON_FRAME_CRC_OVERHEAD.
+   *
+   * @param framed_buf Framed payload buffer
+   * @param length Output length
+   * @param flags Output PROTON_FRAME_FLAG_* bits
+   * @return proton_status_e return status
+   */
+  proton_status_e proton_serial_get_framed_payload_info(
+    const uint8_t * framed_buf, uint16_t * length, uint8_t * flags);
+
+  /**
+   * @brief Fill the header and CRC16 of a frame whose payload was encoded in place, after
+   * PROTON_FRAME_HEADER_OVERHEAD bytes of headroom and with PROTON_FRAME_CRC_OVERHEAD bytes of
+   * tailroom. This is the proton_frame_fill_f of PROTON_SERIAL_FRAMING.
+   *
+   * @param frame Pointer to start of frame
+   * @param payload_len Payload length
+   * @param flags PROTON_FRAME_FLAG_* bits
+   * @param arg Unused
+   * @return proton_status_e return status
+   */
+  proton_status_e proton_serial_fill_frame(
+    uint8_t * frame, size_t payload_len, uint8_t flags, void * arg);
+
+  /**
+   * @brief Fill the header and CRC32C of a frame whose payload was encoded in place, as
+   * proton_serial_fill_frame with PROTON_FRAME_CRC32C_OVERHEAD bytes of tailroom
+   */
+  proton_status_e proton_serial_fill_frame_crc32c(
+    uint8_t * frame, size_t payload_len, uint8_t flags, void * arg);
+
+// Initializers of a proton_framing_t for proton_node_update_framed
+#define PROTON_SERIAL_FRAMING \
+  {PROTON_FRAME_HEADER_OVERHEAD, PROTON_FRAME_CRC_OVERHEAD, proton_serial_fill_frame, NULL}
+#define PROTON_SERIAL_FRAMING_CRC32C                           \
+  {PROTON_FRAME_HEADER_OVERHEAD, PROTON_FRAME_CRC32C_OVERHEAD, \
+   proton_serial_fill_frame_crc32c, NULL}
+
+  typedef enum
+  {
+    PROTON_SERIAL_PARSER_SYNC,     // Looking for PROTON_FRAME_HEADER_MAGIC_BYTE_0
+    PROTON_SERIAL_PARSER_HEADER,   // Header split across chunks, collecting it
+    PROTON_SERIAL_PARSER_PAYLOAD,  // Copying the payload
+    PROTON_SERIAL_PARSER_CRC,      // Collecting the CRC bytes
+  } proton_serial_parser_state_e;
+
+  /**
+   * @struct proton_serial_parser_t incremental parser of a serial byte stream.
+   * Frames that arrive whole in one chunk are checked in place, the others are copied to buffer.
+   */
+  typedef struct proton_serial_parser
+  {
+    uint8_t * buffer;
+    size_t buffer_len;
+    // Frames announcing a longer payload are dropped as line noise
+    uint16_t max_payload_len;
+
+    proton_serial_parser_state_e state;
+    uint8_t header[PROTON_FRAME_HEADER_OVERHEAD];
+    size_t header_len;
+    uint16_t payload_len;
+    uint8_t flags;
+    size_t payload_received;
+    // Running CRC16 or CRC32C of the payload received so far
+    uint32_t crc;
+    uint8_t crc_bytes[PROTON_FRAME_CRC32C_OVERHEAD];
+    size_t crc_received;
+
+    // Counters for diagnostics, never reset by the parser
+    uint32_t frames;
+    uint32_t crc_errors;
+    uint32_t length_errors;
+    uint32_t discarded_bytes;
+  } proton_serial_parser_t;
+
+  /**
+   * @struct proton_serial_frame_t payload of a frame found by proton_serial_parser_feed
+   */
+  typedef struct proton_serial_frame
+  {
+    // NULL if no frame was completed. Points into the input chunk or the parser buffer, and is
+    // only valid until the next call to proton_serial_parser_feed
+    const uint8_t * payload;
+    uint16_t length;
+    // PROTON_FRAME_FLAG_* bits of the frame
+    uint8_t flags;
+  } proton_serial_frame_t;
+
+  /**
+   * @brief Initialize a serial parser
+   *
+   * @param parser Parser
+   * @param buffer Buffer for frames split across chunks, at least max_payload_len bytes
+   * @param buffer_len Buffer length
+   * @param max_payload_len Largest payload accepted
+   * @return proton_status_e return status
+   */
+  proton_status_e proton_serial_parser_init(
+    proton_serial_parser_t * parser, uint8_t * buffer, size_t buffer_len,
+    uint16_t max_payload_len);
+
+  /**
+   * @brief Drop any partial frame and look for the next header
+   */
+  void proton_serial_parser_reset(proton_serial_parser_t * parser);
+
+  /**
+   * @brief Feed a chunk of received bytes to a serial parser
+   * @note Stops after the first complete frame. Call again with the rest of the chunk until all of
+   * it is consumed. Each byte is only looked at once: frames failing their CRC are dropped whole,
+   * and the search for the next header resumes after them.
+   *
+   * @param parser Parser
+   * @param data Received bytes
+   * @param len Number of received bytes
+   * @param consumed Output number of bytes used from data
+   * @param frame Output frame, its payload is NULL if no frame was completed
+   * @return proton_status_e PROTON_CRC16_ERROR when a frame fails its CRC, and
+   * PROTON_INVALID_HEADER_ERROR when a header announces more than max_payload_len bytes. The
+   * parser has already resynchronized, keep feeding it the rest of the chunk.
+   */
+  proton_status_e proton_serial_parser_feed(
+    proton_serial_parser_t * parser, const uint8_t * data, size_t len, size_t * consumed,
+    proton_serial_frame_t * frame);
+
 #ifdef __cplusplus
 }
 #endif
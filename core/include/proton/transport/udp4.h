@@ -38,6 +38,9 @@ extern "C"
 
 #define PROTON_CURRENT_UDP_VERSION ((uint8_t)UDP4_VERSION_2)
 
+// The payload is a compact frame, see proton_encode_bundle_compact
+#define PROTON_UDP4_FLAG_COMPACT PROTON_FRAME_FLAG_COMPACT
+
   /**
    * @struct proton_udp4_header_t scaffolding for any future protocol changes that may impact how we encode/decode
    */
@@ -47,7 +50,7 @@ extern "C"
     uint8_t version;
     // 0 = unspecified, left up to the user to differentiate based on where the message came from
     uint8_t node_id;
-    // Scaffolding for flags that may be needed for future versions
+    // PROTON_UDP4_FLAG_* bits, the others are reserved for future versions
     uint8_t flags;
     // Reserved for future revisions
     uint8_t reserved;
@@ -66,6 +69,20 @@ extern "C"
   proton_status_e proton_udp4_check_payload(
     const uint8_t * payload, const uint16_t payload_len, proton_udp4_header_t * out_header);
 
+  /**
+   * @brief Fill the header of a frame whose payload was encoded in place, after
+   * sizeof(proton_udp4_header_t) bytes of headroom. This is the proton_frame_fill_f of
+   * PROTON_UDP4_FRAMING.
+   * @param arg Pointer to the uint8_t node ID to put in the header, or NULL for 0
+   */
+  proton_status_e proton_udp4_fill_frame(
+    uint8_t * frame, size_t payload_len, uint8_t flags, void * arg);
+
+// Initializer of a proton_framing_t for proton_node_update_framed, node_id_ptr as for
+// proton_udp4_fill_frame
+#define PROTON_UDP4_FRAMING(node_id_ptr) \
+  {sizeof(proton_udp4_header_t), 0, proton_udp4_fill_frame, (node_id_ptr)}
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,12 +20,228 @@
 #include <stdint.h>
 #include <string.h>
 #include "proton/common.h"
+#include "proton/encode_decode.h"
 #include "proton/registry.h"
 
 #include "pb.h"
 #include "pb_decode.h"
 #include "pb_encode.h"
 
+static uint64_t proton_zigzag_encode(int64_t value)
+{
+  return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t proton_zigzag_decode(uint64_t value)
+{
+  return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/**
+ * Value of a float or double signal, widened to a double
+ */
+static double proton_signal_real(const signal_desc_t * desc)
+{
+  return desc->type == PROTON_FLOAT ? (double)desc->signal.signal.float_value
+                                    : desc->signal.signal.double_value;
+}
+
+uint16_t proton_float_to_half(float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint16_t sign = (uint16_t)((bits >> 16) & 0x8000u);
+  uint32_t exponent = (bits >> 23) & 0xFFu;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+
+  if (exponent == 0xFFu)
+  {
+    // Infinity, or a NaN that keeps a mantissa bit so it does not turn into an infinity
+    return (uint16_t)(sign | 0x7C00u | (mantissa != 0 ? 0x200u | (mantissa >> 13) : 0u));
+  }
+
+  int32_t half_exponent = (int32_t)exponent - 127 + 15;
+  if (half_exponent >= 0x1F)
+  {
+    return (uint16_t)(sign | 0x7C00u);
+  }
+
+  if (half_exponent <= 0)
+  {
+    // Below the smallest normal half, shift the mantissa with its implicit bit into a subnormal
+    if (half_exponent < -10)
+    {
+      return sign;
+    }
+    mantissa |= 0x800000u;
+    uint32_t shift = (uint32_t)(14 - half_exponent);
+    uint32_t half = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (half & 1u) != 0))
+    {
+      half++;
+    }
+    return (uint16_t)(sign | half);
+  }
+
+  uint32_t half = ((uint32_t)half_exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1FFFu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0))
+  {
+    // A carry out of the mantissa moves to the next exponent, and past the largest half to infinity
+    half++;
+  }
+  return (uint16_t)(sign | half);
+}
+
+float proton_half_to_float(uint16_t half)
+{
+  uint32_t sign = (uint32_t)(half & 0x8000u) << 16;
+  uint32_t exponent = (half >> 10) & 0x1Fu;
+  uint32_t mantissa = half & 0x3FFu;
+  uint32_t bits;
+
+  if (exponent == 0x1Fu)
+  {
+    bits = sign | 0x7F800000u | (mantissa << 13);
+  }
+  else if (exponent != 0)
+  {
+    bits = sign | ((exponent + 127u - 15u) << 23) | (mantissa << 13);
+  }
+  else if (mantissa == 0)
+  {
+    bits = sign;
+  }
+  else
+  {
+    // Subnormal half, which is a normal float once the mantissa is shifted up to its implicit bit
+    exponent = 127u - 14u;
+    while ((mantissa & 0x400u) == 0)
+    {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+  }
+
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+int64_t proton_quantize(const proton_signal_encoding_t * encoding, double value)
+{
+  double scaled = (value - encoding->offset) / encoding->scale;
+  if (scaled != scaled)
+  {
+    return 0;
+  }
+
+  // 2^63 is the first value out of range of an int64
+  if (scaled >= 9223372036854775808.0)
+  {
+    return INT64_MAX;
+  }
+  if (scaled <= -9223372036854775808.0)
+  {
+    return INT64_MIN;
+  }
+
+  // Round half away from zero
+  int64_t quantized = (int64_t)scaled;
+  double fraction = scaled - (double)quantized;
+  if (fraction >= 0.5)
+  {
+    quantized++;
+  }
+  else if (fraction <= -0.5)
+  {
+    quantized--;
+  }
+  return quantized;
+}
+
+double proton_dequantize(const proton_signal_encoding_t * encoding, int64_t quantized)
+{
+  return encoding->offset + encoding->scale * (double)quantized;
+}
+
+pb_size_t proton_encoding_tag(const proton_signal_encoding_t * encoding)
+{
+  return encoding->type == PROTON_ENCODING_QUANTIZED ? proton_Signal_quantized_value_tag
+                                                     : proton_Signal_half_value_tag;
+}
+
+uint64_t proton_encode_signal_varint(const signal_desc_t * desc)
+{
+  double value = proton_signal_real(desc);
+  if (desc->encoding->type == PROTON_ENCODING_QUANTIZED)
+  {
+    return proton_zigzag_encode(proton_quantize(desc->encoding, value));
+  }
+  return proton_float_to_half((float)value);
+}
+
+bool proton_decode_signal_varint(
+  const signal_desc_t * desc, uint64_t varint, proton_Signal * signal)
+{
+  double value = 0.0;
+  if (desc->encoding->type == PROTON_ENCODING_QUANTIZED)
+  {
+    value = proton_dequantize(desc->encoding, proton_zigzag_decode(varint));
+  }
+  else if (varint <= UINT16_MAX)
+  {
+    value = proton_half_to_float((uint16_t)varint);
+  }
+  else
+  {
+    return false;
+  }
+
+  if (desc->type == PROTON_FLOAT)
+  {
+    signal->signal.float_value = (float)value;
+  }
+  else if (desc->type == PROTON_DOUBLE)
+  {
+    signal->signal.double_value = value;
+  }
+  else
+  {
+    return false;
+  }
+  signal->which_signal = proton_get_tag_from_type(desc->type);
+  return true;
+}
+
+/**
+ * Turn a decoded quantized_value or half_value field back into the float or double value of its
+ * signal. Other values are left as they are.
+ * @return false if the signal does not have the encoding the value was sent with
+ */
+static bool proton_decode_encoded_signal(const signal_desc_t * desc, proton_Signal * signal)
+{
+  uint64_t varint = 0;
+  if (signal->which_signal == proton_Signal_quantized_value_tag)
+  {
+    varint = proton_zigzag_encode(signal->signal.quantized_value);
+  }
+  else if (signal->which_signal == proton_Signal_half_value_tag)
+  {
+    varint = signal->signal.half_value;
+  }
+  else
+  {
+    return true;
+  }
+
+  return desc->encoding != NULL && proton_encoding_tag(desc->encoding) == signal->which_signal &&
+         proton_decode_signal_varint(desc, varint, signal);
+}
+
 /**
  * Callback for encoding a bundle, passing the registry as arg to access bundle ID and signals
  * @param ostream protobuf output stream
@@ -58,15 +274,20 @@ static bool proton_encode_bundle_cb(
 
   for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
   {
-    uint32_t signal_id = bundle_desc->signal_ids.ids[i];
-    signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, NULL);
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
+    if (desc == NULL)
+    {
+      return false;
+    }
+
     proton_Signal signal_msg = proton_Signal_init_zero;
-    signal_msg.id = signal_id;
+    signal_msg.id = desc->id;
     signal_msg.which_signal = desc->signal.which_signal;
     proton_buffer_t string_buf;
     if (
       signal_msg.which_signal == proton_Signal_string_value_tag ||
-      signal_msg.which_signal == proton_Signal_bytes_value_tag)
+      signal_msg.which_signal == proton_Signal_bytes_value_tag ||
+      proton_is_array_type(desc->type))
     {
       string_buf.data = (uint8_t *)desc->signal.signal.string_value;
       string_buf.len = desc->value_size;
@@ -77,10 +298,20 @@ static bool proton_encode_bundle_cb(
       memcpy(&signal_msg.signal, &desc->signal.signal, desc->value_size);
     }
 
-    if (desc == NULL)
+    if (desc->encoding != NULL)
     {
-      return false;
+      signal_msg.which_signal = proton_encoding_tag(desc->encoding);
+      if (signal_msg.which_signal == proton_Signal_quantized_value_tag)
+      {
+        signal_msg.signal.quantized_value =
+          proton_quantize(desc->encoding, proton_signal_real(desc));
+      }
+      else
+      {
+        signal_msg.signal.half_value = proton_float_to_half((float)proton_signal_real(desc));
+      }
     }
+
     if (!pb_encode_tag_for_field(ostream, field))
     {
       return false;
@@ -128,7 +359,6 @@ static bool proton_decode_bundle_cb(pb_istream_t * istream, const pb_field_t * f
     return false;
   }
 
-  size_t signal_count = bundle_desc->signal_ids.count;
   proton_Signal * bundle_signals = proton_registry_get_bundle_encode_decode_buffer(registry);
 
   if (bundle_signals == NULL)
@@ -153,26 +383,16 @@ static bool proton_decode_bundle_cb(pb_istream_t * istream, const pb_field_t * f
     uint32_t incoming_id = incoming.id;
 
     // Validate: the incoming signal ID must belong to this bundle
-    bool id_in_bundle = false;
     size_t bundle_signal_slot = SIZE_MAX;
-    for (size_t i = 0; i < signal_count; i++)
-    {
-      if (bundle_desc->signal_ids.ids[i] == incoming_id)
-      {
-        id_in_bundle = true;
-        bundle_signal_slot = i;
-        break;
-      }
-    }
-
-    if (!id_in_bundle)
+    if (!proton_bundle_get_signal_slot(bundle_desc, incoming_id, &bundle_signal_slot))
     {
       return false;
     }
 
-    // get signal registry index for decode buffers
-    size_t signal_registry_idx = SIZE_MAX;
-    if (proton_registry_get_signal(registry, incoming_id, &signal_registry_idx) == NULL)
+    // get signal descriptor for decode buffers
+    signal_desc_t * signal_desc =
+      proton_registry_get_bundle_signal(registry, bundle_desc, bundle_signal_slot);
+    if (signal_desc == NULL)
     {
       return false;
     }
@@ -187,13 +407,12 @@ static bool proton_decode_bundle_cb(pb_istream_t * istream, const pb_field_t * f
       case proton_Signal_bytes_value_tag:
       case proton_Signal_string_value_tag:
       {
-        proton_buffer_t * decode_buf =
-          &registry->signal_registry[signal_registry_idx].signal_decode_buffer;
+        proton_buffer_t * decode_buf = &signal_desc->signal_decode_buffer;
         if (decode_buf->data == NULL)
         {
           return false;
         }
-        size_t capacity = registry->signal_registry[signal_registry_idx].capacity;
+        size_t capacity = signal_desc->capacity;
         if (scratch_buf.len > capacity)
         {
           return false;
@@ -211,6 +430,29 @@ static bool proton_decode_bundle_cb(pb_istream_t * istream, const pb_field_t * f
         break;
       }
 
+      case proton_Signal_double_array_value_tag:
+      case proton_Signal_float_array_value_tag:
+      case proton_Signal_int32_array_value_tag:
+      case proton_Signal_int64_array_value_tag:
+      case proton_Signal_uint32_array_value_tag:
+      case proton_Signal_uint64_array_value_tag:
+      {
+        // The scratch buffer holds the packed elements, unpack them into the decode buffer
+        proton_buffer_t * decode_buf = &signal_desc->signal_decode_buffer;
+        size_t size = 0;
+        if (
+          decode_buf->data == NULL ||
+          !proton_read_packed_array(
+            proton_get_type_from_tag(incoming.which_signal), scratch_buf.data, scratch_buf.len,
+            decode_buf->data, signal_desc->capacity, &size))
+        {
+          return false;
+        }
+        signal->signal.string_value = decode_buf->data;
+        decode_buf->len = size;
+        break;
+      }
+
       default:
       {
         memcpy(&signal->signal, &incoming.signal, sizeof(incoming.signal));
@@ -222,36 +464,16 @@ static bool proton_decode_bundle_cb(pb_istream_t * istream, const pb_field_t * f
 }
 
 /**
- * Callback for decoding the oneof field in a Proton message, used to pass args to the various different operations
+ * State shared by the decode callbacks of one proton_decode_dispatch call
  */
-static bool proton_operation_decode_cb(
-  pb_istream_t * istream, const pb_field_t * field, void ** arg)
+typedef struct proton_decode_context
 {
-  (void)istream;
-
-  if (!field || !arg)
-  {
-    return false;
-  }
-
-  proton_Proton * msg = (proton_Proton *)field->message;
-  if (!msg)
-  {
-    return false;
-  }
-
-  switch (field->tag)
-  {
-    case proton_Proton_bundle_tag:
-      msg->operation.bundle.signals.funcs.decode = proton_decode_bundle_cb;
-      msg->operation.bundle.signals.arg = *arg;
-      return true;
-    default:
-      return false;
-  }
-
-  return false;
-}
+  proton_registry_t * registry;
+  proton_bundle_decoded_cb_t bundle_decoded;
+  void * arg;
+  // Error that stopped decoding from within a callback
+  proton_status_e status;
+} proton_decode_context_t;
 
 static proton_status_e check_stream_bytes_left(const pb_istream_t * stream)
 {
@@ -277,20 +499,32 @@ static proton_status_e proton_decode_bundle(
 
   // Set signals in registry based on decoded values
   proton_Signal * bundle_signals = proton_registry_get_bundle_encode_decode_buffer(registry);
+  proton_status_e status = PROTON_OK;
+  proton_bundle_begin_write(registry, bundle_desc);
   for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
   {
     proton_Signal * signal_ptr = &bundle_signals[i];
-    uint32_t signal_id = bundle_desc->signal_ids.ids[i];
-    signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, NULL);
+    signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
     if (desc == NULL)
     {
-      return PROTON_ERROR;
+      status = PROTON_ERROR;
+      break;
     }
-    if (desc->type != proton_get_type_from_tag(signal_ptr->which_signal))
+    if (signal_ptr->which_signal == 0 && bundle_desc->delta)
     {
-      return PROTON_ERROR;
+      // Left out of a delta bundle, keep the current value
+      continue;
     }
-    if (desc->type == PROTON_STRING || desc->type == PROTON_BYTES)
+    if (
+      !proton_decode_encoded_signal(desc, signal_ptr) ||
+      desc->type != proton_get_type_from_tag(signal_ptr->which_signal))
+    {
+      status = PROTON_ERROR;
+      break;
+    }
+    if (
+      desc->type == PROTON_STRING || desc->type == PROTON_BYTES ||
+      proton_is_array_type(desc->type))
     {
       // value pointer in union points to the decode buffer — copy content into registry
       const void * src = signal_ptr->signal.string_value;  // same union slot as bytes_value
@@ -301,11 +535,99 @@ static proton_status_e proton_decode_bundle(
     {
       memcpy(&desc->signal.signal, &signal_ptr->signal, desc->value_size);
     }
+    desc->version++;
+    signal_ptr->which_signal = 0;
   }
+  proton_bundle_end_write(registry, bundle_desc);
 
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
   return check_stream_bytes_left(stream);
 }
 
+/**
+ * Callback for decoding one bundle of a bundle set. Each bundle is written to the registry and
+ * dispatched before the next one is decoded, since they share the registry decode buffer.
+ * @param arg pointer to the decode context
+ * @return true if successful, false if error
+ */
+static bool proton_decode_bundle_set_cb(
+  pb_istream_t * istream, const pb_field_t * field, void ** arg)
+{
+  if (!field || !arg || field->tag != proton_BundleSet_bundles_tag)
+  {
+    return false;
+  }
+
+  proton_decode_context_t * context = *(proton_decode_context_t **)arg;
+  if (!context)
+  {
+    return false;
+  }
+
+  proton_Bundle bundle = {
+    .signals.funcs.decode = proton_decode_bundle_cb,
+    .signals.arg = context->registry,
+  };
+  if (!pb_decode_ex(istream, proton_Bundle_fields, &bundle, PB_DECODE_NOINIT))
+  {
+    return false;
+  }
+
+  proton_status_e status = proton_decode_bundle(context->registry, &bundle, istream);
+  if (status == PROTON_OK && context->bundle_decoded != NULL)
+  {
+    status = context->bundle_decoded(context->registry, bundle.id, context->arg);
+  }
+
+  if (status != PROTON_OK)
+  {
+    context->status = status;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Callback for decoding the oneof field in a Proton message, used to pass args to the various different operations
+ */
+static bool proton_operation_decode_cb(
+  pb_istream_t * istream, const pb_field_t * field, void ** arg)
+{
+  (void)istream;
+
+  if (!field || !arg)
+  {
+    return false;
+  }
+
+  proton_Proton * msg = (proton_Proton *)field->message;
+  proton_decode_context_t * context = *(proton_decode_context_t **)arg;
+  if (!msg || !context)
+  {
+    return false;
+  }
+
+  switch (field->tag)
+  {
+    case proton_Proton_bundle_tag:
+      msg->operation.bundle.signals.funcs.decode = proton_decode_bundle_cb;
+      msg->operation.bundle.signals.arg = context->registry;
+      return true;
+    case proton_Proton_bundle_set_tag:
+      msg->operation.bundle_set.bundles.funcs.decode = proton_decode_bundle_set_cb;
+      msg->operation.bundle_set.bundles.arg = context;
+      return true;
+    default:
+      return false;
+  }
+
+  return false;
+}
+
 proton_status_e proton_encode_bundle(
   proton_registry_t * registry, uint32_t bundle_id, uint8_t * buffer, size_t buffer_len,
   size_t * bytes_encoded)
@@ -353,34 +675,1746 @@ proton_status_e proton_encode_bundle(
   return PROTON_OK;
 }
 
-proton_status_e proton_decode(
-  proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
-  proton_Proton * decoded_msg)
+// Protobuf field key of a field number and wire type
+#define PROTON_FIELD_KEY(tag, wire_type) (((uint32_t)(tag) << 3) | (uint32_t)(wire_type))
+
+size_t proton_varint_size(uint64_t value)
 {
-  if (registry == NULL || buffer == NULL || decoded_msg == NULL)
+  size_t size = 1;
+  while (value >= 0x80)
   {
-    return PROTON_NULL_PTR_ERROR;
+    value >>= 7;
+    size++;
   }
+  return size;
+}
 
-  pb_istream_t stream = pb_istream_from_buffer((const pb_byte_t *)buffer, buffer_len);
-  // Place registry at the signals pointer so it can be accessed in the callback
-  decoded_msg->cb_operation.funcs.decode = proton_operation_decode_cb;
-  decoded_msg->cb_operation.arg = registry;
+uint8_t * proton_write_varint(uint8_t * out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    *out++ = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (uint8_t)value;
+  return out;
+}
 
-  bool status = pb_decode(&stream, proton_Proton_fields, decoded_msg);
-  if (!status)
+uint8_t * proton_write_fixed32(uint8_t * out, uint32_t value)
+{
+  for (size_t i = 0; i < sizeof(value); i++)
   {
-    return PROTON_SERIALIZATION_ERROR;
+    *out++ = (uint8_t)(value >> (8 * i));
   }
+  return out;
+}
 
-  // No other operations are defined yet
-  if (decoded_msg->which_operation == proton_Proton_bundle_tag)
+uint8_t * proton_write_fixed64(uint8_t * out, uint64_t value)
+{
+  for (size_t i = 0; i < sizeof(value); i++)
   {
-    proton_Bundle bundle = decoded_msg->operation.bundle;
-    return proton_decode_bundle(registry, &bundle, &stream);
+    *out++ = (uint8_t)(value >> (8 * i));
   }
-  else
+  return out;
+}
+
+/**
+ * Varint a scalar signal value is encoded as, following nanopb: signed values are sign-extended
+ * to 64 bits and bools are 0 or 1.
+ */
+static uint64_t proton_signal_varint(const proton_Signal * signal)
+{
+  switch (signal->which_signal)
   {
-    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+    case proton_Signal_int32_value_tag:
+      return (uint64_t)(int64_t)signal->signal.int32_value;
+    case proton_Signal_int64_value_tag:
+      return (uint64_t)signal->signal.int64_value;
+    case proton_Signal_uint32_value_tag:
+      return signal->signal.uint32_value;
+    case proton_Signal_uint64_value_tag:
+      return signal->signal.uint64_value;
+    case proton_Signal_flags_value_tag:
+      return signal->signal.flags_value;
+    case proton_Signal_bool_value_tag:
+      return signal->signal.bool_value ? 1 : 0;
+    default:
+      return 0;
   }
 }
+
+/**
+ * Length of the body of a Signal message encoded from a signal descriptor
+ */
+static size_t proton_signal_encoded_len(const signal_desc_t * desc)
+{
+  size_t len = 0;
+  if (desc->encoding != NULL)
+  {
+    // quantized_value and half_value take a two byte key
+    pb_size_t tag = proton_encoding_tag(desc->encoding);
+    len = proton_varint_size(PROTON_FIELD_KEY(tag, PB_WT_VARINT)) +
+          proton_varint_size(proton_encode_signal_varint(desc));
+  }
+  else
+  {
+    switch (desc->signal.which_signal)
+    {
+      case proton_Signal_double_value_tag:
+        len = 1 + sizeof(uint64_t);
+        break;
+      case proton_Signal_float_value_tag:
+        len = 1 + sizeof(uint32_t);
+        break;
+      case proton_Signal_int32_value_tag:
+      case proton_Signal_int64_value_tag:
+      case proton_Signal_uint32_value_tag:
+      case proton_Signal_uint64_value_tag:
+      case proton_Signal_bool_value_tag:
+      case proton_Signal_flags_value_tag:
+        len = 1 + proton_varint_size(proton_signal_varint(&desc->signal));
+        break;
+      case proton_Signal_string_value_tag:
+      case proton_Signal_bytes_value_tag:
+        len = 1 + proton_varint_size(desc->value_size) + desc->value_size;
+        break;
+      case proton_Signal_double_array_value_tag:
+      case proton_Signal_float_array_value_tag:
+      case proton_Signal_int32_array_value_tag:
+      case proton_Signal_int64_array_value_tag:
+      case proton_Signal_uint32_array_value_tag:
+      case proton_Signal_uint64_array_value_tag:
+      {
+        // Tags past 15 take a two byte key
+        size_t packed_len =
+          proton_packed_array_len(desc->type, desc->signal.signal.string_value, desc->value_size);
+        len = proton_varint_size(PROTON_FIELD_KEY(desc->signal.which_signal, PB_WT_STRING)) +
+              proton_varint_size(packed_len) + packed_len;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  // proto3 leaves out a zero ID
+  if (desc->id != 0)
+  {
+    len += proton_varint_size(PROTON_FIELD_KEY(proton_Signal_id_tag, PB_WT_VARINT)) +
+           proton_varint_size(desc->id);
+  }
+
+  return len;
+}
+
+/**
+ * Write the body of a Signal message, in the field order nanopb uses: the value, then the ID
+ */
+static uint8_t * proton_write_signal(uint8_t * out, const signal_desc_t * desc)
+{
+  const proton_Signal * signal = &desc->signal;
+  pb_size_t tag =
+    desc->encoding != NULL ? proton_encoding_tag(desc->encoding) : signal->which_signal;
+  switch (tag)
+  {
+    case proton_Signal_quantized_value_tag:
+    case proton_Signal_half_value_tag:
+      out = proton_write_varint(out, PROTON_FIELD_KEY(tag, PB_WT_VARINT));
+      out = proton_write_varint(out, proton_encode_signal_varint(desc));
+      break;
+    case proton_Signal_double_value_tag:
+    {
+      uint64_t bits;
+      memcpy(&bits, &signal->signal.double_value, sizeof(bits));
+      *out++ = PROTON_FIELD_KEY(proton_Signal_double_value_tag, PB_WT_64BIT);
+      out = proton_write_fixed64(out, bits);
+      break;
+    }
+    case proton_Signal_float_value_tag:
+    {
+      uint32_t bits;
+      memcpy(&bits, &signal->signal.float_value, sizeof(bits));
+      *out++ = PROTON_FIELD_KEY(proton_Signal_float_value_tag, PB_WT_32BIT);
+      out = proton_write_fixed32(out, bits);
+      break;
+    }
+    case proton_Signal_int32_value_tag:
+    case proton_Signal_int64_value_tag:
+    case proton_Signal_uint32_value_tag:
+    case proton_Signal_uint64_value_tag:
+    case proton_Signal_bool_value_tag:
+    case proton_Signal_flags_value_tag:
+      *out++ = PROTON_FIELD_KEY(signal->which_signal, PB_WT_VARINT);
+      out = proton_write_varint(out, proton_signal_varint(signal));
+      break;
+    case proton_Signal_string_value_tag:
+    case proton_Signal_bytes_value_tag:
+      *out++ = PROTON_FIELD_KEY(signal->which_signal, PB_WT_STRING);
+      out = proton_write_varint(out, desc->value_size);
+      memcpy(out, signal->signal.string_value, desc->value_size);
+      out += desc->value_size;
+      break;
+    case proton_Signal_double_array_value_tag:
+    case proton_Signal_float_array_value_tag:
+    case proton_Signal_int32_array_value_tag:
+    case proton_Signal_int64_array_value_tag:
+    case proton_Signal_uint32_array_value_tag:
+    case proton_Signal_uint64_array_value_tag:
+      out = proton_write_varint(out, PROTON_FIELD_KEY(signal->which_signal, PB_WT_STRING));
+      out = proton_write_varint(
+        out, proton_packed_array_len(desc->type, signal->signal.string_value, desc->value_size));
+      out = proton_write_packed_array(
+        out, desc->type, signal->signal.string_value, desc->value_size);
+      break;
+    default:
+      break;
+  }
+
+  if (desc->id != 0)
+  {
+    out = proton_write_varint(out, PROTON_FIELD_KEY(proton_Signal_id_tag, PB_WT_VARINT));
+    out = proton_write_varint(out, desc->id);
+  }
+
+  return out;
+}
+
+/**
+ * Length of the body of a Bundle message encoded from the registry
+ * @param delta_only leave out the signals that did not change since the bundle was last sent
+ * @return false if a signal of the bundle is missing from the registry
+ */
+static bool proton_bundle_encoded_len(
+  const proton_registry_t * registry, const bundle_desc_t * bundle_desc, bool delta_only,
+  size_t * len)
+{
+  size_t bundle_len = 0;
+  if (bundle_desc->bundle_id != 0)
+  {
+    bundle_len += 1 + proton_varint_size(bundle_desc->bundle_id);
+  }
+
+  for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
+    if (desc == NULL)
+    {
+      return false;
+    }
+    if (delta_only && desc->version == bundle_desc->sent_versions[i])
+    {
+      continue;
+    }
+    size_t signal_len = proton_signal_encoded_len(desc);
+    bundle_len += 1 + proton_varint_size(signal_len) + signal_len;
+  }
+
+  *len = bundle_len;
+  return true;
+}
+
+/**
+ * Write a length-delimited Bundle message with the given field key. The signals are assumed to
+ * exist, as checked by proton_bundle_encoded_len.
+ */
+static uint8_t * proton_write_bundle(
+  uint8_t * out, uint32_t key, const proton_registry_t * registry,
+  const bundle_desc_t * bundle_desc, bool delta_only, size_t bundle_len)
+{
+  out = proton_write_varint(out, key);
+  out = proton_write_varint(out, bundle_len);
+
+  if (bundle_desc->bundle_id != 0)
+  {
+    *out++ = PROTON_FIELD_KEY(proton_Bundle_id_tag, PB_WT_VARINT);
+    out = proton_write_varint(out, bundle_desc->bundle_id);
+  }
+
+  for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
+    if (delta_only && desc->version == bundle_desc->sent_versions[i])
+    {
+      continue;
+    }
+    *out++ = PROTON_FIELD_KEY(proton_Bundle_signals_tag, PB_WT_STRING);
+    out = proton_write_varint(out, proton_signal_encoded_len(desc));
+    out = proton_write_signal(out, desc);
+  }
+
+  return out;
+}
+
+/**
+ * Write a bundle as a length-delimited field 1, which is both a Proton message with a bundle
+ * operation and an entry of a bundle set. The generated codec of the bundle is used if it has one.
+ * A delta bundle between two keyframes only carries the signals changed since it was last sent.
+ * @return PROTON_INSUFFICIENT_BUFFER_ERROR if the bundle does not fit in buffer_len, or
+ * PROTON_SERIALIZATION_ERROR if a signal of the bundle is missing from the registry
+ */
+static proton_status_e proton_write_bundle_entry(
+  const proton_registry_t * registry, const bundle_desc_t * bundle_desc, uint8_t * buffer,
+  size_t buffer_len, size_t * entry_len)
+{
+  // Generated codecs always write every signal
+  bool delta_only = !proton_bundle_keyframe_due(bundle_desc);
+  if (!delta_only && bundle_desc->codec != NULL && bundle_desc->codec->encode != NULL)
+  {
+    return bundle_desc->codec->encode(registry, buffer, buffer_len, entry_len);
+  }
+
+  size_t bundle_len = 0;
+  if (!proton_bundle_encoded_len(registry, bundle_desc, delta_only, &bundle_len))
+  {
+    return PROTON_SERIALIZATION_ERROR;
+  }
+
+  size_t len = 1 + proton_varint_size(bundle_len) + bundle_len;
+  if (len > buffer_len)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  proton_write_bundle(
+    buffer, PROTON_FIELD_KEY(proton_Proton_bundle_tag, PB_WT_STRING), registry, bundle_desc,
+    delta_only, bundle_len);
+  *entry_len = len;
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_encode_bundle_direct(
+  proton_registry_t * registry, uint32_t bundle_id, uint8_t * buffer, size_t buffer_len,
+  size_t * bytes_encoded)
+{
+  if (registry == NULL || buffer == NULL || bytes_encoded == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  const bundle_desc_t * bundle_desc = proton_registry_get_bundle(registry, bundle_id, NULL);
+  if (bundle_desc == NULL)
+  {
+    return PROTON_ERROR;
+  }
+
+  proton_status_e status =
+    proton_write_bundle_entry(registry, bundle_desc, buffer, buffer_len, bytes_encoded);
+  // Report a short buffer the way proton_encode_bundle does
+  return status == PROTON_INSUFFICIENT_BUFFER_ERROR ? PROTON_SERIALIZATION_ERROR : status;
+}
+
+/**
+ * Space reserved at the start of the buffer for the bundle set header: the operation tag and the
+ * length of a payload no longer than limit.
+ */
+static size_t proton_bundle_set_header_reserve(const proton_bundle_set_encoder_t * encoder)
+{
+  return 1 + proton_varint_size(encoder->limit);
+}
+
+proton_status_e proton_bundle_set_init(
+  proton_bundle_set_encoder_t * encoder, uint8_t * buffer, size_t buffer_len, size_t mtu)
+{
+  if (encoder == NULL || buffer == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  encoder->buffer = buffer;
+  encoder->buffer_len = buffer_len;
+  encoder->limit = (mtu != 0 && mtu < buffer_len) ? mtu : buffer_len;
+  encoder->payload_len = 0;
+  encoder->num_bundles = 0;
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_bundle_set_add(
+  proton_bundle_set_encoder_t * encoder, proton_registry_t * registry, uint32_t bundle_id)
+{
+  if (encoder == NULL || encoder->buffer == NULL || registry == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  const bundle_desc_t * bundle_desc = proton_registry_get_bundle(registry, bundle_id, NULL);
+  if (bundle_desc == NULL)
+  {
+    return PROTON_ERROR;
+  }
+
+  size_t reserve = proton_bundle_set_header_reserve(encoder);
+  if (reserve + encoder->payload_len > encoder->buffer_len)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  // Each entry is a length-delimited bundle, which a single-entry message is also sent as. It is
+  // written after the payload, and only becomes part of it if it fits.
+  size_t entry_len = 0;
+  proton_status_e status = proton_write_bundle_entry(
+    registry, bundle_desc, &encoder->buffer[reserve + encoder->payload_len],
+    encoder->buffer_len - reserve - encoder->payload_len, &entry_len);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  size_t payload_len = encoder->payload_len + entry_len;
+  // A lone bundle is sent as is even if it exceeds the MTU, the MTU only limits coalescing
+  if (
+    encoder->num_bundles != 0 && 1 + proton_varint_size(payload_len) + payload_len > encoder->limit)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  encoder->payload_len = payload_len;
+  encoder->num_bundles++;
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_bundle_set_finish(
+  proton_bundle_set_encoder_t * encoder, size_t * bytes_encoded)
+{
+  if (encoder == NULL || encoder->buffer == NULL || bytes_encoded == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  size_t reserve = proton_bundle_set_header_reserve(encoder);
+  uint8_t * payload = &encoder->buffer[reserve];
+
+  if (encoder->num_bundles <= 1)
+  {
+    // The entry of a lone bundle already is a Proton message with a bundle operation, as the
+    // bundle operation and the bundle set entries share field number 1
+    memmove(encoder->buffer, payload, encoder->payload_len);
+    *bytes_encoded = encoder->payload_len;
+    return PROTON_OK;
+  }
+
+  uint8_t header[16];
+  pb_ostream_t stream = pb_ostream_from_buffer(header, sizeof(header));
+  if (
+    !pb_encode_tag(&stream, PB_WT_STRING, proton_Proton_bundle_set_tag) ||
+    !pb_encode_varint(&stream, encoder->payload_len))
+  {
+    return PROTON_SERIALIZATION_ERROR;
+  }
+
+  memmove(&encoder->buffer[stream.bytes_written], payload, encoder->payload_len);
+  memcpy(encoder->buffer, header, stream.bytes_written);
+  *bytes_encoded = stream.bytes_written + encoder->payload_len;
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_decode(
+  proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
+  proton_Proton * decoded_msg)
+{
+  return proton_decode_dispatch(registry, buffer, buffer_len, decoded_msg, NULL, NULL);
+}
+
+proton_status_e proton_decode_dispatch(
+  proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
+  proton_Proton * decoded_msg, proton_bundle_decoded_cb_t bundle_decoded, void * arg)
+{
+  if (registry == NULL || buffer == NULL || decoded_msg == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  // Signals are marked as received in the decode buffer, clear what an earlier failed decode left
+  for (size_t i = 0; i < registry->encode_decode_buffer_count; i++)
+  {
+    registry->encode_decode_buffer[i].which_signal = 0;
+  }
+
+  proton_decode_context_t context = {
+    .registry = registry,
+    .bundle_decoded = bundle_decoded,
+    .arg = arg,
+    .status = PROTON_OK,
+  };
+
+  pb_istream_t stream = pb_istream_from_buffer((const pb_byte_t *)buffer, buffer_len);
+  // Place the decode context at the operation pointer so it can be accessed in the callbacks
+  decoded_msg->cb_operation.funcs.decode = proton_operation_decode_cb;
+  decoded_msg->cb_operation.arg = &context;
+
+  bool status = pb_decode(&stream, proton_Proton_fields, decoded_msg);
+  if (!status)
+  {
+    return context.status != PROTON_OK ? context.status : PROTON_SERIALIZATION_ERROR;
+  }
+
+  if (decoded_msg->which_operation == proton_Proton_bundle_tag)
+  {
+    proton_Bundle bundle = decoded_msg->operation.bundle;
+    proton_status_e result = proton_decode_bundle(registry, &bundle, &stream);
+    if (result == PROTON_OK && bundle_decoded != NULL)
+    {
+      result = bundle_decoded(registry, bundle.id, arg);
+    }
+    return result;
+  }
+  else if (decoded_msg->which_operation == proton_Proton_bundle_set_tag)
+  {
+    // Every bundle was written to the registry and dispatched while decoding
+    return check_stream_bytes_left(&stream);
+  }
+  else
+  {
+    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+  }
+}
+
+bool proton_read_varint(proton_reader_t * reader, uint64_t * value)
+{
+  uint64_t result = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+  {
+    if (reader->pos == reader->end)
+    {
+      return false;
+    }
+    uint8_t byte = *reader->pos++;
+    result |= (uint64_t)(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool proton_read_fixed(proton_reader_t * reader, size_t size, uint64_t * value)
+{
+  if ((size_t)(reader->end - reader->pos) < size)
+  {
+    return false;
+  }
+  uint64_t result = 0;
+  for (size_t i = 0; i < size; i++)
+  {
+    result |= (uint64_t)reader->pos[i] << (8 * i);
+  }
+  reader->pos += size;
+  *value = result;
+  return true;
+}
+
+/*
+ * Packed arrays. Doubles and floats are encoded as their little-endian bits, which is how they
+ * are stored on little-endian hosts, so they are copied in bulk. Integers are encoded as varints,
+ * signed ones sign-extended to 64 bits as nanopb does. Elements are accessed with memcpy since
+ * scratch and decode buffers are not aligned for the element type.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define PROTON_LITTLE_ENDIAN 1
+#else
+#define PROTON_LITTLE_ENDIAN 0
+#endif
+
+/**
+ * Varint element i of an integer array is encoded as
+ */
+static inline uint64_t proton_array_varint(
+  proton_signal_type_e type, const uint8_t * data, size_t i)
+{
+  switch (type)
+  {
+    case PROTON_INT32_ARRAY:
+    {
+      int32_t value;
+      memcpy(&value, data + i * sizeof(value), sizeof(value));
+      return (uint64_t)(int64_t)value;
+    }
+    case PROTON_UINT32_ARRAY:
+    {
+      uint32_t value;
+      memcpy(&value, data + i * sizeof(value), sizeof(value));
+      return value;
+    }
+    default:
+    {
+      uint64_t value;
+      memcpy(&value, data + i * sizeof(value), sizeof(value));
+      return value;
+    }
+  }
+}
+
+size_t proton_packed_array_len(proton_signal_type_e type, const void * data, size_t size)
+{
+  size_t element_size = proton_array_element_size(type);
+  if (element_size == 0)
+  {
+    return 0;
+  }
+  if (type == PROTON_DOUBLE_ARRAY || type == PROTON_FLOAT_ARRAY)
+  {
+    return size;
+  }
+
+  size_t count = size / element_size;
+  size_t len = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    len += proton_varint_size(proton_array_varint(type, (const uint8_t *)data, i));
+  }
+  return len;
+}
+
+uint8_t * proton_write_packed_array(
+  uint8_t * out, proton_signal_type_e type, const void * data, size_t size)
+{
+  size_t element_size = proton_array_element_size(type);
+  if (element_size == 0)
+  {
+    return out;
+  }
+  const uint8_t * bytes = (const uint8_t *)data;
+  size_t count = size / element_size;
+
+  if (type == PROTON_DOUBLE_ARRAY || type == PROTON_FLOAT_ARRAY)
+  {
+#if PROTON_LITTLE_ENDIAN
+    memcpy(out, bytes, size);
+    return out + size;
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+      if (element_size == sizeof(uint64_t))
+      {
+        uint64_t bits;
+        memcpy(&bits, bytes + i * element_size, sizeof(bits));
+        out = proton_write_fixed64(out, bits);
+      }
+      else
+      {
+        uint32_t bits;
+        memcpy(&bits, bytes + i * element_size, sizeof(bits));
+        out = proton_write_fixed32(out, bits);
+      }
+    }
+    return out;
+#endif
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    uint64_t value = proton_array_varint(type, bytes, i);
+    // Most elements of a sensor block are small, so keep the one byte case out of the loop
+    if (value < 0x80)
+    {
+      *out++ = (uint8_t)value;
+    }
+    else
+    {
+      out = proton_write_varint(out, value);
+    }
+  }
+  return out;
+}
+
+bool proton_read_packed_array(
+  proton_signal_type_e type, const uint8_t * in, size_t len, void * out, size_t capacity,
+  size_t * size)
+{
+  size_t element_size = proton_array_element_size(type);
+  if (element_size == 0 || size == NULL)
+  {
+    return false;
+  }
+  uint8_t * bytes = (uint8_t *)out;
+
+  if (type == PROTON_DOUBLE_ARRAY || type == PROTON_FLOAT_ARRAY)
+  {
+    if (len % element_size != 0 || len > capacity)
+    {
+      return false;
+    }
+    if (bytes != NULL)
+    {
+#if PROTON_LITTLE_ENDIAN
+      memcpy(bytes, in, len);
+#else
+      proton_reader_t reader = {.pos = in, .end = in + len};
+      for (size_t offset = 0; offset < len; offset += element_size)
+      {
+        uint64_t bits = 0;
+        proton_read_fixed(&reader, element_size, &bits);
+        if (element_size == sizeof(uint32_t))
+        {
+          uint32_t bits32 = (uint32_t)bits;
+          memcpy(bytes + offset, &bits32, sizeof(bits32));
+        }
+        else
+        {
+          memcpy(bytes + offset, &bits, sizeof(bits));
+        }
+      }
+#endif
+    }
+    *size = len;
+    return true;
+  }
+
+  proton_reader_t reader = {.pos = in, .end = in + len};
+  size_t offset = 0;
+  while (reader.pos < reader.end)
+  {
+    uint64_t value = 0;
+    if (offset + element_size > capacity || !proton_read_varint(&reader, &value))
+    {
+      return false;
+    }
+    switch (type)
+    {
+      case PROTON_INT32_ARRAY:
+      {
+        if ((int64_t)value < INT32_MIN || (int64_t)value > INT32_MAX)
+        {
+          return false;
+        }
+        int32_t element = (int32_t)(int64_t)value;
+        if (bytes != NULL)
+        {
+          memcpy(bytes + offset, &element, sizeof(element));
+        }
+        break;
+      }
+      case PROTON_UINT32_ARRAY:
+      {
+        if (value > UINT32_MAX)
+        {
+          return false;
+        }
+        uint32_t element = (uint32_t)value;
+        if (bytes != NULL)
+        {
+          memcpy(bytes + offset, &element, sizeof(element));
+        }
+        break;
+      }
+      default:
+        if (bytes != NULL)
+        {
+          memcpy(bytes + offset, &value, sizeof(value));
+        }
+        break;
+    }
+    offset += element_size;
+  }
+  *size = offset;
+  return true;
+}
+
+static bool proton_read_key(proton_reader_t * reader, uint32_t * tag, uint32_t * wire_type)
+{
+  uint64_t key = 0;
+  if (!proton_read_varint(reader, &key) || (key >> 3) == 0 || (key >> 3) > UINT32_MAX)
+  {
+    return false;
+  }
+  *tag = (uint32_t)(key >> 3);
+  *wire_type = (uint32_t)(key & 0x07);
+  return true;
+}
+
+bool proton_read_length_delimited(proton_reader_t * reader, proton_reader_t * field)
+{
+  uint64_t len = 0;
+  if (!proton_read_varint(reader, &len) || len > (uint64_t)(reader->end - reader->pos))
+  {
+    return false;
+  }
+  field->pos = reader->pos;
+  field->end = reader->pos + len;
+  reader->pos = field->end;
+  return true;
+}
+
+bool proton_read_expect(proton_reader_t * reader, const uint8_t * expected, size_t len)
+{
+  if ((size_t)(reader->end - reader->pos) < len || memcmp(reader->pos, expected, len) != 0)
+  {
+    return false;
+  }
+  reader->pos += len;
+  return true;
+}
+
+/**
+ * Skip a field this decoder does not know, as nanopb does
+ */
+static bool proton_skip_field(proton_reader_t * reader, uint32_t wire_type)
+{
+  uint64_t value = 0;
+  proton_reader_t field;
+  switch (wire_type)
+  {
+    case PB_WT_VARINT:
+      return proton_read_varint(reader, &value);
+    case PB_WT_64BIT:
+      return proton_read_fixed(reader, sizeof(uint64_t), &value);
+    case PB_WT_32BIT:
+      return proton_read_fixed(reader, sizeof(uint32_t), &value);
+    case PB_WT_STRING:
+      return proton_read_length_delimited(reader, &field);
+    default:
+      return false;
+  }
+}
+
+/**
+ * Wire type a value of the Signal oneof is encoded with
+ */
+static uint32_t proton_signal_wire_type(uint32_t tag)
+{
+  switch (tag)
+  {
+    case proton_Signal_double_value_tag:
+      return PB_WT_64BIT;
+    case proton_Signal_float_value_tag:
+      return PB_WT_32BIT;
+    case proton_Signal_string_value_tag:
+    case proton_Signal_bytes_value_tag:
+    case proton_Signal_double_array_value_tag:
+    case proton_Signal_float_array_value_tag:
+    case proton_Signal_int32_array_value_tag:
+    case proton_Signal_int64_array_value_tag:
+    case proton_Signal_uint32_array_value_tag:
+    case proton_Signal_uint64_array_value_tag:
+      return PB_WT_STRING;
+    default:
+      return PB_WT_VARINT;
+  }
+}
+
+/**
+ * Read the value of a Signal oneof field into signal. The value of a string, bytes or array field
+ * is not copied, the union points at its length prefix in the input until the bundle is committed.
+ * @return false if the value is malformed or out of range of its type
+ */
+static bool proton_read_signal_value(proton_reader_t * reader, uint32_t tag, proton_Signal * signal)
+{
+  uint64_t value = 0;
+  switch (tag)
+  {
+    case proton_Signal_double_value_tag:
+      if (!proton_read_fixed(reader, sizeof(uint64_t), &value))
+      {
+        return false;
+      }
+      memcpy(&signal->signal.double_value, &value, sizeof(double));
+      break;
+    case proton_Signal_float_value_tag:
+    {
+      if (!proton_read_fixed(reader, sizeof(uint32_t), &value))
+      {
+        return false;
+      }
+      uint32_t bits = (uint32_t)value;
+      memcpy(&signal->signal.float_value, &bits, sizeof(float));
+      break;
+    }
+    case proton_Signal_int32_value_tag:
+      if (
+        !proton_read_varint(reader, &value) || (int64_t)value < INT32_MIN ||
+        (int64_t)value > INT32_MAX)
+      {
+        return false;
+      }
+      signal->signal.int32_value = (int32_t)(int64_t)value;
+      break;
+    case proton_Signal_int64_value_tag:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      signal->signal.int64_value = (int64_t)value;
+      break;
+    case proton_Signal_uint32_value_tag:
+      if (!proton_read_varint(reader, &value) || value > UINT32_MAX)
+      {
+        return false;
+      }
+      signal->signal.uint32_value = (uint32_t)value;
+      break;
+    case proton_Signal_uint64_value_tag:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      signal->signal.uint64_value = value;
+      break;
+    case proton_Signal_flags_value_tag:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      signal->signal.flags_value = value;
+      break;
+    case proton_Signal_bool_value_tag:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      signal->signal.bool_value = value != 0;
+      break;
+    case proton_Signal_quantized_value_tag:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      signal->signal.quantized_value = proton_zigzag_decode(value);
+      break;
+    case proton_Signal_half_value_tag:
+      if (!proton_read_varint(reader, &value) || value > UINT32_MAX)
+      {
+        return false;
+      }
+      signal->signal.half_value = (uint32_t)value;
+      break;
+    case proton_Signal_string_value_tag:
+    case proton_Signal_bytes_value_tag:
+    case proton_Signal_double_array_value_tag:
+    case proton_Signal_float_array_value_tag:
+    case proton_Signal_int32_array_value_tag:
+    case proton_Signal_int64_array_value_tag:
+    case proton_Signal_uint32_array_value_tag:
+    case proton_Signal_uint64_array_value_tag:
+    {
+      const uint8_t * prefix = reader->pos;
+      proton_reader_t field;
+      if (!proton_read_length_delimited(reader, &field))
+      {
+        return false;
+      }
+      signal->signal.string_value = (void *)prefix;
+      break;
+    }
+    default:
+      return false;
+  }
+  signal->which_signal = (pb_size_t)tag;
+  return true;
+}
+
+/**
+ * Check that the packed elements a staged array signal points at are valid and fit the signal
+ */
+static bool proton_stage_array(
+  const signal_desc_t * desc, const proton_Signal * staged, const uint8_t * end)
+{
+  proton_reader_t prefix = {.pos = staged->signal.string_value, .end = end};
+  proton_reader_t packed;
+  size_t size = 0;
+  return proton_read_length_delimited(&prefix, &packed) &&
+         proton_read_packed_array(
+           desc->type, packed.pos, (size_t)(packed.end - packed.pos), NULL, desc->capacity, &size);
+}
+
+/**
+ * Parse one Signal message of a bundle and stage it in the slot of the shadow area belonging to
+ * its ID. The signal must be part of the bundle, have the registered type and fit its capacity.
+ */
+static bool proton_stage_signal(
+  proton_registry_t * registry, const bundle_desc_t * bundle_desc, proton_reader_t * reader,
+  proton_Signal * shadow)
+{
+  proton_Signal incoming = proton_Signal_init_zero;
+  uint64_t id = 0;
+
+  while (reader->pos < reader->end)
+  {
+    uint32_t tag = 0;
+    uint32_t wire_type = 0;
+    if (!proton_read_key(reader, &tag, &wire_type))
+    {
+      return false;
+    }
+
+    if (tag == proton_Signal_id_tag && wire_type == PB_WT_VARINT)
+    {
+      if (!proton_read_varint(reader, &id) || id > UINT32_MAX)
+      {
+        return false;
+      }
+    }
+    else if (tag >= proton_Signal_double_value_tag && tag <= proton_Signal_half_value_tag)
+    {
+      if (wire_type != proton_signal_wire_type(tag))
+      {
+        return false;
+      }
+      if (!proton_read_signal_value(reader, tag, &incoming))
+      {
+        return false;
+      }
+    }
+    else if (tag == proton_Signal_id_tag || !proton_skip_field(reader, wire_type))
+    {
+      return false;
+    }
+  }
+
+  size_t slot = SIZE_MAX;
+  if (!proton_bundle_get_signal_slot(bundle_desc, (uint32_t)id, &slot))
+  {
+    return false;
+  }
+
+  const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, slot);
+  if (
+    desc == NULL || !proton_decode_encoded_signal(desc, &incoming) ||
+    desc->type != proton_get_type_from_tag(incoming.which_signal))
+  {
+    return false;
+  }
+
+  if (desc->type == PROTON_STRING || desc->type == PROTON_BYTES)
+  {
+    proton_reader_t prefix = {.pos = incoming.signal.string_value, .end = reader->end};
+    uint64_t len = 0;
+    if (!proton_read_varint(&prefix, &len) || len > desc->capacity)
+    {
+      return false;
+    }
+  }
+  else if (proton_is_array_type(desc->type) && !proton_stage_array(desc, &incoming, reader->end))
+  {
+    return false;
+  }
+
+  incoming.id = (uint32_t)id;
+  shadow[slot] = incoming;
+  return true;
+}
+
+/**
+ * Copy the staged signals of a bundle into the registry. Only called once the bundle has been
+ * fully validated, so it cannot fail part way through. Signals left out of a delta bundle keep
+ * their value.
+ */
+static void proton_commit_bundle(
+  proton_registry_t * registry, const bundle_desc_t * bundle_desc, const proton_Signal * shadow,
+  const uint8_t * end)
+{
+  proton_bundle_begin_write(registry, bundle_desc);
+  for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+  {
+    signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
+    const proton_Signal * staged = &shadow[i];
+    if (staged->which_signal == 0)
+    {
+      continue;
+    }
+    if (desc->type == PROTON_STRING || desc->type == PROTON_BYTES)
+    {
+      proton_reader_t prefix = {.pos = staged->signal.string_value, .end = end};
+      uint64_t len = 0;
+      proton_read_varint(&prefix, &len);
+      memcpy(desc->signal.signal.string_value, prefix.pos, (size_t)len);
+      desc->value_size = (size_t)len;
+    }
+    else if (proton_is_array_type(desc->type))
+    {
+      proton_reader_t prefix = {.pos = staged->signal.string_value, .end = end};
+      uint64_t len = 0;
+      size_t size = 0;
+      proton_read_varint(&prefix, &len);
+      proton_read_packed_array(
+        desc->type, prefix.pos, (size_t)len, desc->signal.signal.string_value, desc->capacity,
+        &size);
+      desc->value_size = (uint16_t)size;
+    }
+    else
+    {
+      memcpy(&desc->signal.signal, &staged->signal, desc->value_size);
+    }
+    desc->version++;
+  }
+  proton_bundle_end_write(registry, bundle_desc);
+}
+
+/**
+ * Parse a Bundle message into the shadow area and commit it to the registry if, and only if, the
+ * whole bundle is valid and carries every signal of the bundle, or any of them for a delta bundle.
+ */
+static proton_status_e proton_decode_bundle_direct(
+  proton_registry_t * registry, proton_reader_t * reader, uint32_t * bundle_id)
+{
+  // The generated codec of the bundle decodes the layout it encodes, anything else falls through
+  // to the generic decoder below
+  proton_reader_t peek = *reader;
+  uint64_t key = 0;
+  uint64_t peek_id = 0;
+  if (
+    proton_read_varint(&peek, &key) &&
+    key == PROTON_FIELD_KEY(proton_Bundle_id_tag, PB_WT_VARINT) &&
+    (!proton_read_varint(&peek, &peek_id) || peek_id > UINT32_MAX))
+  {
+    peek_id = 0;
+  }
+  const bundle_desc_t * codec_bundle =
+    proton_registry_get_bundle(registry, (uint32_t)peek_id, NULL);
+  if (codec_bundle != NULL && codec_bundle->codec != NULL && codec_bundle->codec->decode != NULL)
+  {
+    // Generated codecs write the registry straight from the message
+    proton_bundle_begin_write(registry, codec_bundle);
+    bool decoded =
+      codec_bundle->codec->decode(registry, reader->pos, (size_t)(reader->end - reader->pos));
+    proton_bundle_end_write(registry, codec_bundle);
+    if (decoded)
+    {
+      *bundle_id = codec_bundle->bundle_id;
+      return PROTON_OK;
+    }
+  }
+
+  proton_Signal * shadow = proton_registry_get_bundle_encode_decode_buffer(registry);
+  if (shadow == NULL)
+  {
+    return PROTON_ERROR;
+  }
+
+  const bundle_desc_t * bundle_desc = NULL;
+  uint64_t id = 0;
+
+  while (reader->pos < reader->end)
+  {
+    uint32_t tag = 0;
+    uint32_t wire_type = 0;
+    if (!proton_read_key(reader, &tag, &wire_type))
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+
+    if (tag == proton_Bundle_id_tag && wire_type == PB_WT_VARINT)
+    {
+      if (!proton_read_varint(reader, &id) || id > UINT32_MAX)
+      {
+        return PROTON_SERIALIZATION_ERROR;
+      }
+    }
+    else if (tag == proton_Bundle_signals_tag && wire_type == PB_WT_STRING)
+    {
+      // As with nanopb, signals are checked against the bundle ID read before them
+      if (bundle_desc == NULL)
+      {
+        bundle_desc = proton_registry_get_bundle(registry, (uint32_t)id, NULL);
+        if (
+          bundle_desc == NULL ||
+          bundle_desc->signal_ids.count > registry->encode_decode_buffer_count)
+        {
+          return PROTON_SERIALIZATION_ERROR;
+        }
+        for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+        {
+          shadow[i].which_signal = 0;
+        }
+      }
+
+      proton_reader_t signal;
+      if (
+        !proton_read_length_delimited(reader, &signal) ||
+        !proton_stage_signal(registry, bundle_desc, &signal, shadow))
+      {
+        return PROTON_SERIALIZATION_ERROR;
+      }
+    }
+    else if (
+      tag == proton_Bundle_id_tag || tag == proton_Bundle_signals_tag ||
+      !proton_skip_field(reader, wire_type))
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+  }
+
+  if (bundle_desc == NULL)
+  {
+    bundle_desc = proton_registry_get_bundle(registry, (uint32_t)id, NULL);
+    if (bundle_desc == NULL)
+    {
+      return PROTON_ERROR;
+    }
+    // Only a bundle without signals, or a delta bundle with no changes, can be sent without any
+    if (bundle_desc->signal_ids.count != 0 && !bundle_desc->delta)
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+    if (bundle_desc->signal_ids.count > registry->encode_decode_buffer_count)
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+    for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+    {
+      shadow[i].which_signal = 0;
+    }
+  }
+
+  for (size_t i = 0; i < bundle_desc->signal_ids.count && !bundle_desc->delta; i++)
+  {
+    if (shadow[i].which_signal == 0)
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+  }
+
+  proton_commit_bundle(registry, bundle_desc, shadow, reader->end);
+  *bundle_id = bundle_desc->bundle_id;
+  return PROTON_OK;
+}
+
+proton_status_e proton_decode_direct(
+  proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
+  proton_bundle_decoded_cb_t bundle_decoded, void * arg)
+{
+  if (registry == NULL || buffer == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  // Walk the whole message before decoding anything, so that a message cut short is rejected
+  // without touching the registry. As with a oneof, the last operation in the message wins.
+  proton_reader_t reader = {.pos = buffer, .end = buffer + buffer_len};
+  proton_reader_t operation = {.pos = NULL, .end = NULL};
+  uint32_t operation_tag = 0;
+  while (reader.pos < reader.end)
+  {
+    uint32_t tag = 0;
+    uint32_t wire_type = 0;
+    if (!proton_read_key(&reader, &tag, &wire_type))
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+
+    if (tag == proton_Proton_bundle_tag || tag == proton_Proton_bundle_set_tag)
+    {
+      if (wire_type != PB_WT_STRING || !proton_read_length_delimited(&reader, &operation))
+      {
+        return PROTON_SERIALIZATION_ERROR;
+      }
+      operation_tag = tag;
+    }
+    else if (!proton_skip_field(&reader, wire_type))
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+  }
+
+  if (operation_tag == proton_Proton_bundle_tag)
+  {
+    uint32_t bundle_id = 0;
+    proton_status_e status = proton_decode_bundle_direct(registry, &operation, &bundle_id);
+    if (status == PROTON_OK && bundle_decoded != NULL)
+    {
+      status = bundle_decoded(registry, bundle_id, arg);
+    }
+    return status;
+  }
+  else if (operation_tag == proton_Proton_bundle_set_tag)
+  {
+    while (operation.pos < operation.end)
+    {
+      uint32_t tag = 0;
+      uint32_t wire_type = 0;
+      if (!proton_read_key(&operation, &tag, &wire_type))
+      {
+        return PROTON_SERIALIZATION_ERROR;
+      }
+
+      if (tag != proton_BundleSet_bundles_tag)
+      {
+        if (!proton_skip_field(&operation, wire_type))
+        {
+          return PROTON_SERIALIZATION_ERROR;
+        }
+        continue;
+      }
+
+      proton_reader_t bundle;
+      if (wire_type != PB_WT_STRING || !proton_read_length_delimited(&operation, &bundle))
+      {
+        return PROTON_SERIALIZATION_ERROR;
+      }
+
+      uint32_t bundle_id = 0;
+      proton_status_e status = proton_decode_bundle_direct(registry, &bundle, &bundle_id);
+      if (status == PROTON_OK && bundle_decoded != NULL)
+      {
+        status = bundle_decoded(registry, bundle_id, arg);
+      }
+      if (status != PROTON_OK)
+      {
+        return status;
+      }
+    }
+    return PROTON_OK;
+  }
+  else
+  {
+    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+  }
+}
+
+proton_status_e proton_append_schema_hash(
+  uint8_t * buffer, size_t buffer_len, size_t * len, uint32_t schema_hash)
+{
+  if (buffer == NULL || len == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (*len > buffer_len || buffer_len - *len < PROTON_SCHEMA_HASH_FIELD_LEN)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  uint8_t * out = &buffer[*len];
+  *out++ = PROTON_FIELD_KEY(proton_Proton_schema_hash_tag, PB_WT_32BIT);
+  proton_write_fixed32(out, schema_hash);
+  *len += PROTON_SCHEMA_HASH_FIELD_LEN;
+  return PROTON_OK;
+}
+
+bool proton_read_schema_hash(const uint8_t * buffer, size_t buffer_len, uint32_t * schema_hash)
+{
+  if (buffer == NULL || schema_hash == NULL)
+  {
+    return false;
+  }
+
+  proton_reader_t reader = {.pos = buffer, .end = buffer + buffer_len};
+  bool found = false;
+  while (reader.pos < reader.end)
+  {
+    uint32_t tag = 0;
+    uint32_t wire_type = 0;
+    if (!proton_read_key(&reader, &tag, &wire_type))
+    {
+      return false;
+    }
+
+    if (tag == proton_Proton_schema_hash_tag && wire_type == PB_WT_32BIT)
+    {
+      uint64_t value = 0;
+      if (!proton_read_fixed(&reader, sizeof(uint32_t), &value))
+      {
+        return false;
+      }
+      *schema_hash = (uint32_t)value;
+      found = true;
+    }
+    else if (!proton_skip_field(&reader, wire_type))
+    {
+      return false;
+    }
+  }
+
+  return found;
+}
+
+/**
+ * Number of bytes of the presence bitmap of a compact bundle, which only delta bundles have
+ */
+static size_t proton_compact_bitmap_len(const bundle_desc_t * bundle_desc)
+{
+  return bundle_desc->delta ? ((size_t)bundle_desc->signal_ids.count + 7) / 8 : 0;
+}
+
+/**
+ * Length of the value of a signal in a compact bundle, which follows its registered type
+ */
+static size_t proton_compact_value_len(const signal_desc_t * desc)
+{
+  const proton_Signal * signal = &desc->signal;
+  if (desc->encoding != NULL)
+  {
+    return proton_varint_size(proton_encode_signal_varint(desc));
+  }
+  switch (desc->type)
+  {
+    case PROTON_DOUBLE:
+      return sizeof(uint64_t);
+    case PROTON_FLOAT:
+      return sizeof(uint32_t);
+    case PROTON_BOOL:
+      return 1;
+    case PROTON_INT32:
+      return proton_varint_size(proton_zigzag_encode(signal->signal.int32_value));
+    case PROTON_INT64:
+      return proton_varint_size(proton_zigzag_encode(signal->signal.int64_value));
+    case PROTON_UINT32:
+      return proton_varint_size(signal->signal.uint32_value);
+    case PROTON_UINT64:
+      return proton_varint_size(signal->signal.uint64_value);
+    case PROTON_FLAGS:
+      return proton_varint_size(signal->signal.flags_value);
+    case PROTON_STRING:
+    case PROTON_BYTES:
+      return proton_varint_size(desc->value_size) + desc->value_size;
+    case PROTON_DOUBLE_ARRAY:
+    case PROTON_FLOAT_ARRAY:
+    case PROTON_INT32_ARRAY:
+    case PROTON_INT64_ARRAY:
+    case PROTON_UINT32_ARRAY:
+    case PROTON_UINT64_ARRAY:
+    {
+      size_t packed_len =
+        proton_packed_array_len(desc->type, signal->signal.string_value, desc->value_size);
+      return proton_varint_size(packed_len) + packed_len;
+    }
+    default:
+      return 0;
+  }
+}
+
+static uint8_t * proton_compact_write_value(uint8_t * out, const signal_desc_t * desc)
+{
+  const proton_Signal * signal = &desc->signal;
+  if (desc->encoding != NULL)
+  {
+    return proton_write_varint(out, proton_encode_signal_varint(desc));
+  }
+  switch (desc->type)
+  {
+    case PROTON_DOUBLE:
+    {
+      uint64_t bits;
+      memcpy(&bits, &signal->signal.double_value, sizeof(bits));
+      return proton_write_fixed64(out, bits);
+    }
+    case PROTON_FLOAT:
+    {
+      uint32_t bits;
+      memcpy(&bits, &signal->signal.float_value, sizeof(bits));
+      return proton_write_fixed32(out, bits);
+    }
+    case PROTON_BOOL:
+      *out++ = signal->signal.bool_value ? 1 : 0;
+      return out;
+    case PROTON_INT32:
+      return proton_write_varint(out, proton_zigzag_encode(signal->signal.int32_value));
+    case PROTON_INT64:
+      return proton_write_varint(out, proton_zigzag_encode(signal->signal.int64_value));
+    case PROTON_UINT32:
+      return proton_write_varint(out, signal->signal.uint32_value);
+    case PROTON_UINT64:
+      return proton_write_varint(out, signal->signal.uint64_value);
+    case PROTON_FLAGS:
+      return proton_write_varint(out, signal->signal.flags_value);
+    case PROTON_STRING:
+    case PROTON_BYTES:
+      out = proton_write_varint(out, desc->value_size);
+      memcpy(out, signal->signal.string_value, desc->value_size);
+      return out + desc->value_size;
+    case PROTON_DOUBLE_ARRAY:
+    case PROTON_FLOAT_ARRAY:
+    case PROTON_INT32_ARRAY:
+    case PROTON_INT64_ARRAY:
+    case PROTON_UINT32_ARRAY:
+    case PROTON_UINT64_ARRAY:
+      out = proton_write_varint(
+        out, proton_packed_array_len(desc->type, signal->signal.string_value, desc->value_size));
+      return proton_write_packed_array(
+        out, desc->type, signal->signal.string_value, desc->value_size);
+    default:
+      return out;
+  }
+}
+
+proton_status_e proton_encode_bundle_compact(
+  const proton_registry_t * registry, uint32_t bundle_id, uint8_t * buffer, size_t buffer_len,
+  size_t * bytes_encoded)
+{
+  if (registry == NULL || buffer == NULL || bytes_encoded == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (registry->schema_hash == 0)
+  {
+    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+  }
+
+  const bundle_desc_t * bundle_desc = proton_registry_get_bundle(registry, bundle_id, NULL);
+  if (bundle_desc == NULL)
+  {
+    return PROTON_ERROR;
+  }
+
+  bool delta_only = !proton_bundle_keyframe_due(bundle_desc);
+  size_t bitmap_len = proton_compact_bitmap_len(bundle_desc);
+  size_t len = PROTON_COMPACT_HEADER_LEN + proton_varint_size(bundle_id) + bitmap_len;
+  for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
+    if (desc == NULL)
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+    if (!delta_only || desc->version != bundle_desc->sent_versions[i])
+    {
+      len += proton_compact_value_len(desc);
+    }
+  }
+
+  if (len > buffer_len)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  uint8_t * out = proton_write_fixed32(buffer, registry->schema_hash);
+  out = proton_write_varint(out, bundle_id);
+  uint8_t * bitmap = out;
+  memset(bitmap, 0, bitmap_len);
+  out += bitmap_len;
+  for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
+    if (delta_only && desc->version == bundle_desc->sent_versions[i])
+    {
+      continue;
+    }
+    if (bitmap_len != 0)
+    {
+      bitmap[i / 8] |= (uint8_t)(1u << (i % 8));
+    }
+    out = proton_compact_write_value(out, desc);
+  }
+
+  *bytes_encoded = len;
+  return PROTON_OK;
+}
+
+/**
+ * Read the value of a signal of a compact bundle into its slot of the shadow area. As with
+ * proton_read_signal_value, string and bytes values are left in the input, with the staged pointer
+ * at their length prefix.
+ */
+static bool proton_compact_stage_value(
+  proton_reader_t * reader, const signal_desc_t * desc, proton_Signal * staged)
+{
+  uint64_t value = 0;
+  if (desc->encoding != NULL)
+  {
+    if (
+      !proton_read_varint(reader, &value) || !proton_decode_signal_varint(desc, value, staged))
+    {
+      return false;
+    }
+    staged->id = desc->id;
+    return true;
+  }
+
+  switch (desc->type)
+  {
+    case PROTON_DOUBLE:
+      if (!proton_read_fixed(reader, sizeof(uint64_t), &value))
+      {
+        return false;
+      }
+      memcpy(&staged->signal.double_value, &value, sizeof(double));
+      break;
+    case PROTON_FLOAT:
+    {
+      if (!proton_read_fixed(reader, sizeof(uint32_t), &value))
+      {
+        return false;
+      }
+      uint32_t bits = (uint32_t)value;
+      memcpy(&staged->signal.float_value, &bits, sizeof(float));
+      break;
+    }
+    case PROTON_BOOL:
+      if (!proton_read_fixed(reader, 1, &value) || value > 1)
+      {
+        return false;
+      }
+      staged->signal.bool_value = value != 0;
+      break;
+    case PROTON_INT32:
+    {
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      int64_t decoded = proton_zigzag_decode(value);
+      if (decoded < INT32_MIN || decoded > INT32_MAX)
+      {
+        return false;
+      }
+      staged->signal.int32_value = (int32_t)decoded;
+      break;
+    }
+    case PROTON_INT64:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      staged->signal.int64_value = proton_zigzag_decode(value);
+      break;
+    case PROTON_UINT32:
+      if (!proton_read_varint(reader, &value) || value > UINT32_MAX)
+      {
+        return false;
+      }
+      staged->signal.uint32_value = (uint32_t)value;
+      break;
+    case PROTON_UINT64:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      staged->signal.uint64_value = value;
+      break;
+    case PROTON_FLAGS:
+      if (!proton_read_varint(reader, &value))
+      {
+        return false;
+      }
+      staged->signal.flags_value = value;
+      break;
+    case PROTON_STRING:
+    case PROTON_BYTES:
+    {
+      const uint8_t * prefix = reader->pos;
+      proton_reader_t data;
+      if (
+        !proton_read_length_delimited(reader, &data) ||
+        (size_t)(data.end - data.pos) > desc->capacity)
+      {
+        return false;
+      }
+      staged->signal.string_value = (void *)prefix;
+      break;
+    }
+    case PROTON_DOUBLE_ARRAY:
+    case PROTON_FLOAT_ARRAY:
+    case PROTON_INT32_ARRAY:
+    case PROTON_INT64_ARRAY:
+    case PROTON_UINT32_ARRAY:
+    case PROTON_UINT64_ARRAY:
+    {
+      const uint8_t * prefix = reader->pos;
+      proton_reader_t data;
+      if (!proton_read_length_delimited(reader, &data))
+      {
+        return false;
+      }
+      staged->signal.string_value = (void *)prefix;
+      if (!proton_stage_array(desc, staged, reader->end))
+      {
+        return false;
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+
+  staged->id = desc->id;
+  staged->which_signal = proton_get_tag_from_type(desc->type);
+  return true;
+}
+
+/**
+ * Parse one compact bundle into the shadow area and commit it to the registry if it is valid
+ */
+static proton_status_e proton_decode_bundle_compact(
+  proton_registry_t * registry, proton_reader_t * reader, uint32_t * bundle_id)
+{
+  uint64_t id = 0;
+  if (!proton_read_varint(reader, &id) || id > UINT32_MAX)
+  {
+    return PROTON_SERIALIZATION_ERROR;
+  }
+
+  const bundle_desc_t * bundle_desc = proton_registry_get_bundle(registry, (uint32_t)id, NULL);
+  if (bundle_desc == NULL)
+  {
+    return PROTON_ERROR;
+  }
+
+  proton_Signal * shadow = proton_registry_get_bundle_encode_decode_buffer(registry);
+  if (shadow == NULL || bundle_desc->signal_ids.count > registry->encode_decode_buffer_count)
+  {
+    return PROTON_ERROR;
+  }
+
+  size_t bitmap_len = proton_compact_bitmap_len(bundle_desc);
+  const uint8_t * bitmap = reader->pos;
+  if ((size_t)(reader->end - reader->pos) < bitmap_len)
+  {
+    return PROTON_SERIALIZATION_ERROR;
+  }
+  reader->pos += bitmap_len;
+
+  for (size_t i = 0; i < bundle_desc->signal_ids.count; i++)
+  {
+    shadow[i].which_signal = 0;
+    if (bitmap_len != 0 && (bitmap[i / 8] & (1u << (i % 8))) == 0)
+    {
+      continue;
+    }
+
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle_desc, i);
+    if (desc == NULL || !proton_compact_stage_value(reader, desc, &shadow[i]))
+    {
+      return PROTON_SERIALIZATION_ERROR;
+    }
+  }
+
+  proton_commit_bundle(registry, bundle_desc, shadow, reader->end);
+  *bundle_id = bundle_desc->bundle_id;
+  return PROTON_OK;
+}
+
+proton_status_e proton_decode_compact(
+  proton_registry_t * registry, const uint8_t * buffer, size_t buffer_len,
+  proton_bundle_decoded_cb_t bundle_decoded, void * arg)
+{
+  if (registry == NULL || buffer == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  proton_reader_t reader = {.pos = buffer, .end = buffer + buffer_len};
+  uint64_t schema_hash = 0;
+  if (!proton_read_fixed(&reader, sizeof(uint32_t), &schema_hash))
+  {
+    return PROTON_SERIALIZATION_ERROR;
+  }
+  if (registry->schema_hash == 0 || schema_hash != registry->schema_hash)
+  {
+    return PROTON_SCHEMA_MISMATCH_ERROR;
+  }
+  if (reader.pos == reader.end)
+  {
+    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+  }
+
+  while (reader.pos < reader.end)
+  {
+    uint32_t bundle_id = 0;
+    proton_status_e status = proton_decode_bundle_compact(registry, &reader, &bundle_id);
+    if (status == PROTON_OK && bundle_decoded != NULL)
+    {
+      status = bundle_decoded(registry, bundle_id, arg);
+    }
+    if (status != PROTON_OK)
+    {
+      return status;
+    }
+  }
+
+  return PROTON_OK;
+}
@@ -9,4 +9,7 @@
 PB_BIND(proton_Bundle, proton_Bundle, AUTO)
 
 
+PB_BIND(proton_BundleSet, proton_BundleSet, AUTO)
+
+
 
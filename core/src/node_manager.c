@@ -39,6 +39,110 @@ static bool proton_bundle_overdue_ms(
   return overdue;
 }
 
+/**
+ * Fill dest_peers with the endpoints of every consumer of a bundle
+ * @return PROTON_INSUFFICIENT_BUFFER_ERROR if dest_peers cannot hold every consumer of the bundle
+ */
+static proton_status_e proton_node_select_bundle_peers(
+  const proton_node_t * node, const bundle_desc_t * bundle_handle, proton_endpoint_t * dest_peers,
+  size_t num_dest_peers, size_t * num_selected_peers)
+{
+  // Check the target endpoint buffer is big enough for the endpoints for this bundle
+  if (bundle_handle->consumer_ids.count > num_dest_peers)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  size_t dest_idx = 0;
+  for (size_t i = 0; i < bundle_handle->consumer_ids.count; i++)
+  {
+    for (size_t j = 0; j < node->num_peers; j++)
+    {
+      if (bundle_handle->consumer_ids.ids[i] == node->destination_peers[j].node_id)
+      {
+        proton_endpoint_t * ep = &dest_peers[dest_idx];
+        ep->node_id = bundle_handle->consumer_ids.ids[i];
+        ep->transport_type = node->destination_peers[j].transport_type;
+        ep->endpoint_id = node->destination_peers[j].endpoint_id;
+        ep->mtu = node->destination_peers[j].mtu;
+        dest_idx++;
+        break;
+      }
+    }
+  }
+  *num_selected_peers = bundle_handle->consumer_ids.count;
+
+  return PROTON_OK;
+}
+
+/**
+ * @brief Whether the node advertises its schema and may send compact frames
+ */
+static bool proton_node_compact_enabled(const proton_node_t * node)
+{
+  return node->peer_schema_hashes != NULL && node->registry->schema_hash != 0;
+}
+
+/**
+ * @brief Whether every selected peer advertised the node's schema, so a compact frame can be sent
+ */
+static bool proton_node_peers_compact(
+  const proton_node_t * node, const proton_endpoint_t * peers, size_t num_peers)
+{
+  if (!proton_node_compact_enabled(node) || num_peers == 0)
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < num_peers; i++)
+  {
+    bool compact = false;
+    for (size_t j = 0; j < node->num_peers; j++)
+    {
+      const proton_endpoint_t * peer = &node->destination_peers[j];
+      if (peer->node_id == peers[i].node_id && peer->endpoint_id == peers[i].endpoint_id)
+      {
+        compact = node->peer_schema_hashes[j] == node->registry->schema_hash;
+        break;
+      }
+    }
+    if (!compact)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Advertise the node's schema in an encoded message, if the node accepts compact frames
+ * and the field fits. The message is valid without it, so running out of space is not an error.
+ */
+static void proton_node_advertise_schema(
+  const proton_node_t * node, uint8_t * buffer, size_t buffer_len, size_t * len)
+{
+  if (proton_node_compact_enabled(node))
+  {
+    (void)proton_append_schema_hash(buffer, buffer_len, len, node->registry->schema_hash);
+  }
+}
+
+/**
+ * @brief Record the schema hash a peer sent, for every destination endpoint of that peer
+ */
+static void proton_node_record_peer_schema(
+  proton_node_t * node, uint32_t peer_node_id, uint32_t schema_hash)
+{
+  for (size_t i = 0; i < node->num_peers; i++)
+  {
+    if (node->destination_peers[i].node_id == peer_node_id)
+    {
+      node->peer_schema_hashes[i] = schema_hash;
+    }
+  }
+}
+
 /**
  * Encode a bundle for sending from a node. Updates the bundle metadata in the registry
  * @NOTE the bundle ID should be set for this bundle in the registry before calling the function
@@ -53,72 +157,624 @@ static bool proton_bundle_overdue_ms(
  * - dest_peers: output parameter for the list of destination peers to send this bundle to
  * - num_dest_peers: the number of destination peers available in the dest_peers buffer
  * - num_selected_peers: output parameter for the number of peers selected for this bundle (should be >= num_dest_peers)
+ * - framing: transport framing to encode the bundle into, or NULL for a bare message. out_len is
+ *   then the length of the whole frame
  * @return status of the operation
  */
 static proton_status_e proton_node_encode_bundle_desc(
   proton_node_t * node, size_t slot_id, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len,
   size_t * out_len, proton_endpoint_t * dest_peers, size_t num_dest_peers,
-  size_t * num_selected_peers)
+  size_t * num_selected_peers, const proton_framing_t * framing)
 {
   bundle_desc_t * bundle_handle = &node->registry->bundle_table[slot_id];
 
-  // Check the target endpoint buffer is big enough for the endpoints for this bundle
-  if (bundle_handle->consumer_ids.count > num_dest_peers)
+  size_t headroom = framing ? framing->headroom : 0;
+  size_t tailroom = framing ? framing->tailroom : 0;
+  if (buffer_len < headroom + tailroom)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  proton_status_e peers_status = proton_node_select_bundle_peers(
+    node, bundle_handle, dest_peers, num_dest_peers, num_selected_peers);
+  if (peers_status != PROTON_OK)
+  {
+    return peers_status;
+  }
+
+  bundle_handle->last_send_ms = uptime_ms;
+  bundle_handle->send_now = false;
+
+  uint8_t * message = buffer + headroom;
+  size_t message_space = buffer_len - headroom - tailroom;
+  size_t message_len = 0;
+  proton_status_e status = proton_encode_bundle_direct(
+    node->registry, bundle_handle->bundle_id, message, message_space, &message_len);
+  if (status == PROTON_OK)
+  {
+    proton_node_advertise_schema(node, message, message_space, &message_len);
+    proton_bundle_mark_sent(node->registry, bundle_handle);
+
+    if (framing && framing->fill)
+    {
+      status = framing->fill(buffer, message_len, 0, framing->arg);
+    }
+    *out_len = headroom + message_len + tailroom;
+  }
+
+  return status;
+}
+
+/**
+ * @brief Determine if the node is a producer of a particular bundle
+ */
+static bool proton_node_is_producer(uint32_t node_id, const proton_id_list_t * bundle_id_list)
+{
+  bool node_is_producer = false;
+  for (uint8_t i = 0; i < bundle_id_list->count; i++)
+  {
+    if (node_id == bundle_id_list->ids[i])
+    {
+      node_is_producer = true;
+      break;
+    }
+  }
+
+  return node_is_producer;
+}
+
+/**
+ * Heap order of two schedule entries: earlier deadline first, using a wrap-safe serial comparison so
+ * that deadlines past UINT64_MAX order correctly. Equal deadlines favour the higher slot, matching the
+ * tie-breaking of a scan over the bundle table.
+ */
+static bool proton_schedule_before(
+  const proton_schedule_entry_t * a, const proton_schedule_entry_t * b)
+{
+  int64_t diff = (int64_t)(a->deadline_ms - b->deadline_ms);
+  if (diff != 0)
+  {
+    return diff < 0;
+  }
+
+  return a->slot > b->slot;
+}
+
+static void proton_schedule_sift_up(proton_schedule_entry_t * heap, uint16_t pos)
+{
+  while (pos > 0)
+  {
+    uint16_t parent = (pos - 1) / 2;
+    if (!proton_schedule_before(&heap[pos], &heap[parent]))
+    {
+      break;
+    }
+
+    proton_schedule_entry_t tmp = heap[parent];
+    heap[parent] = heap[pos];
+    heap[pos] = tmp;
+    pos = parent;
+  }
+}
+
+static void proton_schedule_sift_down(proton_schedule_entry_t * heap, uint16_t size, uint16_t pos)
+{
+  for (;;)
+  {
+    uint16_t first = pos;
+    uint16_t left = 2 * pos + 1;
+    uint16_t right = left + 1;
+    if (left < size && proton_schedule_before(&heap[left], &heap[first]))
+    {
+      first = left;
+    }
+    if (right < size && proton_schedule_before(&heap[right], &heap[first]))
+    {
+      first = right;
+    }
+    if (first == pos)
+    {
+      break;
+    }
+
+    proton_schedule_entry_t tmp = heap[first];
+    heap[first] = heap[pos];
+    heap[pos] = tmp;
+    pos = first;
+  }
+}
+
+static uint64_t proton_bundle_deadline_ms(const bundle_desc_t * bundle)
+{
+  return bundle->last_send_ms + (uint64_t)bundle->period_ms;
+}
+
+/**
+ * @brief Determine if the scheduler has storage for every bundle in the node's registry
+ */
+static bool proton_node_scheduler_usable(const proton_node_t * node)
+{
+  const proton_node_scheduler_t * sched = &node->scheduler;
+  return sched->heap != NULL && sched->triggered != NULL &&
+         sched->capacity >= node->registry->bundle_count;
+}
+
+static bool proton_node_scheduler_stale(const proton_node_t * node)
+{
+  const proton_node_scheduler_t * sched = &node->scheduler;
+  return !sched->initialized || sched->bundle_table != node->registry->bundle_table ||
+         sched->bundle_count != node->registry->bundle_count ||
+         sched->bundle_schedule_version != node->registry->bundle_schedule_version;
+}
+
+/**
+ * Rebuild the schedule from the bundle table: produced periodic bundles go into the heap, and
+ * produced bundles flagged send_now into the triggered lane.
+ */
+static void proton_node_scheduler_rebuild(proton_node_t * node)
+{
+  proton_node_scheduler_t * sched = &node->scheduler;
+  const proton_registry_t * registry = node->registry;
+
+  sched->heap_size = 0;
+  sched->triggered_size = 0;
+
+  for (uint16_t i = 0; i < registry->bundle_count; i++)
+  {
+    const bundle_desc_t * bundle_desc = &registry->bundle_table[i];
+    if (!proton_node_is_producer(node->id, &bundle_desc->producer_ids))
+    {
+      continue;
+    }
+
+    if (bundle_desc->period_ms != 0)
+    {
+      sched->heap[sched->heap_size].deadline_ms = proton_bundle_deadline_ms(bundle_desc);
+      sched->heap[sched->heap_size].slot = i;
+      proton_schedule_sift_up(sched->heap, sched->heap_size);
+      sched->heap_size++;
+    }
+
+    if (bundle_desc->send_now)
+    {
+      sched->triggered[sched->triggered_size++] = i;
+    }
+  }
+
+  sched->bundle_table = registry->bundle_table;
+  sched->bundle_count = registry->bundle_count;
+  sched->bundle_schedule_version = registry->bundle_schedule_version;
+  sched->initialized = true;
+}
+
+/**
+ * Bring the top of the heap up to date and return it, NULL if the heap is empty
+ */
+static const proton_schedule_entry_t * proton_node_scheduler_peek(proton_node_t * node)
+{
+  proton_node_scheduler_t * sched = &node->scheduler;
+
+  while (sched->heap_size > 0)
+  {
+    proton_schedule_entry_t * top = &sched->heap[0];
+    uint64_t deadline_ms = proton_bundle_deadline_ms(&node->registry->bundle_table[top->slot]);
+    if (deadline_ms == top->deadline_ms)
+    {
+      return top;
+    }
+
+    top->deadline_ms = deadline_ms;
+    proton_schedule_sift_down(sched->heap, sched->heap_size, 0);
+  }
+
+  return NULL;
+}
+
+/**
+ * Pick the next bundle to send from the schedule, following the same priority rules as the table
+ * scan: the most overdue triggered bundle, otherwise the most overdue due periodic bundle.
+ * Heap entries are re-keyed lazily: a bundle sent outside of the heap order (triggered, or encoded
+ * directly) only has a later deadline than its cached one, and is fixed up when it reaches the top.
+ * @return true if a bundle should be sent, with its slot in *slot_id
+ */
+static bool proton_node_scheduler_select(proton_node_t * node, uint64_t uptime_ms, size_t * slot_id)
+{
+  proton_node_scheduler_t * sched = &node->scheduler;
+  const bundle_desc_t * table = node->registry->bundle_table;
+
+  if (sched->triggered_size > 0)
+  {
+    bool found = false;
+    uint16_t best_pos = 0;
+    uint64_t most_overdue_ms = 0;
+
+    uint16_t pos = 0;
+    while (pos < sched->triggered_size)
+    {
+      uint16_t slot = sched->triggered[pos];
+      if (!table[slot].send_now)
+      {
+        // Already sent since it was triggered
+        sched->triggered[pos] = sched->triggered[--sched->triggered_size];
+        continue;
+      }
+
+      uint64_t candidate_overdue = 0;
+      proton_bundle_overdue_ms(
+        uptime_ms, table[slot].last_send_ms, table[slot].period_ms, &candidate_overdue);
+      if (
+        !found || candidate_overdue > most_overdue_ms ||
+        (candidate_overdue == most_overdue_ms && slot > sched->triggered[best_pos]))
+      {
+        found = true;
+        best_pos = pos;
+        most_overdue_ms = candidate_overdue;
+      }
+      pos++;
+    }
+
+    if (found)
+    {
+      *slot_id = sched->triggered[best_pos];
+      sched->triggered[best_pos] = sched->triggered[--sched->triggered_size];
+      return true;
+    }
+  }
+
+  const proton_schedule_entry_t * top = proton_node_scheduler_peek(node);
+  if (top == NULL)
+  {
+    return false;
+  }
+
+  const bundle_desc_t * bundle_desc = &table[top->slot];
+  if (!proton_bundle_overdue_ms(uptime_ms, bundle_desc->last_send_ms, bundle_desc->period_ms, NULL))
+  {
+    return false;
+  }
+
+  *slot_id = top->slot;
+  return true;
+}
+
+/**
+ * Move a bundle that was just sent from the top of the heap to its new deadline
+ */
+static void proton_node_scheduler_reschedule(proton_node_t * node, size_t slot_id)
+{
+  proton_node_scheduler_t * sched = &node->scheduler;
+  if (sched->heap_size > 0 && sched->heap[0].slot == slot_id)
+  {
+    sched->heap[0].deadline_ms = proton_bundle_deadline_ms(&node->registry->bundle_table[slot_id]);
+    proton_schedule_sift_down(sched->heap, sched->heap_size, 0);
+  }
+}
+
+/**
+ * Return a selected bundle that could not be sent to the schedule. Only triggered bundles leave the
+ * schedule when selected, periodic bundles keep their place in the heap until they are sent.
+ */
+static void proton_node_scheduler_unselect(proton_node_t * node, size_t slot_id)
+{
+  proton_node_scheduler_t * sched = &node->scheduler;
+  if (node->registry->bundle_table[slot_id].send_now && sched->triggered_size < sched->capacity)
+  {
+    sched->triggered[sched->triggered_size++] = (uint16_t)slot_id;
+  }
+}
+
+/**
+ * Pick the next bundle to send by scanning the whole bundle table. Used when the node has no
+ * scheduler storage.
+ * @return true if a bundle should be sent, with its slot in *slot_id
+ */
+static bool proton_node_select_linear(proton_node_t * node, uint64_t uptime_ms, size_t * slot_id)
+{
+  bool something_to_send = false;
+  uint64_t most_overdue_ms = 0;
+  bool send_now_flag = false;
+
+  for (size_t i = 0; i < node->registry->bundle_count; i++)
+  {
+    bundle_desc_t * bundle_desc = &node->registry->bundle_table[i];
+
+    // Don't send bundles that aren't supposed to be sent by this node.
+    if (!proton_node_is_producer(node->id, &bundle_desc->producer_ids))
+    {
+      continue;
+    }
+    // Check triggered bundles
+    if (bundle_desc->send_now)
+    {
+      // If this is our first triggered bundle, we will skip looking at non-triggered bundles (via send_now_flag)
+      uint64_t candidate_overdue = 0;
+      // We also don't care about whether the triggered bundle is overdue, just how overdue it is.
+      proton_bundle_overdue_ms(
+        uptime_ms, bundle_desc->last_send_ms, bundle_desc->period_ms, &candidate_overdue);
+      if (!send_now_flag)
+      {
+        send_now_flag = true;
+        most_overdue_ms = candidate_overdue;
+        *slot_id = i;
+        something_to_send = true;
+      }
+      // Check if this triggered bundle is more overdue than our current candidate triggered bundle
+      else if (candidate_overdue >= most_overdue_ms)
+      {
+        most_overdue_ms = candidate_overdue;
+        *slot_id = i;
+        something_to_send = true;
+      }
+    }
+    // No triggered bundles, check non-triggered bundles for the most overdue bundle to send
+    else if (!send_now_flag)
+    {
+      if (bundle_desc->period_ms != 0)
+      {
+        uint64_t candidate_overdue = 0;
+        if (
+          proton_bundle_overdue_ms(
+            uptime_ms, bundle_desc->last_send_ms, bundle_desc->period_ms, &candidate_overdue))
+        {
+          if (candidate_overdue >= most_overdue_ms)
+          {
+            most_overdue_ms = candidate_overdue;
+            *slot_id = i;
+            something_to_send = true;
+          }
+        }
+      }
+    }
+  }
+
+  return something_to_send;
+}
+
+/**
+ * Drain the pending trigger buffer into send_now flags and bring the scheduler up to date with the
+ * registry. Must be called with the registry locked, before selecting bundles to send.
+ * @return true if the scheduler should be used for selection, false to scan the bundle table
+ */
+static bool proton_node_prepare_selection(proton_node_t * node)
+{
+  bool use_scheduler = proton_node_scheduler_usable(node);
+  bool scheduler_stale = !use_scheduler || proton_node_scheduler_stale(node);
+
+  // Mark any bundles in the pending trigger buffer to be sent now
+  while (node->trigger_tail != node->trigger_head)
+  {
+    uint32_t trigger_slot = node->pending_triggers[node->trigger_tail];
+    bundle_desc_t * bundle_desc = &node->registry->bundle_table[trigger_slot];
+    if (!bundle_desc->send_now && !scheduler_stale)
+    {
+      if (node->scheduler.triggered_size < node->scheduler.capacity)
+      {
+        node->scheduler.triggered[node->scheduler.triggered_size++] = (uint16_t)trigger_slot;
+      }
+      else
+      {
+        // Lane is full of entries already sent through other paths, collect it again from the table
+        scheduler_stale = true;
+      }
+    }
+    bundle_desc->send_now = true;
+    node->trigger_tail = (node->trigger_tail + 1) % PROTON_MAX_PENDING_TRIGGERS;
+  }
+
+  if (use_scheduler && scheduler_stale)
+  {
+    proton_node_scheduler_rebuild(node);
+  }
+
+  return use_scheduler;
+}
+
+/**
+ * Pick the next bundle to send, according to the priority rules of proton_node_update
+ * @return true if a bundle should be sent, with its slot in *slot_id
+ */
+static bool proton_node_select_next(
+  proton_node_t * node, bool use_scheduler, uint64_t uptime_ms, size_t * slot_id)
+{
+  if (use_scheduler)
+  {
+    return proton_node_scheduler_select(node, uptime_ms, slot_id);
+  }
+
+  return proton_node_select_linear(node, uptime_ms, slot_id);
+}
+
+/**
+ * Call the bundle callback of a bundle decoded by proton_node_receive
+ * @param arg the receiving node
+ */
+static proton_status_e proton_node_dispatch_bundle(
+  proton_registry_t * registry, uint32_t bundle_id, void * arg)
+{
+  (void)arg;
+
+  size_t slot_id;
+  const bundle_desc_t * bundle_desc = proton_registry_get_bundle(registry, bundle_id, &slot_id);
+
+  if (bundle_desc == NULL)
+  {
+    // If the bundle ID is not found, then this is likely not a bundle for this target
+    return PROTON_INCORRECT_TARGET_ERROR;
+  }
+
+  // Get the bundle callback directly from the bundle descriptor
+  proton_bundle_cb_t * callback_desc = &registry->bundle_table[slot_id].callback;
+
+  if (callback_desc->cb != NULL)
+  {
+    callback_desc->cb(
+      bundle_id, bundle_desc->signal_ids.ids, bundle_desc->signal_ids.count, callback_desc->arg);
+  }
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_node_receive(proton_node_t * node, const uint8_t * buffer, size_t len)
+{
+  if (node == NULL || node->registry == NULL || buffer == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  proton_status_e lock_status = proton_lock_registry(node->registry);
+  if (lock_status != PROTON_OK)
+  {
+    return lock_status;
+  }
+
+  // No unsupported operation check here, handled in proton_decode_direct
+  proton_status_e decode_result =
+    proton_decode_direct(node->registry, buffer, len, proton_node_dispatch_bundle, node);
+
+  proton_status_e unlock_status = proton_unlock_registry(node->registry);
+  if (unlock_status != PROTON_OK)
+  {
+    return unlock_status;
+  }
+
+  return decode_result;
+}
+
+proton_status_e proton_node_receive_frame(
+  proton_node_t * node, const uint8_t * buffer, size_t len, uint32_t peer_node_id,
+  uint8_t frame_flags)
+{
+  if (node == NULL || node->registry == NULL || buffer == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  proton_status_e lock_status = proton_lock_registry(node->registry);
+  if (lock_status != PROTON_OK)
+  {
+    return lock_status;
+  }
+
+  proton_status_e decode_result = PROTON_OK;
+  if (frame_flags & PROTON_FRAME_FLAG_COMPACT)
+  {
+    decode_result =
+      proton_decode_compact(node->registry, buffer, len, proton_node_dispatch_bundle, node);
+
+    // Any compact frame tells which schema the peer uses, even one that cannot be decoded
+    proton_reader_t reader = {.pos = buffer, .end = buffer + len};
+    uint64_t schema_hash = 0;
+    if (
+      node->peer_schema_hashes != NULL &&
+      proton_read_fixed(&reader, PROTON_COMPACT_HEADER_LEN, &schema_hash))
+    {
+      proton_node_record_peer_schema(node, peer_node_id, (uint32_t)schema_hash);
+    }
+  }
+  else
+  {
+    uint32_t schema_hash = 0;
+    if (node->peer_schema_hashes != NULL && proton_read_schema_hash(buffer, len, &schema_hash))
+    {
+      proton_node_record_peer_schema(node, peer_node_id, schema_hash);
+    }
+
+    decode_result =
+      proton_decode_direct(node->registry, buffer, len, proton_node_dispatch_bundle, node);
+  }
+
+  proton_status_e unlock_status = proton_unlock_registry(node->registry);
+  if (unlock_status != PROTON_OK)
+  {
+    return unlock_status;
+  }
+
+  return decode_result;
+}
+
+proton_status_e proton_node_update(
+  proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len, size_t * out_len,
+  proton_endpoint_t * dest_peers, size_t num_dest_peers, size_t * num_selected_peers)
+{
+  return proton_node_update_framed(
+    node, uptime_ms, buffer, buffer_len, NULL, out_len, dest_peers, num_dest_peers,
+    num_selected_peers);
+}
+
+proton_status_e proton_node_update_framed(
+  proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len,
+  const proton_framing_t * framing, size_t * out_len, proton_endpoint_t * dest_peers,
+  size_t num_dest_peers, size_t * num_selected_peers)
+{
+  if (
+    node == NULL || node->registry == NULL || buffer == NULL || out_len == NULL ||
+    dest_peers == NULL || num_selected_peers == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (num_dest_peers == 0)
   {
     return PROTON_INSUFFICIENT_BUFFER_ERROR;
   }
 
-  size_t dest_idx = 0;
-  for (size_t i = 0; i < bundle_handle->consumer_ids.count; i++)
+  proton_status_e lock_status = proton_lock_registry(node->registry);
+  if (lock_status != PROTON_OK)
   {
-    for (size_t j = 0; j < node->num_peers; j++)
-    {
-      if (bundle_handle->consumer_ids.ids[i] == node->destination_peers[j].node_id)
-      {
-        proton_endpoint_t * ep = &dest_peers[dest_idx];
-        ep->node_id = bundle_handle->consumer_ids.ids[i];
-        ep->transport_type = node->destination_peers[j].transport_type;
-        ep->endpoint_id = node->destination_peers[j].endpoint_id;
-        dest_idx++;
-        break;
-      }
-    }
+    return lock_status;
   }
-  *num_selected_peers = bundle_handle->consumer_ids.count;
 
-  bundle_handle->last_send_ms = uptime_ms;
-  bundle_handle->send_now = false;
+  bool use_scheduler = proton_node_prepare_selection(node);
 
-  return proton_encode_bundle(
-    node->registry, bundle_handle->bundle_id, buffer, buffer_len, out_len);
-}
+  size_t slot_id = 0;
+  bool something_to_send = proton_node_select_next(node, use_scheduler, uptime_ms, &slot_id);
 
-/**
- * @brief Determine if the node is a producer of a particular bundle
- */
-static bool proton_node_is_producer(uint32_t node_id, const proton_id_list_t * bundle_id_list)
-{
-  bool node_is_producer = false;
-  for (uint8_t i = 0; i < bundle_id_list->count; i++)
+  proton_status_e ret = PROTON_OK;
+  if (something_to_send)
   {
-    if (node_id == bundle_id_list->ids[i])
+    // We have our priority bundle, encode it
+    ret = proton_node_encode_bundle_desc(
+      node, slot_id, uptime_ms, buffer, buffer_len, out_len, dest_peers, num_dest_peers,
+      num_selected_peers, framing);
+
+    if (use_scheduler)
     {
-      node_is_producer = true;
-      break;
+      if (ret != PROTON_OK)
+      {
+        // Leave a triggered bundle that was not consumed scheduled for the next call
+        proton_node_scheduler_unselect(node, slot_id);
+      }
+      proton_node_scheduler_reschedule(node, slot_id);
     }
   }
 
-  return node_is_producer;
+  proton_status_e unlock_status = proton_unlock_registry(node->registry);
+  if (unlock_status != PROTON_OK)
+  {
+    return unlock_status;
+  }
+
+  return ret;
 }
 
-proton_status_e proton_node_receive(proton_node_t * node, const uint8_t * buffer, size_t len)
+proton_status_e proton_node_update_batch(
+  proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len,
+  proton_bundle_record_t * records, size_t max_records, size_t * num_records,
+  proton_endpoint_t * dest_peers, size_t num_dest_peers)
 {
-  if (node == NULL || node->registry == NULL || buffer == NULL)
+  if (
+    node == NULL || node->registry == NULL || buffer == NULL || records == NULL ||
+    num_records == NULL || dest_peers == NULL)
   {
     return PROTON_NULL_PTR_ERROR;
   }
 
-  proton_Proton msg = proton_Proton_init_default;
+  *num_records = 0;
+
+  if (max_records == 0 || num_dest_peers == 0)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
 
   proton_status_e lock_status = proton_lock_registry(node->registry);
   if (lock_status != PROTON_OK)
@@ -126,48 +782,186 @@ proton_status_e proton_node_receive(proton_node_t * node, const uint8_t * buffer
     return lock_status;
   }
 
-  proton_status_e decode_result = proton_decode(node->registry, buffer, len, &msg);
+  bool use_scheduler = proton_node_prepare_selection(node);
 
-  if (decode_result == PROTON_OK)
+  proton_status_e ret = PROTON_OK;
+  size_t buffer_used = 0;
+  size_t peers_used = 0;
+  size_t slot_id = 0;
+  while (*num_records < max_records &&
+         proton_node_select_next(node, use_scheduler, uptime_ms, &slot_id))
   {
-    if (msg.which_operation == proton_Proton_bundle_tag)
+    bundle_desc_t * bundle_handle = &node->registry->bundle_table[slot_id];
+    proton_bundle_record_t * record = &records[*num_records];
+
+    size_t num_selected_peers = 0;
+    proton_status_e status = proton_node_select_bundle_peers(
+      node, bundle_handle, &dest_peers[peers_used], num_dest_peers - peers_used,
+      &num_selected_peers);
+
+    if (status != PROTON_OK)
     {
-      size_t slot_id;
-      uint32_t bundle_id = msg.operation.bundle.id;
-      const bundle_desc_t * bundle_desc =
-        proton_registry_get_bundle(node->registry, bundle_id, &slot_id);
+      // Leave the bundle scheduled for the next call
+      if (use_scheduler)
+      {
+        proton_node_scheduler_unselect(node, slot_id);
+      }
+      ret = *num_records == 0 ? status : PROTON_OK;
+      break;
+    }
 
-      if (bundle_desc == NULL)
+    size_t encoded_len = 0;
+    bool compact = proton_node_peers_compact(node, &dest_peers[peers_used], num_selected_peers);
+    if (compact)
+    {
+      status = proton_encode_bundle_compact(
+        node->registry, bundle_handle->bundle_id, &buffer[buffer_used], buffer_len - buffer_used,
+        &encoded_len);
+    }
+    else
+    {
+      status = proton_encode_bundle_direct(
+        node->registry, bundle_handle->bundle_id, &buffer[buffer_used], buffer_len - buffer_used,
+        &encoded_len);
+      if (status == PROTON_OK)
       {
-        // If the bundle ID is not found, then this is likely not a bundle for this target
-        decode_result = PROTON_INCORRECT_TARGET_ERROR;
+        proton_node_advertise_schema(
+          node, &buffer[buffer_used], buffer_len - buffer_used, &encoded_len);
       }
-      else
+    }
+    if (status != PROTON_OK && *num_records > 0)
+    {
+      // Out of space after earlier bundles, leave this one scheduled for the next call
+      if (use_scheduler)
       {
-        // Get the bundle callback directly from the bundle descriptor
-        proton_bundle_cb_t * callback_desc = &node->registry->bundle_table[slot_id].callback;
-
-        if (callback_desc != NULL && callback_desc->cb != NULL)
-        {
-          callback_desc->cb(
-            bundle_id, bundle_desc->signal_ids.ids, bundle_desc->signal_ids.count,
-            callback_desc->arg);
-        }
+        proton_node_scheduler_unselect(node, slot_id);
       }
+      break;
+    }
+
+    // As with proton_node_update, a bundle that fails to encode on its own is still consumed
+    bundle_handle->last_send_ms = uptime_ms;
+    bundle_handle->send_now = false;
+    if (use_scheduler)
+    {
+      proton_node_scheduler_reschedule(node, slot_id);
+    }
+
+    if (status != PROTON_OK)
+    {
+      ret = status;
+      break;
     }
+
+    proton_bundle_mark_sent(node->registry, bundle_handle);
+    record->offset = buffer_used;
+    record->length = encoded_len;
+    record->frame_flags = compact ? PROTON_FRAME_FLAG_COMPACT : 0;
+    record->bundle_id = bundle_handle->bundle_id;
+    record->peers = &dest_peers[peers_used];
+    record->num_peers = num_selected_peers;
+
+    buffer_used += encoded_len;
+    peers_used += num_selected_peers;
+    (*num_records)++;
   }
 
-  // No unsupported operation check here, handled in proton_decode
   proton_status_e unlock_status = proton_unlock_registry(node->registry);
   if (unlock_status != PROTON_OK)
   {
     return unlock_status;
   }
 
-  return decode_result;
+  return ret;
 }
 
-proton_status_e proton_node_update(
+/**
+ * @brief Determine if two ID lists hold the same IDs, in any order
+ */
+static bool proton_id_lists_match(const proton_id_list_t * a, const proton_id_list_t * b)
+{
+  if (a->count != b->count)
+  {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < a->count; i++)
+  {
+    bool found = false;
+    for (uint8_t j = 0; j < b->count; j++)
+    {
+      if (a->ids[i] == b->ids[j])
+      {
+        found = true;
+        break;
+      }
+    }
+    if (!found)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Smallest non-zero MTU of a list of peers, 0 if none of them has an MTU
+ */
+static size_t proton_peers_mtu(const proton_endpoint_t * peers, size_t num_peers)
+{
+  size_t mtu = 0;
+  for (size_t i = 0; i < num_peers; i++)
+  {
+    if (peers[i].mtu != 0 && (mtu == 0 || peers[i].mtu < mtu))
+    {
+      mtu = peers[i].mtu;
+    }
+  }
+  return mtu;
+}
+
+/**
+ * Add every other due bundle sent to the same consumers as the selected bundle to a bundle set,
+ * marking the ones that fit as sent. Bundles that do not fit are skipped in favour of smaller ones.
+ * The scheduler does not need updating: lane entries of sent bundles are dropped when reached, and
+ * heap entries are re-keyed to their later deadline.
+ */
+static void proton_node_coalesce_bundles(
+  proton_node_t * node, size_t selected_slot, uint64_t uptime_ms,
+  proton_bundle_set_encoder_t * encoder)
+{
+  const bundle_desc_t * selected = &node->registry->bundle_table[selected_slot];
+
+  for (size_t i = 0; i < node->registry->bundle_count; i++)
+  {
+    bundle_desc_t * bundle_desc = &node->registry->bundle_table[i];
+    if (
+      i == selected_slot || !proton_node_is_producer(node->id, &bundle_desc->producer_ids) ||
+      !proton_id_lists_match(&bundle_desc->consumer_ids, &selected->consumer_ids))
+    {
+      continue;
+    }
+
+    bool due = bundle_desc->send_now ||
+               (bundle_desc->period_ms != 0 &&
+                proton_bundle_overdue_ms(
+                  uptime_ms, bundle_desc->last_send_ms, bundle_desc->period_ms, NULL));
+    if (!due)
+    {
+      continue;
+    }
+
+    if (proton_bundle_set_add(encoder, node->registry, bundle_desc->bundle_id) == PROTON_OK)
+    {
+      bundle_desc->last_send_ms = uptime_ms;
+      bundle_desc->send_now = false;
+      proton_bundle_mark_sent(node->registry, bundle_desc);
+    }
+  }
+}
+
+proton_status_e proton_node_update_coalesced(
   proton_node_t * node, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len, size_t * out_len,
   proton_endpoint_t * dest_peers, size_t num_dest_peers, size_t * num_selected_peers)
 {
@@ -183,11 +977,8 @@ proton_status_e proton_node_update(
     return PROTON_INSUFFICIENT_BUFFER_ERROR;
   }
 
-  bool something_to_send = false;
-
-  uint64_t most_overdue_ms = 0;
-  bool send_now_flag = false;
-  size_t slot_id = 0;
+  *out_len = 0;
+  *num_selected_peers = 0;
 
   proton_status_e lock_status = proton_lock_registry(node->registry);
   if (lock_status != PROTON_OK)
@@ -195,75 +986,54 @@ proton_status_e proton_node_update(
     return lock_status;
   }
 
-  // Mark any bundles in the pending trigger buffer to be sent now
-  while (node->trigger_tail != node->trigger_head)
-  {
-    node->registry->bundle_table[node->pending_triggers[node->trigger_tail]].send_now = true;
-    node->trigger_tail = (node->trigger_tail + 1) % PROTON_MAX_PENDING_TRIGGERS;
-  }
+  bool use_scheduler = proton_node_prepare_selection(node);
 
-  for (size_t i = 0; i < node->registry->bundle_count; i++)
+  size_t slot_id = 0;
+  proton_status_e ret = PROTON_OK;
+  if (proton_node_select_next(node, use_scheduler, uptime_ms, &slot_id))
   {
-    bundle_desc_t * bundle_desc = &node->registry->bundle_table[i];
+    bundle_desc_t * bundle_handle = &node->registry->bundle_table[slot_id];
+    ret = proton_node_select_bundle_peers(
+      node, bundle_handle, dest_peers, num_dest_peers, num_selected_peers);
 
-    // Don't send bundles that aren't supposed to be sent by this node.
-    if (!proton_node_is_producer(node->id, &bundle_desc->producer_ids))
+    if (ret != PROTON_OK)
     {
-      continue;
+      if (use_scheduler)
+      {
+        proton_node_scheduler_unselect(node, slot_id);
+      }
     }
-    // Check triggered bundles
-    if (bundle_desc->send_now)
+    else
     {
-      // If this is our first triggered bundle, we will skip looking at non-triggered bundles (via send_now_flag)
-      uint64_t candidate_overdue = 0;
-      // We also don't care about whether the triggered bundle is overdue, just how overdue it is.
-      proton_bundle_overdue_ms(
-        uptime_ms, bundle_desc->last_send_ms, bundle_desc->period_ms, &candidate_overdue);
-      if (!send_now_flag)
+      proton_bundle_set_encoder_t encoder;
+      ret = proton_bundle_set_init(
+        &encoder, buffer, buffer_len, proton_peers_mtu(dest_peers, *num_selected_peers));
+      if (ret == PROTON_OK)
       {
-        send_now_flag = true;
-        most_overdue_ms = candidate_overdue;
-        slot_id = i;
-        something_to_send = true;
+        ret = proton_bundle_set_add(&encoder, node->registry, bundle_handle->bundle_id);
       }
-      // Check if this triggered bundle is more overdue than our current candidate triggered bundle
-      else if (candidate_overdue >= most_overdue_ms)
+
+      // As with proton_node_update, the selected bundle is consumed even if it fails to encode
+      bundle_handle->last_send_ms = uptime_ms;
+      bundle_handle->send_now = false;
+      if (use_scheduler)
       {
-        most_overdue_ms = candidate_overdue;
-        slot_id = i;
-        something_to_send = true;
+        proton_node_scheduler_reschedule(node, slot_id);
       }
-    }
-    // No triggered bundles, check non-triggered bundles for the most overdue bundle to send
-    else if (!send_now_flag)
-    {
-      if (bundle_desc->period_ms != 0)
+
+      if (ret == PROTON_OK)
       {
-        uint64_t candidate_overdue = 0;
-        if (
-          proton_bundle_overdue_ms(
-            uptime_ms, bundle_desc->last_send_ms, bundle_desc->period_ms, &candidate_overdue))
-        {
-          if (candidate_overdue >= most_overdue_ms)
-          {
-            most_overdue_ms = candidate_overdue;
-            slot_id = i;
-            something_to_send = true;
-          }
-        }
+        proton_bundle_mark_sent(node->registry, bundle_handle);
+        proton_node_coalesce_bundles(node, slot_id, uptime_ms, &encoder);
+        ret = proton_bundle_set_finish(&encoder, out_len);
+      }
+      if (ret == PROTON_OK)
+      {
+        proton_node_advertise_schema(node, buffer, buffer_len, out_len);
       }
     }
   }
 
-  proton_status_e ret = PROTON_OK;
-  if (something_to_send)
-  {
-    // We have our priority bundle, encode it
-    ret = proton_node_encode_bundle_desc(
-      node, slot_id, uptime_ms, buffer, buffer_len, out_len, dest_peers, num_dest_peers,
-      num_selected_peers);
-  }
-
   proton_status_e unlock_status = proton_unlock_registry(node->registry);
   if (unlock_status != PROTON_OK)
   {
@@ -273,6 +1043,88 @@ proton_status_e proton_node_update(
   return ret;
 }
 
+void proton_node_reset_scheduler(proton_node_t * node)
+{
+  if (node != NULL)
+  {
+    node->scheduler.initialized = false;
+  }
+}
+
+proton_status_e proton_node_next_deadline(
+  proton_node_t * node, uint64_t uptime_ms, uint64_t * deadline_ms, bool * has_deadline)
+{
+  if (node == NULL || node->registry == NULL || deadline_ms == NULL || has_deadline == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  proton_status_e lock_status = proton_lock_registry(node->registry);
+  if (lock_status != PROTON_OK)
+  {
+    return lock_status;
+  }
+
+  bool use_scheduler = proton_node_prepare_selection(node);
+  const bundle_desc_t * table = node->registry->bundle_table;
+  bool found = false;
+  uint64_t deadline = 0;
+
+  if (use_scheduler)
+  {
+    const proton_node_scheduler_t * sched = &node->scheduler;
+    for (uint16_t i = 0; i < sched->triggered_size && !found; i++)
+    {
+      found = table[sched->triggered[i]].send_now;
+    }
+
+    if (found)
+    {
+      deadline = uptime_ms;
+    }
+    else
+    {
+      const proton_schedule_entry_t * top = proton_node_scheduler_peek(node);
+      if (top != NULL)
+      {
+        found = true;
+        deadline = top->deadline_ms;
+      }
+    }
+  }
+  else
+  {
+    for (uint16_t i = 0; i < node->registry->bundle_count; i++)
+    {
+      const bundle_desc_t * bundle_desc = &table[i];
+      if (!proton_node_is_producer(node->id, &bundle_desc->producer_ids))
+      {
+        continue;
+      }
+
+      if (bundle_desc->send_now)
+      {
+        found = true;
+        deadline = uptime_ms;
+        break;
+      }
+
+      // Same wrap-safe ordering as the schedule heap
+      uint64_t bundle_deadline = proton_bundle_deadline_ms(bundle_desc);
+      if (bundle_desc->period_ms != 0 && (!found || (int64_t)(bundle_deadline - deadline) < 0))
+      {
+        found = true;
+        deadline = bundle_deadline;
+      }
+    }
+  }
+
+  *has_deadline = found;
+  *deadline_ms = deadline;
+
+  return proton_unlock_registry(node->registry);
+}
+
 proton_status_e proton_node_trigger_bundle(proton_node_t * node, uint32_t bundle_id)
 {
   if (node == NULL || node->registry == NULL)
@@ -330,6 +1182,16 @@ proton_status_e proton_node_encode_bundle(
   proton_node_t * node, uint32_t bundle_id, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len,
   size_t * out_len, proton_endpoint_t * dest_peers, size_t num_dest_peers,
   size_t * num_selected_peers)
+{
+  return proton_node_encode_bundle_framed(
+    node, bundle_id, uptime_ms, buffer, buffer_len, NULL, out_len, dest_peers, num_dest_peers,
+    num_selected_peers);
+}
+
+proton_status_e proton_node_encode_bundle_framed(
+  proton_node_t * node, uint32_t bundle_id, uint64_t uptime_ms, uint8_t * buffer,
+  size_t buffer_len, const proton_framing_t * framing, size_t * out_len,
+  proton_endpoint_t * dest_peers, size_t num_dest_peers, size_t * num_selected_peers)
 {
   if (
     node == NULL || node->registry == NULL || buffer == NULL || out_len == NULL ||
@@ -362,7 +1224,7 @@ proton_status_e proton_node_encode_bundle(
   {
     enc_ret = proton_node_encode_bundle_desc(
       node, slot_id, uptime_ms, buffer, buffer_len, out_len, dest_peers, num_dest_peers,
-      num_selected_peers);
+      num_selected_peers, framing);
   }
 
   proton_status_e unlock_status = proton_unlock_registry(node->registry);
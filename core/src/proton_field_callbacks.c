@@ -22,11 +22,15 @@
 #include "pb_decode.h"
 #include "pb_encode.h"
 #include "proton/common.h"
+#include "proton/encode_decode.h"
 #include "proton/registry.h"
 
+// Number of array elements packed at a time when encoding, the largest packed element is 10 bytes
+#define PROTON_PACKED_CHUNK_ELEMENTS 16
+
 /**
  * Callback for encoding/decoding proton_Signal message.
- * Note that this was created for both encode/decode to handle the buffer management for string and bytes types
+ * Note that this was created for both encode/decode to handle the buffer management for string, bytes and array types
  * @param istream protobuf input stream, will be non-NULL when decoding
  * @param ostream protobuf output stream, will be non-NULL when encoding
  * @param field protobuf field being encoded/decoded. Used to find whether the signal type is string or bytes
@@ -95,6 +99,22 @@ bool proton_Signal_callback(
       }
       bytes_buf->len = len;
     }
+    else if (proton_is_array_type(proton_get_type_from_tag(field->tag)))
+    {
+      // The packed elements are kept as they are, the bundle decode callback unpacks them
+      signal->which_signal = field->tag;
+      proton_buffer_t * packed_buf = (proton_buffer_t *)signal->signal.string_value;
+      if (packed_buf == NULL || len > packed_buf->len)
+      {
+        return false;
+      }
+
+      if (!pb_read(istream, (pb_byte_t *)packed_buf->data, len))
+      {
+        return false;
+      }
+      packed_buf->len = len;
+    }
   }
   // Encode
   else if (ostream)
@@ -135,6 +155,35 @@ bool proton_Signal_callback(
         return false;
       }
     }
+    else if (proton_is_array_type(proton_get_type_from_tag(field->tag)))
+    {
+      proton_buffer_t * array_buf = (proton_buffer_t *)signal->signal.string_value;
+      if (array_buf == NULL)
+      {
+        return false;
+      }
+
+      proton_signal_type_e type = proton_get_type_from_tag(field->tag);
+      if (
+        !pb_encode_tag_for_field(ostream, field) ||
+        !pb_encode_varint(ostream, proton_packed_array_len(type, array_buf->data, array_buf->len)))
+      {
+        return false;
+      }
+
+      // Pack the elements a chunk at a time, so no buffer of the whole payload is needed
+      size_t chunk_size = PROTON_PACKED_CHUNK_ELEMENTS * proton_array_element_size(type);
+      for (size_t offset = 0; offset < array_buf->len; offset += chunk_size)
+      {
+        uint8_t packed[PROTON_PACKED_CHUNK_ELEMENTS * 10];
+        size_t size = array_buf->len - offset < chunk_size ? array_buf->len - offset : chunk_size;
+        uint8_t * end = proton_write_packed_array(packed, type, array_buf->data + offset, size);
+        if (!pb_write(ostream, packed, (size_t)(end - packed)))
+        {
+          return false;
+        }
+      }
+    }
   }
 
   return true;
@@ -17,8 +17,42 @@
  */
 
 #include "proton/registry.h"
+#include <stddef.h>
 #include <string.h>
 
+/*
+ * Signal sequence counters, see proton_bundle_snapshot. A writer stores an odd sequence before it
+ * writes a value and the next even one after, and a reader checks the sequence is even and did
+ * not change around its copy.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define PROTON_SEQUENCE_LOAD_ACQUIRE(sequence) __atomic_load_n((sequence), __ATOMIC_ACQUIRE)
+#define PROTON_SEQUENCE_LOAD_RELAXED(sequence) __atomic_load_n((sequence), __ATOMIC_RELAXED)
+#define PROTON_SEQUENCE_STORE(sequence, value) \
+  __atomic_store_n((sequence), (value), __ATOMIC_RELAXED)
+#define PROTON_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define PROTON_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+// Without atomic builtins, snapshots are only consistent against writers on the same core
+#define PROTON_SEQUENCE_LOAD_ACQUIRE(sequence) (*(volatile const uint32_t *)(sequence))
+#define PROTON_SEQUENCE_LOAD_RELAXED(sequence) (*(volatile const uint32_t *)(sequence))
+#define PROTON_SEQUENCE_STORE(sequence, value) (*(volatile uint32_t *)(sequence) = (value))
+#define PROTON_FENCE_ACQUIRE()
+#define PROTON_FENCE_RELEASE()
+#endif
+
+static void proton_signal_begin_write(signal_desc_t * desc)
+{
+  PROTON_SEQUENCE_STORE(&desc->sequence, desc->sequence + 1);
+  PROTON_FENCE_RELEASE();
+}
+
+static void proton_signal_end_write(signal_desc_t * desc)
+{
+  PROTON_FENCE_RELEASE();
+  PROTON_SEQUENCE_STORE(&desc->sequence, desc->sequence + 1);
+}
+
 proton_status_e proton_lock_registry(const proton_registry_t * registry)
 {
   proton_status_e lock_status = PROTON_OK;
@@ -65,6 +99,20 @@ proton_signal_type_e proton_get_type_from_tag(pb_size_t tag)
       return PROTON_STRING;
     case proton_Signal_bytes_value_tag:
       return PROTON_BYTES;
+    case proton_Signal_flags_value_tag:
+      return PROTON_FLAGS;
+    case proton_Signal_double_array_value_tag:
+      return PROTON_DOUBLE_ARRAY;
+    case proton_Signal_float_array_value_tag:
+      return PROTON_FLOAT_ARRAY;
+    case proton_Signal_int32_array_value_tag:
+      return PROTON_INT32_ARRAY;
+    case proton_Signal_int64_array_value_tag:
+      return PROTON_INT64_ARRAY;
+    case proton_Signal_uint32_array_value_tag:
+      return PROTON_UINT32_ARRAY;
+    case proton_Signal_uint64_array_value_tag:
+      return PROTON_UINT64_ARRAY;
     default:
       return PROTON_INVALID_TYPE;
   }
@@ -92,6 +140,20 @@ pb_size_t proton_get_tag_from_type(proton_signal_type_e type)
       return proton_Signal_string_value_tag;
     case PROTON_BYTES:
       return proton_Signal_bytes_value_tag;
+    case PROTON_FLAGS:
+      return proton_Signal_flags_value_tag;
+    case PROTON_DOUBLE_ARRAY:
+      return proton_Signal_double_array_value_tag;
+    case PROTON_FLOAT_ARRAY:
+      return proton_Signal_float_array_value_tag;
+    case PROTON_INT32_ARRAY:
+      return proton_Signal_int32_array_value_tag;
+    case PROTON_INT64_ARRAY:
+      return proton_Signal_int64_array_value_tag;
+    case PROTON_UINT32_ARRAY:
+      return proton_Signal_uint32_array_value_tag;
+    case PROTON_UINT64_ARRAY:
+      return proton_Signal_uint64_array_value_tag;
     default:
       return 0;
   }
@@ -112,12 +174,46 @@ uint16_t get_signal_value_size(proton_signal_type_e type, uint32_t capacity)
     case PROTON_UINT32:
       return sizeof(uint32_t);
     case PROTON_UINT64:
+    case PROTON_FLAGS:
       return sizeof(uint64_t);
     case PROTON_BOOL:
       return sizeof(bool);
     case PROTON_STRING:
     case PROTON_BYTES:
       return capacity;
+    case PROTON_DOUBLE_ARRAY:
+    case PROTON_FLOAT_ARRAY:
+    case PROTON_INT32_ARRAY:
+    case PROTON_INT64_ARRAY:
+    case PROTON_UINT32_ARRAY:
+    case PROTON_UINT64_ARRAY:
+      return (uint16_t)(capacity * proton_array_element_size(type));
+    default:
+      return 0;
+  }
+}
+
+bool proton_is_array_type(proton_signal_type_e type)
+{
+  return proton_array_element_size(type) != 0;
+}
+
+size_t proton_array_element_size(proton_signal_type_e type)
+{
+  switch (type)
+  {
+    case PROTON_DOUBLE_ARRAY:
+      return sizeof(double);
+    case PROTON_FLOAT_ARRAY:
+      return sizeof(float);
+    case PROTON_INT32_ARRAY:
+      return sizeof(int32_t);
+    case PROTON_INT64_ARRAY:
+      return sizeof(int64_t);
+    case PROTON_UINT32_ARRAY:
+      return sizeof(uint32_t);
+    case PROTON_UINT64_ARRAY:
+      return sizeof(uint64_t);
     default:
       return 0;
   }
@@ -125,7 +221,32 @@ uint16_t get_signal_value_size(proton_signal_type_e type, uint32_t capacity)
 
 proton_signal_type_e string_to_signal_type(const char * type_str)
 {
-  if (strncmp(type_str, "double", strlen("double")) == 0)
+  // Array types first, since their names start with the name of their element type
+  if (strcmp(type_str, "double_array") == 0)
+  {
+    return PROTON_DOUBLE_ARRAY;
+  }
+  else if (strcmp(type_str, "float_array") == 0)
+  {
+    return PROTON_FLOAT_ARRAY;
+  }
+  else if (strcmp(type_str, "int32_array") == 0)
+  {
+    return PROTON_INT32_ARRAY;
+  }
+  else if (strcmp(type_str, "int64_array") == 0)
+  {
+    return PROTON_INT64_ARRAY;
+  }
+  else if (strcmp(type_str, "uint32_array") == 0)
+  {
+    return PROTON_UINT32_ARRAY;
+  }
+  else if (strcmp(type_str, "uint64_array") == 0)
+  {
+    return PROTON_UINT64_ARRAY;
+  }
+  else if (strncmp(type_str, "double", strlen("double")) == 0)
   {
     return PROTON_DOUBLE;
   }
@@ -161,6 +282,10 @@ proton_signal_type_e string_to_signal_type(const char * type_str)
   {
     return PROTON_BYTES;
   }
+  else if (strncmp(type_str, "flags", strlen("flags")) == 0)
+  {
+    return PROTON_FLAGS;
+  }
   else
   {
     return PROTON_INVALID_TYPE;
@@ -189,6 +314,20 @@ const char * signal_type_to_string(proton_signal_type_e signal_type)
       return "string";
     case PROTON_BYTES:
       return "bytes";
+    case PROTON_FLAGS:
+      return "flags";
+    case PROTON_DOUBLE_ARRAY:
+      return "double_array";
+    case PROTON_FLOAT_ARRAY:
+      return "float_array";
+    case PROTON_INT32_ARRAY:
+      return "int32_array";
+    case PROTON_INT64_ARRAY:
+      return "int64_array";
+    case PROTON_UINT32_ARRAY:
+      return "uint32_array";
+    case PROTON_UINT64_ARRAY:
+      return "uint64_array";
     case PROTON_INVALID_TYPE:
     default:
       return "invalid";
@@ -196,25 +335,261 @@ const char * signal_type_to_string(proton_signal_type_e signal_type)
   return "invalid";
 }
 
-const bundle_desc_t * proton_registry_get_bundle(
-  const proton_registry_t * registry, uint32_t bundle_id, size_t * slot_idx)
+uint32_t proton_lookup_index_hash(uint32_t id)
+{
+  // Fibonacci hashing, folding the high bits down so that masking by capacity uses all of them
+  uint32_t hash = id * 2654435761u;
+  return hash ^ (hash >> 16);
+}
+
+uint16_t proton_lookup_index_capacity(size_t count)
 {
-  if (registry != NULL)
+  size_t capacity = 1;
+  while (capacity < count * 2)
   {
-    for (size_t i = 0; i < registry->bundle_count; i++)
+    capacity <<= 1;
+  }
+
+  // Slots store uint16_t positions, with UINT16_MAX reserved for empty slots
+  if (capacity > (1u << 15) || count >= PROTON_LOOKUP_INDEX_EMPTY)
+  {
+    return 0;
+  }
+
+  return (uint16_t)capacity;
+}
+
+/*
+ * Lookup indices of the bundle table, the signal registry and the per-bundle signal lists only
+ * differ in where the ID sits in each table entry. The helpers below take the table base, the
+ * entry stride and the offset of the uint32_t ID within an entry, so probes make no indirect call.
+ */
+static inline uint32_t proton_lookup_index_id_at(
+  const void * table, size_t stride, size_t id_offset, size_t i)
+{
+  uint32_t id;
+  memcpy(&id, (const uint8_t *)table + i * stride + id_offset, sizeof(id));
+  return id;
+}
+
+static inline bool proton_lookup_index_enabled(const proton_lookup_index_t * index)
+{
+  return index->slots != NULL && index->capacity != 0;
+}
+
+/*
+ * Fill an index for a table of count entries. Duplicate IDs keep the first position, matching the
+ * linear scan.
+ */
+static inline proton_status_e proton_lookup_index_build(
+  proton_lookup_index_t * index, uint16_t * slots, uint16_t capacity, const void * table,
+  size_t stride, size_t id_offset, size_t count)
+{
+  index->slots = NULL;
+  index->capacity = 0;
+
+  if (slots == NULL)
+  {
+    return PROTON_OK;
+  }
+
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0 || capacity <= count)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  for (size_t i = 0; i < capacity; i++)
+  {
+    slots[i] = PROTON_LOOKUP_INDEX_EMPTY;
+  }
+
+  uint16_t mask = capacity - 1;
+  for (size_t i = 0; i < count; i++)
+  {
+    uint32_t id = proton_lookup_index_id_at(table, stride, id_offset, i);
+    uint16_t slot = proton_lookup_index_hash(id) & mask;
+    while (slots[slot] != PROTON_LOOKUP_INDEX_EMPTY &&
+           proton_lookup_index_id_at(table, stride, id_offset, slots[slot]) != id)
+    {
+      slot = (slot + 1) & mask;
+    }
+
+    if (slots[slot] == PROTON_LOOKUP_INDEX_EMPTY)
     {
-      if (registry->bundle_table[i].bundle_id == bundle_id)
+      slots[slot] = (uint16_t)i;
+    }
+  }
+
+  index->slots = slots;
+  index->capacity = capacity;
+  return PROTON_OK;
+}
+
+/*
+ * Find the table position of an ID with the index if enabled, and with a linear scan otherwise.
+ */
+static inline bool proton_lookup_index_find(
+  const proton_lookup_index_t * index, const void * table, size_t stride, size_t id_offset,
+  size_t count, uint32_t id, size_t * position)
+{
+  if (proton_lookup_index_enabled(index))
+  {
+    uint16_t mask = index->capacity - 1;
+    uint16_t slot = proton_lookup_index_hash(id) & mask;
+    for (uint16_t probes = 0; probes < index->capacity; probes++)
+    {
+      uint16_t i = index->slots[slot];
+      if (i == PROTON_LOOKUP_INDEX_EMPTY)
       {
-        if (slot_idx)
-        {
-          *slot_idx = i;
-        }
-        return &registry->bundle_table[i];
+        return false;
       }
+
+      if (i < count && proton_lookup_index_id_at(table, stride, id_offset, i) == id)
+      {
+        *position = i;
+        return true;
+      }
+      slot = (slot + 1) & mask;
     }
+
+    return false;
   }
 
-  return NULL;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (proton_lookup_index_id_at(table, stride, id_offset, i) == id)
+    {
+      *position = i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+proton_status_e proton_registry_build_index(
+  proton_registry_t * registry, uint16_t * bundle_slots, uint16_t bundle_capacity,
+  uint16_t * signal_slots, uint16_t signal_capacity)
+{
+  if (registry == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  proton_status_e bundle_status = proton_lookup_index_build(
+    &registry->bundle_index, bundle_slots, bundle_capacity, registry->bundle_table,
+    sizeof(bundle_desc_t), offsetof(bundle_desc_t, bundle_id), registry->bundle_count);
+  proton_status_e signal_status = proton_lookup_index_build(
+    &registry->signal_index, signal_slots, signal_capacity, registry->signal_registry,
+    sizeof(signal_desc_t), offsetof(signal_desc_t, id), registry->signal_count);
+
+  return bundle_status != PROTON_OK ? bundle_status : signal_status;
+}
+
+proton_status_e proton_registry_build_bundle_index(
+  const proton_registry_t * registry, bundle_desc_t * bundle, uint16_t * signal_indices,
+  uint16_t * signal_slots, uint16_t slot_capacity)
+{
+  if (registry == NULL || bundle == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  bundle->signal_indices = NULL;
+
+  proton_status_e status = proton_lookup_index_build(
+    &bundle->signal_slots, signal_slots, slot_capacity, bundle->signal_ids.ids, sizeof(uint32_t),
+    0, bundle->signal_ids.count);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  if (signal_indices != NULL)
+  {
+    for (size_t i = 0; i < bundle->signal_ids.count; i++)
+    {
+      size_t registry_idx = 0;
+      if (proton_registry_get_signal(registry, bundle->signal_ids.ids[i], &registry_idx) == NULL)
+      {
+        return PROTON_ERROR;
+      }
+      signal_indices[i] = (uint16_t)registry_idx;
+    }
+    bundle->signal_indices = signal_indices;
+  }
+
+  return PROTON_OK;
+}
+
+bool proton_bundle_get_signal_slot(
+  const bundle_desc_t * bundle, uint32_t signal_id, size_t * slot)
+{
+  if (bundle == NULL)
+  {
+    return false;
+  }
+
+  size_t position = 0;
+  if (!proton_lookup_index_find(
+        &bundle->signal_slots, bundle->signal_ids.ids, sizeof(uint32_t), 0,
+        bundle->signal_ids.count, signal_id, &position))
+  {
+    return false;
+  }
+
+  if (slot)
+  {
+    *slot = position;
+  }
+  return true;
+}
+
+signal_desc_t * proton_registry_get_bundle_signal(
+  const proton_registry_t * registry, const bundle_desc_t * bundle, size_t slot)
+{
+  if (registry == NULL || bundle == NULL || slot >= bundle->signal_ids.count)
+  {
+    return NULL;
+  }
+
+  uint32_t signal_id = bundle->signal_ids.ids[slot];
+  if (bundle->signal_indices != NULL)
+  {
+    // Resolved indices are trusted only while they still point at the expected signal
+    uint16_t registry_idx = bundle->signal_indices[slot];
+    if (
+      registry_idx < registry->signal_count &&
+      registry->signal_registry[registry_idx].id == signal_id)
+    {
+      return &registry->signal_registry[registry_idx];
+    }
+  }
+
+  return proton_registry_get_signal(registry, signal_id, NULL);
+}
+
+const bundle_desc_t * proton_registry_get_bundle(
+  const proton_registry_t * registry, uint32_t bundle_id, size_t * slot_idx)
+{
+  if (registry == NULL)
+  {
+    return NULL;
+  }
+
+  size_t slot = 0;
+  if (!proton_lookup_index_find(
+        &registry->bundle_index, registry->bundle_table, sizeof(bundle_desc_t),
+        offsetof(bundle_desc_t, bundle_id), registry->bundle_count, bundle_id, &slot))
+  {
+    return NULL;
+  }
+
+  if (slot_idx)
+  {
+    *slot_idx = slot;
+  }
+  return &registry->bundle_table[slot];
 }
 
 proton_Signal * proton_registry_get_bundle_encode_decode_buffer(const proton_registry_t * registry)
@@ -225,112 +600,423 @@ proton_Signal * proton_registry_get_bundle_encode_decode_buffer(const proton_reg
 proton_bundle_cb_t * proton_registry_get_bundle_callback(
   const proton_registry_t * registry, uint32_t bundle_id)
 {
-  for (size_t i = 0; i < registry->bundle_count; i++)
+  size_t slot = 0;
+  if (proton_registry_get_bundle(registry, bundle_id, &slot) == NULL)
   {
-    if (registry->bundle_table[i].bundle_id == bundle_id)
-    {
-      return &registry->bundle_table[i].callback;
-    }
+    return NULL;
   }
 
-  return NULL;
+  return &registry->bundle_table[slot].callback;
 }
 
 void proton_registry_set_bundle_callback(
   proton_registry_t * registry, uint32_t bundle_id, proton_bundle_cb_f bundle_cb, void * context)
 {
-  for (size_t i = 0; i < registry->bundle_count; i++)
+  size_t slot = 0;
+  if (proton_registry_get_bundle(registry, bundle_id, &slot) != NULL)
   {
-    if (registry->bundle_table[i].bundle_id == bundle_id)
-    {
-      registry->bundle_table[i].callback.cb = bundle_cb;
-      registry->bundle_table[i].callback.arg = context;
-    }
+    registry->bundle_table[slot].callback.cb = bundle_cb;
+    registry->bundle_table[slot].callback.arg = context;
   }
 }
 
 void proton_registry_set_bundle_period(
   proton_registry_t * registry, uint32_t bundle_id, uint32_t period_ms)
 {
-  for (size_t i = 0; i < registry->bundle_count; i++)
+  size_t slot = 0;
+  if (proton_registry_get_bundle(registry, bundle_id, &slot) != NULL)
+  {
+    registry->bundle_table[slot].period_ms = period_ms;
+    registry->bundle_schedule_version++;
+  }
+}
+
+bool proton_bundle_keyframe_due(const bundle_desc_t * bundle)
+{
+  if (!bundle->delta || bundle->sent_versions == NULL || bundle->sends_since_keyframe == 0)
+  {
+    return true;
+  }
+  return bundle->keyframe_interval != 0 &&
+         bundle->sends_since_keyframe >= bundle->keyframe_interval;
+}
+
+bool proton_bundle_signal_changed(
+  const proton_registry_t * registry, const bundle_desc_t * bundle, size_t slot)
+{
+  if (bundle->sent_versions == NULL)
+  {
+    return true;
+  }
+
+  const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, slot);
+  return desc == NULL || desc->version != bundle->sent_versions[slot];
+}
+
+void proton_bundle_mark_sent(const proton_registry_t * registry, bundle_desc_t * bundle)
+{
+  if (registry == NULL || bundle == NULL || bundle->sent_versions == NULL)
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, i);
+    if (desc != NULL)
+    {
+      bundle->sent_versions[i] = desc->version;
+    }
+  }
+
+  if (proton_bundle_keyframe_due(bundle))
+  {
+    bundle->sends_since_keyframe = 1;
+  }
+  else if (bundle->sends_since_keyframe < UINT16_MAX)
+  {
+    bundle->sends_since_keyframe++;
+  }
+}
+
+void proton_registry_request_keyframe(proton_registry_t * registry, uint32_t bundle_id)
+{
+  size_t slot = 0;
+  if (proton_registry_get_bundle(registry, bundle_id, &slot) != NULL)
+  {
+    registry->bundle_table[slot].sends_since_keyframe = 0;
+  }
+}
+
+void proton_bundle_begin_write(const proton_registry_t * registry, const bundle_desc_t * bundle)
+{
+  if (registry == NULL || bundle == NULL)
   {
-    if (registry->bundle_table[i].bundle_id == bundle_id)
+    return;
+  }
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, i);
+    if (desc != NULL)
     {
-      registry->bundle_table[i].period_ms = period_ms;
-      return;
+      PROTON_SEQUENCE_STORE(&desc->sequence, desc->sequence + 1);
     }
   }
+  PROTON_FENCE_RELEASE();
 }
 
-signal_desc_t * proton_registry_get_signal(
-  const proton_registry_t * registry, uint32_t signal_id, size_t * registry_idx)
+void proton_bundle_end_write(const proton_registry_t * registry, const bundle_desc_t * bundle)
+{
+  if (registry == NULL || bundle == NULL)
+  {
+    return;
+  }
+  PROTON_FENCE_RELEASE();
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, i);
+    if (desc != NULL)
+    {
+      PROTON_SEQUENCE_STORE(&desc->sequence, desc->sequence + 1);
+    }
+  }
+}
+
+/**
+ * Record the sequence of every signal of a bundle before a snapshot copies them
+ * @return false if a signal is being written
+ */
+static bool proton_bundle_load_sequences(
+  const proton_registry_t * registry, const bundle_desc_t * bundle, proton_signal_value_t * values)
+{
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, i);
+    values[i].sequence = PROTON_SEQUENCE_LOAD_ACQUIRE(&desc->sequence);
+    if ((values[i].sequence & 1u) != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Whether no signal of a bundle was written since proton_bundle_load_sequences
+ */
+static bool proton_bundle_sequences_unchanged(
+  const proton_registry_t * registry, const bundle_desc_t * bundle,
+  const proton_signal_value_t * values)
+{
+  PROTON_FENCE_ACQUIRE();
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, i);
+    if (PROTON_SEQUENCE_LOAD_RELAXED(&desc->sequence) != values[i].sequence)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Copy the signals of a bundle for a snapshot. Sizes read while a writer changes them may be out
+ * of range, so they are bounded by the signal capacity before being used.
+ */
+static proton_status_e proton_bundle_copy_values(
+  const proton_registry_t * registry, const bundle_desc_t * bundle, proton_signal_value_t * values,
+  uint8_t * buffer, size_t buffer_len)
+{
+  size_t used = 0;
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, i);
+    proton_signal_value_t * value = &values[i];
+    value->id = desc->id;
+    value->type = desc->type;
+    value->version = desc->version;
+    value->signal.id = desc->id;
+    value->signal.which_signal = desc->signal.which_signal;
+
+    if (
+      desc->type != PROTON_STRING && desc->type != PROTON_BYTES &&
+      !proton_is_array_type(desc->type))
+    {
+      value->signal.signal = desc->signal.signal;
+      value->value_size = desc->value_size;
+      continue;
+    }
+
+    const char * data = desc->signal.signal.string_value;
+    size_t size = desc->value_size < desc->capacity ? desc->value_size : desc->capacity;
+    if (data == NULL)
+    {
+      size = 0;
+    }
+    else if (desc->type == PROTON_STRING)
+    {
+      size = strnlen(data, desc->capacity);
+      if (size < desc->capacity)
+      {
+        size += 1;  // Account for null terminator if not present
+      }
+    }
+    if (size > buffer_len - used || (size > 0 && buffer == NULL))
+    {
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+
+    if (size > 0)
+    {
+      memcpy(buffer + used, data, size);
+    }
+    value->signal.signal.string_value = buffer + used;
+    value->value_size = (uint16_t)size;
+    // Keep the next value aligned for array elements
+    used += (size + 7u) & ~(size_t)7u;
+    used = used < buffer_len ? used : buffer_len;
+  }
+  return PROTON_OK;
+}
+
+proton_status_e proton_bundle_snapshot(
+  const proton_registry_t * registry, uint32_t bundle_id, proton_signal_value_t * values,
+  size_t capacity, uint8_t * buffer, size_t buffer_len, size_t * count)
 {
-  for (size_t i = 0; i < registry->signal_count; i++)
+  if (registry == NULL || count == NULL || (values == NULL && capacity > 0))
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  const bundle_desc_t * bundle = proton_registry_get_bundle(registry, bundle_id, NULL);
+  if (bundle == NULL)
+  {
+    return PROTON_ERROR;
+  }
+  if (bundle->signal_ids.count > capacity)
   {
-    if (registry->signal_registry[i].id == signal_id)
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    if (proton_registry_get_bundle_signal(registry, bundle, i) == NULL)
     {
-      if (registry_idx)
+      return PROTON_ERROR;
+    }
+  }
+
+  for (uint32_t attempt = 0; attempt < PROTON_SNAPSHOT_ATTEMPTS; attempt++)
+  {
+    if (!proton_bundle_load_sequences(registry, bundle, values))
+    {
+      continue;
+    }
+    proton_status_e status =
+      proton_bundle_copy_values(registry, bundle, values, buffer, buffer_len);
+    if (proton_bundle_sequences_unchanged(registry, bundle, values))
+    {
+      if (status == PROTON_OK)
       {
-        *registry_idx = i;
+        *count = bundle->signal_ids.count;
       }
-      return &registry->signal_registry[i];
+      return status;
     }
   }
 
-  return NULL;
+  // Writers kept the signals busy, wait for the lock so that the snapshot finishes
+  if (proton_lock_registry(registry) != PROTON_OK)
+  {
+    return PROTON_MUTEX_ERROR;
+  }
+  proton_bundle_load_sequences(registry, bundle, values);
+  proton_status_e status = proton_bundle_copy_values(registry, bundle, values, buffer, buffer_len);
+  proton_unlock_registry(registry);
+  if (status == PROTON_OK)
+  {
+    *count = bundle->signal_ids.count;
+  }
+  return status;
+}
+
+signal_desc_t * proton_registry_get_signal(
+  const proton_registry_t * registry, uint32_t signal_id, size_t * registry_idx)
+{
+  size_t idx = 0;
+  if (!proton_lookup_index_find(
+        &registry->signal_index, registry->signal_registry, sizeof(signal_desc_t),
+        offsetof(signal_desc_t, id), registry->signal_count, signal_id, &idx))
+  {
+    return NULL;
+  }
+
+  if (registry_idx)
+  {
+    *registry_idx = idx;
+  }
+  return &registry->signal_registry[idx];
+}
+
+proton_status_e proton_registry_resolve_signal(
+  const proton_registry_t * registry, uint32_t signal_id, proton_signal_type_e expected_type,
+  proton_signal_handle_t * handle)
+{
+  if (registry == NULL || handle == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  handle->index = UINT16_MAX;
+  handle->type = PROTON_INVALID_TYPE;
+
+  size_t idx = 0;
+  signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, &idx);
+  if (desc == NULL || desc->type == PROTON_INVALID_TYPE)
+  {
+    return PROTON_ERROR;
+  }
+  if (expected_type != PROTON_INVALID_TYPE && desc->type != expected_type)
+  {
+    return PROTON_ERROR;
+  }
+
+  handle->index = (uint16_t)idx;
+  handle->type = desc->type;
+  return PROTON_OK;
 }
 
 /*
- * Typed scalar accessors. Each pair validates that the signal exists and that
- * its stored type matches the requested type before reading or writing.
+ * Descriptor of a handle, or NULL if the handle was not resolved for type in this registry.
+ * The type was checked when resolving, so only the handle itself is compared here.
  */
-#define PROTON_DEFINE_SCALAR_ACCESSORS(NAME, CTYPE, ENUM_TAG, UNION_FIELD)        \
-  proton_status_e proton_signal_get_##NAME(                                       \
-    const proton_registry_t * registry, uint32_t signal_id, CTYPE * value)        \
-  {                                                                               \
-    if (registry == NULL || value == NULL)                                        \
-    {                                                                             \
-      return PROTON_NULL_PTR_ERROR;                                               \
-    }                                                                             \
-    signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, NULL); \
-    if (desc == NULL)                                                             \
-    {                                                                             \
-      return PROTON_ERROR;                                                        \
-    }                                                                             \
-    if (desc->signal.which_signal != (ENUM_TAG))                                  \
-    {                                                                             \
-      return PROTON_ERROR;                                                        \
-    }                                                                             \
-    *value = desc->signal.signal.UNION_FIELD;                                     \
-    return PROTON_OK;                                                             \
-  }                                                                               \
-  proton_status_e proton_signal_set_##NAME(                                       \
-    const proton_registry_t * registry, uint32_t signal_id, CTYPE value)          \
-  {                                                                               \
-    if (registry == NULL)                                                         \
-    {                                                                             \
-      return PROTON_NULL_PTR_ERROR;                                               \
-    }                                                                             \
-    signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, NULL); \
-    if (desc == NULL)                                                             \
-    {                                                                             \
-      return PROTON_ERROR;                                                        \
-    }                                                                             \
-    if (desc->signal.which_signal != (ENUM_TAG))                                  \
-    {                                                                             \
-      return PROTON_ERROR;                                                        \
-    }                                                                             \
-    desc->signal.signal.UNION_FIELD = value;                                      \
-    return PROTON_OK;                                                             \
-  }
-
-PROTON_DEFINE_SCALAR_ACCESSORS(double, double, proton_Signal_double_value_tag, double_value)
-PROTON_DEFINE_SCALAR_ACCESSORS(float, float, proton_Signal_float_value_tag, float_value)
-PROTON_DEFINE_SCALAR_ACCESSORS(int32, int32_t, proton_Signal_int32_value_tag, int32_value)
-PROTON_DEFINE_SCALAR_ACCESSORS(int64, int64_t, proton_Signal_int64_value_tag, int64_value)
-PROTON_DEFINE_SCALAR_ACCESSORS(uint32, uint32_t, proton_Signal_uint32_value_tag, uint32_value)
-PROTON_DEFINE_SCALAR_ACCESSORS(uint64, uint64_t, proton_Signal_uint64_value_tag, uint64_value)
-PROTON_DEFINE_SCALAR_ACCESSORS(bool, bool, proton_Signal_bool_value_tag, bool_value)
+static signal_desc_t * proton_signal_handle_desc(
+  const proton_registry_t * registry, proton_signal_handle_t handle, proton_signal_type_e type)
+{
+  if (handle.type != type || handle.index >= registry->signal_count)
+  {
+    return NULL;
+  }
+  return &registry->signal_registry[handle.index];
+}
+
+/*
+ * Typed scalar accessors. The handle accessors trust the type checked when the handle was
+ * resolved, and the ID accessors resolve a handle for every call.
+ */
+#define PROTON_DEFINE_SCALAR_ACCESSORS(NAME, CTYPE, SIGNAL_TYPE, UNION_FIELD)             \
+  proton_status_e proton_signal_handle_get_##NAME(                                        \
+    const proton_registry_t * registry, proton_signal_handle_t handle, CTYPE * value)     \
+  {                                                                                       \
+    if (registry == NULL || value == NULL)                                                \
+    {                                                                                     \
+      return PROTON_NULL_PTR_ERROR;                                                       \
+    }                                                                                     \
+    signal_desc_t * desc = proton_signal_handle_desc(registry, handle, (SIGNAL_TYPE));    \
+    if (desc == NULL)                                                                     \
+    {                                                                                     \
+      return PROTON_ERROR;                                                                \
+    }                                                                                     \
+    *value = desc->signal.signal.UNION_FIELD;                                             \
+    return PROTON_OK;                                                                     \
+  }                                                                                       \
+  proton_status_e proton_signal_handle_set_##NAME(                                        \
+    const proton_registry_t * registry, proton_signal_handle_t handle, CTYPE value)       \
+  {                                                                                       \
+    if (registry == NULL)                                                                 \
+    {                                                                                     \
+      return PROTON_NULL_PTR_ERROR;                                                       \
+    }                                                                                     \
+    signal_desc_t * desc = proton_signal_handle_desc(registry, handle, (SIGNAL_TYPE));    \
+    if (desc == NULL)                                                                     \
+    {                                                                                     \
+      return PROTON_ERROR;                                                                \
+    }                                                                                     \
+    proton_signal_begin_write(desc);                                                      \
+    desc->signal.signal.UNION_FIELD = value;                                              \
+    desc->version++;                                                                      \
+    proton_signal_end_write(desc);                                                        \
+    return PROTON_OK;                                                                     \
+  }                                                                                       \
+  proton_status_e proton_signal_get_##NAME(                                               \
+    const proton_registry_t * registry, uint32_t signal_id, CTYPE * value)                \
+  {                                                                                       \
+    if (registry == NULL || value == NULL)                                                \
+    {                                                                                     \
+      return PROTON_NULL_PTR_ERROR;                                                       \
+    }                                                                                     \
+    proton_signal_handle_t handle;                                                        \
+    proton_status_e status =                                                              \
+      proton_registry_resolve_signal(registry, signal_id, (SIGNAL_TYPE), &handle);        \
+    if (status != PROTON_OK)                                                              \
+    {                                                                                     \
+      return status;                                                                      \
+    }                                                                                     \
+    return proton_signal_handle_get_##NAME(registry, handle, value);                      \
+  }                                                                                       \
+  proton_status_e proton_signal_set_##NAME(                                               \
+    const proton_registry_t * registry, uint32_t signal_id, CTYPE value)                  \
+  {                                                                                       \
+    if (registry == NULL)                                                                 \
+    {                                                                                     \
+      return PROTON_NULL_PTR_ERROR;                                                       \
+    }                                                                                     \
+    proton_signal_handle_t handle;                                                        \
+    proton_status_e status =                                                              \
+      proton_registry_resolve_signal(registry, signal_id, (SIGNAL_TYPE), &handle);        \
+    if (status != PROTON_OK)                                                              \
+    {                                                                                     \
+      return status;                                                                      \
+    }                                                                                     \
+    return proton_signal_handle_set_##NAME(registry, handle, value);                      \
+  }
+
+PROTON_DEFINE_SCALAR_ACCESSORS(double, double, PROTON_DOUBLE, double_value)
+PROTON_DEFINE_SCALAR_ACCESSORS(float, float, PROTON_FLOAT, float_value)
+PROTON_DEFINE_SCALAR_ACCESSORS(int32, int32_t, PROTON_INT32, int32_value)
+PROTON_DEFINE_SCALAR_ACCESSORS(int64, int64_t, PROTON_INT64, int64_value)
+PROTON_DEFINE_SCALAR_ACCESSORS(uint32, uint32_t, PROTON_UINT32, uint32_value)
+PROTON_DEFINE_SCALAR_ACCESSORS(uint64, uint64_t, PROTON_UINT64, uint64_value)
+PROTON_DEFINE_SCALAR_ACCESSORS(bool, bool, PROTON_BOOL, bool_value)
+PROTON_DEFINE_SCALAR_ACCESSORS(flags, uint64_t, PROTON_FLAGS, flags_value)
 
 #undef PROTON_DEFINE_SCALAR_ACCESSORS
 
@@ -340,25 +1026,21 @@ PROTON_DEFINE_SCALAR_ACCESSORS(bool, bool, proton_Signal_bool_value_tag, bool_va
  * string_value as the access path.
  */
 static proton_status_e proton_signal_get_buffer(
-  const proton_registry_t * registry, uint32_t signal_id, pb_size_t expected_tag, void * buf,
-  size_t capacity, size_t * out_len)
+  const proton_registry_t * registry, proton_signal_handle_t handle,
+  proton_signal_type_e expected_type, void * buf, size_t capacity, size_t * out_len)
 {
   if (registry == NULL || buf == NULL || out_len == NULL)
   {
     return PROTON_NULL_PTR_ERROR;
   }
-  signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, NULL);
+  signal_desc_t * desc = proton_signal_handle_desc(registry, handle, expected_type);
   if (desc == NULL)
   {
     return PROTON_ERROR;
   }
-  if (desc->signal.which_signal != expected_tag)
-  {
-    return PROTON_ERROR;
-  }
 
   size_t signal_size = desc->value_size;
-  if (expected_tag == proton_Signal_string_value_tag)
+  if (expected_type == PROTON_STRING)
   {
     signal_size = strnlen(desc->signal.signal.string_value, desc->capacity);
     if (signal_size < desc->capacity)
@@ -377,31 +1059,25 @@ static proton_status_e proton_signal_get_buffer(
   return PROTON_OK;
 }
 
-proton_status_e proton_signal_get_string(
-  const proton_registry_t * registry, uint32_t signal_id, char * buf, size_t capacity,
+proton_status_e proton_signal_handle_get_string(
+  const proton_registry_t * registry, proton_signal_handle_t handle, char * buf, size_t capacity,
   size_t * out_len)
 {
-  return proton_signal_get_buffer(
-    registry, signal_id, proton_Signal_string_value_tag, buf, capacity, out_len);
+  return proton_signal_get_buffer(registry, handle, PROTON_STRING, buf, capacity, out_len);
 }
 
-proton_status_e proton_signal_set_string(
-  const proton_registry_t * registry, uint32_t signal_id, const char * str, size_t len)
+proton_status_e proton_signal_handle_set_string(
+  const proton_registry_t * registry, proton_signal_handle_t handle, const char * str, size_t len)
 {
   if (registry == NULL || str == NULL)
   {
     return PROTON_NULL_PTR_ERROR;
   }
-  size_t idx = 0;
-  signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, &idx);
+  signal_desc_t * desc = proton_signal_handle_desc(registry, handle, PROTON_STRING);
   if (desc == NULL)
   {
     return PROTON_ERROR;
   }
-  if (desc->signal.which_signal != proton_Signal_string_value_tag)
-  {
-    return PROTON_ERROR;
-  }
 
   size_t string_len = strnlen(str, len);
   if (string_len == len)
@@ -418,18 +1094,109 @@ proton_status_e proton_signal_set_string(
     return PROTON_INSUFFICIENT_BUFFER_ERROR;
   }
 
+  proton_signal_begin_write(desc);
   desc->value_size = string_len;
-
   memcpy(desc->signal.signal.string_value, str, string_len);
+  desc->version++;
+  proton_signal_end_write(desc);
   return PROTON_OK;
 }
 
+proton_status_e proton_signal_handle_get_bytes(
+  const proton_registry_t * registry, proton_signal_handle_t handle, uint8_t * buf,
+  size_t capacity, size_t * out_len)
+{
+  return proton_signal_get_buffer(registry, handle, PROTON_BYTES, buf, capacity, out_len);
+}
+
+proton_status_e proton_signal_handle_set_bytes(
+  const proton_registry_t * registry, proton_signal_handle_t handle, const uint8_t * data,
+  size_t len)
+{
+  if (registry == NULL || (data == NULL && len > 0))
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  signal_desc_t * desc = proton_signal_handle_desc(registry, handle, PROTON_BYTES);
+  if (desc == NULL)
+  {
+    return PROTON_ERROR;
+  }
+  if (desc->capacity < len)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  proton_signal_begin_write(desc);
+  if (len == 0)
+  {
+    memset(desc->signal.signal.bytes_value, 0, desc->capacity);
+  }
+  else
+  {
+    memcpy(desc->signal.signal.bytes_value, data, len);
+  }
+
+  desc->value_size = len;
+  desc->version++;
+  proton_signal_end_write(desc);
+  return PROTON_OK;
+}
+
+/*
+ * ID-based string/bytes accessors, resolving a handle for every call
+ */
+proton_status_e proton_signal_get_string(
+  const proton_registry_t * registry, uint32_t signal_id, char * buf, size_t capacity,
+  size_t * out_len)
+{
+  if (registry == NULL || buf == NULL || out_len == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  proton_signal_handle_t handle;
+  proton_status_e status =
+    proton_registry_resolve_signal(registry, signal_id, PROTON_STRING, &handle);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  return proton_signal_handle_get_string(registry, handle, buf, capacity, out_len);
+}
+
+proton_status_e proton_signal_set_string(
+  const proton_registry_t * registry, uint32_t signal_id, const char * str, size_t len)
+{
+  if (registry == NULL || str == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  proton_signal_handle_t handle;
+  proton_status_e status =
+    proton_registry_resolve_signal(registry, signal_id, PROTON_STRING, &handle);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  return proton_signal_handle_set_string(registry, handle, str, len);
+}
+
 proton_status_e proton_signal_get_bytes(
   const proton_registry_t * registry, uint32_t signal_id, uint8_t * buf, size_t capacity,
   size_t * out_len)
 {
-  return proton_signal_get_buffer(
-    registry, signal_id, proton_Signal_bytes_value_tag, buf, capacity, out_len);
+  if (registry == NULL || buf == NULL || out_len == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  proton_signal_handle_t handle;
+  proton_status_e status =
+    proton_registry_resolve_signal(registry, signal_id, PROTON_BYTES, &handle);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  return proton_signal_handle_get_bytes(registry, handle, buf, capacity, out_len);
 }
 
 proton_status_e proton_signal_set_bytes(
@@ -439,30 +1206,244 @@ proton_status_e proton_signal_set_bytes(
   {
     return PROTON_NULL_PTR_ERROR;
   }
-  size_t idx = 0;
-  signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, &idx);
+  proton_signal_handle_t handle;
+  proton_status_e status =
+    proton_registry_resolve_signal(registry, signal_id, PROTON_BYTES, &handle);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  return proton_signal_handle_set_bytes(registry, handle, data, len);
+}
+
+proton_status_e proton_signal_handle_get_flag(
+  const proton_registry_t * registry, proton_signal_handle_t handle, uint8_t bit, bool * value)
+{
+  if (registry == NULL || value == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  signal_desc_t * desc = proton_signal_handle_desc(registry, handle, PROTON_FLAGS);
+  if (desc == NULL || bit >= PROTON_FLAGS_MAX_BITS)
+  {
+    return PROTON_ERROR;
+  }
+
+  *value = (desc->signal.signal.flags_value >> bit) & 1u;
+  return PROTON_OK;
+}
+
+proton_status_e proton_signal_handle_set_flag(
+  const proton_registry_t * registry, proton_signal_handle_t handle, uint8_t bit, bool value)
+{
+  if (registry == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  signal_desc_t * desc = proton_signal_handle_desc(registry, handle, PROTON_FLAGS);
+  if (desc == NULL || bit >= PROTON_FLAGS_MAX_BITS)
+  {
+    return PROTON_ERROR;
+  }
+
+  uint64_t mask = (uint64_t)1 << bit;
+  proton_signal_begin_write(desc);
+  if (value)
+  {
+    desc->signal.signal.flags_value |= mask;
+  }
+  else
+  {
+    desc->signal.signal.flags_value &= ~mask;
+  }
+  desc->version++;
+  proton_signal_end_write(desc);
+  return PROTON_OK;
+}
+
+proton_status_e proton_signal_get_flag(
+  const proton_registry_t * registry, uint32_t signal_id, uint8_t bit, bool * value)
+{
+  if (registry == NULL || value == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  proton_signal_handle_t handle;
+  proton_status_e status =
+    proton_registry_resolve_signal(registry, signal_id, PROTON_FLAGS, &handle);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  return proton_signal_handle_get_flag(registry, handle, bit, value);
+}
+
+proton_status_e proton_signal_set_flag(
+  const proton_registry_t * registry, uint32_t signal_id, uint8_t bit, bool value)
+{
+  if (registry == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  proton_signal_handle_t handle;
+  proton_status_e status =
+    proton_registry_resolve_signal(registry, signal_id, PROTON_FLAGS, &handle);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  return proton_signal_handle_set_flag(registry, handle, bit, value);
+}
+
+/*
+ * Descriptor of a handle resolved for any array type, or NULL
+ */
+static signal_desc_t * proton_signal_handle_array_desc(
+  const proton_registry_t * registry, proton_signal_handle_t handle)
+{
+  if (!proton_is_array_type(handle.type))
+  {
+    return NULL;
+  }
+  return proton_signal_handle_desc(registry, handle, handle.type);
+}
+
+proton_status_e proton_signal_handle_get_array(
+  const proton_registry_t * registry, proton_signal_handle_t handle, const void ** data,
+  size_t * count)
+{
+  if (registry == NULL || data == NULL || count == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  signal_desc_t * desc = proton_signal_handle_array_desc(registry, handle);
   if (desc == NULL)
   {
     return PROTON_ERROR;
   }
-  if (desc->signal.which_signal != proton_Signal_bytes_value_tag)
+
+  *data = desc->signal.signal.string_value;  // same union slot for every array type
+  *count = desc->value_size / proton_array_element_size(desc->type);
+  return PROTON_OK;
+}
+
+proton_status_e proton_signal_handle_set_array(
+  const proton_registry_t * registry, proton_signal_handle_t handle, const void * data,
+  size_t count)
+{
+  if (registry == NULL || (data == NULL && count > 0))
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  signal_desc_t * desc = proton_signal_handle_array_desc(registry, handle);
+  if (desc == NULL)
   {
     return PROTON_ERROR;
   }
-  if (desc->capacity < len)
+  size_t size = count * proton_array_element_size(desc->type);
+  if (size > desc->capacity)
   {
     return PROTON_INSUFFICIENT_BUFFER_ERROR;
   }
 
-  if (len == 0)
+  proton_signal_begin_write(desc);
+  if (size > 0)
   {
-    memset(desc->signal.signal.bytes_value, 0, desc->capacity);
+    // data may already point into the signal storage
+    memmove(desc->signal.signal.string_value, data, size);
   }
-  else
+  desc->value_size = (uint16_t)size;
+  desc->version++;
+  proton_signal_end_write(desc);
+  return PROTON_OK;
+}
+
+proton_status_e proton_signal_handle_array_buffer(
+  const proton_registry_t * registry, proton_signal_handle_t handle, void ** data,
+  size_t * capacity)
+{
+  if (registry == NULL || data == NULL || capacity == NULL)
   {
-    memcpy(desc->signal.signal.bytes_value, data, len);
+    return PROTON_NULL_PTR_ERROR;
+  }
+  signal_desc_t * desc = proton_signal_handle_array_desc(registry, handle);
+  if (desc == NULL)
+  {
+    return PROTON_ERROR;
   }
 
-  desc->value_size = len;
+  *data = desc->signal.signal.string_value;
+  *capacity = desc->capacity / proton_array_element_size(desc->type);
+  return PROTON_OK;
+}
+
+proton_status_e proton_signal_handle_commit_array(
+  const proton_registry_t * registry, proton_signal_handle_t handle, size_t count)
+{
+  if (registry == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  signal_desc_t * desc = proton_signal_handle_array_desc(registry, handle);
+  if (desc == NULL)
+  {
+    return PROTON_ERROR;
+  }
+  size_t size = count * proton_array_element_size(desc->type);
+  if (size > desc->capacity)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  proton_signal_begin_write(desc);
+  desc->value_size = (uint16_t)size;
+  desc->version++;
+  proton_signal_end_write(desc);
   return PROTON_OK;
 }
+
+/*
+ * Typed ID-based array accessors, resolving a handle of the array type for every call
+ */
+#define PROTON_DEFINE_ARRAY_ACCESSORS(NAME, CTYPE, SIGNAL_TYPE)                                  \
+  proton_status_e proton_signal_get_##NAME##_array(                                              \
+    const proton_registry_t * registry, uint32_t signal_id, const CTYPE ** data, size_t * count) \
+  {                                                                                              \
+    if (registry == NULL || data == NULL || count == NULL)                                       \
+    {                                                                                            \
+      return PROTON_NULL_PTR_ERROR;                                                              \
+    }                                                                                            \
+    proton_signal_handle_t handle;                                                               \
+    proton_status_e status =                                                                     \
+      proton_registry_resolve_signal(registry, signal_id, (SIGNAL_TYPE), &handle);               \
+    if (status != PROTON_OK)                                                                     \
+    {                                                                                            \
+      return status;                                                                             \
+    }                                                                                            \
+    return proton_signal_handle_get_array(registry, handle, (const void **)data, count);         \
+  }                                                                                              \
+  proton_status_e proton_signal_set_##NAME##_array(                                              \
+    const proton_registry_t * registry, uint32_t signal_id, const CTYPE * data, size_t count)    \
+  {                                                                                              \
+    if (registry == NULL)                                                                        \
+    {                                                                                            \
+      return PROTON_NULL_PTR_ERROR;                                                              \
+    }                                                                                            \
+    proton_signal_handle_t handle;                                                               \
+    proton_status_e status =                                                                     \
+      proton_registry_resolve_signal(registry, signal_id, (SIGNAL_TYPE), &handle);               \
+    if (status != PROTON_OK)                                                                     \
+    {                                                                                            \
+      return status;                                                                             \
+    }                                                                                            \
+    return proton_signal_handle_set_array(registry, handle, data, count);                        \
+  }
+
+PROTON_DEFINE_ARRAY_ACCESSORS(double, double, PROTON_DOUBLE_ARRAY)
+PROTON_DEFINE_ARRAY_ACCESSORS(float, float, PROTON_FLOAT_ARRAY)
+PROTON_DEFINE_ARRAY_ACCESSORS(int32, int32_t, PROTON_INT32_ARRAY)
+PROTON_DEFINE_ARRAY_ACCESSORS(int64, int64_t, PROTON_INT64_ARRAY)
+PROTON_DEFINE_ARRAY_ACCESSORS(uint32, uint32_t, PROTON_UINT32_ARRAY)
+PROTON_DEFINE_ARRAY_ACCESSORS(uint64, uint64_t, PROTON_UINT64_ARRAY)
+
+#undef PROTON_DEFINE_ARRAY_ACCESSORS
@@ -18,54 +18,74 @@
 
 #include "proton/transport/serial.h"
 
-/**
- * @brief Calculate CRC16 given a data buffer and length
- *
- * @param data Data buffer
- * @param len Buffer length
- * @param crc16 Output CRC16
- * @return proton_status_e return status
- */
-static inline proton_status_e proton_crc16(const uint8_t * data, uint16_t len, uint16_t * crc16)
+#include <string.h>
+
+#include "proton/crc.h"
+
+proton_status_e proton_serial_fill_frame_header(uint8_t * header, const uint16_t payload_len)
 {
-  if (!data || !crc16)
+  return proton_serial_fill_frame_header_flags(header, payload_len, 0);
+}
+
+proton_status_e proton_serial_fill_frame_header_flags(
+  uint8_t * header, const uint16_t payload_len, const uint8_t flags)
+{
+  if (!header)
   {
     return PROTON_NULL_PTR_ERROR;
   }
 
-  uint16_t crc = 0xFFFF;
-  for (uint16_t i = 0; i < len; i++)
+  header[0] = PROTON_FRAME_HEADER_MAGIC_BYTE_0;
+  if (flags & PROTON_FRAME_FLAG_CRC32C)
   {
-    crc ^= (uint16_t)data[i] << 8;
-    for (int j = 0; j < 8; j++)
-    {
-      if (crc & 0x8000)
-        crc = (crc << 1) ^ 0x1021;
-      else
-        crc <<= 1;
-    }
+    header[1] = (flags & PROTON_FRAME_FLAG_COMPACT)
+                  ? PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT_CRC32C
+                  : PROTON_FRAME_HEADER_MAGIC_BYTE_1_CRC32C;
+  }
+  else
+  {
+    header[1] = (flags & PROTON_FRAME_FLAG_COMPACT) ? PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT
+                                                     : PROTON_FRAME_HEADER_MAGIC_BYTE_1;
   }
+  header[2] = (uint8_t)(payload_len & 0xFF);
+  header[3] = (uint8_t)(payload_len >> 8);
 
-  *crc16 = crc;
   return PROTON_OK;
 }
 
-proton_status_e proton_serial_fill_frame_header(uint8_t * header, const uint16_t payload_len)
+proton_status_e proton_serial_fill_crc16(
+  const uint8_t * payload, const uint16_t payload_len, uint8_t * crc)
 {
-  if (!header)
+  if (!payload || !crc)
   {
     return PROTON_NULL_PTR_ERROR;
   }
 
-  header[0] = PROTON_FRAME_HEADER_MAGIC_BYTE_0;
-  header[1] = PROTON_FRAME_HEADER_MAGIC_BYTE_1;
-  header[2] = (uint8_t)(payload_len & 0xFF);
-  header[3] = (uint8_t)(payload_len >> 8);
+  uint16_t crc16 = proton_crc16_update(PROTON_CRC16_INIT, payload, payload_len);
+  crc[0] = (uint8_t)(crc16 & 0xFF);
+  crc[1] = (uint8_t)(crc16 >> 8);
 
   return PROTON_OK;
 }
 
-proton_status_e proton_serial_fill_crc16(
+proton_status_e proton_serial_check_framed_payload(
+  const uint8_t * payload, const uint16_t payload_len, const uint16_t frame_crc)
+{
+  if (!payload)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (proton_crc16_update(PROTON_CRC16_INIT, payload, payload_len) != frame_crc)
+  {
+    // CRC16 mismatch
+    return PROTON_CRC16_ERROR;
+  }
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_serial_fill_crc32c(
   const uint8_t * payload, const uint16_t payload_len, uint8_t * crc)
 {
   if (!payload || !crc)
@@ -73,36 +93,30 @@ proton_status_e proton_serial_fill_crc16(
     return PROTON_NULL_PTR_ERROR;
   }
 
-  uint16_t crc16;
-  proton_status_e status = proton_crc16(payload, payload_len, &crc16);
-
-  if (status == PROTON_OK)
+  uint32_t crc32c = proton_crc32c_update(PROTON_CRC32C_INIT, payload, payload_len);
+  for (size_t i = 0; i < PROTON_FRAME_CRC32C_OVERHEAD; i++)
   {
-    crc[0] = (uint8_t)(crc16 & 0xFF);
-    crc[1] = (uint8_t)(crc16 >> 8);
+    crc[i] = (uint8_t)(crc32c >> (8 * i));
   }
 
-  return status;
+  return PROTON_OK;
 }
 
-proton_status_e proton_serial_check_framed_payload(
-  const uint8_t * payload, const uint16_t payload_len, const uint16_t frame_crc)
+proton_status_e proton_serial_check_framed_payload_crc32c(
+  const uint8_t * payload, const uint16_t payload_len, const uint32_t frame_crc)
 {
   if (!payload)
   {
     return PROTON_NULL_PTR_ERROR;
   }
 
-  uint16_t crc;
-  proton_status_e status = proton_crc16(payload, payload_len, &crc);
-
-  if (status == PROTON_OK && crc != frame_crc)
+  if (proton_crc32c_update(PROTON_CRC32C_INIT, payload, payload_len) != frame_crc)
   {
-    // CRC16 mismatch
+    // CRC32C mismatch
     return PROTON_CRC16_ERROR;
   }
 
-  return status;
+  return PROTON_OK;
 }
 
 proton_status_e proton_serial_get_framed_payload_length(
@@ -126,3 +140,334 @@ proton_status_e proton_serial_get_framed_payload_length(
 
   return PROTON_OK;
 }
+
+proton_status_e proton_serial_get_framed_payload_info(
+  const uint8_t * framed_buf, uint16_t * length, uint8_t * flags)
+{
+  if (!framed_buf || !length || !flags)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (framed_buf[0] != PROTON_FRAME_HEADER_MAGIC_BYTE_0)
+  {
+    return PROTON_INVALID_HEADER_ERROR;
+  }
+
+  if (framed_buf[1] == PROTON_FRAME_HEADER_MAGIC_BYTE_1)
+  {
+    *flags = 0;
+  }
+  else if (framed_buf[1] == PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT)
+  {
+    *flags = PROTON_FRAME_FLAG_COMPACT;
+  }
+  else if (framed_buf[1] == PROTON_FRAME_HEADER_MAGIC_BYTE_1_CRC32C)
+  {
+    *flags = PROTON_FRAME_FLAG_CRC32C;
+  }
+  else if (framed_buf[1] == PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT_CRC32C)
+  {
+    *flags = PROTON_FRAME_FLAG_COMPACT | PROTON_FRAME_FLAG_CRC32C;
+  }
+  else
+  {
+    return PROTON_INVALID_HEADER_ERROR;
+  }
+
+  *length = framed_buf[2] | (framed_buf[3] << 8);
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_serial_fill_frame(
+  uint8_t * frame, size_t payload_len, uint8_t flags, void * arg)
+{
+  (void)arg;
+  if (!frame)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (payload_len > PROTON_MAX_MESSAGE_SIZE)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  uint8_t * payload = frame + PROTON_FRAME_HEADER_OVERHEAD;
+  proton_status_e status =
+    proton_serial_fill_frame_header_flags(frame, (uint16_t)payload_len, flags);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  if (flags & PROTON_FRAME_FLAG_CRC32C)
+  {
+    return proton_serial_fill_crc32c(payload, (uint16_t)payload_len, payload + payload_len);
+  }
+  return proton_serial_fill_crc16(payload, (uint16_t)payload_len, payload + payload_len);
+}
+
+proton_status_e proton_serial_fill_frame_crc32c(
+  uint8_t * frame, size_t payload_len, uint8_t flags, void * arg)
+{
+  return proton_serial_fill_frame(frame, payload_len, flags | PROTON_FRAME_FLAG_CRC32C, arg);
+}
+
+/**
+ * Number of CRC bytes ending a frame with the given flags
+ */
+static inline size_t proton_serial_crc_len(uint8_t flags)
+{
+  return (flags & PROTON_FRAME_FLAG_CRC32C) ? PROTON_FRAME_CRC32C_OVERHEAD
+                                            : PROTON_FRAME_CRC_OVERHEAD;
+}
+
+static inline uint32_t proton_serial_crc_update(
+  uint8_t flags, uint32_t crc, const uint8_t * data, size_t len)
+{
+  if (flags & PROTON_FRAME_FLAG_CRC32C)
+  {
+    return proton_crc32c_update(crc, data, len);
+  }
+  return proton_crc16_update((uint16_t)crc, data, len);
+}
+
+/**
+ * Start a frame from a complete header
+ * @return PROTON_ERROR if the header is not a frame header, PROTON_INVALID_HEADER_ERROR if the
+ * payload is too long
+ */
+static proton_status_e proton_serial_parser_start_frame(
+  proton_serial_parser_t * parser, const uint8_t * header)
+{
+  uint16_t length;
+  uint8_t flags;
+  if (proton_serial_get_framed_payload_info(header, &length, &flags) != PROTON_OK)
+  {
+    return PROTON_ERROR;
+  }
+
+  if (length > parser->max_payload_len)
+  {
+    parser->length_errors++;
+    return PROTON_INVALID_HEADER_ERROR;
+  }
+
+  parser->payload_len = length;
+  parser->flags = flags;
+  parser->payload_received = 0;
+  parser->crc_received = 0;
+  parser->crc = (flags & PROTON_FRAME_FLAG_CRC32C) ? PROTON_CRC32C_INIT : PROTON_CRC16_INIT;
+  parser->header_len = 0;
+  parser->state = length ? PROTON_SERIAL_PARSER_PAYLOAD : PROTON_SERIAL_PARSER_CRC;
+
+  return PROTON_OK;
+}
+
+/**
+ * Drop a rejected header, keeping any of its later bytes that could start the next one
+ */
+static void proton_serial_parser_resync_header(proton_serial_parser_t * parser)
+{
+  size_t skip = 1;
+  while (skip < parser->header_len && parser->header[skip] != PROTON_FRAME_HEADER_MAGIC_BYTE_0)
+  {
+    skip++;
+  }
+
+  parser->discarded_bytes += (uint32_t)skip;
+  parser->header_len -= skip;
+  memmove(parser->header, parser->header + skip, parser->header_len);
+  parser->state = parser->header_len ? PROTON_SERIAL_PARSER_HEADER : PROTON_SERIAL_PARSER_SYNC;
+}
+
+/**
+ * Check the CRC of a complete frame and output it
+ */
+static proton_status_e proton_serial_parser_finish_frame(
+  proton_serial_parser_t * parser, const uint8_t * payload, uint32_t crc, const uint8_t * crc_bytes,
+  proton_serial_frame_t * frame)
+{
+  parser->state = PROTON_SERIAL_PARSER_SYNC;
+
+  uint32_t frame_crc = 0;
+  for (size_t i = 0; i < proton_serial_crc_len(parser->flags); i++)
+  {
+    frame_crc |= (uint32_t)crc_bytes[i] << (8 * i);
+  }
+
+  if (crc != frame_crc)
+  {
+    parser->crc_errors++;
+    return PROTON_CRC16_ERROR;
+  }
+
+  parser->frames++;
+  frame->payload = payload;
+  frame->length = parser->payload_len;
+  frame->flags = parser->flags;
+
+  return PROTON_OK;
+}
+
+proton_status_e proton_serial_parser_init(
+  proton_serial_parser_t * parser, uint8_t * buffer, size_t buffer_len, uint16_t max_payload_len)
+{
+  if (!parser || !buffer)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (buffer_len < max_payload_len)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  memset(parser, 0, sizeof(*parser));
+  parser->buffer = buffer;
+  parser->buffer_len = buffer_len;
+  parser->max_payload_len = max_payload_len;
+  parser->state = PROTON_SERIAL_PARSER_SYNC;
+
+  return PROTON_OK;
+}
+
+void proton_serial_parser_reset(proton_serial_parser_t * parser)
+{
+  if (parser)
+  {
+    parser->state = PROTON_SERIAL_PARSER_SYNC;
+    parser->header_len = 0;
+  }
+}
+
+proton_status_e proton_serial_parser_feed(
+  proton_serial_parser_t * parser, const uint8_t * data, size_t len, size_t * consumed,
+  proton_serial_frame_t * frame)
+{
+  if (!parser || !data || !consumed || !frame)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  frame->payload = NULL;
+  frame->length = 0;
+  frame->flags = 0;
+
+  proton_status_e status = PROTON_OK;
+  size_t pos = 0;
+  while (pos < len && !frame->payload && status == PROTON_OK)
+  {
+    switch (parser->state)
+    {
+      case PROTON_SERIAL_PARSER_SYNC:
+      {
+        const uint8_t * magic = memchr(data + pos, PROTON_FRAME_HEADER_MAGIC_BYTE_0, len - pos);
+        size_t start = magic ? (size_t)(magic - data) : len;
+        parser->discarded_bytes += (uint32_t)(start - pos);
+        pos = start;
+        if (pos == len)
+        {
+          break;
+        }
+
+        if (len - pos < PROTON_FRAME_HEADER_OVERHEAD)
+        {
+          // Header split across chunks
+          parser->header_len = len - pos;
+          memcpy(parser->header, data + pos, parser->header_len);
+          parser->state = PROTON_SERIAL_PARSER_HEADER;
+          pos = len;
+          break;
+        }
+
+        status = proton_serial_parser_start_frame(parser, data + pos);
+        if (status != PROTON_OK)
+        {
+          // Not a frame, look for the next magic byte from the one after this one
+          parser->discarded_bytes++;
+          pos++;
+          if (status == PROTON_ERROR)
+          {
+            status = PROTON_OK;
+          }
+          break;
+        }
+        pos += PROTON_FRAME_HEADER_OVERHEAD;
+
+        // Check a frame that arrived whole in place
+        size_t crc_len = proton_serial_crc_len(parser->flags);
+        if (len - pos >= parser->payload_len + crc_len)
+        {
+          const uint8_t * payload = data + pos;
+          uint32_t crc = proton_serial_crc_update(
+            parser->flags, parser->crc, payload, parser->payload_len);
+          pos += parser->payload_len + crc_len;
+          status = proton_serial_parser_finish_frame(
+            parser, payload, crc, payload + parser->payload_len, frame);
+        }
+        break;
+      }
+
+      case PROTON_SERIAL_PARSER_HEADER:
+      {
+        size_t n = PROTON_FRAME_HEADER_OVERHEAD - parser->header_len;
+        n = n < len - pos ? n : len - pos;
+        memcpy(parser->header + parser->header_len, data + pos, n);
+        parser->header_len += n;
+        pos += n;
+        if (parser->header_len < PROTON_FRAME_HEADER_OVERHEAD)
+        {
+          break;
+        }
+
+        status = proton_serial_parser_start_frame(parser, parser->header);
+        if (status != PROTON_OK)
+        {
+          proton_serial_parser_resync_header(parser);
+          if (status == PROTON_ERROR)
+          {
+            status = PROTON_OK;
+          }
+        }
+        break;
+      }
+
+      case PROTON_SERIAL_PARSER_PAYLOAD:
+      {
+        size_t n = parser->payload_len - parser->payload_received;
+        n = n < len - pos ? n : len - pos;
+        memcpy(parser->buffer + parser->payload_received, data + pos, n);
+        parser->crc = proton_serial_crc_update(parser->flags, parser->crc, data + pos, n);
+        parser->payload_received += n;
+        pos += n;
+        if (parser->payload_received == parser->payload_len)
+        {
+          parser->state = PROTON_SERIAL_PARSER_CRC;
+        }
+        break;
+      }
+
+      case PROTON_SERIAL_PARSER_CRC:
+      {
+        size_t crc_len = proton_serial_crc_len(parser->flags);
+        size_t n = crc_len - parser->crc_received;
+        n = n < len - pos ? n : len - pos;
+        memcpy(parser->crc_bytes + parser->crc_received, data + pos, n);
+        parser->crc_received += n;
+        pos += n;
+        if (parser->crc_received == crc_len)
+        {
+          status = proton_serial_parser_finish_frame(
+            parser, parser->buffer, parser->crc, parser->crc_bytes, frame);
+        }
+        break;
+      }
+    }
+  }
+
+  *consumed = pos;
+  return status;
+}
@@ -77,3 +77,23 @@ proton_status_e proton_udp4_check_payload(
 
   return PROTON_OK;
 }
+
+proton_status_e proton_udp4_fill_frame(
+  uint8_t * frame, size_t payload_len, uint8_t flags, void * arg)
+{
+  (void)payload_len;
+  if (frame == NULL)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  proton_udp4_header_t header;
+  proton_status_e status =
+    proton_udp4_fill_header(&header, arg ? *(const uint8_t *)arg : 0, flags);
+  if (status == PROTON_OK)
+  {
+    memcpy(frame, &header, sizeof(header));
+  }
+
+  return status;
+}
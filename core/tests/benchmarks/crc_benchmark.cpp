@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "proton/crc.h"
+
+namespace
+{
+constexpr size_t DEFAULT_ITERATIONS = 20000;
+// Sizes of a small bundle, a typical serial frame and the largest frame
+constexpr size_t FRAME_SIZES[] = {16, 256, 4096};
+
+template <typename CrcT>
+using crc_fn = CrcT (*)(CrcT, const uint8_t *, size_t);
+
+/**
+ * Time a CRC over a buffer
+ * @return average nanoseconds per buffer, and the sum of the CRCs in *sum so the variants can be
+ * checked against each other and the calls are not optimized out
+ */
+template <typename CrcT>
+double time_crc(
+  crc_fn<CrcT> crc, CrcT init, const std::vector<uint8_t> & buffer, size_t iterations, CrcT * sum)
+{
+  CrcT result = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iteration = 0; iteration < iterations; iteration++)
+  {
+    result = static_cast<CrcT>(result + crc(init, buffer.data(), buffer.size()));
+  }
+  auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  *sum = result;
+  return static_cast<double>(elapsed_ns.count()) / static_cast<double>(iterations);
+}
+
+void report(const char * name, size_t size, double ns_per_buffer)
+{
+  std::printf(
+    "%-28s %5zu B %10.1f ns/frame %10.1f MB/s\n", name, size, ns_per_buffer,
+    static_cast<double>(size) * 1e3 / ns_per_buffer);
+}
+}  // namespace
+
+/**
+ * Compare the bitwise and slicing-by-8 CRC16 with the table and instruction CRC32C.
+ * Usage: crc_benchmark [iterations]
+ */
+int main(int argc, char ** argv)
+{
+  size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_ITERATIONS;
+
+  std::printf(
+    "CRC32C instructions: %s\n", proton_crc32c_hw_supported() ? "available" : "not available");
+
+  for (size_t size : FRAME_SIZES)
+  {
+    std::vector<uint8_t> buffer(size);
+    for (size_t i = 0; i < size; i++)
+    {
+      buffer[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+
+    uint16_t bitwise_sum = 0;
+    double bitwise_ns = time_crc<uint16_t>(
+      proton_crc16_update_bitwise, PROTON_CRC16_INIT, buffer, iterations, &bitwise_sum);
+    report("proton_crc16_update_bitwise", size, bitwise_ns);
+
+    uint16_t sliced_sum = 0;
+    double sliced_ns = time_crc<uint16_t>(
+      proton_crc16_update, PROTON_CRC16_INIT, buffer, iterations, &sliced_sum);
+    report("proton_crc16_update", size, sliced_ns);
+
+    uint32_t sw_sum = 0;
+    double sw_ns = time_crc<uint32_t>(
+      proton_crc32c_update_sw, PROTON_CRC32C_INIT, buffer, iterations, &sw_sum);
+    report("proton_crc32c_update_sw", size, sw_ns);
+
+    uint32_t crc32c_sum = 0;
+    double crc32c_ns = time_crc<uint32_t>(
+      proton_crc32c_update, PROTON_CRC32C_INIT, buffer, iterations, &crc32c_sum);
+    report("proton_crc32c_update", size, crc32c_ns);
+
+    if (bitwise_sum != sliced_sum || sw_sum != crc32c_sum)
+    {
+      std::fprintf(stderr, "CRC variants disagree on %zu bytes\n", size);
+      return 1;
+    }
+
+    std::printf(
+      "speedup over bitwise: crc16 %.2fx, crc32c %.2fx\n", bitwise_ns / sliced_ns,
+      bitwise_ns / crc32c_ns);
+  }
+
+  return 0;
+}
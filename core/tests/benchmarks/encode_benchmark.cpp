@@ -0,0 +1,161 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "proton/encode_decode.h"
+#include "proton/registry.h"
+
+extern proton_registry_t g_proton_registry;
+
+namespace
+{
+constexpr size_t BUFFER_SIZE = 1024;
+constexpr size_t DEFAULT_ITERATIONS = 200000;
+
+using encode_fn = proton_status_e (*)(proton_registry_t *, uint32_t, uint8_t *, size_t, size_t *);
+
+/**
+ * Time an encoder over every bundle in the registry
+ * @return average nanoseconds per bundle, and the encoded bytes per bundle in *bytes_per_bundle
+ */
+double time_encoder(encode_fn encode, size_t iterations, double * bytes_per_bundle)
+{
+  uint8_t buffer[BUFFER_SIZE];
+  size_t total_bytes = 0;
+  size_t bundles = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iteration = 0; iteration < iterations; iteration++)
+  {
+    for (size_t i = 0; i < g_proton_registry.bundle_count; i++)
+    {
+      uint32_t bundle_id = g_proton_registry.bundle_table[i].bundle_id;
+      size_t bytes_encoded = 0;
+      if (
+        encode(&g_proton_registry, bundle_id, buffer, sizeof(buffer), &bytes_encoded) != PROTON_OK)
+      {
+        std::fprintf(stderr, "Failed to encode bundle %u\n", bundle_id);
+        std::exit(1);
+      }
+      total_bytes += bytes_encoded;
+      bundles++;
+    }
+  }
+  auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  *bytes_per_bundle = static_cast<double>(total_bytes) / static_cast<double>(bundles);
+  return static_cast<double>(elapsed_ns.count()) / static_cast<double>(bundles);
+}
+
+using decode_fn = proton_status_e (*)(proton_registry_t *, const uint8_t *, size_t);
+
+proton_status_e decode_nanopb(proton_registry_t * registry, const uint8_t * buffer, size_t len)
+{
+  proton_Proton msg = proton_Proton_init_default;
+  return proton_decode(registry, buffer, len, &msg);
+}
+
+proton_status_e decode_direct(proton_registry_t * registry, const uint8_t * buffer, size_t len)
+{
+  return proton_decode_direct(registry, buffer, len, nullptr, nullptr);
+}
+
+/**
+ * Time a decoder over every bundle in the registry, encoded once up front
+ * @return average nanoseconds per bundle, and the encoded bytes per bundle in *bytes_per_bundle
+ */
+double time_decoder(decode_fn decode, size_t iterations, double * bytes_per_bundle)
+{
+  std::vector<std::vector<uint8_t>> frames;
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < g_proton_registry.bundle_count; i++)
+  {
+    uint32_t bundle_id = g_proton_registry.bundle_table[i].bundle_id;
+    std::vector<uint8_t> frame(BUFFER_SIZE);
+    size_t bytes_encoded = 0;
+    if (
+      proton_encode_bundle_direct(
+        &g_proton_registry, bundle_id, frame.data(), frame.size(), &bytes_encoded) != PROTON_OK)
+    {
+      std::fprintf(stderr, "Failed to encode bundle %u\n", bundle_id);
+      std::exit(1);
+    }
+    frame.resize(bytes_encoded);
+    total_bytes += bytes_encoded;
+    frames.push_back(std::move(frame));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iteration = 0; iteration < iterations; iteration++)
+  {
+    for (const auto & frame : frames)
+    {
+      if (decode(&g_proton_registry, frame.data(), frame.size()) != PROTON_OK)
+      {
+        std::fprintf(stderr, "Failed to decode bundle\n");
+        std::exit(1);
+      }
+    }
+  }
+  auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  size_t bundles = iterations * frames.size();
+  *bytes_per_bundle = static_cast<double>(total_bytes) / static_cast<double>(frames.size());
+  return static_cast<double>(elapsed_ns.count()) / static_cast<double>(bundles);
+}
+
+void report(const char * name, double ns_per_bundle, double bytes_per_bundle)
+{
+  std::printf(
+    "%-28s %10.1f ns/bundle %10.1f MB/s\n", name, ns_per_bundle,
+    bytes_per_bundle * 1e3 / ns_per_bundle);
+}
+}  // namespace
+
+/**
+ * Compare the nanopb bundle encoder and decoder with the direct ones on the test registry.
+ * Usage: encode_benchmark [iterations]
+ */
+int main(int argc, char ** argv)
+{
+  size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_ITERATIONS;
+
+  double bytes_per_bundle = 0.0;
+  double nanopb_ns = time_encoder(proton_encode_bundle, iterations, &bytes_per_bundle);
+  report("proton_encode_bundle", nanopb_ns, bytes_per_bundle);
+
+  double direct_ns = time_encoder(proton_encode_bundle_direct, iterations, &bytes_per_bundle);
+  report("proton_encode_bundle_direct", direct_ns, bytes_per_bundle);
+
+  std::printf("speedup: %.2fx\n", nanopb_ns / direct_ns);
+
+  double nanopb_decode_ns = time_decoder(decode_nanopb, iterations, &bytes_per_bundle);
+  report("proton_decode", nanopb_decode_ns, bytes_per_bundle);
+
+  double direct_decode_ns = time_decoder(decode_direct, iterations, &bytes_per_bundle);
+  report("proton_decode_direct", direct_decode_ns, bytes_per_bundle);
+
+  std::printf("speedup: %.2fx\n", nanopb_decode_ns / direct_decode_ns);
+  return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "proton/crc.h"
+
+namespace
+{
+const uint8_t CHECK_STRING[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+std::vector<uint8_t> random_bytes(size_t len, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> data(len);
+  for (auto & byte : data)
+  {
+    byte = static_cast<uint8_t>(rng());
+  }
+  return data;
+}
+
+/**
+ * Bit by bit reflected CRC32C, the reference for the table and instruction versions
+ */
+uint32_t crc32c_bitwise(const uint8_t * data, size_t len)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; i++)
+  {
+    crc ^= data[i];
+    for (int j = 0; j < 8; j++)
+    {
+      crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+    }
+  }
+  return ~crc;
+}
+}  // namespace
+
+// -----------------------------------------------------------------------
+// CRC16-CCITT
+// -----------------------------------------------------------------------
+
+TEST(Crc16, KnownValues)
+{
+  EXPECT_EQ(proton_crc16_update(PROTON_CRC16_INIT, CHECK_STRING, 0), 0xFFFF);
+  EXPECT_EQ(proton_crc16_update(PROTON_CRC16_INIT, CHECK_STRING, sizeof(CHECK_STRING)), 0x29B1);
+  const uint8_t single[] = {0xAB};
+  EXPECT_EQ(proton_crc16_update(PROTON_CRC16_INIT, single, sizeof(single)), 0xE571);
+  EXPECT_EQ(
+    proton_crc16_update_bitwise(PROTON_CRC16_INIT, CHECK_STRING, sizeof(CHECK_STRING)), 0x29B1);
+}
+
+TEST(Crc16, EveryTableEntryMatchesBitwise)
+{
+  // From 0, an 8 byte block holding only byte n at position p comes down to entry n of table 7 - p
+  for (size_t position = 0; position < 8; position++)
+  {
+    for (int n = 0; n < 256; n++)
+    {
+      uint8_t block[8] = {};
+      block[position] = static_cast<uint8_t>(n);
+      ASSERT_EQ(proton_crc16_update(0, block, 8), proton_crc16_update_bitwise(0, block, 8))
+        << "byte " << n << " position " << position;
+    }
+  }
+}
+
+TEST(Crc16, MatchesBitwiseForEveryLengthAndAlignment)
+{
+  auto data = random_bytes(256, 16);
+  for (size_t offset = 0; offset < 8; offset++)
+  {
+    for (size_t len = 0; offset + len <= data.size(); len++)
+    {
+      ASSERT_EQ(
+        proton_crc16_update(PROTON_CRC16_INIT, data.data() + offset, len),
+        proton_crc16_update_bitwise(PROTON_CRC16_INIT, data.data() + offset, len))
+        << "offset " << offset << " len " << len;
+    }
+  }
+}
+
+TEST(Crc16, IncrementalUpdateMatchesOneShot)
+{
+  auto data = random_bytes(1000, 17);
+  const uint16_t expected = proton_crc16_update(PROTON_CRC16_INIT, data.data(), data.size());
+
+  for (size_t chunk : {1, 3, 7, 8, 9, 64, 999})
+  {
+    uint16_t crc = PROTON_CRC16_INIT;
+    for (size_t i = 0; i < data.size(); i += chunk)
+    {
+      crc = proton_crc16_update(crc, data.data() + i, std::min(chunk, data.size() - i));
+    }
+    EXPECT_EQ(crc, expected) << "chunk " << chunk;
+  }
+}
+
+TEST(Crc16, NullDataLeavesCrcUnchanged)
+{
+  EXPECT_EQ(proton_crc16_update(0x1234, nullptr, 10), 0x1234);
+  EXPECT_EQ(proton_crc16_update_bitwise(0x1234, nullptr, 10), 0x1234);
+}
+
+// -----------------------------------------------------------------------
+// CRC32C
+// -----------------------------------------------------------------------
+
+TEST(Crc32c, KnownValues)
+{
+  EXPECT_EQ(proton_crc32c_update(PROTON_CRC32C_INIT, CHECK_STRING, 0), 0x00000000u);
+  EXPECT_EQ(
+    proton_crc32c_update(PROTON_CRC32C_INIT, CHECK_STRING, sizeof(CHECK_STRING)), 0xE3069283u);
+  EXPECT_EQ(
+    proton_crc32c_update_sw(PROTON_CRC32C_INIT, CHECK_STRING, sizeof(CHECK_STRING)), 0xE3069283u);
+
+  // RFC 3720 B.4, 32 bytes of zeros
+  const uint8_t zeros[32] = {};
+  EXPECT_EQ(proton_crc32c_update(PROTON_CRC32C_INIT, zeros, sizeof(zeros)), 0x8A9136AAu);
+}
+
+TEST(Crc32c, HardwareAndSoftwareMatchBitwise)
+{
+  auto data = random_bytes(256, 32);
+  for (size_t offset = 0; offset < 8; offset++)
+  {
+    for (size_t len = 0; offset + len <= data.size(); len++)
+    {
+      const uint32_t expected = crc32c_bitwise(data.data() + offset, len);
+      ASSERT_EQ(proton_crc32c_update(PROTON_CRC32C_INIT, data.data() + offset, len), expected)
+        << "offset " << offset << " len " << len;
+      ASSERT_EQ(proton_crc32c_update_sw(PROTON_CRC32C_INIT, data.data() + offset, len), expected)
+        << "offset " << offset << " len " << len;
+    }
+  }
+}
+
+TEST(Crc32c, IncrementalUpdateMatchesOneShot)
+{
+  auto data = random_bytes(1000, 33);
+  const uint32_t expected = proton_crc32c_update(PROTON_CRC32C_INIT, data.data(), data.size());
+
+  for (size_t chunk : {1, 3, 7, 8, 9, 64, 999})
+  {
+    uint32_t crc = PROTON_CRC32C_INIT;
+    uint32_t crc_sw = PROTON_CRC32C_INIT;
+    for (size_t i = 0; i < data.size(); i += chunk)
+    {
+      const size_t len = std::min(chunk, data.size() - i);
+      crc = proton_crc32c_update(crc, data.data() + i, len);
+      crc_sw = proton_crc32c_update_sw(crc_sw, data.data() + i, len);
+    }
+    EXPECT_EQ(crc, expected) << "chunk " << chunk;
+    EXPECT_EQ(crc_sw, expected) << "chunk " << chunk;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,7 +18,13 @@
 
 #include "proton/encode_decode.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
 #include "proton/registry.h"
 #include "target_registry_ids.h"
 #include "target_registry_sizes.h"
@@ -269,6 +275,1438 @@ TEST(EncodeDecode, SignalSharedBetweenBundles)
   free(registry.signal_registry);
 }
 
+// -----------------------------------------------------------------------
+// Direct encode
+// -----------------------------------------------------------------------
+
+/**
+ * Set every signal in the registry to a random value of its type
+ */
+static void randomize_signals(proton_registry_t * registry, std::mt19937 & rng)
+{
+  std::uniform_int_distribution<uint64_t> bits;
+  for (size_t i = 0; i < registry->signal_count; i++)
+  {
+    const signal_desc_t * desc = &registry->signal_registry[i];
+    uint64_t value = bits(rng) >> std::uniform_int_distribution<int>(0, 63)(rng);
+    if (desc->encoding != NULL)
+    {
+      // Pick a value the encoding holds exactly so it survives a round trip, leaving out the
+      // infinities and NaNs of half precision
+      proton_Signal decoded = proton_Signal_init_zero;
+      uint64_t varint = desc->encoding->type == PROTON_ENCODING_FLOAT16 ? value & 0xBFFF
+                                                                         : value & 0xFFFFFFFF;
+      proton_decode_signal_varint(desc, varint, &decoded);
+      if (desc->type == PROTON_DOUBLE)
+      {
+        proton_signal_set_double(registry, desc->id, decoded.signal.double_value);
+      }
+      else
+      {
+        proton_signal_set_float(registry, desc->id, decoded.signal.float_value);
+      }
+      continue;
+    }
+    switch (desc->type)
+    {
+      case PROTON_DOUBLE:
+        proton_signal_set_double(registry, desc->id, static_cast<double>(value) * -1.5);
+        break;
+      case PROTON_FLOAT:
+        proton_signal_set_float(registry, desc->id, static_cast<float>(value) * 0.25f);
+        break;
+      case PROTON_INT32:
+        proton_signal_set_int32(registry, desc->id, static_cast<int32_t>(value));
+        break;
+      case PROTON_INT64:
+        proton_signal_set_int64(registry, desc->id, static_cast<int64_t>(value));
+        break;
+      case PROTON_UINT32:
+        proton_signal_set_uint32(registry, desc->id, static_cast<uint32_t>(value));
+        break;
+      case PROTON_UINT64:
+        proton_signal_set_uint64(registry, desc->id, value);
+        break;
+      case PROTON_BOOL:
+        proton_signal_set_bool(registry, desc->id, (value & 1) != 0);
+        break;
+      case PROTON_FLAGS:
+        proton_signal_set_flags(registry, desc->id, value);
+        break;
+      case PROTON_STRING:
+      {
+        std::string str(value % desc->capacity, 'a' + static_cast<char>(value % 26));
+        proton_signal_set_string(registry, desc->id, str.c_str(), str.size() + 1);
+        break;
+      }
+      case PROTON_BYTES:
+      {
+        std::vector<uint8_t> data(value % (desc->capacity + 1), static_cast<uint8_t>(value));
+        proton_signal_set_bytes(registry, desc->id, data.data(), data.size());
+        break;
+      }
+      default:
+        if (proton_is_array_type(desc->type))
+        {
+          // Any bits make a valid element, shifted values give varints of every length
+          size_t element_size = proton_array_element_size(desc->type);
+          size_t count = value % (desc->capacity / element_size + 1);
+          std::vector<uint8_t> data(count * element_size);
+          for (size_t j = 0; j < count; j++)
+          {
+            uint64_t element = bits(rng) >> std::uniform_int_distribution<int>(0, 63)(rng);
+            memcpy(&data[j * element_size], &element, element_size);
+          }
+          proton_signal_handle_t handle;
+          proton_registry_resolve_signal(registry, desc->id, desc->type, &handle);
+          proton_signal_handle_set_array(registry, handle, data.data(), count);
+        }
+        break;
+    }
+  }
+}
+
+TEST(EncodeDecode, EncodeDirectNullPtrsReturnError)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  uint8_t raw[BUFFER_SIZE];
+  size_t bytes_encoded = 0;
+
+  EXPECT_EQ(
+    proton_encode_bundle_direct(
+      nullptr, PROTON_BUNDLE_SHARED_1_ID, raw, sizeof(raw), &bytes_encoded),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_encode_bundle_direct(
+      &registry, PROTON_BUNDLE_SHARED_1_ID, nullptr, sizeof(raw), &bytes_encoded),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_encode_bundle_direct(&registry, PROTON_BUNDLE_SHARED_1_ID, raw, sizeof(raw), nullptr),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_encode_bundle_direct(&registry, 0xDEAD, raw, sizeof(raw), &bytes_encoded),
+    PROTON_ERROR);
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, EncodeDirectMatchesNanopb)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  std::mt19937 rng(5678);
+
+  for (int iteration = 0; iteration < 200; iteration++)
+  {
+    if (iteration > 0)
+    {
+      randomize_signals(&registry, rng);
+    }
+
+    for (size_t i = 0; i < registry.bundle_count; i++)
+    {
+      uint32_t bundle_id = registry.bundle_table[i].bundle_id;
+      uint8_t expected[BUFFER_SIZE];
+      size_t expected_len = 0;
+      ASSERT_EQ(
+        proton_encode_bundle(&registry, bundle_id, expected, sizeof(expected), &expected_len),
+        PROTON_OK);
+
+      uint8_t raw[BUFFER_SIZE];
+      size_t bytes_encoded = 0;
+      ASSERT_EQ(
+        proton_encode_bundle_direct(&registry, bundle_id, raw, sizeof(raw), &bytes_encoded),
+        PROTON_OK);
+
+      ASSERT_EQ(bytes_encoded, expected_len) << "bundle " << bundle_id;
+      ASSERT_EQ(memcmp(raw, expected, expected_len), 0) << "bundle " << bundle_id;
+
+      // Anything shorter than the message fails, as with nanopb
+      EXPECT_EQ(
+        proton_encode_bundle_direct(&registry, bundle_id, raw, expected_len - 1, &bytes_encoded),
+        PROTON_SERIALIZATION_ERROR);
+    }
+  }
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+// -----------------------------------------------------------------------
+// Bundle sets
+// -----------------------------------------------------------------------
+
+namespace
+{
+/**
+ * Records each bundle dispatched by proton_decode_dispatch, with the shared signal value it saw
+ */
+struct DispatchRecorder
+{
+  std::vector<uint32_t> bundle_ids;
+  std::vector<int32_t> shared_values;
+  proton_status_e result{PROTON_OK};
+
+  static proton_status_e on_bundle(proton_registry_t * registry, uint32_t bundle_id, void * arg)
+  {
+    auto * recorder = static_cast<DispatchRecorder *>(arg);
+    int32_t value = 0;
+    proton_signal_get_int32(registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, &value);
+    recorder->bundle_ids.push_back(bundle_id);
+    recorder->shared_values.push_back(value);
+    return recorder->result;
+  }
+};
+}  // namespace
+
+TEST(EncodeDecode, BundleSetNullPtrsReturnError)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_bundle_set_encoder_t encoder;
+  uint8_t raw[BUFFER_SIZE];
+  size_t bytes_encoded = 0;
+
+  EXPECT_EQ(proton_bundle_set_init(nullptr, raw, sizeof(raw), 0), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(proton_bundle_set_init(&encoder, nullptr, sizeof(raw), 0), PROTON_NULL_PTR_ERROR);
+  ASSERT_EQ(proton_bundle_set_init(&encoder, raw, sizeof(raw), 0), PROTON_OK);
+  EXPECT_EQ(
+    proton_bundle_set_add(&encoder, nullptr, PROTON_BUNDLE_SHARED_1_ID), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(proton_bundle_set_add(&encoder, &registry, 0xDEAD), PROTON_ERROR);
+  EXPECT_EQ(proton_bundle_set_finish(&encoder, nullptr), PROTON_NULL_PTR_ERROR);
+
+  // Nothing added
+  ASSERT_EQ(proton_bundle_set_finish(&encoder, &bytes_encoded), PROTON_OK);
+  EXPECT_EQ(bytes_encoded, 0u);
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, BundleSetWithOneBundleMatchesEncodeBundle)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  uint8_t expected[BUFFER_SIZE];
+  size_t expected_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(
+      &registry, PROTON_BUNDLE_VALUE_TEST_ID, expected, sizeof(expected), &expected_len),
+    PROTON_OK);
+
+  uint8_t raw[BUFFER_SIZE];
+  size_t bytes_encoded = 0;
+  proton_bundle_set_encoder_t encoder;
+  ASSERT_EQ(proton_bundle_set_init(&encoder, raw, sizeof(raw), 0), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_finish(&encoder, &bytes_encoded), PROTON_OK);
+
+  ASSERT_EQ(bytes_encoded, expected_len);
+  EXPECT_EQ(memcmp(raw, expected, expected_len), 0);
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, BundleSetRoundTripDispatchesEachBundle)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  uint8_t raw[BUFFER_SIZE];
+  size_t bytes_encoded = 0;
+  proton_bundle_set_encoder_t encoder;
+  ASSERT_EQ(proton_bundle_set_init(&encoder, raw, sizeof(raw), 0), PROTON_OK);
+
+  // Both bundles carry the shared signal, with a different value in each
+  ASSERT_EQ(proton_signal_set_int32(&registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, 42), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  ASSERT_EQ(proton_signal_set_int32(&registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, 84), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_2_ID), PROTON_OK);
+  ASSERT_EQ(
+    proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_DEFAULT_VALUE_TEST_ID), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_finish(&encoder, &bytes_encoded), PROTON_OK);
+  ASSERT_GT(bytes_encoded, 0u);
+
+  ASSERT_EQ(proton_signal_set_int32(&registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, 0), PROTON_OK);
+  ASSERT_EQ(proton_signal_set_double(&registry, PROTON_SIGNAL_DEFAULT_DOUBLE_ID, 0.0), PROTON_OK);
+
+  DispatchRecorder recorder;
+  proton_Proton decoded_msg = proton_Proton_init_zero;
+  ASSERT_EQ(
+    proton_decode_dispatch(
+      &registry, raw, bytes_encoded, &decoded_msg, DispatchRecorder::on_bundle, &recorder),
+    PROTON_OK);
+  EXPECT_EQ(decoded_msg.which_operation, proton_Proton_bundle_set_tag);
+
+  std::vector<uint32_t> expected_ids = {
+    PROTON_BUNDLE_SHARED_1_ID, PROTON_BUNDLE_SHARED_2_ID, PROTON_BUNDLE_DEFAULT_VALUE_TEST_ID};
+  EXPECT_EQ(recorder.bundle_ids, expected_ids);
+  std::vector<int32_t> expected_values = {42, 84, 84};
+  EXPECT_EQ(recorder.shared_values, expected_values);
+
+  double decoded_double = 0.0;
+  ASSERT_EQ(
+    proton_signal_get_double(&registry, PROTON_SIGNAL_DEFAULT_DOUBLE_ID, &decoded_double),
+    PROTON_OK);
+  EXPECT_DOUBLE_EQ(decoded_double, 3.14159);
+
+  // Decoding without a dispatch callback still writes every bundle
+  ASSERT_EQ(proton_signal_set_int32(&registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, 0), PROTON_OK);
+  decoded_msg = proton_Proton_init_zero;
+  ASSERT_EQ(proton_decode(&registry, raw, bytes_encoded, &decoded_msg), PROTON_OK);
+  int32_t shared = 0;
+  ASSERT_EQ(proton_signal_get_int32(&registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, &shared), PROTON_OK);
+  EXPECT_EQ(shared, 84);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, BundleSetDispatchErrorStopsDecoding)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  uint8_t raw[BUFFER_SIZE];
+  size_t bytes_encoded = 0;
+  proton_bundle_set_encoder_t encoder;
+  ASSERT_EQ(proton_bundle_set_init(&encoder, raw, sizeof(raw), 0), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_2_ID), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_finish(&encoder, &bytes_encoded), PROTON_OK);
+
+  DispatchRecorder recorder;
+  recorder.result = PROTON_INCORRECT_TARGET_ERROR;
+  proton_Proton decoded_msg = proton_Proton_init_zero;
+  EXPECT_EQ(
+    proton_decode_dispatch(
+      &registry, raw, bytes_encoded, &decoded_msg, DispatchRecorder::on_bundle, &recorder),
+    PROTON_INCORRECT_TARGET_ERROR);
+  EXPECT_EQ(recorder.bundle_ids.size(), 1u);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, BundleSetStopsAtMtu)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  uint8_t single[BUFFER_SIZE];
+  size_t single_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(&registry, PROTON_BUNDLE_SHARED_1_ID, single, sizeof(single), &single_len),
+    PROTON_OK);
+
+  // Room for two bundles of the same size, plus the set header, but not three
+  size_t mtu = 2 + 2 * single_len + 1;
+  uint8_t raw[BUFFER_SIZE];
+  size_t bytes_encoded = 0;
+  proton_bundle_set_encoder_t encoder;
+  ASSERT_EQ(proton_bundle_set_init(&encoder, raw, sizeof(raw), mtu), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_2_ID), PROTON_OK);
+  EXPECT_EQ(
+    proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_1_ID),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(
+    proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_VALUE_TEST_ID),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  ASSERT_EQ(proton_bundle_set_finish(&encoder, &bytes_encoded), PROTON_OK);
+  EXPECT_EQ(bytes_encoded, 2 + 2 * single_len);
+  EXPECT_LE(bytes_encoded, mtu);
+
+  // A lone bundle larger than the MTU is still encoded
+  ASSERT_EQ(proton_bundle_set_init(&encoder, raw, sizeof(raw), 4), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+  EXPECT_EQ(
+    proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_1_ID),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  ASSERT_EQ(proton_bundle_set_finish(&encoder, &bytes_encoded), PROTON_OK);
+  EXPECT_GT(bytes_encoded, 4u);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+// -----------------------------------------------------------------------
+// Direct decode
+// -----------------------------------------------------------------------
+
+using SignalValues = std::vector<std::vector<uint8_t>>;
+
+static uint8_t * signal_value_data(signal_desc_t * desc)
+{
+  if (desc->type == PROTON_STRING || desc->type == PROTON_BYTES || proton_is_array_type(desc->type))
+  {
+    return static_cast<uint8_t *>(desc->signal.signal.string_value);
+  }
+  return reinterpret_cast<uint8_t *>(&desc->signal.signal);
+}
+
+/**
+ * Copy the value of every signal in the registry, to check what a decode wrote
+ */
+static SignalValues snapshot_signals(proton_registry_t * registry)
+{
+  SignalValues values;
+  for (size_t i = 0; i < registry->signal_count; i++)
+  {
+    signal_desc_t * desc = &registry->signal_registry[i];
+    const uint8_t * data = signal_value_data(desc);
+    values.emplace_back(data, data + desc->value_size);
+  }
+  return values;
+}
+
+static void restore_signals(proton_registry_t * registry, const SignalValues & values)
+{
+  for (size_t i = 0; i < registry->signal_count; i++)
+  {
+    signal_desc_t * desc = &registry->signal_registry[i];
+    memcpy(signal_value_data(desc), values[i].data(), values[i].size());
+    desc->value_size = values[i].size();
+  }
+}
+
+TEST(EncodeDecode, DecodeDirectNullPtrsAndGarbageReturnError)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  uint8_t garbage[] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+  EXPECT_EQ(
+    proton_decode_direct(nullptr, garbage, sizeof(garbage), nullptr, nullptr),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_decode_direct(&registry, nullptr, sizeof(garbage), nullptr, nullptr),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_decode_direct(&registry, garbage, sizeof(garbage), nullptr, nullptr),
+    PROTON_SERIALIZATION_ERROR);
+  // A message without an operation
+  EXPECT_EQ(
+    proton_decode_direct(&registry, garbage, 0, nullptr, nullptr),
+    PROTON_UNSUPPORTED_OPERATION_ERROR);
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, DecodeDirectMatchesNanopb)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  std::mt19937 rng(9012);
+
+  for (int iteration = 0; iteration < 100; iteration++)
+  {
+    for (size_t i = 0; i < registry.bundle_count; i++)
+    {
+      uint32_t bundle_id = registry.bundle_table[i].bundle_id;
+      randomize_signals(&registry, rng);
+      uint8_t raw[BUFFER_SIZE];
+      size_t bytes_encoded = 0;
+      ASSERT_EQ(
+        proton_encode_bundle_direct(&registry, bundle_id, raw, sizeof(raw), &bytes_encoded),
+        PROTON_OK);
+
+      // Decode into a registry holding other values with both decoders
+      randomize_signals(&registry, rng);
+      SignalValues before = snapshot_signals(&registry);
+      proton_Proton decoded_msg = proton_Proton_init_zero;
+      ASSERT_EQ(proton_decode(&registry, raw, bytes_encoded, &decoded_msg), PROTON_OK);
+      SignalValues expected = snapshot_signals(&registry);
+
+      restore_signals(&registry, before);
+      DispatchRecorder recorder;
+      ASSERT_EQ(
+        proton_decode_direct(&registry, raw, bytes_encoded, DispatchRecorder::on_bundle, &recorder),
+        PROTON_OK);
+      EXPECT_EQ(recorder.bundle_ids, std::vector<uint32_t>{bundle_id});
+      ASSERT_EQ(snapshot_signals(&registry), expected) << "bundle " << bundle_id;
+    }
+  }
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, DecodeDirectBundleSetDispatchesEachBundle)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  uint8_t raw[BUFFER_SIZE];
+  size_t bytes_encoded = 0;
+  proton_bundle_set_encoder_t encoder;
+  ASSERT_EQ(proton_bundle_set_init(&encoder, raw, sizeof(raw), 0), PROTON_OK);
+  ASSERT_EQ(proton_signal_set_int32(&registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, 42), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  ASSERT_EQ(proton_signal_set_int32(&registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, 84), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_add(&encoder, &registry, PROTON_BUNDLE_SHARED_2_ID), PROTON_OK);
+  ASSERT_EQ(proton_bundle_set_finish(&encoder, &bytes_encoded), PROTON_OK);
+
+  DispatchRecorder recorder;
+  ASSERT_EQ(
+    proton_decode_direct(&registry, raw, bytes_encoded, DispatchRecorder::on_bundle, &recorder),
+    PROTON_OK);
+  std::vector<uint32_t> expected_ids = {PROTON_BUNDLE_SHARED_1_ID, PROTON_BUNDLE_SHARED_2_ID};
+  EXPECT_EQ(recorder.bundle_ids, expected_ids);
+  std::vector<int32_t> expected_values = {42, 84};
+  EXPECT_EQ(recorder.shared_values, expected_values);
+
+  recorder = DispatchRecorder{};
+  recorder.result = PROTON_INCORRECT_TARGET_ERROR;
+  EXPECT_EQ(
+    proton_decode_direct(&registry, raw, bytes_encoded, DispatchRecorder::on_bundle, &recorder),
+    PROTON_INCORRECT_TARGET_ERROR);
+  EXPECT_EQ(recorder.bundle_ids.size(), 1u);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, DecodeDirectRejectedFrameLeavesRegistryUnchanged)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  std::mt19937 rng(3456);
+  const uint32_t bundle_id = PROTON_BUNDLE_VALUE_TEST_ID;
+  const bundle_desc_t * bundle = proton_registry_get_bundle(&registry, bundle_id, NULL);
+  ASSERT_NE(bundle, nullptr);
+
+  signal_desc_t * int32_desc = nullptr;
+  signal_desc_t * string_desc = nullptr;
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    signal_desc_t * desc = proton_registry_get_bundle_signal(&registry, bundle, i);
+    int32_desc = desc->type == PROTON_INT32 ? desc : int32_desc;
+    string_desc = desc->type == PROTON_STRING ? desc : string_desc;
+  }
+  ASSERT_NE(int32_desc, nullptr);
+  ASSERT_NE(string_desc, nullptr);
+
+  auto encode = [&](std::vector<uint8_t> & frame) {
+    frame.resize(BUFFER_SIZE);
+    size_t bytes_encoded = 0;
+    ASSERT_EQ(
+      proton_encode_bundle_direct(&registry, bundle_id, frame.data(), frame.size(), &bytes_encoded),
+      PROTON_OK);
+    frame.resize(bytes_encoded);
+  };
+
+  randomize_signals(&registry, rng);
+  ASSERT_EQ(proton_signal_set_string(&registry, string_desc->id, "value", 6), PROTON_OK);
+  std::vector<uint8_t> valid;
+  encode(valid);
+
+  // A signal sent with another type than registered, by the generic encoder which follows the
+  // type of the signal value rather than the bundle layout
+  std::vector<uint8_t> wrong_type;
+  bundle_desc_t * mutable_bundle = &registry.bundle_table[bundle - registry.bundle_table];
+  mutable_bundle->codec = nullptr;
+  int32_desc->signal.which_signal = proton_Signal_uint32_value_tag;
+  encode(wrong_type);
+  int32_desc->signal.which_signal = proton_Signal_int32_value_tag;
+  mutable_bundle->codec = g_proton_registry.bundle_table[bundle - registry.bundle_table].codec;
+
+  // A signal that is not part of the bundle, made by rewriting the ID field of the int32 signal.
+  // Both IDs are two byte varints.
+  std::vector<uint8_t> foreign_signal = valid;
+  auto id_field = [](uint32_t id) {
+    return std::vector<uint8_t>{
+      0x98, 0x01, static_cast<uint8_t>(0x80 | (id & 0x7F)), static_cast<uint8_t>(id >> 7)};
+  };
+  std::vector<uint8_t> int32_id = id_field(int32_desc->id);
+  std::vector<uint8_t> shared_id = id_field(PROTON_SIGNAL_SHARED_SIGNAL_ID);
+  auto id_pos = std::search(
+    foreign_signal.begin(), foreign_signal.end(), int32_id.begin(), int32_id.end());
+  ASSERT_NE(id_pos, foreign_signal.end());
+  std::copy(shared_id.begin(), shared_id.end(), id_pos);
+
+  randomize_signals(&registry, rng);
+  SignalValues before = snapshot_signals(&registry);
+
+  EXPECT_EQ(
+    proton_decode_direct(&registry, wrong_type.data(), wrong_type.size(), nullptr, nullptr),
+    PROTON_SERIALIZATION_ERROR);
+  EXPECT_EQ(snapshot_signals(&registry), before);
+
+  EXPECT_EQ(
+    proton_decode_direct(
+      &registry, foreign_signal.data(), foreign_signal.size(), nullptr, nullptr),
+    PROTON_SERIALIZATION_ERROR);
+  EXPECT_EQ(snapshot_signals(&registry), before);
+
+  // A string longer than the receiving signal can hold
+  size_t capacity = string_desc->capacity;
+  string_desc->capacity = 5;
+  EXPECT_EQ(
+    proton_decode_direct(&registry, valid.data(), valid.size(), nullptr, nullptr),
+    PROTON_SERIALIZATION_ERROR);
+  EXPECT_EQ(snapshot_signals(&registry), before);
+  string_desc->capacity = capacity;
+
+  // Every truncation of the frame, including ones that only drop whole signals
+  for (size_t len = 1; len < valid.size(); len++)
+  {
+    EXPECT_NE(proton_decode_direct(&registry, valid.data(), len, nullptr, nullptr), PROTON_OK)
+      << "length " << len;
+    ASSERT_EQ(snapshot_signals(&registry), before) << "length " << len;
+  }
+
+  ASSERT_EQ(
+    proton_decode_direct(&registry, valid.data(), valid.size(), nullptr, nullptr), PROTON_OK);
+  std::string decoded(static_cast<const char *>(string_desc->signal.signal.string_value));
+  EXPECT_EQ(decoded, "value");
+  EXPECT_EQ(string_desc->value_size, 6u);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+// -----------------------------------------------------------------------
+// Generated codecs
+// -----------------------------------------------------------------------
+
+/**
+ * Re-frame a single bundle message with an extra unknown field at the end of the bundle, which
+ * the generic decoders skip but the generated codecs do not expect
+ */
+static std::vector<uint8_t> append_unknown_bundle_field(const uint8_t * frame, size_t len)
+{
+  // Key, then a bundle length below 16384 bytes
+  size_t header_len = (frame[1] & 0x80) ? 3 : 2;
+  size_t bundle_len = (frame[1] & 0x7F) | ((header_len == 3) ? (frame[2] << 7) : 0);
+  EXPECT_EQ(header_len + bundle_len, len);
+
+  std::vector<uint8_t> out = {frame[0]};
+  size_t new_len = bundle_len + 2;
+  if (new_len >= 0x80)
+  {
+    out.push_back(static_cast<uint8_t>(0x80 | (new_len & 0x7F)));
+    out.push_back(static_cast<uint8_t>(new_len >> 7));
+  }
+  else
+  {
+    out.push_back(static_cast<uint8_t>(new_len));
+  }
+  out.insert(out.end(), frame + header_len, frame + len);
+  // Field 15, varint 1
+  out.push_back(0x78);
+  out.push_back(0x01);
+  return out;
+}
+
+TEST(EncodeDecode, GeneratedCodecsMatchGenericCodecs)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_registry_t generic = copy_default_registry(&g_proton_registry);
+  for (size_t i = 0; i < generic.bundle_count; i++)
+  {
+    ASSERT_NE(registry.bundle_table[i].codec, nullptr);
+    generic.bundle_table[i].codec = nullptr;
+  }
+  std::mt19937 rng(7890);
+
+  for (int iteration = 0; iteration < 100; iteration++)
+  {
+    for (size_t i = 0; i < registry.bundle_count; i++)
+    {
+      uint32_t bundle_id = registry.bundle_table[i].bundle_id;
+      randomize_signals(&registry, rng);
+      // Both copies share the string and bytes storage of the generated registry
+      memcpy(
+        generic.signal_registry, registry.signal_registry,
+        sizeof(signal_desc_t) * registry.signal_count);
+
+      uint8_t expected[BUFFER_SIZE];
+      size_t expected_len = 0;
+      ASSERT_EQ(
+        proton_encode_bundle_direct(
+          &generic, bundle_id, expected, sizeof(expected), &expected_len),
+        PROTON_OK);
+      uint8_t raw[BUFFER_SIZE];
+      size_t bytes_encoded = 0;
+      ASSERT_EQ(
+        registry.bundle_table[i].codec->encode(&registry, raw, sizeof(raw), &bytes_encoded),
+        PROTON_OK);
+      ASSERT_EQ(bytes_encoded, expected_len) << "bundle " << bundle_id;
+      ASSERT_EQ(memcmp(raw, expected, expected_len), 0) << "bundle " << bundle_id;
+      EXPECT_EQ(
+        registry.bundle_table[i].codec->encode(&registry, raw, expected_len - 1, &bytes_encoded),
+        PROTON_INSUFFICIENT_BUFFER_ERROR);
+
+      // The codec decodes what it encodes, and leaves anything else to the generic decoder
+      const bundle_desc_t * bundle = &registry.bundle_table[i];
+      auto expect_bundle_signals = [&](const SignalValues & expected_values) {
+        SignalValues values = snapshot_signals(&registry);
+        for (size_t j = 0; j < registry.signal_count; j++)
+        {
+          size_t slot = 0;
+          if (proton_bundle_get_signal_slot(bundle, registry.signal_registry[j].id, &slot))
+          {
+            EXPECT_EQ(values[j], expected_values[j]) << "signal " << registry.signal_registry[j].id;
+          }
+        }
+      };
+      SignalValues sent = snapshot_signals(&registry);
+      size_t header_len = (expected[1] & 0x80) ? 3 : 2;
+      randomize_signals(&registry, rng);
+      ASSERT_TRUE(
+        bundle->codec->decode(&registry, expected + header_len, expected_len - header_len));
+      expect_bundle_signals(sent);
+
+      randomize_signals(&registry, rng);
+      SignalValues before = snapshot_signals(&registry);
+      std::vector<uint8_t> unknown_field = append_unknown_bundle_field(expected, expected_len);
+      EXPECT_FALSE(bundle->codec->decode(
+        &registry, unknown_field.data() + header_len, unknown_field.size() - header_len));
+      ASSERT_EQ(snapshot_signals(&registry), before);
+      ASSERT_EQ(
+        proton_decode_direct(
+          &registry, unknown_field.data(), unknown_field.size(), nullptr, nullptr),
+        PROTON_OK);
+      expect_bundle_signals(sent);
+    }
+  }
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+  free(generic.signal_registry);
+  free(generic.bundle_table);
+}
+
+TEST(EncodeDecode, FlagsRoundTripPacksEveryBit)
+{
+  proton_registry_t sender = copy_default_registry(&g_proton_registry);
+  proton_registry_t receiver = copy_default_registry(&g_proton_registry);
+
+  for (uint8_t bit = 0; bit < PROTON_FLAGS_MAX_BITS; bit++)
+  {
+    ASSERT_EQ(
+      proton_signal_set_flag(&sender, PROTON_SIGNAL_STATUS_FLAGS_ID, bit, bit % 3 == 0), PROTON_OK);
+  }
+
+  uint8_t buffer[BUFFER_SIZE];
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &sender, PROTON_BUNDLE_FLAGS_TEST_ID, buffer, sizeof(buffer), &len),
+    PROTON_OK);
+  // Setting 64 flags only grows the single varint of the default value 5, where 64 bool signals
+  // would each need a Signal entry of at least 4 bytes
+  proton_registry_t defaults = copy_default_registry(&g_proton_registry);
+  uint8_t default_frame[BUFFER_SIZE];
+  size_t default_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &defaults, PROTON_BUNDLE_FLAGS_TEST_ID, default_frame, sizeof(default_frame), &default_len),
+    PROTON_OK);
+  EXPECT_LE(len, default_len + 9);
+  EXPECT_LT(len, 64u * 4u);
+
+  ASSERT_EQ(proton_decode_direct(&receiver, buffer, len, nullptr, nullptr), PROTON_OK);
+  for (uint8_t bit = 0; bit < PROTON_FLAGS_MAX_BITS; bit++)
+  {
+    bool flag = false;
+    ASSERT_EQ(
+      proton_signal_get_flag(&receiver, PROTON_SIGNAL_STATUS_FLAGS_ID, bit, &flag), PROTON_OK);
+    EXPECT_EQ(flag, bit % 3 == 0) << "bit " << static_cast<int>(bit);
+  }
+
+  free(sender.signal_registry);
+  free(sender.bundle_table);
+  free(receiver.signal_registry);
+  free(receiver.bundle_table);
+  free(defaults.signal_registry);
+  free(defaults.bundle_table);
+}
+
+TEST(EncodeDecode, ArrayRoundTripUsesPackedEncoding)
+{
+  proton_registry_t sender = copy_default_registry(&g_proton_registry);
+  proton_registry_t receiver = copy_default_registry(&g_proton_registry);
+
+  const double samples[] = {1.5, -0.25, 1e-3};
+  const int32_t ticks[] = {-1, 0, 300, INT32_MIN};
+  ASSERT_EQ(
+    proton_signal_set_double_array(&sender, PROTON_SIGNAL_IMU_SAMPLES_ID, samples, 3), PROTON_OK);
+  ASSERT_EQ(
+    proton_signal_set_int32_array(&sender, PROTON_SIGNAL_WHEEL_TICKS_ID, ticks, 4), PROTON_OK);
+
+  uint8_t buffer[BUFFER_SIZE];
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &sender, PROTON_BUNDLE_ARRAY_TEST_ID, buffer, sizeof(buffer), &len),
+    PROTON_OK);
+
+  // Each array is one key and length followed by its elements, doubles take 8 bytes each and
+  // negative int32 elements are sign extended to 10 byte varints like a repeated int32 field
+  const uint8_t doubles_head[] = {0x5A, sizeof(samples)};
+  const uint8_t * doubles = std::search(
+    buffer, buffer + len, std::begin(doubles_head), std::end(doubles_head));
+  ASSERT_NE(doubles, buffer + len);
+  double first = 0;
+  memcpy(&first, doubles + sizeof(doubles_head), sizeof(first));
+  EXPECT_EQ(first, 1.5);
+  const uint8_t ticks_head[] = {0x6A, 10 + 1 + 2 + 10};
+  EXPECT_NE(
+    std::search(buffer, buffer + len, std::begin(ticks_head), std::end(ticks_head)), buffer + len);
+
+  uint8_t nanopb[BUFFER_SIZE];
+  size_t nanopb_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(&sender, PROTON_BUNDLE_ARRAY_TEST_ID, nanopb, sizeof(nanopb), &nanopb_len),
+    PROTON_OK);
+  ASSERT_EQ(nanopb_len, len);
+  EXPECT_EQ(memcmp(nanopb, buffer, len), 0);
+
+  // The registries share their storage, so clear it before each decode
+  for (int decoder = 0; decoder < 2; decoder++)
+  {
+    ASSERT_EQ(
+      proton_signal_set_double_array(&receiver, PROTON_SIGNAL_IMU_SAMPLES_ID, nullptr, 0),
+      PROTON_OK);
+    const int32_t zeros[4] = {};
+    ASSERT_EQ(
+      proton_signal_set_int32_array(&receiver, PROTON_SIGNAL_WHEEL_TICKS_ID, zeros, 4), PROTON_OK);
+    if (decoder == 0)
+    {
+      ASSERT_EQ(proton_decode_direct(&receiver, buffer, len, nullptr, nullptr), PROTON_OK);
+    }
+    else
+    {
+      proton_Proton decoded_msg = proton_Proton_init_zero;
+      ASSERT_EQ(proton_decode(&receiver, buffer, len, &decoded_msg), PROTON_OK);
+    }
+
+    const double * samples_out = nullptr;
+    const int32_t * ticks_out = nullptr;
+    size_t count = 0;
+    ASSERT_EQ(
+      proton_signal_get_double_array(
+        &receiver, PROTON_SIGNAL_IMU_SAMPLES_ID, &samples_out, &count),
+      PROTON_OK);
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(memcmp(samples_out, samples, sizeof(samples)), 0);
+    ASSERT_EQ(
+      proton_signal_get_int32_array(&receiver, PROTON_SIGNAL_WHEEL_TICKS_ID, &ticks_out, &count),
+      PROTON_OK);
+    ASSERT_EQ(count, 4u);
+    EXPECT_EQ(memcmp(ticks_out, ticks, sizeof(ticks)), 0);
+  }
+
+  // More elements than the receiver holds are rejected
+  signal_desc_t * receiver_ticks =
+    proton_registry_get_signal(&receiver, PROTON_SIGNAL_WHEEL_TICKS_ID, nullptr);
+  receiver_ticks->capacity = 3 * sizeof(int32_t);
+  EXPECT_NE(proton_decode_direct(&receiver, buffer, len, nullptr, nullptr), PROTON_OK);
+  proton_Proton decoded_msg = proton_Proton_init_zero;
+  EXPECT_NE(proton_decode(&receiver, buffer, len, &decoded_msg), PROTON_OK);
+
+  free(sender.signal_registry);
+  free(sender.bundle_table);
+  free(receiver.signal_registry);
+  free(receiver.bundle_table);
+}
+
+TEST(EncodeDecode, ArrayTagsPast15UseTwoByteKeys)
+{
+  // Turn the double array into a uint64 array, whose field number 16 needs a two byte key. The
+  // generated codec of the bundle still expects doubles, so leave it out.
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  size_t slot = 0;
+  const_cast<bundle_desc_t *>(
+    proton_registry_get_bundle(&registry, PROTON_BUNDLE_ARRAY_TEST_ID, &slot))
+    ->codec = nullptr;
+  signal_desc_t * desc =
+    proton_registry_get_signal(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, nullptr);
+  desc->type = PROTON_UINT64_ARRAY;
+  desc->signal.which_signal = proton_Signal_uint64_array_value_tag;
+  const uint64_t values[] = {1, UINT64_MAX};
+  ASSERT_EQ(
+    proton_signal_set_uint64_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, values, 2), PROTON_OK);
+
+  uint8_t expected[BUFFER_SIZE];
+  size_t expected_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(
+      &registry, PROTON_BUNDLE_ARRAY_TEST_ID, expected, sizeof(expected), &expected_len),
+    PROTON_OK);
+  uint8_t buffer[BUFFER_SIZE];
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &registry, PROTON_BUNDLE_ARRAY_TEST_ID, buffer, sizeof(buffer), &len),
+    PROTON_OK);
+  ASSERT_EQ(len, expected_len);
+  EXPECT_EQ(memcmp(buffer, expected, len), 0);
+
+  const uint8_t head[] = {0x82, 0x01, 1 + 10};
+  EXPECT_NE(std::search(buffer, buffer + len, std::begin(head), std::end(head)), buffer + len);
+
+  ASSERT_EQ(
+    proton_signal_set_uint64_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, nullptr, 0),
+    PROTON_OK);
+  ASSERT_EQ(proton_decode_direct(&registry, buffer, len, nullptr, nullptr), PROTON_OK);
+  const uint64_t * decoded = nullptr;
+  size_t count = 0;
+  ASSERT_EQ(
+    proton_signal_get_uint64_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, &decoded, &count),
+    PROTON_OK);
+  ASSERT_EQ(count, 2u);
+  EXPECT_EQ(decoded[1], UINT64_MAX);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+// -----------------------------------------------------------------------
+// Lossy encodings
+// -----------------------------------------------------------------------
+
+TEST(EncodeDecode, HalfPrecisionConversionRoundsToNearestEven)
+{
+  EXPECT_EQ(proton_float_to_half(1.0f), 0x3C00);
+  EXPECT_EQ(proton_float_to_half(-2.0f), 0xC000);
+  EXPECT_EQ(proton_float_to_half(65504.0f), 0x7BFF);
+  // Past the largest half, the halfway point to the next exponent rounds up to infinity
+  EXPECT_EQ(proton_float_to_half(65519.0f), 0x7BFF);
+  EXPECT_EQ(proton_float_to_half(65520.0f), 0x7C00);
+  EXPECT_EQ(proton_float_to_half(-1e10f), 0xFC00);
+  // Ties go to the even mantissa
+  EXPECT_EQ(proton_float_to_half(1.0f + 0x1p-11f), 0x3C00);
+  EXPECT_EQ(proton_float_to_half(1.0f + 0x3p-11f), 0x3C02);
+  // Subnormals, down to the smallest half and the tie below it
+  EXPECT_EQ(proton_float_to_half(0x1p-24f), 0x0001);
+  EXPECT_EQ(proton_float_to_half(0x1p-25f), 0x0000);
+  EXPECT_EQ(proton_float_to_half(0x1.8p-25f), 0x0001);
+  EXPECT_EQ(proton_float_to_half(-0x1p-30f), 0x8000);
+  EXPECT_EQ(proton_float_to_half(0x1.ff8p-15f), 0x03FF);
+  EXPECT_EQ(proton_float_to_half(0x1.ffcp-15f), 0x0400);
+  EXPECT_EQ(proton_float_to_half(std::numeric_limits<float>::infinity()), 0x7C00);
+  uint16_t nan = proton_float_to_half(std::numeric_limits<float>::quiet_NaN());
+  EXPECT_EQ(nan & 0x7C00, 0x7C00);
+  EXPECT_NE(nan & 0x03FF, 0);
+
+  EXPECT_EQ(proton_half_to_float(0x0001), 0x1p-24f);
+  EXPECT_EQ(proton_half_to_float(0x7BFF), 65504.0f);
+  EXPECT_TRUE(std::isnan(proton_half_to_float(0x7E00)));
+
+  // Every half that is not a NaN converts to a float and back unchanged
+  for (uint32_t half = 0; half <= UINT16_MAX; half++)
+  {
+    if ((half & 0x7C00) == 0x7C00 && (half & 0x03FF) != 0)
+    {
+      continue;
+    }
+    ASSERT_EQ(proton_float_to_half(proton_half_to_float(static_cast<uint16_t>(half))), half);
+  }
+}
+
+TEST(EncodeDecode, QuantizeRoundsAndSaturates)
+{
+  const proton_signal_encoding_t encoding = {
+    .type = PROTON_ENCODING_QUANTIZED, .scale = 0.5, .offset = 10.0};
+  EXPECT_EQ(proton_quantize(&encoding, 10.0), 0);
+  EXPECT_EQ(proton_quantize(&encoding, 11.2), 2);
+  // Halfway values round away from zero
+  EXPECT_EQ(proton_quantize(&encoding, 10.25), 1);
+  EXPECT_EQ(proton_quantize(&encoding, 9.75), -1);
+  EXPECT_EQ(proton_quantize(&encoding, 1e300), INT64_MAX);
+  EXPECT_EQ(proton_quantize(&encoding, -1e300), INT64_MIN);
+  EXPECT_EQ(proton_quantize(&encoding, std::numeric_limits<double>::quiet_NaN()), 0);
+  EXPECT_EQ(proton_dequantize(&encoding, -3), 8.5);
+}
+
+TEST(EncodeDecode, EncodedSignalsRoundTripOnEveryPath)
+{
+  proton_registry_t sender = copy_default_registry(&g_proton_registry);
+  proton_registry_t receiver = copy_default_registry(&g_proton_registry);
+  ASSERT_EQ(
+    proton_signal_set_double(&sender, PROTON_SIGNAL_BATTERY_TEMPERATURE_ID, 23.456), PROTON_OK);
+  ASSERT_EQ(proton_signal_set_float(&sender, PROTON_SIGNAL_MOTOR_CURRENT_ID, 12.34f), PROTON_OK);
+  const float motor_current = proton_half_to_float(proton_float_to_half(12.34f));
+
+  uint8_t direct[BUFFER_SIZE];
+  size_t direct_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &sender, PROTON_BUNDLE_TELEMETRY_TEST_ID, direct, sizeof(direct), &direct_len),
+    PROTON_OK);
+  uint8_t nanopb[BUFFER_SIZE];
+  size_t nanopb_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(
+      &sender, PROTON_BUNDLE_TELEMETRY_TEST_ID, nanopb, sizeof(nanopb), &nanopb_len),
+    PROTON_OK);
+  ASSERT_EQ(nanopb_len, direct_len);
+  EXPECT_EQ(memcmp(nanopb, direct, direct_len), 0);
+
+  // quantized_value is field 17, with a two byte key, holding zigzag(6346)
+  const uint8_t quantized[] = {0x88, 0x01, 0x94, 0x63};
+  EXPECT_NE(
+    std::search(direct, direct + direct_len, std::begin(quantized), std::end(quantized)),
+    direct + direct_len);
+
+  uint8_t compact[BUFFER_SIZE];
+  size_t compact_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_compact(
+      &sender, PROTON_BUNDLE_TELEMETRY_TEST_ID, compact, sizeof(compact), &compact_len),
+    PROTON_OK);
+
+  for (int decoder = 0; decoder < 3; decoder++)
+  {
+    ASSERT_EQ(
+      proton_signal_set_double(&receiver, PROTON_SIGNAL_BATTERY_TEMPERATURE_ID, 0.0), PROTON_OK);
+    ASSERT_EQ(proton_signal_set_float(&receiver, PROTON_SIGNAL_MOTOR_CURRENT_ID, 0.0f), PROTON_OK);
+    if (decoder == 0)
+    {
+      ASSERT_EQ(proton_decode_direct(&receiver, direct, direct_len, nullptr, nullptr), PROTON_OK);
+    }
+    else if (decoder == 1)
+    {
+      proton_Proton decoded_msg = proton_Proton_init_zero;
+      ASSERT_EQ(proton_decode(&receiver, direct, direct_len, &decoded_msg), PROTON_OK);
+    }
+    else
+    {
+      ASSERT_EQ(
+        proton_decode_compact(&receiver, compact, compact_len, nullptr, nullptr), PROTON_OK);
+    }
+
+    double temperature = 0.0;
+    float current = 0.0f;
+    ASSERT_EQ(
+      proton_signal_get_double(&receiver, PROTON_SIGNAL_BATTERY_TEMPERATURE_ID, &temperature),
+      PROTON_OK);
+    ASSERT_EQ(
+      proton_signal_get_float(&receiver, PROTON_SIGNAL_MOTOR_CURRENT_ID, &current), PROTON_OK);
+    EXPECT_NEAR(temperature, 23.456, 0.005) << "decoder " << decoder;
+    EXPECT_EQ(current, motor_current) << "decoder " << decoder;
+  }
+
+  // Sent as they are, the same values take a fixed 12 bytes
+  for (size_t i = 0; i < sender.signal_count; i++)
+  {
+    sender.signal_registry[i].encoding = nullptr;
+  }
+  uint8_t native[BUFFER_SIZE];
+  size_t native_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_compact(
+      &sender, PROTON_BUNDLE_TELEMETRY_TEST_ID, native, sizeof(native), &native_len),
+    PROTON_OK);
+  EXPECT_EQ(native_len - compact_len, 12u - 5u);
+
+  free(sender.signal_registry);
+  free(sender.bundle_table);
+  free(receiver.signal_registry);
+  free(receiver.bundle_table);
+}
+
+TEST(EncodeDecode, EncodedValueForAnotherEncodingIsRejected)
+{
+  // A half_value sent for the quantized signal
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  signal_desc_t * desc =
+    proton_registry_get_signal(&registry, PROTON_SIGNAL_BATTERY_TEMPERATURE_ID, nullptr);
+  const proton_signal_encoding_t half = {
+    .type = PROTON_ENCODING_FLOAT16, .scale = 0.0, .offset = 0.0};
+  const proton_signal_encoding_t * quantized = desc->encoding;
+  size_t slot = 0;
+  const_cast<bundle_desc_t *>(
+    proton_registry_get_bundle(&registry, PROTON_BUNDLE_TELEMETRY_TEST_ID, &slot))
+    ->codec = nullptr;
+  desc->encoding = &half;
+
+  uint8_t buffer[BUFFER_SIZE];
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &registry, PROTON_BUNDLE_TELEMETRY_TEST_ID, buffer, sizeof(buffer), &len),
+    PROTON_OK);
+  desc->encoding = quantized;
+  SignalValues before = snapshot_signals(&registry);
+  EXPECT_NE(proton_decode_direct(&registry, buffer, len, nullptr, nullptr), PROTON_OK);
+  proton_Proton decoded_msg = proton_Proton_init_zero;
+  EXPECT_NE(proton_decode(&registry, buffer, len, &decoded_msg), PROTON_OK);
+  EXPECT_EQ(snapshot_signals(&registry), before);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+// -----------------------------------------------------------------------
+// Delta bundles
+// -----------------------------------------------------------------------
+
+/**
+ * Copy of the default registry whose delta bundle has its own sent_versions
+ */
+struct DeltaRegistry
+{
+  DeltaRegistry() : registry(copy_default_registry(&g_proton_registry))
+  {
+    size_t slot = 0;
+    bundle = const_cast<bundle_desc_t *>(
+      proton_registry_get_bundle(&registry, PROTON_BUNDLE_DELTA_BUNDLE_ID, &slot));
+    sent_versions.resize(bundle->signal_ids.count);
+    bundle->sent_versions = sent_versions.data();
+    bundle->sends_since_keyframe = 0;
+  }
+
+  ~DeltaRegistry()
+  {
+    free(registry.signal_registry);
+    free(registry.bundle_table);
+  }
+
+  std::vector<uint8_t> send()
+  {
+    std::vector<uint8_t> frame(BUFFER_SIZE);
+    size_t bytes_encoded = 0;
+    EXPECT_EQ(
+      proton_encode_bundle_direct(
+        &registry, bundle->bundle_id, frame.data(), frame.size(), &bytes_encoded),
+      PROTON_OK);
+    frame.resize(bytes_encoded);
+    proton_bundle_mark_sent(&registry, bundle);
+    return frame;
+  }
+
+  proton_registry_t registry;
+  bundle_desc_t * bundle;
+  std::vector<uint32_t> sent_versions;
+};
+
+TEST(EncodeDecode, SettersAndDecodesBumpSignalVersions)
+{
+  DeltaRegistry delta;
+  signal_desc_t * int32_desc =
+    proton_registry_get_signal(&delta.registry, PROTON_SIGNAL_INT32_VALUE_ID, NULL);
+  signal_desc_t * string_desc =
+    proton_registry_get_signal(&delta.registry, PROTON_SIGNAL_STRING_VALUE_ID, NULL);
+  uint32_t int32_version = int32_desc->version;
+  uint32_t string_version = string_desc->version;
+
+  ASSERT_EQ(proton_signal_set_int32(&delta.registry, PROTON_SIGNAL_INT32_VALUE_ID, 5), PROTON_OK);
+  EXPECT_EQ(int32_desc->version, int32_version + 1);
+  EXPECT_EQ(string_desc->version, string_version);
+  // A failed write leaves the version alone
+  EXPECT_NE(
+    proton_signal_set_float(&delta.registry, PROTON_SIGNAL_INT32_VALUE_ID, 1.0f), PROTON_OK);
+  EXPECT_EQ(int32_desc->version, int32_version + 1);
+
+  std::vector<uint8_t> frame = delta.send();
+  ASSERT_EQ(
+    proton_decode_direct(&delta.registry, frame.data(), frame.size(), nullptr, nullptr),
+    PROTON_OK);
+  EXPECT_EQ(int32_desc->version, int32_version + 2);
+  EXPECT_EQ(string_desc->version, string_version + 1);
+
+  proton_Proton msg = proton_Proton_init_zero;
+  ASSERT_EQ(proton_decode(&delta.registry, frame.data(), frame.size(), &msg), PROTON_OK);
+  EXPECT_EQ(int32_desc->version, int32_version + 3);
+  EXPECT_EQ(string_desc->version, string_version + 2);
+}
+
+TEST(EncodeDecode, DeltaBundleSendsChangedSignalsBetweenKeyframes)
+{
+  DeltaRegistry delta;
+  ASSERT_TRUE(delta.bundle->delta);
+  ASSERT_EQ(delta.bundle->keyframe_interval, 3);
+
+  ASSERT_TRUE(proton_bundle_keyframe_due(delta.bundle));
+  std::vector<uint8_t> keyframe = delta.send();
+  EXPECT_FALSE(proton_bundle_keyframe_due(delta.bundle));
+  EXPECT_FALSE(proton_bundle_signal_changed(&delta.registry, delta.bundle, 0));
+  EXPECT_FALSE(proton_bundle_signal_changed(&delta.registry, delta.bundle, 1));
+
+  // Nothing changed, only the bundle ID is sent
+  std::vector<uint8_t> empty = delta.send();
+  EXPECT_LT(empty.size(), keyframe.size());
+
+  ASSERT_EQ(proton_signal_set_int32(&delta.registry, PROTON_SIGNAL_INT32_VALUE_ID, 7), PROTON_OK);
+  EXPECT_TRUE(proton_bundle_signal_changed(&delta.registry, delta.bundle, 0));
+  EXPECT_FALSE(proton_bundle_signal_changed(&delta.registry, delta.bundle, 1));
+  std::vector<uint8_t> changed = delta.send();
+  EXPECT_GT(changed.size(), empty.size());
+  EXPECT_LT(changed.size(), keyframe.size());
+
+  // The interval is reached, the next send is full again
+  EXPECT_TRUE(proton_bundle_keyframe_due(delta.bundle));
+  std::vector<uint8_t> second_keyframe = delta.send();
+  EXPECT_EQ(second_keyframe.size(), keyframe.size());
+  EXPECT_EQ(delta.send(), empty);
+
+  // A requested keyframe is sent on the next send, then deltas resume
+  proton_registry_request_keyframe(&delta.registry, PROTON_BUNDLE_DELTA_BUNDLE_ID);
+  EXPECT_TRUE(proton_bundle_keyframe_due(delta.bundle));
+  EXPECT_EQ(delta.send().size(), keyframe.size());
+  EXPECT_EQ(delta.send(), empty);
+
+  // A keyframe matches what a full bundle encodes
+  proton_registry_request_keyframe(&delta.registry, PROTON_BUNDLE_DELTA_BUNDLE_ID);
+  std::vector<uint8_t> expected(BUFFER_SIZE);
+  size_t expected_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(
+      &delta.registry, PROTON_BUNDLE_DELTA_BUNDLE_ID, expected.data(), expected.size(),
+      &expected_len),
+    PROTON_OK);
+  expected.resize(expected_len);
+  EXPECT_EQ(delta.send(), expected);
+}
+
+TEST(EncodeDecode, DeltaBundleDecodeKeepsMissingSignals)
+{
+  DeltaRegistry sender;
+  ASSERT_EQ(proton_signal_set_int32(&sender.registry, PROTON_SIGNAL_INT32_VALUE_ID, 1), PROTON_OK);
+  ASSERT_EQ(
+    proton_signal_set_string(&sender.registry, PROTON_SIGNAL_STRING_VALUE_ID, "key", 4), PROTON_OK);
+  std::vector<uint8_t> keyframe = sender.send();
+  ASSERT_EQ(proton_signal_set_int32(&sender.registry, PROTON_SIGNAL_INT32_VALUE_ID, 2), PROTON_OK);
+  std::vector<uint8_t> partial = sender.send();
+  std::vector<uint8_t> empty = sender.send();
+
+  auto expect_values = [](proton_registry_t * registry, int32_t number, const char * text) {
+    int32_t value = 0;
+    ASSERT_EQ(proton_signal_get_int32(registry, PROTON_SIGNAL_INT32_VALUE_ID, &value), PROTON_OK);
+    EXPECT_EQ(value, number);
+    char str[16] = {};
+    size_t len = 0;
+    ASSERT_EQ(
+      proton_signal_get_string(registry, PROTON_SIGNAL_STRING_VALUE_ID, str, sizeof(str), &len),
+      PROTON_OK);
+    EXPECT_STREQ(str, text);
+  };
+
+  // Direct decode
+  DeltaRegistry receiver;
+  ASSERT_EQ(
+    proton_decode_direct(&receiver.registry, keyframe.data(), keyframe.size(), nullptr, nullptr),
+    PROTON_OK);
+  expect_values(&receiver.registry, 1, "key");
+  ASSERT_EQ(
+    proton_decode_direct(&receiver.registry, partial.data(), partial.size(), nullptr, nullptr),
+    PROTON_OK);
+  expect_values(&receiver.registry, 2, "key");
+  ASSERT_EQ(
+    proton_decode_direct(&receiver.registry, empty.data(), empty.size(), nullptr, nullptr),
+    PROTON_OK);
+  expect_values(&receiver.registry, 2, "key");
+
+  // Nanopb decode
+  ASSERT_EQ(
+    proton_signal_set_string(&receiver.registry, PROTON_SIGNAL_STRING_VALUE_ID, "old", 4),
+    PROTON_OK);
+  proton_Proton msg = proton_Proton_init_zero;
+  ASSERT_EQ(proton_decode(&receiver.registry, partial.data(), partial.size(), &msg), PROTON_OK);
+  expect_values(&receiver.registry, 2, "old");
+  ASSERT_EQ(proton_decode(&receiver.registry, keyframe.data(), keyframe.size(), &msg), PROTON_OK);
+  expect_values(&receiver.registry, 1, "key");
+  ASSERT_EQ(proton_decode(&receiver.registry, empty.data(), empty.size(), &msg), PROTON_OK);
+  expect_values(&receiver.registry, 1, "key");
+
+  // A bundle that is not a delta bundle must be sent whole
+  receiver.bundle->delta = false;
+  EXPECT_NE(
+    proton_decode_direct(&receiver.registry, partial.data(), partial.size(), nullptr, nullptr),
+    PROTON_OK);
+  EXPECT_NE(
+    proton_decode_direct(&receiver.registry, empty.data(), empty.size(), nullptr, nullptr),
+    PROTON_OK);
+  expect_values(&receiver.registry, 1, "key");
+  EXPECT_NE(proton_decode(&receiver.registry, partial.data(), partial.size(), &msg), PROTON_OK);
+}
+
+// -----------------------------------------------------------------------
+// Compact frames
+// -----------------------------------------------------------------------
+
+TEST(EncodeDecode, SchemaHashFieldIsAppendedAndRead)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  ASSERT_EQ(registry.schema_hash, PROTON_SCHEMA_HASH);
+  ASSERT_NE(registry.schema_hash, 0u);
+
+  uint8_t buffer[BUFFER_SIZE];
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &registry, PROTON_BUNDLE_VALUE_TEST_ID, buffer, sizeof(buffer), &len),
+    PROTON_OK);
+  uint32_t schema_hash = 0;
+  EXPECT_FALSE(proton_read_schema_hash(buffer, len, &schema_hash));
+
+  size_t advertised_len = len;
+  EXPECT_EQ(
+    proton_append_schema_hash(buffer, len + 4, &advertised_len, registry.schema_hash),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(advertised_len, len);
+  ASSERT_EQ(
+    proton_append_schema_hash(buffer, sizeof(buffer), &advertised_len, registry.schema_hash),
+    PROTON_OK);
+  EXPECT_EQ(advertised_len, len + PROTON_SCHEMA_HASH_FIELD_LEN);
+  ASSERT_TRUE(proton_read_schema_hash(buffer, advertised_len, &schema_hash));
+  EXPECT_EQ(schema_hash, registry.schema_hash);
+
+  // Both decoders skip the advertisement
+  DispatchRecorder recorder;
+  EXPECT_EQ(
+    proton_decode_direct(&registry, buffer, advertised_len, DispatchRecorder::on_bundle, &recorder),
+    PROTON_OK);
+  EXPECT_EQ(recorder.bundle_ids, std::vector<uint32_t>{PROTON_BUNDLE_VALUE_TEST_ID});
+  proton_Proton msg = proton_Proton_init_zero;
+  EXPECT_EQ(proton_decode(&registry, buffer, advertised_len, &msg), PROTON_OK);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(EncodeDecode, CompactRoundTripMatchesDirect)
+{
+  std::mt19937 rng(12);
+  proton_registry_t sender = copy_default_registry(&g_proton_registry);
+  proton_registry_t compact = copy_default_registry(&g_proton_registry);
+  proton_registry_t direct = copy_default_registry(&g_proton_registry);
+
+  for (int i = 0; i < 50; i++)
+  {
+    randomize_signals(&sender, rng);
+
+    uint8_t compact_frame[BUFFER_SIZE];
+    uint8_t direct_frame[BUFFER_SIZE];
+    size_t compact_len = 0;
+    size_t direct_len = 0;
+    ASSERT_EQ(
+      proton_encode_bundle_compact(
+        &sender, PROTON_BUNDLE_VALUE_TEST_ID, compact_frame, sizeof(compact_frame), &compact_len),
+      PROTON_OK);
+    ASSERT_EQ(
+      proton_encode_bundle_direct(
+        &sender, PROTON_BUNDLE_VALUE_TEST_ID, direct_frame, sizeof(direct_frame), &direct_len),
+      PROTON_OK);
+    EXPECT_LT(compact_len, direct_len);
+
+    DispatchRecorder recorder;
+    ASSERT_EQ(
+      proton_decode_compact(
+        &compact, compact_frame, compact_len, DispatchRecorder::on_bundle, &recorder),
+      PROTON_OK);
+    EXPECT_EQ(recorder.bundle_ids, std::vector<uint32_t>{PROTON_BUNDLE_VALUE_TEST_ID});
+    ASSERT_EQ(
+      proton_decode_direct(&direct, direct_frame, direct_len, nullptr, nullptr), PROTON_OK);
+    EXPECT_EQ(snapshot_signals(&compact), snapshot_signals(&direct));
+  }
+
+  free(sender.signal_registry);
+  free(sender.bundle_table);
+  free(compact.signal_registry);
+  free(compact.bundle_table);
+  free(direct.signal_registry);
+  free(direct.bundle_table);
+}
+
+TEST(EncodeDecode, CompactFrameRejectedWithoutTouchingRegistry)
+{
+  std::mt19937 rng(13);
+  proton_registry_t sender = copy_default_registry(&g_proton_registry);
+  proton_registry_t receiver = copy_default_registry(&g_proton_registry);
+  randomize_signals(&sender, rng);
+
+  uint8_t frame[BUFFER_SIZE];
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_compact(
+      &sender, PROTON_BUNDLE_VALUE_TEST_ID, frame, sizeof(frame), &len),
+    PROTON_OK);
+  SignalValues before = snapshot_signals(&receiver);
+
+  // Another schema
+  receiver.schema_hash ^= 1;
+  EXPECT_EQ(
+    proton_decode_compact(&receiver, frame, len, nullptr, nullptr), PROTON_SCHEMA_MISMATCH_ERROR);
+  receiver.schema_hash = 0;
+  EXPECT_EQ(
+    proton_decode_compact(&receiver, frame, len, nullptr, nullptr), PROTON_SCHEMA_MISMATCH_ERROR);
+  receiver.schema_hash = sender.schema_hash;
+  EXPECT_EQ(snapshot_signals(&receiver), before);
+
+  // Truncated frames
+  for (size_t cut = 1; cut < len; cut++)
+  {
+    EXPECT_NE(proton_decode_compact(&receiver, frame, cut, nullptr, nullptr), PROTON_OK) << cut;
+  }
+  EXPECT_EQ(snapshot_signals(&receiver), before);
+
+  // A truncated bundle after a complete one, which is kept as in a bundle set
+  frame[len] = 0xFF;
+  EXPECT_NE(proton_decode_compact(&receiver, frame, len + 1, nullptr, nullptr), PROTON_OK);
+
+  // Compact frames need a schema hash
+  sender.schema_hash = 0;
+  EXPECT_EQ(
+    proton_encode_bundle_compact(
+      &sender, PROTON_BUNDLE_VALUE_TEST_ID, frame, sizeof(frame), &len),
+    PROTON_UNSUPPORTED_OPERATION_ERROR);
+
+  free(sender.signal_registry);
+  free(sender.bundle_table);
+  free(receiver.signal_registry);
+  free(receiver.bundle_table);
+}
+
+TEST(EncodeDecode, CompactDeltaBundleSendsChangedSignals)
+{
+  DeltaRegistry sender;
+  DeltaRegistry receiver;
+  auto send = [&sender]()
+  {
+    std::vector<uint8_t> frame(BUFFER_SIZE);
+    size_t len = 0;
+    EXPECT_EQ(
+      proton_encode_bundle_compact(
+        &sender.registry, PROTON_BUNDLE_DELTA_BUNDLE_ID, frame.data(), frame.size(), &len),
+      PROTON_OK);
+    frame.resize(len);
+    proton_bundle_mark_sent(&sender.registry, sender.bundle);
+    return frame;
+  };
+
+  ASSERT_EQ(proton_signal_set_int32(&sender.registry, PROTON_SIGNAL_INT32_VALUE_ID, -3), PROTON_OK);
+  ASSERT_EQ(
+    proton_signal_set_string(&sender.registry, PROTON_SIGNAL_STRING_VALUE_ID, "key", 4), PROTON_OK);
+  std::vector<uint8_t> keyframe = send();
+  // Hash, bundle ID and a bitmap with nothing set
+  std::vector<uint8_t> empty = send();
+  EXPECT_EQ(
+    empty.size(),
+    PROTON_COMPACT_HEADER_LEN + proton_varint_size(PROTON_BUNDLE_DELTA_BUNDLE_ID) + 1);
+  EXPECT_EQ(empty.back(), 0x00);
+  ASSERT_EQ(proton_signal_set_int32(&sender.registry, PROTON_SIGNAL_INT32_VALUE_ID, 9), PROTON_OK);
+  std::vector<uint8_t> partial = send();
+
+  for (const auto & frame : {keyframe, empty, partial})
+  {
+    ASSERT_EQ(
+      proton_decode_compact(&receiver.registry, frame.data(), frame.size(), nullptr, nullptr),
+      PROTON_OK);
+  }
+  int32_t number = 0;
+  ASSERT_EQ(
+    proton_signal_get_int32(&receiver.registry, PROTON_SIGNAL_INT32_VALUE_ID, &number), PROTON_OK);
+  EXPECT_EQ(number, 9);
+  char str[16] = {};
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_signal_get_string(
+      &receiver.registry, PROTON_SIGNAL_STRING_VALUE_ID, str, sizeof(str), &len),
+    PROTON_OK);
+  EXPECT_STREQ(str, "key");
+
+  // A bundle that is not a delta bundle has no bitmap
+  receiver.bundle->delta = false;
+  EXPECT_NE(
+    proton_decode_compact(&receiver.registry, partial.data(), partial.size(), nullptr, nullptr),
+    PROTON_OK);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
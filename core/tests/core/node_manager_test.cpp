@@ -23,7 +23,10 @@
 #include "utils.hpp"
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstring>
+#include <random>
+#include <vector>
 
 extern proton_registry_t g_proton_registry;
 extern proton_node_t g_target_node;
@@ -44,6 +47,7 @@ protected:
       g_proton_registry.bundle_table[i].last_send_ms = 0;
       g_proton_registry.bundle_table[i].send_now = false;
       g_proton_registry.bundle_table[i].callback = {NULL, NULL};
+      g_proton_registry.bundle_table[i].sends_since_keyframe = 0;
     }
     registry_ = copy_default_registry(&g_proton_registry);
     node_ = copy_default_node(&g_target_node);
@@ -543,6 +547,45 @@ TEST_F(NodeManagerTest, EncodeBundle_RoundTrip_WithReceive_SignalValuePreserved)
   EXPECT_FLOAT_EQ(received, SENT_VALUE);
 }
 
+TEST_F(NodeManagerTest, EncodeBundle_DeltaBundle_SendsChangedSignalsBetweenKeyframes)
+{
+  uint8_t full[BUFFER_SIZE];
+  uint8_t buf[BUFFER_SIZE];
+  size_t full_len = 0;
+  size_t out_len = 0;
+  proton_endpoint_t dest[1];
+  size_t num_peers = 0;
+  auto encode = [&](uint8_t * out, size_t * len) {
+    ASSERT_EQ(
+      proton_node_encode_bundle(
+        &node_, PROTON_BUNDLE_DELTA_BUNDLE_ID, 0, out, BUFFER_SIZE, len, dest, 1, &num_peers),
+      PROTON_OK);
+  };
+
+  constexpr int32_t SENT_VALUE = -17;
+  ASSERT_EQ(proton_signal_set_int32(&registry_, PROTON_SIGNAL_INT32_VALUE_ID, 0), PROTON_OK);
+  encode(full, &full_len);
+
+  // The node marked the bundle as sent, so only the changed signal goes out next
+  ASSERT_EQ(
+    proton_signal_set_int32(&registry_, PROTON_SIGNAL_INT32_VALUE_ID, SENT_VALUE), PROTON_OK);
+  encode(buf, &out_len);
+  EXPECT_LT(out_len, full_len);
+
+  ASSERT_EQ(proton_signal_set_int32(&registry_, PROTON_SIGNAL_INT32_VALUE_ID, 0), PROTON_OK);
+  ASSERT_EQ(proton_node_receive(&node_, buf, out_len), PROTON_OK);
+  int32_t received = 0;
+  ASSERT_EQ(
+    proton_signal_get_int32(&registry_, PROTON_SIGNAL_INT32_VALUE_ID, &received), PROTON_OK);
+  EXPECT_EQ(received, SENT_VALUE);
+
+  ASSERT_EQ(proton_signal_set_int32(&registry_, PROTON_SIGNAL_INT32_VALUE_ID, 0), PROTON_OK);
+  proton_registry_request_keyframe(&registry_, PROTON_BUNDLE_DELTA_BUNDLE_ID);
+  encode(buf, &out_len);
+  ASSERT_EQ(out_len, full_len);
+  EXPECT_EQ(memcmp(buf, full, full_len), 0);
+}
+
 // -----------------------------------------------------------------------
 // proton_node_trigger_bundle — null-pointer guards
 // -----------------------------------------------------------------------
@@ -639,6 +682,36 @@ TEST_F(NodeManagerTest, Update_QueueTriggeredBundle_IsPrioritizedOverDefault)
   EXPECT_FALSE(node_.registry->bundle_table[0].send_now);
 }
 
+TEST_F(NodeManagerTest, Update_TriggeredBundleWithoutPeerSlotsStaysScheduled)
+{
+  // Give value_test (slot 0) a second consumer, so that a single peer slot is not enough
+  const uint32_t consumers[] = {PROTON_NODE_CONSUMER_ID, PROTON_NODE_UNUSED_CONSUMER_ID};
+  registry_.bundle_table[0].consumer_ids = {consumers, 2};
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+
+  uint8_t buf[BUFFER_SIZE];
+  size_t out_len = 0;
+  proton_endpoint_t dest[2];
+  size_t num_peers = 0;
+  ASSERT_EQ(
+    proton_node_update(&node_, 10, buf, sizeof(buf), &out_len, dest, 1, &num_peers),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(registry_.bundle_table[0].last_send_ms, 0ULL);
+
+  // The trigger survived the failed update
+  ASSERT_EQ(
+    proton_node_update(&node_, 20, buf, sizeof(buf), &out_len, dest, 2, &num_peers), PROTON_OK);
+  EXPECT_GT(out_len, 0u);
+  EXPECT_EQ(registry_.bundle_table[0].last_send_ms, 20ULL);
+  EXPECT_FALSE(registry_.bundle_table[0].send_now);
+
+  // And later triggers are not ignored
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+  ASSERT_EQ(
+    proton_node_update(&node_, 30, buf, sizeof(buf), &out_len, dest, 2, &num_peers), PROTON_OK);
+  EXPECT_EQ(registry_.bundle_table[0].last_send_ms, 30ULL);
+}
+
 // -----------------------------------------------------------------------
 // Round-trip: proton_node_update → proton_node_receive
 // -----------------------------------------------------------------------
@@ -981,8 +1054,726 @@ TEST_F(NodeManagerTest, EncodeBundle_MutexUnlocksOnIncorrectTarget)
   EXPECT_TRUE(unlock_called_);
 }
 
+// -----------------------------------------------------------------------
+// Scheduler tests
+// -----------------------------------------------------------------------
+
+// The deadline-ordered scheduler must select exactly the bundles the full table scan would. Drive two
+// copies of the node with the same random sequence of triggers, period changes and direct encodes, one
+// with scheduler storage and one without, and compare every update.
+TEST_F(NodeManagerTest, Scheduler_MatchesLinearScan)
+{
+  ASSERT_NE(node_.scheduler.heap, nullptr);
+
+  proton_registry_t linear_registry = copy_default_registry(&g_proton_registry);
+  proton_node_t linear_node = copy_default_node(&g_target_node);
+  linear_node.registry = &linear_registry;
+  linear_node.scheduler.heap = nullptr;
+  linear_node.scheduler.triggered = nullptr;
+
+  std::mt19937 rng(1234);
+  auto random_bundle = [&]() {
+    return node_.registry->bundle_table[rng() % node_.registry->bundle_count].bundle_id;
+  };
+
+  for (size_t i = 0; i < node_.registry->bundle_count; i++)
+  {
+    uint32_t id = node_.registry->bundle_table[i].bundle_id;
+    uint32_t period = 20 + 10 * (rng() % 8);
+    proton_registry_set_bundle_period(node_.registry, id, period);
+    proton_registry_set_bundle_period(&linear_registry, id, period);
+  }
+
+  uint8_t buf[BUFFER_SIZE];
+  uint8_t linear_buf[BUFFER_SIZE];
+  proton_endpoint_t dest[4];
+  proton_endpoint_t linear_dest[4];
+  uint64_t uptime_ms = 0;
+  size_t sent = 0;
+
+  for (int step = 0; step < 5000; step++)
+  {
+    uptime_ms += rng() % 25;
+
+    switch (rng() % 12)
+    {
+      case 0:
+      case 1:
+      {
+        uint32_t id = random_bundle();
+        EXPECT_EQ(
+          proton_node_trigger_bundle(&node_, id), proton_node_trigger_bundle(&linear_node, id));
+        break;
+      }
+      case 2:
+      {
+        uint32_t id = random_bundle();
+        uint32_t period = (rng() % 4 == 0) ? 0 : 10 + rng() % 100;
+        proton_registry_set_bundle_period(node_.registry, id, period);
+        proton_registry_set_bundle_period(&linear_registry, id, period);
+        break;
+      }
+      case 3:
+      {
+        uint32_t id = random_bundle();
+        size_t len = 0;
+        size_t linear_len = 0;
+        size_t peers = 0;
+        size_t linear_peers = 0;
+        EXPECT_EQ(
+          proton_node_encode_bundle(&node_, id, uptime_ms, buf, sizeof(buf), &len, dest, 4, &peers),
+          proton_node_encode_bundle(
+            &linear_node, id, uptime_ms, linear_buf, sizeof(linear_buf), &linear_len, linear_dest,
+            4, &linear_peers));
+        break;
+      }
+      default:
+        break;
+    }
+
+    size_t out_len = 0;
+    size_t linear_out_len = 0;
+    size_t num_peers = 0;
+    size_t linear_num_peers = 0;
+    ASSERT_EQ(
+      proton_node_update(&node_, uptime_ms, buf, sizeof(buf), &out_len, dest, 4, &num_peers),
+      proton_node_update(
+        &linear_node, uptime_ms, linear_buf, sizeof(linear_buf), &linear_out_len, linear_dest, 4,
+        &linear_num_peers));
+    ASSERT_EQ(out_len, linear_out_len) << "step " << step;
+    ASSERT_EQ(num_peers, linear_num_peers) << "step " << step;
+    ASSERT_EQ(memcmp(buf, linear_buf, out_len), 0) << "step " << step;
+    sent += out_len > 0 ? 1 : 0;
+
+    for (size_t i = 0; i < node_.registry->bundle_count; i++)
+    {
+      ASSERT_EQ(
+        node_.registry->bundle_table[i].last_send_ms, linear_registry.bundle_table[i].last_send_ms)
+        << "step " << step << " slot " << i;
+      ASSERT_EQ(node_.registry->bundle_table[i].send_now, linear_registry.bundle_table[i].send_now)
+        << "step " << step << " slot " << i;
+    }
+  }
+
+  // Make sure the sequence actually exercised the scheduler
+  EXPECT_GT(sent, 1000u);
+
+  free(linear_registry.signal_registry);
+  free(linear_registry.bundle_table);
+  free(const_cast<proton_endpoint_t *>(linear_node.destination_peers));
+}
+
+// Writing bundle timing state directly requires a scheduler reset once the schedule is built.
+TEST_F(NodeManagerTest, Scheduler_ResetPicksUpDirectWrites)
+{
+  uint8_t buf[BUFFER_SIZE];
+  size_t out_len = 0;
+  proton_endpoint_t dest[1];
+  size_t num_peers = 0;
+
+  size_t slot = 0;
+  ASSERT_NE(
+    proton_registry_get_bundle(node_.registry, PROTON_BUNDLE_PERIODIC_BUNDLE_ID, &slot), nullptr);
+  bundle_desc_t * periodic = &node_.registry->bundle_table[slot];
+
+  // Build the schedule, nothing is due yet
+  ASSERT_EQ(
+    proton_node_update(&node_, 10, buf, sizeof(buf), &out_len, dest, 1, &num_peers), PROTON_OK);
+  EXPECT_EQ(out_len, 0u);
+  EXPECT_TRUE(node_.scheduler.initialized);
+
+  // Pull the deadline forward behind the scheduler's back
+  periodic->last_send_ms = 0;
+  periodic->period_ms = 5;
+  proton_node_reset_scheduler(&node_);
+  EXPECT_FALSE(node_.scheduler.initialized);
+
+  ASSERT_EQ(
+    proton_node_update(&node_, 10, buf, sizeof(buf), &out_len, dest, 1, &num_peers), PROTON_OK);
+  EXPECT_GT(out_len, 0u);
+  EXPECT_EQ(periodic->last_send_ms, 10u);
+}
+
+TEST_F(NodeManagerTest, NextDeadline_NullPtrs_ReturnNullPtrError)
+{
+  uint64_t deadline = 0;
+  bool has_deadline = false;
+  EXPECT_EQ(
+    proton_node_next_deadline(nullptr, 0, &deadline, &has_deadline), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(proton_node_next_deadline(&node_, 0, nullptr, &has_deadline), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(proton_node_next_deadline(&node_, 0, &deadline, nullptr), PROTON_NULL_PTR_ERROR);
+}
+
+TEST_F(NodeManagerTest, NextDeadline_TriggeredBundleIsDueNow)
+{
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+
+  uint64_t deadline = 0;
+  bool has_deadline = false;
+  ASSERT_EQ(proton_node_next_deadline(&node_, 1234, &deadline, &has_deadline), PROTON_OK);
+  EXPECT_TRUE(has_deadline);
+  EXPECT_EQ(deadline, 1234u);
+}
+
+// Sleeping until the reported deadline must never miss a send nor wake up early, with or without
+// the scheduler.
+TEST_F(NodeManagerTest, NextDeadline_MatchesUpdate)
+{
+  proton_registry_t linear_registry = copy_default_registry(&g_proton_registry);
+  proton_node_t linear_node = copy_default_node(&g_target_node);
+  linear_node.registry = &linear_registry;
+  linear_node.scheduler.heap = nullptr;
+  linear_node.scheduler.triggered = nullptr;
+
+  for (proton_node_t * node : {&node_, &linear_node})
+  {
+    uint8_t buf[BUFFER_SIZE];
+    proton_endpoint_t dest[4];
+    size_t num_peers = 0;
+    uint64_t now = 1000;
+    size_t sends = 0;
+
+    while (now < 5000)
+    {
+      uint64_t deadline = 0;
+      bool has_deadline = false;
+      ASSERT_EQ(proton_node_next_deadline(node, now, &deadline, &has_deadline), PROTON_OK);
+      ASSERT_TRUE(has_deadline);
+
+      size_t out_len = 0;
+      if (deadline > now)
+      {
+        ASSERT_EQ(
+          proton_node_update(node, deadline - 1, buf, sizeof(buf), &out_len, dest, 4, &num_peers),
+          PROTON_OK);
+        EXPECT_EQ(out_len, 0u);
+        now = deadline;
+      }
+
+      ASSERT_EQ(
+        proton_node_update(node, now, buf, sizeof(buf), &out_len, dest, 4, &num_peers), PROTON_OK);
+      EXPECT_GT(out_len, 0u);
+      sends++;
+    }
+    EXPECT_GT(sends, 1u);
+  }
+
+  free(linear_registry.signal_registry);
+  free(linear_registry.bundle_table);
+}
+
+// -----------------------------------------------------------------------
+// proton_node_update_batch
+// -----------------------------------------------------------------------
+
+TEST_F(NodeManagerTest, UpdateBatch_NullPtrs_ReturnNullPtrError)
+{
+  uint8_t buf[BUFFER_SIZE];
+  proton_bundle_record_t records[4];
+  size_t num_records = 0;
+  proton_endpoint_t dest[4];
+
+  EXPECT_EQ(
+    proton_node_update_batch(nullptr, 0, buf, sizeof(buf), records, 4, &num_records, dest, 4),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_batch(&node_, 0, nullptr, sizeof(buf), records, 4, &num_records, dest, 4),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_batch(&node_, 0, buf, sizeof(buf), nullptr, 4, &num_records, dest, 4),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_batch(&node_, 0, buf, sizeof(buf), records, 4, nullptr, dest, 4),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_batch(&node_, 0, buf, sizeof(buf), records, 4, &num_records, nullptr, 4),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_batch(&node_, 0, buf, sizeof(buf), records, 0, &num_records, dest, 4),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+}
+
+TEST_F(NodeManagerTest, UpdateBatch_NothingDue_ReturnsNoRecords)
+{
+  uint8_t buf[BUFFER_SIZE];
+  proton_bundle_record_t records[4];
+  size_t num_records = 1;
+  proton_endpoint_t dest[4];
+
+  ASSERT_EQ(
+    proton_node_update_batch(&node_, 10, buf, sizeof(buf), records, 4, &num_records, dest, 4),
+    PROTON_OK);
+  EXPECT_EQ(num_records, 0u);
+}
+
+// A batch must emit the same bundles, in the same order and with the same bytes, as calling
+// proton_node_update until nothing is left to send.
+TEST_F(NodeManagerTest, UpdateBatch_MatchesRepeatedUpdate)
+{
+  proton_registry_t single_registry = copy_default_registry(&g_proton_registry);
+  proton_node_t single_node = copy_default_node(&g_target_node);
+  single_node.registry = &single_registry;
+
+  for (proton_node_t * node : {&node_, &single_node})
+  {
+    ASSERT_EQ(proton_node_trigger_bundle(node, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+    ASSERT_EQ(proton_node_trigger_bundle(node, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  }
+
+  constexpr uint64_t UPTIME_MS = 1000;
+  uint8_t buf[BUFFER_SIZE * 4];
+  proton_bundle_record_t records[8];
+  size_t num_records = 0;
+  proton_endpoint_t dest[8];
+  ASSERT_EQ(
+    proton_node_update_batch(
+      &node_, UPTIME_MS, buf, sizeof(buf), records, 8, &num_records, dest, 8),
+    PROTON_OK);
+
+  // Two triggered bundles plus the due periodic bundle
+  ASSERT_EQ(num_records, 3u);
+
+  size_t expected_offset = 0;
+  for (size_t i = 0; i < num_records; i++)
+  {
+    uint8_t single_buf[BUFFER_SIZE];
+    size_t out_len = 0;
+    proton_endpoint_t single_dest[4];
+    size_t num_peers = 0;
+    ASSERT_EQ(
+      proton_node_update(
+        &single_node, UPTIME_MS, single_buf, sizeof(single_buf), &out_len, single_dest, 4,
+        &num_peers),
+      PROTON_OK);
+
+    EXPECT_EQ(records[i].offset, expected_offset);
+    ASSERT_EQ(records[i].length, out_len);
+    EXPECT_EQ(memcmp(&buf[records[i].offset], single_buf, out_len), 0);
+    ASSERT_EQ(records[i].num_peers, num_peers);
+    for (size_t p = 0; p < num_peers; p++)
+    {
+      EXPECT_EQ(records[i].peers[p].node_id, single_dest[p].node_id);
+      EXPECT_EQ(records[i].peers[p].endpoint_id, single_dest[p].endpoint_id);
+    }
+
+    size_t slot = 0;
+    ASSERT_NE(proton_registry_get_bundle(&registry_, records[i].bundle_id, &slot), nullptr);
+    EXPECT_EQ(registry_.bundle_table[slot].last_send_ms, UPTIME_MS);
+    expected_offset += records[i].length;
+  }
+
+  // Both nodes have nothing left to send
+  size_t out_len = 0;
+  uint8_t single_buf[BUFFER_SIZE];
+  proton_endpoint_t single_dest[4];
+  size_t num_peers = 0;
+  ASSERT_EQ(
+    proton_node_update(
+      &single_node, UPTIME_MS, single_buf, sizeof(single_buf), &out_len, single_dest, 4,
+      &num_peers),
+    PROTON_OK);
+  EXPECT_EQ(out_len, 0u);
+  ASSERT_EQ(
+    proton_node_update_batch(
+      &node_, UPTIME_MS, buf, sizeof(buf), records, 8, &num_records, dest, 8),
+    PROTON_OK);
+  EXPECT_EQ(num_records, 0u);
+
+  free(single_registry.signal_registry);
+  free(single_registry.bundle_table);
+  free(const_cast<proton_endpoint_t *>(single_node.destination_peers));
+}
+
+TEST_F(NodeManagerTest, UpdateBatch_BundlesThatDoNotFitStayScheduled)
+{
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+
+  uint8_t buf[BUFFER_SIZE];
+  proton_bundle_record_t records[8];
+  size_t num_records = 0;
+  proton_endpoint_t dest[8];
+
+  // Only room for one record
+  ASSERT_EQ(
+    proton_node_update_batch(&node_, 10, buf, sizeof(buf), records, 1, &num_records, dest, 8),
+    PROTON_OK);
+  ASSERT_EQ(num_records, 1u);
+  uint32_t first_id = records[0].bundle_id;
+
+  size_t first_length = records[0].length;
+
+  // The other triggered bundle was left scheduled
+  ASSERT_EQ(
+    proton_node_update_batch(&node_, 20, buf, sizeof(buf), records, 8, &num_records, dest, 8),
+    PROTON_OK);
+  ASSERT_EQ(num_records, 1u);
+  uint32_t second_id = records[0].bundle_id;
+  size_t second_length = records[0].length;
+  EXPECT_NE(second_id, first_id);
+
+  // Only room for the bytes of the most overdue bundle
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, first_id), PROTON_OK);
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, second_id), PROTON_OK);
+  ASSERT_EQ(
+    proton_node_update_batch(
+      &node_, 30, buf, first_length + second_length - 1, records, 8, &num_records, dest, 8),
+    PROTON_OK);
+  ASSERT_EQ(num_records, 1u);
+  EXPECT_EQ(records[0].bundle_id, first_id);
+
+  // The bundle that did not fit is still sent afterwards
+  ASSERT_EQ(
+    proton_node_update_batch(&node_, 40, buf, sizeof(buf), records, 8, &num_records, dest, 8),
+    PROTON_OK);
+  ASSERT_EQ(num_records, 1u);
+  EXPECT_EQ(records[0].bundle_id, second_id);
+  ASSERT_EQ(
+    proton_node_update_batch(&node_, 50, buf, sizeof(buf), records, 8, &num_records, dest, 8),
+    PROTON_OK);
+  EXPECT_EQ(num_records, 0u);
+}
+
+TEST_F(NodeManagerTest, UpdateBatch_LocksOnce)
+{
+  registry_.mutex_handles.arg = this;
+  registry_.mutex_handles.mutex = nullptr;
+  registry_.mutex_handles.lock = NodeManagerTest::bundle_lock;
+  registry_.mutex_handles.unlock = NodeManagerTest::bundle_unlock;
+  mock_mutex_unlock_result_ = PROTON_DISCONNECT_ERROR;
+
+  uint8_t buf[BUFFER_SIZE];
+  proton_bundle_record_t records[4];
+  size_t num_records = 0;
+  proton_endpoint_t dest[4];
+
+  EXPECT_EQ(
+    proton_node_update_batch(&node_, 1000, buf, sizeof(buf), records, 4, &num_records, dest, 4),
+    PROTON_DISCONNECT_ERROR);
+  EXPECT_TRUE(lock_called_);
+  EXPECT_TRUE(unlock_called_);
+}
+
+// -----------------------------------------------------------------------
+// Compact frames
+// -----------------------------------------------------------------------
+
+TEST_F(NodeManagerTest, UpdateBatch_SendsCompactFramesOnceThePeerAdvertisesItsSchema)
+{
+  std::vector<uint32_t> peer_schema_hashes(node_.num_peers, 0);
+  node_.peer_schema_hashes = peer_schema_hashes.data();
+
+  uint8_t buf[BUFFER_SIZE];
+  proton_bundle_record_t records[4];
+  size_t num_records = 0;
+  proton_endpoint_t dest[4];
+  auto send_value_test = [&]()
+  {
+    ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+    ASSERT_EQ(
+      proton_node_update_batch(&node_, 0, buf, sizeof(buf), records, 4, &num_records, dest, 4),
+      PROTON_OK);
+    ASSERT_EQ(num_records, 1u);
+    ASSERT_EQ(records[0].bundle_id, PROTON_BUNDLE_VALUE_TEST_ID);
+  };
+
+  // The peer's schema is unknown, a normal message advertising this node's schema is sent
+  send_value_test();
+  EXPECT_EQ(records[0].frame_flags, 0);
+  uint32_t schema_hash = 0;
+  ASSERT_TRUE(proton_read_schema_hash(buf, records[0].length, &schema_hash));
+  EXPECT_EQ(schema_hash, PROTON_SCHEMA_HASH);
+
+  // The consumer advertises the same schema
+  proton_registry_t peer_registry = copy_default_registry(&g_proton_registry);
+  uint8_t advertisement[BUFFER_SIZE];
+  size_t advertisement_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &peer_registry, PROTON_BUNDLE_VALUE_TEST_ID, advertisement, sizeof(advertisement),
+      &advertisement_len),
+    PROTON_OK);
+  ASSERT_EQ(
+    proton_append_schema_hash(
+      advertisement, sizeof(advertisement), &advertisement_len, PROTON_SCHEMA_HASH),
+    PROTON_OK);
+  ASSERT_EQ(
+    proton_node_receive_frame(
+      &node_, advertisement, advertisement_len, PROTON_NODE_CONSUMER_ID, 0),
+    PROTON_OK);
+
+  send_value_test();
+  EXPECT_EQ(records[0].frame_flags, PROTON_FRAME_FLAG_COMPACT);
+  EXPECT_LT(records[0].length, advertisement_len);
+  EXPECT_EQ(
+    proton_decode_compact(&peer_registry, buf, records[0].length, nullptr, nullptr), PROTON_OK);
+
+  // A compact frame from another schema is rejected, and the node falls back to normal messages
+  buf[0] ^= 0xFF;
+  EXPECT_EQ(
+    proton_node_receive_frame(
+      &node_, buf, records[0].length, PROTON_NODE_CONSUMER_ID, PROTON_FRAME_FLAG_COMPACT),
+    PROTON_SCHEMA_MISMATCH_ERROR);
+  send_value_test();
+  EXPECT_EQ(records[0].frame_flags, 0);
+
+  // Nodes without peer schema storage never send compact frames nor advertise
+  node_.peer_schema_hashes = nullptr;
+  send_value_test();
+  EXPECT_EQ(records[0].frame_flags, 0);
+  EXPECT_FALSE(proton_read_schema_hash(buf, records[0].length, &schema_hash));
+
+  free(peer_registry.signal_registry);
+  free(peer_registry.bundle_table);
+}
+
+// -----------------------------------------------------------------------
+// proton_node_update_coalesced
+// -----------------------------------------------------------------------
+
+namespace
+{
+/**
+ * Counts the bundle callbacks called for every bundle in the registry
+ */
+class CountingCallbacks : public BundleCallback
+{
+public:
+  explicit CountingCallbacks(proton_registry_t * registry)
+  {
+    for (size_t i = 0; i < registry->bundle_count; i++)
+    {
+      proton_registry_set_bundle_callback(
+        registry, registry->bundle_table[i].bundle_id, bundle_cb, this);
+    }
+  }
+
+  void callback(uint32_t bundle_id, const uint32_t *, size_t) override
+  {
+    received.push_back(bundle_id);
+  }
+
+  std::vector<uint32_t> received;
+};
+}  // namespace
+
+TEST_F(NodeManagerTest, UpdateCoalesced_NullPtrs_ReturnNullPtrError)
+{
+  uint8_t buf[BUFFER_SIZE];
+  size_t out_len = 0;
+  proton_endpoint_t dest[4];
+  size_t num_peers = 0;
+
+  EXPECT_EQ(
+    proton_node_update_coalesced(nullptr, 0, buf, sizeof(buf), &out_len, dest, 4, &num_peers),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_coalesced(&node_, 0, nullptr, sizeof(buf), &out_len, dest, 4, &num_peers),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_coalesced(&node_, 0, buf, sizeof(buf), nullptr, dest, 4, &num_peers),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_coalesced(&node_, 0, buf, sizeof(buf), &out_len, nullptr, 4, &num_peers),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_coalesced(&node_, 0, buf, sizeof(buf), &out_len, dest, 4, nullptr),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_node_update_coalesced(&node_, 0, buf, sizeof(buf), &out_len, dest, 0, &num_peers),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+}
+
+TEST_F(NodeManagerTest, UpdateCoalesced_PacksDueBundlesIntoOneMessage)
+{
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_SHARED_2_ID), PROTON_OK);
+
+  constexpr uint64_t UPTIME_MS = 1000;
+  uint8_t buf[BUFFER_SIZE];
+  size_t out_len = 0;
+  proton_endpoint_t dest[4];
+  size_t num_peers = 0;
+  ASSERT_EQ(
+    proton_node_update_coalesced(
+      &node_, UPTIME_MS, buf, sizeof(buf), &out_len, dest, 4, &num_peers),
+    PROTON_OK);
+  ASSERT_GT(out_len, 0u);
+  ASSERT_EQ(num_peers, 1u);
+  EXPECT_EQ(dest[0].node_id, static_cast<uint32_t>(PROTON_NODE_CONSUMER_ID));
+
+  // The three triggered bundles and the due periodic bundle were all sent
+  for (uint32_t id :
+       {PROTON_BUNDLE_VALUE_TEST_ID, PROTON_BUNDLE_SHARED_1_ID, PROTON_BUNDLE_SHARED_2_ID,
+        PROTON_BUNDLE_PERIODIC_BUNDLE_ID})
+  {
+    const bundle_desc_t * desc = proton_registry_get_bundle(&registry_, id, NULL);
+    ASSERT_NE(desc, nullptr);
+    EXPECT_EQ(desc->last_send_ms, UPTIME_MS);
+    EXPECT_FALSE(desc->send_now);
+  }
+
+  size_t next_len = 1;
+  uint8_t next_buf[BUFFER_SIZE];
+  ASSERT_EQ(
+    proton_node_update_coalesced(
+      &node_, UPTIME_MS, next_buf, sizeof(next_buf), &next_len, dest, 4, &num_peers),
+    PROTON_OK);
+  EXPECT_EQ(next_len, 0u);
+
+  // The receiver calls the callback of every bundle in the message
+  CountingCallbacks callbacks(&registry_);
+  ASSERT_EQ(proton_node_receive(&node_, buf, out_len), PROTON_OK);
+  std::vector<uint32_t> expected_ids = {
+    PROTON_BUNDLE_VALUE_TEST_ID, PROTON_BUNDLE_SHARED_1_ID, PROTON_BUNDLE_SHARED_2_ID,
+    PROTON_BUNDLE_PERIODIC_BUNDLE_ID};
+  std::sort(callbacks.received.begin(), callbacks.received.end());
+  EXPECT_EQ(callbacks.received, expected_ids);
+}
+
+TEST_F(NodeManagerTest, UpdateCoalesced_RespectsPeerMtu)
+{
+  uint8_t single[BUFFER_SIZE];
+  size_t single_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(
+      &registry_, PROTON_BUNDLE_SHARED_1_ID, single, sizeof(single), &single_len),
+    PROTON_OK);
+
+  // Room for the two shared bundles in one message, but not for a third bundle
+  auto * peers = const_cast<proton_endpoint_t *>(node_.destination_peers);
+  for (uint8_t i = 0; i < node_.num_peers; i++)
+  {
+    peers[i].mtu = static_cast<uint16_t>(2 + 2 * single_len);
+  }
+
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_SHARED_2_ID), PROTON_OK);
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+
+  uint8_t buf[BUFFER_SIZE];
+  size_t out_len = 0;
+  proton_endpoint_t dest[4];
+  size_t num_peers = 0;
+  size_t messages = 0;
+  CountingCallbacks callbacks(&registry_);
+  while (true)
+  {
+    ASSERT_EQ(
+      proton_node_update_coalesced(&node_, 10, buf, sizeof(buf), &out_len, dest, 4, &num_peers),
+      PROTON_OK);
+    if (out_len == 0)
+    {
+      break;
+    }
+    ASSERT_LT(messages, 3u);
+    messages++;
+
+    size_t received_before = callbacks.received.size();
+    ASSERT_EQ(proton_node_receive(&node_, buf, out_len), PROTON_OK);
+    if (callbacks.received.size() - received_before > 1)
+    {
+      EXPECT_LE(out_len, peers[0].mtu);
+    }
+  }
+
+  // The large bundle goes on its own, the two shared bundles together
+  EXPECT_EQ(messages, 2u);
+  EXPECT_EQ(callbacks.received.size(), 3u);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
+
+// -----------------------------------------------------------------------
+// proton_node_update_framed / proton_node_encode_bundle_framed
+// -----------------------------------------------------------------------
+
+TEST_F(NodeManagerTest, EncodeBundleFramed_SerialFrameWrapsTheBareMessage)
+{
+  uint8_t bare[BUFFER_SIZE];
+  size_t bare_len = 0;
+  proton_endpoint_t dest[1];
+  size_t num_peers = 0;
+  ASSERT_EQ(
+    proton_node_encode_bundle(
+      &node_, PROTON_BUNDLE_VALUE_TEST_ID, 0, bare, sizeof(bare), &bare_len, dest, 1, &num_peers),
+    PROTON_OK);
+
+  for (proton_framing_t framing :
+       {proton_framing_t PROTON_SERIAL_FRAMING, proton_framing_t PROTON_SERIAL_FRAMING_CRC32C})
+  {
+    uint8_t frame[BUFFER_SIZE];
+    size_t frame_len = 0;
+    ASSERT_EQ(
+      proton_node_encode_bundle_framed(
+        &node_, PROTON_BUNDLE_VALUE_TEST_ID, 0, frame, sizeof(frame), &framing, &frame_len, dest,
+        1, &num_peers),
+      PROTON_OK);
+    ASSERT_EQ(frame_len, framing.headroom + bare_len + framing.tailroom);
+
+    uint8_t parser_buffer[BUFFER_SIZE];
+    proton_serial_parser_t parser;
+    ASSERT_EQ(
+      proton_serial_parser_init(&parser, parser_buffer, sizeof(parser_buffer), BUFFER_SIZE),
+      PROTON_OK);
+    size_t consumed = 0;
+    proton_serial_frame_t parsed;
+    ASSERT_EQ(proton_serial_parser_feed(&parser, frame, frame_len, &consumed, &parsed), PROTON_OK);
+    EXPECT_EQ(consumed, frame_len);
+    ASSERT_EQ(parsed.payload, frame + PROTON_FRAME_HEADER_OVERHEAD);
+    EXPECT_EQ(parsed.flags, framing.tailroom == PROTON_FRAME_CRC32C_OVERHEAD
+                              ? PROTON_FRAME_FLAG_CRC32C
+                              : 0);
+    ASSERT_EQ(parsed.length, bare_len);
+    EXPECT_EQ(memcmp(parsed.payload, bare, bare_len), 0);
+  }
+}
+
+TEST_F(NodeManagerTest, UpdateFramed_Udp4HeaderIsFilledInPlace)
+{
+  ASSERT_EQ(proton_node_trigger_bundle(&node_, PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+
+  uint8_t node_id = 7;
+  const proton_framing_t framing = PROTON_UDP4_FRAMING(&node_id);
+  uint8_t buf[BUFFER_SIZE];
+  size_t out_len = 0;
+  proton_endpoint_t dest[1];
+  size_t num_peers = 0;
+  ASSERT_EQ(
+    proton_node_update_framed(
+      &node_, 0, buf, sizeof(buf), &framing, &out_len, dest, 1, &num_peers),
+    PROTON_OK);
+  ASSERT_GT(out_len, sizeof(proton_udp4_header_t));
+
+  proton_udp4_header_t header;
+  ASSERT_EQ(proton_udp4_check_payload(buf, (uint16_t)out_len, &header), PROTON_OK);
+  EXPECT_EQ(header.version, PROTON_CURRENT_UDP_VERSION);
+  EXPECT_EQ(header.node_id, node_id);
+  EXPECT_EQ(header.flags, 0);
+
+  CountingCallbacks callbacks(&registry_);
+  ASSERT_EQ(
+    proton_node_receive(
+      &node_, buf + sizeof(proton_udp4_header_t), out_len - sizeof(proton_udp4_header_t)),
+    PROTON_OK);
+  EXPECT_EQ(callbacks.received, std::vector<uint32_t>{PROTON_BUNDLE_VALUE_TEST_ID});
+}
+
+TEST_F(NodeManagerTest, Framed_BufferSmallerThanFramingReturnsInsufficientBuffer)
+{
+  const proton_framing_t framing = PROTON_SERIAL_FRAMING;
+  uint8_t buf[PROTON_FRAME_OVERHEAD - 1];
+  size_t out_len = 0;
+  proton_endpoint_t dest[1];
+  size_t num_peers = 0;
+  EXPECT_EQ(
+    proton_node_encode_bundle_framed(
+      &node_, PROTON_BUNDLE_VALUE_TEST_ID, 0, buf, sizeof(buf), &framing, &out_len, dest, 1,
+      &num_peers),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+}
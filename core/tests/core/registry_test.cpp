@@ -18,6 +18,7 @@
 
 #include "proton/registry.h"
 #include <gtest/gtest.h>
+#include <vector>
 #include "target_registry_ids.h"
 #include "target_registry_sizes.h"
 #include "utils.hpp"
@@ -347,13 +348,651 @@ TEST(SignalRegistry, SignalTypeStrings)
     {PROTON_INVALID_TYPE, "invalid"}, {PROTON_DOUBLE, "double"}, {PROTON_FLOAT, "float"},
     {PROTON_INT32, "int32"},          {PROTON_INT64, "int64"},   {PROTON_UINT32, "uint32"},
     {PROTON_UINT64, "uint64"},        {PROTON_BOOL, "bool"},     {PROTON_STRING, "string"},
-    {PROTON_BYTES, "bytes"},          {-1, "invalid"},
+    {PROTON_BYTES, "bytes"},          {PROTON_FLAGS, "flags"},   {-1, "invalid"},
+    {PROTON_DOUBLE_ARRAY, "double_array"}, {PROTON_FLOAT_ARRAY, "float_array"},
+    {PROTON_INT32_ARRAY, "int32_array"},   {PROTON_INT64_ARRAY, "int64_array"},
+    {PROTON_UINT32_ARRAY, "uint32_array"}, {PROTON_UINT64_ARRAY, "uint64_array"},
   };
 
   for (const auto & [type, str] : types)
   {
     EXPECT_EQ(signal_type_to_string(static_cast<proton_signal_type_e>(type)), str);
   }
+
+  // Array type names start with the name of their element type
+  EXPECT_EQ(string_to_signal_type("int32_array"), PROTON_INT32_ARRAY);
+  EXPECT_EQ(string_to_signal_type("int32"), PROTON_INT32);
+  EXPECT_EQ(string_to_signal_type("uint64_array"), PROTON_UINT64_ARRAY);
+}
+
+TEST(SignalRegistry, SetGetArray)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  // Default value [1, -2, 3] out of a capacity of 4
+  const int32_t * ticks = nullptr;
+  size_t count = 0;
+  ASSERT_EQ(
+    proton_signal_get_int32_array(&registry, PROTON_SIGNAL_WHEEL_TICKS_ID, &ticks, &count),
+    PROTON_OK);
+  ASSERT_EQ(count, 3u);
+  EXPECT_EQ(ticks[1], -2);
+
+  const double samples[] = {0.5, -1.25, 1e300};
+  ASSERT_EQ(
+    proton_signal_set_double_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, samples, 3),
+    PROTON_OK);
+  const double * view = nullptr;
+  ASSERT_EQ(
+    proton_signal_get_double_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, &view, &count),
+    PROTON_OK);
+  ASSERT_EQ(count, 3u);
+  EXPECT_EQ(memcmp(view, samples, sizeof(samples)), 0);
+
+  // The view is the registry storage itself
+  const signal_desc_t * desc =
+    proton_registry_get_signal(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, nullptr);
+  ASSERT_NE(desc, nullptr);
+  EXPECT_EQ(static_cast<const void *>(view), desc->signal.signal.string_value);
+  EXPECT_EQ(desc->value_size, sizeof(samples));
+
+  const double too_many[PROTON_SIGNAL_IMU_SAMPLES_MAX_ELEMENTS + 1] = {};
+  EXPECT_EQ(
+    proton_signal_set_double_array(
+      &registry, PROTON_SIGNAL_IMU_SAMPLES_ID, too_many, std::size(too_many)),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(
+    proton_signal_set_float_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, nullptr, 0),
+    PROTON_ERROR);
+  EXPECT_EQ(
+    proton_signal_set_double_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, nullptr, 1),
+    PROTON_NULL_PTR_ERROR);
+  ASSERT_EQ(
+    proton_signal_set_double_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, nullptr, 0),
+    PROTON_OK);
+  ASSERT_EQ(
+    proton_signal_get_double_array(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID, &view, &count),
+    PROTON_OK);
+  EXPECT_EQ(count, 0u);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(SignalRegistry, FillArrayInPlace)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_signal_handle_t handle;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_IMU_SAMPLES_ID, PROTON_DOUBLE_ARRAY, &handle),
+    PROTON_OK);
+
+  void * data = nullptr;
+  size_t capacity = 0;
+  ASSERT_EQ(proton_signal_handle_array_buffer(&registry, handle, &data, &capacity), PROTON_OK);
+  ASSERT_EQ(capacity, static_cast<size_t>(PROTON_SIGNAL_IMU_SAMPLES_MAX_ELEMENTS));
+
+  double * samples = static_cast<double *>(data);
+  for (size_t i = 0; i < capacity; i++)
+  {
+    samples[i] = static_cast<double>(i) / 4;
+  }
+
+  const uint32_t version = registry.signal_registry[handle.index].version;
+  EXPECT_EQ(
+    proton_signal_handle_commit_array(&registry, handle, capacity + 1),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  ASSERT_EQ(proton_signal_handle_commit_array(&registry, handle, 5), PROTON_OK);
+  EXPECT_EQ(registry.signal_registry[handle.index].version, version + 1);
+
+  const void * view = nullptr;
+  size_t count = 0;
+  ASSERT_EQ(proton_signal_handle_get_array(&registry, handle, &view, &count), PROTON_OK);
+  EXPECT_EQ(view, data);
+  ASSERT_EQ(count, 5u);
+  EXPECT_EQ(static_cast<const double *>(view)[4], 1.0);
+
+  // Handles of other types are rejected
+  proton_signal_handle_t scalar;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_DOUBLE_VALUE_ID, PROTON_DOUBLE, &scalar),
+    PROTON_OK);
+  EXPECT_EQ(proton_signal_handle_array_buffer(&registry, scalar, &data, &capacity), PROTON_ERROR);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(SignalRegistry, SetGetFlags)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  const uint32_t id = PROTON_SIGNAL_STATUS_FLAGS_ID;
+
+  // Default value 5 sets ready and charging
+  bool flag = false;
+  ASSERT_EQ(
+    proton_signal_get_flag(&registry, id, PROTON_SIGNAL_STATUS_FLAGS_READY_BIT, &flag), PROTON_OK);
+  EXPECT_TRUE(flag);
+  ASSERT_EQ(
+    proton_signal_get_flag(&registry, id, PROTON_SIGNAL_STATUS_FLAGS_FAULT_BIT, &flag), PROTON_OK);
+  EXPECT_FALSE(flag);
+
+  ASSERT_EQ(
+    proton_signal_set_flag(&registry, id, PROTON_SIGNAL_STATUS_FLAGS_FAULT_BIT, true), PROTON_OK);
+  ASSERT_EQ(
+    proton_signal_set_flag(&registry, id, PROTON_SIGNAL_STATUS_FLAGS_CHARGING_BIT, false),
+    PROTON_OK);
+  ASSERT_EQ(proton_signal_set_flag(&registry, id, 63, true), PROTON_OK);
+
+  uint64_t flags = 0;
+  ASSERT_EQ(proton_signal_get_flags(&registry, id, &flags), PROTON_OK);
+  EXPECT_EQ(flags, 0x8000000000000003u);
+
+  ASSERT_EQ(proton_signal_set_flags(&registry, id, 0x10), PROTON_OK);
+  ASSERT_EQ(proton_signal_get_flag(&registry, id, 4, &flag), PROTON_OK);
+  EXPECT_TRUE(flag);
+
+  // Bits past the end and other signal types are rejected without touching the value
+  EXPECT_EQ(proton_signal_set_flag(&registry, id, PROTON_FLAGS_MAX_BITS, true), PROTON_ERROR);
+  EXPECT_EQ(proton_signal_get_flag(&registry, id, PROTON_FLAGS_MAX_BITS, &flag), PROTON_ERROR);
+  EXPECT_EQ(
+    proton_signal_set_flag(&registry, PROTON_SIGNAL_UINT64_VALUE_ID, 0, true), PROTON_ERROR);
+  EXPECT_EQ(proton_signal_get_flag(&registry, id, 0, nullptr), PROTON_NULL_PTR_ERROR);
+  ASSERT_EQ(proton_signal_get_flags(&registry, id, &flags), PROTON_OK);
+  EXPECT_EQ(flags, 0x10u);
+
+  proton_signal_handle_t handle;
+  ASSERT_EQ(proton_registry_resolve_signal(&registry, id, PROTON_FLAGS, &handle), PROTON_OK);
+  ASSERT_EQ(proton_signal_handle_set_flag(&registry, handle, 1, true), PROTON_OK);
+  ASSERT_EQ(proton_signal_handle_get_flags(&registry, handle, &flags), PROTON_OK);
+  EXPECT_EQ(flags, 0x12u);
+
+  free(registry.signal_registry);
+}
+
+TEST(RegistryIndex, GeneratedIndexMatchesLinearScan)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  ASSERT_NE(registry.bundle_index.slots, nullptr);
+  ASSERT_NE(registry.signal_index.slots, nullptr);
+
+  proton_registry_t unindexed = registry;
+  unindexed.bundle_index = {nullptr, 0};
+  unindexed.signal_index = {nullptr, 0};
+
+  for (size_t i = 0; i < registry.bundle_count; i++)
+  {
+    uint32_t id = registry.bundle_table[i].bundle_id;
+    size_t indexed_slot = SIZE_MAX;
+    size_t linear_slot = SIZE_MAX;
+    EXPECT_EQ(
+      proton_registry_get_bundle(&registry, id, &indexed_slot),
+      proton_registry_get_bundle(&unindexed, id, &linear_slot));
+    EXPECT_EQ(indexed_slot, linear_slot);
+  }
+
+  for (size_t i = 0; i < registry.signal_count; i++)
+  {
+    uint32_t id = registry.signal_registry[i].id;
+    size_t indexed_idx = SIZE_MAX;
+    size_t linear_idx = SIZE_MAX;
+    EXPECT_EQ(
+      proton_registry_get_signal(&registry, id, &indexed_idx),
+      proton_registry_get_signal(&unindexed, id, &linear_idx));
+    EXPECT_EQ(indexed_idx, linear_idx);
+  }
+
+  EXPECT_EQ(proton_registry_get_bundle(&registry, 9999, NULL), nullptr);
+  EXPECT_EQ(proton_registry_get_signal(&registry, 0x1111, NULL), nullptr);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(RegistryIndex, BuildIndex)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  uint16_t bundle_capacity = proton_lookup_index_capacity(registry.bundle_count);
+  uint16_t signal_capacity = proton_lookup_index_capacity(registry.signal_count);
+  ASSERT_GT(bundle_capacity, registry.bundle_count);
+  ASSERT_GT(signal_capacity, registry.signal_count);
+
+  std::vector<uint16_t> bundle_slots(bundle_capacity);
+  std::vector<uint16_t> signal_slots(signal_capacity);
+  ASSERT_EQ(
+    proton_registry_build_index(
+      &registry, bundle_slots.data(), bundle_capacity, signal_slots.data(), signal_capacity),
+    PROTON_OK);
+
+  // Runtime build must produce the same tables as the generator
+  for (size_t i = 0; i < bundle_capacity; i++)
+  {
+    EXPECT_EQ(bundle_slots[i], g_proton_registry.bundle_index.slots[i]);
+  }
+  for (size_t i = 0; i < signal_capacity; i++)
+  {
+    EXPECT_EQ(signal_slots[i], g_proton_registry.signal_index.slots[i]);
+  }
+
+  size_t idx = 0;
+  EXPECT_NE(proton_registry_get_signal(&registry, PROTON_SIGNAL_DOUBLE_VALUE_ID, &idx), nullptr);
+  EXPECT_EQ(registry.signal_registry[idx].id, PROTON_SIGNAL_DOUBLE_VALUE_ID);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(RegistryIndex, BuildIndexInvalidCapacity)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  std::vector<uint16_t> slots(64);
+
+  // Not a power of two
+  EXPECT_EQ(
+    proton_registry_build_index(&registry, slots.data(), 63, nullptr, 0),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(registry.bundle_index.slots, nullptr);
+
+  // Too small to hold every signal
+  EXPECT_EQ(
+    proton_registry_build_index(&registry, nullptr, 0, slots.data(), 1),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(registry.signal_index.slots, nullptr);
+
+  // Lookups still work through the linear scan
+  EXPECT_NE(proton_registry_get_bundle(&registry, PROTON_BUNDLE_VALUE_TEST_ID, NULL), nullptr);
+  EXPECT_NE(proton_registry_get_signal(&registry, PROTON_SIGNAL_DOUBLE_VALUE_ID, NULL), nullptr);
+
+  EXPECT_EQ(proton_registry_build_index(nullptr, nullptr, 0, nullptr, 0), PROTON_NULL_PTR_ERROR);
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(RegistryIndex, Collisions)
+{
+  // A full-ish table forces probe chains to wrap around the end of the slot array
+  constexpr uint16_t count = 7;
+  signal_desc_t signals[count] = {};
+  for (uint16_t i = 0; i < count; i++)
+  {
+    signals[i].id = 8u * i + 3u;
+  }
+
+  proton_registry_t registry = {};
+  registry.signal_registry = signals;
+  registry.signal_count = count;
+
+  uint16_t slots[8];
+  ASSERT_EQ(proton_registry_build_index(&registry, nullptr, 0, slots, 8), PROTON_OK);
+
+  for (uint16_t i = 0; i < count; i++)
+  {
+    size_t idx = SIZE_MAX;
+    EXPECT_EQ(proton_registry_get_signal(&registry, signals[i].id, &idx), &signals[i]);
+    EXPECT_EQ(idx, i);
+  }
+  EXPECT_EQ(proton_registry_get_signal(&registry, 1000, NULL), nullptr);
+}
+
+TEST(RegistryIndex, BundleSignalTables)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  for (size_t b = 0; b < registry.bundle_count; b++)
+  {
+    const bundle_desc_t * bundle = &registry.bundle_table[b];
+    ASSERT_NE(bundle->signal_indices, nullptr);
+    ASSERT_NE(bundle->signal_slots.slots, nullptr);
+
+    for (size_t i = 0; i < bundle->signal_ids.count; i++)
+    {
+      uint32_t signal_id = bundle->signal_ids.ids[i];
+      EXPECT_EQ(
+        proton_registry_get_bundle_signal(&registry, bundle, i),
+        proton_registry_get_signal(&registry, signal_id, NULL));
+
+      size_t slot = SIZE_MAX;
+      EXPECT_TRUE(proton_bundle_get_signal_slot(bundle, signal_id, &slot));
+      EXPECT_EQ(slot, i);
+    }
+
+    EXPECT_FALSE(proton_bundle_get_signal_slot(bundle, 0x1111, NULL));
+    EXPECT_EQ(
+      proton_registry_get_bundle_signal(&registry, bundle, bundle->signal_ids.count), nullptr);
+  }
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(RegistryIndex, BuildBundleIndex)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  bundle_desc_t * bundle = &registry.bundle_table[0];
+  const bundle_desc_t * generated = &g_proton_registry.bundle_table[0];
+  ASSERT_GT(bundle->signal_ids.count, 0);
+
+  std::vector<uint16_t> indices(bundle->signal_ids.count);
+  std::vector<uint16_t> slots(proton_lookup_index_capacity(bundle->signal_ids.count));
+  ASSERT_EQ(
+    proton_registry_build_bundle_index(
+      &registry, bundle, indices.data(), slots.data(), slots.size()),
+    PROTON_OK);
+
+  // Runtime build must produce the same tables as the generator
+  for (size_t i = 0; i < indices.size(); i++)
+  {
+    EXPECT_EQ(indices[i], generated->signal_indices[i]);
+  }
+  ASSERT_EQ(bundle->signal_slots.capacity, generated->signal_slots.capacity);
+  for (size_t i = 0; i < slots.size(); i++)
+  {
+    EXPECT_EQ(slots[i], generated->signal_slots.slots[i]);
+  }
+
+  EXPECT_EQ(
+    proton_registry_build_bundle_index(&registry, bundle, nullptr, slots.data(), 1),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(bundle->signal_slots.slots, nullptr);
+  EXPECT_TRUE(proton_bundle_get_signal_slot(bundle, bundle->signal_ids.ids[0], NULL));
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(RegistryIndex, StaleBundleSignalIndexFallsBack)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  bundle_desc_t * bundle = &registry.bundle_table[0];
+  ASSERT_GT(bundle->signal_ids.count, 1);
+
+  // Point every entry at the wrong registry position
+  std::vector<uint16_t> stale(bundle->signal_ids.count, 0);
+  stale[0] = registry.signal_count;
+  bundle->signal_indices = stale.data();
+
+  for (size_t i = 0; i < bundle->signal_ids.count; i++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(&registry, bundle, i);
+    ASSERT_NE(desc, nullptr);
+    EXPECT_EQ(desc->id, bundle->signal_ids.ids[i]);
+  }
+
+  free(registry.signal_registry);
+  free(registry.bundle_table);
+}
+
+TEST(SignalHandle, ResolveSignal)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  size_t index = 0;
+  ASSERT_NE(
+    proton_registry_get_signal(&registry, PROTON_SIGNAL_DEFAULT_DOUBLE_ID, &index), nullptr);
+
+  proton_signal_handle_t handle;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_DEFAULT_DOUBLE_ID, PROTON_DOUBLE, &handle),
+    PROTON_OK);
+  EXPECT_EQ(handle.index, index);
+  EXPECT_EQ(handle.type, PROTON_DOUBLE);
+
+  // PROTON_INVALID_TYPE takes the registered type
+  proton_signal_handle_t any;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_DEFAULT_STRING_ID, PROTON_INVALID_TYPE, &any),
+    PROTON_OK);
+  EXPECT_EQ(any.type, PROTON_STRING);
+
+  free(registry.signal_registry);
+}
+
+TEST(SignalHandle, ResolveSignalErrors)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_signal_handle_t handle;
+
+  EXPECT_EQ(
+    proton_registry_resolve_signal(
+      nullptr, PROTON_SIGNAL_DEFAULT_DOUBLE_ID, PROTON_DOUBLE, &handle),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_DEFAULT_DOUBLE_ID, PROTON_DOUBLE, nullptr),
+    PROTON_NULL_PTR_ERROR);
+
+  EXPECT_EQ(proton_registry_resolve_signal(&registry, 9999, PROTON_DOUBLE, &handle), PROTON_ERROR);
+  EXPECT_EQ(handle.type, PROTON_INVALID_TYPE);
+
+  EXPECT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_DEFAULT_DOUBLE_ID, PROTON_UINT32, &handle),
+    PROTON_ERROR);
+  EXPECT_EQ(handle.type, PROTON_INVALID_TYPE);
+
+  free(registry.signal_registry);
+}
+
+TEST(SignalHandle, ScalarAccessors)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_signal_handle_t handle;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(&registry, PROTON_SIGNAL_INT64_VALUE_ID, PROTON_INT64, &handle),
+    PROTON_OK);
+
+  ASSERT_EQ(proton_signal_handle_set_int64(&registry, handle, -42), PROTON_OK);
+  int64_t value = 0;
+  ASSERT_EQ(proton_signal_get_int64(&registry, PROTON_SIGNAL_INT64_VALUE_ID, &value), PROTON_OK);
+  EXPECT_EQ(value, -42);
+
+  ASSERT_EQ(proton_signal_set_int64(&registry, PROTON_SIGNAL_INT64_VALUE_ID, 7), PROTON_OK);
+  ASSERT_EQ(proton_signal_handle_get_int64(&registry, handle, &value), PROTON_OK);
+  EXPECT_EQ(value, 7);
+
+  // A handle is only valid for the type it was resolved for
+  double wrong = 0.0;
+  EXPECT_EQ(proton_signal_handle_get_double(&registry, handle, &wrong), PROTON_ERROR);
+  EXPECT_EQ(proton_signal_handle_get_int64(&registry, handle, nullptr), PROTON_NULL_PTR_ERROR);
+
+  proton_signal_handle_t unresolved = PROTON_SIGNAL_HANDLE_INIT;
+  EXPECT_EQ(proton_signal_handle_get_int64(&registry, unresolved, &value), PROTON_ERROR);
+  EXPECT_EQ(proton_signal_handle_set_int64(&registry, unresolved, 1), PROTON_ERROR);
+
+  free(registry.signal_registry);
+}
+
+TEST(SignalHandle, StringAndBytesAccessors)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_signal_handle_t string_handle;
+  proton_signal_handle_t bytes_handle;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_STRING_VALUE_ID, PROTON_STRING, &string_handle),
+    PROTON_OK);
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_BYTES_VALUE_ID, PROTON_BYTES, &bytes_handle),
+    PROTON_OK);
+
+  ASSERT_EQ(proton_signal_handle_set_string(&registry, string_handle, "bar", 4), PROTON_OK);
+  EXPECT_EQ(
+    proton_signal_handle_set_string(&registry, string_handle, "too long!", 10),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+
+  char string_value[PROTON_SIGNAL_STRING_VALUE_CAPACITY] = {0};
+  size_t len = 0;
+  ASSERT_EQ(
+    proton_signal_handle_get_string(
+      &registry, string_handle, string_value, sizeof(string_value), &len),
+    PROTON_OK);
+  EXPECT_EQ(len, 4u);
+  EXPECT_STREQ(string_value, "bar");
+
+  const uint8_t data[] = {9, 8, 7};
+  ASSERT_EQ(proton_signal_handle_set_bytes(&registry, bytes_handle, data, sizeof(data)), PROTON_OK);
+  uint8_t bytes_value[PROTON_SIGNAL_BYTES_VALUE_CAPACITY] = {0};
+  ASSERT_EQ(
+    proton_signal_get_bytes(
+      &registry, PROTON_SIGNAL_BYTES_VALUE_ID, bytes_value, sizeof(bytes_value), &len),
+    PROTON_OK);
+  ASSERT_EQ(len, sizeof(data));
+  EXPECT_EQ(memcmp(bytes_value, data, len), 0);
+
+  // String and bytes handles are not interchangeable
+  EXPECT_EQ(
+    proton_signal_handle_get_bytes(
+      &registry, string_handle, bytes_value, sizeof(bytes_value), &len),
+    PROTON_ERROR);
+
+  free(registry.signal_registry);
+}
+
+TEST(SignalHandle, HandleOutOfRange)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_signal_handle_t handle;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_SHARED_SIGNAL_ID, PROTON_INT32, &handle),
+    PROTON_OK);
+
+  // A handle from a larger registry is rejected rather than read out of bounds
+  registry.signal_count = handle.index;
+  int32_t value = 0;
+  EXPECT_EQ(proton_signal_handle_get_int32(&registry, handle, &value), PROTON_ERROR);
+
+  free(registry.signal_registry);
+}
+
+TEST(BundleSnapshot, CopiesEveryValue)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  ASSERT_EQ(proton_signal_set_int64(&registry, PROTON_SIGNAL_INT64_VALUE_ID, -5), PROTON_OK);
+  ASSERT_EQ(
+    proton_signal_set_string(&registry, PROTON_SIGNAL_STRING_VALUE_ID, "abc", 4), PROTON_OK);
+  const uint8_t data[] = {4, 5, 6};
+  ASSERT_EQ(
+    proton_signal_set_bytes(&registry, PROTON_SIGNAL_BYTES_VALUE_ID, data, sizeof(data)),
+    PROTON_OK);
+
+  proton_signal_value_t values[9];
+  uint8_t buffer[32];
+  size_t count = 0;
+  ASSERT_EQ(
+    proton_bundle_snapshot(
+      &registry, PROTON_BUNDLE_VALUE_TEST_ID, values, 9, buffer, sizeof(buffer), &count),
+    PROTON_OK);
+  ASSERT_EQ(count, 9u);
+
+  EXPECT_EQ(values[3].id, PROTON_SIGNAL_INT64_VALUE_ID);
+  EXPECT_EQ(values[3].type, PROTON_INT64);
+  EXPECT_EQ(values[3].signal.signal.int64_value, -5);
+  EXPECT_EQ(values[3].version, 1u);
+  // Each setter call is one write
+  EXPECT_EQ(values[3].sequence, 2u);
+  EXPECT_EQ(values[0].sequence, 0u);
+
+  ASSERT_EQ(values[7].type, PROTON_STRING);
+  EXPECT_EQ(values[7].value_size, 4u);
+  EXPECT_STREQ(static_cast<const char *>(values[7].signal.signal.string_value), "abc");
+  EXPECT_GE(static_cast<uint8_t *>(values[7].signal.signal.string_value), buffer);
+  ASSERT_EQ(values[8].value_size, sizeof(data));
+  EXPECT_EQ(memcmp(values[8].signal.signal.bytes_value, data, sizeof(data)), 0);
+
+  free(registry.signal_registry);
+}
+
+TEST(BundleSnapshot, ChecksItsArguments)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  proton_signal_value_t values[9];
+  uint8_t buffer[32];
+  size_t count = 0;
+  EXPECT_EQ(
+    proton_bundle_snapshot(
+      nullptr, PROTON_BUNDLE_VALUE_TEST_ID, values, 9, buffer, sizeof(buffer), &count),
+    PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_bundle_snapshot(&registry, 9999, values, 9, buffer, sizeof(buffer), &count),
+    PROTON_ERROR);
+  EXPECT_EQ(
+    proton_bundle_snapshot(
+      &registry, PROTON_BUNDLE_VALUE_TEST_ID, values, 8, buffer, sizeof(buffer), &count),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(
+    proton_bundle_snapshot(&registry, PROTON_BUNDLE_VALUE_TEST_ID, values, 9, buffer, 4, &count),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(count, 0u);
+  free(registry.signal_registry);
+}
+
+namespace
+{
+
+/**
+ * Registry lock that finishes a write of a bundle when it is taken, as a writer holding the lock
+ * would before releasing it
+ */
+struct PendingWrite
+{
+  const proton_registry_t * registry;
+  const bundle_desc_t * bundle;
+  int locks;
+};
+
+proton_status_e finish_write_and_lock(void * mutex, void * arg)
+{
+  (void)mutex;
+  PendingWrite * write = static_cast<PendingWrite *>(arg);
+  proton_bundle_end_write(write->registry, write->bundle);
+  write->locks++;
+  return PROTON_OK;
+}
+
+proton_status_e unlock_registry(void * mutex, void * arg)
+{
+  (void)mutex;
+  (void)arg;
+  return PROTON_OK;
+}
+
+}  // namespace
+
+TEST(BundleSnapshot, WaitsForTheLockWhileASignalIsWritten)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  const bundle_desc_t * shared_1 =
+    proton_registry_get_bundle(&registry, PROTON_BUNDLE_SHARED_1_ID, NULL);
+  ASSERT_NE(shared_1, nullptr);
+  PendingWrite write = {&registry, shared_1, 0};
+  registry.mutex_handles.lock = finish_write_and_lock;
+  registry.mutex_handles.unlock = unlock_registry;
+  registry.mutex_handles.arg = &write;
+
+  // A bundle being decoded marks its signals, which shared_2 shares with it
+  proton_bundle_begin_write(&registry, shared_1);
+  proton_signal_value_t value;
+  size_t count = 0;
+  ASSERT_EQ(
+    proton_bundle_snapshot(&registry, PROTON_BUNDLE_SHARED_2_ID, &value, 1, nullptr, 0, &count),
+    PROTON_OK);
+  EXPECT_EQ(write.locks, 1);
+  EXPECT_EQ(count, 1u);
+  EXPECT_EQ(value.sequence, 2u);
+
+  // Once written, snapshots do not take the lock
+  ASSERT_EQ(
+    proton_bundle_snapshot(&registry, PROTON_BUNDLE_SHARED_2_ID, &value, 1, nullptr, 0, &count),
+    PROTON_OK);
+  EXPECT_EQ(write.locks, 1);
+
+  free(registry.signal_registry);
 }
 
 int main(int argc, char ** argv)
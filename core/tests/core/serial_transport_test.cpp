@@ -17,6 +17,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <vector>
 #include "proton/transport/serial.h"
 
 // -----------------------------------------------------------------------
@@ -226,6 +227,35 @@ TEST(SerialFraming, FillHeaderThenGetLength_RoundTrip)
   EXPECT_EQ(decoded_len, expected_len);
 }
 
+TEST(SerialFraming, CompactFlagUsesOwnMagicByte)
+{
+  uint8_t header[4] = {};
+  ASSERT_EQ(
+    proton_serial_fill_frame_header_flags(header, 137, PROTON_FRAME_FLAG_COMPACT), PROTON_OK);
+  EXPECT_EQ(header[0], PROTON_FRAME_HEADER_MAGIC_BYTE_0);
+  EXPECT_EQ(header[1], PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT);
+
+  uint16_t length = 0;
+  uint8_t flags = 0;
+  ASSERT_EQ(proton_serial_get_framed_payload_info(header, &length, &flags), PROTON_OK);
+  EXPECT_EQ(length, 137);
+  EXPECT_EQ(flags, PROTON_FRAME_FLAG_COMPACT);
+  // Receivers that only know normal frames reject compact ones
+  EXPECT_EQ(
+    proton_serial_get_framed_payload_length(header, &length), PROTON_INVALID_HEADER_ERROR);
+
+  ASSERT_EQ(proton_serial_fill_frame_header_flags(header, 5, 0), PROTON_OK);
+  EXPECT_EQ(header[1], PROTON_FRAME_HEADER_MAGIC_BYTE_1);
+  ASSERT_EQ(proton_serial_get_framed_payload_info(header, &length, &flags), PROTON_OK);
+  EXPECT_EQ(length, 5);
+  EXPECT_EQ(flags, 0);
+
+  header[1] = 0x00;
+  EXPECT_EQ(
+    proton_serial_get_framed_payload_info(header, &length, &flags), PROTON_INVALID_HEADER_ERROR);
+  EXPECT_EQ(proton_serial_get_framed_payload_info(header, &length, nullptr), PROTON_NULL_PTR_ERROR);
+}
+
 TEST(SerialFraming, FillCrcThenCheckCrc_RoundTrip)
 {
   const uint8_t payload[] = {0xDE, 0xAD, 0xBE, 0xEF};
@@ -248,6 +278,281 @@ TEST(SerialFraming, ModifiedPayloadFailsCrcCheck)
     proton_serial_check_framed_payload(payload, sizeof(payload), crc_val), PROTON_CRC16_ERROR);
 }
 
+TEST(SerialFraming, Crc32cFlagUsesOwnMagicBytes)
+{
+  uint8_t header[4] = {};
+  uint16_t length = 0;
+  uint8_t flags = 0;
+
+  ASSERT_EQ(
+    proton_serial_fill_frame_header_flags(header, 300, PROTON_FRAME_FLAG_CRC32C), PROTON_OK);
+  EXPECT_EQ(header[1], PROTON_FRAME_HEADER_MAGIC_BYTE_1_CRC32C);
+  ASSERT_EQ(proton_serial_get_framed_payload_info(header, &length, &flags), PROTON_OK);
+  EXPECT_EQ(length, 300);
+  EXPECT_EQ(flags, PROTON_FRAME_FLAG_CRC32C);
+
+  const uint8_t both = PROTON_FRAME_FLAG_COMPACT | PROTON_FRAME_FLAG_CRC32C;
+  ASSERT_EQ(proton_serial_fill_frame_header_flags(header, 7, both), PROTON_OK);
+  EXPECT_EQ(header[1], PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT_CRC32C);
+  ASSERT_EQ(proton_serial_get_framed_payload_info(header, &length, &flags), PROTON_OK);
+  EXPECT_EQ(length, 7);
+  EXPECT_EQ(flags, both);
+
+  // Receivers that only know CRC16 frames reject CRC32C ones
+  EXPECT_EQ(
+    proton_serial_get_framed_payload_length(header, &length), PROTON_INVALID_HEADER_ERROR);
+}
+
+TEST(SerialFraming, FillCrc32cThenCheckCrc32c_RoundTrip)
+{
+  // "123456789" is the CRC32C check string
+  uint8_t payload[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  uint8_t crc_bytes[PROTON_FRAME_CRC32C_OVERHEAD] = {};
+  ASSERT_EQ(proton_serial_fill_crc32c(payload, sizeof(payload), crc_bytes), PROTON_OK);
+  EXPECT_EQ(crc_bytes[0], 0x83);
+  EXPECT_EQ(crc_bytes[1], 0x92);
+  EXPECT_EQ(crc_bytes[2], 0x06);
+  EXPECT_EQ(crc_bytes[3], 0xE3);
+
+  EXPECT_EQ(
+    proton_serial_check_framed_payload_crc32c(payload, sizeof(payload), 0xE3069283), PROTON_OK);
+  payload[8] ^= 0x80;
+  EXPECT_EQ(
+    proton_serial_check_framed_payload_crc32c(payload, sizeof(payload), 0xE3069283),
+    PROTON_CRC16_ERROR);
+
+  EXPECT_EQ(proton_serial_fill_crc32c(nullptr, 0, crc_bytes), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(proton_serial_fill_crc32c(payload, 0, nullptr), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(proton_serial_check_framed_payload_crc32c(nullptr, 0, 0), PROTON_NULL_PTR_ERROR);
+}
+
+// -----------------------------------------------------------------------
+// proton_serial_parser
+// -----------------------------------------------------------------------
+
+namespace
+{
+std::vector<uint8_t> make_frame(const std::vector<uint8_t> & payload, uint8_t flags = 0)
+{
+  const bool crc32c = flags & PROTON_FRAME_FLAG_CRC32C;
+  std::vector<uint8_t> frame(
+    PROTON_FRAME_HEADER_OVERHEAD + payload.size() +
+    (crc32c ? PROTON_FRAME_CRC32C_OVERHEAD : PROTON_FRAME_CRC_OVERHEAD));
+  proton_serial_fill_frame_header_flags(frame.data(), (uint16_t)payload.size(), flags);
+  std::copy(payload.begin(), payload.end(), frame.begin() + PROTON_FRAME_HEADER_OVERHEAD);
+  const uint8_t * data = frame.data() + PROTON_FRAME_HEADER_OVERHEAD;
+  uint8_t * crc = frame.data() + PROTON_FRAME_HEADER_OVERHEAD + payload.size();
+  if (crc32c)
+  {
+    proton_serial_fill_crc32c(data, (uint16_t)payload.size(), crc);
+  }
+  else
+  {
+    proton_serial_fill_crc16(data, (uint16_t)payload.size(), crc);
+  }
+  return frame;
+}
+
+struct ParsedStream
+{
+  std::vector<std::vector<uint8_t>> payloads;
+  std::vector<uint8_t> flags;
+  std::vector<proton_status_e> errors;
+};
+
+/**
+ * Feed a stream to a parser in chunks of chunk_len bytes, collecting frames and errors
+ */
+void parse_stream(
+  proton_serial_parser_t & parser, const std::vector<uint8_t> & stream, size_t chunk_len,
+  ParsedStream & parsed)
+{
+  for (size_t offset = 0; offset < stream.size(); offset += chunk_len)
+  {
+    const size_t len = std::min(chunk_len, stream.size() - offset);
+    size_t used = 0;
+    while (used < len)
+    {
+      size_t consumed = 0;
+      proton_serial_frame_t frame;
+      proton_status_e status = proton_serial_parser_feed(
+        &parser, stream.data() + offset + used, len - used, &consumed, &frame);
+      ASSERT_GT(consumed, 0u);
+      used += consumed;
+      if (status != PROTON_OK)
+      {
+        parsed.errors.push_back(status);
+      }
+      else if (frame.payload)
+      {
+        parsed.payloads.emplace_back(frame.payload, frame.payload + frame.length);
+        parsed.flags.push_back(frame.flags);
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(SerialParser, InitChecksArguments)
+{
+  proton_serial_parser_t parser;
+  uint8_t buffer[16];
+  EXPECT_EQ(proton_serial_parser_init(nullptr, buffer, 16, 16), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(proton_serial_parser_init(&parser, nullptr, 16, 16), PROTON_NULL_PTR_ERROR);
+  EXPECT_EQ(
+    proton_serial_parser_init(&parser, buffer, 16, 17), PROTON_INSUFFICIENT_BUFFER_ERROR);
+  ASSERT_EQ(proton_serial_parser_init(&parser, buffer, 16, 16), PROTON_OK);
+
+  size_t consumed = 0;
+  proton_serial_frame_t frame;
+  EXPECT_EQ(
+    proton_serial_parser_feed(&parser, nullptr, 0, &consumed, &frame), PROTON_NULL_PTR_ERROR);
+}
+
+TEST(SerialParser, WholeFrameIsCheckedInPlace)
+{
+  uint8_t buffer[64];
+  proton_serial_parser_t parser;
+  ASSERT_EQ(proton_serial_parser_init(&parser, buffer, sizeof(buffer), sizeof(buffer)), PROTON_OK);
+
+  const auto stream = make_frame({0xDE, 0xAD, 0xBE, 0xEF});
+  size_t consumed = 0;
+  proton_serial_frame_t frame;
+  ASSERT_EQ(
+    proton_serial_parser_feed(&parser, stream.data(), stream.size(), &consumed, &frame),
+    PROTON_OK);
+  EXPECT_EQ(consumed, stream.size());
+  EXPECT_EQ(frame.payload, stream.data() + PROTON_FRAME_HEADER_OVERHEAD);
+  EXPECT_EQ(frame.length, 4);
+  EXPECT_EQ(frame.flags, 0);
+  EXPECT_EQ(parser.frames, 1u);
+}
+
+TEST(SerialParser, FramesSplitAtEveryChunkSize)
+{
+  std::vector<uint8_t> stream;
+  std::vector<std::vector<uint8_t>> payloads = {
+    {}, {0x50, 0x52, 0x01}, std::vector<uint8_t>(40, 0xA5), {0x01, 0x02}};
+  const uint8_t flags[] = {
+    0, PROTON_FRAME_FLAG_CRC32C, PROTON_FRAME_FLAG_COMPACT,
+    PROTON_FRAME_FLAG_COMPACT | PROTON_FRAME_FLAG_CRC32C};
+  for (size_t i = 0; i < payloads.size(); i++)
+  {
+    const auto frame = make_frame(payloads[i], flags[i]);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+
+  for (size_t chunk_len = 1; chunk_len <= stream.size(); chunk_len++)
+  {
+    uint8_t buffer[64];
+    proton_serial_parser_t parser;
+    ASSERT_EQ(proton_serial_parser_init(&parser, buffer, sizeof(buffer), 64), PROTON_OK);
+
+    ParsedStream parsed;
+    parse_stream(parser, stream, chunk_len, parsed);
+    EXPECT_TRUE(parsed.errors.empty()) << "chunk " << chunk_len;
+    ASSERT_EQ(parsed.payloads, payloads) << "chunk " << chunk_len;
+    for (size_t i = 0; i < payloads.size(); i++)
+    {
+      EXPECT_EQ(parsed.flags[i], flags[i]);
+    }
+    EXPECT_EQ(parser.discarded_bytes, 0u);
+  }
+}
+
+TEST(SerialParser, ResynchronizesAfterLineNoise)
+{
+  const std::vector<uint8_t> payload = {0x11, 0x22, 0x33};
+  // False starts: a lone magic byte, a repeated one, and a bad second magic byte
+  std::vector<uint8_t> stream = {0x00, 0x50, 0xFF, 0x50, 0x50, 0x00, 0x12};
+  const auto frame = make_frame(payload);
+  stream.insert(stream.end(), frame.begin(), frame.end());
+  stream.insert(stream.end(), {0x50, 0x50});
+  stream.insert(stream.end(), frame.begin(), frame.end());
+
+  for (size_t chunk_len = 1; chunk_len <= stream.size(); chunk_len++)
+  {
+    uint8_t buffer[16];
+    proton_serial_parser_t parser;
+    ASSERT_EQ(proton_serial_parser_init(&parser, buffer, sizeof(buffer), 16), PROTON_OK);
+
+    ParsedStream parsed;
+    parse_stream(parser, stream, chunk_len, parsed);
+    EXPECT_TRUE(parsed.errors.empty()) << "chunk " << chunk_len;
+    ASSERT_EQ(parsed.payloads.size(), 2u) << "chunk " << chunk_len;
+    EXPECT_EQ(parsed.payloads[0], payload);
+    EXPECT_EQ(parsed.payloads[1], payload);
+    EXPECT_EQ(parser.discarded_bytes, 9u) << "chunk " << chunk_len;
+  }
+}
+
+TEST(SerialParser, OversizedLengthIsRejected)
+{
+  const std::vector<uint8_t> payload = {0x01, 0x02};
+  std::vector<uint8_t> stream = make_frame(std::vector<uint8_t>(9, 0x00));
+  const auto frame = make_frame(payload);
+  stream.insert(stream.end(), frame.begin(), frame.end());
+
+  uint8_t buffer[8];
+  proton_serial_parser_t parser;
+  ASSERT_EQ(proton_serial_parser_init(&parser, buffer, sizeof(buffer), 8), PROTON_OK);
+
+  ParsedStream parsed;
+  parse_stream(parser, stream, stream.size(), parsed);
+  ASSERT_EQ(parsed.errors.size(), 1u);
+  EXPECT_EQ(parsed.errors[0], PROTON_INVALID_HEADER_ERROR);
+  EXPECT_EQ(parser.length_errors, 1u);
+  ASSERT_EQ(parsed.payloads.size(), 1u);
+  EXPECT_EQ(parsed.payloads[0], payload);
+}
+
+TEST(SerialParser, CrcErrorDropsTheFrame)
+{
+  for (uint8_t flags : {(uint8_t)0, PROTON_FRAME_FLAG_CRC32C})
+  {
+    std::vector<uint8_t> stream = make_frame({0x01, 0x02, 0x03}, flags);
+    stream[PROTON_FRAME_HEADER_OVERHEAD + 1] ^= 0x04;
+    const auto frame = make_frame({0x04, 0x05}, flags);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+
+    for (size_t chunk_len : {(size_t)1, (size_t)5, stream.size()})
+    {
+      uint8_t buffer[8];
+      proton_serial_parser_t parser;
+      ASSERT_EQ(proton_serial_parser_init(&parser, buffer, sizeof(buffer), 8), PROTON_OK);
+
+      ParsedStream parsed;
+      parse_stream(parser, stream, chunk_len, parsed);
+      ASSERT_EQ(parsed.errors.size(), 1u);
+      EXPECT_EQ(parsed.errors[0], PROTON_CRC16_ERROR);
+      EXPECT_EQ(parser.crc_errors, 1u);
+      ASSERT_EQ(parsed.payloads.size(), 1u);
+      EXPECT_EQ(parsed.payloads[0], std::vector<uint8_t>({0x04, 0x05}));
+      EXPECT_EQ(parser.discarded_bytes, 0u);
+    }
+  }
+}
+
+TEST(SerialParser, ResetDropsPartialFrame)
+{
+  uint8_t buffer[8];
+  proton_serial_parser_t parser;
+  ASSERT_EQ(proton_serial_parser_init(&parser, buffer, sizeof(buffer), 8), PROTON_OK);
+
+  const auto frame = make_frame({0x01, 0x02, 0x03});
+  size_t consumed = 0;
+  proton_serial_frame_t out;
+  ASSERT_EQ(proton_serial_parser_feed(&parser, frame.data(), 6, &consumed, &out), PROTON_OK);
+  EXPECT_EQ(consumed, 6u);
+  EXPECT_EQ(out.payload, nullptr);
+
+  proton_serial_parser_reset(&parser);
+  ASSERT_EQ(
+    proton_serial_parser_feed(&parser, frame.data(), frame.size(), &consumed, &out), PROTON_OK);
+  ASSERT_NE(out.payload, nullptr);
+  EXPECT_EQ(out.length, 3);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
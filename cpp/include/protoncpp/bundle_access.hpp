@@ -53,6 +53,14 @@ public:
   void set_period(uint32_t period_ms) noexcept;
   void set_callback(proton_bundle_cb_f cb, void * ctx) noexcept;
 
+  /**
+   * Copy every signal of the bundle as they were at one point in time, retrying rather than
+   * waiting for the registry lock, see proton_bundle_snapshot
+   */
+  proton_status_e snapshot(
+    proton_signal_value_t * values, size_t capacity, uint8_t * buffer, size_t buffer_len,
+    size_t & count) const noexcept;
+
 #if PROTON_ENABLE_ALLOC
   using CallbackType =
     std::function<void(uint32_t bundle_id, const uint32_t * signal_ids, size_t count)>;
@@ -76,21 +84,25 @@ public:
 #endif  // PROTON_ENABLE_ALLOC
 
 #if __cplusplus >= 201703L
+  /**
+   * Signal of the bundle, resolved through the bundle's signal table without an ID lookup
+   */
   std::optional<SignalBase> operator[](uint32_t signal_id) const noexcept
   {
     const bundle_desc_t * desc = descriptor();
-    if (!desc)
+    size_t slot = 0;
+    if (!proton_bundle_get_signal_slot(desc, signal_id, &slot))
     {
       return std::nullopt;
     }
-    for (size_t i = 0; i < desc->signal_ids.count; i++)
+    const signal_desc_t * signal = proton_registry_get_bundle_signal(registry_, desc, slot);
+    if (!signal || signal->type == PROTON_INVALID_TYPE)
     {
-      if (desc->signal_ids.ids[i] == signal_id)
-      {
-        return SignalBase(registry_, signal_id);
-      }
+      return std::nullopt;
     }
-    return std::nullopt;
+    proton_signal_handle_t handle = {
+      static_cast<uint16_t>(signal - registry_->signal_registry), signal->type};
+    return SignalBase(registry_, handle);
   }
 #endif
 
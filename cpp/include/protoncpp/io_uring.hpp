@@ -0,0 +1,138 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_IO_URING_HPP
+#define PROTON_IO_URING_HPP
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#include <cstddef>
+#include <cstdint>
+#include "proton/common.h"
+
+namespace proton
+{
+
+/**
+ * @class IoUring minimal io_uring instance, set up with the raw system calls so that no liburing
+ * is needed. Submission entries are queued with get_sqe and handed to the kernel by submit, in
+ * one io_uring_enter along with the wait for completions. Not thread-safe.
+ */
+class IoUring
+{
+public:
+  IoUring() = default;
+  ~IoUring();
+
+  IoUring(const IoUring &) = delete;
+  IoUring & operator=(const IoUring &) = delete;
+
+  /**
+   * @brief Whether the kernel allows io_uring and supports every operation the runtime uses:
+   * multishot recvmsg with provided buffer rings, zero-copy sends, polls and linked timeouts.
+   * False when io_uring is disabled by the kernel.io_uring_disabled sysctl or a seccomp filter.
+   */
+  static bool supported() noexcept;
+
+  /**
+   * @param entries Size of the submission queue, the completion queue is twice as large
+   * @return PROTON_UNSUPPORTED_OPERATION_ERROR if io_uring is not available
+   */
+  proton_status_e open(uint32_t entries) noexcept;
+
+  /**
+   * @brief Tear the instance down, cancelling every operation in flight
+   */
+  void close() noexcept;
+
+  bool is_open() const noexcept { return fd_ >= 0; }
+
+  /**
+   * @brief Next free submission entry, zeroed. Queued entries are submitted first if the queue is
+   * full.
+   * @return nullptr if the queue is full and cannot be submitted
+   */
+  io_uring_sqe * get_sqe() noexcept;
+
+  /**
+   * @brief Number of entries get_sqe returns before it has to submit
+   */
+  uint32_t space_left() const noexcept;
+
+  /**
+   * @brief Submit the queued entries and wait for at least wait_nr completions
+   * @return PROTON_OK if interrupted by a signal before wait_nr completions arrived
+   */
+  proton_status_e submit(uint32_t wait_nr = 0) noexcept;
+
+  /**
+   * @brief Oldest completion not seen yet, nullptr if there is none
+   */
+  const io_uring_cqe * peek_cqe() noexcept;
+
+  /**
+   * @brief Hand the completion returned by peek_cqe back to the kernel
+   */
+  void cqe_seen() noexcept;
+
+  /**
+   * @brief Register buffers for IORING_RECVSEND_FIXED_BUF and the fixed read and write operations
+   */
+  proton_status_e register_buffers(const iovec * buffers, uint32_t count) noexcept;
+
+  /**
+   * @brief Register a ring of provided buffers as buffer group group
+   * @param ring Page aligned memory for entries io_uring_buf, entries a power of two
+   */
+  proton_status_e register_buffer_ring(
+    io_uring_buf_ring * ring, uint16_t entries, uint16_t group) noexcept;
+
+  /**
+   * @brief Hand a buffer to a provided buffer ring, made visible by advance_buffer_ring
+   * @param offset Number of buffers added since the last advance
+   */
+  static void add_buffer(
+    io_uring_buf_ring * ring, uint16_t entries, void * data, uint32_t len, uint16_t id,
+    uint16_t offset) noexcept;
+
+  static void advance_buffer_ring(io_uring_buf_ring * ring, uint16_t count) noexcept;
+
+private:
+  int fd_ = -1;
+
+  void * sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void * cq_ring_ = nullptr;
+  io_uring_sqe * sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t * sq_head_ = nullptr;
+  uint32_t * sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t * sq_array_ = nullptr;
+  // Entries queued by get_sqe and not submitted yet
+  uint32_t sq_queued_ = 0;
+
+  uint32_t * cq_head_ = nullptr;
+  uint32_t * cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe * cqes_ = nullptr;
+};
+
+}  // namespace proton
+
+#endif  // PROTON_IO_URING_HPP
@@ -43,6 +43,8 @@ class NodeAccess
 {
 public:
   using Endpoint = proton_endpoint_t;
+  using BundleRecord = proton_bundle_record_t;
+  using Framing = proton_framing_t;
 
   explicit NodeAccess(proton_node_t * node) : node_(node) {}
 
@@ -64,6 +66,40 @@ public:
       &num_selected_peers);
   }
 
+  proton_status_e update_framed(
+    uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len, const Framing & framing,
+    size_t & out_len, Endpoint * dest_peers, size_t num_dest_peers,
+    size_t & num_selected_peers) noexcept
+  {
+    return proton_node_update_framed(
+      node_, uptime_ms, buffer, buffer_len, &framing, &out_len, dest_peers, num_dest_peers,
+      &num_selected_peers);
+  }
+
+  proton_status_e update_batch(
+    uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len, BundleRecord * records,
+    size_t max_records, size_t & num_records, Endpoint * dest_peers, size_t num_dest_peers) noexcept
+  {
+    return proton_node_update_batch(
+      node_, uptime_ms, buffer, buffer_len, records, max_records, &num_records, dest_peers,
+      num_dest_peers);
+  }
+
+  proton_status_e update_coalesced(
+    uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len, size_t & out_len,
+    Endpoint * dest_peers, size_t num_dest_peers, size_t & num_selected_peers) noexcept
+  {
+    return proton_node_update_coalesced(
+      node_, uptime_ms, buffer, buffer_len, &out_len, dest_peers, num_dest_peers,
+      &num_selected_peers);
+  }
+
+  proton_status_e next_deadline(
+    uint64_t uptime_ms, uint64_t & deadline_ms, bool & has_deadline) noexcept
+  {
+    return proton_node_next_deadline(node_, uptime_ms, &deadline_ms, &has_deadline);
+  }
+
   proton_status_e trigger_bundle(uint32_t bundle_id) noexcept
   {
     return proton_node_trigger_bundle(node_, bundle_id);
@@ -80,6 +116,16 @@ public:
       &num_selected_peers);
   }
 
+  proton_status_e encode_bundle_framed(
+    uint32_t bundle_id, uint64_t uptime_ms, uint8_t * buffer, size_t buffer_len,
+    const Framing & framing, size_t & out_len, Endpoint * dest_peers, size_t num_dest_peers,
+    size_t & num_selected_peers) noexcept
+  {
+    return proton_node_encode_bundle_framed(
+      node_, bundle_id, uptime_ms, buffer, buffer_len, &framing, &out_len, dest_peers,
+      num_dest_peers, &num_selected_peers);
+  }
+
   SignalAccess signals() noexcept { return SignalAccess(node_->registry); }
   BundleAccess bundle(uint32_t id) noexcept { return BundleAccess(node_->registry, id); }
 
@@ -132,6 +178,33 @@ public:
       num_selected_peers);
   }
 
+  proton_status_e update_framed(
+    uint64_t uptime_ms, std::span<uint8_t> buffer, const Framing & framing, size_t & out_len,
+    std::span<Endpoint> peers, size_t & num_selected_peers) noexcept
+  {
+    return update_framed(
+      uptime_ms, buffer.data(), buffer.size(), framing, out_len, peers.data(), peers.size(),
+      num_selected_peers);
+  }
+
+  proton_status_e update_batch(
+    uint64_t uptime_ms, std::span<uint8_t> buffer, std::span<BundleRecord> records,
+    size_t & num_records, std::span<Endpoint> peers) noexcept
+  {
+    return update_batch(
+      uptime_ms, buffer.data(), buffer.size(), records.data(), records.size(), num_records,
+      peers.data(), peers.size());
+  }
+
+  proton_status_e update_coalesced(
+    uint64_t uptime_ms, std::span<uint8_t> buffer, size_t & out_len, std::span<Endpoint> peers,
+    size_t & num_selected_peers) noexcept
+  {
+    return update_coalesced(
+      uptime_ms, buffer.data(), buffer.size(), out_len, peers.data(), peers.size(),
+      num_selected_peers);
+  }
+
   proton_status_e encode_bundle(
     uint32_t bundle_id, uint64_t uptime_ms, std::span<uint8_t> buffer, size_t & out_len,
     std::span<Endpoint> peers, size_t & num_selected_peers) noexcept
@@ -141,6 +214,15 @@ public:
       num_selected_peers);
   }
 
+  proton_status_e encode_bundle_framed(
+    uint32_t bundle_id, uint64_t uptime_ms, std::span<uint8_t> buffer, const Framing & framing,
+    size_t & out_len, std::span<Endpoint> peers, size_t & num_selected_peers) noexcept
+  {
+    return encode_bundle_framed(
+      bundle_id, uptime_ms, buffer.data(), buffer.size(), framing, out_len, peers.data(),
+      peers.size(), num_selected_peers);
+  }
+
 #endif
 
 private:
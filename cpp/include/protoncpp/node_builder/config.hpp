@@ -54,17 +54,25 @@ inline constexpr std::string_view TYPE = "type";
 inline constexpr std::string_view IP = "ip";
 inline constexpr std::string_view PORT = "port";
 inline constexpr std::string_view DEVICE = "device";
+inline constexpr std::string_view MTU = "mtu";
+inline constexpr std::string_view COMPACT = "compact";
 inline constexpr std::string_view CONNECTIONS = "connections";
 inline constexpr std::string_view FIRST = "first";
 inline constexpr std::string_view SECOND = "second";
 inline constexpr std::string_view NODE = "node";
 inline constexpr std::string_view CAPACITY = "capacity";
+inline constexpr std::string_view BITS = "bits";
 inline constexpr std::string_view VALUE = "value";
 inline constexpr std::string_view ID = "id";
 inline constexpr std::string_view PRODUCERS = "producers";
 inline constexpr std::string_view CONSUMERS = "consumers";
 inline constexpr std::string_view SIGNALS = "signals";
 inline constexpr std::string_view PERIOD_MS = "period_ms";
+inline constexpr std::string_view DELTA = "delta";
+inline constexpr std::string_view KEYFRAME_INTERVAL = "keyframe_interval";
+inline constexpr std::string_view ENCODING = "encoding";
+inline constexpr std::string_view SCALE = "scale";
+inline constexpr std::string_view OFFSET = "offset";
 }  // namespace keys
 
 namespace value_types
@@ -79,16 +87,32 @@ inline constexpr std::string_view UINT64 = "uint64";
 inline constexpr std::string_view BOOL = "bool";
 inline constexpr std::string_view STRING = "string";
 inline constexpr std::string_view BYTES = "bytes";
-
-constexpr std::array<std::string_view, 10> VALUE_TYPES = {INVALID, DOUBLE, FLOAT, INT32,  INT64,
-                                                          UINT32,  UINT64, BOOL,  STRING, BYTES};
+inline constexpr std::string_view FLAGS = "flags";
+inline constexpr std::string_view DOUBLE_ARRAY = "double_array";
+inline constexpr std::string_view FLOAT_ARRAY = "float_array";
+inline constexpr std::string_view INT32_ARRAY = "int32_array";
+inline constexpr std::string_view INT64_ARRAY = "int64_array";
+inline constexpr std::string_view UINT32_ARRAY = "uint32_array";
+inline constexpr std::string_view UINT64_ARRAY = "uint64_array";
+
+constexpr std::array<std::string_view, 17> VALUE_TYPES = {
+  INVALID,      DOUBLE,      FLOAT,       INT32,        INT64,       UINT32,
+  UINT64,       BOOL,        STRING,      BYTES,        FLAGS,       DOUBLE_ARRAY,
+  FLOAT_ARRAY,  INT32_ARRAY, INT64_ARRAY, UINT32_ARRAY, UINT64_ARRAY};
 
 }  // namespace value_types
 
+namespace encodings
+{
+inline constexpr std::string_view QUANTIZED = "quantized";
+inline constexpr std::string_view FLOAT16 = "float16";
+}  // namespace encodings
+
 namespace transport_types
 {
 inline constexpr std::string_view UDP4 = "udp4";
 inline constexpr std::string_view SERIAL = "serial";
+inline constexpr std::string_view SHM = "shm";
 }  // namespace transport_types
 
 struct SignalConfig
@@ -117,9 +141,17 @@ struct SignalConfig
   uint32_t id{};
   std::string type_string;
   uint16_t value_size{};
+  // Bytes of a string or bytes signal, elements of an array signal
   uint16_t capacity{};
   bool has_default_value{};
   ConfigValue value;
+  // Names of the flags of a flags signal, bit n holding flag n
+  std::vector<std::string> bits;
+  // Wire encoding of a float or double signal, empty to send the value as it is
+  std::string encoding;
+  // Quantization step and value of 0 of a quantized signal
+  double scale{};
+  double offset{};
 };
 
 struct BundleConfig
@@ -127,6 +159,8 @@ struct BundleConfig
   std::string name;
   uint32_t id;
   uint32_t period_ms;
+  bool delta{};
+  uint16_t keyframe_interval{};
   std::vector<std::string> producers;
   std::vector<std::string> consumers;
   std::vector<uint32_t> signals;
@@ -139,6 +173,7 @@ struct EndpointConfig
   std::string device;
   std::string ip;
   uint32_t port;
+  uint16_t mtu{};
 };
 
 struct NodeConfig
@@ -146,6 +181,7 @@ struct NodeConfig
   std::string name;
   uint32_t id;
   std::map<uint32_t, EndpointConfig> endpoints;
+  bool compact{};
 };
 
 struct ConnectionEndpointConfig
@@ -189,6 +225,8 @@ public:
   std::map<std::string, NodeConfig> nodes;
   std::vector<ConnectionConfig> connections;
   std::vector<SignalConfig> signals;
+  // Schema hash of the config a filtered config was made from, 0 when not filtered
+  uint32_t schema_hash{};
 
 private:
   void parse(const ConfigTree & tree);
@@ -74,6 +74,13 @@ void find_duplicates(const std::span<T> & items, const std::string & name)
 }
 
 void validate(const Config & config);
+
+/**
+ * @brief Schema hash of a whole config, equal to the PROTON_SCHEMA_HASH the code generator emits
+ * for it. A config made by filter_for_target keeps the hash of the config it was filtered from.
+ */
+uint32_t compute_schema_hash(const Config & config);
+
 Config filter_for_target(const Config & config, const std::string & target_name);
 
 class GeneratedNode
@@ -94,18 +101,28 @@ public:
       bundle_producer_ids_ = std::move(other.bundle_producer_ids_);
       bundle_consumer_ids_ = std::move(other.bundle_consumer_ids_);
       bundle_signal_ids_ = std::move(other.bundle_signal_ids_);
+      bundle_sent_versions_ = std::move(other.bundle_sent_versions_);
+      peer_schema_hashes_ = std::move(other.peer_schema_hashes_);
       bundle_table_ = std::move(other.bundle_table_);
       bundle_encode_decode_buffer_ = std::move(other.bundle_encode_decode_buffer_);
       signal_registry_ = std::move(other.signal_registry_);
       signal_value_buffer_storage_ = std::move(other.signal_value_buffer_storage_);
       signal_decode_buffer_storage_ = std::move(other.signal_decode_buffer_storage_);
+      signal_encoding_storage_ = std::move(other.signal_encoding_storage_);
       signal_scratch_buffer_ = std::move(other.signal_scratch_buffer_);
+      bundle_signal_indices_ = std::move(other.bundle_signal_indices_);
+      bundle_signal_slots_ = std::move(other.bundle_signal_slots_);
+      bundle_index_slots_ = std::move(other.bundle_index_slots_);
+      schedule_heap_ = std::move(other.schedule_heap_);
+      schedule_triggered_ = std::move(other.schedule_triggered_);
+      signal_index_slots_ = std::move(other.signal_index_slots_);
       mtx_ = std::move(other.mtx_);
       node_ = std::move(other.node_);
       registry_ = std::move(other.registry_);
       node_.registry = &registry_;
       node_.destination_peers =
         node_destination_peers_.empty() ? nullptr : node_destination_peers_.data();
+      node_.peer_schema_hashes = peer_schema_hashes_.empty() ? nullptr : peer_schema_hashes_.data();
     }
   }
 
@@ -117,18 +134,28 @@ public:
       bundle_producer_ids_ = std::move(other.bundle_producer_ids_);
       bundle_consumer_ids_ = std::move(other.bundle_consumer_ids_);
       bundle_signal_ids_ = std::move(other.bundle_signal_ids_);
+      bundle_sent_versions_ = std::move(other.bundle_sent_versions_);
+      peer_schema_hashes_ = std::move(other.peer_schema_hashes_);
       bundle_table_ = std::move(other.bundle_table_);
       bundle_encode_decode_buffer_ = std::move(other.bundle_encode_decode_buffer_);
       signal_registry_ = std::move(other.signal_registry_);
       signal_value_buffer_storage_ = std::move(other.signal_value_buffer_storage_);
       signal_decode_buffer_storage_ = std::move(other.signal_decode_buffer_storage_);
+      signal_encoding_storage_ = std::move(other.signal_encoding_storage_);
       signal_scratch_buffer_ = std::move(other.signal_scratch_buffer_);
+      bundle_signal_indices_ = std::move(other.bundle_signal_indices_);
+      bundle_signal_slots_ = std::move(other.bundle_signal_slots_);
+      bundle_index_slots_ = std::move(other.bundle_index_slots_);
+      schedule_heap_ = std::move(other.schedule_heap_);
+      schedule_triggered_ = std::move(other.schedule_triggered_);
+      signal_index_slots_ = std::move(other.signal_index_slots_);
       mtx_ = std::move(other.mtx_);
       node_ = std::move(other.node_);
       registry_ = std::move(other.registry_);
       node_.registry = &registry_;
       node_.destination_peers =
         node_destination_peers_.empty() ? nullptr : node_destination_peers_.data();
+      node_.peer_schema_hashes = peer_schema_hashes_.empty() ? nullptr : peer_schema_hashes_.data();
     }
 
     return *this;
@@ -154,12 +181,17 @@ private:
 
   // Owned storage for endpoint peers
   std::vector<proton_endpoint_t> node_destination_peers_;
+  // Owned storage for the schema hash each peer advertised, empty unless the node is compact
+  std::vector<uint32_t> peer_schema_hashes_;
 
   // Owned storage for bundle ID lists (producer_ids, consumer_ids, signal_ids per bundle)
   std::map<uint32_t, std::vector<uint32_t>> bundle_producer_ids_;
   std::map<uint32_t, std::vector<uint32_t>> bundle_consumer_ids_;
   std::map<uint32_t, std::vector<uint32_t>> bundle_signal_ids_;
 
+  // Owned storage for the signal versions last sent in each delta bundle
+  std::map<uint32_t, std::vector<uint32_t>> bundle_sent_versions_;
+
   // Owned storage for bundle descriptors
   std::vector<bundle_desc_t> bundle_table_;
 
@@ -172,6 +204,20 @@ private:
   // Owned storage for string/bytes signal decode buffer (temporary decode space)
   std::vector<std::vector<uint8_t>> signal_decode_buffer_storage_;
   std::vector<uint8_t> signal_scratch_buffer_;
+  // Owned storage for the encodings of encoded float and double signals
+  std::vector<proton_signal_encoding_t> signal_encoding_storage_;
+
+  // Owned storage for per-bundle signal registry indices and signal ID to slot maps
+  std::vector<std::vector<uint16_t>> bundle_signal_indices_;
+  std::vector<std::vector<uint16_t>> bundle_signal_slots_;
+
+  // Owned storage for the bundle and signal ID lookup indices
+  std::vector<uint16_t> bundle_index_slots_;
+  std::vector<uint16_t> signal_index_slots_;
+
+  // Owned storage for the node's bundle send schedule
+  std::vector<proton_schedule_entry_t> schedule_heap_;
+  std::vector<uint16_t> schedule_triggered_;
 
   // Registry locking
   mutable std::unique_ptr<std::mutex> mtx_ = std::make_unique<std::mutex>();
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_REGISTRY_VIEW_H
+#define PROTON_REGISTRY_VIEW_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "proton/common.h"
+#include "proton/registry.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /**
+   * Read-only view of the registry of a node in another process on the same host, published by a
+   * proton::RegistryPublisher into a named shared memory segment. The segment holds a copy of the
+   * values of every bundle, each guarded by a sequence counter that is odd while the publisher
+   * writes the bundle. Readers copy a bundle and retry if the counter changed meanwhile, so they
+   * never block the publisher. A read makes no system call unless the publisher keeps writing the
+   * bundle past its first attempts, which then yield the CPU. A read that runs out of attempts
+   * returns PROTON_READ_ERROR: the bundle was busy, and the read can be retried. Linux only.
+   */
+  typedef struct proton_registry_view
+  {
+    // Mapped segment, NULL when detached
+    const void * segment;
+    size_t size;
+  } proton_registry_view_t;
+
+#define PROTON_REGISTRY_VIEW_INIT {NULL, 0}
+
+  /**
+   * A signal value copied out of a view
+   */
+  typedef struct proton_view_value
+  {
+    uint32_t signal_id;
+    proton_signal_type_e type;
+    // Version of the signal in the registry of the node when it was published
+    uint32_t version;
+    // Value bytes in the buffer given to proton_registry_view_read_bundle, 8 byte aligned. Strings
+    // include their null terminator if they have one.
+    const uint8_t * data;
+    size_t length;
+  } proton_view_value_t;
+
+  /**
+   * Map the view published under name
+   * @param name shm_open name, starting with a slash
+   * @return PROTON_CONNECT_ERROR if there is no valid view of that name
+   */
+  proton_status_e proton_registry_view_attach(proton_registry_view_t * view, const char * name);
+
+  /**
+   * Unmap the view
+   */
+  void proton_registry_view_detach(proton_registry_view_t * view);
+
+  /**
+   * Whether the publisher closed the view. Its last values can still be read, and a new view of
+   * the same name has to be attached to see later ones.
+   */
+  bool proton_registry_view_closed(const proton_registry_view_t * view);
+
+  /**
+   * Schema hash of the registry the view was published from, 0 if unknown
+   */
+  uint32_t proton_registry_view_schema_hash(const proton_registry_view_t * view);
+
+  /**
+   * Sequence of a bundle, which grows by 2 every time the bundle is published. Comparing it to the
+   * sequence of the last read tells whether the bundle has to be read again.
+   * @return PROTON_ERROR if the bundle is not in the view
+   */
+  proton_status_e proton_registry_view_bundle_sequence(
+    const proton_registry_view_t * view, uint32_t bundle_id, uint32_t * sequence);
+
+  /**
+   * Copy every signal of a bundle, all from the same publish
+   * @param values Filled with one value per signal of the bundle, in bundle order
+   * @param buffer Holds the value bytes the values point to
+   * @param count Number of values
+   * @param sequence Optional, sequence of the bundle the values were published with
+   * @return PROTON_ERROR if the bundle is not in the view, PROTON_INSUFFICIENT_BUFFER_ERROR if
+   * values or buffer are too small, and PROTON_READ_ERROR if the publisher kept writing the bundle
+   * for every attempt, in which case the read should be retried
+   */
+  proton_status_e proton_registry_view_read_bundle(
+    const proton_registry_view_t * view, uint32_t bundle_id, proton_view_value_t * values,
+    size_t capacity, uint8_t * buffer, size_t buffer_len, size_t * count, uint32_t * sequence);
+
+  /*
+   * Typed signal getters, reading the signal from the first bundle that holds it.
+   * Each returns PROTON_ERROR if the signal is not in the view or has another type, and
+   * PROTON_READ_ERROR, to be retried, if the publisher kept writing it for every attempt. String
+   * and bytes getters return PROTON_INSUFFICIENT_BUFFER_ERROR if the value does not fit in
+   * capacity.
+   */
+  proton_status_e proton_registry_view_get_double(
+    const proton_registry_view_t * view, uint32_t signal_id, double * value);
+  proton_status_e proton_registry_view_get_float(
+    const proton_registry_view_t * view, uint32_t signal_id, float * value);
+  proton_status_e proton_registry_view_get_int32(
+    const proton_registry_view_t * view, uint32_t signal_id, int32_t * value);
+  proton_status_e proton_registry_view_get_int64(
+    const proton_registry_view_t * view, uint32_t signal_id, int64_t * value);
+  proton_status_e proton_registry_view_get_uint32(
+    const proton_registry_view_t * view, uint32_t signal_id, uint32_t * value);
+  proton_status_e proton_registry_view_get_uint64(
+    const proton_registry_view_t * view, uint32_t signal_id, uint64_t * value);
+  proton_status_e proton_registry_view_get_bool(
+    const proton_registry_view_t * view, uint32_t signal_id, bool * value);
+  proton_status_e proton_registry_view_get_flags(
+    const proton_registry_view_t * view, uint32_t signal_id, uint64_t * value);
+  proton_status_e proton_registry_view_get_string(
+    const proton_registry_view_t * view, uint32_t signal_id, char * buf, size_t capacity,
+    size_t * out_len);
+  proton_status_e proton_registry_view_get_bytes(
+    const proton_registry_view_t * view, uint32_t signal_id, uint8_t * buf, size_t capacity,
+    size_t * out_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // PROTON_REGISTRY_VIEW_H
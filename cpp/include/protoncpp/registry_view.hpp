@@ -0,0 +1,193 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_REGISTRY_VIEW_HPP
+#define PROTON_REGISTRY_VIEW_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include "proton/registry.h"
+#include "protoncpp/registry_view.h"
+
+#if PROTON_NODE_BUILDER
+#include "protoncpp/node_builder/generator.hpp"
+#endif
+
+namespace proton
+{
+
+/**
+ * @class RegistryPublisher publishes the signal values of a registry into a named shared memory
+ * segment, for RegistryView readers of other processes on the same host. The segment is laid out
+ * once by create, with a copy of the values of every bundle sized to the capacity of its signals.
+ * publish copies the bundles with a signal written since their last publish, under the registry
+ * lock, each between two increments of its sequence counter. Values are copied rather than shared
+ * in place, as the registry holds string, bytes and array values behind process-local pointers.
+ */
+class RegistryPublisher
+{
+public:
+  RegistryPublisher() = default;
+  ~RegistryPublisher();
+
+  RegistryPublisher(const RegistryPublisher &) = delete;
+  RegistryPublisher & operator=(const RegistryPublisher &) = delete;
+
+  /**
+   * @brief Lay out the segment for registry and publish every bundle, replacing any segment left
+   * behind under the same name
+   * @param name shm_open name, starting with a slash
+   * @note registry must outlive the publisher
+   */
+  proton_status_e create(const char * name, const proton_registry_t * registry) noexcept;
+
+#if PROTON_NODE_BUILDER
+  proton_status_e create(const char * name, const node_builder::GeneratedNode & node) noexcept
+  {
+    return create(name, node.registry());
+  }
+#endif
+
+  /**
+   * @brief Mark the segment closed for its readers, unmap it and remove its name
+   */
+  void close() noexcept;
+
+  bool is_open() const noexcept { return segment_ != nullptr; }
+
+  /**
+   * @brief Publish every bundle with a signal written since it was last published
+   * @return PROTON_MUTEX_ERROR if the registry cannot be locked
+   */
+  proton_status_e publish() noexcept;
+
+  /**
+   * @brief Publish one bundle whether or not its signals were written
+   * @return PROTON_ERROR if the bundle is not in the registry
+   */
+  proton_status_e publish(uint32_t bundle_id) noexcept;
+
+private:
+  void publish_bundle(size_t index, bool force) noexcept;
+
+  const proton_registry_t * registry_ = nullptr;
+  uint8_t * segment_ = nullptr;
+  size_t size_ = 0;
+  char name_[NAME_MAX + 1] = {};
+};
+
+/**
+ * @class RegistryView read-only view of a registry published by a RegistryPublisher, wrapping the
+ * proton_registry_view_t C API. Reads copy values out of the segment without locks, and return
+ * PROTON_READ_ERROR if the publisher kept the bundle busy, in which case they can be retried.
+ */
+class RegistryView
+{
+public:
+  RegistryView() = default;
+  ~RegistryView() { close(); }
+
+  RegistryView(const RegistryView &) = delete;
+  RegistryView & operator=(const RegistryView &) = delete;
+
+  /**
+   * @return PROTON_CONNECT_ERROR if there is no valid view of that name
+   */
+  proton_status_e attach(const char * name) noexcept
+  {
+    return proton_registry_view_attach(&view_, name);
+  }
+
+  void close() noexcept { proton_registry_view_detach(&view_); }
+
+  bool is_open() const noexcept { return view_.segment != nullptr; }
+
+  /**
+   * @brief Whether the publisher closed the view, and a new one has to be attached
+   */
+  bool is_closed() const noexcept { return proton_registry_view_closed(&view_); }
+
+  uint32_t schema_hash() const noexcept { return proton_registry_view_schema_hash(&view_); }
+
+  proton_status_e sequence(uint32_t bundle_id, uint32_t & sequence) const noexcept
+  {
+    return proton_registry_view_bundle_sequence(&view_, bundle_id, &sequence);
+  }
+
+  /**
+   * @brief Copy every signal of a bundle, see proton_registry_view_read_bundle
+   */
+  proton_status_e read(
+    uint32_t bundle_id, proton_view_value_t * values, size_t capacity, uint8_t * buffer,
+    size_t buffer_len, size_t & count, uint32_t * sequence = nullptr) const noexcept
+  {
+    return proton_registry_view_read_bundle(
+      &view_, bundle_id, values, capacity, buffer, buffer_len, &count, sequence);
+  }
+
+  proton_status_e get(uint32_t signal_id, double & value) const noexcept
+  {
+    return proton_registry_view_get_double(&view_, signal_id, &value);
+  }
+  proton_status_e get(uint32_t signal_id, float & value) const noexcept
+  {
+    return proton_registry_view_get_float(&view_, signal_id, &value);
+  }
+  proton_status_e get(uint32_t signal_id, int32_t & value) const noexcept
+  {
+    return proton_registry_view_get_int32(&view_, signal_id, &value);
+  }
+  proton_status_e get(uint32_t signal_id, int64_t & value) const noexcept
+  {
+    return proton_registry_view_get_int64(&view_, signal_id, &value);
+  }
+  proton_status_e get(uint32_t signal_id, uint32_t & value) const noexcept
+  {
+    return proton_registry_view_get_uint32(&view_, signal_id, &value);
+  }
+  proton_status_e get(uint32_t signal_id, uint64_t & value) const noexcept
+  {
+    return proton_registry_view_get_uint64(&view_, signal_id, &value);
+  }
+  proton_status_e get(uint32_t signal_id, bool & value) const noexcept
+  {
+    return proton_registry_view_get_bool(&view_, signal_id, &value);
+  }
+  proton_status_e get_flags(uint32_t signal_id, uint64_t & value) const noexcept
+  {
+    return proton_registry_view_get_flags(&view_, signal_id, &value);
+  }
+  proton_status_e get_string(
+    uint32_t signal_id, char * buf, size_t capacity, size_t & out_len) const noexcept
+  {
+    return proton_registry_view_get_string(&view_, signal_id, buf, capacity, &out_len);
+  }
+  proton_status_e get_bytes(
+    uint32_t signal_id, uint8_t * buf, size_t capacity, size_t & out_len) const noexcept
+  {
+    return proton_registry_view_get_bytes(&view_, signal_id, buf, capacity, &out_len);
+  }
+
+  const proton_registry_view_t * view() const noexcept { return &view_; }
+
+private:
+  proton_registry_view_t view_ = PROTON_REGISTRY_VIEW_INIT;
+};
+
+}  // namespace proton
+
+#endif  // PROTON_REGISTRY_VIEW_HPP
@@ -0,0 +1,353 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_RUNTIME_HPP
+#define PROTON_RUNTIME_HPP
+
+#include <sys/socket.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "proton/node_manager.h"
+#include "protoncpp/io_uring.hpp"
+#include "protoncpp/node_access.hpp"
+#include "protoncpp/registry_view.hpp"
+#include "protoncpp/transport/serial_port.hpp"
+#include "protoncpp/transport/shm_channel.hpp"
+#include "protoncpp/transport/udp4_socket.hpp"
+
+#if PROTON_NODE_BUILDER
+#include <memory>
+#include <string>
+#include <vector>
+#include "protoncpp/node_builder/config.hpp"
+#include "protoncpp/node_builder/generator.hpp"
+#endif
+
+namespace proton
+{
+
+/**
+ * @brief I/O interface a Runtime waits on
+ */
+enum class RuntimeBackend
+{
+  // io_uring when IoUring::supported, epoll otherwise
+  AUTO,
+  EPOLL,
+  IO_URING,
+};
+
+/**
+ * @brief Counters of a Runtime, only meant to be read from the thread running it
+ */
+struct RuntimeStats
+{
+  // Returns from run_once
+  uint64_t wakeups;
+  // Messages encoded by the node, each sent to one or more peers
+  uint64_t messages_sent;
+  uint64_t frames_received;
+  // Bundles that failed to encode, sends that failed, and selected peers no transport reaches
+  uint64_t send_errors;
+  // Reads that failed, and frames the node could not decode
+  uint64_t receive_errors;
+};
+
+/**
+ * @class Runtime Linux event loop driving a node over its udp4, serial and shm transports.
+ * The loop sleeps until a transport has data or the next bundle deadline (see
+ * proton_node_next_deadline) passes, so an idle node uses no CPU. Due messages are encoded straight
+ * into a frame buffer with room for either transport header, which is filled in place for every
+ * transport the selected peers are reached through. Received frames are parsed in the transport
+ * buffers and decoded from there. Uptime is CLOCK_MONOTONIC in milliseconds. Errors are returned as
+ * proton_status_e.
+ *
+ * With the epoll backend, the loop waits in epoll_wait on the transports and on a timerfd armed to
+ * the next deadline, and sends with sendmmsg. With the io_uring backend, datagrams arrive through
+ * multishot recvmsg into a provided buffer ring, and messages are encoded into registered send
+ * buffers and sent with zero-copy sends, all those due on a wakeup in one io_uring_enter. The wait
+ * for the next deadline is a poll of the wakeup eventfd linked to an absolute timeout. Serial ports
+ * are polled through the ring and written with writev in both cases.
+ *
+ * Shm channels are checked for frames before every wait, which does not sleep if any has some, and
+ * their doorbells are waited on with the other transports. Their frames are decoded in place.
+ */
+class Runtime
+{
+public:
+  static constexpr size_t MAX_SOCKETS = 8;
+  static constexpr size_t MAX_PORTS = 8;
+  static constexpr size_t MAX_CHANNELS = 8;
+  // Largest message sent or datagram received
+  static constexpr size_t FRAME_BUFFER_SIZE = 16384;
+  // Datagrams received by one recvmmsg
+  static constexpr size_t RECEIVE_BATCH = 8;
+  // Frames received from a channel per wakeup, the rest are received on the next one
+  static constexpr size_t CHANNEL_RECEIVE_BATCH = 64;
+  // Messages sent per wakeup, the rest are sent on the next one
+  static constexpr size_t MAX_UPDATES_PER_WAKEUP = 64;
+  // io_uring submission queue entries, registered send buffers and provided receive buffers
+  static constexpr uint32_t IO_URING_ENTRIES = 256;
+  static constexpr size_t SEND_SLOTS = 16;
+  static constexpr uint16_t RECEIVE_BUFFERS = 16;
+
+  Runtime() = default;
+  ~Runtime();
+
+  Runtime(const Runtime &) = delete;
+  Runtime & operator=(const Runtime &) = delete;
+
+  /**
+   * @brief Set up the backend and wakeup event of a runtime driving node
+   * @return PROTON_UNSUPPORTED_OPERATION_ERROR if RuntimeBackend::IO_URING is asked for and
+   * IoUring::supported is false
+   */
+  proton_status_e open(
+    proton_node_t * node, RuntimeBackend backend = RuntimeBackend::AUTO) noexcept;
+
+  /**
+   * @brief Stop watching the transports and release them, closing those the runtime opened
+   */
+  void close() noexcept;
+
+  bool is_open() const noexcept { return node_ != nullptr; }
+
+  /**
+   * @brief Backend in use, EPOLL or IO_URING once open
+   */
+  RuntimeBackend backend() const noexcept { return backend_; }
+
+  /**
+   * @brief Send to and receive from the udp4 peers of an open socket. The socket is not owned and
+   * must outlive the runtime.
+   * @return PROTON_UNSUPPORTED_OPERATION_ERROR for a socket with UDP GRO enabled on the io_uring
+   * backend
+   */
+  proton_status_e add_socket(transport::udp4::Socket & socket) noexcept;
+
+  /**
+   * @brief Send to and receive from the peer endpoint on the other end of an open serial port.
+   * The port is not owned and must outlive the runtime.
+   */
+  proton_status_e add_port(
+    transport::serial::Port & port, uint32_t peer_node_id, uint32_t peer_endpoint_id) noexcept;
+
+  /**
+   * @brief Send to and receive from the shm peers of an open channel. The channel is not owned and
+   * must outlive the runtime.
+   */
+  proton_status_e add_channel(transport::shm::Channel & channel) noexcept;
+
+  /**
+   * @brief Publish the registry of the node to a view after every wakeup, nullptr to stop. The
+   * publisher is not owned and must outlive the runtime.
+   */
+  void set_publisher(RegistryPublisher * publisher) noexcept;
+
+  /**
+   * @brief Wait for a transport, the next bundle deadline or a wakeup, then receive what arrived
+   * and send what is due
+   * @param timeout_ms Longest wait, -1 to wait for the next event
+   * @return an error only if the loop cannot go on, such as when the registry cannot be locked.
+   * Bundles that fail to encode and failed sends are counted in stats instead.
+   */
+  proton_status_e run_once(int timeout_ms = -1) noexcept;
+
+  /**
+   * @brief Run until stop is called. Returns at once, clearing the request, if stop was called
+   * since the last run.
+   */
+  proton_status_e run() noexcept;
+
+  /**
+   * @brief Make run return. Safe to call from any thread.
+   */
+  void stop() noexcept;
+
+  /**
+   * @brief Trigger a bundle and wake the loop to send it. Safe to call from any thread.
+   */
+  proton_status_e trigger_bundle(uint32_t bundle_id) noexcept;
+
+  /**
+   * @brief Current uptime of the runtime's clock, as given to the node
+   */
+  static uint64_t uptime_ms() noexcept;
+
+  NodeAccess node() noexcept { return NodeAccess(node_); }
+
+  const RuntimeStats & stats() const noexcept { return stats_; }
+
+#if PROTON_NODE_BUILDER
+
+  /**
+   * @brief Open every udp4, serial and shm endpoint of target_name and drive its generated node.
+   * udp4 and shm endpoints send to the endpoints they are connected to in config, or to every
+   * endpoint of their type of the other nodes if they have no connection. Serial endpoints send to
+   * the endpoint they are connected to.
+   * @note node must outlive the runtime
+   */
+  proton_status_e open(
+    node_builder::GeneratedNode & node, const node_builder::Config & config,
+    const std::string & target_name, RuntimeBackend backend = RuntimeBackend::AUTO) noexcept;
+
+#endif
+
+private:
+  // What an epoll event or io_uring completion is about
+  enum class Source : uint8_t
+  {
+    TIMER,
+    WAKEUP,
+    SOCKET,
+    PORT,
+    PORT_OUTPUT,
+    CHANNEL,
+    SEND,
+    TIMEOUT,
+    CANCEL,
+  };
+
+  struct PortRoute
+  {
+    transport::serial::Port * port;
+    uint32_t peer_node_id;
+    uint32_t peer_endpoint_id;
+    // Whether the port is watched for output, while it has bytes queued
+    bool watching_output;
+    // Set once the port failed or hung up, it is no longer watched
+    bool failed;
+  };
+
+  proton_status_e open_epoll() noexcept;
+  proton_status_e open_io_uring() noexcept;
+  proton_status_e watch(int fd, Source source, size_t index, uint32_t events) noexcept;
+
+  proton_status_e wait_epoll(int timeout_ms) noexcept;
+  proton_status_e wait_io_uring(int timeout_ms) noexcept;
+
+  /**
+   * @brief Queue a poll of the wakeup event, linked to a timeout at deadline if there is one,
+   * unless one is queued for the same deadline already
+   */
+  proton_status_e arm_wakeup(bool has_deadline, uint64_t deadline) noexcept;
+  proton_status_e arm_socket(size_t index) noexcept;
+  proton_status_e arm_port(size_t index) noexcept;
+  proton_status_e arm_channel(size_t index) noexcept;
+
+  /**
+   * @brief Handle the completions the ring holds
+   * @return whether any of them is an event to wake up for, rather than a send completing
+   */
+  bool reap_completions() noexcept;
+  void complete_receive(size_t index, int32_t res, uint32_t flags) noexcept;
+  void complete_port(size_t index, int32_t res, uint32_t flags) noexcept;
+  void complete_port_output(size_t index) noexcept;
+  void complete_channel(size_t index, int32_t res, uint32_t flags) noexcept;
+
+  /**
+   * @return whether the send slot is free again
+   */
+  bool complete_send(size_t slot, int32_t res, uint32_t flags) noexcept;
+
+  uint8_t * receive_buffer(uint16_t id) const noexcept;
+  uint8_t * send_slot(size_t slot) const noexcept;
+
+  /**
+   * @brief Find a free send slot, reaping completions if there is none
+   */
+  bool acquire_slot(size_t & slot) noexcept;
+
+  proton_status_e send_due() noexcept;
+  void send_message(
+    uint8_t * frame, size_t slot, size_t payload_len, size_t num_selected_peers) noexcept;
+  void receive_socket(size_t index) noexcept;
+  void receive_datagram(const uint8_t * data, size_t len) noexcept;
+  void receive_port(size_t index) noexcept;
+
+  /**
+   * @brief Get every channel ready for the loop to sleep
+   * @return whether any has frames, and the loop should not sleep
+   */
+  bool prepare_channels() noexcept;
+  void receive_channel(size_t index) noexcept;
+  void receive_frame(
+    const uint8_t * data, size_t len, uint32_t peer_node_id, uint8_t flags) noexcept;
+  void update_port_output(size_t index) noexcept;
+  void unwatch_port(size_t index) noexcept;
+
+  static proton_status_e record_flags(
+    uint8_t * frame, size_t payload_len, uint8_t flags, void * arg) noexcept;
+
+  proton_node_t * node_ = nullptr;
+  RuntimeBackend backend_ = RuntimeBackend::EPOLL;
+  int epoll_fd_ = -1;
+  int timer_fd_ = -1;
+  int wakeup_fd_ = -1;
+  std::atomic<bool> stop_requested_ = false;
+  RuntimeStats stats_ = {};
+
+  transport::udp4::Socket * sockets_[MAX_SOCKETS] = {};
+  size_t num_sockets_ = 0;
+  PortRoute ports_[MAX_PORTS] = {};
+  size_t num_ports_ = 0;
+  transport::shm::Channel * channels_[MAX_CHANNELS] = {};
+  size_t num_channels_ = 0;
+  RegistryPublisher * publisher_ = nullptr;
+
+  // Headroom of either transport header, and tailroom of the longest serial CRC
+  proton_framing_t framing_ = {};
+  uint8_t frame_flags_ = 0;
+  proton_endpoint_t selected_peers_[UINT8_MAX];
+  // Index of the socket each selected peer is sent through, MAX_SOCKETS for none
+  uint8_t peer_sockets_[UINT8_MAX];
+
+  // epoll backend buffers
+  uint8_t tx_buffer_[FRAME_BUFFER_SIZE];
+  proton_endpoint_t socket_peers_[UINT8_MAX];
+  uint8_t rx_buffers_[RECEIVE_BATCH][FRAME_BUFFER_SIZE];
+  transport::udp4::Datagram datagrams_[RECEIVE_BATCH];
+
+  // io_uring backend state. Its buffers are mapped by open: the provided buffer ring, then the
+  // receive buffers and the registered send slots.
+  IoUring ring_;
+  uint8_t * ring_buffers_ = nullptr;
+  size_t ring_buffers_size_ = 0;
+  io_uring_buf_ring * receive_ring_ = nullptr;
+  msghdr receive_msghdr_ = {};
+  // Completions each send slot waits for, it is free at 0
+  uint16_t slot_completions_[SEND_SLOTS] = {};
+  // Set when a message was left unsent for want of a free slot
+  bool slots_exhausted_ = false;
+  // The poll of the wakeup event in flight, its timeout and the generation tagging both.
+  // Completions of an earlier generation were cancelled and are ignored.
+  bool wakeup_armed_ = false;
+  uint64_t wakeup_deadline_ = 0;
+  uint32_t wakeup_generation_ = 0;
+  __kernel_timespec wakeup_timeout_ = {};
+
+#if PROTON_NODE_BUILDER
+  // Transports opened by open from a config
+  std::vector<std::unique_ptr<transport::udp4::Socket>> owned_sockets_;
+  std::vector<std::unique_ptr<transport::serial::Port>> owned_ports_;
+  std::vector<std::unique_ptr<transport::shm::Channel>> owned_channels_;
+#endif
+};
+
+}  // namespace proton
+
+#endif  // PROTON_RUNTIME_HPP
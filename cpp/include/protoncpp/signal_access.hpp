@@ -42,6 +42,29 @@
 namespace proton
 {
 
+/**
+ * Value of a flags signal, bit n holding flag n
+ */
+enum class Flags : uint64_t
+{
+};
+
+constexpr bool test_flag(Flags flags, uint8_t bit) noexcept
+{
+  return bit < PROTON_FLAGS_MAX_BITS && ((static_cast<uint64_t>(flags) >> bit) & 1u) != 0;
+}
+
+constexpr Flags with_flag(Flags flags, uint8_t bit, bool value) noexcept
+{
+  if (bit >= PROTON_FLAGS_MAX_BITS)
+  {
+    return flags;
+  }
+  const uint64_t mask = uint64_t{1} << bit;
+  const uint64_t bits = static_cast<uint64_t>(flags);
+  return static_cast<Flags>(value ? (bits | mask) : (bits & ~mask));
+}
+
 /**
  * @class SignalAccess provides type-safe access to signal values from the proton_core registry API.
  */
@@ -71,12 +94,56 @@ public:
   proton_status_e get(uint32_t id, bool & out) const noexcept;
   proton_status_e set(uint32_t id, bool value) noexcept;
 
+  proton_status_e get(uint32_t id, Flags & out) const noexcept;
+  proton_status_e set(uint32_t id, Flags value) noexcept;
+
+  proton_status_e get_flag(uint32_t id, uint8_t bit, bool & out) const noexcept;
+  proton_status_e set_flag(uint32_t id, uint8_t bit, bool value) noexcept;
+
   proton_status_e get(uint32_t id, char * buf, size_t cap, size_t & len) const noexcept;
   proton_status_e set(uint32_t id, const char * buf, size_t len) const noexcept;
 
   proton_status_e get(uint32_t id, uint8_t * buf, size_t cap, size_t & len) const noexcept;
   proton_status_e set(uint32_t id, const uint8_t * buf, size_t len) const noexcept;
 
+  // Accessors for signals resolved with proton_registry_resolve_signal
+
+  proton_status_e get(proton_signal_handle_t handle, double & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, double value) noexcept;
+
+  proton_status_e get(proton_signal_handle_t handle, float & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, float value) noexcept;
+
+  proton_status_e get(proton_signal_handle_t handle, int32_t & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, int32_t value) noexcept;
+
+  proton_status_e get(proton_signal_handle_t handle, int64_t & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, int64_t value) noexcept;
+
+  proton_status_e get(proton_signal_handle_t handle, uint32_t & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, uint32_t value) noexcept;
+
+  proton_status_e get(proton_signal_handle_t handle, uint64_t & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, uint64_t value) noexcept;
+
+  proton_status_e get(proton_signal_handle_t handle, bool & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, bool value) noexcept;
+
+  proton_status_e get(proton_signal_handle_t handle, Flags & out) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, Flags value) noexcept;
+
+  proton_status_e get_flag(proton_signal_handle_t handle, uint8_t bit, bool & out) const noexcept;
+  proton_status_e set_flag(proton_signal_handle_t handle, uint8_t bit, bool value) noexcept;
+
+  proton_status_e get(
+    proton_signal_handle_t handle, char * buf, size_t cap, size_t & len) const noexcept;
+  proton_status_e set(proton_signal_handle_t handle, const char * buf, size_t len) const noexcept;
+
+  proton_status_e get(
+    proton_signal_handle_t handle, uint8_t * buf, size_t cap, size_t & len) const noexcept;
+  proton_status_e set(
+    proton_signal_handle_t handle, const uint8_t * buf, size_t len) const noexcept;
+
 private:
   proton_registry_t * registry_;
 };
@@ -87,9 +154,156 @@ private:
 template <typename T>
 class Signal;
 
+namespace detail
+{
+// Helper trait to detect primitive signal types (types with direct SignalAccess support)
+template <typename T>
+struct is_primitive_signal_type
+: std::bool_constant<
+    std::is_same_v<T, double> || std::is_same_v<T, float> || std::is_same_v<T, int32_t> ||
+    std::is_same_v<T, int64_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t> ||
+    std::is_same_v<T, bool> || std::is_same_v<T, Flags>>
+{
+};
+
+template <typename T>
+inline constexpr bool is_primitive_signal_type_v = is_primitive_signal_type<T>::value;
+
+/**
+ * Registry type of an array signal of element type T, PROTON_INVALID_TYPE if there is none
+ */
+template <typename T>
+constexpr proton_signal_type_e array_type_of() noexcept
+{
+  if constexpr (std::is_same_v<T, double>)
+  {
+    return PROTON_DOUBLE_ARRAY;
+  }
+  else if constexpr (std::is_same_v<T, float>)
+  {
+    return PROTON_FLOAT_ARRAY;
+  }
+  else if constexpr (std::is_same_v<T, int32_t>)
+  {
+    return PROTON_INT32_ARRAY;
+  }
+  else if constexpr (std::is_same_v<T, int64_t>)
+  {
+    return PROTON_INT64_ARRAY;
+  }
+  else if constexpr (std::is_same_v<T, uint32_t>)
+  {
+    return PROTON_UINT32_ARRAY;
+  }
+  else if constexpr (std::is_same_v<T, uint64_t>)
+  {
+    return PROTON_UINT64_ARRAY;
+  }
+  else
+  {
+    return PROTON_INVALID_TYPE;
+  }
+}
+
+// Helper trait to detect array signal types, std::span of an array element type
+template <typename T>
+struct is_array_signal_type : std::false_type
+{
+};
+
+#if __cplusplus >= 202002L
+
+template <typename T>
+struct is_array_signal_type<std::span<T>>
+: std::bool_constant<array_type_of<T>() != PROTON_INVALID_TYPE>
+{
+};
+
+#endif  // __cplusplus >= 202002L
+
+template <typename T>
+inline constexpr bool is_array_signal_type_v = is_array_signal_type<T>::value;
+
+/**
+ * Registry type of a Signal<T>, PROTON_INVALID_TYPE if T is not a signal type
+ */
+template <typename T>
+constexpr proton_signal_type_e signal_type_of() noexcept
+{
+  if constexpr (std::is_same_v<T, double>)
+  {
+    return PROTON_DOUBLE;
+  }
+  else if constexpr (std::is_same_v<T, float>)
+  {
+    return PROTON_FLOAT;
+  }
+  else if constexpr (std::is_same_v<T, int32_t>)
+  {
+    return PROTON_INT32;
+  }
+  else if constexpr (std::is_same_v<T, int64_t>)
+  {
+    return PROTON_INT64;
+  }
+  else if constexpr (std::is_same_v<T, uint32_t>)
+  {
+    return PROTON_UINT32;
+  }
+  else if constexpr (std::is_same_v<T, uint64_t>)
+  {
+    return PROTON_UINT64;
+  }
+  else if constexpr (std::is_same_v<T, bool>)
+  {
+    return PROTON_BOOL;
+  }
+  else if constexpr (std::is_same_v<T, Flags>)
+  {
+    return PROTON_FLAGS;
+  }
+  else if constexpr (std::is_same_v<T, char *>)
+  {
+    return PROTON_STRING;
+  }
+  else if constexpr (std::is_same_v<T, uint8_t *>)
+  {
+    return PROTON_BYTES;
+  }
+  else if constexpr (std::is_pointer_v<T>)
+  {
+    // Array signals of a static registry, see SignalDef
+    return array_type_of<std::remove_pointer_t<T>>();
+  }
+#if __cplusplus >= 202002L
+  else if constexpr (is_array_signal_type_v<T>)
+  {
+    return array_type_of<typename T::element_type>();
+  }
+#endif  // __cplusplus >= 202002L
+#if PROTON_ENABLE_ALLOC
+  else if constexpr (std::is_same_v<T, std::string>)
+  {
+    return PROTON_STRING;
+  }
+  else if constexpr (std::is_same_v<T, std::vector<uint8_t>>)
+  {
+    return PROTON_BYTES;
+  }
+#endif  // PROTON_ENABLE_ALLOC
+  else
+  {
+    return PROTON_INVALID_TYPE;
+  }
+}
+}  // namespace detail
+
 /**
  * @brief Non-templated base class for Signal<T>, enabling storage in containers.
  *
+ * The signal is resolved into a handle when constructed, so accesses index the registry directly
+ * instead of looking the ID up every time.
+ *
  * Use type() to determine the actual signal type at runtime.
  * When PROTON_ENABLE_ALLOC is enabled, use as<T>() for safe dynamic_cast.
  * When disabled (for embedded applications), cast to Signal<T>* only when type() matches.
@@ -97,8 +311,16 @@ class Signal;
 class SignalBase
 {
 public:
-  constexpr SignalBase(proton_registry_t * registry, uint32_t id) noexcept
-  : registry_(registry), id_(id)
+  SignalBase(proton_registry_t * registry, uint32_t id) noexcept
+  : SignalBase(registry, id, PROTON_INVALID_TYPE)
+  {
+  }
+
+  /**
+   * @brief Wrap a signal that was already resolved, such as one found through its bundle.
+   */
+  SignalBase(proton_registry_t * registry, proton_signal_handle_t handle) noexcept
+  : registry_(registry), id_(registry->signal_registry[handle.index].id), handle_(handle)
   {
   }
 
@@ -127,8 +349,15 @@ public:
 
   uint32_t id() const noexcept { return id_; }
 
+  proton_signal_handle_t handle() const noexcept { return handle_; }
+
   signal_desc_t * desc() const noexcept
   {
+    if (handle_.type != PROTON_INVALID_TYPE)
+    {
+      return &registry_->signal_registry[handle_.index];
+    }
+    // Not resolved, either missing or registered with another type than expected
     return proton_registry_get_signal(registry_, id_, nullptr);
   }
 
@@ -139,26 +368,17 @@ public:
   }
 
 protected:
+  SignalBase(proton_registry_t * registry, uint32_t id, proton_signal_type_e type) noexcept
+  : registry_(registry), id_(id), handle_{UINT16_MAX, PROTON_INVALID_TYPE}
+  {
+    proton_registry_resolve_signal(registry, id, type, &handle_);
+  }
+
   proton_registry_t * registry_;
   uint32_t id_;
+  proton_signal_handle_t handle_;
 };
 
-namespace detail
-{
-// Helper trait to detect primitive signal types (types with direct SignalAccess support)
-template <typename T>
-struct is_primitive_signal_type
-: std::bool_constant<
-    std::is_same_v<T, double> || std::is_same_v<T, float> || std::is_same_v<T, int32_t> ||
-    std::is_same_v<T, int64_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t> ||
-    std::is_same_v<T, bool>>
-{
-};
-
-template <typename T>
-inline constexpr bool is_primitive_signal_type_v = is_primitive_signal_type<T>::value;
-}  // namespace detail
-
 /**
  * @class Signal typed wrapper around a SignalBase. Does not require RTTI, but if
  * RTTI is enabled, it can be safely stored as a SignalBase pointer and dynamically cast back to Signal<T>.
@@ -167,32 +387,49 @@ template <typename T>
 class Signal : public SignalBase
 {
 public:
-  constexpr explicit Signal(proton_registry_t * registry, uint32_t id) : SignalBase(registry, id) {}
+  explicit Signal(proton_registry_t * registry, uint32_t id) noexcept
+  : SignalBase(registry, id, detail::signal_type_of<T>())
+  {
+    static_assert(
+      detail::signal_type_of<T>() != PROTON_INVALID_TYPE, "Signal<T> needs a signal type");
+  }
 
   template <typename U = T, std::enable_if_t<detail::is_primitive_signal_type_v<U>, int> = 0>
   proton_status_e get(U & out) const noexcept
   {
-    return SignalAccess(registry_).get(id_, out);
+    return SignalAccess(registry_).get(handle_, out);
   }
 
   template <typename U = T, std::enable_if_t<detail::is_primitive_signal_type_v<U>, int> = 0>
   proton_status_e set(U value) noexcept
   {
-    return SignalAccess(registry_).set(id_, value);
+    return SignalAccess(registry_).set(handle_, value);
+  }
+
+  proton_status_e get_flag(uint8_t bit, bool & out) const noexcept
+  {
+    static_assert(std::is_same_v<T, Flags>, "get_flag is only valid for Signal<Flags>");
+    return SignalAccess(registry_).get_flag(handle_, bit, out);
+  }
+
+  proton_status_e set_flag(uint8_t bit, bool value) noexcept
+  {
+    static_assert(std::is_same_v<T, Flags>, "set_flag is only valid for Signal<Flags>");
+    return SignalAccess(registry_).set_flag(handle_, bit, value);
   }
 
   proton_status_e get(char * buf, size_t cap, size_t & len) const noexcept
   {
     static_assert(
       std::is_same_v<T, char *>, "get(char*, size_t, size_t&) is only valid for Signal<char*>");
-    return SignalAccess(registry_).get(id_, buf, cap, len);
+    return SignalAccess(registry_).get(handle_, buf, cap, len);
   }
 
   proton_status_e set(const char * buf, size_t len) noexcept
   {
     static_assert(
       std::is_same_v<T, char *>, "set(const char*, size_t) is only valid for Signal<char*>");
-    return SignalAccess(registry_).set(id_, buf, len);
+    return SignalAccess(registry_).set(handle_, buf, len);
   }
 
   proton_status_e get(uint8_t * buf, size_t cap, size_t & len) const noexcept
@@ -200,7 +437,7 @@ public:
     static_assert(
       std::is_same_v<T, uint8_t *>,
       "get(uint8_t*, size_t, size_t&) is only valid for Signal<uint8_t*>");
-    return SignalAccess(registry_).get(id_, buf, cap, len);
+    return SignalAccess(registry_).get(handle_, buf, cap, len);
   }
 
   proton_status_e set(const uint8_t * buf, size_t len) noexcept
@@ -208,7 +445,7 @@ public:
     static_assert(
       std::is_same_v<T, uint8_t *>,
       "set(const uint8_t*, size_t) is only valid for Signal<uint8_t*>");
-    return SignalAccess(registry_).set(id_, buf, len);
+    return SignalAccess(registry_).set(handle_, buf, len);
   }
 
 #if PROTON_ENABLE_ALLOC
@@ -223,7 +460,7 @@ public:
 
     size_t len;
     const proton_status_e status =
-      SignalAccess(registry_).get(id_, str.data(), str.capacity(), len);
+      SignalAccess(registry_).get(handle_, str.data(), str.capacity(), len);
 
     if (status == PROTON_OK && len > 0)
     {
@@ -238,7 +475,7 @@ public:
     static_assert(
       std::is_same_v<T, std::string>, "set(std::string&) is only valid for Signal<std::string>");
 
-    return SignalAccess(registry_).set(id_, str.c_str(), str.size() + 1);
+    return SignalAccess(registry_).set(handle_, str.c_str(), str.size() + 1);
   }
 
   proton_status_e get(std::vector<uint8_t> & buf) const noexcept
@@ -249,7 +486,7 @@ public:
 
     size_t len;
     const proton_status_e status =
-      SignalAccess(registry_).get(id_, buf.data(), buf.capacity(), len);
+      SignalAccess(registry_).get(handle_, buf.data(), buf.capacity(), len);
 
     if (status == PROTON_OK)
     {
@@ -265,7 +502,7 @@ public:
       std::is_same_v<T, std::vector<uint8_t>>,
       "set(std::vector<uint8_t>&) is only valid for Signal<std::vector<uint8_t>>");
 
-    return SignalAccess(registry_).set(id_, buf.data(), buf.size());
+    return SignalAccess(registry_).set(handle_, buf.data(), buf.size());
   }
 
 #endif  // PROTON_ENABLE_ALLOC
@@ -279,6 +516,61 @@ public:
 
   proton_status_e set(std::span<const uint8_t> buf) noexcept { return set(buf.data(), buf.size()); }
 
+  // Array signals, Signal<std::span<E>>. get and buffer hand out the registry storage itself, it
+  // is only valid until the registry next changes the signal.
+
+  /**
+   * View the current elements of an array signal without copying them
+   */
+  template <typename U = T, std::enable_if_t<detail::is_array_signal_type_v<U>, int> = 0>
+  proton_status_e get(std::span<const typename U::element_type> & out) const noexcept
+  {
+    const void * data = nullptr;
+    size_t count = 0;
+    const proton_status_e status =
+      proton_signal_handle_get_array(registry_, handle_, &data, &count);
+    if (status == PROTON_OK)
+    {
+      out = {static_cast<const typename U::element_type *>(data), count};
+    }
+    return status;
+  }
+
+  /**
+   * Copy elements into an array signal
+   */
+  template <typename U = T, std::enable_if_t<detail::is_array_signal_type_v<U>, int> = 0>
+  proton_status_e set(std::span<const typename U::element_type> values) noexcept
+  {
+    return proton_signal_handle_set_array(registry_, handle_, values.data(), values.size());
+  }
+
+  /**
+   * Storage of an array signal for its whole capacity, to fill in place before commit
+   */
+  template <typename U = T, std::enable_if_t<detail::is_array_signal_type_v<U>, int> = 0>
+  proton_status_e buffer(U & out) noexcept
+  {
+    void * data = nullptr;
+    size_t capacity = 0;
+    const proton_status_e status =
+      proton_signal_handle_array_buffer(registry_, handle_, &data, &capacity);
+    if (status == PROTON_OK)
+    {
+      out = {static_cast<typename U::element_type *>(data), capacity};
+    }
+    return status;
+  }
+
+  /**
+   * Set the number of elements written in place through buffer()
+   */
+  template <typename U = T, std::enable_if_t<detail::is_array_signal_type_v<U>, int> = 0>
+  proton_status_e commit(size_t count) noexcept
+  {
+    return proton_signal_handle_commit_array(registry_, handle_, count);
+  }
+
 #endif  // __cplusplus >= 202002L
 };
 
@@ -0,0 +1,601 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_STATIC_REGISTRY_HPP
+#define PROTON_STATIC_REGISTRY_HPP
+
+#include "proton/common.h"
+#include "proton/proton_config.h"
+#include "proton/registry.h"
+#include "protoncpp/signal_access.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace proton
+{
+
+namespace detail
+{
+constexpr pb_size_t signal_tag_of(proton_signal_type_e type) noexcept
+{
+  switch (type)
+  {
+    case PROTON_DOUBLE:
+      return proton_Signal_double_value_tag;
+    case PROTON_FLOAT:
+      return proton_Signal_float_value_tag;
+    case PROTON_INT32:
+      return proton_Signal_int32_value_tag;
+    case PROTON_INT64:
+      return proton_Signal_int64_value_tag;
+    case PROTON_UINT32:
+      return proton_Signal_uint32_value_tag;
+    case PROTON_UINT64:
+      return proton_Signal_uint64_value_tag;
+    case PROTON_BOOL:
+      return proton_Signal_bool_value_tag;
+    case PROTON_STRING:
+      return proton_Signal_string_value_tag;
+    case PROTON_BYTES:
+      return proton_Signal_bytes_value_tag;
+    case PROTON_FLAGS:
+      return proton_Signal_flags_value_tag;
+    case PROTON_DOUBLE_ARRAY:
+      return proton_Signal_double_array_value_tag;
+    case PROTON_FLOAT_ARRAY:
+      return proton_Signal_float_array_value_tag;
+    case PROTON_INT32_ARRAY:
+      return proton_Signal_int32_array_value_tag;
+    case PROTON_INT64_ARRAY:
+      return proton_Signal_int64_array_value_tag;
+    case PROTON_UINT32_ARRAY:
+      return proton_Signal_uint32_array_value_tag;
+    case PROTON_UINT64_ARRAY:
+      return proton_Signal_uint64_array_value_tag;
+    default:
+      return 0;
+  }
+}
+
+template <typename T, typename... Ts>
+inline constexpr bool is_one_of_v = (std::is_same_v<T, Ts> || ...);
+
+/**
+ * Position of T in Ts, or sizeof...(Ts) if it is not there
+ */
+template <typename T, typename... Ts>
+constexpr size_t index_of() noexcept
+{
+  constexpr bool matches[] = {std::is_same_v<T, Ts>..., true};
+  size_t i = 0;
+  while (!matches[i])
+  {
+    i++;
+  }
+  return i;
+}
+
+template <size_t N>
+constexpr bool ids_unique(const std::array<uint32_t, N> & ids) noexcept
+{
+  for (size_t i = 0; i < N; i++)
+  {
+    for (size_t j = i + 1; j < N; j++)
+    {
+      if (ids[i] == ids[j])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Compile-time versions of proton_lookup_index_hash, proton_lookup_index_capacity and the index
+// build in registry.c, which they must be kept in sync with
+
+constexpr uint32_t lookup_index_hash(uint32_t id) noexcept
+{
+  uint32_t hash = id * 2654435761u;
+  return hash ^ (hash >> 16);
+}
+
+constexpr uint16_t lookup_index_capacity(size_t count) noexcept
+{
+  size_t capacity = 1;
+  while (capacity < count * 2)
+  {
+    capacity <<= 1;
+  }
+  if (capacity > (1u << 15) || count >= PROTON_LOOKUP_INDEX_EMPTY)
+  {
+    return 0;
+  }
+  return static_cast<uint16_t>(capacity);
+}
+
+template <size_t Capacity, size_t N>
+constexpr std::array<uint16_t, Capacity> build_lookup_index(
+  const std::array<uint32_t, N> & ids) noexcept
+{
+  std::array<uint16_t, Capacity> slots{};
+  for (auto & slot : slots)
+  {
+    slot = PROTON_LOOKUP_INDEX_EMPTY;
+  }
+  if constexpr (Capacity > 0)
+  {
+    for (size_t i = 0; i < N; i++)
+    {
+      size_t slot = lookup_index_hash(ids[i]) & (Capacity - 1);
+      while (slots[slot] != PROTON_LOOKUP_INDEX_EMPTY)
+      {
+        slot = (slot + 1) & (Capacity - 1);
+      }
+      slots[slot] = static_cast<uint16_t>(i);
+    }
+  }
+  return slots;
+}
+
+template <typename Encoding>
+constexpr const proton_signal_encoding_t * encoding_of() noexcept
+{
+  if constexpr (std::is_void_v<Encoding>)
+  {
+    return nullptr;
+  }
+  else
+  {
+    return &Encoding::value;
+  }
+}
+}  // namespace detail
+
+/**
+ * Compile-time definition of a signal.
+ * @tparam T one of the scalar signal types, Flags, char * for a string, uint8_t * for bytes or a
+ * pointer to the element type of an array, such as double *
+ * @tparam Capacity size of a string or bytes signal, including the NUL terminator of a string, or
+ * number of elements of an array signal
+ * @tparam Encoding wire encoding of a float or double signal, a type with a static constexpr
+ * proton_signal_encoding_t named value, or void to send the value as it is
+ */
+template <uint32_t Id, typename T, size_t Capacity = 0, typename Encoding = void>
+struct SignalDef
+{
+  using value_type = T;
+  static constexpr uint32_t id = Id;
+  static constexpr proton_signal_type_e type = detail::signal_type_of<T>();
+  static constexpr bool is_array =
+    std::is_pointer_v<T> && type == detail::array_type_of<std::remove_pointer_t<T>>();
+  static constexpr bool is_buffer = type == PROTON_STRING || type == PROTON_BYTES || is_array;
+  static constexpr size_t capacity = Capacity;
+  static constexpr size_t element_size = is_array ? sizeof(std::remove_pointer_t<T>) : 1;
+  // Bytes of value storage the signal needs
+  static constexpr size_t storage_size = Capacity * element_size;
+  static constexpr const proton_signal_encoding_t * encoding = detail::encoding_of<Encoding>();
+
+  static_assert(
+    type != PROTON_INVALID_TYPE && std::is_scalar_v<T>,
+    "SignalDef type must be a scalar signal type, char *, uint8_t * or an array element pointer");
+  static_assert(
+    is_buffer == (Capacity > 0),
+    "String, bytes and array signals need a capacity, other signals cannot have one");
+  static_assert(storage_size <= UINT16_MAX, "Signal capacity must fit in 16 bits");
+  static_assert(
+    encoding == nullptr || type == PROTON_FLOAT || type == PROTON_DOUBLE,
+    "Only float and double signals can have an encoding");
+};
+
+/**
+ * Compile-time definition of a bundle, from the SignalDef of each of its signals
+ */
+template <uint32_t Id, typename... SignalDefs>
+struct BundleDef
+{
+  static constexpr uint32_t id = Id;
+  static constexpr size_t signal_count = sizeof...(SignalDefs);
+  static constexpr std::array<uint32_t, signal_count> signal_ids = {SignalDefs::id...};
+  static constexpr uint16_t slot_capacity = detail::lookup_index_capacity(signal_count);
+  static constexpr std::array<uint16_t, slot_capacity> signal_slots =
+    detail::build_lookup_index<slot_capacity>(signal_ids);
+
+  static_assert(signal_count <= UINT8_MAX, "A bundle can hold at most 255 signals");
+  static_assert(detail::ids_unique(signal_ids), "A bundle cannot hold the same signal twice");
+
+  /**
+   * Registry index of each signal of the bundle in a registry of the signals Registered
+   */
+  template <typename... Registered>
+  static constexpr std::array<uint16_t, signal_count> signal_indices = {
+    static_cast<uint16_t>(detail::index_of<SignalDefs, Registered...>())...};
+
+  template <typename... Registered>
+  static constexpr bool signals_registered =
+    (detail::is_one_of_v<SignalDefs, Registered...> && ...);
+};
+
+template <typename... SignalDefs>
+struct Signals
+{
+};
+
+template <typename... BundleDefs>
+struct Bundles
+{
+};
+
+template <typename SignalList, typename BundleList>
+class StaticRegistry;
+
+/**
+ * @class StaticRegistry registry whose signals and bundles are fixed at compile time.
+ * IDs, types and bundle membership are checked when the registry type is instantiated, and typed
+ * accesses compile down to a fixed offset into the signal table, without any lookup.
+ * registry() exposes the same storage as a proton_registry_t for the core encoder, decoder and
+ * node manager.
+ *
+ * Like the core signal accessors, get and set do not lock the registry.
+ */
+template <typename... S, typename... B>
+class StaticRegistry<Signals<S...>, Bundles<B...>>
+{
+public:
+  static constexpr size_t signal_count = sizeof...(S);
+  static constexpr size_t bundle_count = sizeof...(B);
+
+  static_assert(signal_count <= UINT16_MAX, "Too many signals");
+  static_assert(bundle_count <= UINT16_MAX, "Too many bundles");
+  static_assert(
+    detail::ids_unique(std::array<uint32_t, signal_count>{S::id...}), "Signal IDs must be unique");
+  static_assert(
+    detail::ids_unique(std::array<uint32_t, bundle_count>{B::id...}), "Bundle IDs must be unique");
+  static_assert(
+    (B::template signals_registered<S...> && ...),
+    "Every signal of a bundle must be in the registry with the same type and capacity");
+
+  StaticRegistry() noexcept
+  {
+    init_signals(std::index_sequence_for<S...>{});
+    init_bundles(std::index_sequence_for<B...>{});
+
+    registry_.bundle_table = bundle_table_.data();
+    registry_.bundle_count = static_cast<uint16_t>(bundle_count);
+    registry_.encode_decode_buffer = encode_decode_buffer_.data();
+    registry_.encode_decode_buffer_count = static_cast<uint8_t>(encode_decode_buffer_.size());
+    registry_.signal_registry = signal_table_.data();
+    registry_.signal_count = static_cast<uint16_t>(signal_count);
+    registry_.signal_scratch_buffer = scratch_buffer_.data();
+    registry_.signal_scratch_buffer_size = static_cast<uint16_t>(scratch_buffer_.size());
+    registry_.bundle_index = {bundle_index_slots.data(), bundle_index_capacity};
+    registry_.signal_index = {signal_index_slots.data(), signal_index_capacity};
+  }
+
+  // The registry view points into this object
+  StaticRegistry(const StaticRegistry &) = delete;
+  StaticRegistry & operator=(const StaticRegistry &) = delete;
+
+  proton_registry_t * registry() noexcept { return &registry_; }
+  const proton_registry_t * registry() const noexcept { return &registry_; }
+
+  /**
+   * Position of a signal in the signal table
+   */
+  template <typename Def>
+  static constexpr size_t index_of() noexcept
+  {
+    static_assert(detail::is_one_of_v<Def, S...>, "Signal is not part of this registry");
+    return detail::index_of<Def, S...>();
+  }
+
+  template <typename Def>
+  signal_desc_t & desc() noexcept
+  {
+    return signal_table_[index_of<Def>()];
+  }
+
+  template <typename Def>
+  const signal_desc_t & desc() const noexcept
+  {
+    return signal_table_[index_of<Def>()];
+  }
+
+  template <typename Def>
+  typename Def::value_type get() const noexcept
+  {
+    static_assert(!Def::is_buffer, "Use get(buf, cap, len) for string and bytes signals");
+    return member<typename Def::value_type>(desc<Def>().signal);
+  }
+
+  template <typename Def>
+  void set(typename Def::value_type value) noexcept
+  {
+    static_assert(!Def::is_buffer, "Use set(buf, len) for string and bytes signals");
+    signal_desc_t & d = desc<Def>();
+    if constexpr (std::is_same_v<typename Def::value_type, Flags>)
+    {
+      d.signal.signal.flags_value = static_cast<uint64_t>(value);
+    }
+    else
+    {
+      member<typename Def::value_type>(d.signal) = value;
+    }
+    d.version++;
+  }
+
+  /**
+   * Single flag of a flags signal, false for bits past PROTON_FLAGS_MAX_BITS
+   */
+  template <typename Def>
+  bool get_flag(uint8_t bit) const noexcept
+  {
+    static_assert(Def::type == PROTON_FLAGS, "get_flag is only valid for flags signals");
+    return test_flag(get<Def>(), bit);
+  }
+
+  /**
+   * Set or clear a single flag of a flags signal. Bits past PROTON_FLAGS_MAX_BITS are ignored.
+   */
+  template <typename Def>
+  void set_flag(uint8_t bit, bool value) noexcept
+  {
+    static_assert(Def::type == PROTON_FLAGS, "set_flag is only valid for flags signals");
+    if (bit < PROTON_FLAGS_MAX_BITS)
+    {
+      set<Def>(with_flag(get<Def>(), bit, value));
+    }
+  }
+
+  /**
+   * Copy a string (including its NUL terminator) or bytes signal into buf, as
+   * proton_signal_get_string and proton_signal_get_bytes do
+   */
+  template <typename Def>
+  proton_status_e get(typename Def::value_type buf, size_t cap, size_t & len) const noexcept
+  {
+    static_assert(Def::is_buffer, "Use get() for scalar signals");
+    const signal_desc_t & d = desc<Def>();
+    size_t size = d.value_size;
+    if constexpr (Def::type == PROTON_STRING)
+    {
+      size = strnlen(static_cast<const char *>(d.signal.signal.string_value), Def::capacity);
+      size += size < Def::capacity ? 1 : 0;
+    }
+    if (buf == nullptr)
+    {
+      return PROTON_NULL_PTR_ERROR;
+    }
+    // cap and len of an array signal count elements
+    if (cap < size / Def::element_size)
+    {
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+    memcpy(buf, d.signal.signal.string_value, size);
+    len = size / Def::element_size;
+    return PROTON_OK;
+  }
+
+#if __cplusplus >= 202002L
+
+  /**
+   * Elements of an array signal, viewed in place in the registry storage
+   */
+  template <typename Def>
+  std::span<const std::remove_pointer_t<typename Def::value_type>> view() const noexcept
+  {
+    static_assert(Def::is_array, "view() is only valid for array signals");
+    const signal_desc_t & d = desc<Def>();
+    return {
+      static_cast<const std::remove_pointer_t<typename Def::value_type> *>(
+        d.signal.signal.string_value),
+      d.value_size / Def::element_size};
+  }
+
+#endif  // __cplusplus >= 202002L
+
+  /**
+   * Set a string, bytes or array signal, as proton_signal_set_string, proton_signal_set_bytes
+   * and the array setters do. len of a string includes its NUL terminator, len of an array counts
+   * elements.
+   */
+  template <typename Def>
+  proton_status_e set(
+    std::add_pointer_t<const std::remove_pointer_t<typename Def::value_type>> buf,
+    size_t len) noexcept
+  {
+    static_assert(Def::is_buffer, "Use set(value) for scalar signals");
+    signal_desc_t & d = desc<Def>();
+    if (buf == nullptr && (Def::type == PROTON_STRING || len > 0))
+    {
+      return PROTON_NULL_PTR_ERROR;
+    }
+    if constexpr (Def::type == PROTON_STRING)
+    {
+      size_t string_len = strnlen(buf, len);
+      if (string_len == len)
+      {
+        return PROTON_ERROR;  // Not NUL-terminated within len
+      }
+      len = string_len + 1;
+    }
+    if (len > Def::capacity)
+    {
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+    if (len > 0)
+    {
+      memcpy(d.signal.signal.string_value, buf, len * Def::element_size);
+    }
+    d.value_size = static_cast<uint16_t>(len * Def::element_size);
+    d.version++;
+    return PROTON_OK;
+  }
+
+private:
+  static constexpr std::array<size_t, signal_count> storage_sizes = {S::storage_size...};
+
+  // Storage of each signal starts on a boundary that suits any array element type
+  static constexpr size_t storage_alignment = alignof(uint64_t);
+
+  static constexpr size_t max_bundle_signals = [] {
+    size_t max = 1;
+    for (size_t count : {size_t{0}, B::signal_count...})
+    {
+      max = count > max ? count : max;
+    }
+    return max;
+  }();
+
+  static constexpr uint16_t bundle_index_capacity = detail::lookup_index_capacity(bundle_count);
+  static constexpr uint16_t signal_index_capacity = detail::lookup_index_capacity(signal_count);
+  static constexpr std::array<uint16_t, bundle_index_capacity> bundle_index_slots =
+    detail::build_lookup_index<bundle_index_capacity>(
+      std::array<uint32_t, bundle_count>{B::id...});
+  static constexpr std::array<uint16_t, signal_index_capacity> signal_index_slots =
+    detail::build_lookup_index<signal_index_capacity>(
+      std::array<uint32_t, signal_count>{S::id...});
+
+  /**
+   * Offset of a string, bytes or array signal in the value and decode storage
+   */
+  static constexpr size_t storage_offset(size_t index) noexcept
+  {
+    size_t offset = 0;
+    for (size_t i = 0; i < index; i++)
+    {
+      offset += (storage_sizes[i] + storage_alignment - 1) & ~(storage_alignment - 1);
+    }
+    return offset;
+  }
+
+  static constexpr size_t total_storage = storage_offset(signal_count);
+
+  template <typename T>
+  static auto & member(proton_Signal & signal) noexcept
+  {
+    if constexpr (std::is_same_v<T, double>)
+    {
+      return signal.signal.double_value;
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+      return signal.signal.float_value;
+    }
+    else if constexpr (std::is_same_v<T, int32_t>)
+    {
+      return signal.signal.int32_value;
+    }
+    else if constexpr (std::is_same_v<T, int64_t>)
+    {
+      return signal.signal.int64_value;
+    }
+    else if constexpr (std::is_same_v<T, uint32_t>)
+    {
+      return signal.signal.uint32_value;
+    }
+    else if constexpr (std::is_same_v<T, uint64_t>)
+    {
+      return signal.signal.uint64_value;
+    }
+    else if constexpr (std::is_same_v<T, Flags>)
+    {
+      return signal.signal.flags_value;
+    }
+    else
+    {
+      return signal.signal.bool_value;
+    }
+  }
+
+  template <typename T>
+  static T member(const proton_Signal & signal) noexcept
+  {
+    return static_cast<T>(member<T>(const_cast<proton_Signal &>(signal)));
+  }
+
+  template <size_t... I>
+  void init_signals(std::index_sequence<I...>) noexcept
+  {
+    (init_signal<S>(signal_table_[I], storage_offset(I)), ...);
+  }
+
+  template <typename Def>
+  void init_signal(signal_desc_t & d, size_t offset) noexcept
+  {
+    d.id = Def::id;
+    d.type = Def::type;
+    d.signal.id = Def::id;
+    d.signal.which_signal = detail::signal_tag_of(Def::type);
+    d.encoding = Def::encoding;
+    if constexpr (Def::is_buffer)
+    {
+      // Arrays start out empty, strings and bytes take their whole capacity
+      d.signal.signal.string_value = &value_storage_[offset];
+      d.value_size = static_cast<uint16_t>(Def::is_array ? 0 : Def::storage_size);
+      d.capacity = static_cast<uint16_t>(Def::storage_size);
+      d.signal_decode_buffer = {&decode_storage_[offset], Def::storage_size};
+    }
+    else
+    {
+      d.value_size = sizeof(typename Def::value_type);
+      d.capacity = 0;
+      d.signal_decode_buffer = {nullptr, 0};
+    }
+  }
+
+  template <size_t... I>
+  void init_bundles(std::index_sequence<I...>) noexcept
+  {
+    (init_bundle<B>(bundle_table_[I]), ...);
+  }
+
+  template <typename Def>
+  static void init_bundle(bundle_desc_t & d) noexcept
+  {
+    d.bundle_id = Def::id;
+    d.producer_ids = {nullptr, 0};
+    d.consumer_ids = {nullptr, 0};
+    d.signal_ids = {Def::signal_ids.data(), static_cast<uint8_t>(Def::signal_count)};
+    d.signal_indices = Def::template signal_indices<S...>.data();
+    d.signal_slots = {Def::signal_slots.data(), Def::slot_capacity};
+    d.last_send_ms = 0;
+    d.period_ms = 0;
+    d.send_now = false;
+    d.callback = {nullptr, nullptr};
+    d.codec = nullptr;
+    d.delta = false;
+    d.keyframe_interval = 0;
+    d.sends_since_keyframe = 0;
+    d.sent_versions = nullptr;
+  }
+
+  std::array<signal_desc_t, signal_count> signal_table_{};
+  std::array<bundle_desc_t, bundle_count> bundle_table_{};
+  alignas(storage_alignment) std::array<uint8_t, total_storage> value_storage_{};
+  alignas(storage_alignment) std::array<uint8_t, total_storage> decode_storage_{};
+  std::array<proton_Signal, max_bundle_signals> encode_decode_buffer_{};
+  std::array<uint8_t, PROTON_SCRATCH_BUFFER_SIZE> scratch_buffer_{};
+  proton_registry_t registry_{};
+};
+
+}  // namespace proton
+
+#endif  // PROTON_STATIC_REGISTRY_HPP
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_TRANSPORT_BYTE_RING_HPP
+#define PROTON_TRANSPORT_BYTE_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace proton::transport
+{
+
+/**
+ * @brief Up to two contiguous regions of a ByteRing, the second one used when the region wraps
+ */
+template <typename T>
+struct RingRegions
+{
+  T * data[2];
+  size_t len[2];
+
+  size_t size() const noexcept { return len[0] + len[1]; }
+};
+
+/**
+ * @class ByteRing lock-free single producer, single consumer byte ring.
+ * The producer fills the free space in place (for instance with readv) and commits it, and the
+ * consumer parses the readable bytes in place and releases them. Bytes stay valid and unchanged
+ * until they are released.
+ * @tparam Capacity Size in bytes, a power of two
+ */
+template <size_t Capacity>
+class ByteRing
+{
+  static_assert(
+    Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+  static constexpr size_t CAPACITY = Capacity;
+
+  /**
+   * @brief Free space the producer may fill. Producer side.
+   */
+  RingRegions<uint8_t> writable() noexcept
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return regions<uint8_t>(head, Capacity - (head - tail));
+  }
+
+  /**
+   * @brief Make len bytes written to the writable regions readable. Producer side.
+   */
+  void commit(size_t len) noexcept
+  {
+    head_.store(head_.load(std::memory_order_relaxed) + len, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copy data into the ring
+   * @return number of bytes copied, less than len if the ring is full
+   */
+  size_t write(const uint8_t * data, size_t len) noexcept
+  {
+    RingRegions<uint8_t> free = writable();
+    size_t copied = 0;
+    for (size_t i = 0; i < 2 && copied < len; i++)
+    {
+      const size_t chunk = free.len[i] < len - copied ? free.len[i] : len - copied;
+      std::memcpy(free.data[i], data + copied, chunk);
+      copied += chunk;
+    }
+    commit(copied);
+    return copied;
+  }
+
+  /**
+   * @brief Bytes committed by the producer and not released yet. Consumer side.
+   */
+  RingRegions<const uint8_t> readable() const noexcept
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_acquire);
+    return regions<const uint8_t>(tail, head - tail);
+  }
+
+  /**
+   * @brief Hand len readable bytes back to the producer. Consumer side.
+   */
+  void release(size_t len) noexcept
+  {
+    tail_.store(tail_.load(std::memory_order_relaxed) + len, std::memory_order_release);
+  }
+
+  size_t size() const noexcept
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Drop every byte. Only safe while neither side is in use.
+   */
+  void clear() noexcept
+  {
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  template <typename T>
+  RingRegions<T> regions(size_t start, size_t len) const noexcept
+  {
+    const size_t offset = start & (Capacity - 1);
+    const size_t first = Capacity - offset < len ? Capacity - offset : len;
+    // The buffer is only written through writable regions, by the producer
+    T * data = const_cast<uint8_t *>(buffer_);
+    return {{data + offset, data}, {first, len - first}};
+  }
+
+  // Free-running positions, only ever increased. head_ is written by the producer and tail_ by
+  // the consumer, on separate cache lines so the two sides do not contend.
+  alignas(64) std::atomic<size_t> head_ = 0;
+  alignas(64) std::atomic<size_t> tail_ = 0;
+  alignas(64) uint8_t buffer_[Capacity];
+};
+
+}  // namespace proton::transport
+
+#endif  // PROTON_TRANSPORT_BYTE_RING_HPP
@@ -21,6 +21,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "proton/crc.h"
 #include "proton/transport.h"
 
 #if __cplusplus >= 202002L
@@ -32,8 +33,28 @@ namespace proton::transport::serial
 
 static constexpr uint8_t FRAME_HEADER_MAGIC_BYTE_0 = PROTON_FRAME_HEADER_MAGIC_BYTE_0;
 static constexpr uint8_t FRAME_HEADER_MAGIC_BYTE_1 = PROTON_FRAME_HEADER_MAGIC_BYTE_1;
+static constexpr uint8_t FRAME_HEADER_MAGIC_BYTE_1_COMPACT =
+  PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT;
+static constexpr uint8_t FRAME_HEADER_MAGIC_BYTE_1_CRC32C = PROTON_FRAME_HEADER_MAGIC_BYTE_1_CRC32C;
+static constexpr uint8_t FRAME_HEADER_MAGIC_BYTE_1_COMPACT_CRC32C =
+  PROTON_FRAME_HEADER_MAGIC_BYTE_1_COMPACT_CRC32C;
+static constexpr uint8_t FRAME_FLAG_COMPACT = PROTON_FRAME_FLAG_COMPACT;
+static constexpr uint8_t FRAME_FLAG_CRC32C = PROTON_FRAME_FLAG_CRC32C;
 static constexpr size_t FRAME_HEADER_LENGTH_OVERHEAD = PROTON_FRAME_HEADER_LENGTH_OVERHEAD;
 static constexpr size_t FRAME_CRC_OVERHEAD = PROTON_FRAME_CRC_OVERHEAD;
+static constexpr size_t FRAME_CRC32C_OVERHEAD = PROTON_FRAME_CRC32C_OVERHEAD;
+static constexpr uint16_t CRC16_INIT = PROTON_CRC16_INIT;
+static constexpr uint32_t CRC32C_INIT = PROTON_CRC32C_INIT;
+
+inline uint16_t crc16_update(uint16_t crc, const uint8_t * data, size_t len)
+{
+  return proton_crc16_update(crc, data, len);
+}
+
+inline uint32_t crc32c_update(uint32_t crc, const uint8_t * data, size_t len)
+{
+  return proton_crc32c_update(crc, data, len);
+}
 static constexpr size_t FRAME_HEADER_OVERHEAD = PROTON_FRAME_HEADER_OVERHEAD;
 static constexpr size_t FRAME_OVERHEAD = PROTON_FRAME_OVERHEAD;
 
@@ -42,6 +63,12 @@ inline proton_status_e fill_frame_header(uint8_t * header, const uint16_t payloa
   return proton_serial_fill_frame_header(header, payload_len);
 }
 
+inline proton_status_e fill_frame_header(
+  uint8_t * header, const uint16_t payload_len, const uint8_t flags)
+{
+  return proton_serial_fill_frame_header_flags(header, payload_len, flags);
+}
+
 inline proton_status_e fill_crc16(
   const uint8_t * payload, const uint16_t payload_len, uint8_t * crc)
 {
@@ -54,13 +81,73 @@ inline proton_status_e check_framed_payload(
   return proton_serial_check_framed_payload(payload, payload_len, frame_crc);
 }
 
+inline proton_status_e fill_crc32c(
+  const uint8_t * payload, const uint16_t payload_len, uint8_t * crc)
+{
+  return proton_serial_fill_crc32c(payload, payload_len, crc);
+}
+
+inline proton_status_e check_framed_payload_crc32c(
+  const uint8_t * payload, const uint16_t payload_len, const uint32_t frame_crc)
+{
+  return proton_serial_check_framed_payload_crc32c(payload, payload_len, frame_crc);
+}
+
 inline proton_status_e get_framed_payload_length(const uint8_t * framed_buf, uint16_t * length)
 {
   return proton_serial_get_framed_payload_length(framed_buf, length);
 }
 
+inline proton_status_e get_framed_payload_info(
+  const uint8_t * framed_buf, uint16_t * length, uint8_t * flags)
+{
+  return proton_serial_get_framed_payload_info(framed_buf, length, flags);
+}
+
+using parser_t = proton_serial_parser_t;
+using frame_t = proton_serial_frame_t;
+
+inline proton_status_e parser_init(
+  parser_t & parser, uint8_t * buffer, size_t buffer_len, uint16_t max_payload_len)
+{
+  return proton_serial_parser_init(&parser, buffer, buffer_len, max_payload_len);
+}
+
+inline void parser_reset(parser_t & parser)
+{
+  proton_serial_parser_reset(&parser);
+}
+
+inline proton_status_e parser_feed(
+  parser_t & parser, const uint8_t * data, size_t len, size_t & consumed, frame_t & frame)
+{
+  return proton_serial_parser_feed(&parser, data, len, &consumed, &frame);
+}
+
 #if __cplusplus >= 202002L
 
+inline proton_status_e parser_init(
+  parser_t & parser, std::span<uint8_t> buffer, uint16_t max_payload_len)
+{
+  return parser_init(parser, buffer.data(), buffer.size(), max_payload_len);
+}
+
+inline proton_status_e parser_feed(
+  parser_t & parser, std::span<const uint8_t> data, size_t & consumed, frame_t & frame)
+{
+  return parser_feed(parser, data.data(), data.size(), consumed, frame);
+}
+
+inline uint16_t crc16_update(uint16_t crc, std::span<const uint8_t> data)
+{
+  return crc16_update(crc, data.data(), data.size());
+}
+
+inline uint32_t crc32c_update(uint32_t crc, std::span<const uint8_t> data)
+{
+  return crc32c_update(crc, data.data(), data.size());
+}
+
 inline proton_status_e fill_crc16(
   std::span<const uint8_t> payload, std::span<uint8_t, FRAME_CRC_OVERHEAD> crc)
 {
@@ -73,12 +160,31 @@ inline proton_status_e check_framed_payload(
   return check_framed_payload(payload.data(), static_cast<uint16_t>(payload.size()), frame_crc);
 }
 
+inline proton_status_e fill_crc32c(
+  std::span<const uint8_t> payload, std::span<uint8_t, FRAME_CRC32C_OVERHEAD> crc)
+{
+  return fill_crc32c(payload.data(), static_cast<uint16_t>(payload.size()), crc.data());
+}
+
+inline proton_status_e check_framed_payload_crc32c(
+  std::span<const uint8_t> payload, const uint32_t frame_crc)
+{
+  return check_framed_payload_crc32c(
+    payload.data(), static_cast<uint16_t>(payload.size()), frame_crc);
+}
+
 inline proton_status_e get_framed_payload_length(
   std::span<const uint8_t> framed_buf, uint16_t & length)
 {
   return get_framed_payload_length(framed_buf.data(), &length);
 }
 
+inline proton_status_e get_framed_payload_info(
+  std::span<const uint8_t> framed_buf, uint16_t & length, uint8_t & flags)
+{
+  return get_framed_payload_info(framed_buf.data(), &length, &flags);
+}
+
 #endif
 
 }  // namespace proton::transport::serial
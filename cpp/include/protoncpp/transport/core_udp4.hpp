@@ -33,6 +33,7 @@ using Header = proton_udp4_header_t;
 using Version = proton_udp4_version_e;
 
 inline constexpr uint8_t CURRENT_VERSION = PROTON_CURRENT_UDP_VERSION;
+inline constexpr uint8_t FLAG_COMPACT = PROTON_UDP4_FLAG_COMPACT;
 
 inline proton_status_e fill_header(Header & header, uint8_t node_id = 0, uint8_t flags = 0)
 {
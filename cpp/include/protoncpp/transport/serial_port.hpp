@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_TRANSPORT_SERIAL_PORT_HPP
+#define PROTON_TRANSPORT_SERIAL_PORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "proton/node_manager.h"
+#include "protoncpp/transport/byte_ring.hpp"
+#include "protoncpp/transport/core_serial.hpp"
+
+#if PROTON_NODE_BUILDER
+#include "protoncpp/node_builder/config.hpp"
+#endif
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+namespace proton::transport::serial
+{
+
+/**
+ * @brief Line settings applied when a Port is opened
+ */
+struct PortOptions
+{
+  uint32_t baud_rate = 115200;
+  // Termios VMIN and VTIME. The port is read without blocking once poll reports data, so these
+  // only matter to callers that clear O_NONBLOCK on Port::fd.
+  uint8_t vmin = 0;
+  uint8_t vtime = 0;
+  // Ask the UART driver to push received bytes without delay (ASYNC_LOW_LATENCY). Devices that do
+  // not support it, such as ptys and most USB adapters, are left as they are.
+  bool low_latency = false;
+  // Frames announcing a longer payload are dropped, at most Port::MAX_PAYLOAD_LEN
+  uint16_t max_payload_len = 1024;
+  // Send frames with a CRC32C instead of a CRC16, see PROTON_FRAME_FLAG_CRC32C
+  bool crc32c = false;
+};
+
+/**
+ * @class Port Linux serial port for serial endpoints, opened raw and non-blocking.
+ * Received bytes are read into a lock-free ring, which the frame parser reads in place, so one
+ * thread may call read while another calls receive. Frames are sent with one writev of the header,
+ * the caller's payload and the CRC. Bytes the device does not take at once are queued and sent
+ * first by the next send or flush. Nothing is allocated, and errors are returned as
+ * proton_status_e.
+ */
+class Port
+{
+public:
+  static constexpr size_t RX_RING_SIZE = 8192;
+  // Room for a MAX_PAYLOAD_LEN frame while most of another is still queued
+  static constexpr size_t TX_BUFFER_SIZE = 8192;
+  static constexpr uint16_t MAX_PAYLOAD_LEN = 4096;
+
+  Port() = default;
+  ~Port();
+
+  Port(const Port &) = delete;
+  Port & operator=(const Port &) = delete;
+
+  /**
+   * @brief Open device in raw mode at options.baud_rate
+   * @return PROTON_CONNECT_ERROR if the device cannot be opened or configured, or the baud rate is
+   * not a standard one
+   */
+  proton_status_e open(const char * device, const PortOptions & options = {}) noexcept;
+
+  void close() noexcept;
+
+  bool is_open() const noexcept { return fd_ >= 0; }
+
+  int fd() const noexcept { return fd_; }
+
+  /**
+   * @brief Read what the device has into the receive ring, with a single readv
+   * @param timeout_ms How long to wait for data, 0 to return at once and -1 to block
+   * @param received Output number of bytes read, 0 on timeout or when the ring is full
+   * @return PROTON_READ_ERROR if the device fails or hangs up
+   */
+  proton_status_e read(size_t & received, int timeout_ms = 0) noexcept;
+
+  /**
+   * @brief Parse the next frame out of the receive ring
+   * @note The frame payload is only valid until the next call to receive. Frames failing their CRC
+   * or announcing too long a payload are skipped and counted in parser().
+   *
+   * @param frame Output frame, its payload is NULL if the ring holds no complete frame
+   */
+  proton_status_e receive(frame_t & frame) noexcept;
+
+  /**
+   * @brief Send payload in a frame, with one writev of the header, payload and CRC
+   * @return PROTON_INSUFFICIENT_BUFFER_ERROR, without sending anything, if the frame would not fit
+   * in the transmit queue should the device not take it. PROTON_WRITE_ERROR if the device fails.
+   */
+  proton_status_e send(const uint8_t * payload, uint16_t len, uint8_t flags = 0) noexcept;
+
+  /**
+   * @brief Send a complete frame, for instance one encoded by proton_node_update_framed with
+   * framing()
+   */
+  proton_status_e send_frame(const uint8_t * frame, size_t len) noexcept;
+
+  /**
+   * @brief Send the transmit queue
+   */
+  proton_status_e flush() noexcept;
+
+  /**
+   * @brief Bytes queued for sending, a caller waiting on fd should poll for POLLOUT while non-zero
+   */
+  size_t pending() const noexcept { return tx_end_ - tx_start_; }
+
+  /**
+   * @brief Framing matching the frames this port sends, for proton_node_update_framed
+   */
+  proton_framing_t framing() const noexcept
+  {
+    if (crc32c_)
+    {
+      return PROTON_SERIAL_FRAMING_CRC32C;
+    }
+    return PROTON_SERIAL_FRAMING;
+  }
+
+  const parser_t & parser() const noexcept { return parser_; }
+
+#if __cplusplus >= 202002L
+
+  proton_status_e send(std::span<const uint8_t> payload, uint8_t flags = 0) noexcept
+  {
+    if (payload.size() > UINT16_MAX)
+    {
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+    return send(payload.data(), static_cast<uint16_t>(payload.size()), flags);
+  }
+
+  proton_status_e send_frame(std::span<const uint8_t> frame) noexcept
+  {
+    return send_frame(frame.data(), frame.size());
+  }
+
+#endif
+
+#if PROTON_NODE_BUILDER
+
+  /**
+   * @brief Open the device of a serial endpoint of this node
+   */
+  proton_status_e open(
+    const node_builder::EndpointConfig & endpoint, const PortOptions & options = {}) noexcept;
+
+#endif
+
+private:
+  /**
+   * @brief Write queued bytes followed by the count buffers of parts, in one writev, and queue
+   * whatever the device did not take
+   */
+  proton_status_e write_parts(
+    const uint8_t * const * parts, const size_t * lens, size_t count) noexcept;
+
+  int fd_ = -1;
+  bool crc32c_ = false;
+
+  ByteRing<RX_RING_SIZE> rx_ring_;
+  // Bytes of the ring consumed by the last receive, released on the next one so that the frame
+  // it returned stays valid
+  size_t rx_consumed_ = 0;
+  parser_t parser_ = {};
+  uint8_t parser_buffer_[MAX_PAYLOAD_LEN];
+
+  uint8_t tx_buffer_[TX_BUFFER_SIZE];
+  size_t tx_start_ = 0;
+  size_t tx_end_ = 0;
+};
+
+}  // namespace proton::transport::serial
+
+#endif  // PROTON_TRANSPORT_SERIAL_PORT_HPP
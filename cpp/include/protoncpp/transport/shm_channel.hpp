@@ -0,0 +1,284 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_TRANSPORT_SHM_CHANNEL_HPP
+#define PROTON_TRANSPORT_SHM_CHANNEL_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include "proton/node_manager.h"
+
+#if PROTON_NODE_BUILDER
+#include <string>
+#include "protoncpp/node_builder/config.hpp"
+#endif
+
+namespace proton::transport::shm
+{
+
+/**
+ * @brief Geometry of the ring a Channel receives on
+ */
+struct RingOptions
+{
+  // Frames the ring holds, a power of two
+  uint32_t slots = 64;
+  // Largest frame in bytes
+  uint32_t slot_size = 16384;
+};
+
+/**
+ * @brief A frame read in place from a ring, valid until it is released
+ */
+struct Frame
+{
+  const uint8_t * payload;
+  size_t length;
+  // Node that sent the frame, and its PROTON_FRAME_FLAG_* bits
+  uint8_t node_id;
+  uint8_t flags;
+};
+
+/**
+ * @class Ring shared memory ring of fixed-size slots, produced into by any number of processes and
+ * consumed by one (a bounded MPSC queue after Vyukov). A producer claims a slot by advancing the
+ * enqueue position with a compare-and-swap, writes its frame straight into the slot and publishes
+ * it by storing the slot's sequence number. The consumer reads the frame in place and hands the
+ * slot back by storing the sequence number of its next turn, so nothing but the frame itself is
+ * ever copied. A producer that dies between claim and commit stalls the ring until it is
+ * recreated.
+ */
+class Ring
+{
+public:
+  /**
+   * @brief A slot claimed by a producer, to be committed
+   */
+  struct Slot
+  {
+    uint8_t * data;
+    size_t capacity;
+    uint64_t position;
+  };
+
+  Ring() = default;
+  ~Ring();
+
+  Ring(const Ring &) = delete;
+  Ring & operator=(const Ring &) = delete;
+
+  /**
+   * @brief Create the ring as its consumer, replacing any left behind under the same name
+   * @param name shm_open name, starting with a slash
+   */
+  proton_status_e create(const char * name, const RingOptions & options = {}) noexcept;
+
+  /**
+   * @brief Map an existing ring as a producer
+   * @return PROTON_CONNECT_ERROR if there is no ring of that name yet
+   */
+  proton_status_e attach(const char * name) noexcept;
+
+  /**
+   * @brief Unmap the ring. The consumer also marks it closed and removes its name.
+   */
+  void close() noexcept;
+
+  bool is_open() const noexcept { return header_ != nullptr; }
+
+  /**
+   * @brief Whether the consumer closed the ring, producers should attach again
+   */
+  bool is_closed() const noexcept;
+
+  size_t slot_size() const noexcept { return slot_size_; }
+
+  /**
+   * @return PROTON_INSUFFICIENT_BUFFER_ERROR if the ring is full
+   */
+  proton_status_e claim(Slot & slot) noexcept;
+
+  /**
+   * @brief Publish a claimed slot. A length of 0 gives the slot back unused.
+   * @return whether the consumer is asleep and has to be woken up
+   */
+  bool commit(const Slot & slot, size_t length, uint8_t node_id, uint8_t flags) noexcept;
+
+  /**
+   * @brief Oldest published frame, false if there is none
+   */
+  bool peek(Frame & frame) noexcept;
+
+  /**
+   * @brief Hand the frame returned by peek back to the producers
+   */
+  void release() noexcept;
+
+  /**
+   * @brief Tell producers the consumer is about to sleep, so that the next commit wakes it up
+   * @return false if a frame was published meanwhile, and the consumer should not sleep
+   */
+  bool prepare_sleep() noexcept;
+
+private:
+  struct Header;
+  struct SlotHeader;
+
+  SlotHeader * slot_header(uint64_t position) const noexcept;
+  uint8_t * slot_data(uint64_t position) const noexcept;
+  proton_status_e map(int fd, size_t size) noexcept;
+
+  Header * header_ = nullptr;
+  size_t size_ = 0;
+  size_t slot_size_ = 0;
+  size_t slot_stride_ = 0;
+  uint32_t mask_ = 0;
+  // Consumer only: its position, and the name it removes on close
+  uint64_t dequeue_position_ = 0;
+  bool consumer_ = false;
+  char name_[NAME_MAX + 1] = {};
+};
+
+/**
+ * @class Channel Linux shared memory transport for shm endpoints of nodes on one host.
+ * Each endpoint receives on a Ring named after it, and sends by writing into the rings of its
+ * peers, attached the first time they are sent to. A consumer about to sleep sets a flag in its
+ * ring, and only then does a producer ring its doorbell: a datagram to an abstract unix socket
+ * named after the ring, whose descriptor is fd(). Frames are decoded in place, and errors are
+ * returned as proton_status_e.
+ */
+class Channel
+{
+public:
+  static constexpr size_t MAX_PEERS = 16;
+  // Longest ring name, with its terminating null
+  static constexpr size_t MAX_NAME_LENGTH = 64;
+
+  Channel() = default;
+  ~Channel();
+
+  Channel(const Channel &) = delete;
+  Channel & operator=(const Channel &) = delete;
+
+  /**
+   * @brief Create the ring this channel receives on and bind its doorbell
+   * @return PROTON_CONNECT_ERROR if the name is invalid or another channel has it
+   */
+  proton_status_e open(const char * name, const RingOptions & options = {}) noexcept;
+
+  void close() noexcept;
+
+  bool is_open() const noexcept { return fd_ >= 0; }
+
+  /**
+   * @brief Doorbell descriptor, readable when a producer woke this channel up
+   */
+  int fd() const noexcept { return fd_; }
+
+  const char * name() const noexcept { return name_; }
+
+  /**
+   * @brief Set the ring name of a peer endpoint, replacing any name it had
+   */
+  proton_status_e add_peer(uint32_t node_id, uint32_t endpoint_id, const char * name) noexcept;
+
+  size_t num_peers() const noexcept { return num_peers_; }
+
+  bool has_peer(uint32_t node_id, uint32_t endpoint_id) const noexcept;
+
+  /**
+   * @brief Copy a frame into the ring of every peer
+   * @param node_id Node sending the frame, as the receiver gets it
+   * @return PROTON_INCORRECT_TARGET_ERROR if a peer has no name, PROTON_WRITE_ERROR if a ring
+   * cannot be attached or is full, and PROTON_INSUFFICIENT_BUFFER_ERROR if the frame is larger than
+   * its slots, after sending to the others. sent holds the number of peers sent to.
+   */
+  proton_status_e send(
+    const uint8_t * payload, size_t len, uint8_t node_id, uint8_t flags,
+    const proton_endpoint_t * peers, size_t num_peers, size_t & sent) noexcept;
+
+  /**
+   * @brief Claim a slot in the ring of a peer, for a frame to be encoded straight into it
+   */
+  proton_status_e claim(const proton_endpoint_t & peer, Ring::Slot & slot) noexcept;
+
+  /**
+   * @brief Publish a slot claimed with claim, waking the peer up if it sleeps. A length of 0 gives
+   * the slot back unused.
+   */
+  proton_status_e commit(
+    const proton_endpoint_t & peer, const Ring::Slot & slot, size_t len, uint8_t node_id,
+    uint8_t flags) noexcept;
+
+  /**
+   * @brief Read the next frame in place
+   * @return PROTON_OK with a null frame.payload if there is none
+   */
+  proton_status_e receive(Frame & frame) noexcept;
+
+  /**
+   * @brief Hand the frame returned by receive back to its ring
+   */
+  void release() noexcept;
+
+  /**
+   * @brief Empty the doorbell and ask producers to ring it, before waiting on fd()
+   * @return whether frames arrived meanwhile, and the caller should receive rather than wait
+   */
+  bool prepare_wait() noexcept;
+
+#if PROTON_NODE_BUILDER
+
+  /**
+   * @brief Open the ring named by the device of an endpoint of this node. A non-zero MTU sets the
+   * slot size.
+   */
+  proton_status_e open(
+    const node_builder::EndpointConfig & endpoint, const RingOptions & options = {}) noexcept;
+
+  /**
+   * @brief Add the shm endpoints of every node but target_name, the destination peers the node
+   * manager of target_name selects from
+   */
+  proton_status_e add_peers(
+    const node_builder::Config & config, const std::string & target_name) noexcept;
+
+#endif
+
+private:
+  struct Peer
+  {
+    uint32_t node_id;
+    uint32_t endpoint_id;
+    char name[MAX_NAME_LENGTH];
+    Ring ring;
+  };
+
+  Peer * find_peer(uint32_t node_id, uint32_t endpoint_id) noexcept;
+  proton_status_e attach(Peer & peer) noexcept;
+  void wake(const Peer & peer) noexcept;
+
+  int fd_ = -1;
+  char name_[MAX_NAME_LENGTH] = {};
+  Ring ring_;
+  Peer peers_[MAX_PEERS] = {};
+  size_t num_peers_ = 0;
+};
+
+}  // namespace proton::transport::shm
+
+#endif  // PROTON_TRANSPORT_SHM_CHANNEL_HPP
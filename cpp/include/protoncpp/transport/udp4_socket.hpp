@@ -0,0 +1,212 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROTON_TRANSPORT_UDP4_SOCKET_HPP
+#define PROTON_TRANSPORT_UDP4_SOCKET_HPP
+
+#include <netinet/in.h>
+#include <cstddef>
+#include <cstdint>
+#include "proton/node_manager.h"
+#include "protoncpp/transport/core_udp4.hpp"
+
+#if PROTON_NODE_BUILDER
+#include <string>
+#include "protoncpp/node_builder/config.hpp"
+#endif
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+namespace proton::transport::udp4
+{
+
+/**
+ * @brief A received datagram. data and capacity are set by the caller, the rest by Socket::receive
+ */
+struct Datagram
+{
+  uint8_t * data;
+  size_t capacity;
+  size_t length;
+  sockaddr_in from;
+  // With UDP GRO, the size of the datagrams the kernel coalesced into data, 0 otherwise. All but
+  // the last are segment_size bytes long.
+  size_t segment_size;
+  // Set when the datagram, or the datagrams coalesced with UDP GRO, did not fit in capacity. Only
+  // the first length bytes were received, and a datagram cut short must not be decoded.
+  bool truncated;
+};
+
+/**
+ * @brief Options applied when a Socket is opened
+ */
+struct SocketOptions
+{
+  // SO_RCVBUF size in bytes, 0 keeps the system default
+  int receive_buffer_size = 0;
+  // Let the kernel coalesce received datagrams (UDP_GRO), see Datagram::segment_size
+  bool gro = false;
+};
+
+/**
+ * @class Socket Linux UDP socket for udp4 endpoints.
+ * Sends one frame to every selected peer with a single sendmmsg, and receives with recvmmsg.
+ * Peers are looked up by the node and endpoint IDs of the proton_endpoint_t the node manager
+ * selects. Nothing is allocated, and errors are returned as proton_status_e.
+ */
+class Socket
+{
+public:
+  // Matches the peer count of proton_node_t
+  static constexpr size_t MAX_PEERS = UINT8_MAX;
+  // Most datagrams moved by one sendmmsg or recvmmsg call
+  static constexpr size_t MAX_BATCH = 64;
+
+  Socket() = default;
+  ~Socket();
+
+  Socket(const Socket &) = delete;
+  Socket & operator=(const Socket &) = delete;
+  Socket(Socket && other) noexcept;
+  Socket & operator=(Socket && other) noexcept;
+
+  /**
+   * @brief Open a non-blocking socket bound to ip and port. An empty or null ip binds to any
+   * address, and port 0 to an ephemeral port.
+   */
+  proton_status_e open(
+    const char * ip, uint16_t port, const SocketOptions & options = {}) noexcept;
+
+  void close() noexcept;
+
+  bool is_open() const noexcept { return fd_ >= 0; }
+
+  int fd() const noexcept { return fd_; }
+
+  /**
+   * @brief Whether the socket was opened with UDP GRO, and may receive coalesced datagrams
+   */
+  bool gro() const noexcept { return gro_; }
+
+  /**
+   * @brief Port the socket is bound to, useful after binding to port 0
+   */
+  uint16_t port() const noexcept;
+
+  /**
+   * @brief Set the address of a peer endpoint, replacing any address it had
+   */
+  proton_status_e add_peer(
+    uint32_t node_id, uint32_t endpoint_id, const char * ip, uint16_t port) noexcept;
+
+  size_t num_peers() const noexcept { return num_peers_; }
+
+  bool has_peer(uint32_t node_id, uint32_t endpoint_id) const noexcept
+  {
+    return find_peer(node_id, endpoint_id) != nullptr;
+  }
+
+  /**
+   * @brief Address of a peer endpoint, valid until the peers change. nullptr if it has none.
+   */
+  const sockaddr_in * peer_address(uint32_t node_id, uint32_t endpoint_id) const noexcept
+  {
+    const Peer * peer = find_peer(node_id, endpoint_id);
+    return peer != nullptr ? &peer->address : nullptr;
+  }
+
+  /**
+   * @brief Send one frame to every peer, in as few sendmmsg calls as possible
+   * @return PROTON_INCORRECT_TARGET_ERROR if a peer has no address, after sending to the others.
+   * PROTON_WRITE_ERROR if the socket fails, with sent holding the number of peers sent to.
+   */
+  proton_status_e send(
+    const uint8_t * frame, size_t len, const proton_endpoint_t * peers, size_t num_peers,
+    size_t & sent) noexcept;
+
+  /**
+   * @brief Send several segment_size datagrams, the last one possibly shorter, to one peer.
+   * With gso the kernel splits them (UDP_SEGMENT) from a single send, otherwise they are sent with
+   * one sendmmsg.
+   */
+  proton_status_e send_segments(
+    const uint8_t * data, size_t len, size_t segment_size, const proton_endpoint_t & peer,
+    bool gso = false) noexcept;
+
+  /**
+   * @brief Receive up to count datagrams with one recvmmsg
+   * @param timeout_ms How long to wait for the first datagram, 0 to return at once and -1 to block
+   * @return PROTON_OK with received 0 on timeout, PROTON_READ_ERROR if the socket fails
+   */
+  proton_status_e receive(
+    Datagram * datagrams, size_t count, size_t & received, int timeout_ms = 0) noexcept;
+
+#if __cplusplus >= 202002L
+
+  proton_status_e send(
+    std::span<const uint8_t> frame, std::span<const proton_endpoint_t> peers,
+    size_t & sent) noexcept
+  {
+    return send(frame.data(), frame.size(), peers.data(), peers.size(), sent);
+  }
+
+  proton_status_e receive(
+    std::span<Datagram> datagrams, size_t & received, int timeout_ms = 0) noexcept
+  {
+    return receive(datagrams.data(), datagrams.size(), received, timeout_ms);
+  }
+
+#endif
+
+#if PROTON_NODE_BUILDER
+
+  /**
+   * @brief Open a socket bound to the ip and port of an endpoint of this node
+   */
+  proton_status_e open(
+    const node_builder::EndpointConfig & endpoint, const SocketOptions & options = {}) noexcept;
+
+  /**
+   * @brief Add the udp4 endpoints of every node but target_name, the destination peers the node
+   * manager of target_name selects from
+   */
+  proton_status_e add_peers(
+    const node_builder::Config & config, const std::string & target_name) noexcept;
+
+#endif
+
+private:
+  struct Peer
+  {
+    uint32_t node_id;
+    uint32_t endpoint_id;
+    sockaddr_in address;
+  };
+
+  Peer * find_peer(uint32_t node_id, uint32_t endpoint_id) noexcept;
+  const Peer * find_peer(uint32_t node_id, uint32_t endpoint_id) const noexcept;
+
+  int fd_ = -1;
+  bool gro_ = false;
+  Peer peers_[MAX_PEERS] = {};
+  size_t num_peers_ = 0;
+};
+
+}  // namespace proton::transport::udp4
+
+#endif  // PROTON_TRANSPORT_UDP4_SOCKET_HPP
@@ -36,4 +36,11 @@ void BundleAccess::set_callback(proton_bundle_cb_f cb, void * ctx) noexcept
   proton_registry_set_bundle_callback(registry_, id_, cb, ctx);
 }
 
+proton_status_e BundleAccess::snapshot(
+  proton_signal_value_t * values, size_t capacity, uint8_t * buffer, size_t buffer_len,
+  size_t & count) const noexcept
+{
+  return proton_bundle_snapshot(registry_, id_, values, capacity, buffer, buffer_len, &count);
+}
+
 }  // namespace proton
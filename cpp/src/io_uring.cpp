@@ -0,0 +1,292 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "protoncpp/io_uring.hpp"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace proton
+{
+
+namespace
+{
+
+int io_uring_setup(uint32_t entries, io_uring_params * params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+  return static_cast<int>(
+    ::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(int fd, uint32_t opcode, const void * arg, uint32_t nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+uint32_t * ring_field(void * ring, uint32_t offset)
+{
+  return reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(ring) + offset);
+}
+
+// Operations the runtime submits
+constexpr uint8_t REQUIRED_OPS[] = {
+  IORING_OP_POLL_ADD, IORING_OP_RECVMSG, IORING_OP_SEND_ZC, IORING_OP_LINK_TIMEOUT,
+  IORING_OP_ASYNC_CANCEL};
+
+}  // namespace
+
+IoUring::~IoUring()
+{
+  close();
+}
+
+bool IoUring::supported() noexcept
+{
+  IoUring ring;
+  if (ring.open(4) != PROTON_OK)
+  {
+    return false;
+  }
+
+  // The probe is followed by one entry per operation
+  alignas(io_uring_probe) uint8_t buffer[
+    sizeof(io_uring_probe) + (UINT8_MAX + 1) * sizeof(io_uring_probe_op)] = {};
+  io_uring_probe * probe = reinterpret_cast<io_uring_probe *>(buffer);
+  if (io_uring_register(ring.fd_, IORING_REGISTER_PROBE, probe, UINT8_MAX + 1) < 0)
+  {
+    return false;
+  }
+
+  // Zero-copy sends came with multishot recvmsg, so the kernel has both
+  for (uint8_t op : REQUIRED_OPS)
+  {
+    if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+proton_status_e IoUring::open(uint32_t entries) noexcept
+{
+  close();
+
+  io_uring_params params = {};
+  params.flags = IORING_SETUP_COOP_TASKRUN;
+  fd_ = io_uring_setup(entries, &params);
+  if (fd_ < 0 && errno == EINVAL)
+  {
+    // Kernels before 5.19 do not know the flag
+    params = {};
+    fd_ = io_uring_setup(entries, &params);
+  }
+  if (fd_ < 0)
+  {
+    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+  }
+  if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_NODROP))
+  {
+    close();
+    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+  }
+
+  // Both rings share one mapping
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  const size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  sq_ring_size_ = sq_ring_size_ > cq_size ? sq_ring_size_ : cq_size;
+  void * sq_ring = ::mmap(
+    nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+    IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED)
+  {
+    close();
+    return PROTON_ERROR;
+  }
+  sq_ring_ = sq_ring;
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void * sqes = ::mmap(
+    nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+  {
+    close();
+    return PROTON_ERROR;
+  }
+  sqes_ = static_cast<io_uring_sqe *>(sqes);
+  cq_ring_ = sq_ring_;
+
+  sq_head_ = ring_field(sq_ring_, params.sq_off.head);
+  sq_tail_ = ring_field(sq_ring_, params.sq_off.tail);
+  sq_mask_ = *ring_field(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = *ring_field(sq_ring_, params.sq_off.ring_entries);
+  sq_array_ = ring_field(sq_ring_, params.sq_off.array);
+  sq_queued_ = 0;
+
+  cq_head_ = ring_field(cq_ring_, params.cq_off.head);
+  cq_tail_ = ring_field(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *ring_field(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe *>(static_cast<uint8_t *>(cq_ring_) + params.cq_off.cqes);
+
+  return PROTON_OK;
+}
+
+void IoUring::close() noexcept
+{
+  if (sqes_ != nullptr)
+  {
+    ::munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (sq_ring_ != nullptr)
+  {
+    ::munmap(sq_ring_, sq_ring_size_);
+    sq_ring_ = nullptr;
+    cq_ring_ = nullptr;
+  }
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+io_uring_sqe * IoUring::get_sqe() noexcept
+{
+  if (!is_open())
+  {
+    return nullptr;
+  }
+
+  uint32_t tail = *sq_tail_ + sq_queued_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+  {
+    if (submit() != PROTON_OK)
+    {
+      return nullptr;
+    }
+    tail = *sq_tail_ + sq_queued_;
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+    {
+      return nullptr;
+    }
+  }
+
+  const uint32_t index = tail & sq_mask_;
+  sq_array_[index] = index;
+  sq_queued_++;
+  io_uring_sqe * sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+uint32_t IoUring::space_left() const noexcept
+{
+  return sq_entries_ - (*sq_tail_ + sq_queued_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE));
+}
+
+proton_status_e IoUring::submit(uint32_t wait_nr) noexcept
+{
+  if (!is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+
+  // Publish the queued entries, the kernel reads them once the tail is stored. Entries a failed
+  // submit left in the ring are counted again.
+  const uint32_t tail = *sq_tail_ + sq_queued_;
+  __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+  sq_queued_ = 0;
+  const uint32_t to_submit = tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+
+  const uint32_t flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+  if (io_uring_enter(fd_, to_submit, wait_nr, flags) < 0)
+  {
+    if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+    {
+      return PROTON_OK;
+    }
+    return PROTON_ERROR;
+  }
+  return PROTON_OK;
+}
+
+const io_uring_cqe * IoUring::peek_cqe() noexcept
+{
+  const uint32_t head = *cq_head_;
+  if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+  {
+    return nullptr;
+  }
+  return &cqes_[head & cq_mask_];
+}
+
+void IoUring::cqe_seen() noexcept
+{
+  __atomic_store_n(cq_head_, *cq_head_ + 1, __ATOMIC_RELEASE);
+}
+
+proton_status_e IoUring::register_buffers(const iovec * buffers, uint32_t count) noexcept
+{
+  if (io_uring_register(fd_, IORING_REGISTER_BUFFERS, buffers, count) < 0)
+  {
+    return PROTON_ERROR;
+  }
+  return PROTON_OK;
+}
+
+proton_status_e IoUring::register_buffer_ring(
+  io_uring_buf_ring * ring, uint16_t entries, uint16_t group) noexcept
+{
+  io_uring_buf_reg reg = {};
+  reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+  reg.ring_entries = entries;
+  reg.bgid = group;
+  ring->tail = 0;
+  if (io_uring_register(fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+  {
+    return PROTON_ERROR;
+  }
+  return PROTON_OK;
+}
+
+void IoUring::add_buffer(
+  io_uring_buf_ring * ring, uint16_t entries, void * data, uint32_t len, uint16_t id,
+  uint16_t offset) noexcept
+{
+  // Indexed from the ring itself: in C++ the header's flexible array of buffers does not start at
+  // offset 0, as it does for the kernel
+  io_uring_buf * bufs = reinterpret_cast<io_uring_buf *>(ring);
+  io_uring_buf & buf = bufs[(ring->tail + offset) & (entries - 1)];
+  buf.addr = reinterpret_cast<uint64_t>(data);
+  buf.len = len;
+  buf.bid = id;
+}
+
+void IoUring::advance_buffer_ring(io_uring_buf_ring * ring, uint16_t count) noexcept
+{
+  __atomic_store_n(&ring->tail, static_cast<uint16_t>(ring->tail + count), __ATOMIC_RELEASE);
+}
+
+}  // namespace proton
@@ -58,8 +58,10 @@ static SignalConfig parse_signal(const ConfigNode & node)
   auto value_key = node[keys::VALUE];
   signal_config.has_default_value = value_key.is_defined();
 
+  proton_signal_type_e signal_type = string_to_signal_type(signal_config.type_string.c_str());
+  bool is_array_type = proton_is_array_type(signal_type);
   bool is_capacity_type = signal_config.type_string == value_types::BYTES ||
-                          signal_config.type_string == value_types::STRING;
+                          signal_config.type_string == value_types::STRING || is_array_type;
 
   auto capacity_key = node[keys::CAPACITY];
   if (capacity_key.is_defined())
@@ -71,6 +73,74 @@ static SignalConfig parse_signal(const ConfigNode & node)
     signal_config.capacity = 0;
   }
 
+  auto bits_key = node[keys::BITS];
+  if (bits_key.is_defined())
+  {
+    if (signal_config.type_string != value_types::FLAGS)
+    {
+      throw NodeBuilderException(
+        "Error in signal " + signal_config.name + ": only flags signals can name bits");
+    }
+    if (bits_key.size() > PROTON_FLAGS_MAX_BITS)
+    {
+      std::stringstream ss;
+      ss << "Error in signal " << signal_config.name << ": " << bits_key.size()
+         << " bits, at most " << PROTON_FLAGS_MAX_BITS << " fit";
+      throw NodeBuilderException(ss.str());
+    }
+    for (const auto & bit : bits_key)
+    {
+      std::string bit_name = bit.as_string();
+      if (std::find(signal_config.bits.begin(), signal_config.bits.end(), bit_name) !=
+          signal_config.bits.end())
+      {
+        throw NodeBuilderException(
+          "Error in signal " + signal_config.name + ": duplicate bit " + bit_name);
+      }
+      signal_config.bits.push_back(std::move(bit_name));
+    }
+  }
+
+  auto encoding_key = node[keys::ENCODING];
+  auto scale_key = node[keys::SCALE];
+  auto offset_key = node[keys::OFFSET];
+  if (encoding_key.is_defined() || scale_key.is_defined() || offset_key.is_defined())
+  {
+    if (signal_type != PROTON_DOUBLE && signal_type != PROTON_FLOAT)
+    {
+      throw NodeBuilderException(
+        "Error in signal " + signal_config.name + ": only float and double signals can be encoded");
+    }
+
+    // A scale on its own is enough to quantize a signal
+    signal_config.encoding =
+      encoding_key.is_defined() ? encoding_key.as_string() : std::string(encodings::QUANTIZED);
+    if (signal_config.encoding == encodings::QUANTIZED)
+    {
+      if (!scale_key.is_defined() || scale_key.as_double() == 0.0)
+      {
+        throw NodeBuilderException(
+          "Error in signal " + signal_config.name + ": a quantized signal needs a nonzero scale");
+      }
+      signal_config.scale = scale_key.as_double();
+      signal_config.offset = offset_key.is_defined() ? offset_key.as_double() : 0.0;
+    }
+    else if (signal_config.encoding == encodings::FLOAT16)
+    {
+      if (scale_key.is_defined() || offset_key.is_defined())
+      {
+        throw NodeBuilderException(
+          "Error in signal " + signal_config.name +
+          ": only a quantized signal can have a scale and offset");
+      }
+    }
+    else
+    {
+      throw NodeBuilderException(
+        "Error in signal " + signal_config.name + ": unknown encoding " + signal_config.encoding);
+    }
+  }
+
   if (signal_config.has_default_value)
   {
     signal_config.value = value_key.value();
@@ -94,7 +164,7 @@ static SignalConfig parse_signal(const ConfigNode & node)
     }
     else if (value_key.is_sequence())
     {
-      if (signal_config.type_string == value_types::BYTES)
+      if (signal_config.type_string == value_types::BYTES || is_array_type)
       {
         if (signal_config.capacity == 0)
         {
@@ -112,7 +182,7 @@ static SignalConfig parse_signal(const ConfigNode & node)
       {
         throw NodeBuilderException(
           "Error in signal " + signal_config.name +
-          ": only bytes type signals can have a sequence as a default value");
+          ": only bytes and array type signals can have a sequence as a default value");
       }
     }
   }
@@ -124,6 +194,17 @@ static SignalConfig parse_signal(const ConfigNode & node)
     throw NodeBuilderException(ss.str());
   }
 
+  // Array storage is sized in bytes, which must fit the 16 bit capacity of the registry
+  if (
+    is_array_type &&
+    size_t{signal_config.capacity} * proton_array_element_size(signal_type) > UINT16_MAX)
+  {
+    std::stringstream ss;
+    ss << "Error in signal " << signal_config.name << ": " << signal_config.capacity
+       << " elements do not fit in an array signal";
+    throw NodeBuilderException(ss.str());
+  }
+
   return signal_config;
 }
 
@@ -189,6 +270,26 @@ static BundleConfig parse_bundle(const ConfigNode & node)
     bundle_config.period_ms = period_node.as_uint32();
   }
 
+  bundle_config.delta = false;
+  auto delta_node = node[keys::DELTA];
+  if (delta_node.is_defined())
+  {
+    bundle_config.delta = delta_node.as_bool();
+  }
+
+  bundle_config.keyframe_interval = 10;
+  auto keyframe_node = node[keys::KEYFRAME_INTERVAL];
+  if (keyframe_node.is_defined())
+  {
+    uint32_t keyframe_interval = keyframe_node.as_uint32();
+    if (keyframe_interval > UINT16_MAX)
+    {
+      throw NodeBuilderException(
+        "Bundle " + bundle_config.name + " keyframe_interval must be between 0 and 65535");
+    }
+    bundle_config.keyframe_interval = static_cast<uint16_t>(keyframe_interval);
+  }
+
   return bundle_config;
 }
 
@@ -225,11 +326,31 @@ static EndpointConfig parse_endpoint(const ConfigNode & node)
     }
     endpoint_config.device = device_node.as_string();
   }
+  else if (endpoint_config.type == transport_types::SHM)
+  {
+    // The device is the name of the shared memory segment the endpoint receives on
+    if (!device_node)
+    {
+      throw NodeBuilderException("shm endpoints require a device");
+    }
+    endpoint_config.device = device_node.as_string();
+  }
   else
   {
     throw NodeBuilderException("Endpoint type " + endpoint_config.type + " is not a valid type");
   }
 
+  const auto mtu_node = node[keys::MTU];
+  if (mtu_node)
+  {
+    uint32_t mtu = mtu_node.as_uint32();
+    if (mtu > UINT16_MAX)
+    {
+      throw NodeBuilderException("Endpoint MTU must be between 0 and 65535");
+    }
+    endpoint_config.mtu = static_cast<uint16_t>(mtu);
+  }
+
   return endpoint_config;
 }
 
@@ -249,6 +370,13 @@ static NodeConfig parse_node(const ConfigNode & node)
   node_config.name = node_name.as_string();
   node_config.id = node_id.as_uint32();
 
+  node_config.compact = false;
+  auto compact_node = node[keys::COMPACT];
+  if (compact_node.is_defined())
+  {
+    node_config.compact = compact_node.as_bool();
+  }
+
   if (endpoints.is_sequence())
   {
     for (const auto & endpoint : endpoints)
@@ -23,6 +23,7 @@
 #include "protoncpp/node_builder/generator.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <optional>
 #include <vector>
 
@@ -103,6 +104,74 @@ void validate(const Config & config)
   find_duplicates<std::string>(node_names, "node names");
 }
 
+uint32_t compute_schema_hash(const Config & config)
+{
+  if (config.schema_hash != 0)
+  {
+    return config.schema_hash;
+  }
+
+  // 32-bit FNV-1a over the same bytes as generator_scripts/schema_hash.py
+  uint32_t hash = 0x811C9DC5u;
+  const auto add = [&hash](uint64_t value, size_t size)
+  {
+    for (size_t i = 0; i < size; i++)
+    {
+      hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * 0x01000193u;
+    }
+  };
+
+  std::map<uint32_t, const SignalConfig *> signals;
+  for (const auto & signal : config.signals)
+  {
+    signals[signal.id] = &signal;
+  }
+
+  std::vector<const BundleConfig *> bundles;
+  for (const auto & bundle : config.bundles)
+  {
+    bundles.push_back(&bundle);
+  }
+  std::sort(
+    bundles.begin(), bundles.end(),
+    [](const BundleConfig * a, const BundleConfig * b) { return a->id < b->id; });
+
+  for (const auto * bundle : bundles)
+  {
+    add(bundle->id, 4);
+    add(bundle->delta ? 1 : 0, 1);
+    add(static_cast<uint32_t>(bundle->signals.size()), 2);
+    for (const auto & signal_id : bundle->signals)
+    {
+      if (!signals.contains(signal_id))
+      {
+        throw NodeBuilderException(
+          std::format("Bundle {} references unknown signal {}", bundle->name, signal_id));
+      }
+      const SignalConfig & signal = *signals[signal_id];
+      add(signal_id, 4);
+      if (signal.encoding == encodings::QUANTIZED)
+      {
+        // Peers must agree on the quantization to read each other's values
+        add(proton_Signal_quantized_value_tag, 1);
+        add(std::bit_cast<uint64_t>(signal.scale), 8);
+        add(std::bit_cast<uint64_t>(signal.offset), 8);
+      }
+      else if (signal.encoding == encodings::FLOAT16)
+      {
+        add(proton_Signal_half_value_tag, 1);
+      }
+      else
+      {
+        add(proton_get_tag_from_type(string_to_signal_type(signal.type_string.c_str())), 1);
+      }
+    }
+  }
+
+  // 0 is reserved for an unknown schema
+  return hash != 0 ? hash : 1;
+}
+
 Config filter_for_target(const Config & config, const std::string & target_name)
 {
   validate(config);
@@ -113,6 +182,7 @@ Config filter_for_target(const Config & config, const std::string & target_name)
   }
 
   Config filtered_config = Config();
+  filtered_config.schema_hash = compute_schema_hash(config);
 
   filtered_config.nodes.insert({target_name, config.nodes.at(target_name)});
 
@@ -187,12 +257,58 @@ static proton_transport_type_e string_to_transport(const std::string & t_type)
   {
     return TRANSPORT_TYPE_SERIAL;
   }
+  else if (t_type == transport_types::SHM)
+  {
+    return TRANSPORT_TYPE_SHM;
+  }
   else
   {
     throw NodeBuilderException(std::format("Transport type is invalid: {}", t_type));
   }
 }
 
+template <typename T>
+static void append_array_element(uint8_t *& out, T value)
+{
+  std::memcpy(out, &value, sizeof(value));
+  out += sizeof(value);
+}
+
+/**
+ * Write the default value of an array signal into its value buffer
+ * @return size of the default value in bytes
+ */
+static uint16_t set_array_default(
+  proton_signal_type_e type, const ConfigNode & value_node, uint8_t * data)
+{
+  uint8_t * out = data;
+  for (const auto & item : value_node)
+  {
+    switch (type)
+    {
+      case PROTON_DOUBLE_ARRAY:
+        append_array_element(out, item.as_double());
+        break;
+      case PROTON_FLOAT_ARRAY:
+        append_array_element(out, static_cast<float>(item.as_double()));
+        break;
+      case PROTON_INT32_ARRAY:
+        append_array_element(out, static_cast<int32_t>(item.as_int64()));
+        break;
+      case PROTON_INT64_ARRAY:
+        append_array_element(out, item.as_int64());
+        break;
+      case PROTON_UINT32_ARRAY:
+        append_array_element(out, static_cast<uint32_t>(item.as_uint64()));
+        break;
+      default:
+        append_array_element(out, item.as_uint64());
+        break;
+    }
+  }
+  return static_cast<uint16_t>(out - data);
+}
+
 // ============================================================================
 // GeneratedNode implementation
 // ============================================================================
@@ -203,6 +319,7 @@ GeneratedNode::GeneratedNode(const Config & config, const std::string & target_n
   generate_signals(config);
   generate_bundles(config);
   init_registry();
+  registry_.schema_hash = compute_schema_hash(config);
   init_node(config, target_name);
 }
 
@@ -217,7 +334,8 @@ void GeneratedNode::generate_endpoints(const Config & config, const std::string
         proton_endpoint_t ep = {
           .node_id = node.id,
           .endpoint_id = endpoint.id,
-          .transport_type = string_to_transport(endpoint.type)};
+          .transport_type = string_to_transport(endpoint.type),
+          .mtu = endpoint.mtu};
         node_destination_peers_.push_back(ep);
       }
     }
@@ -229,6 +347,7 @@ void GeneratedNode::generate_signals(const Config & config)
   signal_registry_.reserve(config.signals.size());
   signal_value_buffer_storage_.reserve(config.signals.size());
   signal_decode_buffer_storage_.reserve(config.signals.size());
+  signal_encoding_storage_.reserve(config.signals.size());
   signal_scratch_buffer_.resize(PROTON_SCRATCH_BUFFER_SIZE);
 
   for (size_t idx = 0; idx < config.signals.size(); idx++)
@@ -241,23 +360,37 @@ void GeneratedNode::generate_signals(const Config & config)
     }
 
     uint16_t value_size = get_signal_value_size(sig_type, signal_cfg.capacity);
+    bool is_array = proton_is_array_type(sig_type);
 
-    // Create signal descriptor
+    // Create signal descriptor, the capacity of an array is in bytes like its value size
     signal_desc_t sig_desc = {
       .id = signal_cfg.id,
       .type = sig_type,
       .value_size = value_size,
-      .capacity = signal_cfg.capacity,
+      .capacity = is_array ? value_size : signal_cfg.capacity,
       .signal = proton_Signal_init_zero,
       .signal_decode_buffer =
         {
           .data = nullptr,
           .len = 0,
         },
+      .version = 0,
+      .sequence = 0,
+      .encoding = nullptr,
     };
 
     sig_desc.signal.which_signal = proton_get_tag_from_type(sig_type);
 
+    if (!signal_cfg.encoding.empty())
+    {
+      signal_encoding_storage_.push_back(
+        {.type = signal_cfg.encoding == encodings::FLOAT16 ? PROTON_ENCODING_FLOAT16
+                                                           : PROTON_ENCODING_QUANTIZED,
+         .scale = signal_cfg.scale,
+         .offset = signal_cfg.offset});
+      sig_desc.encoding = &signal_encoding_storage_.back();
+    }
+
     // Set default value if provided
     if (signal_cfg.has_default_value)
     {
@@ -285,9 +418,18 @@ void GeneratedNode::generate_signals(const Config & config)
         case PROTON_BOOL:
           sig_desc.signal.signal.bool_value = value_node.as_bool();
           break;
+        case PROTON_FLAGS:
+          sig_desc.signal.signal.flags_value = value_node.as_uint64();
+          break;
         case PROTON_STRING:
         case PROTON_BYTES:
-          // String/bytes default values handled separately via decode buffers
+        case PROTON_DOUBLE_ARRAY:
+        case PROTON_FLOAT_ARRAY:
+        case PROTON_INT32_ARRAY:
+        case PROTON_INT64_ARRAY:
+        case PROTON_UINT32_ARRAY:
+        case PROTON_UINT64_ARRAY:
+          // String/bytes/array default values handled separately via decode buffers
           break;
         default:
           throw NodeBuilderException("Signal type is invalid");
@@ -295,10 +437,11 @@ void GeneratedNode::generate_signals(const Config & config)
       }
     }
 
-    // Allocate buffers for string/bytes signals
-    if (sig_type == PROTON_STRING || sig_type == PROTON_BYTES)
+    // Allocate buffers for string/bytes/array signals. Vector storage comes from the allocator,
+    // so it is aligned for the elements of an array.
+    if (sig_type == PROTON_STRING || sig_type == PROTON_BYTES || is_array)
     {
-      signal_value_buffer_storage_.emplace_back(signal_cfg.capacity, 0);
+      signal_value_buffer_storage_.emplace_back(sig_desc.capacity, 0);
 
       if (signal_cfg.has_default_value)
       {
@@ -322,6 +465,16 @@ void GeneratedNode::generate_signals(const Config & config)
             signal_value_buffer_storage_.back().data(), bytes_value.data(), bytes_value.size());
           sig_desc.value_size = bytes_value.size();
         }
+        else
+        {
+          sig_desc.value_size = set_array_default(
+            sig_type, value_node, signal_value_buffer_storage_.back().data());
+        }
+      }
+      else if (is_array)
+      {
+        // Arrays start out empty
+        sig_desc.value_size = 0;
       }
 
       // Value buffer - where the actual signal value is stored
@@ -329,7 +482,7 @@ void GeneratedNode::generate_signals(const Config & config)
         reinterpret_cast<char *>(signal_value_buffer_storage_.back().data());
 
       // Decode buffer - temporary space for decoding incoming data
-      signal_decode_buffer_storage_.emplace_back(signal_cfg.capacity, 0);
+      signal_decode_buffer_storage_.emplace_back(sig_desc.capacity, 0);
       sig_desc.signal_decode_buffer.data = signal_decode_buffer_storage_.back().data();
       sig_desc.signal_decode_buffer.len = signal_decode_buffer_storage_.back().size();
     }
@@ -364,6 +517,14 @@ void GeneratedNode::generate_bundles(const Config & config)
     // Store signal IDs for this bundle
     bundle_signal_ids_[bundle_cfg.id] = bundle_cfg.signals;
 
+    uint32_t * sent_versions = nullptr;
+    if (bundle_cfg.delta && !bundle_cfg.signals.empty())
+    {
+      auto & versions = bundle_sent_versions_[bundle_cfg.id];
+      versions.assign(bundle_cfg.signals.size(), 0);
+      sent_versions = versions.data();
+    }
+
     // Create bundle descriptor
     bundle_desc_t bundle_desc = {
       .bundle_id = bundle_cfg.id,
@@ -382,6 +543,12 @@ void GeneratedNode::generate_bundles(const Config & config)
           .ids = bundle_signal_ids_[bundle_cfg.id].data(),
           .count = static_cast<uint8_t>(bundle_signal_ids_[bundle_cfg.id].size()),
         },
+      .signal_indices = nullptr,
+      .signal_slots =
+        {
+          .slots = nullptr,
+          .capacity = 0,
+        },
       .last_send_ms = 0,
       .period_ms = bundle_cfg.period_ms,
       .send_now = false,
@@ -390,12 +557,40 @@ void GeneratedNode::generate_bundles(const Config & config)
           .cb = nullptr,
           .arg = nullptr,
         },
+      .codec = nullptr,
+      .delta = bundle_cfg.delta,
+      .keyframe_interval = bundle_cfg.keyframe_interval,
+      .sends_since_keyframe = 0,
+      .sent_versions = sent_versions,
     };
     bundle_table_.push_back(bundle_desc);
   }
 
   // Build space for encode/decode buffer (largest bundle signal count)
   bundle_encode_decode_buffer_.resize(max_signal_count);
+
+  // Resolve per-bundle registry indices and signal ID maps against the signal registry
+  proton_registry_t signal_view{};
+  signal_view.signal_registry = signal_registry_.data();
+  signal_view.signal_count = signal_registry_.size();
+  bundle_signal_indices_.clear();
+  bundle_signal_slots_.clear();
+  bundle_signal_indices_.reserve(bundle_table_.size());
+  bundle_signal_slots_.reserve(bundle_table_.size());
+  for (auto & bundle : bundle_table_)
+  {
+    auto & indices = bundle_signal_indices_.emplace_back(bundle.signal_ids.count);
+    auto & slots =
+      bundle_signal_slots_.emplace_back(proton_lookup_index_capacity(bundle.signal_ids.count));
+    if (
+      proton_registry_build_bundle_index(
+        &signal_view, &bundle, indices.empty() ? nullptr : indices.data(),
+        slots.empty() ? nullptr : slots.data(), slots.size()) != PROTON_OK)
+    {
+      throw NodeBuilderException(
+        std::format("Bundle {} references a signal that is not in the registry", bundle.bundle_id));
+    }
+  }
 }
 
 void GeneratedNode::init_registry()
@@ -415,6 +610,19 @@ void GeneratedNode::init_registry()
     signal_scratch_buffer_.empty() ? nullptr : signal_scratch_buffer_.data();
   registry_.signal_scratch_buffer_size = signal_scratch_buffer_.size();
 
+  // ID lookup indices, left disabled (linear scan) if a table is too large to index
+  bundle_index_slots_.resize(proton_lookup_index_capacity(bundle_table_.size()));
+  signal_index_slots_.resize(proton_lookup_index_capacity(signal_registry_.size()));
+  uint16_t * bundle_slots = bundle_index_slots_.empty() ? nullptr : bundle_index_slots_.data();
+  uint16_t * signal_slots = signal_index_slots_.empty() ? nullptr : signal_index_slots_.data();
+  if (
+    proton_registry_build_index(
+      &registry_, bundle_slots, bundle_index_slots_.size(), signal_slots,
+      signal_index_slots_.size()) != PROTON_OK)
+  {
+    throw NodeBuilderException("Failed to build registry lookup index");
+  }
+
   registry_.mutex_handles = {
     .lock = GeneratedNode::lock,
     .unlock = GeneratedNode::unlock,
@@ -432,11 +640,33 @@ void GeneratedNode::init_node(const Config & config, const std::string & target_
   node_.trigger_head = 0;
   node_.trigger_tail = 0;
 
+  // Peer schema hashes, only kept by nodes that accept compact frames
+  if (config.nodes.at(target_name).compact)
+  {
+    peer_schema_hashes_.assign(node_destination_peers_.size(), 0);
+  }
+  node_.peer_schema_hashes = peer_schema_hashes_.empty() ? nullptr : peer_schema_hashes_.data();
+
   // Initialize pending triggers to zero
   for (size_t i = 0; i < PROTON_MAX_PENDING_TRIGGERS; i++)
   {
     node_.pending_triggers[i] = 0;
   }
+
+  // Bundle send schedule, built from the registry on the first update
+  schedule_heap_.resize(bundle_table_.size());
+  schedule_triggered_.resize(bundle_table_.size());
+  node_.scheduler = {
+    .heap = schedule_heap_.empty() ? nullptr : schedule_heap_.data(),
+    .triggered = schedule_triggered_.empty() ? nullptr : schedule_triggered_.data(),
+    .capacity = static_cast<uint16_t>(bundle_table_.size()),
+    .heap_size = 0,
+    .triggered_size = 0,
+    .initialized = false,
+    .bundle_table = nullptr,
+    .bundle_count = 0,
+    .bundle_schedule_version = 0,
+  };
 }
 
 proton_status_e GeneratedNode::lock(void * mutex, void * ctx)
@@ -0,0 +1,704 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "protoncpp/registry_view.hpp"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include "protoncpp/registry_lock.hpp"
+
+namespace
+{
+
+constexpr uint32_t VIEW_MAGIC = 0x56525050;  // "PPRV"
+constexpr uint32_t VIEW_VERSION = 1;
+constexpr size_t CACHE_LINE = 64;
+constexpr size_t VALUE_ALIGNMENT = 8;
+// Reads of a bundle before giving up on a publisher that never finishes writing it. The first
+// SPIN_READ_ATTEMPTS spin, as a publish only takes a copy, and later ones yield the CPU in case
+// the publisher was preempted on it.
+constexpr int MAX_READ_ATTEMPTS = 1000;
+constexpr int SPIN_READ_ATTEMPTS = 100;
+
+// The atomics are shared between processes, which only works if they are lock-free
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+// Start of the segment, followed by the bundles, the signals and the values
+struct Header
+{
+  // Stored last by the publisher, once the segment is laid out and published
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t schema_hash;
+  uint32_t bundle_count;
+  uint32_t signal_count;
+  // Set by the publisher once it closes the segment
+  std::atomic<uint32_t> closed;
+  uint64_t size;
+};
+
+// One per bundle of the registry, in registry order. Each holds its own copy of the values of its
+// signals, so that its sequence guards all of them.
+struct Bundle
+{
+  // Odd while the publisher writes the bundle
+  alignas(CACHE_LINE) std::atomic<uint32_t> sequence;
+  uint32_t bundle_id;
+  uint32_t first_signal;
+  uint32_t signal_count;
+};
+
+struct Signal
+{
+  uint32_t signal_id;
+  uint32_t type;
+  // Offset of the value from the start of the segment, and the bytes it can hold
+  uint32_t offset;
+  uint32_t capacity;
+  // Index of the bundle the signal belongs to
+  uint32_t bundle;
+  // Written with the value
+  std::atomic<uint32_t> length;
+  std::atomic<uint32_t> version;
+};
+
+constexpr size_t align_up(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+constexpr size_t bundles_offset()
+{
+  return align_up(sizeof(Header), CACHE_LINE);
+}
+
+constexpr size_t signals_offset(size_t bundle_count)
+{
+  return bundles_offset() + bundle_count * sizeof(Bundle);
+}
+
+constexpr size_t values_offset(size_t bundle_count, size_t signal_count)
+{
+  return align_up(signals_offset(bundle_count) + signal_count * sizeof(Signal), CACHE_LINE);
+}
+
+bool valid_name(const char * name)
+{
+  return name != nullptr && name[0] == '/' && std::strchr(name + 1, '/') == nullptr &&
+         std::strlen(name) > 1 && std::strlen(name) <= NAME_MAX;
+}
+
+// Whether the registry holds the value behind a pointer, rather than in the signal union
+bool holds_buffer(proton_signal_type_e type)
+{
+  return type == PROTON_STRING || type == PROTON_BYTES || proton_is_array_type(type);
+}
+
+Header * header_of(const uint8_t * segment)
+{
+  return reinterpret_cast<Header *>(const_cast<uint8_t *>(segment));
+}
+
+Bundle * bundles_of(const uint8_t * segment)
+{
+  return reinterpret_cast<Bundle *>(const_cast<uint8_t *>(segment) + bundles_offset());
+}
+
+Signal * signals_of(const uint8_t * segment)
+{
+  return reinterpret_cast<Signal *>(
+    const_cast<uint8_t *>(segment) + signals_offset(header_of(segment)->bundle_count));
+}
+
+const uint8_t * segment_of(const proton_registry_view_t * view)
+{
+  return view == nullptr ? nullptr : static_cast<const uint8_t *>(view->segment);
+}
+
+const Bundle * find_bundle(const uint8_t * segment, uint32_t bundle_id)
+{
+  const Header * header = header_of(segment);
+  const Bundle * bundles = bundles_of(segment);
+  for (uint32_t i = 0; i < header->bundle_count; i++)
+  {
+    if (bundles[i].bundle_id == bundle_id)
+    {
+      return &bundles[i];
+    }
+  }
+  return nullptr;
+}
+
+const Signal * find_signal(const uint8_t * segment, uint32_t signal_id)
+{
+  const Header * header = header_of(segment);
+  const Signal * signals = signals_of(segment);
+  for (uint32_t i = 0; i < header->signal_count; i++)
+  {
+    if (signals[i].signal_id == signal_id)
+    {
+      return &signals[i];
+    }
+  }
+  return nullptr;
+}
+
+// Check the tables of a mapped segment, so that no read goes past its end
+bool valid_segment(const uint8_t * segment, size_t size)
+{
+  if (size < sizeof(Header))
+  {
+    return false;
+  }
+  const Header * header = header_of(segment);
+  if (
+    header->magic.load(std::memory_order_acquire) != VIEW_MAGIC ||
+    header->version != VIEW_VERSION || header->size > size ||
+    values_offset(header->bundle_count, header->signal_count) > header->size)
+  {
+    return false;
+  }
+
+  const Bundle * bundles = bundles_of(segment);
+  for (uint32_t i = 0; i < header->bundle_count; i++)
+  {
+    if (
+      bundles[i].first_signal > header->signal_count ||
+      bundles[i].signal_count > header->signal_count - bundles[i].first_signal)
+    {
+      return false;
+    }
+  }
+  const Signal * signals = signals_of(segment);
+  for (uint32_t i = 0; i < header->signal_count; i++)
+  {
+    if (
+      signals[i].bundle >= header->bundle_count ||
+      static_cast<uint64_t>(signals[i].offset) + signals[i].capacity > header->size)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Tell the CPU the thread is spinning, so that it does not starve a sibling hardware thread
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * Run read between two loads of the sequence of a bundle until they match and are even, so that
+ * whatever read copied comes from a single publish
+ */
+template<typename Read>
+proton_status_e read_consistent(const Bundle & bundle, uint32_t * sequence, Read && read)
+{
+  for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++)
+  {
+    const uint32_t before = bundle.sequence.load(std::memory_order_acquire);
+    if ((before & 1) == 0)
+    {
+      proton_status_e status = read();
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (bundle.sequence.load(std::memory_order_relaxed) == before)
+      {
+        if (sequence != nullptr)
+        {
+          *sequence = before;
+        }
+        return status;
+      }
+    }
+    if (attempt < SPIN_READ_ATTEMPTS)
+    {
+      cpu_relax();
+    }
+    else
+    {
+      ::sched_yield();
+    }
+  }
+  return PROTON_READ_ERROR;
+}
+
+size_t value_length(const Signal & signal)
+{
+  const uint32_t length = signal.length.load(std::memory_order_relaxed);
+  return length < signal.capacity ? length : signal.capacity;
+}
+
+// Read a single value of the expected type into buf
+proton_status_e read_value(
+  const proton_registry_view_t * view, uint32_t signal_id, proton_signal_type_e expected_type,
+  void * buf, size_t capacity, size_t * out_len)
+{
+  const uint8_t * segment = segment_of(view);
+  if (segment == nullptr || buf == nullptr)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  const Signal * signal = find_signal(segment, signal_id);
+  if (signal == nullptr || signal->type != static_cast<uint32_t>(expected_type))
+  {
+    return PROTON_ERROR;
+  }
+
+  size_t length = 0;
+  proton_status_e status = read_consistent(
+    bundles_of(segment)[signal->bundle], nullptr,
+    [&]()
+    {
+      length = value_length(*signal);
+      if (length > capacity)
+      {
+        return PROTON_INSUFFICIENT_BUFFER_ERROR;
+      }
+      std::memcpy(buf, segment + signal->offset, length);
+      return PROTON_OK;
+    });
+  if (status == PROTON_OK && out_len != nullptr)
+  {
+    *out_len = length;
+  }
+  return status;
+}
+
+}  // namespace
+
+namespace proton
+{
+
+RegistryPublisher::~RegistryPublisher()
+{
+  close();
+}
+
+proton_status_e RegistryPublisher::create(
+  const char * name, const proton_registry_t * registry) noexcept
+{
+  close();
+
+  if (registry == nullptr)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  if (!valid_name(name))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  size_t signal_count = 0;
+  for (uint16_t i = 0; i < registry->bundle_count; i++)
+  {
+    signal_count += registry->bundle_table[i].signal_ids.count;
+  }
+
+  // Lay out the values of every bundle after the tables
+  size_t size = values_offset(registry->bundle_count, signal_count);
+  for (uint16_t i = 0; i < registry->bundle_count; i++)
+  {
+    const bundle_desc_t * bundle = &registry->bundle_table[i];
+    for (size_t slot = 0; slot < bundle->signal_ids.count; slot++)
+    {
+      const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, slot);
+      if (desc == nullptr)
+      {
+        return PROTON_ERROR;
+      }
+      size += align_up(
+        holds_buffer(desc->type) ? desc->capacity : get_signal_value_size(desc->type, 0),
+        VALUE_ALIGNMENT);
+    }
+  }
+  if (size > UINT32_MAX)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  // A segment left behind by a publisher that died is replaced, its readers attach again
+  ::shm_unlink(name);
+  int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd < 0)
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+  void * memory = MAP_FAILED;
+  if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (memory == MAP_FAILED)
+  {
+    ::shm_unlink(name);
+    return PROTON_CONNECT_ERROR;
+  }
+
+  segment_ = static_cast<uint8_t *>(memory);
+  size_ = size;
+  registry_ = registry;
+  std::strcpy(name_, name);
+
+  Header * header = new (segment_) Header();
+  header->version = VIEW_VERSION;
+  header->schema_hash = registry->schema_hash;
+  header->bundle_count = registry->bundle_count;
+  header->signal_count = static_cast<uint32_t>(signal_count);
+  header->size = size;
+
+  Bundle * bundles = bundles_of(segment_);
+  Signal * signals = signals_of(segment_);
+  size_t offset = values_offset(registry->bundle_count, signal_count);
+  uint32_t next_signal = 0;
+  for (uint16_t i = 0; i < registry->bundle_count; i++)
+  {
+    const bundle_desc_t * bundle = &registry->bundle_table[i];
+    Bundle * entry = new (&bundles[i]) Bundle();
+    entry->bundle_id = bundle->bundle_id;
+    entry->first_signal = next_signal;
+    entry->signal_count = static_cast<uint32_t>(bundle->signal_ids.count);
+    for (size_t slot = 0; slot < bundle->signal_ids.count; slot++)
+    {
+      const signal_desc_t * desc = proton_registry_get_bundle_signal(registry, bundle, slot);
+      Signal * signal = new (&signals[next_signal++]) Signal();
+      signal->signal_id = desc->id;
+      signal->type = static_cast<uint32_t>(desc->type);
+      signal->offset = static_cast<uint32_t>(offset);
+      signal->capacity =
+        holds_buffer(desc->type) ? desc->capacity : get_signal_value_size(desc->type, 0);
+      signal->bundle = i;
+      offset += align_up(signal->capacity, VALUE_ALIGNMENT);
+    }
+  }
+
+  {
+    ScopedLock lock(registry_);
+    if (!lock)
+    {
+      close();
+      return PROTON_MUTEX_ERROR;
+    }
+    for (uint16_t i = 0; i < registry->bundle_count; i++)
+    {
+      publish_bundle(i, true);
+    }
+  }
+
+  header->magic.store(VIEW_MAGIC, std::memory_order_release);
+  return PROTON_OK;
+}
+
+void RegistryPublisher::close() noexcept
+{
+  if (segment_ == nullptr)
+  {
+    return;
+  }
+  header_of(segment_)->closed.store(1, std::memory_order_release);
+  ::munmap(segment_, size_);
+  ::shm_unlink(name_);
+  segment_ = nullptr;
+  size_ = 0;
+  registry_ = nullptr;
+  name_[0] = '\0';
+}
+
+proton_status_e RegistryPublisher::publish() noexcept
+{
+  if (!is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  ScopedLock lock(registry_);
+  if (!lock)
+  {
+    return PROTON_MUTEX_ERROR;
+  }
+  for (uint16_t i = 0; i < registry_->bundle_count; i++)
+  {
+    publish_bundle(i, false);
+  }
+  return PROTON_OK;
+}
+
+proton_status_e RegistryPublisher::publish(uint32_t bundle_id) noexcept
+{
+  if (!is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  ScopedLock lock(registry_);
+  if (!lock)
+  {
+    return PROTON_MUTEX_ERROR;
+  }
+  const bundle_desc_t * bundle = proton_registry_get_bundle(registry_, bundle_id, nullptr);
+  if (bundle == nullptr)
+  {
+    return PROTON_ERROR;
+  }
+  publish_bundle(static_cast<size_t>(bundle - registry_->bundle_table), true);
+  return PROTON_OK;
+}
+
+void RegistryPublisher::publish_bundle(size_t index, bool force) noexcept
+{
+  const bundle_desc_t * bundle = &registry_->bundle_table[index];
+  Bundle & entry = bundles_of(segment_)[index];
+  Signal * signals = signals_of(segment_) + entry.first_signal;
+
+  if (!force)
+  {
+    bool written = false;
+    for (size_t slot = 0; slot < entry.signal_count && !written; slot++)
+    {
+      const signal_desc_t * desc = proton_registry_get_bundle_signal(registry_, bundle, slot);
+      written = desc->version != signals[slot].version.load(std::memory_order_relaxed);
+    }
+    if (!written)
+    {
+      return;
+    }
+  }
+
+  const uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+  entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  for (size_t slot = 0; slot < entry.signal_count; slot++)
+  {
+    const signal_desc_t * desc = proton_registry_get_bundle_signal(registry_, bundle, slot);
+    Signal & signal = signals[slot];
+    uint8_t * value = segment_ + signal.offset;
+    size_t length = signal.capacity;
+    if (!holds_buffer(desc->type))
+    {
+      std::memcpy(value, &desc->signal.signal, length);
+    }
+    else if (desc->signal.signal.string_value == nullptr)
+    {
+      length = 0;
+    }
+    else
+    {
+      const char * data = static_cast<const char *>(desc->signal.signal.string_value);
+      if (desc->type == PROTON_STRING)
+      {
+        // Keep the null terminator if the string has one
+        length = strnlen(data, signal.capacity);
+        length += length < signal.capacity ? 1 : 0;
+      }
+      else if (desc->value_size < length)
+      {
+        length = desc->value_size;
+      }
+      std::memcpy(value, data, length);
+    }
+    signal.length.store(static_cast<uint32_t>(length), std::memory_order_relaxed);
+    signal.version.store(desc->version, std::memory_order_relaxed);
+  }
+
+  entry.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+}  // namespace proton
+
+extern "C"
+{
+
+  proton_status_e proton_registry_view_attach(proton_registry_view_t * view, const char * name)
+  {
+    if (view == nullptr)
+    {
+      return PROTON_NULL_PTR_ERROR;
+    }
+    proton_registry_view_detach(view);
+    if (!valid_name(name))
+    {
+      return PROTON_CONNECT_ERROR;
+    }
+
+    int fd = ::shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+      return PROTON_CONNECT_ERROR;
+    }
+    struct stat st;
+    void * memory = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header))
+    {
+      memory = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (memory == MAP_FAILED)
+    {
+      return PROTON_CONNECT_ERROR;
+    }
+    // A segment still being laid out has no magic yet, and is reported missing
+    if (!valid_segment(static_cast<const uint8_t *>(memory), static_cast<size_t>(st.st_size)))
+    {
+      ::munmap(memory, static_cast<size_t>(st.st_size));
+      return PROTON_CONNECT_ERROR;
+    }
+
+    view->segment = memory;
+    view->size = static_cast<size_t>(st.st_size);
+    return PROTON_OK;
+  }
+
+  void proton_registry_view_detach(proton_registry_view_t * view)
+  {
+    if (view == nullptr || view->segment == nullptr)
+    {
+      return;
+    }
+    ::munmap(const_cast<void *>(view->segment), view->size);
+    view->segment = nullptr;
+    view->size = 0;
+  }
+
+  bool proton_registry_view_closed(const proton_registry_view_t * view)
+  {
+    const uint8_t * segment = segment_of(view);
+    return segment == nullptr || header_of(segment)->closed.load(std::memory_order_acquire) != 0;
+  }
+
+  uint32_t proton_registry_view_schema_hash(const proton_registry_view_t * view)
+  {
+    const uint8_t * segment = segment_of(view);
+    return segment == nullptr ? 0 : header_of(segment)->schema_hash;
+  }
+
+  proton_status_e proton_registry_view_bundle_sequence(
+    const proton_registry_view_t * view, uint32_t bundle_id, uint32_t * sequence)
+  {
+    const uint8_t * segment = segment_of(view);
+    if (segment == nullptr || sequence == nullptr)
+    {
+      return PROTON_NULL_PTR_ERROR;
+    }
+    const Bundle * bundle = find_bundle(segment, bundle_id);
+    if (bundle == nullptr)
+    {
+      return PROTON_ERROR;
+    }
+    // Round a sequence being written down to the publish before it
+    *sequence = bundle->sequence.load(std::memory_order_acquire) & ~1u;
+    return PROTON_OK;
+  }
+
+  proton_status_e proton_registry_view_read_bundle(
+    const proton_registry_view_t * view, uint32_t bundle_id, proton_view_value_t * values,
+    size_t capacity, uint8_t * buffer, size_t buffer_len, size_t * count, uint32_t * sequence)
+  {
+    const uint8_t * segment = segment_of(view);
+    if (segment == nullptr || count == nullptr || (capacity > 0 && values == nullptr))
+    {
+      return PROTON_NULL_PTR_ERROR;
+    }
+    const Bundle * bundle = find_bundle(segment, bundle_id);
+    if (bundle == nullptr)
+    {
+      return PROTON_ERROR;
+    }
+    if (bundle->signal_count > capacity)
+    {
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+
+    const Signal * signals = signals_of(segment) + bundle->first_signal;
+    proton_status_e status = read_consistent(
+      *bundle, sequence,
+      [&]()
+      {
+        size_t used = 0;
+        for (uint32_t i = 0; i < bundle->signal_count; i++)
+        {
+          const Signal & signal = signals[i];
+          const size_t length = value_length(signal);
+          if (used + length > buffer_len || (length > 0 && buffer == nullptr))
+          {
+            return PROTON_INSUFFICIENT_BUFFER_ERROR;
+          }
+          std::memcpy(buffer + used, segment + signal.offset, length);
+          values[i].signal_id = signal.signal_id;
+          values[i].type = static_cast<proton_signal_type_e>(signal.type);
+          values[i].version = signal.version.load(std::memory_order_relaxed);
+          values[i].data = buffer + used;
+          values[i].length = length;
+          used = align_up(used + length, VALUE_ALIGNMENT);
+        }
+        return PROTON_OK;
+      });
+    if (status == PROTON_OK)
+    {
+      *count = bundle->signal_count;
+    }
+    return status;
+  }
+
+#define PROTON_REGISTRY_VIEW_GETTER(NAME, TYPE, ENUM)                       \
+  proton_status_e proton_registry_view_get_##NAME(                          \
+    const proton_registry_view_t * view, uint32_t signal_id, TYPE * value)  \
+  {                                                                         \
+    return read_value(view, signal_id, ENUM, value, sizeof(TYPE), nullptr); \
+  }
+
+  PROTON_REGISTRY_VIEW_GETTER(double, double, PROTON_DOUBLE)
+  PROTON_REGISTRY_VIEW_GETTER(float, float, PROTON_FLOAT)
+  PROTON_REGISTRY_VIEW_GETTER(int32, int32_t, PROTON_INT32)
+  PROTON_REGISTRY_VIEW_GETTER(int64, int64_t, PROTON_INT64)
+  PROTON_REGISTRY_VIEW_GETTER(uint32, uint32_t, PROTON_UINT32)
+  PROTON_REGISTRY_VIEW_GETTER(uint64, uint64_t, PROTON_UINT64)
+  PROTON_REGISTRY_VIEW_GETTER(bool, bool, PROTON_BOOL)
+  PROTON_REGISTRY_VIEW_GETTER(flags, uint64_t, PROTON_FLAGS)
+
+#undef PROTON_REGISTRY_VIEW_GETTER
+
+  proton_status_e proton_registry_view_get_string(
+    const proton_registry_view_t * view, uint32_t signal_id, char * buf, size_t capacity,
+    size_t * out_len)
+  {
+    if (out_len == nullptr)
+    {
+      return PROTON_NULL_PTR_ERROR;
+    }
+    return read_value(view, signal_id, PROTON_STRING, buf, capacity, out_len);
+  }
+
+  proton_status_e proton_registry_view_get_bytes(
+    const proton_registry_view_t * view, uint32_t signal_id, uint8_t * buf, size_t capacity,
+    size_t * out_len)
+  {
+    if (out_len == nullptr)
+    {
+      return PROTON_NULL_PTR_ERROR;
+    }
+    return read_value(view, signal_id, PROTON_BYTES, buf, capacity, out_len);
+  }
+}
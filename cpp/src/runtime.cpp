@@ -0,0 +1,1330 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "protoncpp/runtime.hpp"
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <ctime>
+
+namespace proton
+{
+
+namespace
+{
+
+// Both transport headers fit in the same headroom, so a message is encoded once for all of them
+static_assert(sizeof(proton_udp4_header_t) == PROTON_FRAME_HEADER_OVERHEAD);
+
+constexpr size_t HEADROOM = PROTON_FRAME_HEADER_OVERHEAD;
+constexpr size_t TAILROOM = PROTON_FRAME_CRC32C_OVERHEAD;
+constexpr int MAX_EVENTS = 16;
+
+// Layout of the io_uring buffers: the provided buffer ring on its own page, then the receive
+// buffers, each a recvmsg header followed by the datagram, then the send slots
+constexpr size_t BUFFER_RING_SIZE = 4096;
+constexpr size_t RECEIVE_BUFFER_SIZE = sizeof(io_uring_recvmsg_out) + Runtime::FRAME_BUFFER_SIZE;
+constexpr uint16_t RECEIVE_GROUP = 0;
+static_assert(Runtime::RECEIVE_BUFFERS * sizeof(io_uring_buf) <= BUFFER_RING_SIZE);
+static_assert((Runtime::RECEIVE_BUFFERS & (Runtime::RECEIVE_BUFFERS - 1)) == 0);
+
+// Epoll event data and io_uring user data: what the event is about, the index of the transport or
+// send slot, and the generation of the wakeup poll
+uint64_t event_data(uint32_t source, size_t index, uint32_t generation = 0)
+{
+  return (static_cast<uint64_t>(source) << 56) | (static_cast<uint64_t>(index) << 32) | generation;
+}
+
+uint32_t event_source(uint64_t data)
+{
+  return static_cast<uint32_t>(data >> 56);
+}
+
+size_t event_index(uint64_t data)
+{
+  return static_cast<size_t>((data >> 32) & 0xFFFFFF);
+}
+
+uint32_t event_generation(uint64_t data)
+{
+  return static_cast<uint32_t>(data & UINT32_MAX);
+}
+
+void close_fd(int & fd)
+{
+  if (fd >= 0)
+  {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+// Reset the count of a timerfd or eventfd, so that it stops being readable
+void drain(int fd)
+{
+  uint64_t count;
+  while (::read(fd, &count, sizeof(count)) < 0 && errno == EINTR)
+  {
+  }
+}
+
+void wake(int fd)
+{
+  const uint64_t one = 1;
+  // Only fails if the count is about to overflow, and then the loop is woken up already
+  ssize_t ret = ::write(fd, &one, sizeof(one));
+  (void)ret;
+}
+
+}  // namespace
+
+Runtime::~Runtime()
+{
+  close();
+}
+
+proton_status_e Runtime::open(proton_node_t * node, RuntimeBackend backend) noexcept
+{
+  close();
+
+  if (node == nullptr)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  proton_status_e status = PROTON_UNSUPPORTED_OPERATION_ERROR;
+  if (backend != RuntimeBackend::EPOLL && IoUring::supported())
+  {
+    backend_ = RuntimeBackend::IO_URING;
+    status = open_io_uring();
+    if (status != PROTON_OK)
+    {
+      close();
+    }
+  }
+
+  // Unless io_uring was asked for, fall back to epoll when it cannot be set up
+  if (status != PROTON_OK && backend != RuntimeBackend::IO_URING)
+  {
+    backend_ = RuntimeBackend::EPOLL;
+    status = open_epoll();
+    if (status != PROTON_OK)
+    {
+      close();
+    }
+  }
+
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  node_ = node;
+  framing_ = {HEADROOM, TAILROOM, record_flags, this};
+  stats_ = {};
+  stop_requested_ = false;
+
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::open_epoll() noexcept
+{
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  wakeup_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (
+    epoll_fd_ < 0 || timer_fd_ < 0 || wakeup_fd_ < 0 ||
+    watch(timer_fd_, Source::TIMER, 0, EPOLLIN) != PROTON_OK ||
+    watch(wakeup_fd_, Source::WAKEUP, 0, EPOLLIN) != PROTON_OK)
+  {
+    return PROTON_ERROR;
+  }
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::open_io_uring() noexcept
+{
+  proton_status_e status = ring_.open(IO_URING_ENTRIES);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  wakeup_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  ring_buffers_size_ =
+    BUFFER_RING_SIZE + RECEIVE_BUFFERS * RECEIVE_BUFFER_SIZE + SEND_SLOTS * FRAME_BUFFER_SIZE;
+  void * buffers = ::mmap(
+    nullptr, ring_buffers_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (wakeup_fd_ < 0 || buffers == MAP_FAILED)
+  {
+    return PROTON_ERROR;
+  }
+  ring_buffers_ = static_cast<uint8_t *>(buffers);
+
+  // Datagrams are received into whichever buffer of the ring is free, and it is handed back once
+  // the datagram is decoded
+  receive_ring_ = reinterpret_cast<io_uring_buf_ring *>(ring_buffers_);
+  status = ring_.register_buffer_ring(receive_ring_, RECEIVE_BUFFERS, RECEIVE_GROUP);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  for (uint16_t id = 0; id < RECEIVE_BUFFERS; id++)
+  {
+    IoUring::add_buffer(
+      receive_ring_, RECEIVE_BUFFERS, receive_buffer(id), RECEIVE_BUFFER_SIZE, id, id);
+  }
+  IoUring::advance_buffer_ring(receive_ring_, RECEIVE_BUFFERS);
+
+  iovec slots[SEND_SLOTS];
+  for (size_t slot = 0; slot < SEND_SLOTS; slot++)
+  {
+    slots[slot] = {send_slot(slot), FRAME_BUFFER_SIZE};
+  }
+  return ring_.register_buffers(slots, SEND_SLOTS);
+}
+
+void Runtime::close() noexcept
+{
+  // Closing the ring cancels what is in flight, before the buffers it uses are unmapped
+  ring_.close();
+  if (ring_buffers_ != nullptr)
+  {
+    ::munmap(ring_buffers_, ring_buffers_size_);
+    ring_buffers_ = nullptr;
+    receive_ring_ = nullptr;
+  }
+  for (uint16_t & completions : slot_completions_)
+  {
+    completions = 0;
+  }
+  slots_exhausted_ = false;
+  wakeup_armed_ = false;
+
+  close_fd(epoll_fd_);
+  close_fd(timer_fd_);
+  close_fd(wakeup_fd_);
+  node_ = nullptr;
+  backend_ = RuntimeBackend::EPOLL;
+  num_sockets_ = 0;
+  num_ports_ = 0;
+  num_channels_ = 0;
+  publisher_ = nullptr;
+
+#if PROTON_NODE_BUILDER
+  owned_sockets_.clear();
+  owned_ports_.clear();
+  owned_channels_.clear();
+#endif
+}
+
+proton_status_e Runtime::watch(int fd, Source source, size_t index, uint32_t events) noexcept
+{
+  epoll_event event = {};
+  event.events = events;
+  event.data.u64 = event_data(static_cast<uint32_t>(source), index);
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0)
+  {
+    return PROTON_ERROR;
+  }
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::add_socket(transport::udp4::Socket & socket) noexcept
+{
+  if (!is_open() || !socket.is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  if (num_sockets_ == MAX_SOCKETS)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+  // Receive completions hold a single datagram, there is no room for GRO segments
+  if (backend_ == RuntimeBackend::IO_URING && socket.gro())
+  {
+    return PROTON_UNSUPPORTED_OPERATION_ERROR;
+  }
+
+  sockets_[num_sockets_] = &socket;
+  proton_status_e status = backend_ == RuntimeBackend::IO_URING
+                             ? arm_socket(num_sockets_)
+                             : watch(socket.fd(), Source::SOCKET, num_sockets_, EPOLLIN);
+  if (status == PROTON_OK)
+  {
+    num_sockets_++;
+  }
+  return status;
+}
+
+proton_status_e Runtime::add_port(
+  transport::serial::Port & port, uint32_t peer_node_id, uint32_t peer_endpoint_id) noexcept
+{
+  if (!is_open() || !port.is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  if (num_ports_ == MAX_PORTS)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  ports_[num_ports_] = {&port, peer_node_id, peer_endpoint_id, false, false};
+  proton_status_e status = backend_ == RuntimeBackend::IO_URING
+                             ? arm_port(num_ports_)
+                             : watch(port.fd(), Source::PORT, num_ports_, EPOLLIN);
+  if (status == PROTON_OK)
+  {
+    num_ports_++;
+  }
+  return status;
+}
+
+proton_status_e Runtime::add_channel(transport::shm::Channel & channel) noexcept
+{
+  if (!is_open() || !channel.is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  if (num_channels_ == MAX_CHANNELS)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  channels_[num_channels_] = &channel;
+  proton_status_e status = backend_ == RuntimeBackend::IO_URING
+                             ? arm_channel(num_channels_)
+                             : watch(channel.fd(), Source::CHANNEL, num_channels_, EPOLLIN);
+  if (status == PROTON_OK)
+  {
+    num_channels_++;
+  }
+  return status;
+}
+
+void Runtime::set_publisher(RegistryPublisher * publisher) noexcept
+{
+  publisher_ = publisher;
+}
+
+uint64_t Runtime::uptime_ms() noexcept
+{
+  timespec now;
+  ::clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000 + static_cast<uint64_t>(now.tv_nsec) / 1000000;
+}
+
+proton_status_e Runtime::run_once(int timeout_ms) noexcept
+{
+  if (!is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+
+  proton_status_e status =
+    backend_ == RuntimeBackend::IO_URING ? wait_io_uring(timeout_ms) : wait_epoll(timeout_ms);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+  stats_.wakeups++;
+
+  // Channels are read whatever woke the loop up, their doorbells only ring for a sleeping loop
+  for (size_t i = 0; i < num_channels_; i++)
+  {
+    receive_channel(i);
+  }
+
+  status = send_due();
+  // Readers of the view see what was received as soon as the loop is done with it
+  if (publisher_ != nullptr)
+  {
+    publisher_->publish();
+  }
+  return status;
+}
+
+proton_status_e Runtime::run() noexcept
+{
+  while (!stop_requested_.exchange(false))
+  {
+    proton_status_e status = run_once();
+    if (status != PROTON_OK)
+    {
+      return status;
+    }
+  }
+  return PROTON_OK;
+}
+
+void Runtime::stop() noexcept
+{
+  stop_requested_ = true;
+  wake(wakeup_fd_);
+}
+
+proton_status_e Runtime::trigger_bundle(uint32_t bundle_id) noexcept
+{
+  proton_status_e status = proton_node_trigger_bundle(node_, bundle_id);
+  if (status == PROTON_OK)
+  {
+    wake(wakeup_fd_);
+  }
+  return status;
+}
+
+proton_status_e Runtime::wait_epoll(int timeout_ms) noexcept
+{
+  const uint64_t now = uptime_ms();
+  uint64_t deadline = 0;
+  bool has_deadline = false;
+  proton_status_e status = proton_node_next_deadline(node_, now, &deadline, &has_deadline);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  // Frames already in a channel are received without sleeping
+  if (prepare_channels() || (has_deadline && deadline <= now))
+  {
+    timeout_ms = 0;
+  }
+  else
+  {
+    // An all-zero value disarms the timer
+    itimerspec spec = {};
+    if (has_deadline)
+    {
+      spec.it_value.tv_sec = static_cast<time_t>(deadline / 1000);
+      spec.it_value.tv_nsec = static_cast<long>(deadline % 1000) * 1000000;
+    }
+    if (::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr) != 0)
+    {
+      return PROTON_ERROR;
+    }
+  }
+
+  // Signals, and io_uring tearing down a ring this thread used, interrupt the wait without waking
+  // the loop up
+  const uint64_t end = now + static_cast<uint64_t>(timeout_ms);
+  epoll_event events[MAX_EVENTS];
+  int ready = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout_ms);
+  while (ready < 0 && errno == EINTR)
+  {
+    if (timeout_ms > 0)
+    {
+      const uint64_t interrupted = uptime_ms();
+      timeout_ms = interrupted < end ? static_cast<int>(end - interrupted) : 0;
+    }
+    ready = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout_ms);
+  }
+  if (ready < 0)
+  {
+    return PROTON_ERROR;
+  }
+
+  for (int i = 0; i < ready; i++)
+  {
+    const size_t index = event_index(events[i].data.u64);
+    switch (static_cast<Source>(event_source(events[i].data.u64)))
+    {
+      case Source::TIMER:
+        drain(timer_fd_);
+        break;
+
+      case Source::CHANNEL:
+        // The doorbell is emptied before the next wait
+        break;
+
+      case Source::WAKEUP:
+        drain(wakeup_fd_);
+        break;
+
+      case Source::SOCKET:
+        receive_socket(index);
+        break;
+
+      case Source::PORT:
+        if (events[i].events & EPOLLOUT)
+        {
+          ports_[index].port->flush();
+          update_port_output(index);
+        }
+        if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+        {
+          receive_port(index);
+        }
+        break;
+
+      default:
+        // The other sources only tag io_uring completions
+        break;
+    }
+  }
+
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::wait_io_uring(int timeout_ms) noexcept
+{
+  const uint64_t now = uptime_ms();
+  uint64_t deadline = 0;
+  bool has_deadline = false;
+  // While messages wait for a send slot, the wait is for a slot to be freed instead
+  if (!slots_exhausted_)
+  {
+    proton_status_e status = proton_node_next_deadline(node_, now, &deadline, &has_deadline);
+    if (status != PROTON_OK)
+    {
+      return status;
+    }
+  }
+  if (timeout_ms >= 0 && (!has_deadline || now + static_cast<uint64_t>(timeout_ms) < deadline))
+  {
+    deadline = now + static_cast<uint64_t>(timeout_ms);
+    has_deadline = true;
+  }
+
+  // Frames already in a channel are received without sleeping
+  const bool pending = prepare_channels();
+  const bool wait = !pending && (!has_deadline || deadline > now);
+  if (wait)
+  {
+    proton_status_e status = arm_wakeup(has_deadline, deadline);
+    if (status != PROTON_OK)
+    {
+      return status;
+    }
+  }
+
+  // Completions of sends in flight are reaped on the way, without ending the wait
+  bool woken = false;
+  while (!woken)
+  {
+    proton_status_e status = ring_.submit(wait ? 1 : 0);
+    if (status != PROTON_OK)
+    {
+      return status;
+    }
+    woken = reap_completions() || !wait;
+  }
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::arm_wakeup(bool has_deadline, uint64_t deadline) noexcept
+{
+  if (!has_deadline)
+  {
+    deadline = UINT64_MAX;
+  }
+  if (wakeup_armed_ && wakeup_deadline_ == deadline)
+  {
+    return PROTON_OK;
+  }
+
+  // A cancel, the poll and its timeout, which must not be split by a submit
+  if (ring_.space_left() < 3 && ring_.submit() != PROTON_OK)
+  {
+    return PROTON_ERROR;
+  }
+
+  if (wakeup_armed_)
+  {
+    // Cancelling the poll cancels its timeout too
+    io_uring_sqe * cancel = ring_.get_sqe();
+    cancel->opcode = IORING_OP_ASYNC_CANCEL;
+    cancel->fd = -1;
+    cancel->addr = event_data(static_cast<uint32_t>(Source::WAKEUP), 0, wakeup_generation_);
+    cancel->user_data = event_data(static_cast<uint32_t>(Source::CANCEL), 0);
+  }
+
+  wakeup_generation_++;
+  io_uring_sqe * poll = ring_.get_sqe();
+  poll->opcode = IORING_OP_POLL_ADD;
+  poll->fd = wakeup_fd_;
+  poll->poll32_events = POLLIN;
+  poll->user_data = event_data(static_cast<uint32_t>(Source::WAKEUP), 0, wakeup_generation_);
+
+  if (has_deadline)
+  {
+    poll->flags = IOSQE_IO_LINK;
+    wakeup_timeout_.tv_sec = static_cast<int64_t>(deadline / 1000);
+    wakeup_timeout_.tv_nsec = static_cast<long long>(deadline % 1000) * 1000000;
+    io_uring_sqe * timeout = ring_.get_sqe();
+    timeout->opcode = IORING_OP_LINK_TIMEOUT;
+    timeout->fd = -1;
+    timeout->addr = reinterpret_cast<uint64_t>(&wakeup_timeout_);
+    timeout->len = 1;
+    timeout->timeout_flags = IORING_TIMEOUT_ABS;
+    timeout->user_data =
+      event_data(static_cast<uint32_t>(Source::TIMEOUT), 0, wakeup_generation_);
+  }
+
+  wakeup_armed_ = true;
+  wakeup_deadline_ = deadline;
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::arm_socket(size_t index) noexcept
+{
+  io_uring_sqe * sqe = ring_.get_sqe();
+  if (sqe == nullptr)
+  {
+    return PROTON_ERROR;
+  }
+
+  // One recvmsg keeps receiving into the provided buffers until it runs out of them
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = sockets_[index]->fd();
+  sqe->addr = reinterpret_cast<uint64_t>(&receive_msghdr_);
+  sqe->len = 1;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = RECEIVE_GROUP;
+  sqe->user_data = event_data(static_cast<uint32_t>(Source::SOCKET), index);
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::arm_port(size_t index) noexcept
+{
+  io_uring_sqe * sqe = ring_.get_sqe();
+  if (sqe == nullptr)
+  {
+    return PROTON_ERROR;
+  }
+
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = ports_[index].port->fd();
+  sqe->poll32_events = POLLIN;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = event_data(static_cast<uint32_t>(Source::PORT), index);
+  return PROTON_OK;
+}
+
+proton_status_e Runtime::arm_channel(size_t index) noexcept
+{
+  io_uring_sqe * sqe = ring_.get_sqe();
+  if (sqe == nullptr)
+  {
+    return PROTON_ERROR;
+  }
+
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = channels_[index]->fd();
+  sqe->poll32_events = POLLIN;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = event_data(static_cast<uint32_t>(Source::CHANNEL), index);
+  return PROTON_OK;
+}
+
+bool Runtime::reap_completions() noexcept
+{
+  bool woken = false;
+  for (const io_uring_cqe * cqe = ring_.peek_cqe(); cqe != nullptr; cqe = ring_.peek_cqe())
+  {
+    const uint64_t data = cqe->user_data;
+    const int32_t res = cqe->res;
+    const uint32_t flags = cqe->flags;
+    ring_.cqe_seen();
+
+    const size_t index = event_index(data);
+    const bool current = event_generation(data) == wakeup_generation_;
+    switch (static_cast<Source>(event_source(data)))
+    {
+      case Source::WAKEUP:
+        // The poll ends when the event is written to, or is cancelled by its timeout
+        if (current)
+        {
+          wakeup_armed_ = false;
+          if (res > 0)
+          {
+            drain(wakeup_fd_);
+          }
+          woken = woken || res != -ECANCELED;
+        }
+        break;
+
+      case Source::TIMEOUT:
+        woken = woken || (current && res == -ETIME);
+        break;
+
+      case Source::SOCKET:
+        complete_receive(index, res, flags);
+        woken = true;
+        break;
+
+      case Source::PORT:
+        complete_port(index, res, flags);
+        woken = true;
+        break;
+
+      case Source::PORT_OUTPUT:
+        complete_port_output(index);
+        break;
+
+      case Source::CHANNEL:
+        complete_channel(index, res, flags);
+        woken = true;
+        break;
+
+      case Source::SEND:
+        // Messages left unsent for want of a slot can go now
+        if (complete_send(index, res, flags) && slots_exhausted_)
+        {
+          slots_exhausted_ = false;
+          woken = true;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+  return woken;
+}
+
+void Runtime::complete_receive(size_t index, int32_t res, uint32_t flags) noexcept
+{
+  if (res >= 0 && (flags & IORING_CQE_F_BUFFER))
+  {
+    const uint16_t id = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+    uint8_t * buffer = receive_buffer(id);
+    const io_uring_recvmsg_out * out = reinterpret_cast<const io_uring_recvmsg_out *>(buffer);
+    if (out->flags & MSG_TRUNC)
+    {
+      stats_.receive_errors++;
+    }
+    else
+    {
+      receive_datagram(buffer + sizeof(*out), out->payloadlen);
+    }
+
+    IoUring::add_buffer(receive_ring_, RECEIVE_BUFFERS, buffer, RECEIVE_BUFFER_SIZE, id, 0);
+    IoUring::advance_buffer_ring(receive_ring_, 1);
+  }
+  else if (res < 0 && res != -ENOBUFS)
+  {
+    stats_.receive_errors++;
+  }
+
+  // The recvmsg ends when it runs out of buffers, which are handed back by now
+  if (!(flags & IORING_CQE_F_MORE) && (res >= 0 || res == -ENOBUFS))
+  {
+    if (arm_socket(index) != PROTON_OK)
+    {
+      stats_.receive_errors++;
+    }
+  }
+}
+
+void Runtime::complete_port(size_t index, int32_t res, uint32_t flags) noexcept
+{
+  PortRoute & route = ports_[index];
+  if (res < 0)
+  {
+    if (res != -ECANCELED)
+    {
+      stats_.receive_errors++;
+    }
+    route.failed = true;
+    return;
+  }
+
+  receive_port(index);
+  if (!(flags & IORING_CQE_F_MORE) && !route.failed && arm_port(index) != PROTON_OK)
+  {
+    stats_.receive_errors++;
+  }
+}
+
+void Runtime::complete_port_output(size_t index) noexcept
+{
+  PortRoute & route = ports_[index];
+  route.watching_output = false;
+  if (!route.failed)
+  {
+    route.port->flush();
+    update_port_output(index);
+  }
+}
+
+void Runtime::complete_channel(size_t index, int32_t res, uint32_t flags) noexcept
+{
+  if (res < 0)
+  {
+    if (res != -ECANCELED)
+    {
+      stats_.receive_errors++;
+    }
+    return;
+  }
+
+  if (!(flags & IORING_CQE_F_MORE) && arm_channel(index) != PROTON_OK)
+  {
+    stats_.receive_errors++;
+  }
+}
+
+bool Runtime::complete_send(size_t slot, int32_t res, uint32_t flags) noexcept
+{
+  // A zero-copy send completes once sent, then once more when the kernel is done with the buffer
+  if (!(flags & IORING_CQE_F_NOTIF))
+  {
+    if (res < 0)
+    {
+      stats_.send_errors++;
+    }
+    if (flags & IORING_CQE_F_MORE)
+    {
+      return false;
+    }
+  }
+  return --slot_completions_[slot] == 0;
+}
+
+uint8_t * Runtime::receive_buffer(uint16_t id) const noexcept
+{
+  return ring_buffers_ + BUFFER_RING_SIZE + id * RECEIVE_BUFFER_SIZE;
+}
+
+uint8_t * Runtime::send_slot(size_t slot) const noexcept
+{
+  return ring_buffers_ + BUFFER_RING_SIZE + RECEIVE_BUFFERS * RECEIVE_BUFFER_SIZE +
+         slot * FRAME_BUFFER_SIZE;
+}
+
+bool Runtime::acquire_slot(size_t & slot) noexcept
+{
+  for (int attempt = 0; attempt < 2; attempt++)
+  {
+    for (slot = 0; slot < SEND_SLOTS; slot++)
+    {
+      if (slot_completions_[slot] == 0)
+      {
+        slots_exhausted_ = false;
+        return true;
+      }
+    }
+    if (attempt == 0 && ring_.submit() == PROTON_OK)
+    {
+      reap_completions();
+    }
+  }
+  slots_exhausted_ = true;
+  return false;
+}
+
+proton_status_e Runtime::send_due() noexcept
+{
+  const bool uring = backend_ == RuntimeBackend::IO_URING;
+  const uint64_t now = uptime_ms();
+  for (size_t i = 0; i < MAX_UPDATES_PER_WAKEUP; i++)
+  {
+    // With io_uring, each message is encoded into a registered slot it stays in until sent
+    size_t slot = 0;
+    if (uring && !acquire_slot(slot))
+    {
+      break;
+    }
+    uint8_t * frame = uring ? send_slot(slot) : tx_buffer_;
+
+    size_t out_len = 0;
+    size_t num_selected_peers = 0;
+    proton_status_e status = proton_node_update_framed(
+      node_, now, frame, FRAME_BUFFER_SIZE, &framing_, &out_len, selected_peers_, UINT8_MAX,
+      &num_selected_peers);
+    if (status == PROTON_MUTEX_ERROR || status == PROTON_ERROR)
+    {
+      // The registry could not be locked or unlocked, nothing else can be sent either
+      return status;
+    }
+    if (status != PROTON_OK)
+    {
+      // A bundle that cannot be encoded, such as one larger than a frame, is consumed by the
+      // failed update. The next one is sent regardless.
+      stats_.send_errors++;
+      continue;
+    }
+    if (out_len == 0)
+    {
+      break;
+    }
+
+    stats_.messages_sent++;
+    send_message(frame, slot, out_len - HEADROOM - TAILROOM, num_selected_peers);
+  }
+
+  // The sends of every message go to the kernel at once
+  return uring ? ring_.submit() : PROTON_OK;
+}
+
+void Runtime::send_message(
+  uint8_t * frame, size_t slot, size_t payload_len, size_t num_selected_peers) noexcept
+{
+  size_t routed = 0;
+
+  // Serial peers first, ports copy the frame before the udp4 header overwrites the serial one
+  for (size_t p = 0; p < num_selected_peers; p++)
+  {
+    const proton_endpoint_t & peer = selected_peers_[p];
+    if (peer.transport_type != TRANSPORT_TYPE_SERIAL)
+    {
+      continue;
+    }
+
+    for (size_t i = 0; i < num_ports_; i++)
+    {
+      PortRoute & route = ports_[i];
+      if (route.peer_node_id != peer.node_id || route.peer_endpoint_id != peer.endpoint_id)
+      {
+        continue;
+      }
+
+      const proton_framing_t framing = route.port->framing();
+      if (
+        framing.fill(frame, payload_len, frame_flags_, framing.arg) != PROTON_OK ||
+        route.port->send_frame(frame, HEADROOM + payload_len + framing.tailroom) != PROTON_OK)
+      {
+        stats_.send_errors++;
+      }
+      update_port_output(i);
+      routed++;
+      break;
+    }
+  }
+
+  // Each shm peer is sent to through the first channel that has a ring name for it. Only the
+  // payload is copied into its ring, the sending node and flags go in the slot.
+  uint8_t node_id = static_cast<uint8_t>(node_->id);
+  for (size_t p = 0; p < num_selected_peers; p++)
+  {
+    const proton_endpoint_t & peer = selected_peers_[p];
+    for (size_t c = 0; c < num_channels_ && peer.transport_type == TRANSPORT_TYPE_SHM; c++)
+    {
+      if (!channels_[c]->has_peer(peer.node_id, peer.endpoint_id))
+      {
+        continue;
+      }
+
+      size_t sent = 0;
+      if (
+        channels_[c]->send(frame + HEADROOM, payload_len, node_id, frame_flags_, &peer, 1, sent) !=
+        PROTON_OK)
+      {
+        stats_.send_errors++;
+      }
+      routed++;
+      break;
+    }
+  }
+
+  // Each udp4 peer is sent to through the first socket that has an address for it
+  size_t num_udp4_peers = 0;
+  for (size_t p = 0; p < num_selected_peers; p++)
+  {
+    const proton_endpoint_t & peer = selected_peers_[p];
+    peer_sockets_[p] = MAX_SOCKETS;
+    for (size_t s = 0; s < num_sockets_ && peer.transport_type == TRANSPORT_TYPE_UDP4; s++)
+    {
+      if (sockets_[s]->has_peer(peer.node_id, peer.endpoint_id))
+      {
+        peer_sockets_[p] = static_cast<uint8_t>(s);
+        num_udp4_peers++;
+        break;
+      }
+    }
+  }
+  routed += num_udp4_peers;
+  stats_.send_errors += num_selected_peers - routed;
+  if (num_udp4_peers == 0)
+  {
+    return;
+  }
+
+  proton_udp4_fill_frame(frame, payload_len, frame_flags_, &node_id);
+  const size_t len = HEADROOM + payload_len;
+
+  if (backend_ == RuntimeBackend::IO_URING)
+  {
+    // One zero-copy send per peer, from the registered slot
+    for (size_t p = 0; p < num_selected_peers; p++)
+    {
+      if (peer_sockets_[p] == MAX_SOCKETS)
+      {
+        continue;
+      }
+      const transport::udp4::Socket & socket = *sockets_[peer_sockets_[p]];
+      io_uring_sqe * sqe = ring_.get_sqe();
+      if (sqe == nullptr)
+      {
+        stats_.send_errors++;
+        continue;
+      }
+      sqe->opcode = IORING_OP_SEND_ZC;
+      sqe->fd = socket.fd();
+      sqe->addr = reinterpret_cast<uint64_t>(frame);
+      sqe->len = static_cast<uint32_t>(len);
+      sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+      sqe->buf_index = static_cast<uint16_t>(slot);
+      sqe->addr2 = reinterpret_cast<uint64_t>(
+        socket.peer_address(selected_peers_[p].node_id, selected_peers_[p].endpoint_id));
+      sqe->addr_len = sizeof(sockaddr_in);
+      sqe->user_data = event_data(static_cast<uint32_t>(Source::SEND), slot);
+      slot_completions_[slot]++;
+    }
+    return;
+  }
+
+  // One sendmmsg per socket
+  for (size_t s = 0; s < num_sockets_; s++)
+  {
+    size_t num_socket_peers = 0;
+    for (size_t p = 0; p < num_selected_peers; p++)
+    {
+      if (peer_sockets_[p] == s)
+      {
+        socket_peers_[num_socket_peers++] = selected_peers_[p];
+      }
+    }
+    if (num_socket_peers == 0)
+    {
+      continue;
+    }
+
+    size_t sent = 0;
+    if (sockets_[s]->send(frame, len, socket_peers_, num_socket_peers, sent) != PROTON_OK)
+    {
+      stats_.send_errors += num_socket_peers - sent;
+    }
+  }
+}
+
+void Runtime::receive_frame(
+  const uint8_t * data, size_t len, uint32_t peer_node_id, uint8_t flags) noexcept
+{
+  stats_.frames_received++;
+  if (proton_node_receive_frame(node_, data, len, peer_node_id, flags) != PROTON_OK)
+  {
+    stats_.receive_errors++;
+  }
+}
+
+void Runtime::receive_socket(size_t index) noexcept
+{
+  size_t received = 0;
+  do
+  {
+    for (size_t i = 0; i < RECEIVE_BATCH; i++)
+    {
+      datagrams_[i].data = rx_buffers_[i];
+      datagrams_[i].capacity = FRAME_BUFFER_SIZE;
+    }
+    if (sockets_[index]->receive(datagrams_, RECEIVE_BATCH, received) != PROTON_OK)
+    {
+      stats_.receive_errors++;
+      return;
+    }
+
+    for (size_t i = 0; i < received; i++)
+    {
+      const transport::udp4::Datagram & datagram = datagrams_[i];
+      // With UDP GRO a datagram holds several coalesced ones
+      const size_t segment_size =
+        datagram.segment_size != 0 ? datagram.segment_size : datagram.length;
+      // Of a truncated datagram, only the coalesced ones received whole are decoded
+      size_t length = datagram.length;
+      if (datagram.truncated)
+      {
+        stats_.receive_errors++;
+        length = datagram.segment_size != 0 ? length - length % segment_size : 0;
+      }
+      for (size_t offset = 0; offset < length; offset += segment_size)
+      {
+        const size_t len = length - offset < segment_size ? length - offset : segment_size;
+        receive_datagram(datagram.data + offset, len);
+      }
+    }
+  } while (received == RECEIVE_BATCH);
+}
+
+void Runtime::receive_datagram(const uint8_t * data, size_t len) noexcept
+{
+  proton_udp4_header_t header;
+  if (proton_udp4_check_payload(data, static_cast<uint16_t>(len), &header) != PROTON_OK)
+  {
+    stats_.receive_errors++;
+    return;
+  }
+
+  // Version 1 messages have no header, nor any way of telling the sending node
+  if (header.version == UDP4_VERSION_1)
+  {
+    receive_frame(data, len, 0, 0);
+  }
+  else
+  {
+    receive_frame(data + sizeof(header), len - sizeof(header), header.node_id, header.flags);
+  }
+}
+
+void Runtime::receive_port(size_t index) noexcept
+{
+  const PortRoute & route = ports_[index];
+  size_t received = 0;
+  do
+  {
+    if (route.port->read(received) != PROTON_OK)
+    {
+      // Stop watching a port that failed or hung up, rather than waking up for it forever
+      stats_.receive_errors++;
+      unwatch_port(index);
+      return;
+    }
+
+    transport::serial::frame_t frame;
+    while (route.port->receive(frame) == PROTON_OK && frame.payload != nullptr)
+    {
+      receive_frame(frame.payload, frame.length, route.peer_node_id, frame.flags);
+    }
+  } while (received > 0);
+}
+
+bool Runtime::prepare_channels() noexcept
+{
+  bool pending = false;
+  for (size_t i = 0; i < num_channels_; i++)
+  {
+    pending = channels_[i]->prepare_wait() || pending;
+  }
+  return pending;
+}
+
+void Runtime::receive_channel(size_t index) noexcept
+{
+  transport::shm::Channel & channel = *channels_[index];
+  for (size_t i = 0; i < CHANNEL_RECEIVE_BATCH; i++)
+  {
+    transport::shm::Frame frame;
+    if (channel.receive(frame) != PROTON_OK || frame.payload == nullptr)
+    {
+      return;
+    }
+    receive_frame(frame.payload, frame.length, frame.node_id, frame.flags);
+    channel.release();
+  }
+}
+
+void Runtime::update_port_output(size_t index) noexcept
+{
+  PortRoute & route = ports_[index];
+  const bool pending = route.port->pending() > 0;
+  if (pending == route.watching_output || route.failed)
+  {
+    return;
+  }
+
+  if (backend_ == RuntimeBackend::IO_URING)
+  {
+    // A poll already queued completes on its own once the bytes are gone
+    io_uring_sqe * sqe = pending ? ring_.get_sqe() : nullptr;
+    if (sqe != nullptr)
+    {
+      sqe->opcode = IORING_OP_POLL_ADD;
+      sqe->fd = route.port->fd();
+      sqe->poll32_events = POLLOUT;
+      sqe->user_data = event_data(static_cast<uint32_t>(Source::PORT_OUTPUT), index);
+      route.watching_output = true;
+    }
+    return;
+  }
+
+  epoll_event event = {};
+  event.events = pending ? EPOLLIN | EPOLLOUT : EPOLLIN;
+  event.data.u64 = event_data(static_cast<uint32_t>(Source::PORT), index);
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, route.port->fd(), &event) == 0)
+  {
+    route.watching_output = pending;
+  }
+}
+
+void Runtime::unwatch_port(size_t index) noexcept
+{
+  PortRoute & route = ports_[index];
+  route.failed = true;
+  if (backend_ == RuntimeBackend::EPOLL)
+  {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, route.port->fd(), nullptr);
+    return;
+  }
+
+  io_uring_sqe * sqe = ring_.get_sqe();
+  if (sqe != nullptr)
+  {
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = event_data(static_cast<uint32_t>(Source::PORT), index);
+    sqe->user_data = event_data(static_cast<uint32_t>(Source::CANCEL), 0);
+  }
+}
+
+proton_status_e Runtime::record_flags(
+  uint8_t * frame, size_t payload_len, uint8_t flags, void * arg) noexcept
+{
+  (void)frame;
+  (void)payload_len;
+  static_cast<Runtime *>(arg)->frame_flags_ = flags;
+  return PROTON_OK;
+}
+
+#if PROTON_NODE_BUILDER
+
+proton_status_e Runtime::open(
+  node_builder::GeneratedNode & node, const node_builder::Config & config,
+  const std::string & target_name, RuntimeBackend backend) noexcept
+{
+  proton_status_e status = open(node.node(), backend);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  auto target = config.nodes.find(target_name);
+  if (target == config.nodes.end())
+  {
+    close();
+    return PROTON_INCORRECT_TARGET_ERROR;
+  }
+
+  for (const auto & [id, endpoint] : target->second.endpoints)
+  {
+    // Endpoints of the other nodes this endpoint is connected to
+    std::vector<std::pair<const node_builder::NodeConfig *, const node_builder::EndpointConfig *>>
+      connected;
+    for (const node_builder::ConnectionConfig & connection : config.connections)
+    {
+      const node_builder::ConnectionEndpointConfig * other = nullptr;
+      if (connection.first.node == target_name && connection.first.id == id)
+      {
+        other = &connection.second;
+      }
+      else if (connection.second.node == target_name && connection.second.id == id)
+      {
+        other = &connection.first;
+      }
+
+      auto other_node = other != nullptr ? config.nodes.find(other->node) : config.nodes.end();
+      if (other_node == config.nodes.end())
+      {
+        continue;
+      }
+      auto other_endpoint = other_node->second.endpoints.find(other->id);
+      if (other_endpoint != other_node->second.endpoints.end())
+      {
+        connected.emplace_back(&other_node->second, &other_endpoint->second);
+      }
+    }
+
+    if (endpoint.type == node_builder::transport_types::UDP4)
+    {
+      auto socket = std::make_unique<transport::udp4::Socket>();
+      status = socket->open(endpoint);
+      if (status == PROTON_OK && connected.empty())
+      {
+        status = socket->add_peers(config, target_name);
+      }
+      for (const auto & [peer_node, peer_endpoint] : connected)
+      {
+        if (status == PROTON_OK && peer_endpoint->port > UINT16_MAX)
+        {
+          status = PROTON_CONNECT_ERROR;
+        }
+        if (status == PROTON_OK)
+        {
+          status = socket->add_peer(
+            peer_node->id, peer_endpoint->id, peer_endpoint->ip.c_str(),
+            static_cast<uint16_t>(peer_endpoint->port));
+        }
+      }
+      if (status == PROTON_OK)
+      {
+        status = add_socket(*socket);
+      }
+      if (status == PROTON_OK)
+      {
+        owned_sockets_.push_back(std::move(socket));
+      }
+    }
+    else if (endpoint.type == node_builder::transport_types::SERIAL)
+    {
+      auto port = std::make_unique<transport::serial::Port>();
+      status = port->open(endpoint);
+      // A serial endpoint without a connection is only received from
+      const uint32_t peer_node_id = connected.empty() ? 0 : connected.front().first->id;
+      const uint32_t peer_endpoint_id = connected.empty() ? 0 : connected.front().second->id;
+      if (status == PROTON_OK)
+      {
+        status = add_port(*port, peer_node_id, peer_endpoint_id);
+      }
+      if (status == PROTON_OK)
+      {
+        owned_ports_.push_back(std::move(port));
+      }
+    }
+
+    else if (endpoint.type == node_builder::transport_types::SHM)
+    {
+      auto channel = std::make_unique<transport::shm::Channel>();
+      status = channel->open(endpoint);
+      if (status == PROTON_OK && connected.empty())
+      {
+        status = channel->add_peers(config, target_name);
+      }
+      for (const auto & [peer_node, peer_endpoint] : connected)
+      {
+        if (status == PROTON_OK)
+        {
+          status =
+            channel->add_peer(peer_node->id, peer_endpoint->id, peer_endpoint->device.c_str());
+        }
+      }
+      if (status == PROTON_OK)
+      {
+        status = add_channel(*channel);
+      }
+      if (status == PROTON_OK)
+      {
+        owned_channels_.push_back(std::move(channel));
+      }
+    }
+
+    if (status != PROTON_OK)
+    {
+      close();
+      return status;
+    }
+  }
+
+  return PROTON_OK;
+}
+
+#endif
+
+}  // namespace proton
@@ -84,6 +84,27 @@ proton_status_e SignalAccess::set(uint32_t id, bool value) noexcept
   return proton_signal_set_bool(registry_, id, value);
 }
 
+proton_status_e SignalAccess::get(uint32_t id, Flags & out) const noexcept
+{
+  uint64_t bits = 0;
+  const proton_status_e status = proton_signal_get_flags(registry_, id, &bits);
+  out = static_cast<Flags>(bits);
+  return status;
+}
+proton_status_e SignalAccess::set(uint32_t id, Flags value) noexcept
+{
+  return proton_signal_set_flags(registry_, id, static_cast<uint64_t>(value));
+}
+
+proton_status_e SignalAccess::get_flag(uint32_t id, uint8_t bit, bool & out) const noexcept
+{
+  return proton_signal_get_flag(registry_, id, bit, &out);
+}
+proton_status_e SignalAccess::set_flag(uint32_t id, uint8_t bit, bool value) noexcept
+{
+  return proton_signal_set_flag(registry_, id, bit, value);
+}
+
 proton_status_e SignalAccess::get(uint32_t id, char * buf, size_t cap, size_t & len) const noexcept
 {
   return proton_signal_get_string(registry_, id, buf, cap, &len);
@@ -103,4 +124,114 @@ proton_status_e SignalAccess::set(uint32_t id, const uint8_t * buf, size_t len)
   return proton_signal_set_bytes(registry_, id, buf, len);
 }
 
+// Handle-based accessors
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, double & out) const noexcept
+{
+  return proton_signal_handle_get_double(registry_, handle, &out);
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, double value) noexcept
+{
+  return proton_signal_handle_set_double(registry_, handle, value);
+}
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, float & out) const noexcept
+{
+  return proton_signal_handle_get_float(registry_, handle, &out);
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, float value) noexcept
+{
+  return proton_signal_handle_set_float(registry_, handle, value);
+}
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, int32_t & out) const noexcept
+{
+  return proton_signal_handle_get_int32(registry_, handle, &out);
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, int32_t value) noexcept
+{
+  return proton_signal_handle_set_int32(registry_, handle, value);
+}
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, int64_t & out) const noexcept
+{
+  return proton_signal_handle_get_int64(registry_, handle, &out);
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, int64_t value) noexcept
+{
+  return proton_signal_handle_set_int64(registry_, handle, value);
+}
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, uint32_t & out) const noexcept
+{
+  return proton_signal_handle_get_uint32(registry_, handle, &out);
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, uint32_t value) noexcept
+{
+  return proton_signal_handle_set_uint32(registry_, handle, value);
+}
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, uint64_t & out) const noexcept
+{
+  return proton_signal_handle_get_uint64(registry_, handle, &out);
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, uint64_t value) noexcept
+{
+  return proton_signal_handle_set_uint64(registry_, handle, value);
+}
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, bool & out) const noexcept
+{
+  return proton_signal_handle_get_bool(registry_, handle, &out);
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, bool value) noexcept
+{
+  return proton_signal_handle_set_bool(registry_, handle, value);
+}
+
+proton_status_e SignalAccess::get(proton_signal_handle_t handle, Flags & out) const noexcept
+{
+  uint64_t bits = 0;
+  const proton_status_e status = proton_signal_handle_get_flags(registry_, handle, &bits);
+  out = static_cast<Flags>(bits);
+  return status;
+}
+proton_status_e SignalAccess::set(proton_signal_handle_t handle, Flags value) noexcept
+{
+  return proton_signal_handle_set_flags(registry_, handle, static_cast<uint64_t>(value));
+}
+
+proton_status_e SignalAccess::get_flag(
+  proton_signal_handle_t handle, uint8_t bit, bool & out) const noexcept
+{
+  return proton_signal_handle_get_flag(registry_, handle, bit, &out);
+}
+proton_status_e SignalAccess::set_flag(
+  proton_signal_handle_t handle, uint8_t bit, bool value) noexcept
+{
+  return proton_signal_handle_set_flag(registry_, handle, bit, value);
+}
+
+proton_status_e SignalAccess::get(
+  proton_signal_handle_t handle, char * buf, size_t cap, size_t & len) const noexcept
+{
+  return proton_signal_handle_get_string(registry_, handle, buf, cap, &len);
+}
+proton_status_e SignalAccess::set(
+  proton_signal_handle_t handle, const char * buf, size_t len) const noexcept
+{
+  return proton_signal_handle_set_string(registry_, handle, buf, len);
+}
+
+proton_status_e SignalAccess::get(
+  proton_signal_handle_t handle, uint8_t * buf, size_t cap, size_t & len) const noexcept
+{
+  return proton_signal_handle_get_bytes(registry_, handle, buf, cap, &len);
+}
+proton_status_e SignalAccess::set(
+  proton_signal_handle_t handle, const uint8_t * buf, size_t len) const noexcept
+{
+  return proton_signal_handle_set_bytes(registry_, handle, buf, len);
+}
+
 }  // namespace proton
@@ -0,0 +1,378 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "protoncpp/transport/serial_port.hpp"
+
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace proton::transport::serial
+{
+
+namespace
+{
+
+// Most buffers written by one writev: the transmit queue, then a header, payload and CRC
+constexpr size_t MAX_WRITE_PARTS = 4;
+
+struct BaudRate
+{
+  uint32_t baud_rate;
+  speed_t speed;
+};
+
+constexpr BaudRate BAUD_RATES[] = {
+  {1200, B1200},
+  {2400, B2400},
+  {4800, B4800},
+  {9600, B9600},
+  {19200, B19200},
+  {38400, B38400},
+  {57600, B57600},
+  {115200, B115200},
+  {230400, B230400},
+  {460800, B460800},
+  {500000, B500000},
+  {576000, B576000},
+  {921600, B921600},
+  {1000000, B1000000},
+  {1152000, B1152000},
+  {1500000, B1500000},
+  {2000000, B2000000},
+  {2500000, B2500000},
+  {3000000, B3000000},
+  {3500000, B3500000},
+  {4000000, B4000000},
+};
+
+bool baud_to_speed(uint32_t baud_rate, speed_t & speed)
+{
+  for (const BaudRate & rate : BAUD_RATES)
+  {
+    if (rate.baud_rate == baud_rate)
+    {
+      speed = rate.speed;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+Port::~Port()
+{
+  close();
+}
+
+proton_status_e Port::open(const char * device, const PortOptions & options) noexcept
+{
+  close();
+
+  speed_t speed;
+  if (device == nullptr || device[0] == '\0' || !baud_to_speed(options.baud_rate, speed))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  proton_status_e status =
+    parser_init(parser_, parser_buffer_, sizeof(parser_buffer_), options.max_payload_len);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  fd_ = ::open(device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  if (fd_ < 0)
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  termios tio;
+  if (::tcgetattr(fd_, &tio) != 0)
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+
+  // 8N1 without flow control, and no processing of any byte in either direction
+  ::cfmakeraw(&tio);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+  tio.c_cc[VMIN] = options.vmin;
+  tio.c_cc[VTIME] = options.vtime;
+  if (
+    ::cfsetispeed(&tio, speed) != 0 || ::cfsetospeed(&tio, speed) != 0 ||
+    ::tcsetattr(fd_, TCSANOW, &tio) != 0)
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+
+  if (options.low_latency)
+  {
+    serial_struct serial;
+    if (::ioctl(fd_, TIOCGSERIAL, &serial) == 0)
+    {
+      serial.flags |= ASYNC_LOW_LATENCY;
+      ::ioctl(fd_, TIOCSSERIAL, &serial);
+    }
+  }
+
+  // Drop whatever was received before the port was configured
+  ::tcflush(fd_, TCIOFLUSH);
+
+  crc32c_ = options.crc32c;
+  rx_ring_.clear();
+  rx_consumed_ = 0;
+  tx_start_ = 0;
+  tx_end_ = 0;
+
+  return PROTON_OK;
+}
+
+void Port::close() noexcept
+{
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+proton_status_e Port::read(size_t & received, int timeout_ms) noexcept
+{
+  received = 0;
+  if (fd_ < 0)
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+
+  if (timeout_ms != 0)
+  {
+    pollfd pfd = {fd_, POLLIN, 0};
+    int ready = ::poll(&pfd, 1, timeout_ms);
+    if (ready == 0 || (ready < 0 && errno == EINTR))
+    {
+      return PROTON_OK;
+    }
+    if (ready < 0)
+    {
+      return PROTON_READ_ERROR;
+    }
+  }
+
+  RingRegions<uint8_t> free = rx_ring_.writable();
+  if (free.size() == 0)
+  {
+    return PROTON_OK;
+  }
+
+  iovec iov[2] = {{free.data[0], free.len[0]}, {free.data[1], free.len[1]}};
+  ssize_t ret;
+  do
+  {
+    ret = ::readv(fd_, iov, free.len[1] > 0 ? 2 : 1);
+  } while (ret < 0 && errno == EINTR);
+
+  if (ret < 0)
+  {
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? PROTON_OK : PROTON_READ_ERROR;
+  }
+
+  rx_ring_.commit(static_cast<size_t>(ret));
+  received = static_cast<size_t>(ret);
+
+  return PROTON_OK;
+}
+
+proton_status_e Port::receive(frame_t & frame) noexcept
+{
+  frame = {};
+  rx_ring_.release(rx_consumed_);
+  rx_consumed_ = 0;
+
+  while (true)
+  {
+    // A frame wrapping around the end of the ring is copied to the parser buffer, so the regions
+    // are parsed one at a time
+    RingRegions<const uint8_t> data = rx_ring_.readable();
+    if (data.len[0] == 0)
+    {
+      return PROTON_OK;
+    }
+
+    size_t consumed = 0;
+    proton_status_e status = parser_feed(parser_, data.data[0], data.len[0], consumed, frame);
+    if (frame.payload != nullptr)
+    {
+      rx_consumed_ = consumed;
+      return PROTON_OK;
+    }
+
+    rx_ring_.release(consumed);
+    // The parser resynchronizes after a bad frame, and counts it
+    if (
+      status != PROTON_OK && status != PROTON_CRC16_ERROR &&
+      status != PROTON_INVALID_HEADER_ERROR)
+    {
+      return status;
+    }
+    if (consumed == 0)
+    {
+      return PROTON_OK;
+    }
+  }
+}
+
+proton_status_e Port::send(const uint8_t * payload, uint16_t len, uint8_t flags) noexcept
+{
+  if (payload == nullptr)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+
+  if (crc32c_)
+  {
+    flags |= FRAME_FLAG_CRC32C;
+  }
+
+  uint8_t header[FRAME_HEADER_OVERHEAD];
+  uint8_t crc[FRAME_CRC32C_OVERHEAD];
+  size_t crc_len = FRAME_CRC_OVERHEAD;
+  proton_status_e status = fill_frame_header(header, len, flags);
+  if (status == PROTON_OK && (flags & FRAME_FLAG_CRC32C))
+  {
+    crc_len = FRAME_CRC32C_OVERHEAD;
+    status = fill_crc32c(payload, len, crc);
+  }
+  else if (status == PROTON_OK)
+  {
+    status = fill_crc16(payload, len, crc);
+  }
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  const uint8_t * parts[] = {header, payload, crc};
+  const size_t lens[] = {sizeof(header), len, crc_len};
+  return write_parts(parts, lens, 3);
+}
+
+proton_status_e Port::send_frame(const uint8_t * frame, size_t len) noexcept
+{
+  if (frame == nullptr)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  return write_parts(&frame, &len, 1);
+}
+
+proton_status_e Port::flush() noexcept
+{
+  return write_parts(nullptr, nullptr, 0);
+}
+
+proton_status_e Port::write_parts(
+  const uint8_t * const * parts, const size_t * lens, size_t count) noexcept
+{
+  if (fd_ < 0)
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+
+  // Whatever the device does not take is queued, so the frame must fit behind the queue
+  size_t total = pending();
+  for (size_t i = 0; i < count; i++)
+  {
+    total += lens[i];
+  }
+  if (total > TX_BUFFER_SIZE)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  iovec iov[MAX_WRITE_PARTS];
+  int iov_count = 0;
+  if (pending() > 0)
+  {
+    iov[iov_count++] = {tx_buffer_ + tx_start_, pending()};
+  }
+  for (size_t i = 0; i < count; i++)
+  {
+    iov[iov_count++] = {const_cast<uint8_t *>(parts[i]), lens[i]};
+  }
+  if (iov_count == 0)
+  {
+    return PROTON_OK;
+  }
+
+  ssize_t ret;
+  do
+  {
+    ret = ::writev(fd_, iov, iov_count);
+  } while (ret < 0 && errno == EINTR);
+
+  if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+  {
+    return PROTON_WRITE_ERROR;
+  }
+  size_t written = ret < 0 ? 0 : static_cast<size_t>(ret);
+
+  // Drop the sent part of the queue and move the rest to the front, then queue what is left of
+  // the new parts behind it
+  const size_t from_queue = written < pending() ? written : pending();
+  tx_start_ += from_queue;
+  written -= from_queue;
+  std::memmove(tx_buffer_, tx_buffer_ + tx_start_, pending());
+  tx_end_ -= tx_start_;
+  tx_start_ = 0;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const size_t skip = written < lens[i] ? written : lens[i];
+    written -= skip;
+    std::memcpy(tx_buffer_ + tx_end_, parts[i] + skip, lens[i] - skip);
+    tx_end_ += lens[i] - skip;
+  }
+
+  return PROTON_OK;
+}
+
+#if PROTON_NODE_BUILDER
+
+proton_status_e Port::open(
+  const node_builder::EndpointConfig & endpoint, const PortOptions & options) noexcept
+{
+  if (endpoint.type != "serial")
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+  return open(endpoint.device.c_str(), options);
+}
+
+#endif
+
+}  // namespace proton::transport::serial
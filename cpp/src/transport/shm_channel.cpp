@@ -0,0 +1,615 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "protoncpp/transport/shm_channel.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+namespace proton::transport::shm
+{
+
+namespace
+{
+
+constexpr uint32_t RING_MAGIC = 0x4d485350;  // "PSHM"
+constexpr uint32_t RING_VERSION = 1;
+constexpr size_t CACHE_LINE = 64;
+
+// The atomics are shared between processes, which only works if they are lock-free
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+constexpr size_t align_up(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+bool valid_name(const char * name, size_t max_length)
+{
+  return name != nullptr && name[0] == '/' && std::strchr(name + 1, '/') == nullptr &&
+         std::strlen(name) > 1 && std::strlen(name) < max_length;
+}
+
+// Abstract unix socket address of the doorbell of a ring
+socklen_t doorbell_address(const char * name, sockaddr_un & address)
+{
+  static constexpr char PREFIX[] = "proton-shm";
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path + 1, PREFIX, sizeof(PREFIX) - 1);
+  const size_t name_len = std::strlen(name);
+  std::memcpy(address.sun_path + sizeof(PREFIX), name, name_len);
+  return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + sizeof(PREFIX) + name_len);
+}
+
+}  // namespace
+
+// Start of the shared memory, followed by the slots
+struct Ring::Header
+{
+  // Stored last by the consumer, once the ring is ready
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t slots;
+  uint32_t slot_size;
+  // Set by the consumer once it closes the ring
+  std::atomic<uint32_t> closed;
+  // Set by the consumer before it sleeps, and cleared by the producer that wakes it up
+  std::atomic<uint32_t> sleeping;
+  alignas(CACHE_LINE) std::atomic<uint64_t> enqueue_position;
+  alignas(CACHE_LINE) std::atomic<uint64_t> dequeue_position;
+};
+
+struct Ring::SlotHeader
+{
+  // position when free to claim, position + 1 once published
+  std::atomic<uint64_t> sequence;
+  uint32_t length;
+  uint8_t node_id;
+  uint8_t flags;
+  uint16_t reserved;
+};
+
+Ring::~Ring()
+{
+  close();
+}
+
+proton_status_e Ring::create(const char * name, const RingOptions & options) noexcept
+{
+  close();
+
+  if (!valid_name(name, sizeof(name_)))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+  if (options.slots == 0 || (options.slots & (options.slots - 1)) != 0 || options.slot_size == 0)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  const size_t stride = align_up(sizeof(SlotHeader) + options.slot_size, CACHE_LINE);
+  const size_t size = align_up(sizeof(Header), CACHE_LINE) + options.slots * stride;
+
+  // A ring left behind by a consumer that died is replaced, its producers attach again
+  ::shm_unlink(name);
+  int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd < 0)
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    ::close(fd);
+    ::shm_unlink(name);
+    return PROTON_CONNECT_ERROR;
+  }
+  proton_status_e status = map(fd, size);
+  ::close(fd);
+  if (status != PROTON_OK)
+  {
+    ::shm_unlink(name);
+    return status;
+  }
+
+  std::strcpy(name_, name);
+  consumer_ = true;
+  dequeue_position_ = 0;
+  slot_size_ = options.slot_size;
+  slot_stride_ = stride;
+  mask_ = options.slots - 1;
+
+  Header * header = new (header_) Header{};
+  header->version = RING_VERSION;
+  header->slots = options.slots;
+  header->slot_size = options.slot_size;
+  for (uint64_t position = 0; position < options.slots; position++)
+  {
+    new (slot_header(position)) SlotHeader{};
+    slot_header(position)->sequence.store(position, std::memory_order_relaxed);
+  }
+
+  header->magic.store(RING_MAGIC, std::memory_order_release);
+  return PROTON_OK;
+}
+
+proton_status_e Ring::attach(const char * name) noexcept
+{
+  close();
+
+  if (!valid_name(name, sizeof(name_)))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  int fd = ::shm_open(name, O_RDWR | O_CLOEXEC, 0);
+  if (fd < 0)
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+  struct stat st;
+  proton_status_e status = PROTON_CONNECT_ERROR;
+  if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header))
+  {
+    status = map(fd, static_cast<size_t>(st.st_size));
+  }
+  ::close(fd);
+  if (status != PROTON_OK)
+  {
+    return status;
+  }
+
+  // Reject rings still being created, of another version, or of a size their header disagrees with
+  const Header * header = header_;
+  const uint32_t magic = header->magic.load(std::memory_order_acquire);
+  const size_t stride = align_up(sizeof(SlotHeader) + header->slot_size, CACHE_LINE);
+  if (
+    magic != RING_MAGIC || header->version != RING_VERSION || header->slots == 0 ||
+    (header->slots & (header->slots - 1)) != 0 ||
+    align_up(sizeof(Header), CACHE_LINE) + header->slots * stride > size_)
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+
+  slot_size_ = header->slot_size;
+  slot_stride_ = stride;
+  mask_ = header->slots - 1;
+  return PROTON_OK;
+}
+
+proton_status_e Ring::map(int fd, size_t size) noexcept
+{
+  void * memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (memory == MAP_FAILED)
+  {
+    return PROTON_ERROR;
+  }
+  header_ = static_cast<Header *>(memory);
+  size_ = size;
+  return PROTON_OK;
+}
+
+void Ring::close() noexcept
+{
+  if (header_ == nullptr)
+  {
+    return;
+  }
+
+  if (consumer_)
+  {
+    header_->closed.store(1, std::memory_order_release);
+    ::shm_unlink(name_);
+    consumer_ = false;
+  }
+  ::munmap(header_, size_);
+  header_ = nullptr;
+  size_ = 0;
+}
+
+bool Ring::is_closed() const noexcept
+{
+  return header_ == nullptr || header_->closed.load(std::memory_order_acquire) != 0;
+}
+
+Ring::SlotHeader * Ring::slot_header(uint64_t position) const noexcept
+{
+  uint8_t * slots = reinterpret_cast<uint8_t *>(header_) + align_up(sizeof(Header), CACHE_LINE);
+  return reinterpret_cast<SlotHeader *>(slots + (position & mask_) * slot_stride_);
+}
+
+uint8_t * Ring::slot_data(uint64_t position) const noexcept
+{
+  return reinterpret_cast<uint8_t *>(slot_header(position)) + sizeof(SlotHeader);
+}
+
+proton_status_e Ring::claim(Slot & slot) noexcept
+{
+  if (!is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+
+  uint64_t position = header_->enqueue_position.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    const uint64_t sequence = slot_header(position)->sequence.load(std::memory_order_acquire);
+    const int64_t difference = static_cast<int64_t>(sequence - position);
+    if (difference == 0)
+    {
+      // The slot is free for this turn, take it unless another producer did
+      if (header_->enqueue_position.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (difference < 0)
+    {
+      // The consumer has not released the slot of the previous turn
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+    else
+    {
+      position = header_->enqueue_position.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot = {slot_data(position), slot_size_, position};
+  return PROTON_OK;
+}
+
+bool Ring::commit(const Slot & slot, size_t length, uint8_t node_id, uint8_t flags) noexcept
+{
+  SlotHeader * header = slot_header(slot.position);
+  header->length = static_cast<uint32_t>(length);
+  header->node_id = node_id;
+  header->flags = flags;
+  header->sequence.store(slot.position + 1, std::memory_order_release);
+
+  // Pairs with the fence of prepare_sleep: either the consumer sees the frame before sleeping, or
+  // this sees it asleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return length > 0 && header_->sleeping.load(std::memory_order_relaxed) != 0 &&
+         header_->sleeping.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+bool Ring::peek(Frame & frame) noexcept
+{
+  while (is_open())
+  {
+    const SlotHeader * header = slot_header(dequeue_position_);
+    if (header->sequence.load(std::memory_order_acquire) != dequeue_position_ + 1)
+    {
+      return false;
+    }
+    // Slots given back unused are skipped
+    if (header->length == 0 || header->length > slot_size_)
+    {
+      release();
+      continue;
+    }
+    frame = {slot_data(dequeue_position_), header->length, header->node_id, header->flags};
+    return true;
+  }
+  return false;
+}
+
+void Ring::release() noexcept
+{
+  slot_header(dequeue_position_)
+    ->sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+  dequeue_position_++;
+  header_->dequeue_position.store(dequeue_position_, std::memory_order_relaxed);
+}
+
+bool Ring::prepare_sleep() noexcept
+{
+  header_->sleeping.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const bool empty = slot_header(dequeue_position_)->sequence.load(std::memory_order_acquire) !=
+                     dequeue_position_ + 1;
+  if (!empty)
+  {
+    header_->sleeping.store(0, std::memory_order_relaxed);
+  }
+  return empty;
+}
+
+Channel::~Channel()
+{
+  close();
+}
+
+proton_status_e Channel::open(const char * name, const RingOptions & options) noexcept
+{
+  close();
+
+  if (!valid_name(name, MAX_NAME_LENGTH))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  // Binding the doorbell first makes sure no other channel consumes from the ring
+  fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  sockaddr_un address;
+  const socklen_t address_len = doorbell_address(name, address);
+  if (
+    fd_ < 0 || ::bind(fd_, reinterpret_cast<const sockaddr *>(&address), address_len) != 0)
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+
+  proton_status_e status = ring_.create(name, options);
+  if (status != PROTON_OK)
+  {
+    close();
+    return status;
+  }
+
+  std::strcpy(name_, name);
+  return PROTON_OK;
+}
+
+void Channel::close() noexcept
+{
+  ring_.close();
+  for (size_t i = 0; i < num_peers_; i++)
+  {
+    peers_[i].ring.close();
+  }
+  num_peers_ = 0;
+  name_[0] = '\0';
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+Channel::Peer * Channel::find_peer(uint32_t node_id, uint32_t endpoint_id) noexcept
+{
+  for (size_t i = 0; i < num_peers_; i++)
+  {
+    if (peers_[i].node_id == node_id && peers_[i].endpoint_id == endpoint_id)
+    {
+      return &peers_[i];
+    }
+  }
+  return nullptr;
+}
+
+bool Channel::has_peer(uint32_t node_id, uint32_t endpoint_id) const noexcept
+{
+  return const_cast<Channel *>(this)->find_peer(node_id, endpoint_id) != nullptr;
+}
+
+proton_status_e Channel::add_peer(
+  uint32_t node_id, uint32_t endpoint_id, const char * name) noexcept
+{
+  if (!valid_name(name, MAX_NAME_LENGTH))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  Peer * peer = find_peer(node_id, endpoint_id);
+  if (peer == nullptr)
+  {
+    if (num_peers_ == MAX_PEERS)
+    {
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+    peer = &peers_[num_peers_++];
+    peer->node_id = node_id;
+    peer->endpoint_id = endpoint_id;
+  }
+  peer->ring.close();
+  std::strcpy(peer->name, name);
+  return PROTON_OK;
+}
+
+proton_status_e Channel::attach(Peer & peer) noexcept
+{
+  // Attached the first time the peer is sent to, and again once its consumer closed the ring
+  if (peer.ring.is_open() && !peer.ring.is_closed())
+  {
+    return PROTON_OK;
+  }
+  return peer.ring.attach(peer.name) == PROTON_OK ? PROTON_OK : PROTON_WRITE_ERROR;
+}
+
+void Channel::wake(const Peer & peer) noexcept
+{
+  sockaddr_un address;
+  const socklen_t address_len = doorbell_address(peer.name, address);
+  const uint8_t bell = 0;
+  // Fails if the peer is gone, or its doorbell is full and it is woken up already
+  ::sendto(
+    fd_, &bell, sizeof(bell), MSG_DONTWAIT, reinterpret_cast<const sockaddr *>(&address),
+    address_len);
+}
+
+proton_status_e Channel::send(
+  const uint8_t * payload, size_t len, uint8_t node_id, uint8_t flags,
+  const proton_endpoint_t * peers, size_t num_peers, size_t & sent) noexcept
+{
+  sent = 0;
+  if (payload == nullptr || (peers == nullptr && num_peers > 0))
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  if (!is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+
+  proton_status_e status = PROTON_OK;
+  for (size_t i = 0; i < num_peers; i++)
+  {
+    Ring::Slot slot;
+    proton_status_e peer_status = claim(peers[i], slot);
+    if (peer_status == PROTON_OK && len > slot.capacity)
+    {
+      peer_status = PROTON_INSUFFICIENT_BUFFER_ERROR;
+      commit(peers[i], slot, 0, node_id, flags);
+    }
+    if (peer_status == PROTON_OK)
+    {
+      std::memcpy(slot.data, payload, len);
+      peer_status = commit(peers[i], slot, len, node_id, flags);
+    }
+
+    if (peer_status == PROTON_OK)
+    {
+      sent++;
+    }
+    else
+    {
+      status = peer_status;
+    }
+  }
+  return status;
+}
+
+proton_status_e Channel::claim(const proton_endpoint_t & peer, Ring::Slot & slot) noexcept
+{
+  Peer * p = find_peer(peer.node_id, peer.endpoint_id);
+  if (p == nullptr)
+  {
+    return PROTON_INCORRECT_TARGET_ERROR;
+  }
+  proton_status_e status = attach(*p);
+  if (status == PROTON_OK && p->ring.claim(slot) != PROTON_OK)
+  {
+    status = PROTON_WRITE_ERROR;
+  }
+  return status;
+}
+
+proton_status_e Channel::commit(
+  const proton_endpoint_t & peer, const Ring::Slot & slot, size_t len, uint8_t node_id,
+  uint8_t flags) noexcept
+{
+  Peer * p = find_peer(peer.node_id, peer.endpoint_id);
+  if (p == nullptr || !p->ring.is_open())
+  {
+    return PROTON_INCORRECT_TARGET_ERROR;
+  }
+  if (len > slot.capacity)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+  if (p->ring.commit(slot, len, node_id, flags))
+  {
+    wake(*p);
+  }
+  return PROTON_OK;
+}
+
+proton_status_e Channel::receive(Frame & frame) noexcept
+{
+  frame.payload = nullptr;
+  frame.length = 0;
+  if (!is_open())
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  ring_.peek(frame);
+  return PROTON_OK;
+}
+
+void Channel::release() noexcept
+{
+  if (is_open())
+  {
+    ring_.release();
+  }
+}
+
+bool Channel::prepare_wait() noexcept
+{
+  if (!is_open())
+  {
+    return false;
+  }
+
+  uint8_t bells[64];
+  while (::recv(fd_, bells, sizeof(bells), MSG_DONTWAIT) > 0)
+  {
+  }
+  return !ring_.prepare_sleep();
+}
+
+#if PROTON_NODE_BUILDER
+
+proton_status_e Channel::open(
+  const node_builder::EndpointConfig & endpoint, const RingOptions & options) noexcept
+{
+  if (endpoint.type != node_builder::transport_types::SHM)
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+
+  RingOptions endpoint_options = options;
+  if (endpoint.mtu != 0)
+  {
+    endpoint_options.slot_size = endpoint.mtu;
+  }
+  return open(endpoint.device.c_str(), endpoint_options);
+}
+
+proton_status_e Channel::add_peers(
+  const node_builder::Config & config, const std::string & target_name) noexcept
+{
+  for (const auto & [name, node] : config.nodes)
+  {
+    if (name == target_name)
+    {
+      continue;
+    }
+
+    for (const auto & [id, endpoint] : node.endpoints)
+    {
+      if (endpoint.type != node_builder::transport_types::SHM)
+      {
+        continue;
+      }
+      proton_status_e status = add_peer(node.id, endpoint.id, endpoint.device.c_str());
+      if (status != PROTON_OK)
+      {
+        return status;
+      }
+    }
+  }
+  return PROTON_OK;
+}
+
+#endif
+
+}  // namespace proton::transport::shm
@@ -0,0 +1,467 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "protoncpp/transport/udp4_socket.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+// Older libc headers lack the UDP segmentation offload options of linux/udp.h
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace proton::transport::udp4
+{
+
+namespace
+{
+
+bool make_address(const char * ip, uint16_t port, sockaddr_in & address)
+{
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if (ip == nullptr || ip[0] == '\0')
+  {
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    return true;
+  }
+  return inet_pton(AF_INET, ip, &address.sin_addr) == 1;
+}
+
+/**
+ * Run sendmmsg until every message is sent, retrying on EINTR
+ * @return number of messages sent
+ */
+size_t send_all(int fd, mmsghdr * messages, size_t count)
+{
+  size_t sent = 0;
+  while (sent < count)
+  {
+    int ret = ::sendmmsg(fd, messages + sent, static_cast<unsigned int>(count - sent), 0);
+    if (ret < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      break;
+    }
+    sent += static_cast<size_t>(ret);
+  }
+  return sent;
+}
+
+}  // namespace
+
+Socket::~Socket()
+{
+  close();
+}
+
+Socket::Socket(Socket && other) noexcept
+{
+  *this = static_cast<Socket &&>(other);
+}
+
+Socket & Socket::operator=(Socket && other) noexcept
+{
+  if (this != &other)
+  {
+    close();
+    fd_ = other.fd_;
+    gro_ = other.gro_;
+    num_peers_ = other.num_peers_;
+    std::memcpy(peers_, other.peers_, sizeof(Peer) * num_peers_);
+    other.fd_ = -1;
+    other.gro_ = false;
+    other.num_peers_ = 0;
+  }
+  return *this;
+}
+
+proton_status_e Socket::open(
+  const char * ip, uint16_t port, const SocketOptions & options) noexcept
+{
+  close();
+
+  sockaddr_in address;
+  if (!make_address(ip, port, address))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd_ < 0)
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  int enable = 1;
+  bool ok = true;
+  if (options.receive_buffer_size > 0)
+  {
+    ok = ::setsockopt(
+           fd_, SOL_SOCKET, SO_RCVBUF, &options.receive_buffer_size,
+           sizeof(options.receive_buffer_size)) == 0;
+  }
+  if (ok && options.gro)
+  {
+    ok = ::setsockopt(fd_, IPPROTO_UDP, UDP_GRO, &enable, sizeof(enable)) == 0;
+  }
+  if (ok)
+  {
+    ok = ::bind(fd_, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+  }
+
+  if (!ok)
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+
+  gro_ = options.gro;
+  return PROTON_OK;
+}
+
+void Socket::close() noexcept
+{
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  gro_ = false;
+}
+
+uint16_t Socket::port() const noexcept
+{
+  sockaddr_in address;
+  socklen_t len = sizeof(address);
+  if (fd_ < 0 || ::getsockname(fd_, reinterpret_cast<sockaddr *>(&address), &len) != 0)
+  {
+    return 0;
+  }
+  return ntohs(address.sin_port);
+}
+
+proton_status_e Socket::add_peer(
+  uint32_t node_id, uint32_t endpoint_id, const char * ip, uint16_t port) noexcept
+{
+  sockaddr_in address;
+  if (ip == nullptr || ip[0] == '\0' || !make_address(ip, port, address))
+  {
+    return PROTON_CONNECT_ERROR;
+  }
+
+  Peer * peer = find_peer(node_id, endpoint_id);
+  if (peer == nullptr)
+  {
+    if (num_peers_ == MAX_PEERS)
+    {
+      return PROTON_INSUFFICIENT_BUFFER_ERROR;
+    }
+    peer = &peers_[num_peers_++];
+    peer->node_id = node_id;
+    peer->endpoint_id = endpoint_id;
+  }
+  peer->address = address;
+
+  return PROTON_OK;
+}
+
+Socket::Peer * Socket::find_peer(uint32_t node_id, uint32_t endpoint_id) noexcept
+{
+  return const_cast<Peer *>(std::as_const(*this).find_peer(node_id, endpoint_id));
+}
+
+const Socket::Peer * Socket::find_peer(uint32_t node_id, uint32_t endpoint_id) const noexcept
+{
+  for (size_t i = 0; i < num_peers_; i++)
+  {
+    if (peers_[i].node_id == node_id && peers_[i].endpoint_id == endpoint_id)
+    {
+      return &peers_[i];
+    }
+  }
+  return nullptr;
+}
+
+proton_status_e Socket::send(
+  const uint8_t * frame, size_t len, const proton_endpoint_t * peers, size_t num_peers,
+  size_t & sent) noexcept
+{
+  sent = 0;
+  if (frame == nullptr || (peers == nullptr && num_peers > 0))
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  if (fd_ < 0)
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+
+  // Every message shares the one frame
+  iovec iov = {const_cast<uint8_t *>(frame), len};
+  mmsghdr messages[MAX_BATCH];
+  proton_status_e status = PROTON_OK;
+
+  size_t next = 0;
+  while (next < num_peers)
+  {
+    size_t count = 0;
+    for (; next < num_peers && count < MAX_BATCH; next++)
+    {
+      Peer * peer = find_peer(peers[next].node_id, peers[next].endpoint_id);
+      if (peer == nullptr)
+      {
+        status = PROTON_INCORRECT_TARGET_ERROR;
+        continue;
+      }
+
+      mmsghdr & message = messages[count++];
+      std::memset(&message, 0, sizeof(message));
+      message.msg_hdr.msg_name = &peer->address;
+      message.msg_hdr.msg_namelen = sizeof(peer->address);
+      message.msg_hdr.msg_iov = &iov;
+      message.msg_hdr.msg_iovlen = 1;
+    }
+
+    size_t batch_sent = send_all(fd_, messages, count);
+    sent += batch_sent;
+    if (batch_sent < count)
+    {
+      return PROTON_WRITE_ERROR;
+    }
+  }
+
+  return status;
+}
+
+proton_status_e Socket::send_segments(
+  const uint8_t * data, size_t len, size_t segment_size, const proton_endpoint_t & peer,
+  bool gso) noexcept
+{
+  if (data == nullptr)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  if (fd_ < 0)
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  if (segment_size == 0 || segment_size > UINT16_MAX)
+  {
+    return PROTON_INSUFFICIENT_BUFFER_ERROR;
+  }
+
+  Peer * target = find_peer(peer.node_id, peer.endpoint_id);
+  if (target == nullptr)
+  {
+    return PROTON_INCORRECT_TARGET_ERROR;
+  }
+
+  if (gso)
+  {
+    iovec iov = {const_cast<uint8_t *>(data), len};
+    alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(uint16_t))] = {};
+    msghdr message = {};
+    message.msg_name = &target->address;
+    message.msg_namelen = sizeof(target->address);
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr * cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    const uint16_t gso_size = static_cast<uint16_t>(segment_size);
+    std::memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+
+    ssize_t ret;
+    do
+    {
+      ret = ::sendmsg(fd_, &message, 0);
+    } while (ret < 0 && errno == EINTR);
+    return ret == static_cast<ssize_t>(len) ? PROTON_OK : PROTON_WRITE_ERROR;
+  }
+
+  iovec iovs[MAX_BATCH];
+  mmsghdr messages[MAX_BATCH];
+  size_t offset = 0;
+  while (offset < len)
+  {
+    size_t count = 0;
+    for (; offset < len && count < MAX_BATCH; count++)
+    {
+      size_t segment_len = len - offset < segment_size ? len - offset : segment_size;
+      iovs[count] = {const_cast<uint8_t *>(data + offset), segment_len};
+      std::memset(&messages[count], 0, sizeof(messages[count]));
+      messages[count].msg_hdr.msg_name = &target->address;
+      messages[count].msg_hdr.msg_namelen = sizeof(target->address);
+      messages[count].msg_hdr.msg_iov = &iovs[count];
+      messages[count].msg_hdr.msg_iovlen = 1;
+      offset += segment_len;
+    }
+
+    if (send_all(fd_, messages, count) < count)
+    {
+      return PROTON_WRITE_ERROR;
+    }
+  }
+
+  return PROTON_OK;
+}
+
+proton_status_e Socket::receive(
+  Datagram * datagrams, size_t count, size_t & received, int timeout_ms) noexcept
+{
+  received = 0;
+  if (datagrams == nullptr && count > 0)
+  {
+    return PROTON_NULL_PTR_ERROR;
+  }
+  if (fd_ < 0)
+  {
+    return PROTON_INVALID_STATE_ERROR;
+  }
+  count = count < MAX_BATCH ? count : MAX_BATCH;
+  if (count == 0)
+  {
+    return PROTON_OK;
+  }
+
+  if (timeout_ms != 0)
+  {
+    pollfd pfd = {fd_, POLLIN, 0};
+    int ready = ::poll(&pfd, 1, timeout_ms);
+    if (ready == 0 || (ready < 0 && errno == EINTR))
+    {
+      return PROTON_OK;
+    }
+    if (ready < 0)
+    {
+      return PROTON_READ_ERROR;
+    }
+  }
+
+  iovec iovs[MAX_BATCH];
+  mmsghdr messages[MAX_BATCH];
+  alignas(cmsghdr) uint8_t control[MAX_BATCH][CMSG_SPACE(sizeof(int))];
+  for (size_t i = 0; i < count; i++)
+  {
+    iovs[i] = {datagrams[i].data, datagrams[i].capacity};
+    std::memset(&messages[i], 0, sizeof(messages[i]));
+    messages[i].msg_hdr.msg_name = &datagrams[i].from;
+    messages[i].msg_hdr.msg_namelen = sizeof(datagrams[i].from);
+    messages[i].msg_hdr.msg_iov = &iovs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_control = control[i];
+    messages[i].msg_hdr.msg_controllen = sizeof(control[i]);
+  }
+
+  int ret;
+  do
+  {
+    ret = ::recvmmsg(fd_, messages, static_cast<unsigned int>(count), MSG_DONTWAIT, nullptr);
+  } while (ret < 0 && errno == EINTR);
+
+  if (ret < 0)
+  {
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? PROTON_OK : PROTON_READ_ERROR;
+  }
+
+  for (int i = 0; i < ret; i++)
+  {
+    Datagram & datagram = datagrams[i];
+    datagram.length = messages[i].msg_len;
+    datagram.segment_size = 0;
+    datagram.truncated = (messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    for (cmsghdr * cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&messages[i].msg_hdr, cmsg))
+    {
+      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+      {
+        int segment_size = 0;
+        std::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+        datagram.segment_size = static_cast<size_t>(segment_size);
+      }
+    }
+  }
+  received = static_cast<size_t>(ret);
+
+  return PROTON_OK;
+}
+
+#if PROTON_NODE_BUILDER
+
+proton_status_e Socket::open(
+  const node_builder::EndpointConfig & endpoint, const SocketOptions & options) noexcept
+{
+  if (endpoint.type != "udp4" || endpoint.port > UINT16_MAX)
+  {
+    close();
+    return PROTON_CONNECT_ERROR;
+  }
+  return open(endpoint.ip.c_str(), static_cast<uint16_t>(endpoint.port), options);
+}
+
+proton_status_e Socket::add_peers(
+  const node_builder::Config & config, const std::string & target_name) noexcept
+{
+  for (const auto & [name, node] : config.nodes)
+  {
+    if (name == target_name)
+    {
+      continue;
+    }
+
+    for (const auto & [id, endpoint] : node.endpoints)
+    {
+      if (endpoint.type != "udp4")
+      {
+        continue;
+      }
+      if (endpoint.port > UINT16_MAX)
+      {
+        return PROTON_CONNECT_ERROR;
+      }
+      proton_status_e status =
+        add_peer(node.id, endpoint.id, endpoint.ip.c_str(), static_cast<uint16_t>(endpoint.port));
+      if (status != PROTON_OK)
+      {
+        return status;
+      }
+    }
+  }
+  return PROTON_OK;
+}
+
+#endif
+
+}  // namespace proton::transport::udp4
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/socket.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "protoncpp/transport/udp4_socket.hpp"
+
+using namespace proton::transport::udp4;
+
+namespace
+{
+constexpr size_t DEFAULT_ROUNDS = 2000;
+constexpr const char * LOOPBACK = "127.0.0.1";
+// A PC node receiving from 12 MCUs, or sending one bundle to 12 peers
+constexpr size_t NUM_PEERS = 12;
+constexpr size_t FRAME_SIZE = 128;
+// Datagrams queued before the receiver drains them, well within the receive buffer
+constexpr size_t DATAGRAMS_PER_ROUND = Socket::MAX_BATCH;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ns(Clock::time_point start)
+{
+  return static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+void report(const char * name, double ns, size_t datagrams, size_t syscalls)
+{
+  std::printf(
+    "%-34s %10.1f ns/datagram %8.2f datagrams/syscall\n", name,
+    ns / static_cast<double>(datagrams),
+    static_cast<double>(datagrams) / static_cast<double>(syscalls));
+}
+
+/**
+ * Fan one frame out to every peer, with one sendto per peer or one sendmmsg
+ */
+bool bench_send(Socket & sender, std::array<Socket, NUM_PEERS> & receivers, size_t rounds)
+{
+  std::array<proton_endpoint_t, NUM_PEERS> peers;
+  std::array<sockaddr_in, NUM_PEERS> addresses;
+  for (size_t i = 0; i < NUM_PEERS; i++)
+  {
+    peers[i] = {static_cast<uint32_t>(i + 2), 1, TRANSPORT_TYPE_UDP4, 0};
+    socklen_t len = sizeof(addresses[i]);
+    getsockname(receivers[i].fd(), reinterpret_cast<sockaddr *>(&addresses[i]), &len);
+  }
+
+  std::array<uint8_t, FRAME_SIZE> frame = {};
+  std::array<std::array<uint8_t, FRAME_SIZE>, Socket::MAX_BATCH> storage;
+  std::array<Datagram, Socket::MAX_BATCH> datagrams;
+  for (size_t i = 0; i < datagrams.size(); i++)
+  {
+    datagrams[i] = {storage[i].data(), storage[i].size(), 0, {}, 0, false};
+  }
+
+  double sendto_ns = 0;
+  double sendmmsg_ns = 0;
+  size_t syscalls = 0;
+  for (size_t round = 0; round < rounds; round++)
+  {
+    auto start = Clock::now();
+    for (const sockaddr_in & address : addresses)
+    {
+      sendto(
+        sender.fd(), frame.data(), frame.size(), 0,
+        reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+    }
+    sendto_ns += elapsed_ns(start);
+
+    start = Clock::now();
+    size_t sent = 0;
+    sender.send(frame, peers, sent);
+    sendmmsg_ns += elapsed_ns(start);
+    syscalls++;
+    if (sent != NUM_PEERS)
+    {
+      std::printf("sendmmsg sent %zu of %zu datagrams\n", sent, NUM_PEERS);
+      return false;
+    }
+
+    // Drain both copies of the frame so the receive buffers never fill up
+    for (Socket & receiver : receivers)
+    {
+      size_t drained = 0;
+      while (drained < 2)
+      {
+        size_t received = 0;
+        receiver.receive(datagrams, received, 1000);
+        if (received == 0)
+        {
+          std::printf("lost a datagram on loopback\n");
+          return false;
+        }
+        drained += received;
+      }
+    }
+  }
+
+  report("fan-out, sendto per peer", sendto_ns, rounds * NUM_PEERS, rounds * NUM_PEERS);
+  report("fan-out, Socket::send (sendmmsg)", sendmmsg_ns, rounds * NUM_PEERS, syscalls);
+  return true;
+}
+
+/**
+ * Drain a queue of datagrams from several senders, with one recvfrom per datagram or recvmmsg
+ */
+bool bench_receive(Socket & receiver, std::array<Socket, NUM_PEERS> & senders, size_t rounds)
+{
+  const std::array<proton_endpoint_t, 1> peer = {{{1, 1, TRANSPORT_TYPE_UDP4, 0}}};
+  std::array<uint8_t, FRAME_SIZE> frame = {};
+  std::array<std::array<uint8_t, FRAME_SIZE>, Socket::MAX_BATCH> storage;
+  std::array<Datagram, Socket::MAX_BATCH> datagrams;
+  for (size_t i = 0; i < datagrams.size(); i++)
+  {
+    datagrams[i] = {storage[i].data(), storage[i].size(), 0, {}, 0, false};
+  }
+
+  auto queue = [&]() {
+    for (size_t i = 0; i < DATAGRAMS_PER_ROUND; i++)
+    {
+      size_t sent = 0;
+      senders[i % NUM_PEERS].send(frame, peer, sent);
+    }
+  };
+
+  double recvfrom_ns = 0;
+  double recvmmsg_ns = 0;
+  size_t recvmmsg_syscalls = 0;
+  for (size_t round = 0; round < rounds; round++)
+  {
+    queue();
+    auto start = Clock::now();
+    for (size_t i = 0; i < DATAGRAMS_PER_ROUND; i++)
+    {
+      sockaddr_in from;
+      socklen_t len = sizeof(from);
+      if (
+        recvfrom(
+          receiver.fd(), storage[0].data(), storage[0].size(), 0,
+          reinterpret_cast<sockaddr *>(&from), &len) < 0)
+      {
+        std::printf("lost a datagram on loopback\n");
+        return false;
+      }
+    }
+    recvfrom_ns += elapsed_ns(start);
+
+    queue();
+    start = Clock::now();
+    size_t total = 0;
+    while (total < DATAGRAMS_PER_ROUND)
+    {
+      size_t received = 0;
+      receiver.receive(datagrams, received);
+      recvmmsg_syscalls++;
+      if (received == 0)
+      {
+        std::printf("lost a datagram on loopback\n");
+        return false;
+      }
+      total += received;
+    }
+    recvmmsg_ns += elapsed_ns(start);
+  }
+
+  const size_t datagrams_received = rounds * DATAGRAMS_PER_ROUND;
+  report("receive, recvfrom per datagram", recvfrom_ns, datagrams_received, datagrams_received);
+  report(
+    "receive, Socket::receive (recvmmsg)", recvmmsg_ns, datagrams_received, recvmmsg_syscalls);
+  return true;
+}
+}  // namespace
+
+/**
+ * Compare one syscall per datagram with the batched Socket calls over loopback.
+ * Usage: udp4_socket_benchmark [rounds]
+ */
+int main(int argc, char ** argv)
+{
+  size_t rounds = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_ROUNDS;
+  const SocketOptions options = {.receive_buffer_size = 1024 * 1024};
+
+  Socket node;
+  std::array<Socket, NUM_PEERS> peers;
+  if (node.open(LOOPBACK, 0, options) != PROTON_OK)
+  {
+    std::printf("failed to open socket\n");
+    return 1;
+  }
+  for (size_t i = 0; i < NUM_PEERS; i++)
+  {
+    if (
+      peers[i].open(LOOPBACK, 0, options) != PROTON_OK ||
+      node.add_peer(static_cast<uint32_t>(i + 2), 1, LOOPBACK, peers[i].port()) != PROTON_OK ||
+      peers[i].add_peer(1, 1, LOOPBACK, node.port()) != PROTON_OK)
+    {
+      std::printf("failed to open socket\n");
+      return 1;
+    }
+  }
+
+  std::printf("%zu peers, %zu byte frames, %zu rounds\n", NUM_PEERS, FRAME_SIZE, rounds);
+  if (!bench_send(node, peers, rounds) || !bench_receive(node, peers, rounds))
+  {
+    return 1;
+  }
+  return 0;
+}
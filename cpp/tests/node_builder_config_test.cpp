@@ -24,6 +24,8 @@
 #include <string>
 
 #include "protoncpp/node_builder/config.hpp"
+#include "protoncpp/node_builder/generator.hpp"
+#include "target_registry_ids.h"
 
 #include <yaml-cpp/yaml.h>
 #include <nlohmann/json.hpp>
@@ -67,10 +69,27 @@ void expect_json_throw_with_message(const std::string & filepath, const std::str
 TEST(YamlConfigTest, HappyPathTest)
 {
   Config config = Config::from_yaml("test_configs/yaml/test.yaml");
-  EXPECT_EQ(config.bundles.size(), 7);
+  EXPECT_EQ(config.bundles.size(), 11);
   EXPECT_EQ(config.nodes.size(), 3);
   EXPECT_EQ(config.connections.size(), 2);
-  EXPECT_EQ(config.signals.size(), 16);
+  EXPECT_EQ(config.signals.size(), 21);
+  EXPECT_FALSE(config.bundles[0].delta);
+  EXPECT_EQ(config.bundles[0].keyframe_interval, 10);
+  EXPECT_EQ(config.bundles[6].name, "delta_bundle");
+  EXPECT_TRUE(config.bundles[6].delta);
+  EXPECT_EQ(config.bundles[6].keyframe_interval, 3);
+  EXPECT_FALSE(config.nodes.at("producer").compact);
+  EXPECT_TRUE(config.nodes.at("consumer").compact);
+  EXPECT_EQ(config.signals[15].type_string, "flags");
+  EXPECT_EQ(config.signals[15].bits, (std::vector<std::string>{"ready", "fault", "charging"}));
+  EXPECT_EQ(config.signals[16].type_string, "double_array");
+  EXPECT_EQ(config.signals[16].capacity, 8);
+  EXPECT_EQ(config.signals[17].capacity, 4);
+  EXPECT_EQ(config.signals[18].encoding, "quantized");
+  EXPECT_DOUBLE_EQ(config.signals[18].scale, 0.01);
+  EXPECT_DOUBLE_EQ(config.signals[18].offset, -40.0);
+  EXPECT_EQ(config.signals[19].encoding, "float16");
+  EXPECT_EQ(config.signals[20].encoding, "");
 
   YAML::Node node = YAML::LoadFile("test_configs/yaml/test.yaml");
   std::stringstream ss;
@@ -85,6 +104,32 @@ TEST(YamlConfigTest, HappyPathTest)
   EXPECT_EQ(config.signals.size(), config_2.signals.size());
 }
 
+TEST(YamlConfigTest, SchemaHashMatchesCodeGenerator)
+{
+  Config config = Config::from_yaml("test_configs/yaml/test.yaml");
+  EXPECT_EQ(compute_schema_hash(config), PROTON_SCHEMA_HASH);
+  // Filtering keeps the hash of the whole config, so every node of it agrees
+  EXPECT_EQ(compute_schema_hash(filter_for_target(config, "unused_consumer")), PROTON_SCHEMA_HASH);
+
+  GeneratedNode producer(filter_for_target(config, "producer"), "producer");
+  EXPECT_EQ(producer.registry()->schema_hash, PROTON_SCHEMA_HASH);
+  EXPECT_EQ(producer.node()->peer_schema_hashes, nullptr);
+
+  GeneratedNode consumer(config, "consumer");
+  EXPECT_EQ(consumer.registry()->schema_hash, PROTON_SCHEMA_HASH);
+  ASSERT_NE(consumer.node()->peer_schema_hashes, nullptr);
+  GeneratedNode moved(std::move(consumer));
+  ASSERT_NE(moved.node()->peer_schema_hashes, nullptr);
+  for (uint8_t i = 0; i < moved.node()->num_peers; i++)
+  {
+    EXPECT_EQ(moved.node()->peer_schema_hashes[i], 0u);
+  }
+
+  // Any change to a bundle layout changes the hash
+  config.bundles[0].signals.pop_back();
+  EXPECT_NE(compute_schema_hash(config), PROTON_SCHEMA_HASH);
+}
+
 TEST(YamlSignalConfigTest, InvalidBytesCapacity)
 {
   expect_yaml_throw_with_message(
@@ -115,7 +160,29 @@ TEST(YamlSignalConfigTest, ListForNonListType)
 {
   expect_yaml_throw_with_message(
     "test_configs/yaml/signal_list_for_non_list_type.yaml",
-    "Error in signal list_floats: only bytes type signals can have a sequence as a default value");
+    "Error in signal list_floats: only bytes and array type signals can have a sequence as a "
+    "default value");
+}
+
+TEST(YamlSignalConfigTest, BitsForNonFlagsType)
+{
+  expect_yaml_throw_with_message(
+    "test_configs/yaml/signal_bits_for_non_flags_type.yaml",
+    "Error in signal named_bits: only flags signals can name bits");
+}
+
+TEST(YamlSignalConfigTest, EncodingForNonFloatType)
+{
+  expect_yaml_throw_with_message(
+    "test_configs/yaml/signal_encoding_for_non_float_type.yaml",
+    "Error in signal encoded_int: only float and double signals can be encoded");
+}
+
+TEST(YamlSignalConfigTest, QuantizedNoScale)
+{
+  expect_yaml_throw_with_message(
+    "test_configs/yaml/signal_quantized_no_scale.yaml",
+    "Error in signal unscaled: a quantized signal needs a nonzero scale");
 }
 
 TEST(YamlSignalConfigTest, SignalNoBytesCapacity)
@@ -264,6 +331,71 @@ TEST(YamlEndpointConfigTest, SerialNoDevice)
     "test_configs/yaml/endpoint_serial_no_device.yaml", "serial endpoints require a device");
 }
 
+TEST(YamlEndpointConfigTest, Shm)
+{
+  const std::string yaml = R"(
+nodes:
+  - name: pc
+    id: 0
+    endpoints:
+      - {id: 0, type: shm, device: /proton-pc, mtu: 4096}
+)";
+  Config config(ConfigTree::from_yaml_string(yaml));
+  const EndpointConfig & endpoint = config.nodes.at("pc").endpoints.at(0);
+  EXPECT_EQ(endpoint.type, "shm");
+  EXPECT_EQ(endpoint.device, "/proton-pc");
+  EXPECT_EQ(endpoint.mtu, 4096);
+
+  const std::string invalid_yaml = R"(
+nodes:
+  - name: pc
+    id: 0
+    endpoints:
+      - {id: 0, type: shm}
+)";
+  try
+  {
+    Config invalid_config(ConfigTree::from_yaml_string(invalid_yaml));
+    FAIL() << "Expected exception was not thrown.";
+  }
+  catch (const NodeBuilderException & e)
+  {
+    EXPECT_EQ(std::string(e.what()), "shm endpoints require a device");
+  }
+}
+
+TEST(YamlEndpointConfigTest, Mtu)
+{
+  const std::string yaml = R"(
+nodes:
+  - name: pc
+    id: 0
+    endpoints:
+      - {id: 0, type: udp4, ip: 127.0.0.1, port: 11416, mtu: 1400}
+      - {id: 1, type: serial, device: /dev/ttyUSB0}
+)";
+  Config config(ConfigTree::from_yaml_string(yaml));
+  EXPECT_EQ(config.nodes.at("pc").endpoints.at(0).mtu, 1400);
+  EXPECT_EQ(config.nodes.at("pc").endpoints.at(1).mtu, 0);
+
+  const std::string invalid_yaml = R"(
+nodes:
+  - name: pc
+    id: 0
+    endpoints:
+      - {id: 0, type: udp4, ip: 127.0.0.1, port: 11416, mtu: 70000}
+)";
+  try
+  {
+    Config invalid_config(ConfigTree::from_yaml_string(invalid_yaml));
+    FAIL() << "Expected exception was not thrown.";
+  }
+  catch (const NodeBuilderException & e)
+  {
+    EXPECT_EQ(std::string(e.what()), "Endpoint MTU must be between 0 and 65535");
+  }
+}
+
 TEST(YamlNodeConfigTest, NoId)
 {
   expect_yaml_throw_with_message(
@@ -292,10 +424,27 @@ TEST(YamlNodeConfigTest, EndpointsNotSequence)
 TEST(JsonConfigTest, HappyPathTest)
 {
   Config config = Config::from_json("test_configs/json/test.json");
-  EXPECT_EQ(config.bundles.size(), 7);
+  EXPECT_EQ(config.bundles.size(), 11);
   EXPECT_EQ(config.nodes.size(), 3);
   EXPECT_EQ(config.connections.size(), 2);
-  EXPECT_EQ(config.signals.size(), 16);
+  EXPECT_EQ(config.signals.size(), 21);
+  EXPECT_FALSE(config.bundles[0].delta);
+  EXPECT_EQ(config.bundles[0].keyframe_interval, 10);
+  EXPECT_EQ(config.bundles[6].name, "delta_bundle");
+  EXPECT_TRUE(config.bundles[6].delta);
+  EXPECT_EQ(config.bundles[6].keyframe_interval, 3);
+  EXPECT_FALSE(config.nodes.at("producer").compact);
+  EXPECT_TRUE(config.nodes.at("consumer").compact);
+  EXPECT_EQ(config.signals[15].type_string, "flags");
+  EXPECT_EQ(config.signals[15].bits, (std::vector<std::string>{"ready", "fault", "charging"}));
+  EXPECT_EQ(config.signals[16].type_string, "double_array");
+  EXPECT_EQ(config.signals[16].capacity, 8);
+  EXPECT_EQ(config.signals[17].capacity, 4);
+  EXPECT_EQ(config.signals[18].encoding, "quantized");
+  EXPECT_DOUBLE_EQ(config.signals[18].scale, 0.01);
+  EXPECT_DOUBLE_EQ(config.signals[18].offset, -40.0);
+  EXPECT_EQ(config.signals[19].encoding, "float16");
+  EXPECT_EQ(config.signals[20].encoding, "");
 
   std::ifstream f("test_configs/json/test.json");
   std::stringstream ss;
@@ -339,7 +488,29 @@ TEST(JsonSignalConfigTest, ListForNonListType)
 {
   expect_json_throw_with_message(
     "test_configs/json/signal_list_for_non_list_type.json",
-    "Error in signal list_floats: only bytes type signals can have a sequence as a default value");
+    "Error in signal list_floats: only bytes and array type signals can have a sequence as a "
+    "default value");
+}
+
+TEST(JsonSignalConfigTest, BitsForNonFlagsType)
+{
+  expect_json_throw_with_message(
+    "test_configs/json/signal_bits_for_non_flags_type.json",
+    "Error in signal named_bits: only flags signals can name bits");
+}
+
+TEST(JsonSignalConfigTest, EncodingForNonFloatType)
+{
+  expect_json_throw_with_message(
+    "test_configs/json/signal_encoding_for_non_float_type.json",
+    "Error in signal encoded_int: only float and double signals can be encoded");
+}
+
+TEST(JsonSignalConfigTest, QuantizedNoScale)
+{
+  expect_json_throw_with_message(
+    "test_configs/json/signal_quantized_no_scale.json",
+    "Error in signal unscaled: a quantized signal needs a nonzero scale");
 }
 
 TEST(JsonSignalConfigTest, SignalNoBytesCapacity)
@@ -403,6 +403,39 @@ TEST(FilterForTarget, ValidationRunsBeforeFiltering)
   EXPECT_THROW(filter_for_target(config, "node_a"), NodeBuilderException);
 }
 
+// ============================================================================
+// GeneratedNode tests
+// ============================================================================
+
+TEST(GeneratedNode, RegistryIndexBuilt)
+{
+  Config config = create_base_config();
+  GeneratedNode node(filter_for_target(config, "node_b"), "node_b");
+  const proton_registry_t * registry = node.registry();
+
+  ASSERT_NE(registry->bundle_index.slots, nullptr);
+  ASSERT_NE(registry->signal_index.slots, nullptr);
+  EXPECT_GT(registry->bundle_index.capacity, registry->bundle_count);
+  EXPECT_GT(registry->signal_index.capacity, registry->signal_count);
+
+  for (uint32_t signal_id : {100u, 101u, 102u})
+  {
+    size_t idx = 0;
+    const signal_desc_t * desc = proton_registry_get_signal(registry, signal_id, &idx);
+    ASSERT_NE(desc, nullptr);
+    EXPECT_EQ(desc->id, signal_id);
+    EXPECT_EQ(&registry->signal_registry[idx], desc);
+  }
+
+  EXPECT_NE(proton_registry_get_bundle(registry, 10, nullptr), nullptr);
+  EXPECT_NE(proton_registry_get_bundle(registry, 11, nullptr), nullptr);
+  EXPECT_EQ(proton_registry_get_bundle(registry, 12, nullptr), nullptr);
+
+  // Index storage must follow the node when moved
+  GeneratedNode moved(std::move(node));
+  EXPECT_NE(proton_registry_get_signal(moved.registry(), 102, nullptr), nullptr);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -181,6 +181,43 @@ TEST_F(NodeAccessTest, Update_NoPendingBundles_ReturnsOkNothingToSend)
   EXPECT_EQ(status, PROTON_OK);
 }
 
+TEST_F(NodeAccessTest, UpdateBatch_NoPendingBundles_ReturnsNoRecords)
+{
+  NodeAccess access(&node_);
+
+  uint8_t buffer[BUFFER_SIZE] = {};
+  NodeAccess::BundleRecord records[4] = {};
+  size_t num_records = 0;
+  NodeAccess::Endpoint dest[4] = {};
+
+  proton_status_e status =
+    access.update_batch(10, buffer, sizeof(buffer), records, 4, num_records, dest, 4);
+  EXPECT_EQ(status, PROTON_OK);
+  EXPECT_EQ(num_records, 0u);
+}
+
+TEST_F(NodeAccessTest, UpdateCoalesced_AfterTriggers_SendsOneMessage)
+{
+  NodeAccess access(&node_);
+
+  ASSERT_EQ(access.trigger_bundle(PROTON_BUNDLE_SHARED_1_ID), PROTON_OK);
+  ASSERT_EQ(access.trigger_bundle(PROTON_BUNDLE_SHARED_2_ID), PROTON_OK);
+
+  uint8_t buffer[BUFFER_SIZE] = {};
+  size_t out_len = 0;
+  NodeAccess::Endpoint dest[4] = {};
+  size_t num_peers = 0;
+
+  ASSERT_EQ(
+    access.update_coalesced(10, buffer, sizeof(buffer), out_len, dest, 4, num_peers), PROTON_OK);
+  EXPECT_GT(out_len, 0u);
+  EXPECT_EQ(num_peers, 1u);
+
+  ASSERT_EQ(
+    access.update_coalesced(10, buffer, sizeof(buffer), out_len, dest, 4, num_peers), PROTON_OK);
+  EXPECT_EQ(out_len, 0u);
+}
+
 TEST_F(NodeAccessTest, Update_AfterTrigger_ReturnsOk)
 {
   NodeAccess access(&node_);
@@ -332,6 +369,25 @@ TEST_F(NodeAccessTest, UpdateSpan_AfterTrigger_ReturnsOk)
   EXPECT_GT(out_len, 0u);
 }
 
+TEST_F(NodeAccessTest, UpdateBatchSpan_AfterTrigger_ReturnsRecords)
+{
+  NodeAccess access(&node_);
+
+  ASSERT_EQ(access.trigger_bundle(PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+
+  std::array<uint8_t, BUFFER_SIZE> buffer = {};
+  std::array<NodeAccess::BundleRecord, 4> records = {};
+  size_t num_records = 0;
+  std::array<NodeAccess::Endpoint, 4> dest = {};
+
+  ASSERT_EQ(access.update_batch(10, buffer, records, num_records, dest), PROTON_OK);
+  ASSERT_EQ(num_records, 1u);
+  EXPECT_EQ(records[0].bundle_id, PROTON_BUNDLE_VALUE_TEST_ID);
+  EXPECT_EQ(records[0].offset, 0u);
+  EXPECT_GT(records[0].length, 0u);
+  EXPECT_EQ(records[0].peers, dest.data());
+}
+
 TEST_F(NodeAccessTest, EncodeBundleSpan_ValidBundle_ReturnsOk)
 {
   NodeAccess access(&node_);
@@ -347,6 +403,30 @@ TEST_F(NodeAccessTest, EncodeBundleSpan_ValidBundle_ReturnsOk)
   EXPECT_GT(out_len, 0u);
 }
 
+TEST_F(NodeAccessTest, UpdateFramedSpan_AfterTrigger_ReturnsSerialFrame)
+{
+  NodeAccess access(&node_);
+
+  ASSERT_EQ(access.trigger_bundle(PROTON_BUNDLE_VALUE_TEST_ID), PROTON_OK);
+
+  std::array<uint8_t, BUFFER_SIZE> buffer = {};
+  size_t out_len = 0;
+  std::array<NodeAccess::Endpoint, 4> dest = {};
+  size_t num_selected = 0;
+  const NodeAccess::Framing framing = PROTON_SERIAL_FRAMING;
+
+  ASSERT_EQ(access.update_framed(1000, buffer, framing, out_len, dest, num_selected), PROTON_OK);
+  ASSERT_GT(out_len, PROTON_FRAME_OVERHEAD);
+
+  uint16_t length = 0;
+  ASSERT_EQ(proton_serial_get_framed_payload_length(buffer.data(), &length), PROTON_OK);
+  EXPECT_EQ(length + PROTON_FRAME_OVERHEAD, out_len);
+  const uint16_t crc = buffer[out_len - 2] | (buffer[out_len - 1] << 8);
+  EXPECT_EQ(
+    proton_serial_check_framed_payload(buffer.data() + PROTON_FRAME_HEADER_OVERHEAD, length, crc),
+    PROTON_OK);
+}
+
 #endif  // __cplusplus >= 202002L
 
 // -----------------------------------------------------------------------
@@ -17,7 +17,11 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <cstring>
+#include <mutex>
+#include <thread>
+#include "proton/encode_decode.h"
 #include "protoncpp/bundle_access.hpp"
 #include "protoncpp/signal_access.hpp"
 #include "target_registry_ids.h"
@@ -176,6 +180,32 @@ TEST(SignalAccess, GetSetBool)
   free(registry.signal_registry);
 }
 
+TEST(SignalAccess, GetSetFlags)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  SignalAccess access(&registry);
+
+  Flags flags{};
+  ASSERT_EQ(access.get(PROTON_SIGNAL_STATUS_FLAGS_ID, flags), PROTON_OK);
+  EXPECT_EQ(flags, Flags{5});
+
+  ASSERT_EQ(
+    access.set_flag(PROTON_SIGNAL_STATUS_FLAGS_ID, PROTON_SIGNAL_STATUS_FLAGS_FAULT_BIT, true),
+    PROTON_OK);
+  bool fault = false;
+  ASSERT_EQ(
+    access.get_flag(PROTON_SIGNAL_STATUS_FLAGS_ID, PROTON_SIGNAL_STATUS_FLAGS_FAULT_BIT, fault),
+    PROTON_OK);
+  EXPECT_TRUE(fault);
+
+  ASSERT_EQ(access.set(PROTON_SIGNAL_STATUS_FLAGS_ID, Flags{0}), PROTON_OK);
+  ASSERT_EQ(access.get(PROTON_SIGNAL_STATUS_FLAGS_ID, flags), PROTON_OK);
+  EXPECT_EQ(flags, Flags{0});
+  EXPECT_EQ(access.set_flag(PROTON_SIGNAL_STATUS_FLAGS_ID, 64, true), PROTON_ERROR);
+
+  free(registry.signal_registry);
+}
+
 TEST(SignalAccess, GetDefaultString)
 {
   proton_registry_t registry = copy_default_registry(&g_proton_registry);
@@ -573,6 +603,73 @@ TEST(Signal, GetSetBool)
   free(registry.signal_registry);
 }
 
+TEST(Signal, GetSetFlags)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  Signal<Flags> signal(&registry, PROTON_SIGNAL_STATUS_FLAGS_ID);
+  EXPECT_EQ(signal.type(), PROTON_FLAGS);
+
+  ASSERT_EQ(
+    signal.set(with_flag(Flags{}, PROTON_SIGNAL_STATUS_FLAGS_CHARGING_BIT, true)), PROTON_OK);
+  ASSERT_EQ(signal.set_flag(PROTON_SIGNAL_STATUS_FLAGS_READY_BIT, true), PROTON_OK);
+
+  Flags value{};
+  ASSERT_EQ(signal.get(value), PROTON_OK);
+  EXPECT_TRUE(test_flag(value, PROTON_SIGNAL_STATUS_FLAGS_READY_BIT));
+  EXPECT_FALSE(test_flag(value, PROTON_SIGNAL_STATUS_FLAGS_FAULT_BIT));
+  EXPECT_TRUE(test_flag(value, PROTON_SIGNAL_STATUS_FLAGS_CHARGING_BIT));
+  EXPECT_FALSE(test_flag(value, 64));
+
+  bool charging = false;
+  ASSERT_EQ(signal.get_flag(PROTON_SIGNAL_STATUS_FLAGS_CHARGING_BIT, charging), PROTON_OK);
+  EXPECT_TRUE(charging);
+
+  free(registry.signal_registry);
+}
+
+#if __cplusplus >= 202002L
+
+TEST(Signal, SpanArrayAccess)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  Signal<std::span<double>> signal(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID);
+  EXPECT_EQ(signal.type(), PROTON_DOUBLE_ARRAY);
+
+  const double samples[] = {0.5, 1.5, -2.0};
+  ASSERT_EQ(signal.set(samples), PROTON_OK);
+
+  std::span<const double> view;
+  ASSERT_EQ(signal.get(view), PROTON_OK);
+  ASSERT_EQ(view.size(), std::size(samples));
+  EXPECT_EQ(view[2], -2.0);
+
+  // Fill the registry storage in place, the earlier view sees the new values
+  std::span<double> storage;
+  ASSERT_EQ(signal.buffer(storage), PROTON_OK);
+  ASSERT_EQ(storage.size(), static_cast<size_t>(PROTON_SIGNAL_IMU_SAMPLES_MAX_ELEMENTS));
+  EXPECT_EQ(storage.data(), view.data());
+  for (size_t i = 0; i < storage.size(); i++)
+  {
+    storage[i] = static_cast<double>(i);
+  }
+  ASSERT_EQ(signal.commit(storage.size()), PROTON_OK);
+  ASSERT_EQ(signal.get(view), PROTON_OK);
+  EXPECT_EQ(view.size(), storage.size());
+  EXPECT_EQ(view.back(), 7.0);
+
+  const double too_many[PROTON_SIGNAL_IMU_SAMPLES_MAX_ELEMENTS + 1] = {};
+  EXPECT_EQ(signal.set(too_many), PROTON_INSUFFICIENT_BUFFER_ERROR);
+
+  // Other element types do not resolve
+  Signal<std::span<float>> wrong_type(&registry, PROTON_SIGNAL_IMU_SAMPLES_ID);
+  std::span<const float> floats;
+  EXPECT_EQ(wrong_type.get(floats), PROTON_ERROR);
+
+  free(registry.signal_registry);
+}
+
+#endif  // __cplusplus >= 202002L
+
 TEST(Signal, Id)
 {
   proton_registry_t registry = copy_default_registry(&g_proton_registry);
@@ -1778,6 +1875,139 @@ TEST(BundleAccess, IndexOperatorNulloptFromSignalNotInBundle)
   free(registry.signal_registry);
 }
 
+TEST(BundleAccess, IndexOperatorSignalIsResolved)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  BundleAccess bundle(&registry, PROTON_BUNDLE_VALUE_TEST_ID);
+  std::optional<SignalBase> signal = bundle[PROTON_SIGNAL_STRING_VALUE_ID];
+  ASSERT_TRUE(signal.has_value());
+  EXPECT_EQ(signal->id(), PROTON_SIGNAL_STRING_VALUE_ID);
+  EXPECT_EQ(signal->type(), PROTON_STRING);
+
+  size_t index = 0;
+  ASSERT_NE(proton_registry_get_signal(&registry, PROTON_SIGNAL_STRING_VALUE_ID, &index), nullptr);
+  EXPECT_EQ(signal->handle().index, index);
+  EXPECT_EQ(signal->handle().type, PROTON_STRING);
+
+  free(registry.signal_registry);
+}
+
+TEST(BundleAccess, Snapshot)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  ASSERT_EQ(SignalAccess(&registry).set(PROTON_SIGNAL_DOUBLE_VALUE_ID, 2.5), PROTON_OK);
+  BundleAccess bundle(&registry, PROTON_BUNDLE_VALUE_TEST_ID);
+
+  proton_signal_value_t values[9];
+  uint8_t buffer[32];
+  size_t count = 0;
+  ASSERT_EQ(bundle.snapshot(values, 9, buffer, sizeof(buffer), count), PROTON_OK);
+  ASSERT_EQ(count, 9u);
+  EXPECT_EQ(values[0].id, PROTON_SIGNAL_DOUBLE_VALUE_ID);
+  EXPECT_EQ(values[0].signal.signal.double_value, 2.5);
+
+  EXPECT_EQ(
+    BundleAccess(&registry, 0x9999).snapshot(values, 9, buffer, sizeof(buffer), count),
+    PROTON_ERROR);
+
+  free(registry.signal_registry);
+}
+
+TEST(BundleAccess, SnapshotIsConsistentWithADecodingThread)
+{
+  proton_registry_t source = copy_default_registry(&g_proton_registry);
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+
+  // Writers hold the registry lock, which snapshots only take once they ran out of attempts
+  std::mutex registry_mutex;
+  registry.mutex_handles.lock = [](void * mutex, void *) -> proton_status_e
+  {
+    static_cast<std::mutex *>(mutex)->lock();
+    return PROTON_OK;
+  };
+  registry.mutex_handles.unlock = [](void * mutex, void *) -> proton_status_e
+  {
+    static_cast<std::mutex *>(mutex)->unlock();
+    return PROTON_OK;
+  };
+  registry.mutex_handles.mutex = &registry_mutex;
+
+  // The int32 and int64 signals are always sent equal, so a snapshot sees them equal unless it
+  // mixes two decodes
+  constexpr int32_t DECODES = 200000;
+  std::atomic<bool> done = false;
+  std::thread decoder([&]() {
+    SignalAccess signals(&source);
+    uint8_t message[BUFFER_SIZE];
+    for (int32_t i = 1; i <= DECODES; i++)
+    {
+      size_t len = 0;
+      signals.set(PROTON_SIGNAL_INT32_VALUE_ID, i);
+      signals.set(PROTON_SIGNAL_INT64_VALUE_ID, int64_t{i});
+      proton_encode_bundle(&source, PROTON_BUNDLE_VALUE_TEST_ID, message, sizeof(message), &len);
+      proton_lock_registry(&registry);
+      proton_decode_direct(&registry, message, len, nullptr, nullptr);
+      proton_unlock_registry(&registry);
+    }
+    done = true;
+  });
+
+  BundleAccess bundle(&registry, PROTON_BUNDLE_VALUE_TEST_ID);
+  proton_signal_value_t values[9];
+  uint8_t buffer[32];
+  size_t count = 0;
+  int64_t last = 0;
+  while (!done || last < DECODES)
+  {
+    ASSERT_EQ(bundle.snapshot(values, 9, buffer, sizeof(buffer), count), PROTON_OK);
+    ASSERT_EQ(values[2].signal.signal.int32_value, values[3].signal.signal.int64_value);
+    ASSERT_GE(values[3].signal.signal.int64_value, last);
+    last = values[3].signal.signal.int64_value;
+  }
+  decoder.join();
+  EXPECT_EQ(last, DECODES);
+
+  free(source.signal_registry);
+  free(registry.signal_registry);
+}
+
+TEST(Signal, ResolvesHandleOnConstruction)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  Signal<double> signal(&registry, PROTON_SIGNAL_DOUBLE_VALUE_ID);
+
+  proton_signal_handle_t expected;
+  ASSERT_EQ(
+    proton_registry_resolve_signal(
+      &registry, PROTON_SIGNAL_DOUBLE_VALUE_ID, PROTON_DOUBLE, &expected),
+    PROTON_OK);
+  EXPECT_EQ(signal.handle().index, expected.index);
+  EXPECT_EQ(signal.handle().type, PROTON_DOUBLE);
+  EXPECT_EQ(signal.desc(), &registry.signal_registry[expected.index]);
+
+  // Accesses go through the handle, and see values set by ID
+  ASSERT_EQ(proton_signal_set_double(&registry, PROTON_SIGNAL_DOUBLE_VALUE_ID, 6.5), PROTON_OK);
+  double value = 0.0;
+  ASSERT_EQ(signal.get(value), PROTON_OK);
+  EXPECT_EQ(value, 6.5);
+
+  free(registry.signal_registry);
+}
+
+TEST(Signal, TypeMismatchLeavesHandleUnresolved)
+{
+  proton_registry_t registry = copy_default_registry(&g_proton_registry);
+  Signal<uint32_t> signal(&registry, PROTON_SIGNAL_DEFAULT_DOUBLE_ID);
+
+  EXPECT_EQ(signal.handle().type, PROTON_INVALID_TYPE);
+  // The descriptor is still found by ID
+  ASSERT_NE(signal.desc(), nullptr);
+  EXPECT_EQ(signal.type(), PROTON_DOUBLE);
+
+  free(registry.signal_registry);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
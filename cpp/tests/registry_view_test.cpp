@@ -0,0 +1,297 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "protoncpp/registry_view.hpp"
+#include "protoncpp/signal_access.hpp"
+
+using proton::RegistryPublisher;
+using proton::RegistryView;
+
+TEST(RegistryView, AttachFailsWithoutView)
+{
+  RegistryView view;
+  EXPECT_EQ(view.attach("/proton-test-no-such-view"), PROTON_CONNECT_ERROR);
+  EXPECT_EQ(view.attach("no-slash"), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(view.is_open());
+  EXPECT_TRUE(view.is_closed());
+}
+
+TEST(RegistryView, PublisherRejectsNullRegistry)
+{
+  RegistryPublisher publisher;
+  EXPECT_EQ(publisher.create("/proton-test-null", nullptr), PROTON_NULL_PTR_ERROR);
+  EXPECT_FALSE(publisher.is_open());
+  EXPECT_EQ(publisher.publish(), PROTON_INVALID_STATE_ERROR);
+}
+
+#if PROTON_NODE_BUILDER
+
+using namespace proton::node_builder;
+
+namespace
+{
+
+constexpr uint32_t STATE_BUNDLE = 1;
+constexpr uint32_t PAIR_BUNDLE = 2;
+
+constexpr uint32_t COUNT_SIGNAL = 1;
+constexpr uint32_t SPEED_SIGNAL = 2;
+constexpr uint32_t NAME_SIGNAL = 3;
+constexpr uint32_t DATA_SIGNAL = 4;
+constexpr uint32_t GAINS_SIGNAL = 5;
+constexpr uint32_t FIRST_SIGNAL = 6;
+constexpr uint32_t SECOND_SIGNAL = 7;
+
+/**
+ * One node producing a bundle of every kind of value, and a bundle of two signals written together
+ */
+Config make_config()
+{
+  Config config;
+  config.nodes["pc"] = {"pc", 1, {}, false};
+  config.signals.push_back({"count", COUNT_SIGNAL, "uint32"});
+  config.signals.push_back({"speed", SPEED_SIGNAL, "double"});
+  config.signals.push_back({"name", NAME_SIGNAL, "string", 16});
+  config.signals.push_back({"data", DATA_SIGNAL, "bytes", 8});
+  config.signals.push_back({"gains", GAINS_SIGNAL, "float_array", 3});
+  config.signals.push_back({"first", FIRST_SIGNAL, "uint64"});
+  config.signals.push_back({"second", SECOND_SIGNAL, "uint64"});
+
+  BundleConfig state;
+  state.name = "state";
+  state.id = STATE_BUNDLE;
+  state.producers = {"pc"};
+  state.signals = {COUNT_SIGNAL, SPEED_SIGNAL, NAME_SIGNAL, DATA_SIGNAL, GAINS_SIGNAL};
+  config.bundles.push_back(state);
+
+  BundleConfig pair;
+  pair.name = "pair";
+  pair.id = PAIR_BUNDLE;
+  pair.producers = {"pc"};
+  pair.signals = {FIRST_SIGNAL, SECOND_SIGNAL};
+  config.bundles.push_back(pair);
+
+  return config;
+}
+
+std::string view_name(const char * name)
+{
+  return "/proton-test-" + std::to_string(getpid()) + "-" + name;
+}
+
+}  // namespace
+
+TEST(RegistryView, ReadsPublishedValues)
+{
+  GeneratedNode node(make_config(), "pc");
+  proton::SignalAccess signals(node.registry());
+  const uint8_t data[] = {1, 2, 3};
+  const float gains[] = {0.5f, 1.5f, 2.5f};
+  ASSERT_EQ(signals.set(COUNT_SIGNAL, uint32_t{42}), PROTON_OK);
+  ASSERT_EQ(signals.set(SPEED_SIGNAL, 1.25), PROTON_OK);
+  ASSERT_EQ(signals.set(NAME_SIGNAL, "robot", 6), PROTON_OK);
+  ASSERT_EQ(signals.set(DATA_SIGNAL, data, sizeof(data)), PROTON_OK);
+  ASSERT_EQ(proton_signal_set_float_array(node.registry(), GAINS_SIGNAL, gains, 3), PROTON_OK);
+
+  const std::string name = view_name("values");
+  RegistryPublisher publisher;
+  ASSERT_EQ(publisher.create(name.c_str(), node), PROTON_OK);
+  RegistryView view;
+  ASSERT_EQ(view.attach(name.c_str()), PROTON_OK);
+  EXPECT_FALSE(view.is_closed());
+  EXPECT_EQ(view.schema_hash(), node.registry()->schema_hash);
+
+  uint32_t count = 0;
+  ASSERT_EQ(view.get(COUNT_SIGNAL, count), PROTON_OK);
+  EXPECT_EQ(count, 42u);
+  double speed = 0;
+  ASSERT_EQ(view.get(SPEED_SIGNAL, speed), PROTON_OK);
+  EXPECT_EQ(speed, 1.25);
+  char text[16];
+  size_t len = 0;
+  ASSERT_EQ(view.get_string(NAME_SIGNAL, text, sizeof(text), len), PROTON_OK);
+  EXPECT_EQ(len, 6u);
+  EXPECT_STREQ(text, "robot");
+  uint8_t bytes[8];
+  ASSERT_EQ(view.get_bytes(DATA_SIGNAL, bytes, sizeof(bytes), len), PROTON_OK);
+  ASSERT_EQ(len, sizeof(data));
+  EXPECT_EQ(std::memcmp(bytes, data, sizeof(data)), 0);
+
+  // Getters check the type, and string and bytes getters the capacity
+  EXPECT_EQ(view.get(SPEED_SIGNAL, count), PROTON_ERROR);
+  EXPECT_EQ(view.get(99, count), PROTON_ERROR);
+  EXPECT_EQ(view.get_string(NAME_SIGNAL, text, 3, len), PROTON_INSUFFICIENT_BUFFER_ERROR);
+
+  proton_view_value_t values[5];
+  uint8_t buffer[64];
+  size_t num_values = 0;
+  uint32_t sequence = 0;
+  ASSERT_EQ(
+    view.read(STATE_BUNDLE, values, 5, buffer, sizeof(buffer), num_values, &sequence), PROTON_OK);
+  ASSERT_EQ(num_values, 5u);
+  EXPECT_EQ(sequence, 2u);
+  EXPECT_EQ(values[0].signal_id, COUNT_SIGNAL);
+  EXPECT_EQ(values[0].type, PROTON_UINT32);
+  EXPECT_EQ(values[0].version, 1u);
+  EXPECT_EQ(*reinterpret_cast<const uint32_t *>(values[0].data), 42u);
+  EXPECT_EQ(*reinterpret_cast<const double *>(values[1].data), 1.25);
+  EXPECT_STREQ(reinterpret_cast<const char *>(values[2].data), "robot");
+  EXPECT_EQ(values[3].length, sizeof(data));
+  ASSERT_EQ(values[4].type, PROTON_FLOAT_ARRAY);
+  ASSERT_EQ(values[4].length, sizeof(gains));
+  EXPECT_EQ(std::memcmp(values[4].data, gains, sizeof(gains)), 0);
+}
+
+TEST(RegistryView, ReadBundleChecksItsBuffers)
+{
+  GeneratedNode node(make_config(), "pc");
+  const std::string name = view_name("buffers");
+  RegistryPublisher publisher;
+  ASSERT_EQ(publisher.create(name.c_str(), node), PROTON_OK);
+  RegistryView view;
+  ASSERT_EQ(view.attach(name.c_str()), PROTON_OK);
+
+  proton_view_value_t values[5];
+  uint8_t buffer[64];
+  size_t num_values = 0;
+  EXPECT_EQ(view.read(99, values, 5, buffer, sizeof(buffer), num_values), PROTON_ERROR);
+  EXPECT_EQ(
+    view.read(STATE_BUNDLE, values, 4, buffer, sizeof(buffer), num_values),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(
+    view.read(STATE_BUNDLE, values, 5, buffer, 8, num_values), PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(num_values, 0u);
+}
+
+TEST(RegistryView, PublishesOnlyWrittenBundles)
+{
+  GeneratedNode node(make_config(), "pc");
+  const std::string name = view_name("written");
+  RegistryPublisher publisher;
+  ASSERT_EQ(publisher.create(name.c_str(), node), PROTON_OK);
+  RegistryView view;
+  ASSERT_EQ(view.attach(name.c_str()), PROTON_OK);
+
+  uint32_t state = 0;
+  uint32_t pair = 0;
+  ASSERT_EQ(view.sequence(STATE_BUNDLE, state), PROTON_OK);
+  ASSERT_EQ(view.sequence(PAIR_BUNDLE, pair), PROTON_OK);
+  EXPECT_EQ(view.sequence(99, pair), PROTON_ERROR);
+
+  // Written values are only seen once published
+  ASSERT_EQ(proton::SignalAccess(node.registry()).set(COUNT_SIGNAL, uint32_t{7}), PROTON_OK);
+  uint32_t count = 0;
+  ASSERT_EQ(view.get(COUNT_SIGNAL, count), PROTON_OK);
+  EXPECT_EQ(count, 0u);
+
+  ASSERT_EQ(publisher.publish(), PROTON_OK);
+  ASSERT_EQ(view.get(COUNT_SIGNAL, count), PROTON_OK);
+  EXPECT_EQ(count, 7u);
+  uint32_t sequence = 0;
+  ASSERT_EQ(view.sequence(STATE_BUNDLE, sequence), PROTON_OK);
+  EXPECT_EQ(sequence, state + 2);
+  ASSERT_EQ(view.sequence(PAIR_BUNDLE, sequence), PROTON_OK);
+  EXPECT_EQ(sequence, pair);
+
+  // Nothing changed since
+  ASSERT_EQ(publisher.publish(), PROTON_OK);
+  ASSERT_EQ(view.sequence(STATE_BUNDLE, sequence), PROTON_OK);
+  EXPECT_EQ(sequence, state + 2);
+
+  ASSERT_EQ(publisher.publish(PAIR_BUNDLE), PROTON_OK);
+  ASSERT_EQ(view.sequence(PAIR_BUNDLE, sequence), PROTON_OK);
+  EXPECT_EQ(sequence, pair + 2);
+  EXPECT_EQ(publisher.publish(99), PROTON_ERROR);
+}
+
+TEST(RegistryView, SeesThePublisherClose)
+{
+  GeneratedNode node(make_config(), "pc");
+  ASSERT_EQ(proton::SignalAccess(node.registry()).set(COUNT_SIGNAL, uint32_t{3}), PROTON_OK);
+  const std::string name = view_name("close");
+  RegistryPublisher publisher;
+  ASSERT_EQ(publisher.create(name.c_str(), node), PROTON_OK);
+  RegistryView view;
+  ASSERT_EQ(view.attach(name.c_str()), PROTON_OK);
+
+  publisher.close();
+  EXPECT_TRUE(view.is_closed());
+  uint32_t count = 0;
+  ASSERT_EQ(view.get(COUNT_SIGNAL, count), PROTON_OK);
+  EXPECT_EQ(count, 3u);
+
+  RegistryView late;
+  EXPECT_EQ(late.attach(name.c_str()), PROTON_CONNECT_ERROR);
+
+  // A new publisher replaces the view, which has to be attached again
+  ASSERT_EQ(publisher.create(name.c_str(), node), PROTON_OK);
+  ASSERT_EQ(view.attach(name.c_str()), PROTON_OK);
+  EXPECT_FALSE(view.is_closed());
+}
+
+TEST(RegistryView, ReadsAreConsistentWithAConcurrentPublisher)
+{
+  GeneratedNode node(make_config(), "pc");
+  const std::string name = view_name("consistent");
+  RegistryPublisher publisher;
+  ASSERT_EQ(publisher.create(name.c_str(), node), PROTON_OK);
+  RegistryView view;
+  ASSERT_EQ(view.attach(name.c_str()), PROTON_OK);
+
+  // The two signals of the pair are always written together, so a read of the bundle sees them
+  // equal unless it mixes two publishes
+  constexpr uint64_t WRITES = 20000;
+  std::atomic<bool> done = false;
+  std::thread writer([&]() {
+    proton::SignalAccess signals(node.registry());
+    for (uint64_t i = 1; i <= WRITES; i++)
+    {
+      signals.set(FIRST_SIGNAL, i);
+      signals.set(SECOND_SIGNAL, i);
+      publisher.publish();
+    }
+    done = true;
+  });
+
+  uint64_t reads = 0;
+  uint64_t last = 0;
+  proton_view_value_t values[2];
+  uint8_t buffer[16];
+  size_t num_values = 0;
+  while (!done || last < WRITES)
+  {
+    ASSERT_EQ(view.read(PAIR_BUNDLE, values, 2, buffer, sizeof(buffer), num_values), PROTON_OK);
+    uint64_t first;
+    uint64_t second;
+    std::memcpy(&first, values[0].data, sizeof(first));
+    std::memcpy(&second, values[1].data, sizeof(second));
+    ASSERT_EQ(first, second);
+    ASSERT_GE(first, last);
+    last = first;
+    reads++;
+  }
+  writer.join();
+  EXPECT_EQ(last, WRITES);
+  EXPECT_GT(reads, 0u);
+}
+
+#endif
@@ -0,0 +1,518 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include "protoncpp/bundle_access.hpp"
+#include "protoncpp/runtime.hpp"
+
+using proton::IoUring;
+using proton::Runtime;
+using proton::RuntimeBackend;
+
+TEST(Runtime, OpenRejectsNullNode)
+{
+  Runtime runtime;
+  EXPECT_EQ(runtime.open(static_cast<proton_node_t *>(nullptr)), PROTON_NULL_PTR_ERROR);
+  EXPECT_FALSE(runtime.is_open());
+}
+
+TEST(Runtime, RunBeforeOpenIsInvalidState)
+{
+  Runtime runtime;
+  EXPECT_EQ(runtime.run_once(0), PROTON_INVALID_STATE_ERROR);
+  EXPECT_EQ(runtime.run(), PROTON_INVALID_STATE_ERROR);
+}
+
+#if PROTON_NODE_BUILDER
+
+using namespace proton::node_builder;
+
+namespace
+{
+
+constexpr const char * LOOPBACK = "127.0.0.1";
+
+constexpr uint32_t STATUS_BUNDLE = 1;
+constexpr uint32_t COMMAND_BUNDLE = 2;
+constexpr uint32_t STATUS_SIGNAL = 1;
+constexpr uint32_t COMMAND_SIGNAL = 2;
+
+/**
+ * Two nodes connected by one endpoint each. The pc sends a periodic status bundle to the mcu, and
+ * the mcu sends a command bundle to the pc when triggered.
+ */
+Config make_config(
+  const EndpointConfig & pc_endpoint, const EndpointConfig & mcu_endpoint, uint32_t period_ms)
+{
+  Config config;
+  config.nodes["pc"] = {"pc", 1, {{pc_endpoint.id, pc_endpoint}}, false};
+  config.nodes["mcu"] = {"mcu", 2, {{mcu_endpoint.id, mcu_endpoint}}, false};
+  config.connections.push_back({{pc_endpoint.id, "pc"}, {mcu_endpoint.id, "mcu"}});
+  config.signals.push_back({"status", STATUS_SIGNAL, "uint32"});
+  config.signals.push_back({"command", COMMAND_SIGNAL, "uint32"});
+
+  BundleConfig status;
+  status.name = "status";
+  status.id = STATUS_BUNDLE;
+  status.period_ms = period_ms;
+  status.producers = {"pc"};
+  status.consumers = {"mcu"};
+  status.signals = {STATUS_SIGNAL};
+  config.bundles.push_back(status);
+
+  BundleConfig command;
+  command.name = "command";
+  command.id = COMMAND_BUNDLE;
+  command.period_ms = 0;
+  command.producers = {"mcu"};
+  command.consumers = {"pc"};
+  command.signals = {COMMAND_SIGNAL};
+  config.bundles.push_back(command);
+
+  return config;
+}
+
+// Port 0 binds an ephemeral port
+Config make_udp4_config(uint32_t period_ms, uint16_t pc_port = 0, uint16_t mcu_port = 0)
+{
+  return make_config(
+    {1, "udp4", "", LOOPBACK, pc_port, 0}, {1, "udp4", "", LOOPBACK, mcu_port, 0}, period_ms);
+}
+
+/**
+ * udp4 sockets of the pc and the mcu, bound to ephemeral ports so that tests running in parallel
+ * never receive each other's datagrams. Declared before the runtimes they are added to, which
+ * must not outlive them.
+ */
+struct Udp4Link
+{
+  proton::transport::udp4::Socket pc;
+  proton::transport::udp4::Socket mcu;
+  Config config;
+
+  // Bind both sockets, and make the config and peers of each address the other
+  ::testing::AssertionResult open(uint32_t period_ms)
+  {
+    if (pc.open(LOOPBACK, 0) != PROTON_OK || mcu.open(LOOPBACK, 0) != PROTON_OK)
+    {
+      return ::testing::AssertionFailure() << "cannot bind the udp4 sockets";
+    }
+    config = make_udp4_config(period_ms, pc.port(), mcu.port());
+    if (pc.add_peers(config, "pc") != PROTON_OK || mcu.add_peers(config, "mcu") != PROTON_OK)
+    {
+      return ::testing::AssertionFailure() << "cannot add the udp4 peers";
+    }
+    return ::testing::AssertionSuccess();
+  }
+};
+
+// Run the runtimes until done returns true, or a second has passed
+bool run_until(std::initializer_list<Runtime *> runtimes, const std::function<bool()> & done)
+{
+  const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (!done())
+  {
+    if (std::chrono::steady_clock::now() > end)
+    {
+      return false;
+    }
+    for (Runtime * runtime : runtimes)
+    {
+      if (runtime->run_once(5) != PROTON_OK)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Runs a test with each backend, skipping io_uring where the kernel does not support it
+ */
+class RuntimeBackendTest : public ::testing::TestWithParam<RuntimeBackend>
+{
+protected:
+  void SetUp() override
+  {
+    if (GetParam() == RuntimeBackend::IO_URING && !IoUring::supported())
+    {
+      GTEST_SKIP() << "io_uring is not supported";
+    }
+  }
+};
+
+}  // namespace
+
+TEST(Runtime, OpenFailsForUnknownTarget)
+{
+  Config config = make_udp4_config(10);
+  GeneratedNode pc(config, "pc");
+  Runtime runtime;
+  EXPECT_EQ(runtime.open(pc, config, "robot"), PROTON_INCORRECT_TARGET_ERROR);
+  EXPECT_FALSE(runtime.is_open());
+}
+
+TEST(Runtime, AutoPrefersIoUring)
+{
+  Config config = make_udp4_config(10);
+  GeneratedNode pc(config, "pc");
+  Runtime runtime;
+  ASSERT_EQ(runtime.open(pc, config, "pc"), PROTON_OK);
+  EXPECT_EQ(
+    runtime.backend(),
+    IoUring::supported() ? RuntimeBackend::IO_URING : RuntimeBackend::EPOLL);
+}
+
+TEST(Runtime, OpenWithIoUringFailsIfUnsupported)
+{
+  Config config = make_udp4_config(10);
+  GeneratedNode pc(config, "pc");
+  Runtime runtime;
+  const proton_status_e status = runtime.open(pc.node(), RuntimeBackend::IO_URING);
+  if (IoUring::supported())
+  {
+    EXPECT_EQ(status, PROTON_OK);
+    EXPECT_EQ(runtime.backend(), RuntimeBackend::IO_URING);
+  }
+  else
+  {
+    EXPECT_EQ(status, PROTON_UNSUPPORTED_OPERATION_ERROR);
+    EXPECT_FALSE(runtime.is_open());
+  }
+}
+
+TEST_P(RuntimeBackendTest, OpensWithBackend)
+{
+  Config config = make_udp4_config(10);
+  GeneratedNode pc(config, "pc");
+  Runtime runtime;
+  ASSERT_EQ(runtime.open(pc, config, "pc", GetParam()), PROTON_OK);
+  EXPECT_EQ(runtime.backend(), GetParam());
+  runtime.close();
+  EXPECT_FALSE(runtime.is_open());
+}
+
+TEST_P(RuntimeBackendTest, AddsGroSocketsOnlyWithEpoll)
+{
+  proton::transport::udp4::Socket socket;
+  if (socket.open(LOOPBACK, 0, {.gro = true}) != PROTON_OK)
+  {
+    GTEST_SKIP() << "UDP_GRO is not supported by this kernel";
+  }
+  ASSERT_TRUE(socket.gro());
+
+  Config config = make_udp4_config(10);
+  GeneratedNode pc(config, "pc");
+  Runtime runtime;
+  ASSERT_EQ(runtime.open(pc.node(), GetParam()), PROTON_OK);
+  // io_uring receives each datagram into one buffer, and cannot split coalesced ones
+  const proton_status_e expected = GetParam() == RuntimeBackend::IO_URING
+                                     ? PROTON_UNSUPPORTED_OPERATION_ERROR
+                                     : PROTON_OK;
+  EXPECT_EQ(runtime.add_socket(socket), expected);
+}
+
+TEST_P(RuntimeBackendTest, SendsAndReceivesOverUdp4)
+{
+  Udp4Link link;
+  ASSERT_TRUE(link.open(10));
+  GeneratedNode pc(link.config, "pc");
+  GeneratedNode mcu(link.config, "mcu");
+  Runtime pc_runtime;
+  Runtime mcu_runtime;
+  ASSERT_EQ(pc_runtime.open(pc.node(), GetParam()), PROTON_OK);
+  ASSERT_EQ(pc_runtime.add_socket(link.pc), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.open(mcu.node(), GetParam()), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.add_socket(link.mcu), PROTON_OK);
+
+  size_t statuses = 0;
+  proton::BundleAccess(mcu.registry(), STATUS_BUNDLE)
+    .set_callback([&](uint32_t, const uint32_t *, size_t) { statuses++; });
+  size_t commands = 0;
+  proton::BundleAccess(pc.registry(), COMMAND_BUNDLE)
+    .set_callback([&](uint32_t, const uint32_t *, size_t) { commands++; });
+
+  ASSERT_EQ(proton::SignalAccess(pc.registry()).set(STATUS_SIGNAL, uint32_t{42}), PROTON_OK);
+  ASSERT_TRUE(run_until({&pc_runtime, &mcu_runtime}, [&]() { return statuses >= 3; }));
+  uint32_t status = 0;
+  ASSERT_EQ(proton::SignalAccess(mcu.registry()).get(STATUS_SIGNAL, status), PROTON_OK);
+  EXPECT_EQ(status, 42u);
+
+  ASSERT_EQ(proton::SignalAccess(mcu.registry()).set(COMMAND_SIGNAL, uint32_t{7}), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.trigger_bundle(COMMAND_BUNDLE), PROTON_OK);
+  ASSERT_TRUE(run_until({&pc_runtime, &mcu_runtime}, [&]() { return commands == 1; }));
+  uint32_t command = 0;
+  ASSERT_EQ(proton::SignalAccess(pc.registry()).get(COMMAND_SIGNAL, command), PROTON_OK);
+  EXPECT_EQ(command, 7u);
+
+  EXPECT_EQ(pc_runtime.stats().send_errors, 0u);
+  EXPECT_EQ(mcu_runtime.stats().receive_errors, 0u);
+  EXPECT_GE(mcu_runtime.stats().frames_received, 3u);
+}
+
+TEST_P(RuntimeBackendTest, KeepsSendingPastABundleThatCannotBeEncoded)
+{
+  constexpr uint32_t LARGE_BUNDLE = 3;
+  constexpr uint32_t LARGE_SIGNAL = 3;
+  Udp4Link link;
+  ASSERT_TRUE(link.open(10));
+  // A periodic bundle larger than a frame buffer, which every update fails to encode
+  link.config.signals.push_back({"large", LARGE_SIGNAL, "bytes", 20000});
+  BundleConfig large;
+  large.name = "large";
+  large.id = LARGE_BUNDLE;
+  large.period_ms = 10;
+  large.producers = {"pc"};
+  large.consumers = {"mcu"};
+  large.signals = {LARGE_SIGNAL};
+  link.config.bundles.push_back(large);
+
+  GeneratedNode pc(link.config, "pc");
+  GeneratedNode mcu(link.config, "mcu");
+  Runtime pc_runtime;
+  Runtime mcu_runtime;
+  ASSERT_EQ(pc_runtime.open(pc.node(), GetParam()), PROTON_OK);
+  ASSERT_EQ(pc_runtime.add_socket(link.pc), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.open(mcu.node(), GetParam()), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.add_socket(link.mcu), PROTON_OK);
+
+  size_t statuses = 0;
+  proton::BundleAccess(mcu.registry(), STATUS_BUNDLE)
+    .set_callback([&](uint32_t, const uint32_t *, size_t) { statuses++; });
+
+  // The failures are counted, and the status bundle still goes out
+  ASSERT_TRUE(run_until({&pc_runtime, &mcu_runtime}, [&]() { return statuses >= 3; }));
+  EXPECT_GE(pc_runtime.stats().send_errors, 1u);
+}
+
+TEST_P(RuntimeBackendTest, SleepsUntilNextDeadline)
+{
+  constexpr uint32_t PERIOD_MS = 20;
+  constexpr uint64_t WAITS = 3;
+  // The pc endpoint is opened from the config on an ephemeral port, and sends to an mcu socket
+  // nothing reads
+  proton::transport::udp4::Socket mcu_socket;
+  ASSERT_EQ(mcu_socket.open(LOOPBACK, 0), PROTON_OK);
+  Config config = make_udp4_config(PERIOD_MS, 0, mcu_socket.port());
+  GeneratedNode pc(config, "pc");
+  Runtime runtime;
+  ASSERT_EQ(runtime.open(pc, config, "pc", GetParam()), PROTON_OK);
+
+  // Every bundle is due at first
+  ASSERT_EQ(runtime.run_once(0), PROTON_OK);
+  ASSERT_EQ(runtime.stats().messages_sent, 1u);
+
+  // Nothing is received, so each wait only ends once the bundle is due again, however late the
+  // loop gets to run. Send completions do not end it.
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t wait = 1; wait <= WAITS; wait++)
+  {
+    ASSERT_EQ(runtime.run_once(-1), PROTON_OK);
+    EXPECT_EQ(runtime.stats().messages_sent, 1u + wait);
+  }
+  // Only guards against a missed deadline leaving the loop asleep
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST_P(RuntimeBackendTest, TriggerAndStopFromAnotherThread)
+{
+  Udp4Link link;
+  ASSERT_TRUE(link.open(10));
+  GeneratedNode mcu(link.config, "mcu");
+  Runtime runtime;
+  ASSERT_EQ(runtime.open(mcu.node(), GetParam()), PROTON_OK);
+  ASSERT_EQ(runtime.add_socket(link.mcu), PROTON_OK);
+
+  std::thread other([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    runtime.trigger_bundle(COMMAND_BUNDLE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    runtime.stop();
+  });
+  // The mcu only sends when triggered, so the loop sleeps until woken up
+  EXPECT_EQ(runtime.run(), PROTON_OK);
+  other.join();
+
+  // The trigger and the stop are the only events, so the loop does not spin in between. The bound
+  // leaves room for wakeups the system adds, such as an interrupted wait.
+  EXPECT_EQ(runtime.stats().messages_sent, 1u);
+  EXPECT_LE(runtime.stats().wakeups, 10u);
+}
+
+TEST_P(RuntimeBackendTest, SendsAndReceivesOverSerial)
+{
+  int master = -1;
+  int slave = -1;
+  char name[256];
+  ASSERT_EQ(openpty(&master, &slave, name, nullptr, nullptr), 0);
+  termios tio;
+  ASSERT_EQ(tcgetattr(master, &tio), 0);
+  cfmakeraw(&tio);
+  ASSERT_EQ(tcsetattr(master, TCSANOW, &tio), 0);
+
+  Config config = make_config(
+    {1, "serial", name, "", 0, 0}, {3, "serial", "/dev/ttyUSB0", "", 0, 0}, 10);
+  GeneratedNode pc(config, "pc");
+  GeneratedNode mcu(config, "mcu");
+  Runtime runtime;
+  ASSERT_EQ(runtime.open(pc, config, "pc", GetParam()), PROTON_OK);
+
+  // The status bundle goes out framed, and the mcu node decodes it
+  ASSERT_EQ(proton::SignalAccess(pc.registry()).set(STATUS_SIGNAL, uint32_t{42}), PROTON_OK);
+  ASSERT_EQ(runtime.run_once(0), PROTON_OK);
+  pollfd pfd = {master, POLLIN, 0};
+  ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+  uint8_t bytes[256];
+  ssize_t len = read(master, bytes, sizeof(bytes));
+  ASSERT_GT(len, 0);
+
+  uint8_t parser_buffer[256];
+  proton_serial_parser_t parser;
+  ASSERT_EQ(
+    proton_serial_parser_init(&parser, parser_buffer, sizeof(parser_buffer), 256), PROTON_OK);
+  size_t consumed = 0;
+  proton_serial_frame_t frame;
+  ASSERT_EQ(
+    proton_serial_parser_feed(&parser, bytes, static_cast<size_t>(len), &consumed, &frame),
+    PROTON_OK);
+  ASSERT_NE(frame.payload, nullptr);
+  ASSERT_EQ(
+    proton_node_receive_frame(mcu.node(), frame.payload, frame.length, 1, frame.flags), PROTON_OK);
+  uint32_t status = 0;
+  ASSERT_EQ(proton::SignalAccess(mcu.registry()).get(STATUS_SIGNAL, status), PROTON_OK);
+  EXPECT_EQ(status, 42u);
+
+  // A command frame written by the mcu is received and decoded
+  size_t commands = 0;
+  proton::BundleAccess(pc.registry(), COMMAND_BUNDLE)
+    .set_callback([&](uint32_t, const uint32_t *, size_t) { commands++; });
+  ASSERT_EQ(proton::SignalAccess(mcu.registry()).set(COMMAND_SIGNAL, uint32_t{7}), PROTON_OK);
+  const proton_framing_t framing = PROTON_SERIAL_FRAMING;
+  uint8_t command_frame[256];
+  size_t frame_len = 0;
+  proton_endpoint_t dest[1];
+  size_t num_peers = 0;
+  ASSERT_EQ(
+    proton_node_encode_bundle_framed(
+      mcu.node(), COMMAND_BUNDLE, 0, command_frame, sizeof(command_frame), &framing, &frame_len,
+      dest, 1, &num_peers),
+    PROTON_OK);
+  ASSERT_EQ(write(master, command_frame, frame_len), static_cast<ssize_t>(frame_len));
+
+  ASSERT_TRUE(run_until({&runtime}, [&]() { return commands == 1; }));
+  uint32_t command = 0;
+  ASSERT_EQ(proton::SignalAccess(pc.registry()).get(COMMAND_SIGNAL, command), PROTON_OK);
+  EXPECT_EQ(command, 7u);
+  EXPECT_EQ(runtime.stats().receive_errors, 0u);
+
+  runtime.close();
+  close(master);
+  close(slave);
+}
+
+TEST_P(RuntimeBackendTest, SendsAndReceivesOverShm)
+{
+  const std::string suffix = std::to_string(getpid());
+  Config config = make_config(
+    {1, "shm", "/proton-runtime-pc-" + suffix, "", 0, 0},
+    {1, "shm", "/proton-runtime-mcu-" + suffix, "", 0, 0}, 10);
+  GeneratedNode pc(config, "pc");
+  GeneratedNode mcu(config, "mcu");
+  Runtime pc_runtime;
+  Runtime mcu_runtime;
+  ASSERT_EQ(pc_runtime.open(pc, config, "pc", GetParam()), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.open(mcu, config, "mcu", GetParam()), PROTON_OK);
+
+  size_t statuses = 0;
+  proton::BundleAccess(mcu.registry(), STATUS_BUNDLE)
+    .set_callback([&](uint32_t, const uint32_t *, size_t) { statuses++; });
+  size_t commands = 0;
+  proton::BundleAccess(pc.registry(), COMMAND_BUNDLE)
+    .set_callback([&](uint32_t, const uint32_t *, size_t) { commands++; });
+
+  ASSERT_EQ(proton::SignalAccess(pc.registry()).set(STATUS_SIGNAL, uint32_t{42}), PROTON_OK);
+  ASSERT_TRUE(run_until({&pc_runtime, &mcu_runtime}, [&]() { return statuses >= 3; }));
+  uint32_t status = 0;
+  ASSERT_EQ(proton::SignalAccess(mcu.registry()).get(STATUS_SIGNAL, status), PROTON_OK);
+  EXPECT_EQ(status, 42u);
+
+  // The mcu sleeps until the command it triggers from another thread wakes it up, and the frame it
+  // sends rings the doorbell of the pc
+  ASSERT_EQ(proton::SignalAccess(mcu.registry()).set(COMMAND_SIGNAL, uint32_t{7}), PROTON_OK);
+  std::thread other([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mcu_runtime.trigger_bundle(COMMAND_BUNDLE);
+  });
+  ASSERT_TRUE(run_until({&mcu_runtime, &pc_runtime}, [&]() { return commands == 1; }));
+  other.join();
+  uint32_t command = 0;
+  ASSERT_EQ(proton::SignalAccess(pc.registry()).get(COMMAND_SIGNAL, command), PROTON_OK);
+  EXPECT_EQ(command, 7u);
+
+  EXPECT_EQ(pc_runtime.stats().send_errors, 0u);
+  EXPECT_EQ(mcu_runtime.stats().receive_errors, 0u);
+  EXPECT_GE(mcu_runtime.stats().frames_received, 3u);
+}
+
+TEST_P(RuntimeBackendTest, PublishesReceivedValuesToAView)
+{
+  Udp4Link link;
+  ASSERT_TRUE(link.open(10));
+  GeneratedNode pc(link.config, "pc");
+  GeneratedNode mcu(link.config, "mcu");
+  Runtime pc_runtime;
+  Runtime mcu_runtime;
+  ASSERT_EQ(pc_runtime.open(pc.node(), GetParam()), PROTON_OK);
+  ASSERT_EQ(pc_runtime.add_socket(link.pc), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.open(mcu.node(), GetParam()), PROTON_OK);
+  ASSERT_EQ(mcu_runtime.add_socket(link.mcu), PROTON_OK);
+
+  const std::string name = "/proton-runtime-view-" + std::to_string(getpid());
+  proton::RegistryPublisher publisher;
+  ASSERT_EQ(publisher.create(name.c_str(), mcu), PROTON_OK);
+  mcu_runtime.set_publisher(&publisher);
+  proton::RegistryView view;
+  ASSERT_EQ(view.attach(name.c_str()), PROTON_OK);
+
+  size_t statuses = 0;
+  proton::BundleAccess(mcu.registry(), STATUS_BUNDLE)
+    .set_callback([&](uint32_t, const uint32_t *, size_t) { statuses++; });
+  ASSERT_EQ(proton::SignalAccess(pc.registry()).set(STATUS_SIGNAL, uint32_t{42}), PROTON_OK);
+  ASSERT_TRUE(run_until({&pc_runtime, &mcu_runtime}, [&]() { return statuses >= 1; }));
+
+  // The wakeup that received the status published it
+  uint32_t status = 0;
+  ASSERT_EQ(view.get(STATUS_SIGNAL, status), PROTON_OK);
+  EXPECT_EQ(status, 42u);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Backends, RuntimeBackendTest, ::testing::Values(RuntimeBackend::EPOLL, RuntimeBackend::IO_URING),
+  [](const ::testing::TestParamInfo<RuntimeBackend> & info) {
+    return info.param == RuntimeBackend::EPOLL ? "Epoll" : "IoUring";
+  });
+
+#endif
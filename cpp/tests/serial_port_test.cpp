@@ -0,0 +1,430 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+#include <array>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <vector>
+#include "protoncpp/transport/serial_port.hpp"
+
+using namespace proton::transport;
+using namespace proton::transport::serial;
+
+namespace
+{
+
+constexpr int TIMEOUT_MS = 1000;
+
+/**
+ * A pty pair standing in for a serial device, the Port opens the slave side and the test plays
+ * the peer on the master side
+ */
+class PtyTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char name[256];
+    ASSERT_EQ(openpty(&master_, &slave_, name, nullptr, nullptr), 0);
+    device_ = name;
+    // Keep the peer side raw as well, so bytes pass through untouched
+    termios tio;
+    ASSERT_EQ(tcgetattr(master_, &tio), 0);
+    cfmakeraw(&tio);
+    ASSERT_EQ(tcsetattr(master_, TCSANOW, &tio), 0);
+    fcntl(master_, F_SETFL, fcntl(master_, F_GETFL) | O_NONBLOCK);
+  }
+
+  void TearDown() override
+  {
+    port_.close();
+    ::close(slave_);
+    ::close(master_);
+  }
+
+  std::vector<uint8_t> make_frame(const std::vector<uint8_t> & payload, uint8_t flags = 0)
+  {
+    const bool crc32c = flags & FRAME_FLAG_CRC32C;
+    std::vector<uint8_t> frame(
+      FRAME_HEADER_OVERHEAD + payload.size() +
+      (crc32c ? FRAME_CRC32C_OVERHEAD : FRAME_CRC_OVERHEAD));
+    const uint16_t len = static_cast<uint16_t>(payload.size());
+    EXPECT_EQ(fill_frame_header(frame.data(), len, flags), PROTON_OK);
+    std::memcpy(frame.data() + FRAME_HEADER_OVERHEAD, payload.data(), payload.size());
+    uint8_t * payload_start = frame.data() + FRAME_HEADER_OVERHEAD;
+    uint8_t * crc = payload_start + payload.size();
+    EXPECT_EQ(
+      crc32c ? fill_crc32c(payload_start, len, crc) : fill_crc16(payload_start, len, crc),
+      PROTON_OK);
+    return frame;
+  }
+
+  void peer_write(const std::vector<uint8_t> & bytes)
+  {
+    ASSERT_EQ(::write(master_, bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+  }
+
+  std::vector<uint8_t> peer_read(size_t len)
+  {
+    std::vector<uint8_t> bytes;
+    std::array<uint8_t, 4096> chunk;
+    while (bytes.size() < len)
+    {
+      pollfd pfd = {master_, POLLIN, 0};
+      if (poll(&pfd, 1, TIMEOUT_MS) <= 0)
+      {
+        break;
+      }
+      ssize_t ret = ::read(master_, chunk.data(), chunk.size());
+      if (ret <= 0)
+      {
+        break;
+      }
+      bytes.insert(bytes.end(), chunk.begin(), chunk.begin() + ret);
+    }
+    return bytes;
+  }
+
+  /**
+   * Read from the device until a frame is received or a read times out
+   */
+  bool receive_frame(frame_t & frame)
+  {
+    while (true)
+    {
+      EXPECT_EQ(port_.receive(frame), PROTON_OK);
+      if (frame.payload != nullptr)
+      {
+        return true;
+      }
+      size_t received = 0;
+      EXPECT_EQ(port_.read(received, TIMEOUT_MS), PROTON_OK);
+      if (received == 0)
+      {
+        return false;
+      }
+    }
+  }
+
+  int master_ = -1;
+  int slave_ = -1;
+  std::string device_;
+  Port port_;
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------
+// ByteRing
+// -----------------------------------------------------------------------
+
+TEST(ByteRing, WrapsAroundTheEnd)
+{
+  ByteRing<8> ring;
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(ring.write(data, 6), 6u);
+  ring.release(4);
+  EXPECT_EQ(ring.write(data, 6), 6u);
+  EXPECT_EQ(ring.write(data, 1), 0u);
+  EXPECT_EQ(ring.size(), 8u);
+
+  RingRegions<const uint8_t> readable = ring.readable();
+  ASSERT_EQ(readable.len[0], 4u);
+  ASSERT_EQ(readable.len[1], 4u);
+  EXPECT_EQ(readable.data[0][0], 5);
+  EXPECT_EQ(readable.data[0][2], 1);
+  EXPECT_EQ(readable.data[1][0], 3);
+  EXPECT_EQ(readable.data[1][3], 6);
+}
+
+TEST(ByteRing, ProducerAndConsumerThreads)
+{
+  constexpr size_t TOTAL = 1 << 16;
+  ByteRing<256> ring;
+
+  std::thread producer([&ring]() {
+    size_t written = 0;
+    while (written < TOTAL)
+    {
+      RingRegions<uint8_t> free = ring.writable();
+      size_t len = 0;
+      for (size_t i = 0; i < 2; i++)
+      {
+        for (size_t j = 0; j < free.len[i] && written + len < TOTAL; j++, len++)
+        {
+          free.data[i][j] = static_cast<uint8_t>((written + len) * 7);
+        }
+      }
+      ring.commit(len);
+      written += len;
+      if (len == 0)
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  size_t read = 0;
+  bool ordered = true;
+  while (read < TOTAL)
+  {
+    RingRegions<const uint8_t> data = ring.readable();
+    if (data.size() == 0)
+    {
+      std::this_thread::yield();
+    }
+    for (size_t i = 0; i < 2; i++)
+    {
+      for (size_t j = 0; j < data.len[i]; j++)
+      {
+        ordered &= data.data[i][j] == static_cast<uint8_t>((read + j) * 7);
+      }
+      read += data.len[i];
+      ring.release(data.len[i]);
+    }
+  }
+  producer.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(ring.size(), 0u);
+}
+
+// -----------------------------------------------------------------------
+// Port
+// -----------------------------------------------------------------------
+
+TEST_F(PtyTest, OpensInRawMode)
+{
+  ASSERT_EQ(port_.open(device_.c_str(), {.baud_rate = 921600, .vmin = 1, .vtime = 2}), PROTON_OK);
+  EXPECT_TRUE(port_.is_open());
+
+  termios tio;
+  ASSERT_EQ(tcgetattr(port_.fd(), &tio), 0);
+  EXPECT_EQ(tio.c_lflag & (ICANON | ECHO | ISIG), 0u);
+  EXPECT_EQ(tio.c_oflag & OPOST, 0u);
+  EXPECT_EQ(cfgetospeed(&tio), static_cast<speed_t>(B921600));
+  EXPECT_EQ(tio.c_cc[VMIN], 1);
+  EXPECT_EQ(tio.c_cc[VTIME], 2);
+  EXPECT_NE(fcntl(port_.fd(), F_GETFL) & O_NONBLOCK, 0);
+}
+
+TEST_F(PtyTest, LowLatencyIsIgnoredByPtys)
+{
+  EXPECT_EQ(port_.open(device_.c_str(), {.low_latency = true}), PROTON_OK);
+}
+
+TEST_F(PtyTest, RejectsBadSettings)
+{
+  EXPECT_EQ(port_.open(device_.c_str(), {.baud_rate = 12345}), PROTON_CONNECT_ERROR);
+  EXPECT_EQ(
+    port_.open(device_.c_str(), {.max_payload_len = Port::MAX_PAYLOAD_LEN + 1}),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(port_.open("/dev/does_not_exist"), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(port_.is_open());
+}
+
+TEST_F(PtyTest, RequiresOpenPort)
+{
+  size_t received = 0;
+  EXPECT_EQ(port_.read(received), PROTON_INVALID_STATE_ERROR);
+  const std::array<uint8_t, 1> payload = {0};
+  EXPECT_EQ(port_.send(payload), PROTON_INVALID_STATE_ERROR);
+}
+
+TEST_F(PtyTest, ReceivesFrame)
+{
+  ASSERT_EQ(port_.open(device_.c_str()), PROTON_OK);
+  peer_write(make_frame({1, 2, 3, 4}));
+
+  frame_t frame;
+  ASSERT_TRUE(receive_frame(frame));
+  ASSERT_EQ(frame.length, 4);
+  EXPECT_EQ(frame.payload[0], 1);
+  EXPECT_EQ(frame.payload[3], 4);
+  EXPECT_EQ(frame.flags, 0);
+  EXPECT_EQ(port_.parser().frames, 1u);
+}
+
+TEST_F(PtyTest, ReceivesFrameWrittenInPieces)
+{
+  ASSERT_EQ(port_.open(device_.c_str()), PROTON_OK);
+  std::vector<uint8_t> frame_bytes = make_frame({9, 8, 7, 6, 5});
+
+  frame_t frame;
+  for (size_t i = 0; i < frame_bytes.size(); i++)
+  {
+    EXPECT_EQ(port_.receive(frame), PROTON_OK);
+    EXPECT_EQ(frame.payload, nullptr);
+    peer_write({frame_bytes[i]});
+    size_t received = 0;
+    ASSERT_EQ(port_.read(received, TIMEOUT_MS), PROTON_OK);
+    ASSERT_EQ(received, 1u);
+  }
+
+  ASSERT_EQ(port_.receive(frame), PROTON_OK);
+  ASSERT_NE(frame.payload, nullptr);
+  ASSERT_EQ(frame.length, 5);
+  EXPECT_EQ(frame.payload[0], 9);
+}
+
+TEST_F(PtyTest, ReceivesSeveralFramesFromOneRead)
+{
+  ASSERT_EQ(port_.open(device_.c_str(), {.crc32c = true}), PROTON_OK);
+  std::vector<uint8_t> bytes = make_frame({1});
+  std::vector<uint8_t> second = make_frame({2, 2}, FRAME_FLAG_CRC32C);
+  std::vector<uint8_t> third = make_frame({3, 3, 3});
+  bytes.insert(bytes.end(), second.begin(), second.end());
+  bytes.insert(bytes.end(), third.begin(), third.end());
+  peer_write(bytes);
+
+  size_t received = 0;
+  ASSERT_EQ(port_.read(received, TIMEOUT_MS), PROTON_OK);
+  ASSERT_EQ(received, bytes.size());
+
+  for (uint16_t i = 1; i <= 3; i++)
+  {
+    frame_t frame;
+    ASSERT_EQ(port_.receive(frame), PROTON_OK);
+    ASSERT_NE(frame.payload, nullptr);
+    ASSERT_EQ(frame.length, i);
+    EXPECT_EQ(frame.payload[0], i);
+  }
+}
+
+TEST_F(PtyTest, SkipsCorruptFrames)
+{
+  ASSERT_EQ(port_.open(device_.c_str()), PROTON_OK);
+  std::vector<uint8_t> bytes = {0x00, 0x11};
+  std::vector<uint8_t> corrupt = make_frame({1, 2, 3});
+  corrupt[FRAME_HEADER_OVERHEAD] ^= 0xFF;
+  std::vector<uint8_t> good = make_frame({4, 5, 6});
+  bytes.insert(bytes.end(), corrupt.begin(), corrupt.end());
+  bytes.insert(bytes.end(), good.begin(), good.end());
+  peer_write(bytes);
+
+  frame_t frame;
+  ASSERT_TRUE(receive_frame(frame));
+  ASSERT_EQ(frame.length, 3);
+  EXPECT_EQ(frame.payload[0], 4);
+  EXPECT_EQ(port_.parser().crc_errors, 1u);
+}
+
+TEST_F(PtyTest, ReceivesFramesAcrossTheRingEnd)
+{
+  ASSERT_EQ(port_.open(device_.c_str()), PROTON_OK);
+
+  // Enough traffic to wrap the receive ring several times, with frames straddling its end
+  std::vector<uint8_t> payload(700);
+  for (size_t round = 0; round < 40; round++)
+  {
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+      payload[i] = static_cast<uint8_t>(round + i);
+    }
+    peer_write(make_frame(payload));
+
+    frame_t frame;
+    ASSERT_TRUE(receive_frame(frame));
+    ASSERT_EQ(frame.length, payload.size());
+    EXPECT_EQ(std::memcmp(frame.payload, payload.data(), payload.size()), 0);
+  }
+  EXPECT_EQ(port_.parser().frames, 40u);
+}
+
+TEST_F(PtyTest, SendsFrameWithHeaderAndCrc)
+{
+  ASSERT_EQ(port_.open(device_.c_str()), PROTON_OK);
+  const std::vector<uint8_t> payload = {10, 20, 30};
+  ASSERT_EQ(port_.send(payload), PROTON_OK);
+  EXPECT_EQ(port_.pending(), 0u);
+
+  const std::vector<uint8_t> expected = make_frame(payload);
+  EXPECT_EQ(peer_read(expected.size()), expected);
+}
+
+TEST_F(PtyTest, SendsCrc32cFrames)
+{
+  ASSERT_EQ(port_.open(device_.c_str(), {.crc32c = true}), PROTON_OK);
+  const std::vector<uint8_t> payload = {1, 2, 3, 4, 5};
+  ASSERT_EQ(port_.send(payload, FRAME_FLAG_COMPACT), PROTON_OK);
+
+  const std::vector<uint8_t> expected =
+    make_frame(payload, FRAME_FLAG_CRC32C | FRAME_FLAG_COMPACT);
+  EXPECT_EQ(peer_read(expected.size()), expected);
+  EXPECT_EQ(port_.framing().tailroom, FRAME_CRC32C_OVERHEAD);
+}
+
+TEST_F(PtyTest, SendsPreparedFrame)
+{
+  ASSERT_EQ(port_.open(device_.c_str()), PROTON_OK);
+  const std::vector<uint8_t> frame = make_frame({42});
+  ASSERT_EQ(port_.send_frame(frame), PROTON_OK);
+  EXPECT_EQ(peer_read(frame.size()), frame);
+}
+
+TEST_F(PtyTest, QueuesWhatTheDeviceDoesNotTake)
+{
+  ASSERT_EQ(port_.open(device_.c_str()), PROTON_OK);
+
+  // Nobody reads the peer side, so the pty fills up and the rest of the frames is queued
+  const std::vector<uint8_t> payload(1000, 0x5A);
+  size_t sent = 0;
+  proton_status_e status = PROTON_OK;
+  while (sent < 1000 && (status = port_.send(payload)) == PROTON_OK)
+  {
+    sent++;
+  }
+  ASSERT_EQ(status, PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_GT(port_.pending(), 0u);
+
+  // Drain the peer side while flushing, every frame must arrive whole and in order
+  const std::vector<uint8_t> expected = make_frame(payload);
+  std::vector<uint8_t> bytes;
+  while (bytes.size() < sent * expected.size())
+  {
+    ASSERT_EQ(port_.flush(), PROTON_OK);
+    std::vector<uint8_t> chunk = peer_read(1);
+    ASSERT_FALSE(chunk.empty());
+    bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+  }
+  EXPECT_EQ(port_.pending(), 0u);
+  ASSERT_EQ(bytes.size(), sent * expected.size());
+  for (size_t i = 0; i < sent; i++)
+  {
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bytes.begin() + i * expected.size()));
+  }
+}
+
+#if PROTON_NODE_BUILDER
+
+TEST_F(PtyTest, OpensFromEndpointConfig)
+{
+  proton::node_builder::EndpointConfig endpoint = {2, "serial", device_, "", 0, 0};
+  ASSERT_EQ(port_.open(endpoint), PROTON_OK);
+
+  endpoint.type = "udp4";
+  EXPECT_EQ(port_.open(endpoint), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(port_.is_open());
+}
+
+#endif
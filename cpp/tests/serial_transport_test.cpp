@@ -17,6 +17,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <array>
 #include <span>
 #include "protoncpp/transport/core_serial.hpp"
@@ -371,6 +372,20 @@ TEST(GetFramedPayloadLengthSpan, WrongSecondMagicByteReturnsError)
 // Round-trip integration tests (span)
 // -----------------------------------------------------------------------
 
+TEST(SerialFramingSpan, CompactFlagRoundTrip)
+{
+  std::array<uint8_t, 4> header = {};
+  ASSERT_EQ(fill_frame_header(header.data(), 42, FRAME_FLAG_COMPACT), PROTON_OK);
+  EXPECT_EQ(header[1], FRAME_HEADER_MAGIC_BYTE_1_COMPACT);
+
+  uint16_t length = 0;
+  uint8_t flags = 0;
+  ASSERT_EQ(get_framed_payload_info(header, length, flags), PROTON_OK);
+  EXPECT_EQ(length, 42);
+  EXPECT_EQ(flags, FRAME_FLAG_COMPACT);
+  EXPECT_EQ(get_framed_payload_length(header, length), PROTON_INVALID_HEADER_ERROR);
+}
+
 TEST(SerialFramingSpan, FillCrcThenCheckCrc_RoundTrip)
 {
   const std::array<uint8_t, 4> payload = {0xDE, 0xAD, 0xBE, 0xEF};
@@ -394,6 +409,74 @@ TEST(SerialFramingSpan, ModifiedPayloadFailsCrcCheck)
   EXPECT_EQ(check_framed_payload(payload, crc_val), PROTON_CRC16_ERROR);
 }
 
+TEST(SerialFramingSpan, Crc32cFrameRoundTrip)
+{
+  std::array<uint8_t, 4> header = {};
+  ASSERT_EQ(fill_frame_header(header.data(), 4, FRAME_FLAG_CRC32C), PROTON_OK);
+  EXPECT_EQ(header[1], FRAME_HEADER_MAGIC_BYTE_1_CRC32C);
+
+  uint16_t length = 0;
+  uint8_t flags = 0;
+  ASSERT_EQ(get_framed_payload_info(header, length, flags), PROTON_OK);
+  EXPECT_EQ(flags, FRAME_FLAG_CRC32C);
+
+  std::array<uint8_t, 4> payload = {0xDE, 0xAD, 0xBE, 0xEF};
+  std::array<uint8_t, FRAME_CRC32C_OVERHEAD> crc_bytes = {};
+  ASSERT_EQ(fill_crc32c(payload, crc_bytes), PROTON_OK);
+
+  uint32_t crc_val = 0;
+  for (size_t i = 0; i < crc_bytes.size(); i++)
+  {
+    crc_val |= static_cast<uint32_t>(crc_bytes[i]) << (8 * i);
+  }
+  EXPECT_EQ(crc_val, crc32c_update(CRC32C_INIT, payload));
+  EXPECT_EQ(check_framed_payload_crc32c(payload, crc_val), PROTON_OK);
+  payload[0] ^= 0x01;  // flip one bit
+  EXPECT_EQ(check_framed_payload_crc32c(payload, crc_val), PROTON_CRC16_ERROR);
+}
+
+TEST(SerialFramingSpan, Crc16UpdateMatchesFrameCrc)
+{
+  const std::array<uint8_t, 4> payload = {0xDE, 0xAD, 0xBE, 0xEF};
+  std::array<uint8_t, 2> crc_bytes = {};
+  ASSERT_EQ(fill_crc16(payload, crc_bytes), PROTON_OK);
+
+  uint16_t crc = crc16_update(CRC16_INIT, std::span{payload}.first(1));
+  crc = crc16_update(crc, std::span{payload}.subspan(1));
+  EXPECT_EQ(crc, static_cast<uint16_t>(crc_bytes[0] | (crc_bytes[1] << 8)));
+}
+
+TEST(SerialParserSpan, ParsesFramesFromChunks)
+{
+  const std::array<uint8_t, 3> payload = {0x50, 0x52, 0x07};
+  std::array<uint8_t, FRAME_HEADER_OVERHEAD + payload.size() + FRAME_CRC_OVERHEAD> frame = {};
+  ASSERT_EQ(fill_frame_header(frame.data(), payload.size()), PROTON_OK);
+  std::copy(payload.begin(), payload.end(), frame.begin() + FRAME_HEADER_OVERHEAD);
+  ASSERT_EQ(
+    fill_crc16(payload, std::span{frame}.subspan<FRAME_HEADER_OVERHEAD + payload.size()>()),
+    PROTON_OK);
+
+  std::array<uint8_t, 8> buffer = {};
+  parser_t parser;
+  ASSERT_EQ(parser_init(parser, buffer, buffer.size()), PROTON_OK);
+
+  // Split inside the payload, so the frame is copied to the parser buffer
+  size_t consumed = 0;
+  frame_t out;
+  ASSERT_EQ(parser_feed(parser, std::span{frame}.first(5), consumed, out), PROTON_OK);
+  EXPECT_EQ(consumed, 5u);
+  EXPECT_EQ(out.payload, nullptr);
+  ASSERT_EQ(parser_feed(parser, std::span{frame}.subspan(5), consumed, out), PROTON_OK);
+  EXPECT_EQ(consumed, frame.size() - 5);
+  ASSERT_EQ(out.payload, buffer.data());
+  EXPECT_TRUE(std::equal(payload.begin(), payload.end(), out.payload));
+
+  // Whole frame, checked in place
+  ASSERT_EQ(parser_feed(parser, frame, consumed, out), PROTON_OK);
+  EXPECT_EQ(out.payload, frame.data() + FRAME_HEADER_OVERHEAD);
+  EXPECT_EQ(out.length, payload.size());
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "protoncpp/transport/shm_channel.hpp"
+
+using namespace proton::transport::shm;
+
+namespace
+{
+
+constexpr int TIMEOUT_MS = 1000;
+
+proton_endpoint_t endpoint(uint32_t node_id, uint32_t endpoint_id)
+{
+  return {node_id, endpoint_id, TRANSPORT_TYPE_SHM, 0};
+}
+
+// Ring names unique to this process, so that tests running in parallel do not share rings
+std::string ring_name(const char * name)
+{
+  return "/proton-test-" + std::to_string(getpid()) + "-" + name;
+}
+
+bool readable(int fd, int timeout_ms)
+{
+  pollfd pfd = {fd, POLLIN, 0};
+  return poll(&pfd, 1, timeout_ms) == 1;
+}
+
+}  // namespace
+
+TEST(ShmRing, CommittedFramesArriveInOrder)
+{
+  const std::string name = ring_name("order");
+  Ring consumer;
+  ASSERT_EQ(consumer.create(name.c_str(), {4, 64}), PROTON_OK);
+  Ring producer;
+  ASSERT_EQ(producer.attach(name.c_str()), PROTON_OK);
+  EXPECT_EQ(producer.slot_size(), 64u);
+
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    Ring::Slot slot;
+    ASSERT_EQ(producer.claim(slot), PROTON_OK);
+    slot.data[0] = i;
+    producer.commit(slot, 1, 7, i);
+  }
+
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    Frame frame;
+    ASSERT_TRUE(consumer.peek(frame));
+    EXPECT_EQ(frame.length, 1u);
+    EXPECT_EQ(frame.payload[0], i);
+    EXPECT_EQ(frame.node_id, 7);
+    EXPECT_EQ(frame.flags, i);
+    consumer.release();
+  }
+  Frame frame;
+  EXPECT_FALSE(consumer.peek(frame));
+}
+
+TEST(ShmRing, FullRingRejectsClaims)
+{
+  const std::string name = ring_name("full");
+  Ring consumer;
+  ASSERT_EQ(consumer.create(name.c_str(), {2, 16}), PROTON_OK);
+  Ring producer;
+  ASSERT_EQ(producer.attach(name.c_str()), PROTON_OK);
+
+  Ring::Slot slot;
+  for (int i = 0; i < 2; i++)
+  {
+    ASSERT_EQ(producer.claim(slot), PROTON_OK);
+    producer.commit(slot, 1, 0, 0);
+  }
+  EXPECT_EQ(producer.claim(slot), PROTON_INSUFFICIENT_BUFFER_ERROR);
+
+  // Releasing a frame frees its slot
+  Frame frame;
+  ASSERT_TRUE(consumer.peek(frame));
+  consumer.release();
+  EXPECT_EQ(producer.claim(slot), PROTON_OK);
+}
+
+TEST(ShmRing, UnusedSlotsAreSkipped)
+{
+  const std::string name = ring_name("unused");
+  Ring consumer;
+  ASSERT_EQ(consumer.create(name.c_str(), {4, 16}), PROTON_OK);
+  Ring producer;
+  ASSERT_EQ(producer.attach(name.c_str()), PROTON_OK);
+
+  Ring::Slot unused;
+  Ring::Slot used;
+  ASSERT_EQ(producer.claim(unused), PROTON_OK);
+  ASSERT_EQ(producer.claim(used), PROTON_OK);
+  used.data[0] = 42;
+  producer.commit(used, 1, 0, 0);
+
+  // Nothing is read past a slot still being written
+  Frame frame;
+  EXPECT_FALSE(consumer.peek(frame));
+  producer.commit(unused, 0, 0, 0);
+  ASSERT_TRUE(consumer.peek(frame));
+  EXPECT_EQ(frame.payload[0], 42);
+}
+
+TEST(ShmRing, WakesOnlyASleepingConsumer)
+{
+  const std::string name = ring_name("sleep");
+  Ring consumer;
+  ASSERT_EQ(consumer.create(name.c_str(), {4, 16}), PROTON_OK);
+  Ring producer;
+  ASSERT_EQ(producer.attach(name.c_str()), PROTON_OK);
+
+  Ring::Slot slot;
+  ASSERT_EQ(producer.claim(slot), PROTON_OK);
+  EXPECT_FALSE(producer.commit(slot, 1, 0, 0));
+
+  // A consumer with a frame pending does not sleep
+  EXPECT_FALSE(consumer.prepare_sleep());
+  Frame frame;
+  ASSERT_TRUE(consumer.peek(frame));
+  consumer.release();
+
+  // Only the first commit after the consumer went to sleep wakes it up
+  EXPECT_TRUE(consumer.prepare_sleep());
+  ASSERT_EQ(producer.claim(slot), PROTON_OK);
+  EXPECT_TRUE(producer.commit(slot, 1, 0, 0));
+  ASSERT_EQ(producer.claim(slot), PROTON_OK);
+  EXPECT_FALSE(producer.commit(slot, 1, 0, 0));
+}
+
+TEST(ShmRing, AttachFailsWithoutRing)
+{
+  Ring producer;
+  EXPECT_EQ(producer.attach(ring_name("missing").c_str()), PROTON_CONNECT_ERROR);
+  EXPECT_EQ(producer.attach("no-slash"), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(producer.is_open());
+}
+
+TEST(ShmRing, ProducersSeeTheConsumerClose)
+{
+  const std::string name = ring_name("close");
+  Ring consumer;
+  ASSERT_EQ(consumer.create(name.c_str()), PROTON_OK);
+  Ring producer;
+  ASSERT_EQ(producer.attach(name.c_str()), PROTON_OK);
+  EXPECT_FALSE(producer.is_closed());
+
+  consumer.close();
+  EXPECT_TRUE(producer.is_closed());
+  Ring other;
+  EXPECT_EQ(other.attach(name.c_str()), PROTON_CONNECT_ERROR);
+}
+
+TEST(ShmRing, ManyProducersLoseNoFrame)
+{
+  constexpr int PRODUCERS = 4;
+  constexpr uint32_t FRAMES = 10000;
+  const std::string name = ring_name("mpsc");
+  Ring consumer;
+  ASSERT_EQ(consumer.create(name.c_str(), {16, 8}), PROTON_OK);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; p++)
+  {
+    producers.emplace_back([&, p]() {
+      Ring producer;
+      ASSERT_EQ(producer.attach(name.c_str()), PROTON_OK);
+      for (uint32_t i = 0; i < FRAMES; i++)
+      {
+        Ring::Slot slot;
+        while (producer.claim(slot) != PROTON_OK)
+        {
+          std::this_thread::yield();
+        }
+        std::memcpy(slot.data, &i, sizeof(i));
+        producer.commit(slot, sizeof(i), static_cast<uint8_t>(p), 0);
+      }
+    });
+  }
+
+  // Frames of each producer arrive in the order it sent them
+  uint32_t next[PRODUCERS] = {};
+  uint32_t received = 0;
+  while (received < PRODUCERS * FRAMES)
+  {
+    Frame frame;
+    if (!consumer.peek(frame))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    uint32_t value;
+    std::memcpy(&value, frame.payload, sizeof(value));
+    ASSERT_LT(frame.node_id, PRODUCERS);
+    ASSERT_EQ(value, next[frame.node_id]++);
+    consumer.release();
+    received++;
+  }
+
+  for (std::thread & producer : producers)
+  {
+    producer.join();
+  }
+}
+
+TEST(ShmChannel, SendRingsTheDoorbellOfAWaitingPeer)
+{
+  const std::string pc_name = ring_name("pc");
+  const std::string mcu_name = ring_name("mcu");
+  Channel pc;
+  Channel mcu;
+  ASSERT_EQ(pc.open(pc_name.c_str()), PROTON_OK);
+  ASSERT_EQ(mcu.open(mcu_name.c_str()), PROTON_OK);
+  ASSERT_EQ(pc.add_peer(2, 1, mcu_name.c_str()), PROTON_OK);
+  EXPECT_TRUE(pc.has_peer(2, 1));
+
+  EXPECT_FALSE(mcu.prepare_wait());
+  EXPECT_FALSE(readable(mcu.fd(), 0));
+
+  const uint8_t payload[] = {1, 2, 3};
+  const proton_endpoint_t peers[] = {endpoint(2, 1)};
+  size_t sent = 0;
+  ASSERT_EQ(pc.send(payload, sizeof(payload), 1, 0, peers, 1, sent), PROTON_OK);
+  EXPECT_EQ(sent, 1u);
+  EXPECT_TRUE(readable(mcu.fd(), TIMEOUT_MS));
+
+  Frame frame;
+  ASSERT_EQ(mcu.receive(frame), PROTON_OK);
+  ASSERT_NE(frame.payload, nullptr);
+  EXPECT_EQ(frame.node_id, 1);
+  ASSERT_EQ(frame.length, sizeof(payload));
+  EXPECT_EQ(std::memcmp(frame.payload, payload, sizeof(payload)), 0);
+  mcu.release();
+  ASSERT_EQ(mcu.receive(frame), PROTON_OK);
+  EXPECT_EQ(frame.payload, nullptr);
+
+  // Emptied before the next wait
+  EXPECT_FALSE(mcu.prepare_wait());
+  EXPECT_FALSE(readable(mcu.fd(), 0));
+}
+
+TEST(ShmChannel, FramesSentBeforeWaitingAreReported)
+{
+  const std::string pc_name = ring_name("pc-pending");
+  const std::string mcu_name = ring_name("mcu-pending");
+  Channel pc;
+  Channel mcu;
+  ASSERT_EQ(pc.open(pc_name.c_str()), PROTON_OK);
+  ASSERT_EQ(mcu.open(mcu_name.c_str()), PROTON_OK);
+  ASSERT_EQ(pc.add_peer(2, 1, mcu_name.c_str()), PROTON_OK);
+
+  const uint8_t payload[] = {1};
+  const proton_endpoint_t peers[] = {endpoint(2, 1)};
+  size_t sent = 0;
+  ASSERT_EQ(pc.send(payload, sizeof(payload), 1, 0, peers, 1, sent), PROTON_OK);
+  EXPECT_TRUE(mcu.prepare_wait());
+}
+
+TEST(ShmChannel, EncodesStraightIntoThePeerRing)
+{
+  const std::string pc_name = ring_name("pc-claim");
+  const std::string mcu_name = ring_name("mcu-claim");
+  Channel pc;
+  Channel mcu;
+  ASSERT_EQ(pc.open(pc_name.c_str()), PROTON_OK);
+  ASSERT_EQ(mcu.open(mcu_name.c_str(), {8, 32}), PROTON_OK);
+  ASSERT_EQ(pc.add_peer(2, 1, mcu_name.c_str()), PROTON_OK);
+
+  Ring::Slot slot;
+  ASSERT_EQ(pc.claim(endpoint(2, 1), slot), PROTON_OK);
+  EXPECT_EQ(slot.capacity, 32u);
+  slot.data[0] = 9;
+  ASSERT_EQ(pc.commit(endpoint(2, 1), slot, 1, 1, 0), PROTON_OK);
+
+  Frame frame;
+  ASSERT_EQ(mcu.receive(frame), PROTON_OK);
+  ASSERT_NE(frame.payload, nullptr);
+  EXPECT_EQ(frame.payload[0], 9);
+}
+
+TEST(ShmChannel, SendReportsUnreachablePeers)
+{
+  const std::string pc_name = ring_name("pc-errors");
+  const std::string mcu_name = ring_name("mcu-errors");
+  Channel pc;
+  Channel mcu;
+  ASSERT_EQ(pc.open(pc_name.c_str()), PROTON_OK);
+  ASSERT_EQ(mcu.open(mcu_name.c_str(), {8, 4}), PROTON_OK);
+  ASSERT_EQ(pc.add_peer(2, 1, mcu_name.c_str()), PROTON_OK);
+  ASSERT_EQ(pc.add_peer(3, 1, ring_name("absent").c_str()), PROTON_OK);
+
+  // The known peer is still sent to
+  const uint8_t payload[] = {1, 2};
+  const proton_endpoint_t peers[] = {endpoint(4, 1), endpoint(2, 1)};
+  size_t sent = 0;
+  EXPECT_EQ(
+    pc.send(payload, sizeof(payload), 1, 0, peers, 2, sent), PROTON_INCORRECT_TARGET_ERROR);
+  EXPECT_EQ(sent, 1u);
+
+  const proton_endpoint_t absent[] = {endpoint(3, 1)};
+  EXPECT_EQ(pc.send(payload, sizeof(payload), 1, 0, absent, 1, sent), PROTON_WRITE_ERROR);
+
+  const uint8_t large[8] = {};
+  EXPECT_EQ(
+    pc.send(large, sizeof(large), 1, 0, peers + 1, 1, sent), PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(sent, 0u);
+}
+
+TEST(ShmChannel, PeersAttachAgainToARecreatedRing)
+{
+  const std::string pc_name = ring_name("pc-reopen");
+  const std::string mcu_name = ring_name("mcu-reopen");
+  Channel pc;
+  Channel mcu;
+  ASSERT_EQ(pc.open(pc_name.c_str()), PROTON_OK);
+  ASSERT_EQ(mcu.open(mcu_name.c_str()), PROTON_OK);
+  ASSERT_EQ(pc.add_peer(2, 1, mcu_name.c_str()), PROTON_OK);
+
+  const uint8_t payload[] = {1};
+  const proton_endpoint_t peers[] = {endpoint(2, 1)};
+  size_t sent = 0;
+  ASSERT_EQ(pc.send(payload, sizeof(payload), 1, 0, peers, 1, sent), PROTON_OK);
+
+  mcu.close();
+  EXPECT_EQ(pc.send(payload, sizeof(payload), 1, 0, peers, 1, sent), PROTON_WRITE_ERROR);
+  ASSERT_EQ(mcu.open(mcu_name.c_str()), PROTON_OK);
+  ASSERT_EQ(pc.send(payload, sizeof(payload), 1, 0, peers, 1, sent), PROTON_OK);
+
+  Frame frame;
+  ASSERT_EQ(mcu.receive(frame), PROTON_OK);
+  EXPECT_NE(frame.payload, nullptr);
+}
+
+TEST(ShmChannel, RejectsInvalidAndTakenNames)
+{
+  Channel channel;
+  EXPECT_EQ(channel.open("no-slash"), PROTON_CONNECT_ERROR);
+  EXPECT_EQ(channel.open("/two/slashes"), PROTON_CONNECT_ERROR);
+  const std::string long_name = "/" + std::string(Channel::MAX_NAME_LENGTH, 'a');
+  EXPECT_EQ(channel.open(long_name.c_str()), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(channel.is_open());
+
+  const std::string name = ring_name("taken");
+  ASSERT_EQ(channel.open(name.c_str()), PROTON_OK);
+  Channel other;
+  EXPECT_EQ(other.open(name.c_str()), PROTON_CONNECT_ERROR);
+  EXPECT_TRUE(channel.is_open());
+}
+
+#if PROTON_NODE_BUILDER
+
+TEST(ShmChannel, OpensFromEndpointConfig)
+{
+  proton::node_builder::EndpointConfig endpoint = {1, "shm", ring_name("config"), "", 0, 256};
+  Channel channel;
+  ASSERT_EQ(channel.open(endpoint), PROTON_OK);
+  EXPECT_EQ(channel.name(), ring_name("config"));
+
+  endpoint.type = "udp4";
+  EXPECT_EQ(channel.open(endpoint), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(channel.is_open());
+}
+
+TEST(ShmChannel, AddsShmPeersOfOtherNodes)
+{
+  proton::node_builder::Config config;
+  config.nodes["pc"] = {"pc", 1, {{1, {1, "shm", "/pc", "", 0, 0}}}, false};
+  config.nodes["mcu"] = {
+    "mcu",
+    2,
+    {{1, {1, "shm", "/mcu", "", 0, 0}}, {2, {2, "serial", "/dev/ttyUSB0", "", 0, 0}}},
+    false};
+  config.nodes["other"] = {"other", 3, {{4, {4, "shm", "/other", "", 0, 0}}}, false};
+
+  Channel channel;
+  ASSERT_EQ(channel.add_peers(config, "pc"), PROTON_OK);
+  EXPECT_EQ(channel.num_peers(), 2u);
+  EXPECT_TRUE(channel.has_peer(3, 4));
+}
+
+#endif
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "proton/encode_decode.h"
+#include "protoncpp/static_registry.hpp"
+#include "target_registry_ids.h"
+#include "target_registry_sizes.h"
+#include "target_schema.hpp"
+#include "utils.hpp"
+
+extern proton_registry_t g_proton_registry;
+
+using namespace proton;
+namespace signals = proton::schema::signals;
+namespace bundles = proton::schema::bundles;
+
+using SmallRegistry = StaticRegistry<
+  Signals<SignalDef<7, double>, SignalDef<3, char *, 6>, SignalDef<5, uint8_t *, 4>>,
+  Bundles<BundleDef<1, SignalDef<3, char *, 6>, SignalDef<7, double>>>>;
+
+static_assert(SmallRegistry::index_of<SignalDef<7, double>>() == 0);
+static_assert(SmallRegistry::index_of<SignalDef<5, uint8_t *, 4>>() == 2);
+static_assert(schema::Registry::index_of<signals::shared_signal>() == 14);
+static_assert(bundles::value_test::signal_count == 9);
+
+TEST(StaticRegistry, SchemaMatchesGeneratedRegistry)
+{
+  schema::Registry schema;
+  const proton_registry_t * registry = schema.registry();
+
+  ASSERT_EQ(registry->signal_count, g_proton_registry.signal_count);
+  ASSERT_EQ(registry->bundle_count, g_proton_registry.bundle_count);
+  EXPECT_EQ(registry->encode_decode_buffer_count, g_proton_registry.encode_decode_buffer_count);
+
+  for (uint16_t i = 0; i < registry->signal_count; i++)
+  {
+    const signal_desc_t & expected = g_proton_registry.signal_registry[i];
+    const signal_desc_t & actual = registry->signal_registry[i];
+    EXPECT_EQ(actual.id, expected.id);
+    EXPECT_EQ(actual.type, expected.type);
+    EXPECT_EQ(actual.capacity, expected.capacity);
+    EXPECT_EQ(actual.signal.which_signal, expected.signal.which_signal);
+    EXPECT_EQ(actual.signal_decode_buffer.len, expected.signal_decode_buffer.len);
+    ASSERT_EQ(actual.encoding == nullptr, expected.encoding == nullptr);
+    if (actual.encoding != nullptr)
+    {
+      EXPECT_EQ(actual.encoding->type, expected.encoding->type);
+      EXPECT_EQ(actual.encoding->scale, expected.encoding->scale);
+      EXPECT_EQ(actual.encoding->offset, expected.encoding->offset);
+    }
+  }
+
+  for (uint16_t i = 0; i < registry->bundle_count; i++)
+  {
+    const bundle_desc_t & expected = g_proton_registry.bundle_table[i];
+    const bundle_desc_t & actual = registry->bundle_table[i];
+    EXPECT_EQ(actual.bundle_id, expected.bundle_id);
+    ASSERT_EQ(actual.signal_ids.count, expected.signal_ids.count);
+    ASSERT_EQ(actual.signal_slots.capacity, expected.signal_slots.capacity);
+    for (uint8_t j = 0; j < actual.signal_ids.count; j++)
+    {
+      EXPECT_EQ(actual.signal_ids.ids[j], expected.signal_ids.ids[j]);
+      EXPECT_EQ(actual.signal_indices[j], expected.signal_indices[j]);
+    }
+    for (uint16_t j = 0; j < actual.signal_slots.capacity; j++)
+    {
+      EXPECT_EQ(actual.signal_slots.slots[j], expected.signal_slots.slots[j]);
+    }
+  }
+}
+
+TEST(StaticRegistry, LookupIndicesMatchRuntimeBuild)
+{
+  schema::Registry schema;
+  proton_registry_t registry = *schema.registry();
+
+  std::vector<uint16_t> bundle_slots(registry.bundle_index.capacity);
+  std::vector<uint16_t> signal_slots(registry.signal_index.capacity);
+  ASSERT_EQ(
+    proton_registry_build_index(
+      &registry, bundle_slots.data(), registry.bundle_index.capacity, signal_slots.data(),
+      registry.signal_index.capacity),
+    PROTON_OK);
+
+  const proton_registry_t * view = schema.registry();
+  for (uint16_t i = 0; i < view->bundle_index.capacity; i++)
+  {
+    EXPECT_EQ(view->bundle_index.slots[i], bundle_slots[i]);
+  }
+  for (uint16_t i = 0; i < view->signal_index.capacity; i++)
+  {
+    EXPECT_EQ(view->signal_index.slots[i], signal_slots[i]);
+  }
+
+  size_t index = 0;
+  EXPECT_EQ(
+    proton_registry_get_signal(view, signals::really_long_bytes::id, &index),
+    &schema.desc<signals::really_long_bytes>());
+  EXPECT_EQ(index, schema::Registry::index_of<signals::really_long_bytes>());
+}
+
+TEST(StaticRegistry, TypedAccessUsesRegistryStorage)
+{
+  schema::Registry schema;
+  proton_registry_t * registry = schema.registry();
+
+  schema.set<signals::int64_value>(-1234567890123);
+  schema.set<signals::bool_value>(true);
+
+  int64_t int64_value = 0;
+  ASSERT_EQ(proton_signal_get_int64(registry, signals::int64_value::id, &int64_value), PROTON_OK);
+  EXPECT_EQ(int64_value, -1234567890123);
+
+  ASSERT_EQ(proton_signal_set_float(registry, signals::float_value::id, 2.5f), PROTON_OK);
+  EXPECT_EQ(schema.get<signals::float_value>(), 2.5f);
+  EXPECT_TRUE(schema.get<signals::bool_value>());
+}
+
+TEST(StaticRegistry, FlagsAccess)
+{
+  schema::Registry schema;
+  using StatusFlags = signals::status_flags;
+  static_assert(std::is_same_v<StatusFlags::value_type, Flags>);
+
+  schema.set<StatusFlags>(Flags{5});
+  EXPECT_TRUE(schema.get_flag<StatusFlags>(PROTON_SIGNAL_STATUS_FLAGS_READY_BIT));
+
+  const uint32_t version = schema.desc<StatusFlags>().version;
+  schema.set_flag<StatusFlags>(PROTON_SIGNAL_STATUS_FLAGS_READY_BIT, false);
+  schema.set_flag<StatusFlags>(PROTON_SIGNAL_STATUS_FLAGS_FAULT_BIT, true);
+  schema.set_flag<StatusFlags>(PROTON_FLAGS_MAX_BITS, true);
+  EXPECT_EQ(schema.desc<StatusFlags>().version, version + 2);
+
+  uint64_t flags = 0;
+  ASSERT_EQ(proton_signal_get_flags(schema.registry(), StatusFlags::id, &flags), PROTON_OK);
+  EXPECT_EQ(flags, 6u);
+  EXPECT_FALSE(schema.get_flag<StatusFlags>(PROTON_FLAGS_MAX_BITS));
+}
+
+TEST(StaticRegistry, ArrayAccess)
+{
+  schema::Registry schema;
+  using Samples = signals::imu_samples;
+  static_assert(std::is_same_v<Samples::value_type, double *>);
+  static_assert(Samples::capacity == PROTON_SIGNAL_IMU_SAMPLES_MAX_ELEMENTS);
+  EXPECT_EQ(schema.desc<Samples>().capacity, PROTON_SIGNAL_IMU_SAMPLES_CAPACITY);
+  EXPECT_TRUE(schema.view<Samples>().empty());
+
+  // Array storage is aligned for its elements
+  EXPECT_EQ(
+    reinterpret_cast<uintptr_t>(schema.desc<Samples>().signal.signal.string_value) %
+      alignof(double),
+    0u);
+
+  const double samples[] = {0.25, -8.0};
+  ASSERT_EQ(schema.set<Samples>(samples, 2), PROTON_OK);
+  EXPECT_EQ(schema.set<Samples>(samples, Samples::capacity + 1), PROTON_INSUFFICIENT_BUFFER_ERROR);
+  ASSERT_EQ(schema.view<Samples>().size(), 2u);
+  EXPECT_EQ(schema.view<Samples>()[1], -8.0);
+
+  const double * core_view = nullptr;
+  size_t count = 0;
+  ASSERT_EQ(
+    proton_signal_get_double_array(schema.registry(), Samples::id, &core_view, &count), PROTON_OK);
+  EXPECT_EQ(core_view, schema.view<Samples>().data());
+  EXPECT_EQ(count, 2u);
+
+  double out[1] = {};
+  size_t len = 0;
+  EXPECT_EQ(schema.get<Samples>(out, 1, len), PROTON_INSUFFICIENT_BUFFER_ERROR);
+}
+
+TEST(StaticRegistry, StringAndBytesFollowCoreSemantics)
+{
+  SmallRegistry small;
+  using Text = SignalDef<3, char *, 6>;
+  using Data = SignalDef<5, uint8_t *, 4>;
+
+  EXPECT_EQ(small.set<Text>("hello", 6), PROTON_OK);
+  EXPECT_EQ(small.desc<Text>().value_size, 6);
+  EXPECT_EQ(small.set<Text>("toolong", 8), PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(small.set<Text>("abc", 3), PROTON_ERROR);
+  EXPECT_EQ(small.set<Text>(nullptr, 0), PROTON_NULL_PTR_ERROR);
+
+  char text[6] = {};
+  size_t len = 0;
+  EXPECT_EQ(small.get<Text>(text, 3, len), PROTON_INSUFFICIENT_BUFFER_ERROR);
+  ASSERT_EQ(small.get<Text>(text, sizeof(text), len), PROTON_OK);
+  EXPECT_EQ(len, 6u);
+  EXPECT_STREQ(text, "hello");
+
+  char core_text[6] = {};
+  size_t core_len = 0;
+  ASSERT_EQ(
+    proton_signal_get_string(small.registry(), Text::id, core_text, sizeof(core_text), &core_len),
+    PROTON_OK);
+  EXPECT_EQ(core_len, len);
+  EXPECT_STREQ(core_text, "hello");
+
+  const uint8_t data[] = {1, 2, 3};
+  EXPECT_EQ(small.set<Data>(data, sizeof(data)), PROTON_OK);
+  EXPECT_EQ(small.set<Data>(data, 5), PROTON_INSUFFICIENT_BUFFER_ERROR);
+
+  uint8_t out[4] = {};
+  ASSERT_EQ(small.get<Data>(out, sizeof(out), len), PROTON_OK);
+  EXPECT_EQ(len, sizeof(data));
+  EXPECT_EQ(memcmp(out, data, sizeof(data)), 0);
+}
+
+TEST(StaticRegistry, EncodeDecodeThroughCoreView)
+{
+  schema::Registry source;
+  source.set<signals::double_value>(1.25);
+  source.set<signals::float_value>(-3.5f);
+  source.set<signals::int32_value>(-42);
+  source.set<signals::int64_value>(INT64_MIN);
+  source.set<signals::uint32_value>(UINT32_MAX);
+  source.set<signals::uint64_value>(7);
+  source.set<signals::bool_value>(true);
+  ASSERT_EQ(source.set<signals::string_value>("proton", 7), PROTON_OK);
+  const uint8_t bytes[] = {0xDE, 0xAD, 0xBE, 0xEF};
+  ASSERT_EQ(source.set<signals::bytes_value>(bytes, sizeof(bytes)), PROTON_OK);
+
+  // The same values in a copy of the generated registry encode to the same bytes
+  proton_registry_t generated = copy_default_registry(&g_proton_registry);
+  for (uint8_t i = 0; i < bundles::value_test::signal_count; i++)
+  {
+    const signal_desc_t & from = source.registry()->signal_registry[i];
+    signal_desc_t & to = generated.signal_registry[i];
+    to.value_size = from.value_size;
+    if (from.capacity > 0)
+    {
+      memcpy(to.signal.signal.bytes_value, from.signal.signal.bytes_value, from.value_size);
+    }
+    else
+    {
+      to.signal.signal = from.signal.signal;
+    }
+  }
+
+  uint8_t buffer[256];
+  uint8_t expected[256];
+  size_t len = 0;
+  size_t expected_len = 0;
+  ASSERT_EQ(
+    proton_encode_bundle(
+      source.registry(), bundles::value_test::id, buffer, sizeof(buffer), &len),
+    PROTON_OK);
+  ASSERT_EQ(
+    proton_encode_bundle_direct(
+      &generated, bundles::value_test::id, expected, sizeof(expected), &expected_len),
+    PROTON_OK);
+  ASSERT_EQ(len, expected_len);
+  EXPECT_EQ(memcmp(buffer, expected, len), 0);
+  free(generated.signal_registry);
+  free(generated.bundle_table);
+
+  schema::Registry sink;
+  ASSERT_EQ(proton_decode_direct(sink.registry(), buffer, len, nullptr, nullptr), PROTON_OK);
+  EXPECT_EQ(sink.get<signals::double_value>(), 1.25);
+  EXPECT_EQ(sink.get<signals::float_value>(), -3.5f);
+  EXPECT_EQ(sink.get<signals::int32_value>(), -42);
+  EXPECT_EQ(sink.get<signals::int64_value>(), INT64_MIN);
+  EXPECT_EQ(sink.get<signals::uint32_value>(), UINT32_MAX);
+  EXPECT_EQ(sink.get<signals::uint64_value>(), 7u);
+  EXPECT_TRUE(sink.get<signals::bool_value>());
+
+  char text[signals::string_value::capacity];
+  size_t text_len = 0;
+  ASSERT_EQ(sink.get<signals::string_value>(text, sizeof(text), text_len), PROTON_OK);
+  EXPECT_STREQ(text, "proton");
+
+  uint8_t data[signals::bytes_value::capacity];
+  size_t data_len = 0;
+  ASSERT_EQ(sink.get<signals::bytes_value>(data, sizeof(data), data_len), PROTON_OK);
+  ASSERT_EQ(data_len, sizeof(bytes));
+  EXPECT_EQ(memcmp(data, bytes, sizeof(bytes)), 0);
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstring>
+#include <span>
+#include "protoncpp/transport/udp4_socket.hpp"
+
+using namespace proton::transport::udp4;
+
+namespace
+{
+
+constexpr const char * LOOPBACK = "127.0.0.1";
+constexpr int TIMEOUT_MS = 1000;
+
+proton_endpoint_t endpoint(uint32_t node_id, uint32_t endpoint_id)
+{
+  return {node_id, endpoint_id, TRANSPORT_TYPE_UDP4, 0};
+}
+
+struct Buffers
+{
+  std::array<std::array<uint8_t, 2048>, 8> storage;
+  std::array<Datagram, 8> datagrams;
+
+  Buffers()
+  {
+    for (size_t i = 0; i < datagrams.size(); i++)
+    {
+      datagrams[i] = {storage[i].data(), storage[i].size(), 0, {}, 0, false};
+    }
+  }
+};
+
+/**
+ * Receive until count datagrams arrived or a receive times out
+ */
+size_t receive_all(Socket & socket, Buffers & buffers, size_t count)
+{
+  size_t total = 0;
+  while (total < count)
+  {
+    size_t received = 0;
+    EXPECT_EQ(
+      socket.receive(
+        std::span(buffers.datagrams).subspan(total), received, TIMEOUT_MS),
+      PROTON_OK);
+    if (received == 0)
+    {
+      break;
+    }
+    total += received;
+  }
+  return total;
+}
+
+}  // namespace
+
+TEST(Udp4Socket, OpensOnEphemeralPort)
+{
+  Socket socket;
+  EXPECT_FALSE(socket.is_open());
+  ASSERT_EQ(socket.open(LOOPBACK, 0), PROTON_OK);
+  EXPECT_TRUE(socket.is_open());
+  EXPECT_NE(socket.port(), 0);
+
+  socket.close();
+  EXPECT_FALSE(socket.is_open());
+  EXPECT_EQ(socket.port(), 0);
+}
+
+TEST(Udp4Socket, RejectsInvalidAddress)
+{
+  Socket socket;
+  EXPECT_EQ(socket.open("not an address", 0), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(socket.is_open());
+  EXPECT_EQ(socket.add_peer(1, 1, "", 1000), PROTON_CONNECT_ERROR);
+  EXPECT_EQ(socket.add_peer(1, 1, "300.0.0.1", 1000), PROTON_CONNECT_ERROR);
+}
+
+TEST(Udp4Socket, RejectsPortInUse)
+{
+  Socket first;
+  ASSERT_EQ(first.open(LOOPBACK, 0), PROTON_OK);
+
+  // A second node on the same port must fail rather than share its datagrams
+  Socket second;
+  EXPECT_EQ(second.open(LOOPBACK, first.port()), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(second.is_open());
+}
+
+TEST(Udp4Socket, SetsReceiveBufferSize)
+{
+  Socket socket;
+  ASSERT_EQ(socket.open(LOOPBACK, 0, {.receive_buffer_size = 256 * 1024}), PROTON_OK);
+}
+
+TEST(Udp4Socket, SendFansOutToEveryPeer)
+{
+  Socket sender, first, second;
+  ASSERT_EQ(sender.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(first.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(second.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(sender.add_peer(2, 1, LOOPBACK, first.port()), PROTON_OK);
+  ASSERT_EQ(sender.add_peer(3, 1, LOOPBACK, second.port()), PROTON_OK);
+  EXPECT_EQ(sender.num_peers(), 2u);
+
+  const std::array<uint8_t, 5> frame = {1, 2, 3, 4, 5};
+  const std::array<proton_endpoint_t, 2> peers = {endpoint(2, 1), endpoint(3, 1)};
+  size_t sent = 0;
+  ASSERT_EQ(sender.send(frame, peers, sent), PROTON_OK);
+  EXPECT_EQ(sent, 2u);
+
+  for (Socket * receiver : {&first, &second})
+  {
+    Buffers buffers;
+    ASSERT_EQ(receive_all(*receiver, buffers, 1), 1u);
+    const Datagram & datagram = buffers.datagrams[0];
+    ASSERT_EQ(datagram.length, frame.size());
+    EXPECT_EQ(std::memcmp(datagram.data, frame.data(), frame.size()), 0);
+    EXPECT_EQ(ntohs(datagram.from.sin_port), sender.port());
+    EXPECT_EQ(datagram.segment_size, 0u);
+  }
+}
+
+TEST(Udp4Socket, ReplacingPeerKeepsOneEntry)
+{
+  Socket socket;
+  ASSERT_EQ(socket.add_peer(2, 1, LOOPBACK, 1000), PROTON_OK);
+  ASSERT_EQ(socket.add_peer(2, 1, LOOPBACK, 1001), PROTON_OK);
+  ASSERT_EQ(socket.add_peer(2, 2, LOOPBACK, 1001), PROTON_OK);
+  EXPECT_EQ(socket.num_peers(), 2u);
+}
+
+TEST(Udp4Socket, UnknownPeerStillSendsToOthers)
+{
+  Socket sender, receiver;
+  ASSERT_EQ(sender.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(receiver.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(sender.add_peer(2, 1, LOOPBACK, receiver.port()), PROTON_OK);
+
+  const std::array<uint8_t, 3> frame = {7, 8, 9};
+  const std::array<proton_endpoint_t, 2> peers = {endpoint(9, 1), endpoint(2, 1)};
+  size_t sent = 0;
+  EXPECT_EQ(sender.send(frame, peers, sent), PROTON_INCORRECT_TARGET_ERROR);
+  EXPECT_EQ(sent, 1u);
+
+  Buffers buffers;
+  EXPECT_EQ(receive_all(receiver, buffers, 1), 1u);
+}
+
+TEST(Udp4Socket, SendRequiresOpenSocket)
+{
+  Socket socket;
+  ASSERT_EQ(socket.add_peer(2, 1, LOOPBACK, 1000), PROTON_OK);
+  const std::array<uint8_t, 1> frame = {0};
+  const std::array<proton_endpoint_t, 1> peers = {endpoint(2, 1)};
+  size_t sent = 0;
+  EXPECT_EQ(socket.send(frame, peers, sent), PROTON_INVALID_STATE_ERROR);
+
+  size_t received = 0;
+  Buffers buffers;
+  EXPECT_EQ(socket.receive(buffers.datagrams, received), PROTON_INVALID_STATE_ERROR);
+}
+
+TEST(Udp4Socket, ReceivesSeveralDatagramsPerCall)
+{
+  Socket sender, receiver;
+  ASSERT_EQ(sender.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(receiver.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(sender.add_peer(2, 1, LOOPBACK, receiver.port()), PROTON_OK);
+
+  const std::array<proton_endpoint_t, 1> peers = {endpoint(2, 1)};
+  for (uint8_t i = 0; i < 5; i++)
+  {
+    const std::array<uint8_t, 2> frame = {i, static_cast<uint8_t>(i * 2)};
+    size_t sent = 0;
+    ASSERT_EQ(sender.send(frame, peers, sent), PROTON_OK);
+  }
+
+  Buffers buffers;
+  ASSERT_EQ(receive_all(receiver, buffers, 5), 5u);
+  for (uint8_t i = 0; i < 5; i++)
+  {
+    ASSERT_EQ(buffers.datagrams[i].length, 2u);
+    EXPECT_EQ(buffers.datagrams[i].data[0], i);
+    EXPECT_EQ(buffers.datagrams[i].data[1], i * 2);
+  }
+}
+
+TEST(Udp4Socket, FlagsTruncatedDatagrams)
+{
+  Socket sender, receiver;
+  ASSERT_EQ(sender.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(receiver.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(sender.add_peer(2, 1, LOOPBACK, receiver.port()), PROTON_OK);
+
+  const std::array<proton_endpoint_t, 1> peers = {endpoint(2, 1)};
+  const std::array<uint8_t, 100> large = {};
+  const std::array<uint8_t, 10> small = {};
+  size_t sent = 0;
+  ASSERT_EQ(sender.send(large, peers, sent), PROTON_OK);
+  ASSERT_EQ(sender.send(small, peers, sent), PROTON_OK);
+
+  // Both datagrams get a buffer too small for the first one
+  Buffers buffers;
+  buffers.datagrams[0].capacity = 50;
+  buffers.datagrams[1].capacity = 50;
+  ASSERT_EQ(receive_all(receiver, buffers, 2), 2u);
+  EXPECT_TRUE(buffers.datagrams[0].truncated);
+  EXPECT_EQ(buffers.datagrams[0].length, 50u);
+  EXPECT_FALSE(buffers.datagrams[1].truncated);
+  EXPECT_EQ(buffers.datagrams[1].length, 10u);
+}
+
+TEST(Udp4Socket, ReceiveTimesOutWithNothingReceived)
+{
+  Socket socket;
+  ASSERT_EQ(socket.open(LOOPBACK, 0), PROTON_OK);
+  Buffers buffers;
+  size_t received = 1;
+  EXPECT_EQ(socket.receive(buffers.datagrams, received), PROTON_OK);
+  EXPECT_EQ(received, 0u);
+  EXPECT_EQ(socket.receive(buffers.datagrams, received, 10), PROTON_OK);
+  EXPECT_EQ(received, 0u);
+}
+
+TEST(Udp4Socket, SendSegmentsSplitsIntoDatagrams)
+{
+  Socket sender, receiver;
+  ASSERT_EQ(sender.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(receiver.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(sender.add_peer(2, 1, LOOPBACK, receiver.port()), PROTON_OK);
+
+  std::array<uint8_t, 250> data;
+  for (size_t i = 0; i < data.size(); i++)
+  {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  ASSERT_EQ(sender.send_segments(data.data(), data.size(), 100, endpoint(2, 1)), PROTON_OK);
+
+  Buffers buffers;
+  ASSERT_EQ(receive_all(receiver, buffers, 3), 3u);
+  EXPECT_EQ(buffers.datagrams[0].length, 100u);
+  EXPECT_EQ(buffers.datagrams[1].length, 100u);
+  EXPECT_EQ(buffers.datagrams[2].length, 50u);
+  EXPECT_EQ(buffers.datagrams[2].data[0], 200);
+
+  EXPECT_EQ(
+    sender.send_segments(data.data(), data.size(), 0, endpoint(2, 1)),
+    PROTON_INSUFFICIENT_BUFFER_ERROR);
+  EXPECT_EQ(
+    sender.send_segments(data.data(), data.size(), 100, endpoint(3, 1)),
+    PROTON_INCORRECT_TARGET_ERROR);
+}
+
+TEST(Udp4Socket, GsoSegmentsArriveAsSeparateDatagrams)
+{
+  Socket sender, receiver;
+  ASSERT_EQ(sender.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(receiver.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(sender.add_peer(2, 1, LOOPBACK, receiver.port()), PROTON_OK);
+
+  std::array<uint8_t, 250> data = {};
+  if (sender.send_segments(data.data(), data.size(), 100, endpoint(2, 1), true) != PROTON_OK)
+  {
+    GTEST_SKIP() << "UDP_SEGMENT is not supported by this kernel";
+  }
+
+  Buffers buffers;
+  ASSERT_EQ(receive_all(receiver, buffers, 3), 3u);
+  EXPECT_EQ(buffers.datagrams[0].length, 100u);
+  EXPECT_EQ(buffers.datagrams[2].length, 50u);
+}
+
+TEST(Udp4Socket, MoveTransfersSocketAndPeers)
+{
+  Socket socket;
+  ASSERT_EQ(socket.open(LOOPBACK, 0), PROTON_OK);
+  ASSERT_EQ(socket.add_peer(2, 1, LOOPBACK, 1000), PROTON_OK);
+  const int fd = socket.fd();
+
+  Socket moved(static_cast<Socket &&>(socket));
+  EXPECT_FALSE(socket.is_open());
+  EXPECT_EQ(socket.num_peers(), 0u);
+  EXPECT_EQ(moved.fd(), fd);
+  EXPECT_EQ(moved.num_peers(), 1u);
+}
+
+#if PROTON_NODE_BUILDER
+
+TEST(Udp4Socket, OpensFromEndpointConfig)
+{
+  proton::node_builder::EndpointConfig endpoint = {1, "udp4", "", LOOPBACK, 0, 0};
+  Socket socket;
+  ASSERT_EQ(socket.open(endpoint), PROTON_OK);
+  EXPECT_NE(socket.port(), 0);
+
+  endpoint.type = "serial";
+  EXPECT_EQ(socket.open(endpoint), PROTON_CONNECT_ERROR);
+  EXPECT_FALSE(socket.is_open());
+}
+
+TEST(Udp4Socket, AddsUdp4PeersOfOtherNodes)
+{
+  proton::node_builder::Config config;
+  config.nodes["pc"] = {"pc", 1, {{1, {1, "udp4", "", LOOPBACK, 11416, 0}}}, false};
+  config.nodes["mcu"] = {
+    "mcu",
+    2,
+    {{1, {1, "udp4", "", LOOPBACK, 11417, 0}}, {2, {2, "serial", "/dev/ttyUSB0", "", 0, 0}}},
+    false};
+  config.nodes["other"] = {"other", 3, {{4, {4, "udp4", "", LOOPBACK, 11418, 0}}}, false};
+
+  Socket socket;
+  ASSERT_EQ(socket.add_peers(config, "pc"), PROTON_OK);
+  EXPECT_EQ(socket.num_peers(), 2u);
+}
+
+#endif
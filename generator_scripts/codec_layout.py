@@ -0,0 +1,187 @@
+# Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Wire layout of bundles, used to emit the per-bundle codecs in target_codec.c."""
+
+PB_WT_VARINT = 0
+PB_WT_64BIT = 1
+PB_WT_STRING = 2
+PB_WT_32BIT = 5
+
+# Field numbers from proto/bundle.proto and proto/signal.proto
+BUNDLE_ID_TAG = 1
+BUNDLE_SIGNALS_TAG = 2
+SIGNAL_ID_TAG = 19
+SIGNAL_VALUE_TAGS = {
+    'double': 1,
+    'float': 2,
+    'int32': 3,
+    'int64': 4,
+    'uint32': 5,
+    'uint64': 6,
+    'bool': 7,
+    'string': 8,
+    'bytes': 9,
+    'flags': 10,
+    'double_array': 11,
+    'float_array': 12,
+    'int32_array': 13,
+    'int64_array': 14,
+    'uint32_array': 15,
+    'uint64_array': 16,
+}
+
+# Value fields float and double signals are sent as when they have an encoding
+ENCODED_VALUE_TAGS = {'quantized': 17, 'float16': 18}
+
+# Arrays are length delimited fields holding the packed encoding of their elements
+SIGNAL_WIRE_TYPES = {
+    'double': PB_WT_64BIT,
+    'float': PB_WT_32BIT,
+    'string': PB_WT_STRING,
+    'bytes': PB_WT_STRING,
+    'double_array': PB_WT_STRING,
+    'float_array': PB_WT_STRING,
+    'int32_array': PB_WT_STRING,
+    'int64_array': PB_WT_STRING,
+    'uint32_array': PB_WT_STRING,
+    'uint64_array': PB_WT_STRING,
+}
+
+# Encoded size of values that do not depend on the value, bools are always 0 or 1
+FIXED_VALUE_SIZES = {'double': 8, 'float': 4, 'bool': 1}
+
+
+def signal_value_tag(signal: dict) -> int:
+    """
+    Get the field number a signal's value is sent as.
+
+    Args:
+        signal: normalized signal config
+
+    Returns:
+        the encoded value field of an encoded signal, otherwise the field of its type
+
+    """
+    encoding = signal.get('encoding')
+    if encoding is not None:
+        return ENCODED_VALUE_TAGS[encoding]
+    return SIGNAL_VALUE_TAGS[signal['type']]
+
+
+def encode_varint(value: int) -> list[int]:
+    """
+    Encode a value as a protobuf varint.
+
+    Args:
+        value: non-negative value
+
+    Returns:
+        varint bytes
+
+    """
+    out = []
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return out
+
+
+def encode_key(tag: int, wire_type: int) -> list[int]:
+    """
+    Encode a protobuf field key.
+
+    Args:
+        tag: field number
+        wire_type: protobuf wire type
+
+    Returns:
+        varint bytes of the key
+
+    """
+    return encode_varint((tag << 3) | wire_type)
+
+
+def encode_id_field(tag: int, id_: int) -> list[int]:
+    """
+    Encode an ID field, which proto3 leaves out when it is 0.
+
+    Args:
+        tag: field number of the ID
+        id_: the ID
+
+    Returns:
+        bytes of the field, empty for an ID of 0
+
+    """
+    if id_ == 0:
+        return []
+    return encode_key(tag, PB_WT_VARINT) + encode_varint(id_)
+
+
+def build_codec_layout(bundle_id: int, signals: list[dict]) -> dict:
+    """
+    Describe the bytes of a Bundle message that are known when generating code.
+
+    Signals with a fixed size value have their whole entry header known up front: the signals
+    field key, the length of the Signal message and the value key. Other signals only have a known
+    value key and ID field, and their length is computed when encoding.
+
+    Args:
+        bundle_id: ID of the bundle
+        signals: signal configs of the bundle, in bundle order
+
+    Returns:
+        dict with the bundle ID field, the layout of each signal, and fixed_len, the number of
+        bytes of the Bundle message that do not depend on signal values
+
+    """
+    id_field = encode_id_field(BUNDLE_ID_TAG, bundle_id)
+    signals_key = encode_key(BUNDLE_SIGNALS_TAG, PB_WT_STRING)
+    fixed_len = len(id_field)
+    layout_signals = []
+
+    for signal in signals:
+        type_ = signal['type']
+        encoding = signal.get('encoding')
+        # Encoded values are varints, of whatever size the value takes
+        wire_type = PB_WT_VARINT if encoding else SIGNAL_WIRE_TYPES.get(type_, PB_WT_VARINT)
+        value_key = encode_key(signal_value_tag(signal), wire_type)
+        signal_id_field = encode_id_field(SIGNAL_ID_TAG, signal['id'])
+        entry = {
+            'name': signal['name'],
+            'type': type_,
+            'is_array': type_.endswith('_array'),
+            'encoding': encoding,
+            'registry_index': signal['registry_index'],
+            'signals_key': signals_key,
+            'value_key': value_key,
+            'id_field': signal_id_field,
+            # Bytes of the Signal message that do not depend on the value
+            'const_len': len(value_key) + len(signal_id_field),
+            'head': None,
+        }
+
+        value_size = None if encoding else FIXED_VALUE_SIZES.get(type_)
+        if value_size is not None:
+            signal_len = entry['const_len'] + value_size
+            entry['value_size'] = value_size
+            entry['head'] = signals_key + encode_varint(signal_len) + value_key
+            fixed_len += len(signals_key) + len(encode_varint(signal_len)) + signal_len
+
+        layout_signals.append(entry)
+
+    return {'id_field': id_field, 'signals': layout_signals, 'fixed_len': fixed_len}
@@ -18,7 +18,7 @@
 
 from collections import Counter
 
-from internal_types import INTERNAL_TYPE_MAP
+from internal_types import FLAGS_MAX_BITS, INTERNAL_TYPE_MAP, SIGNAL_ENCODINGS
 
 
 def validate_node_elements(node: dict):
@@ -34,7 +34,7 @@ def validate_node_elements(node: dict):
     """
     required_top_level_elements = {'name': str, 'endpoints': list[dict]}
     required_endpoint_elements = {'id': str, 'type': 'str'}
-    required_endpoint_configs = {'serial': ['ip', 'port'], 'udp4': ['device']}
+    required_endpoint_configs = {'serial': ['ip', 'port'], 'udp4': ['device'], 'shm': ['device']}
 
     for tl, tl_type in required_top_level_elements.items():
         if tl not in node:
@@ -81,6 +81,30 @@ def validate_signal_elements(signal: dict):
     if signal_type not in INTERNAL_TYPE_MAP:
         raise RuntimeError(f'Signal type {signal_type} is not supported')
 
+    bits = signal.get('bits')
+    if bits is not None:
+        if signal_type != 'flags':
+            raise RuntimeError(f'Signal {signal["name"]} has bits but is not a flags signal')
+        if len(bits) > FLAGS_MAX_BITS:
+            raise RuntimeError(
+                f'Signal {signal["name"]} has {len(bits)} bits, at most {FLAGS_MAX_BITS} fit'
+            )
+        if len(set(bits)) != len(bits):
+            raise RuntimeError(f'Signal {signal["name"]} has duplicate bit names')
+
+    # A scale on its own is enough to quantize a signal
+    encoding = signal.get('encoding', 'quantized' if 'scale' in signal else None)
+    if encoding is None and 'offset' not in signal:
+        return
+    if signal_type not in ('float', 'double'):
+        raise RuntimeError(f'Signal {signal["name"]} has an encoding but is not float or double')
+    if encoding not in SIGNAL_ENCODINGS:
+        raise RuntimeError(f'Signal {signal["name"]} has unknown encoding {encoding}')
+    if encoding == 'quantized' and not signal.get('scale'):
+        raise RuntimeError(f'Signal {signal["name"]} is quantized but has no nonzero scale')
+    if encoding != 'quantized' and ('scale' in signal or 'offset' in signal):
+        raise RuntimeError(f'Signal {signal["name"]} has a scale or offset but is not quantized')
+
 
 def validate_ids(id_list: list, item_name: str):
     """
@@ -23,15 +23,22 @@ import argparse
 import json
 from pathlib import Path
 
+from codec_layout import build_codec_layout
 from config import validate_ids
+from internal_types import SIGNAL_ENCODINGS
 from jinja2 import Template
+from lookup_index import build_lookup_index
 from normalize import (
     filter_for_target,
     normalize_signals,
+    set_bundle_delta,
     set_bundle_periods,
+    set_endpoint_mtus,
+    set_node_compact,
     set_node_endpoint_address,
     set_producer_consumer_ids,
 )
+from schema_hash import compute_schema_hash
 import yaml
 
 
@@ -98,6 +105,10 @@ def generate(
         bundles=config['bundles'],
         signals=config['signals'],
         connections=config['connections'],
+        bundle_index=build_lookup_index([bundle['id'] for bundle in config['bundles']]),
+        signal_index=build_lookup_index([signal['id'] for signal in config['signals']]),
+        schema_hash=config['schema_hash'],
+        encodings=SIGNAL_ENCODINGS,
     )
 
     dest_path.mkdir(parents=True, exist_ok=True)
@@ -142,16 +153,19 @@ def main():
         config = load_config(config_path)
         config['bundles'] = sorted(config['bundles'], key=lambda x: x['id'])
         config['signals'] = sorted(config['signals'], key=lambda x: x['id'])
-        for i, signal in enumerate(config['signals']):
-            signal['registry_index'] = i
         name = Path(config_path).stem
 
     # validate node config here
     validate_ids(config['signals'], 'signals')
     set_node_endpoint_address(config['nodes'])
+    set_endpoint_mtus(config['nodes'])
+    set_node_compact(config['nodes'])
     normalize_signals(config['signals'])
     set_producer_consumer_ids(config['bundles'], config['nodes'])
     set_bundle_periods(config['bundles'])
+    set_bundle_delta(config['bundles'])
+    # Computed over the whole config so that every node of it agrees
+    config['schema_hash'] = compute_schema_hash(config['bundles'], config['signals'])
 
     try:
         config['bundles'], config['signals'] = filter_for_target(
@@ -160,6 +174,20 @@ def main():
     except KeyError as e:
         raise KeyError(f'Could not find key in config: {e}') from e
 
+    # Resolve registry positions once the registry contents for the target are known
+    for i, signal in enumerate(config['signals']):
+        signal['registry_index'] = i
+    registry_index_map = {signal['id']: signal['registry_index'] for signal in config['signals']}
+    for bundle in config['bundles']:
+        try:
+            bundle['signal_indices'] = [registry_index_map[id_] for id_ in bundle['signals']]
+        except KeyError as e:
+            raise KeyError(f'Bundle {bundle["name"]} references unknown signal {e}') from e
+        bundle['signal_slots'] = build_lookup_index(bundle['signals'])
+        bundle['codec'] = build_codec_layout(
+            bundle['id'], [config['signals'][i] for i in bundle['signal_indices']]
+        )
+
     generate(
         dest_path,
         'target_registry_ids.h',
@@ -192,6 +220,22 @@ def main():
         name,
         target,
     )
+    generate(
+        dest_path,
+        'target_codec.c',
+        'target_codec.c.jinja',
+        config,
+        name,
+        target,
+    )
+    generate(
+        dest_path,
+        'target_schema.hpp',
+        'target_schema.hpp.jinja',
+        config,
+        name,
+        target,
+    )
     generate(
         dest_path,
         'target_node.c',
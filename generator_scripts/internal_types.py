@@ -27,6 +27,35 @@ INTERNAL_TYPE_MAP = {
     'bool': 'bool',
     'string': 'char',
     'bytes': 'uint8_t',
+    'flags': 'uint64_t',
+    'double_array': 'double',
+    'float_array': 'float',
+    'int32_array': 'int32_t',
+    'int64_array': 'int64_t',
+    'uint32_array': 'uint32_t',
+    'uint64_array': 'uint64_t',
+}
+
+"""Size in bytes of the elements of array types"""
+ARRAY_ELEMENT_SIZES = {
+    'double_array': 8,
+    'float_array': 4,
+    'int32_array': 4,
+    'int64_array': 8,
+    'uint32_array': 4,
+    'uint64_array': 8,
+}
+
+"""Largest capacity in bytes of a signal, the capacity of a signal_desc_t is 16 bits"""
+MAX_CAPACITY_BYTES = 0xFFFF
+
+"""Number of flags a flags signal holds, PROTON_FLAGS_MAX_BITS in proton/registry.h"""
+FLAGS_MAX_BITS = 64
+
+"""Wire encodings of float and double signals, proton_signal_encoding_type_e in registry.h"""
+SIGNAL_ENCODINGS = {
+    'quantized': 'PROTON_ENCODING_QUANTIZED',
+    'float16': 'PROTON_ENCODING_FLOAT16',
 }
 
 """Default values for particular types"""
@@ -38,4 +67,5 @@ DEFAULT_VALUE_MAP = {
     'uint32': 0,
     'uint64': 0,
     'bool': 'false',
+    'flags': 0,
 }
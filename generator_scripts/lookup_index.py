@@ -0,0 +1,78 @@
+# Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Static ID lookup index tables, mirroring proton_registry_build_index in registry.c."""
+
+LOOKUP_INDEX_EMPTY = 0xFFFF
+
+
+def lookup_index_hash(id_: int) -> int:
+    """
+    Hash an ID the same way as proton_lookup_index_hash.
+
+    Args:
+        id_: bundle or signal ID
+
+    Returns:
+        32 bit hash of the ID
+
+    """
+    h = (id_ * 2654435761) & 0xFFFFFFFF
+    return h ^ (h >> 16)
+
+
+def lookup_index_capacity(count: int) -> int:
+    """
+    Get the index capacity for a table, matching proton_lookup_index_capacity.
+
+    Args:
+        count: number of entries in the table
+
+    Returns:
+        power of two capacity, or 0 if the table is too large to be indexed
+
+    """
+    capacity = 1
+    while capacity < count * 2:
+        capacity <<= 1
+    if capacity > (1 << 15) or count >= LOOKUP_INDEX_EMPTY:
+        return 0
+    return capacity
+
+
+def build_lookup_index(ids: list[int]) -> list[int]:
+    """
+    Build the slot table for a list of IDs, in table order.
+
+    Args:
+        ids: IDs of the table entries, indexed by their position in the table
+
+    Returns:
+        list of slots holding table positions, or LOOKUP_INDEX_EMPTY for unused slots
+
+    """
+    capacity = lookup_index_capacity(len(ids))
+    if capacity == 0:
+        return []
+
+    mask = capacity - 1
+    slots = [LOOKUP_INDEX_EMPTY] * capacity
+    for i, id_ in enumerate(ids):
+        slot = lookup_index_hash(id_) & mask
+        while slots[slot] != LOOKUP_INDEX_EMPTY and ids[slots[slot]] != id_:
+            slot = (slot + 1) & mask
+        if slots[slot] == LOOKUP_INDEX_EMPTY:
+            slots[slot] = i
+    return slots
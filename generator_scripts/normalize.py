@@ -18,7 +18,12 @@
 """Normalize elements of the proton config."""
 
 from config import validate_signal_elements
-from internal_types import DEFAULT_VALUE_MAP, INTERNAL_TYPE_MAP
+from internal_types import (
+    ARRAY_ELEMENT_SIZES,
+    DEFAULT_VALUE_MAP,
+    INTERNAL_TYPE_MAP,
+    MAX_CAPACITY_BYTES,
+)
 
 
 def normalize_signals(signals: list[dict]):
@@ -29,21 +34,27 @@ def normalize_signals(signals: list[dict]):
         signals: signals stanza from proton config
 
     Raises:
-        RuntimeError: if specified default value for string/bytes signals
-                      is less than a specified capacity
+        RuntimeError: if specified default value for string/bytes/array signals
+                      is less than a specified capacity, or an array has no capacity
 
     """
     for signal in signals:
         validate_signal_elements(signal)
 
         signal.setdefault('capacity', 0)
+        signal.setdefault('bits', [])
+        signal.setdefault('encoding', 'quantized' if 'scale' in signal else None)
+        signal.setdefault('scale', 0.0)
+        signal.setdefault('offset', 0.0)
 
         signal_type = signal['type']
 
-        is_capacity_type = 'bytes' in signal_type or 'string' in signal_type
+        is_array_type = signal_type in ARRAY_ELEMENT_SIZES
+        is_capacity_type = 'bytes' in signal_type or 'string' in signal_type or is_array_type
         has_default_value = signal.get('value') is not None
 
         signal['is_capacity_type'] = is_capacity_type
+        signal['is_array_type'] = is_array_type
         signal['has_default_value'] = has_default_value
         capacity = signal['capacity']
 
@@ -51,6 +62,30 @@ def normalize_signals(signals: list[dict]):
         if signal_type in DEFAULT_VALUE_MAP and not has_default_value:
             signal['value'] = DEFAULT_VALUE_MAP[signal_type]
 
+        # Array capacities count elements, their storage is sized in bytes like strings and bytes.
+        # Arrays start out empty unless a default list of elements is given.
+        if is_array_type:
+            if not has_default_value:
+                signal['value'] = []
+            if capacity == 0:
+                signal['capacity'] = len(signal['value'])
+            elif capacity < len(signal['value']):
+                raise RuntimeError(
+                    f'Signal capacity {capacity} '
+                    f'is less than default value: {len(signal["value"])}'
+                )
+            if signal['capacity'] == 0:
+                raise RuntimeError(
+                    f'Signal {signal["name"]} of type {signal_type} must define a capacity'
+                )
+            signal['capacity_bytes'] = signal['capacity'] * ARRAY_ELEMENT_SIZES[signal_type]
+            if signal['capacity_bytes'] > MAX_CAPACITY_BYTES:
+                raise RuntimeError(
+                    f'Signal {signal["name"]} has {signal["capacity"]} elements, '
+                    f'at most {MAX_CAPACITY_BYTES // ARRAY_ELEMENT_SIZES[signal_type]} fit'
+                )
+            continue
+
         # Special case for capacity types. If a value is specified but no capacity,
         # assume the capacity is the length of the default value. For strings, this is +1
         # due to the null char at the end.
@@ -102,6 +137,37 @@ def set_node_endpoint_address(nodes: list[dict]):
                 endpoint['ipnl'] = ip_nl
 
 
+def set_endpoint_mtus(nodes: list[dict]):
+    """
+    Set the MTU of each endpoint, defaulting to 0 (no limit).
+
+    Args:
+        nodes: "nodes" stanza in proton config
+
+    """
+    for node in nodes:
+        for endpoint in node['endpoints']:
+            endpoint.setdefault('mtu', 0)
+            if not 0 <= endpoint['mtu'] <= 0xFFFF:
+                raise RuntimeError(
+                    f'Endpoint {node["name"]}/{endpoint["id"]} MTU must be between 0 and 65535'
+                )
+
+
+def set_node_compact(nodes: list[dict]):
+    """
+    Set whether each node accepts compact frames, defaulting to false.
+
+    Args:
+        nodes: "nodes" stanza in proton config
+
+    """
+    for node in nodes:
+        node.setdefault('compact', False)
+        if not isinstance(node['compact'], bool):
+            raise RuntimeError(f'Node {node["name"]} compact must be true or false')
+
+
 def set_producer_consumer_ids(bundles: list[dict], nodes: list[dict]):
     """
     Set ids of producers and consumers for each bundle.
@@ -130,6 +196,28 @@ def set_bundle_periods(bundles: list[dict]):
         bundle.setdefault('period_ms', 0)
 
 
+def set_bundle_delta(bundles: list[dict]):
+    """
+    Set whether each bundle is sent as a delta, defaulting to full bundles.
+
+    Delta bundles send a full keyframe every keyframe_interval sends, defaulting to 10.
+    A keyframe_interval of 0 only sends keyframes when requested.
+
+    Args:
+        bundles: "bundles" stanza in proton config
+
+    """
+    for bundle in bundles:
+        bundle.setdefault('delta', False)
+        bundle.setdefault('keyframe_interval', 10)
+        if not isinstance(bundle['delta'], bool):
+            raise RuntimeError(f'Bundle {bundle["name"]} delta must be true or false')
+        if not 0 <= bundle['keyframe_interval'] <= 0xFFFF:
+            raise RuntimeError(
+                f'Bundle {bundle["name"]} keyframe_interval must be between 0 and 65535'
+            )
+
+
 def filter_for_target(
     bundles: list[dict], signals: list[dict], target: str
 ) -> tuple[list[dict], list[dict]]:
@@ -0,0 +1,76 @@
+# Copyright 2026 Rockwell Automation Technologies, Inc., All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Schema hash identifying the bundle layouts of a config, used to negotiate compact frames."""
+
+import struct
+
+from codec_layout import signal_value_tag
+
+FNV_OFFSET_BASIS = 0x811C9DC5
+FNV_PRIME = 0x01000193
+
+
+def fnv1a_32(data: bytes, hash_: int = FNV_OFFSET_BASIS) -> int:
+    """
+    Hash bytes with 32-bit FNV-1a.
+
+    Args:
+        data: bytes to hash
+        hash_: hash to continue from
+
+    Returns:
+        32-bit hash
+
+    """
+    for byte in data:
+        hash_ = ((hash_ ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+    return hash_
+
+
+def compute_schema_hash(bundles: list[dict], signals: list[dict]) -> int:
+    """
+    Compute the schema hash of a whole config, which must match the node builder's.
+
+    Each bundle, in ascending ID order, contributes its ID (4 bytes), delta flag (1 byte) and
+    signal count (2 bytes), followed by the ID (4 bytes) and wire value tag (1 byte) of each of its
+    signals in bundle order. Quantized signals also add their scale and offset (8 byte doubles).
+    Integers and doubles are little endian. A hash of 0 is reserved for "unknown".
+
+    Args:
+        bundles: normalized "bundles" stanza of the config, before filtering for a target
+        signals: normalized "signals" stanza of the config, before filtering for a target
+
+    Returns:
+        32-bit schema hash
+
+    """
+    signals_by_id = {signal['id']: signal for signal in signals}
+    data = bytearray()
+    for bundle in sorted(bundles, key=lambda x: x['id']):
+        data += bundle['id'].to_bytes(4, 'little')
+        data.append(1 if bundle['delta'] else 0)
+        data += len(bundle['signals']).to_bytes(2, 'little')
+        for signal_id in bundle['signals']:
+            try:
+                signal = signals_by_id[signal_id]
+            except KeyError as e:
+                raise KeyError(f'Bundle {bundle["name"]} references unknown signal {e}') from e
+            data += signal_id.to_bytes(4, 'little')
+            data.append(signal_value_tag(signal))
+            if signal.get('encoding') == 'quantized':
+                data += struct.pack('<dd', signal['scale'], signal['offset'])
+
+    return fnv1a_32(bytes(data)) or 1